@@ -0,0 +1,155 @@
+/**
+ * Native Job System Benchmark
+ *
+ * Compares plain JS loops with mystral.jobs.parallelFor on the built-in
+ * kernels: frustum culling 100k bounding spheres, multiplying 100k matrices,
+ * transforming 100k AABBs and sorting 1M keys.
+ *
+ * Usage:
+ *   mystral run examples/bench-jobs.js --no-sdl
+ */
+
+const COUNT = 100000;
+const SORT_COUNT = 1000000;
+const ROUNDS = 20;
+
+function time(fn) {
+    fn();  // Warm up
+    const start = performance.now();
+    for (let i = 0; i < ROUNDS; i++) fn();
+    return (performance.now() - start) / ROUNDS;
+}
+
+function report(label, jsMs, nativeMs) {
+    console.log(
+        label.padEnd(14) + ' | ' +
+        jsMs.toFixed(2).padStart(8) + ' | ' +
+        nativeMs.toFixed(2).padStart(8) + ' | ' +
+        (jsMs / nativeMs).toFixed(1).padStart(5) + 'x'
+    );
+}
+
+// --- Data -------------------------------------------------------------------
+
+const spheres = new Float32Array(COUNT * 4);
+for (let i = 0; i < COUNT; i++) {
+    spheres[i * 4] = Math.random() * 200 - 100;
+    spheres[i * 4 + 1] = Math.random() * 200 - 100;
+    spheres[i * 4 + 2] = Math.random() * 200 - 100;
+    spheres[i * 4 + 3] = Math.random() * 2;
+}
+// Axis-aligned box [-50, 50]^3 as six inward-facing planes (nx, ny, nz, d)
+const planes = new Float32Array([
+    1, 0, 0, 50, -1, 0, 0, 50,
+    0, 1, 0, 50, 0, -1, 0, 50,
+    0, 0, 1, 50, 0, 0, -1, 50,
+]);
+const visibleJS = new Uint8Array(COUNT);
+const visibleNative = new Uint8Array(COUNT);
+
+const parents = new Float32Array(COUNT * 16);
+const locals = new Float32Array(COUNT * 16);
+for (let i = 0; i < COUNT * 16; i++) {
+    parents[i] = Math.random();
+    locals[i] = Math.random();
+}
+const worldJS = new Float32Array(COUNT * 16);
+const worldNative = new Float32Array(COUNT * 16);
+
+const boxes = new Float32Array(COUNT * 6);
+for (let i = 0; i < COUNT; i++) {
+    boxes.set([-1, -1, -1, 1, 1, 1], i * 6);
+}
+const worldBoxes = new Float32Array(COUNT * 6);
+
+const keys = new Float32Array(SORT_COUNT);
+for (let i = 0; i < SORT_COUNT; i++) keys[i] = Math.random();
+const order = new Uint32Array(SORT_COUNT);
+
+// --- JS reference implementations --------------------------------------------
+
+function cullJS() {
+    for (let i = 0; i < COUNT; i++) {
+        const x = spheres[i * 4], y = spheres[i * 4 + 1], z = spheres[i * 4 + 2], r = spheres[i * 4 + 3];
+        let inside = 1;
+        for (let p = 0; p < 24; p += 4) {
+            if (planes[p] * x + planes[p + 1] * y + planes[p + 2] * z + planes[p + 3] < -r) {
+                inside = 0;
+                break;
+            }
+        }
+        visibleJS[i] = inside;
+    }
+}
+
+function mat4MultiplyJS() {
+    for (let i = 0; i < COUNT; i++) {
+        const o = i * 16;
+        for (let col = 0; col < 4; col++) {
+            const b0 = locals[o + col * 4], b1 = locals[o + col * 4 + 1];
+            const b2 = locals[o + col * 4 + 2], b3 = locals[o + col * 4 + 3];
+            for (let row = 0; row < 4; row++) {
+                worldJS[o + col * 4 + row] = parents[o + row] * b0 + parents[o + 4 + row] * b1 +
+                    parents[o + 8 + row] * b2 + parents[o + 12 + row] * b3;
+            }
+        }
+    }
+}
+
+function sortJS() {
+    const indices = Array.from({ length: SORT_COUNT }, (_, i) => i);
+    indices.sort((a, b) => keys[a] - keys[b]);
+    return indices;
+}
+
+// --- Run --------------------------------------------------------------------
+
+console.log('=== Native Job System Benchmark ===');
+console.log(`pool threads: ${mystral.jobs.threadCount}, kernels: ${mystral.jobs.kernels.join(', ')}`);
+console.log('kernel         |    JS ms | jobs ms | speedup');
+
+report('cullSpheres', time(cullJS),
+    time(() => mystral.jobs.parallelFor(COUNT, 'cullSpheres', [spheres, planes, visibleNative])));
+for (let i = 0; i < COUNT; i++) {
+    if (visibleJS[i] !== visibleNative[i]) {
+        console.error(`cullSpheres mismatch at ${i}`);
+        break;
+    }
+}
+
+report('mat4Multiply', time(mat4MultiplyJS),
+    time(() => mystral.jobs.parallelFor(COUNT, 'mat4Multiply', [parents, locals, worldNative])));
+for (let i = 0; i < COUNT * 16; i++) {
+    if (Math.abs(worldJS[i] - worldNative[i]) > 1e-4) {
+        console.error(`mat4Multiply mismatch at ${i}`);
+        break;
+    }
+}
+
+const transformMs = time(() => mystral.jobs.parallelFor(COUNT, 'transformAABB', [parents, boxes, worldBoxes]));
+console.log('transformAABB'.padEnd(14) + ' | ' + '-'.padStart(8) + ' | ' + transformMs.toFixed(2).padStart(8) + ' |');
+
+const sortStart = performance.now();
+const sortedJS = sortJS();
+const sortJSMs = performance.now() - sortStart;
+const sortNativeStart = performance.now();
+mystral.jobs.parallelFor(SORT_COUNT, 'sortByKey', [keys, order]);
+const sortNativeMs = performance.now() - sortNativeStart;
+report('sortByKey (1M)', sortJSMs, sortNativeMs);
+for (let i = 1; i < SORT_COUNT; i++) {
+    if (keys[order[i - 1]] > keys[order[i]]) {
+        console.error(`sortByKey out of order at ${i}`);
+        break;
+    }
+}
+if (keys[sortedJS[0]] !== keys[order[0]]) console.error('sortByKey disagrees with Array.sort');
+
+// Errors surface as exceptions
+try {
+    mystral.jobs.parallelFor(COUNT, 'cullSpheres', [spheres, planes, new Uint8Array(10)]);
+    console.error('expected a buffer size error');
+} catch (e) {
+    console.log(`bad buffers rejected: ${e.message}`);
+}
+
+process.exit(0);
@@ -0,0 +1,77 @@
+/**
+ * Text Codec Benchmark
+ *
+ * Times the native TextDecoder/TextEncoder and atob/btoa on a 10 MB
+ * JSON-like payload (mostly ASCII with some multi-byte text), plus a
+ * streaming decode split into 64 KB chunks.
+ *
+ * Usage:
+ *   mystral run examples/bench-text-codec.js --no-sdl
+ */
+
+const TARGET_BYTES = 10 * 1024 * 1024;
+const ROUNDS = 10;
+
+function time(fn) {
+    fn();  // Warm up
+    const start = performance.now();
+    for (let i = 0; i < ROUNDS; i++) fn();
+    return (performance.now() - start) / ROUNDS;
+}
+
+function report(label, ms, bytes) {
+    const mbPerSec = (bytes / (1024 * 1024)) / (ms / 1000);
+    console.log(
+        label.padEnd(18) + ' | ' +
+        ms.toFixed(2).padStart(8) + ' ms | ' +
+        mbPerSec.toFixed(0).padStart(6) + ' MB/s'
+    );
+}
+
+// Build the payload
+const entries = [];
+let approx = 2;
+for (let i = 0; approx < TARGET_BYTES; i++) {
+    const entry = JSON.stringify({
+        id: i,
+        name: 'entity_' + i,
+        position: [i * 0.5, i * 0.25, -i],
+        label: i % 16 === 0 ? 'héllo wörld – ナイス 🎮' : 'plain ascii label',
+    });
+    entries.push(entry);
+    approx += entry.length + 1;
+}
+const text = '[' + entries.join(',') + ']';
+
+const encoder = new TextEncoder();
+const bytes = encoder.encode(text);
+console.log(`=== Text Codec Benchmark (${(bytes.length / (1024 * 1024)).toFixed(1)} MB) ===`);
+console.log('operation          |  average |  throughput');
+
+const decoder = new TextDecoder();
+let decoded = '';
+report('TextDecoder', time(() => { decoded = decoder.decode(bytes); }), bytes.length);
+if (decoded !== text) console.error('decode mismatch');
+
+report('TextEncoder', time(() => encoder.encode(text)), bytes.length);
+
+const target = new Uint8Array(bytes.length);
+report('encodeInto', time(() => encoder.encodeInto(text, target)), bytes.length);
+
+const CHUNK = 64 * 1024;
+report('stream decode', time(() => {
+    const streaming = new TextDecoder();
+    let parts = 0;
+    for (let offset = 0; offset < bytes.length; offset += CHUNK) {
+        parts += streaming.decode(bytes.subarray(offset, offset + CHUNK), { stream: true }).length;
+    }
+    parts += streaming.decode().length;
+    return parts;
+}), bytes.length);
+
+// base64 works on byte strings; use the ASCII JSON bytes latin1-style
+const binary = text.replace(/[^\x00-\xff]/g, '?');
+let encoded = '';
+report('btoa', time(() => { encoded = btoa(binary); }), binary.length);
+report('atob', time(() => atob(encoded)), encoded.length);
+if (atob(encoded) !== binary) console.error('base64 round trip mismatch');
@@ -0,0 +1,79 @@
+/**
+ * Timer Queue Benchmark
+ *
+ * Keeps 10k timers pending (long cooldowns plus short repeating tweens)
+ * and measures what they cost: scheduling and clearing 10k timers, and the
+ * per-frame overhead of the timer pass while most of them are idle.
+ *
+ * Usage:
+ *   mystral run examples/bench-timers.js --no-sdl
+ */
+
+const TIMERS = 10000;
+const FRAMES = 300;
+
+function now() {
+    return performance.now();
+}
+
+// 1. Raw schedule / clear cost
+let start = now();
+const ids = [];
+for (let i = 0; i < TIMERS; i++) {
+    ids.push(setTimeout(() => {}, 60000 + i));
+}
+const scheduleMs = now() - start;
+
+start = now();
+for (const id of ids) clearTimeout(id);
+const clearMs = now() - start;
+
+console.log('=== Timer Queue Benchmark (' + TIMERS + ' timers) ===');
+console.log(`setTimeout x${TIMERS}:   ${scheduleMs.toFixed(2)} ms`);
+console.log(`clearTimeout x${TIMERS}: ${clearMs.toFixed(2)} ms`);
+
+// 2. Steady state: 9,900 idle cooldowns plus 100 repeating "tweens"
+const cooldowns = [];
+for (let i = 0; i < TIMERS - 100; i++) {
+    cooldowns.push(setTimeout(() => {}, 60000 + i));
+}
+let tweenTicks = 0;
+const tweens = [];
+for (let i = 0; i < 100; i++) {
+    tweens.push(setInterval(() => { tweenTicks++; }, 16));
+}
+
+let frames = 0;
+let last = now();
+let worst = 0;
+let total = 0;
+
+function frame() {
+    const t = now();
+    const dt = t - last;
+    last = t;
+    if (frames > 0) {
+        total += dt;
+        worst = Math.max(worst, dt);
+    }
+
+    // Churn: a game re-arms a few cooldowns every frame
+    for (let i = 0; i < 20; i++) {
+        const index = (frames * 20 + i) % cooldowns.length;
+        clearTimeout(cooldowns[index]);
+        cooldowns[index] = setTimeout(() => {}, 60000);
+    }
+
+    if (++frames < FRAMES) {
+        requestAnimationFrame(frame);
+        return;
+    }
+
+    console.log(`frames: ${FRAMES}, average frame ${(total / (FRAMES - 1)).toFixed(2)} ms, worst ${worst.toFixed(2)} ms`);
+    console.log(`tween callbacks: ${tweenTicks}`);
+
+    for (const id of cooldowns) clearTimeout(id);
+    for (const id of tweens) clearInterval(id);
+}
+
+requestAnimationFrame(frame);
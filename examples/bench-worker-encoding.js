@@ -0,0 +1,187 @@
+/**
+ * Worker Command Encoding Benchmark
+ *
+ * Records a 20k-draw scene on the main thread, then splits the same draws
+ * across N workers (N = 1, 2, 4, ... up to MAX_WORKERS). Each worker records
+ * its slice into a render bundle with mystral.gpu.device and posts it back;
+ * the main thread executes the bundles in one render pass and submits.
+ *
+ * Pipelines and bind groups cross postMessage by reference, so the workers
+ * record with the very objects the main thread created. Bundles are
+ * transferable and must be listed in the transfer list.
+ *
+ * Usage:
+ *   mystral run examples/bench-worker-encoding.js --no-sdl
+ */
+
+const DRAWS = 20000;
+const MAX_WORKERS = 8;
+const FRAMES = 30;
+const FORMAT = 'rgba8unorm';
+
+const workerCode = `
+let pipeline = null;
+let bindGroup = null;
+
+self.onmessage = (e) => {
+    const msg = e.data;
+    if (msg.type === 'init') {
+        pipeline = msg.pipeline;
+        bindGroup = msg.bindGroup;
+        postMessage({ type: 'ready', ok: !!(self.mystral && mystral.gpu) });
+        return;
+    }
+
+    const start = performance.now();
+    const encoder = mystral.gpu.device.createRenderBundleEncoder({ colorFormats: [msg.format] });
+    encoder.setPipeline(pipeline);
+    encoder.setBindGroup(0, bindGroup);
+    for (let i = msg.first; i < msg.first + msg.count; i++) {
+        encoder.draw(3, 1, 0, i);
+    }
+    const bundle = encoder.finish();
+    postMessage({ type: 'bundle', index: msg.index, bundle, ms: performance.now() - start }, [bundle]);
+};
+`;
+
+async function main() {
+    console.log('=== Worker Command Encoding Benchmark ===');
+
+    const adapter = await navigator.gpu.requestAdapter();
+    const device = await adapter.requestDevice();
+
+    const shaderModule = device.createShaderModule({ code: `
+        @group(0) @binding(0) var<storage, read> offsets: array<vec4f>;
+
+        @vertex
+        fn vs_main(@builtin(vertex_index) v: u32, @builtin(instance_index) i: u32) -> @builtin(position) vec4f {
+            var pos = array<vec2f, 3>(vec2f(0.0, 0.01), vec2f(-0.01, -0.01), vec2f(0.01, -0.01));
+            return vec4f(pos[v] + offsets[i].xy, 0.0, 1.0);
+        }
+
+        @fragment
+        fn fs_main() -> @location(0) vec4f {
+            return vec4f(1.0, 0.5, 0.2, 1.0);
+        }
+    ` });
+
+    const pipeline = device.createRenderPipeline({
+        layout: 'auto',
+        vertex: { module: shaderModule, entryPoint: 'vs_main' },
+        fragment: { module: shaderModule, entryPoint: 'fs_main', targets: [{ format: FORMAT }] }
+    });
+
+    const offsets = new Float32Array(DRAWS * 4);
+    for (let i = 0; i < DRAWS; i++) {
+        offsets[i * 4] = Math.random() * 2 - 1;
+        offsets[i * 4 + 1] = Math.random() * 2 - 1;
+    }
+    const offsetBuffer = device.createBuffer({
+        size: offsets.byteLength,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST
+    });
+    device.queue.writeBuffer(offsetBuffer, 0, offsets);
+
+    const bindGroup = device.createBindGroup({
+        layout: pipeline.getBindGroupLayout(0),
+        entries: [{ binding: 0, resource: { buffer: offsetBuffer } }]
+    });
+
+    const target = device.createTexture({
+        size: [512, 512],
+        format: FORMAT,
+        usage: GPUTextureUsage.RENDER_ATTACHMENT
+    });
+    const targetView = target.createView();
+
+    function beginPass(encoder) {
+        return encoder.beginRenderPass({
+            colorAttachments: [{ view: targetView, loadOp: 'clear', storeOp: 'store', clearValue: { r: 0, g: 0, b: 0, a: 1 } }]
+        });
+    }
+
+    // Baseline: every draw recorded on the main thread
+    function encodeMainThread() {
+        const start = performance.now();
+        const encoder = device.createCommandEncoder();
+        const pass = beginPass(encoder);
+        pass.setPipeline(pipeline);
+        pass.setBindGroup(0, bindGroup);
+        for (let i = 0; i < DRAWS; i++) {
+            pass.draw(3, 1, 0, i);
+        }
+        pass.end();
+        const commandBuffer = encoder.finish();
+        const ms = performance.now() - start;
+        device.queue.submit([commandBuffer]);
+        return ms;
+    }
+
+    encodeMainThread();  // Warm up
+    let baselineMs = 0;
+    for (let f = 0; f < FRAMES; f++) baselineMs += encodeMainThread();
+    baselineMs /= FRAMES;
+
+    console.log('workers | encode ms | speedup');
+    console.log('main    | ' + baselineMs.toFixed(2).padStart(9) + ' |   1.0x');
+
+    for (let count = 1; count <= MAX_WORKERS; count *= 2) {
+        const workers = [];
+        for (let i = 0; i < count; i++) workers.push(new Worker(new Blob([workerCode])));
+
+        // Hand each worker the shared pipeline and bind group
+        const ready = await Promise.all(workers.map((w) => new Promise((resolve) => {
+            w.onmessage = (e) => resolve(e.data.ok);
+            w.postMessage({ type: 'init', pipeline, bindGroup });
+        })));
+        if (!ready.every(Boolean)) {
+            console.log('Device is not thread-safe on this backend; worker encoding unavailable');
+            workers.forEach((w) => w.terminate());
+            process.exit(0);
+        }
+
+        // One frame: all workers record their slice in parallel, main executes the bundles
+        function encodeFrame() {
+            return new Promise((resolve) => {
+                const start = performance.now();
+                const bundles = new Array(count);
+                let remaining = count;
+                const slice = Math.ceil(DRAWS / count);
+
+                workers.forEach((w, index) => {
+                    w.onmessage = (e) => {
+                        bundles[e.data.index] = e.data.bundle;
+                        if (--remaining > 0) return;
+
+                        const encoder = device.createCommandEncoder();
+                        const pass = beginPass(encoder);
+                        pass.executeBundles(bundles);
+                        pass.end();
+                        const commandBuffer = encoder.finish();
+                        const ms = performance.now() - start;
+                        device.queue.submit([commandBuffer]);
+                        resolve(ms);
+                    };
+                    const first = index * slice;
+                    w.postMessage({ type: 'encode', index, first, count: Math.min(slice, DRAWS - first), format: FORMAT });
+                });
+            });
+        }
+
+        await encodeFrame();  // Warm up
+        let totalMs = 0;
+        for (let f = 0; f < FRAMES; f++) totalMs += await encodeFrame();
+        const ms = totalMs / FRAMES;
+
+        console.log(String(count).padEnd(7) + ' | ' + ms.toFixed(2).padStart(9) + ' | ' +
+            (baselineMs / ms).toFixed(1).padStart(5) + 'x');
+        workers.forEach((w) => w.terminate());
+    }
+
+    process.exit(0);
+}
+
+main().catch((e) => {
+    console.error('Benchmark failed:', e);
+    process.exit(1);
+});
@@ -0,0 +1,71 @@
+/**
+ * Worker Message Latency Benchmark
+ *
+ * Streams small timestamped messages to an echo worker at a fixed rate and
+ * reports the round-trip time distribution (main -> worker -> main, measured
+ * on the main thread's clock). Run it before and after queue changes; the
+ * tail percentiles are what frame pacing notices.
+ *
+ * Usage:
+ *   mystral run examples/bench-worker-latency.js --no-sdl
+ */
+
+const TARGET_RATE = 100000;   // messages per second
+const DURATION_MS = 3000;
+const BURST_INTERVAL_MS = 10;
+const BURST = (TARGET_RATE * BURST_INTERVAL_MS) / 1000;
+
+const workerCode = `
+    self.onmessage = (e) => postMessage(e.data);
+`;
+
+function percentile(sorted, p) {
+    const index = Math.min(sorted.length - 1, Math.floor((p / 100) * sorted.length));
+    return sorted[index];
+}
+
+function main() {
+    console.log('=== Worker Message Latency Benchmark ===');
+    console.log(`target: ${TARGET_RATE} msg/s for ${DURATION_MS} ms`);
+
+    const worker = new Worker(new Blob([workerCode]));
+    const rtts = [];
+    let sent = 0;
+    let received = 0;
+    let sending = true;
+    const start = performance.now();
+
+    worker.onmessage = (e) => {
+        rtts.push(performance.now() - e.data);
+        received++;
+        if (!sending && received === sent) report();
+    };
+
+    function sendBurst() {
+        for (let i = 0; i < BURST; i++) {
+            worker.postMessage(performance.now());
+            sent++;
+        }
+        if (performance.now() - start < DURATION_MS) {
+            setTimeout(sendBurst, BURST_INTERVAL_MS);
+        } else {
+            sending = false;
+        }
+    }
+
+    function report() {
+        const elapsed = performance.now() - start;
+        rtts.sort((a, b) => a - b);
+        console.log(`messages: ${received} (${((received * 1000) / elapsed).toFixed(0)} msg/s achieved)`);
+        for (const p of [50, 90, 99, 99.9]) {
+            console.log(`  p${String(p).padEnd(4)} ${(percentile(rtts, p) * 1000).toFixed(1).padStart(9)} us`);
+        }
+        console.log(`  max   ${(rtts[rtts.length - 1] * 1000).toFixed(1).padStart(9)} us`);
+        worker.terminate();
+        process.exit(0);
+    }
+
+    sendBurst();
+}
+
+main();
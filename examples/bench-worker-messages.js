@@ -0,0 +1,86 @@
+/**
+ * Worker Message Throughput Benchmark
+ *
+ * Echoes structured-clone payloads of increasing size through a worker and
+ * reports round trips per second and effective bandwidth. Payloads mix a
+ * nested object graph (keys, strings, numbers, a Map) with a Float32Array,
+ * the typical shape of game data handed to and from workers.
+ *
+ * Usage:
+ *   mystral run examples/bench-worker-messages.js --no-sdl
+ */
+
+const CASES = [
+    { label: '1 KB', bytes: 1024, rounds: 2000 },
+    { label: '1 MB', bytes: 1024 * 1024, rounds: 100 },
+    { label: '64 MB', bytes: 64 * 1024 * 1024, rounds: 5 },
+];
+
+const workerCode = `
+    self.onmessage = (e) => postMessage(e.data);
+`;
+
+function makePayload(bytes) {
+    const floats = new Float32Array(Math.max(1, (bytes - 512) / 4));
+    for (let i = 0; i < floats.length; i += 1024) floats[i] = i;
+    return {
+        id: 42,
+        name: 'chunk',
+        tags: ['terrain', 'lod0'],
+        bounds: { min: [0, 0, 0], max: [64, 16, 64] },
+        created: new Date(0),
+        materials: new Map([['grass', 1], ['rock', 2]]),
+        positions: floats,
+    };
+}
+
+function run(worker, payload, rounds) {
+    return new Promise((resolve) => {
+        let remaining = rounds;
+        const start = performance.now();
+        worker.onmessage = (e) => {
+            if (!(e.data.positions instanceof Float32Array) || !(e.data.materials instanceof Map)) {
+                console.error('Payload lost its types in transit');
+            }
+            if (--remaining === 0) {
+                resolve(performance.now() - start);
+            } else {
+                worker.postMessage(payload);
+            }
+        };
+        worker.postMessage(payload);
+    });
+}
+
+async function main() {
+    console.log('=== Worker Message Throughput Benchmark ===');
+    const worker = new Worker(new Blob([workerCode]));
+
+    // structuredClone sanity check (cycles and shared references survive)
+    const cyclic = { list: [] };
+    cyclic.self = cyclic;
+    cyclic.list.push(cyclic.list);
+    const copy = structuredClone(cyclic);
+    if (copy.self !== copy || copy.list[0] !== copy.list) {
+        console.error('structuredClone lost a reference');
+    }
+
+    console.log('payload | rounds | round trips/s |   MB/s');
+    for (const { label, bytes, rounds } of CASES) {
+        const ms = await run(worker, makePayload(bytes), rounds);
+        const perSecond = (rounds * 1000) / ms;
+        // Each round trip clones the payload twice
+        const mbPerSecond = (perSecond * 2 * bytes) / (1024 * 1024);
+        console.log(
+            label.padStart(7) + ' | ' +
+            String(rounds).padStart(6) + ' | ' +
+            perSecond.toFixed(1).padStart(13) + ' | ' +
+            mbPerSecond.toFixed(1).padStart(6)
+        );
+    }
+
+    worker.terminate();
+    process.exit(0);
+}
+
+main();
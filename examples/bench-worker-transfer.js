@@ -0,0 +1,64 @@
+/**
+ * Worker Transfer Benchmark
+ *
+ * Has a worker allocate a buffer (standing in for a decoded mesh) and post it
+ * back to the main thread, once with the ArrayBuffer in the transfer list and
+ * once without. Transfers hand over the backing store, so their cost should
+ * stay flat as the buffer grows.
+ *
+ * Usage:
+ *   mystral run examples/bench-worker-transfer.js --no-sdl
+ */
+
+const SIZES_MB = [1, 16, 64];
+
+const workerCode = `
+    self.onmessage = (e) => {
+        const t0 = performance.now();
+        const vertices = new Float32Array(e.data.mb * 1024 * 1024 / 4);
+        vertices[0] = 1; vertices[vertices.length - 1] = 2;
+        const allocMs = performance.now() - t0;
+        if (e.data.transfer) {
+            postMessage({ vertices, allocMs }, [vertices.buffer]);
+        } else {
+            postMessage({ vertices, allocMs });
+        }
+    };
+`;
+
+function roundTrip(worker, mb, transfer) {
+    return new Promise((resolve) => {
+        const start = performance.now();
+        worker.onmessage = (e) => {
+            // Round trip minus the worker's allocation time (clocks differ per engine)
+            const ms = performance.now() - start - e.data.allocMs;
+            const v = e.data.vertices;
+            // Transferred arrays arrive as real Float32Arrays over the moved buffer
+            const intact = transfer ? (v.length === mb * 262144 && v[v.length - 1] === 2) : true;
+            resolve({ ms, intact });
+        };
+        worker.postMessage({ mb, transfer });
+    });
+}
+
+async function main() {
+    console.log('=== Worker Transfer Benchmark ===');
+    const worker = new Worker(new Blob([workerCode]));
+
+    console.log('size MB | transfer ms | copy ms');
+    for (const mb of SIZES_MB) {
+        const moved = await roundTrip(worker, mb, true);
+        const copied = await roundTrip(worker, mb, false);
+        if (!moved.intact) console.error('Transferred buffer arrived corrupted');
+        console.log(
+            String(mb).padStart(7) + ' | ' +
+            moved.ms.toFixed(2).padStart(11) + ' | ' +
+            copied.ms.toFixed(1).padStart(7)
+        );
+    }
+
+    worker.terminate();
+    process.exit(0);
+}
+
+main();
@@ -0,0 +1,75 @@
+/**
+ * Worker Scaling Benchmark
+ *
+ * Spawns N CPU-bound workers (N = 1, 2, 4, ... up to MAX_WORKERS), gives each
+ * the same amount of work, and reports throughput relative to a single worker.
+ * With workers on real OS threads the speedup should be close to N until the
+ * machine runs out of cores.
+ *
+ * Usage:
+ *   mystral run examples/bench-workers.js --no-sdl
+ */
+
+const MAX_WORKERS = 8;
+const ITERATIONS_PER_WORKER = 20000000;
+
+const workerCode = `
+    self.onmessage = (e) => {
+        const start = performance.now();
+        let acc = 0;
+        for (let i = 0; i < e.data.iterations; i++) {
+            acc += Math.sqrt(i) * Math.sin(i);
+        }
+        postMessage({ acc: acc, ms: performance.now() - start });
+    };
+`;
+
+function runRound(count) {
+    return new Promise((resolve) => {
+        const workers = [];
+        let remaining = count;
+        const start = performance.now();
+
+        for (let i = 0; i < count; i++) {
+            const w = new Worker(new Blob([workerCode]));
+            w.onmessage = () => {
+                w.terminate();
+                if (--remaining === 0) {
+                    resolve(performance.now() - start);
+                }
+            };
+            w.onerror = (e) => console.error('Worker error:', e.message);
+            workers.push(w);
+        }
+
+        workers.forEach((w) => w.postMessage({ iterations: ITERATIONS_PER_WORKER }));
+    });
+}
+
+async function main() {
+    console.log('=== Worker Scaling Benchmark ===');
+    console.log(`Work per worker: ${ITERATIONS_PER_WORKER} iterations`);
+
+    const results = [];
+    for (let n = 1; n <= MAX_WORKERS; n *= 2) {
+        const ms = await runRound(n);
+        results.push({ n, ms });
+    }
+
+    const base = results[0].ms;
+    console.log('');
+    console.log('workers | wall ms | speedup | efficiency');
+    for (const { n, ms } of results) {
+        const speedup = (base * n) / ms;
+        console.log(
+            String(n).padStart(7) + ' | ' +
+            ms.toFixed(1).padStart(7) + ' | ' +
+            speedup.toFixed(2).padStart(7) + ' | ' +
+            ((speedup / n) * 100).toFixed(0).padStart(9) + '%'
+        );
+    }
+
+    process.exit(0);
+}
+
+main();
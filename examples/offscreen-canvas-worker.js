@@ -0,0 +1,60 @@
+/**
+ * OffscreenCanvas Worker Test
+ *
+ * Transfers the main canvas to a worker, which draws an animated minimap
+ * with Canvas 2D on its own thread and commits a frame every 16 ms. The main
+ * thread keeps running its own loop; the compositor shows whichever frame
+ * the worker committed last.
+ *
+ * Usage:
+ *   mystral run examples/offscreen-canvas-worker.js
+ */
+
+console.log('=== OffscreenCanvas Worker Test ===');
+
+const workerCode = `
+let frames = 0;
+
+self.onmessage = (e) => {
+    const offscreen = e.data.canvas;
+    const ctx = offscreen.getContext('2d');
+    const start = performance.now();
+
+    setInterval(() => {
+        const t = (performance.now() - start) / 1000;
+        ctx.fillStyle = '#101820';
+        ctx.fillRect(0, 0, offscreen.width, offscreen.height);
+
+        // A few hundred moving markers to keep the rasterizer busy
+        for (let i = 0; i < 400; i++) {
+            const a = t * 0.5 + i * 0.37;
+            const x = offscreen.width / 2 + Math.cos(a) * (40 + i * 0.6);
+            const y = offscreen.height / 2 + Math.sin(a * 1.3) * (30 + i * 0.5);
+            ctx.fillStyle = i % 2 ? '#f2aa4c' : '#4cc9f0';
+            ctx.fillRect(x, y, 4, 4);
+        }
+
+        ctx.fillStyle = '#ffffff';
+        ctx.font = '20px sans-serif';
+        ctx.fillText('worker frame ' + frames, 16, 32);
+
+        offscreen.commit();
+        if (++frames % 120 === 0) postMessage({ frames });
+    }, 16);
+};
+`;
+
+const offscreen = canvas.transferControlToOffscreen();
+console.log(`Transferred ${offscreen.width}x${offscreen.height} canvas to a worker`);
+
+const worker = new Worker(new Blob([workerCode]));
+worker.onmessage = (e) => console.log(`Worker committed ${e.data.frames} frames`);
+worker.postMessage({ canvas: offscreen }, [offscreen]);
+
+// The main thread stays free for game logic
+let mainFrames = 0;
+function tick() {
+    mainFrames++;
+    requestAnimationFrame(tick);
+}
+requestAnimationFrame(tick);
@@ -0,0 +1,37 @@
+/**
+ * Virtual Time Test
+ *
+ * Simulates 10 minutes of a timeline (rAF animation plus timers) and prints
+ * the simulated and wall-clock durations. Under --virtual-time every run
+ * prints the same timestamps and finishes in a fraction of real time.
+ *
+ * Usage:
+ *   mystral run examples/virtual-time.js --no-sdl --virtual-time --fixed-dt 16.666
+ */
+
+const SIMULATED_MS = 10 * 60 * 1000;
+const wallStart = Date.now();
+const start = performance.now();
+
+let frames = 0;
+let cues = 0;
+
+// A cue every 30 simulated seconds
+const cueTimer = setInterval(() => {
+    cues++;
+    console.log(`cue ${cues} at ${((performance.now() - start) / 1000).toFixed(3)} s`);
+}, 30000);
+
+function frame(timestamp) {
+    frames++;
+    if (timestamp - start < SIMULATED_MS) {
+        requestAnimationFrame(frame);
+        return;
+    }
+
+    clearInterval(cueTimer);
+    console.log(`simulated ${((timestamp - start) / 1000).toFixed(3)} s in ${frames} frames`);
+    console.log(`wall clock ${((Date.now() - wallStart) / 1000).toFixed(2)} s`);
+}
+
+requestAnimationFrame(frame);
@@ -0,0 +1,52 @@
+/**
+ * Worker Event Loop Test
+ *
+ * Runs setTimeout/setInterval and fetch() inside a worker: the worker loads
+ * this file asynchronously on its own event loop, counts its bytes and
+ * reports back, while a timer keeps ticking alongside the request.
+ *
+ * Usage:
+ *   mystral run examples/worker-fetch-test.js --no-sdl
+ */
+
+console.log('=== Worker Event Loop Test ===');
+
+const code = `
+let ticks = 0;
+const interval = setInterval(() => { ticks++; }, 5);
+
+self.onmessage = async (e) => {
+    const start = performance.now();
+    try {
+        const response = await fetch(e.data);
+        const buffer = await response.arrayBuffer();
+        const ms = performance.now() - start;
+        setTimeout(() => {
+            clearInterval(interval);
+            postMessage({ ok: response.ok, bytes: buffer.byteLength, ms, ticks });
+        }, 20);
+    } catch (err) {
+        postMessage({ ok: false, error: String(err) });
+    }
+};
+`;
+
+const worker = new Worker(new Blob([code]));
+
+worker.onmessage = (e) => {
+    const result = e.data;
+    if (!result.ok) {
+        console.error('Worker fetch failed:', result.error);
+        process.exit(1);
+    }
+    console.log(`Worker fetched ${result.bytes} bytes in ${result.ms.toFixed(2)} ms (interval ticked ${result.ticks} times)`);
+    worker.terminate();
+    process.exit(result.bytes > 0 && result.ticks > 0 ? 0 : 1);
+};
+
+worker.postMessage('examples/worker-fetch-test.js');
+
+setTimeout(() => {
+    console.error('Timed out waiting for the worker');
+    process.exit(1);
+}, 5000);
@@ -0,0 +1,104 @@
+/**
+ * Shared Transforms Example
+ *
+ * A physics worker and the main thread share one SharedArrayBuffer holding
+ * two transform buffers. Each frame the main thread reads the front buffer
+ * and ticks the worker with Atomics.notify; the worker wakes from
+ * Atomics.wait, simulates into the back buffer and publishes it by flipping
+ * the front index. No messages are sent per frame and nothing is copied.
+ *
+ * Usage:
+ *   mystral run examples/worker-shared-transforms.js --no-sdl
+ */
+
+const BODY_COUNT = 10000;
+const FLOATS_PER_BODY = 8;  // position xyz, velocity xyz, padding
+const FRAMES = 120;
+
+// Control block: [front index, tick, published frames, quit]
+const CTRL_FRONT = 0, CTRL_TICK = 1, CTRL_PUBLISHED = 2, CTRL_QUIT = 3;
+
+const workerCode = `
+    self.onmessage = (e) => {
+        const { control, transforms, bodyCount, stride } = e.data;
+        const ctrl = new Int32Array(control);
+        const buffers = [
+            new Float32Array(transforms, 0, bodyCount * stride),
+            new Float32Array(transforms, bodyCount * stride * 4, bodyCount * stride),
+        ];
+        const dt = 1 / 60;
+        let seen = 0;
+
+        while (true) {
+            Atomics.wait(ctrl, ${CTRL_TICK}, seen);
+            if (Atomics.load(ctrl, ${CTRL_QUIT})) break;
+            seen = Atomics.load(ctrl, ${CTRL_TICK});
+
+            const front = Atomics.load(ctrl, ${CTRL_FRONT});
+            const src = buffers[front];
+            const dst = buffers[1 - front];
+            for (let i = 0; i < bodyCount * stride; i += stride) {
+                let vy = src[i + 4] - 9.81 * dt;
+                let y = src[i + 1] + vy * dt;
+                if (y < 0) { y = -y; vy = -vy * 0.8; }
+                dst[i] = src[i] + src[i + 3] * dt;
+                dst[i + 1] = y;
+                dst[i + 2] = src[i + 2] + src[i + 5] * dt;
+                dst[i + 3] = src[i + 3];
+                dst[i + 4] = vy;
+                dst[i + 5] = src[i + 5];
+            }
+
+            Atomics.store(ctrl, ${CTRL_FRONT}, 1 - front);
+            Atomics.add(ctrl, ${CTRL_PUBLISHED}, 1);
+        }
+        postMessage('done');
+    };
+`;
+
+const control = new SharedArrayBuffer(4 * Int32Array.BYTES_PER_ELEMENT);
+const transforms = new SharedArrayBuffer(2 * BODY_COUNT * FLOATS_PER_BODY * 4);
+const ctrl = new Int32Array(control);
+const initial = new Float32Array(transforms, 0, BODY_COUNT * FLOATS_PER_BODY);
+for (let i = 0; i < initial.length; i += FLOATS_PER_BODY) {
+    initial[i + 1] = 10 + Math.random() * 10;
+    initial[i + 3] = Math.random() - 0.5;
+    initial[i + 5] = Math.random() - 0.5;
+}
+
+const worker = new Worker(new Blob([workerCode]));
+worker.onmessage = () => {
+    worker.terminate();
+    process.exit(0);
+};
+worker.postMessage({ control, transforms, bodyCount: BODY_COUNT, stride: FLOATS_PER_BODY });
+
+let frame = 0;
+let readMs = 0;
+function tick() {
+    // Read the published front buffer; the worker only writes the back one
+    const start = performance.now();
+    const front = Atomics.load(ctrl, CTRL_FRONT);
+    const view = new Float32Array(transforms, front * BODY_COUNT * FLOATS_PER_BODY * 4, BODY_COUNT * FLOATS_PER_BODY);
+    let maxY = 0;
+    for (let i = 1; i < view.length; i += FLOATS_PER_BODY) maxY = Math.max(maxY, view[i]);
+    readMs += performance.now() - start;
+
+    if (++frame % 30 === 0) {
+        console.log(`frame ${frame}: published=${Atomics.load(ctrl, CTRL_PUBLISHED)} maxY=${maxY.toFixed(2)}`);
+    }
+
+    if (frame >= FRAMES) {
+        console.log(`avg main-thread read: ${(readMs / frame).toFixed(3)} ms for ${BODY_COUNT} bodies`);
+        Atomics.store(ctrl, CTRL_QUIT, 1);
+        Atomics.notify(ctrl, CTRL_TICK);
+        return;
+    }
+
+    // Let the worker simulate the next step
+    Atomics.add(ctrl, CTRL_TICK, 1);
+    Atomics.notify(ctrl, CTRL_TICK);
+    setTimeout(tick, 16);
+}
+
+setTimeout(tick, 16);
@@ -13,6 +13,10 @@
  *
  * The event loop integrates with the render loop by using UV_RUN_NOWAIT,
  * which only processes ready I/O events without blocking.
+ *
+ * Each thread has its own loop: instance() returns the calling thread's
+ * loop, so the main thread and every worker thread run independent libuv
+ * loops (and their own AsyncHttpClient / AsyncFileReader on top).
  */
 
 #ifdef MYSTRAL_HAS_LIBUV
@@ -20,6 +24,7 @@
 #endif
 
 #include <functional>
+#include <mutex>
 
 namespace mystral {
 namespace async {
@@ -27,8 +32,8 @@ namespace async {
 class EventLoop {
 public:
     /**
-     * Get the singleton event loop instance.
-     * Creates the instance on first call (lazy initialization).
+     * Get the calling thread's event loop instance.
+     * Creates the instance on first call (lazy initialization, per thread).
      */
     static EventLoop& instance();
 
@@ -56,6 +61,20 @@ public:
      */
     bool runOnce();
 
+    /**
+     * Block until an I/O event, a wakeup() or the timeout, then process
+     * whatever became ready (UV_RUN_ONCE).
+     * Returns immediately if the loop has no active handles or requests.
+     * @param timeoutMs Maximum wait (negative waits for the next event)
+     */
+    void waitForEvents(double timeoutMs);
+
+    /**
+     * Interrupt a waitForEvents() in progress.
+     * Safe to call from any thread, including after shutdown (no-op).
+     */
+    void wakeup();
+
     /**
      * Check if the event loop has pending work.
      * Returns true if there are active handles or pending requests.
@@ -94,6 +113,10 @@ private:
 
 #ifdef MYSTRAL_HAS_LIBUV
     uv_loop_t loop_;
+    uv_async_t wakeupAsync_;  // Unref'd: never keeps the loop alive by itself
+    uv_timer_t waitTimer_;    // Bounds waitForEvents(); unref'd
+    std::mutex wakeupMutex_;  // Guards wakeupAsync_ against concurrent close
+    bool wakeupActive_ = false;
 #endif
     bool initialized_ = false;
 };
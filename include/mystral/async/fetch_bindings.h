@@ -0,0 +1,53 @@
+#pragma once
+
+/**
+ * Fetch Bindings (fetch, Response, Headers, Blob)
+ *
+ * Shared by the main runtime and worker threads: installFetchBindings() adds
+ * the async file/HTTP natives and the fetch polyfill to an engine. Requests
+ * run on the calling thread's EventLoop, so the thread that installed the
+ * bindings must pump it (runOnce, processCompletedRequests,
+ * processCompletedReads) and drain its FileCallbackQueue.
+ */
+
+#include "mystral/js/engine.h"
+#include <queue>
+#include <string>
+#include <vector>
+
+namespace mystral {
+namespace async {
+
+/**
+ * Finished __readFileAsync reads waiting to be handed to JS.
+ * Results are delivered from drain() rather than from the read completion,
+ * so callbacks never run inside another callback's stack.
+ */
+class FileCallbackQueue {
+public:
+    void push(js::JSValueHandle callback, std::vector<uint8_t> data, std::string error);
+
+    /**
+     * Invoke every queued callback as callback(data, null) or callback(null, error)
+     */
+    void drain(js::Engine* engine);
+
+    bool empty() const { return pending_.empty(); }
+
+private:
+    struct Pending {
+        js::JSValueHandle callback;
+        std::vector<uint8_t> data;
+        std::string error;
+    };
+    std::queue<Pending> pending_;
+};
+
+/**
+ * Install __readFileAsync, __httpRequestAsync and the fetch polyfill
+ * @param fileCallbacks Receives completed file reads; must outlive the engine's use of fetch
+ */
+void installFetchBindings(js::Engine* engine, FileCallbackQueue& fileCallbacks);
+
+}  // namespace async
+}  // namespace mystral
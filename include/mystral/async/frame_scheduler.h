@@ -0,0 +1,51 @@
+#pragma once
+
+/**
+ * FrameScheduler - Frame rate cap for the main loop
+ *
+ * Tracks when the next requestAnimationFrame batch may start. With a target
+ * rate set, deadlines advance by a fixed interval from the previous one, so
+ * the average rate holds even when individual frames start late; a loop
+ * that falls more than a frame behind resynchronizes instead of bursting to
+ * catch up. Uncapped (the default), the next frame may always start now.
+ *
+ * The runtime's main loop sleeps until nextFrameTime() between frames; how
+ * it sleeps (plain sleep, libuv wait, SDL input wait) is up to the loop.
+ */
+
+#include <chrono>
+
+namespace mystral {
+namespace async {
+
+class FrameScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Set the frame rate cap
+     * @param fps Frames per second; 0, negative or NaN removes the cap
+     */
+    void setTargetFrameRate(double fps);
+
+    double targetFrameRate() const { return fps_; }
+    bool capped() const { return fps_ > 0; }
+
+    /**
+     * Record that a frame started at now and advance the deadline
+     */
+    void frameStarted(Clock::time_point now);
+
+    /**
+     * Earliest time the next frame may start
+     */
+    Clock::time_point nextFrameTime() const { return next_; }
+
+private:
+    double fps_ = 0;
+    Clock::duration interval_{0};
+    Clock::time_point next_{};
+};
+
+}  // namespace async
+}  // namespace mystral
@@ -0,0 +1,71 @@
+#pragma once
+
+/**
+ * RuntimeClock - The main thread's single source of "now"
+ *
+ * performance.now(), requestAnimationFrame timestamps, setTimeout deadlines
+ * and AudioContext.currentTime all read this clock. Normally it follows the
+ * system clocks. In virtual-time mode (--virtual-time) it only moves when
+ * the runtime advances it: by a fixed step after every frame, or straight to
+ * the next timer when nothing else is pending. Runs are then deterministic
+ * and go as fast as the work allows, independent of wall-clock time.
+ *
+ * Reads are safe from any thread (the audio thread reads currentTime);
+ * advancing is main-thread only.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace mystral {
+namespace async {
+
+class RuntimeClock {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static RuntimeClock& instance();
+
+    /**
+     * Switch to virtual time, starting from the current real time
+     * @param fixedDtMs Step added after every frame (milliseconds)
+     */
+    void enableVirtualTime(double fixedDtMs);
+
+    bool isVirtual() const { return virtual_.load(std::memory_order_acquire); }
+    double fixedDtMs() const { return fixedDtMs_; }
+
+    /**
+     * Current time point, for timer deadlines
+     */
+    Clock::time_point now() const;
+
+    /**
+     * Current time in milliseconds, as seen by performance.now() and rAF
+     */
+    double nowMs() const;
+
+    /**
+     * Move virtual time forward (no-op in real time)
+     */
+    void advance(double ms);
+
+    // Prevent copying
+    RuntimeClock(const RuntimeClock&) = delete;
+    RuntimeClock& operator=(const RuntimeClock&) = delete;
+
+private:
+    RuntimeClock() = default;
+
+    static double realMs();
+
+    std::atomic<bool> virtual_{false};
+    double fixedDtMs_ = 0;
+    Clock::time_point origin_;          // Real steady time when virtual time began
+    double originMs_ = 0;               // realMs() at that moment
+    std::atomic<int64_t> elapsedNs_{0};  // Virtual time since origin
+};
+
+}  // namespace async
+}  // namespace mystral
@@ -0,0 +1,142 @@
+#pragma once
+
+/**
+ * TimerQueue - setTimeout/setInterval bookkeeping without per-frame scans
+ *
+ * Pending timers live in a binary min-heap ordered by due time (ties keep
+ * insertion order). Timer ids are slot-map handles: the low bits index a
+ * slot that records the timer's heap position, the high bits hold the
+ * slot's generation, so clearTimeout() finds its timer in O(1) and a stale
+ * id can never cancel a newer timer that reuses the slot. Insert and cancel
+ * are O(log n); a frame with no due timers only looks at the heap top.
+ *
+ * The queue stores callbacks but never protects or unprotects them; the
+ * owning loop does that. Usage from a loop:
+ *
+ *   queue.beginPass(Clock::now());
+ *   TimerQueue::Due timer;
+ *   while (queue.popDue(timer)) {
+ *       engine->call(timer.callback, ...);
+ *       if (timer.intervalMs == 0 || !queue.rearm(timer)) {
+ *           engine->unprotect(timer.callback);
+ *       }
+ *   }
+ *
+ * Used by the main runtime's clock-driven timers and by every worker.
+ */
+
+#include "mystral/js/engine.h"
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace mystral {
+namespace async {
+
+class TimerQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimerId = uint64_t;  // Exact as a JS number (< 2^53)
+
+    struct Due {
+        TimerId id = 0;
+        js::JSValueHandle callback;
+        int intervalMs = 0;  // 0 for setTimeout
+    };
+
+    /**
+     * Convert a JS timer id argument; false for values no timer can have
+     */
+    static bool idFromNumber(double value, TimerId& id);
+
+    /**
+     * Queue a timer due delayMs after now
+     * @param intervalMs 0 for a one-shot timer, otherwise the repeat period
+     * @param now The owner's current time (the runtime clock may be virtual)
+     */
+    TimerId add(js::JSValueHandle callback, int delayMs, int intervalMs, Clock::time_point now);
+
+    /**
+     * Cancel a timer. Returns true with its callback in released when the
+     * caller should release it now. Returns false for unknown ids, and for an
+     * interval cancelled from its own callback: rearm() reports that one.
+     */
+    bool cancel(TimerId id, js::JSValueHandle& released);
+
+    /**
+     * Start running timers: popDue() returns those due by now that were
+     * queued before this call, so callbacks scheduling 0 ms timers or intervals
+     * re-armed during the pass wait for the next one.
+     */
+    void beginPass(Clock::time_point now);
+
+    /**
+     * Take the next due timer of the current pass. One-shot timers leave the
+     * queue; an interval keeps its id until rearm() re-queues it.
+     */
+    bool popDue(Due& timer);
+
+    /**
+     * Re-queue an interval after its callback ran
+     * @return false if it was cancelled meanwhile (release its callback)
+     */
+    bool rearm(const Due& timer);
+
+    /**
+     * Milliseconds until the earliest timer is due (0 if overdue), -1 if none
+     */
+    double msUntilNext(Clock::time_point now) const;
+
+    /**
+     * Drop every timer and return the callbacks to release. Slots are kept
+     * (with a new generation) so ids handed out before never repeat.
+     */
+    std::vector<js::JSValueHandle> clear();
+
+    bool empty() const { return live_ == 0; }
+    size_t size() const { return live_; }
+
+private:
+    static constexpr int kIndexBits = 24;
+    static constexpr uint32_t kIndexMask = (1u << kIndexBits) - 1;
+    static constexpr uint32_t kNotQueued = UINT32_MAX;  // Slot's interval is firing
+
+    struct Entry {
+        Clock::time_point due;
+        uint64_t sequence;
+        uint32_t slot;
+    };
+
+    struct Slot {
+        uint32_t generation = 0;
+        uint32_t heapIndex = kNotQueued;
+        bool live = false;
+        js::JSValueHandle callback;
+        int intervalMs = 0;
+    };
+
+    static bool before(const Entry& a, const Entry& b) {
+        return a.due < b.due || (a.due == b.due && a.sequence < b.sequence);
+    }
+
+    TimerId makeId(uint32_t slot) const;
+    Slot* find(TimerId id);
+    void push(uint32_t slot, Clock::time_point due);
+    void removeAt(uint32_t index);
+    void siftUp(uint32_t index);
+    void siftDown(uint32_t index);
+    void place(uint32_t index, const Entry& entry);
+    void release(uint32_t slot);
+
+    std::vector<Entry> heap_;
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> freeSlots_;
+    size_t live_ = 0;
+    uint64_t nextSequence_ = 0;
+
+    Clock::time_point passNow_;
+    uint64_t passSequence_ = 0;
+};
+
+}  // namespace async
+}  // namespace mystral
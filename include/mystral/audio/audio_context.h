@@ -208,6 +208,7 @@ private:
     float sampleRate_ = 44100.0f;
     uint64_t startTime_ = 0;
     uint64_t sampleCount_ = 0;
+    double clockOriginMs_ = 0;  // Runtime clock at creation; currentTime follows it under --virtual-time
 
     std::unique_ptr<AudioDestinationNode> destination_;
     std::vector<AudioBufferSourceNode*> activeSources_;
@@ -0,0 +1,133 @@
+/**
+ * OffscreenCanvas (transferred control)
+ *
+ * canvas.transferControlToOffscreen() hands the main canvas to an
+ * OffscreenCanvas that can be posted to a worker. The worker owns the
+ * Canvas2DContext and draws on its own thread; offscreen.commit() copies the
+ * pixels into a FrameTripleBuffer, and the compositor on the main thread
+ * picks up the newest committed frame without ever blocking the worker.
+ *
+ * Worker usage:
+ *   self.onmessage = (e) => {
+ *       const ctx = e.data.canvas.getContext('2d');
+ *       ...draw...
+ *       e.data.canvas.commit();
+ *   };
+ */
+
+#pragma once
+
+#include "mystral/js/engine.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace mystral {
+namespace canvas {
+
+class Canvas2DContext;
+
+/**
+ * One committed frame: immutable once published
+ */
+struct CanvasFrame {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels;  // RGBA8, width * height * 4
+    uint64_t serial = 0;          // Increases with every publish
+};
+
+/**
+ * Lock-free triple buffer between one producer and one consumer thread.
+ * The producer writes its back slot and publishes it; the consumer takes the
+ * newest published slot. Neither side ever waits for the other, and stale
+ * frames are simply overwritten.
+ */
+class FrameTripleBuffer {
+public:
+    /**
+     * Producer only: the slot to fill before publish()
+     */
+    CanvasFrame& back() { return slots_[back_]; }
+
+    /**
+     * Producer only: make back() the newest frame
+     */
+    void publish();
+
+    /**
+     * Consumer only: the newest published frame, or nullptr before the first publish.
+     * The frame stays valid until the next acquire() call.
+     */
+    const CanvasFrame* acquire();
+
+private:
+    static constexpr int kFreshBit = 4;  // Set in middle_ when it holds an unread frame
+
+    CanvasFrame slots_[3];
+    int back_ = 0;                // Producer's slot
+    int front_ = 1;               // Consumer's slot
+    std::atomic<int> middle_{2};  // Slot index | kFreshBit
+    uint64_t nextSerial_ = 1;
+};
+
+/**
+ * Shared state behind a canvas whose control was transferred.
+ * Reference counted: the compositor, each OffscreenCanvas object and the
+ * thread drawing into it hold a reference, so it is freed once all let go.
+ */
+class TransferredCanvas {
+public:
+    TransferredCanvas(int width, int height) : width_(width), height_(height) {}
+
+    void addRef() { refs_.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * Drop a reference; deletes the canvas when it was the last one
+     */
+    void release() {
+        if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+    }
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    /**
+     * Take ownership of the drawing side. Only the first caller succeeds.
+     */
+    bool claim() { return !claimed_.exchange(true); }
+
+    /**
+     * Publish the context's current pixels as the next frame (owner thread)
+     */
+    void commit(const Canvas2DContext& context);
+
+    FrameTripleBuffer& frames() { return frames_; }
+
+private:
+    int width_;
+    int height_;
+    std::atomic<int> refs_{1};
+    std::atomic<bool> claimed_{false};
+    FrameTripleBuffer frames_;
+};
+
+/**
+ * Allocate a TransferredCanvas holding one reference for the caller
+ */
+TransferredCanvas* createTransferredCanvas(int width, int height);
+
+/**
+ * Create the JS OffscreenCanvas for a transferred canvas.
+ * It carries the pointer as a native handle, so postMessage moves it by
+ * reference; the object and every posted copy hold their own reference.
+ */
+js::JSValueHandle createOffscreenCanvasObject(js::Engine* engine, TransferredCanvas* canvas);
+
+/**
+ * Register "offscreenCanvas" as a native handle type (once per process)
+ */
+void registerOffscreenCanvasHandle();
+
+}  // namespace canvas
+}  // namespace mystral
@@ -0,0 +1,122 @@
+#pragma once
+
+/**
+ * FrameStats - Rolling frame-time statistics for performance.frameStats()
+ *
+ * The runtime times each phase of pollEvents() with a FramePhase scope.
+ * Work from loop iterations that render nothing (a timer firing between
+ * frames) is carried into the next rendered frame, so a frame's record is
+ * all the main-thread work since the previous one. The last `window` frames
+ * are kept; percentiles are computed when asked for, not per frame.
+ *
+ * FramePhase also emits the phase as a trace span, so --trace and
+ * frameStats() always agree on phase names and boundaries.
+ */
+
+#include "mystral/debug/trace.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace mystral {
+namespace debug {
+
+class FrameStats {
+public:
+    enum Phase {
+        SdlPoll,
+        EventLoop,
+        HttpCompletions,
+        FsCompletions,
+        FileWatcher,
+        Timers,
+        FileCallbacks,
+        JobCompletions,
+        WorkerMessages,
+        Microtasks,
+        AnimationFrame,
+        ClearFrameHandles,
+        PhaseCount
+    };
+
+    struct Distribution {
+        double mean = 0;
+        double p50 = 0;
+        double p95 = 0;
+        double p99 = 0;
+        double max = 0;
+    };
+
+    struct Summary {
+        size_t frames = 0;
+        size_t longFrames = 0;
+        Distribution frameMs;
+        std::array<Distribution, PhaseCount> phaseMs;
+    };
+
+    static const char* phaseName(Phase phase);
+
+    explicit FrameStats(size_t window = 600);
+
+    void addPhase(Phase phase, uint64_t durationNs) { pending_.phaseNs[phase] += durationNs; }
+
+    /**
+     * End one pollEvents() iteration that took workNs
+     * @param rendered Whether it ran animation frame callbacks (only those are recorded)
+     */
+    void endIteration(uint64_t workNs, bool rendered);
+
+    /**
+     * Statistics over the window
+     * @param longFrameMs Frames whose work exceeds this count as long
+     */
+    Summary summarize(double longFrameMs) const;
+
+    void reset();
+
+private:
+    struct Record {
+        uint64_t workNs = 0;
+        std::array<uint64_t, PhaseCount> phaseNs{};
+    };
+
+    std::vector<Record> ring_;
+    size_t next_ = 0;
+    size_t count_ = 0;
+    Record pending_;
+};
+
+/**
+ * Times one phase of the current iteration (and traces it)
+ */
+class FramePhase {
+public:
+    FramePhase(FrameStats& stats, FrameStats::Phase phase)
+        : stats_(stats), phase_(phase), start_(trace::nowNs()) {}
+
+    ~FramePhase() {
+        uint64_t duration = trace::nowNs() - start_;
+        stats_.addPhase(phase_, duration);
+#ifdef MYSTRAL_ENABLE_TRACING
+        if (trace::isEnabled()) {
+            trace::recordComplete(FrameStats::phaseName(phase_), "mystral", start_, duration);
+        }
+#endif
+    }
+
+    FramePhase(const FramePhase&) = delete;
+    FramePhase& operator=(const FramePhase&) = delete;
+
+private:
+    FrameStats& stats_;
+    FrameStats::Phase phase_;
+    uint64_t start_;
+};
+
+/**
+ * Resident set size of the process in bytes (0 where unsupported)
+ */
+uint64_t processResidentBytes();
+
+}  // namespace debug
+}  // namespace mystral
@@ -0,0 +1,74 @@
+#pragma once
+
+/**
+ * PerformanceTimeline - Native storage for performance.mark/measure
+ *
+ * User Timing entries live in a fixed-size ring (the oldest entry is
+ * overwritten once it is full), so a game that marks every frame never grows
+ * memory. Entry times are on the performance.now() timebase; each entry also
+ * carries its trace timestamp, so marks and measures show up next to the
+ * engine's own spans when --trace is recording.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mystral {
+namespace debug {
+
+class PerformanceTimeline {
+public:
+    enum class EntryType { Mark, Measure };
+
+    struct Entry {
+        std::string name;
+        EntryType type = EntryType::Mark;
+        double startTime = 0;  // performance.now() milliseconds
+        double duration = 0;   // 0 for marks
+        uint64_t traceNs = 0;  // Start on the trace timeline
+    };
+
+    explicit PerformanceTimeline(size_t capacity = 4096);
+
+    /**
+     * Record a mark at startTime
+     * @param nowMs performance.now() at the call, to place an explicit startTime on the trace
+     */
+    const Entry& mark(const std::string& name, double startTime, double nowMs);
+
+    /**
+     * Record a measure from startTime to endTime
+     */
+    const Entry& measure(const std::string& name, double startTime, double endTime, double nowMs);
+
+    /**
+     * Latest mark with this name
+     * @return false if there is none
+     */
+    bool findMark(const std::string& name, double& startTime) const;
+
+    /**
+     * Entries in insertion order, optionally filtered (empty name matches all)
+     */
+    std::vector<Entry> entries(const std::string& name, const EntryType* type) const;
+
+    /**
+     * Remove entries of one type, all of them or only those with this name
+     */
+    void clear(EntryType type, const std::string& name);
+
+    size_t size() const { return count_; }
+
+    static const char* typeName(EntryType type) { return type == EntryType::Mark ? "mark" : "measure"; }
+
+private:
+    Entry& push();
+
+    std::vector<Entry> ring_;
+    size_t first_ = 0;  // Index of the oldest entry
+    size_t count_ = 0;
+};
+
+}  // namespace debug
+}  // namespace mystral
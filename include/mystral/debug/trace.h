@@ -0,0 +1,126 @@
+#pragma once
+
+/**
+ * Trace - Low-overhead timeline instrumentation
+ *
+ * Scoped events are recorded into a thread-local ring buffer (no locks, no
+ * allocation after a thread's first event) and written out as Chrome
+ * trace-event JSON, which Perfetto and chrome://tracing load directly.
+ * Every thread that records gets its own track: main, workers, job pool.
+ *
+ * Usage:
+ *   debug::trace::start();                      // --trace out.json
+ *   {
+ *       MYSTRAL_TRACE_SCOPE("timers");          // One complete ("X") event
+ *       executeTimerCallbacks();
+ *   }
+ *   debug::trace::stopAndWrite("out.json");
+ *
+ * Event names and categories must be string literals (or otherwise outlive
+ * the trace); use intern() for names built at runtime.
+ *
+ * Building with -DMYSTRAL_ENABLE_TRACING=OFF compiles the macros out. While
+ * tracing is compiled in but not started, a scope costs one relaxed load.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace mystral {
+namespace debug {
+namespace trace {
+
+namespace detail {
+extern std::atomic<bool> g_enabled;
+}
+
+/**
+ * Whether events are being recorded
+ */
+inline bool isEnabled() {
+    return detail::g_enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Start recording
+ * @param eventsPerThread Ring size; a thread's oldest events are overwritten past it
+ */
+void start(size_t eventsPerThread = 1 << 16);
+
+/**
+ * Stop recording and write every thread's events as trace-event JSON
+ * @return false if the file could not be written
+ */
+bool stopAndWrite(const std::string& path);
+
+/**
+ * Nanoseconds on the trace timeline (steady clock)
+ */
+uint64_t nowNs();
+
+/**
+ * Name the calling thread's track ("Main", "Worker 2", "Job 0")
+ */
+void setThreadName(const std::string& name);
+
+/**
+ * Return a stable copy of a runtime-built name, valid until process exit
+ */
+const char* intern(const std::string& name);
+
+/**
+ * Record a complete event (a span with a start and a duration)
+ */
+void recordComplete(const char* name, const char* category, uint64_t startNs, uint64_t durationNs);
+
+/**
+ * Record an instant event (a point in time)
+ */
+void recordInstant(const char* name, const char* category, uint64_t timeNs);
+
+/**
+ * Write text JSON-escaped (without the surrounding quotes)
+ */
+void writeEscaped(std::ostream& out, const char* text);
+
+/**
+ * RAII span: records a complete event from construction to destruction
+ */
+class Scope {
+public:
+    explicit Scope(const char* name, const char* category = "mystral")
+        : name_(name), category_(category), start_(isEnabled() ? nowNs() : 0) {}
+
+    ~Scope() {
+        if (start_ && isEnabled()) {
+            recordComplete(name_, category_, start_, nowNs() - start_);
+        }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* name_;
+    const char* category_;
+    uint64_t start_;
+};
+
+}  // namespace trace
+}  // namespace debug
+}  // namespace mystral
+
+#define MYSTRAL_TRACE_CONCAT_INNER(a, b) a##b
+#define MYSTRAL_TRACE_CONCAT(a, b) MYSTRAL_TRACE_CONCAT_INNER(a, b)
+
+#ifdef MYSTRAL_ENABLE_TRACING
+#define MYSTRAL_TRACE_SCOPE(name) \
+    ::mystral::debug::trace::Scope MYSTRAL_TRACE_CONCAT(mystralTraceScope_, __LINE__)(name)
+#define MYSTRAL_TRACE_SCOPE_CAT(name, category) \
+    ::mystral::debug::trace::Scope MYSTRAL_TRACE_CONCAT(mystralTraceScope_, __LINE__)(name, category)
+#else
+#define MYSTRAL_TRACE_SCOPE(name) ((void)0)
+#define MYSTRAL_TRACE_SCOPE_CAT(name, category) ((void)0)
+#endif
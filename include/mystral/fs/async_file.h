@@ -14,7 +14,8 @@
  *       }
  *   });
  *
- * The callback runs on the main thread during EventLoop::runOnce().
+ * The callback runs on the calling thread during processCompletedReads().
+ * Every thread (main or worker) gets its own reader and EventLoop.
  */
 
 #include <functional>
@@ -29,7 +30,7 @@ namespace fs {
 
 /**
  * Callback type for async file reads.
- * Called on the main thread when the read completes.
+ * Called on the thread that issued the read when it completes.
  * If error is non-empty, data will be empty.
  */
 using AsyncFileCallback = std::function<void(std::vector<uint8_t> data, std::string error)>;
@@ -37,13 +38,15 @@ using AsyncFileCallback = std::function<void(std::vector<uint8_t> data, std::str
 /**
  * Async File Reader using libuv thread pool
  *
- * This is a singleton that manages async file read operations.
- * File reads happen on libuv's thread pool to avoid blocking the main thread.
+ * This is a per-thread singleton that manages async file read operations.
+ * File reads happen on libuv's thread pool to avoid blocking the calling thread.
  */
 class AsyncFileReader {
 public:
+    struct Impl;
+
     /**
-     * Get the singleton instance.
+     * Get the calling thread's instance.
      */
     static AsyncFileReader& instance();
 
@@ -65,7 +68,7 @@ public:
 
     /**
      * Read a file asynchronously.
-     * The callback is invoked on the main thread when complete.
+     * The callback is invoked on this thread when complete.
      */
     void readFile(const std::string& path, AsyncFileCallback callback);
 
@@ -84,7 +87,6 @@ private:
     AsyncFileReader();
     ~AsyncFileReader();
 
-    struct Impl;
     std::unique_ptr<Impl> impl_;
 };
 
@@ -15,7 +15,8 @@
  *       }
  *   });
  *
- * The callback runs on the main thread during EventLoop::runOnce().
+ * The callback runs on the calling thread during processCompletedRequests().
+ * Every thread (main or worker) gets its own client and EventLoop.
  */
 
 #include "mystral/http/http_client.h"  // HttpResponse, HttpOptions
@@ -36,20 +37,20 @@ namespace http {
 
 /**
  * Callback type for async HTTP responses.
- * Called on the main thread when the request completes (success or failure).
+ * Called on the thread that issued the request when it completes (success or failure).
  */
 using AsyncHttpCallback = std::function<void(HttpResponse)>;
 
 /**
  * Async HTTP Client using curl_multi + libuv
  *
- * This is a singleton that manages all async HTTP requests.
- * It integrates with the libuv event loop for non-blocking I/O.
+ * This is a per-thread singleton that manages the thread's async HTTP requests.
+ * It integrates with the thread's libuv event loop for non-blocking I/O.
  */
 class AsyncHttpClient {
 public:
     /**
-     * Get the singleton instance.
+     * Get the calling thread's instance.
      */
     static AsyncHttpClient& instance();
 
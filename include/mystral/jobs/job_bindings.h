@@ -0,0 +1,20 @@
+/**
+ * Job System JavaScript Bindings (mystral.jobs)
+ */
+
+#pragma once
+
+namespace mystral {
+namespace js {
+class Engine;
+}
+
+namespace jobs {
+
+/**
+ * Install mystral.jobs (parallelFor over registered native kernels)
+ */
+void initializeJobBindings(js::Engine* engine);
+
+}  // namespace jobs
+}  // namespace mystral
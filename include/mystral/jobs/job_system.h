@@ -0,0 +1,188 @@
+#pragma once
+
+/**
+ * JobSystem - Native work-stealing thread pool
+ *
+ * One pool for all background CPU work: asset decoding (Draco, images,
+ * audio) and data-parallel kernels invoked from JS via
+ * mystral.jobs.parallelFor(). Each pool thread owns a deque per priority;
+ * idle threads steal from the others, highest priority first.
+ *
+ * Usage:
+ *   auto& jobs = JobSystem::instance();
+ *
+ *   // Background job; the completion runs on the main thread (runCompletions)
+ *   jobs.submit([ctx] { decode(ctx); }, [ctx] { deliver(ctx); }, JobPriority::Normal);
+ *
+ *   // Blocking data-parallel loop; the calling thread helps
+ *   jobs.parallelFor(count, 0, [&](size_t begin, size_t end) { ... });
+ *
+ *   // Named kernel on raw buffers (what the JS API calls)
+ *   jobs.runKernel("cullSpheres", count, args, error);
+ */
+
+#include "mystral/workers/wakeup_signal.h"
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace mystral {
+namespace jobs {
+
+/**
+ * Scheduling priority (lower value runs first)
+ */
+enum class JobPriority {
+    High = 0,    // Frame-critical work (parallelFor chunks)
+    Normal = 1,  // Asset decoding the game is waiting on
+    Low = 2,     // Speculative / prefetch work
+};
+
+/**
+ * A buffer handed to a kernel (typed array / ArrayBuffer / SharedArrayBuffer bytes)
+ */
+struct KernelBuffer {
+    void* data = nullptr;
+    size_t length = 0;  // Bytes
+};
+
+/**
+ * Arguments for a kernel invocation
+ */
+struct KernelArgs {
+    std::vector<KernelBuffer> buffers;
+    std::vector<double> params;
+    size_t count = 0;  // Total items of this invocation (set by runKernel)
+};
+
+/**
+ * A native kernel that processes items [begin, end) of a parallelFor
+ */
+struct Kernel {
+    // Process one chunk; called concurrently on disjoint ranges
+    std::function<void(const KernelArgs& args, size_t begin, size_t end)> run;
+    // Check buffer sizes before anything runs; return an error message or ""
+    std::function<std::string(const KernelArgs& args, size_t count)> validate;
+    // Optional serial pass after all chunks finish (e.g. merging sorted runs)
+    std::function<void(const KernelArgs& args, size_t count, size_t grain)> finish;
+    // Items per chunk (0 = pick from count and thread count)
+    size_t grain = 0;
+};
+
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    /**
+     * Get the singleton instance (threads start on first use)
+     */
+    static JobSystem& instance();
+
+    /**
+     * Queue a job on the pool
+     */
+    void submit(Job job, JobPriority priority = JobPriority::Normal);
+
+    /**
+     * Queue a job whose completion must run on the main thread
+     * @param work Runs on a pool thread
+     * @param complete Queued for runCompletions() once work has finished
+     */
+    void submit(Job work, Job complete, JobPriority priority = JobPriority::Normal);
+
+    /**
+     * Run completions of finished jobs (main thread, once per frame)
+     * @return Number of completions run
+     */
+    size_t runCompletions();
+
+    /**
+     * Whether any submit(work, complete) job has not had its completion run yet
+     */
+    bool hasPendingWork() const { return outstanding_.load(std::memory_order_acquire) > 0; }
+
+    /**
+     * Run fn over [0, count) in chunks across the pool and wait for all of them
+     * The calling thread processes chunks too, so this is safe to nest.
+     * @param grain Items per chunk (0 = automatic)
+     * @return The grain that was used
+     */
+    size_t parallelFor(size_t count, size_t grain, const std::function<void(size_t begin, size_t end)>& fn);
+
+    /**
+     * Register a named kernel (replaces an existing one with the same name)
+     */
+    void registerKernel(const std::string& name, Kernel kernel);
+
+    /**
+     * Names of all registered kernels
+     */
+    std::vector<std::string> kernelNames() const;
+
+    /**
+     * Validate and run a kernel over [0, count); blocks until done
+     * @return false (with error set) for an unknown kernel or bad arguments
+     */
+    bool runKernel(const std::string& name, size_t count, const KernelArgs& args, std::string& error);
+
+    /**
+     * Number of pool threads
+     */
+    size_t threadCount() const { return threads_.size(); }
+
+    /**
+     * Stop and join all pool threads (queued jobs and completions are dropped)
+     */
+    void shutdown();
+
+    // Prevent copying
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+private:
+    JobSystem();
+    ~JobSystem();
+
+    static constexpr int kPriorityCount = 3;
+
+    // Per-thread deques; the owner pops the newest job, thieves take the oldest
+    struct alignas(64) WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs[kPriorityCount];
+    };
+
+    void push(Job job, JobPriority priority, size_t queueIndex);
+    bool findJob(size_t self, Job& out);
+    void threadMain(size_t index);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> threads_;
+    std::atomic<bool> running_{false};
+    std::atomic<size_t> queued_{0};       // Jobs sitting in deques
+    std::atomic<size_t> nextQueue_{0};    // Round-robin target for external submits
+    workers::WakeupSignal wakeup_;
+
+    // Completions waiting for the main thread
+    std::mutex completionMutex_;
+    std::vector<Job> completions_;
+    std::atomic<size_t> outstanding_{0};
+
+    // Kernel registry (registration is rare; lookups copy the Kernel out)
+    mutable std::mutex kernelMutex_;
+    std::unordered_map<std::string, Kernel> kernels_;
+};
+
+/**
+ * Register the built-in kernels (cullSpheres, mat4Multiply, transformAABB, sortByKey)
+ */
+void registerBuiltinKernels(JobSystem& jobs);
+
+}  // namespace jobs
+}  // namespace mystral
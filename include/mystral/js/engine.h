@@ -12,6 +12,8 @@
 #include <functional>
 #include <vector>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 
 namespace mystral {
 namespace js {
@@ -31,6 +33,41 @@ struct JSValueHandle {
  */
 using NativeFunction = std::function<JSValueHandle(void* ctx, const std::vector<JSValueHandle>& args)>;
 
+/**
+ * Native memory behind an ArrayBuffer, detached from any engine.
+ * Used to move ArrayBuffers between engines (e.g. main thread <-> worker)
+ * without copying. The release callback runs when the last reference drops,
+ * which may happen on a different thread than the one that created it.
+ */
+struct BackingStore {
+    void* data = nullptr;
+    size_t length = 0;
+    std::function<void(void* data)> release;
+
+    // Engine-native object kept alive with the store (e.g. v8::BackingStore),
+    // so another engine of the same type can wrap the very same allocation.
+    std::shared_ptr<void> owner;
+
+    BackingStore() = default;
+    BackingStore(const BackingStore&) = delete;
+    BackingStore& operator=(const BackingStore&) = delete;
+    ~BackingStore() {
+        if (release) release(data);
+    }
+
+    /**
+     * Allocate a malloc-backed store, optionally copying initial bytes into it
+     */
+    static std::shared_ptr<BackingStore> allocate(size_t length, const void* bytes = nullptr) {
+        auto store = std::make_shared<BackingStore>();
+        store->data = std::malloc(length > 0 ? length : 1);
+        store->length = length;
+        store->release = [](void* p) { std::free(p); };
+        if (bytes && length > 0) std::memcpy(store->data, bytes, length);
+        return store;
+    }
+};
+
 /**
  * Engine type enumeration
  */
@@ -117,6 +154,16 @@ public:
     virtual JSValueHandle newBoolean(bool value) = 0;
     virtual JSValueHandle newNumber(double value) = 0;
     virtual JSValueHandle newString(const char* value) = 0;
+
+    /**
+     * Create a string from UTF-8 bytes with an explicit length (may contain NULs)
+     * The bytes must be valid UTF-8. The default copies into a C string, so
+     * engines that can take a length directly should override it.
+     */
+    virtual JSValueHandle newStringUtf8(const char* data, size_t length) {
+        return newString(std::string(data, length).c_str());
+    }
+
     virtual JSValueHandle newObject() = 0;
     virtual JSValueHandle newArray(size_t length = 0) = 0;
 
@@ -145,6 +192,51 @@ public:
      */
     virtual void* getArrayBufferData(JSValueHandle value, size_t* size) = 0;
 
+    /**
+     * Detach an ArrayBuffer and take ownership of its backing store
+     * After this call the JS ArrayBuffer has byteLength 0. Engines that can
+     * hand over their allocation do so without copying; the default copies
+     * the bytes and leaves the source intact (no detach support).
+     * @return The backing store, or nullptr if value is not an ArrayBuffer
+     */
+    virtual std::shared_ptr<BackingStore> detachArrayBuffer(JSValueHandle value) {
+        size_t size = 0;
+        void* data = getArrayBufferData(value, &size);
+        if (!data) return nullptr;
+        return BackingStore::allocate(size, data);
+    }
+
+    /**
+     * Create an ArrayBuffer that adopts a backing store (no copy)
+     * The ArrayBuffer keeps the store alive until it is garbage collected.
+     */
+    virtual JSValueHandle newArrayBufferFromStore(std::shared_ptr<BackingStore> store) {
+        if (!store) return newNull();
+        return newArrayBuffer(static_cast<const uint8_t*>(store->data), store->length);
+    }
+
+    /**
+     * Get a reference to a SharedArrayBuffer's memory (the buffer stays usable)
+     * Engines that cannot share memory across instances return nullptr.
+     */
+    virtual std::shared_ptr<BackingStore> getSharedArrayBufferStore(JSValueHandle value) {
+        return nullptr;
+    }
+
+    /**
+     * Create a SharedArrayBuffer over a store from getSharedArrayBufferStore()
+     * of an engine of the same type; writes are visible to every wrapper.
+     */
+    virtual JSValueHandle newSharedArrayBuffer(std::shared_ptr<BackingStore> store) {
+        return newNull();
+    }
+
+    /**
+     * Let Atomics.wait block this engine's thread. Off by default: as in
+     * browsers only workers may block, and elsewhere Atomics.wait throws.
+     */
+    virtual void setAtomicsWaitAllowed(bool allowed) {}
+
     /**
      * Create a Float32Array from raw data
      * @param data Pointer to the float data (will be copied)
@@ -237,6 +329,17 @@ public:
      */
     virtual void gc() = 0;
 
+    /**
+     * JS heap usage in bytes, for performance.memory
+     * Fields are zero where the engine doesn't report them.
+     */
+    struct HeapStats {
+        size_t usedBytes = 0;
+        size_t totalBytes = 0;
+        size_t limitBytes = 0;
+    };
+    virtual HeapStats getHeapStats() { return {}; }
+
     /**
      * Signal the start of a new animation frame.
      * Enables per-frame allocation tracking (e.g., NativeFunction objects).
@@ -273,6 +376,15 @@ public:
      */
     virtual void registerRelease(JSValueHandle obj, std::function<void()> callback) {}
 
+    /**
+     * Release a handle before the end of the frame.
+     * For native loops that touch many values (e.g. structured clone), which
+     * would otherwise hold every intermediate handle until clearFrameHandles().
+     * Only for handles the caller obtained itself - never native-function
+     * arguments or protected handles.
+     */
+    virtual void releaseHandle(JSValueHandle value) {}
+
     // ========================================================================
     // Error Handling
     // ========================================================================
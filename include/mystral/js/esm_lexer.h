@@ -0,0 +1,79 @@
+#pragma once
+
+/**
+ * ESM lexer - finds import/export statements and rewrites them to CommonJS
+ *
+ * JSC and QuickJS builds evaluate ES modules as CommonJS, so every module
+ * goes through transformEsmToCjs() before it runs. The lexer makes one pass
+ * over the source, skipping comments, strings, template literals (with
+ * nested substitutions) and regex literals, and only looks at `import` /
+ * `export` at the top level. Statements may span any number of lines.
+ *
+ * The rewrite keeps line numbers: each statement is replaced in place and
+ * padded with the newlines it covered; the export bindings are defined as
+ * getters on the first line, so exports are live and visible to cycles
+ * before the module body finishes. import.meta becomes { url, hot } with
+ * hot taken from module.hot.
+ */
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mystral {
+namespace js {
+
+/**
+ * One static import or export statement
+ */
+struct EsmStatement {
+    enum class Kind {
+        Import,              // import ... from "x" / import "x"
+        ExportDeclaration,   // export const|let|var|function|class ...
+        ExportDefault,       // export default ...
+        ExportList,          // export { a, b as c }
+        ExportFrom,          // export { a, b as c } from "x"
+        ExportAll,           // export * from "x" / export * as ns from "x"
+    };
+
+    Kind kind = Kind::Import;
+    size_t start = 0;  // Offset of `import` / `export`
+    size_t end = 0;    // One past the text the rewrite replaces (the whole
+                       // statement, or just `export [default]` for declarations)
+
+    std::string specifier;         // Module specifier (escapes decoded), if any
+    std::string specifierLiteral;  // The specifier as written, quotes included
+
+    std::string defaultName;    // Import: default binding; ExportDefault: declared name
+    std::string namespaceName;  // `* as name` (Import, ExportAll)
+
+    // Import: (imported, local); ExportList: (local, exported);
+    // ExportFrom: (imported, exported)
+    std::vector<std::pair<std::string, std::string>> names;
+
+    std::vector<std::string> declared;  // ExportDeclaration: bound names
+
+    bool defaultIsDeclaration = false;  // ExportDefault: function/class declaration
+    size_t nameInsertAt = std::string::npos;  // ExportDefault: anonymous declaration needs a name here
+};
+
+struct EsmScanResult {
+    std::vector<EsmStatement> statements;
+    std::vector<std::string> dynamicImports;  // import("x") with a string literal
+    std::vector<std::string> requireCalls;    // require("x") with a string literal
+    std::vector<std::pair<size_t, size_t>> importMetas;  // import.meta expressions: [start, end)
+};
+
+/**
+ * Find the top-level import/export statements of a module
+ */
+EsmScanResult scanEsm(const std::string& source);
+
+/**
+ * Rewrite an ES module as a CommonJS module body (exports/require)
+ */
+std::string transformEsmToCjs(const std::string& source);
+
+}  // namespace js
+}  // namespace mystral
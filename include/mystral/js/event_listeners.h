@@ -0,0 +1,83 @@
+#pragma once
+
+/**
+ * EventListenerTable - DOM event listeners keyed by interned ids
+ *
+ * Event type strings are interned once (at addEventListener, or when an
+ * input event type is first seen) into dense ids; listeners live in a flat
+ * array indexed by type id and target. Dispatch is one hash lookup for the
+ * type string, then array indexing - and a per-type target mask lets the
+ * runtime skip building the JS event object when nobody is listening.
+ *
+ * The table stores callbacks but never protects or unprotects them; the
+ * runtime does that.
+ */
+
+#include "mystral/js/engine.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mystral {
+namespace js {
+
+enum class EventTarget : uint8_t {
+    Document,
+    Window,
+    Canvas,
+    Count
+};
+
+class EventListenerTable {
+public:
+    using TypeId = uint32_t;
+    static constexpr TypeId kNoType = UINT32_MAX;
+
+    struct Listener {
+        JSValueHandle callback;
+        bool useCapture = false;
+    };
+
+    /**
+     * Id for an event type, assigning the next one if it is new
+     */
+    TypeId intern(const std::string& type);
+
+    /**
+     * Id for an event type, or kNoType if no listener was ever added for it
+     */
+    TypeId find(const std::string& type) const;
+
+    void add(EventTarget target, const std::string& type, JSValueHandle callback, bool useCapture);
+
+    /**
+     * Whether any target has a listener for this type
+     */
+    bool hasListeners(TypeId type) const {
+        return type < targetMasks_.size() && targetMasks_[type] != 0;
+    }
+
+    bool hasListeners(TypeId type, EventTarget target) const {
+        return type < targetMasks_.size() && (targetMasks_[type] & targetBit(target)) != 0;
+    }
+
+    /**
+     * Listeners of one target for one type (type must come from intern()/find())
+     * The vector may grow while its listeners run: index it, don't iterate it.
+     */
+    const std::vector<Listener>& listeners(EventTarget target, TypeId type) const {
+        return lists_[type][static_cast<size_t>(target)];
+    }
+
+private:
+    static uint8_t targetBit(EventTarget target) { return static_cast<uint8_t>(1u << static_cast<unsigned>(target)); }
+
+    std::unordered_map<std::string, TypeId> ids_;
+    std::vector<std::array<std::vector<Listener>, static_cast<size_t>(EventTarget::Count)>> lists_;
+    std::vector<uint8_t> targetMasks_;  // Per type: bit per target with listeners
+};
+
+}  // namespace js
+}  // namespace mystral
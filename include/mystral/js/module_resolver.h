@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <map>
 #include <string>
 #include <unordered_map>
@@ -29,6 +30,28 @@ struct ResolvedModule {
     ModuleFormat format = ModuleFormat::CJS;
 };
 
+/**
+ * Resolver cache counters since construction
+ */
+struct ResolverStats {
+    uint64_t resolves = 0;        // resolve() calls
+    uint64_t resolveHits = 0;     // ... answered from the resolution cache
+    uint64_t statCalls = 0;       // Filesystem stats (bundle lookups in bundle mode)
+    uint64_t statHits = 0;        // Existence checks answered from the stat cache
+    uint64_t packageJsonReads = 0;
+};
+
+/**
+ * Node-style module resolution
+ *
+ * Results are memoized: resolve() by (specifier, referrer directory, mode -
+ * which picks the export conditions), file/directory existence (found and
+ * missing) by path, parsed package.json by package root, and the nearest
+ * package.json by directory. Files don't usually appear or vanish while a
+ * game runs; in watch mode the runtime calls invalidate() for changed paths.
+ * Not thread-safe: resolve on the module-loading thread only (readFile() may
+ * be called from any thread).
+ */
 class ModuleResolver {
 public:
     explicit ModuleResolver(const std::string& rootDir);
@@ -47,6 +70,20 @@ public:
 
     bool readFile(const ResolvedPath& path, std::string& out, std::string& error) const;
 
+    /**
+     * Forget what is cached about path (a watched file changed, appeared or
+     * was deleted). Also drops every cached resolution and every cached
+     * "missing" result, since any of them may depend on path.
+     */
+    void invalidate(const std::string& path);
+
+    /**
+     * Drop all cached resolutions, stats and package.json files
+     */
+    void clearCaches();
+
+    const ResolverStats& stats() const { return stats_; }
+
     std::string dirname(const std::string& path) const;
     std::string normalizeSpecifier(const std::string& specifier) const;
     bool usingBundle() const;
@@ -80,9 +117,38 @@ private:
         JsonValue importsValue;
     };
 
+    enum class PathKind : uint8_t {
+        Missing,
+        File,
+        Directory
+    };
+
+    struct CachedResolution {
+        bool ok = false;
+        ResolvedModule module;
+        std::string error;
+    };
+
+    struct CachedPackage {
+        bool ok = false;
+        PackageInfo info;
+        std::string error;
+    };
+
     std::string rootDir_;
     bool useBundle_ = false;
-    mutable std::unordered_map<std::string, PackageInfo> packageCache_;
+    std::unordered_map<std::string, CachedResolution> resolveCache_;  // By resolveCacheKey()
+    mutable std::unordered_map<std::string, PathKind> statCache_;
+    mutable std::unordered_map<std::string, CachedPackage> packageCache_;       // By package root
+    mutable std::unordered_map<std::string, std::string> nearestPackageCache_;  // Dir -> root ("" = none)
+    mutable ResolverStats stats_;
+
+    bool resolveUncached(const std::string& specifier,
+                         const std::string& referrer,
+                         ResolveMode mode,
+                         ResolvedModule& out,
+                         std::string& error);
+    PathKind pathKind(const std::string& path) const;
 
     bool resolvePath(const std::string& pathSpec,
                      const std::string& referrer,
@@ -118,9 +184,7 @@ private:
                                ResolvedModule& out,
                                std::string& error);
 
-    bool loadPackageJson(const std::string& packageRoot,
-                         PackageInfo& out,
-                         std::string& error) const;
+    const PackageInfo* loadPackageJson(const std::string& packageRoot, std::string& error) const;
     bool findPackageRoot(const std::string& startDir,
                          const std::string& packageName,
                          std::string& outRoot) const;
@@ -2,13 +2,40 @@
 
 #include "mystral/js/engine.h"
 #include "mystral/js/module_resolver.h"
+#include "mystral/js/transpile_cache.h"
+#include <cstddef>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace mystral {
 namespace js {
 
+/**
+ * What the last loadEntry() prefetched before evaluating
+ */
+struct ModulePrefetchStats {
+    size_t modules = 0;   // Files read (and transpiled) ahead of evaluation
+    size_t waves = 0;     // Import-depth levels of the graph walked
+    double elapsedMs = 0;
+};
+
+/**
+ * Outcome of ModuleSystem::applyHotUpdate()
+ */
+struct HotUpdateResult {
+    enum class Kind {
+        NoChange,    // None of the files is a loaded module
+        Applied,     // Changed modules and their importers re-ran up to accepting modules
+        FullReload,  // The update can't be applied in place (reason says why)
+    };
+
+    Kind kind = Kind::NoChange;
+    size_t modulesReevaluated = 0;
+    std::string reason;
+};
+
 class ModuleSystem {
 public:
     ModuleSystem(Engine* engine, const std::string& rootDir);
@@ -28,18 +55,61 @@ public:
                       std::string& error);
 
     const std::unordered_set<std::string>& loadedPaths() const;
+
+    /**
+     * Give modules a module.hot / import.meta.hot context (watch mode)
+     * Only modules loaded afterwards get one.
+     */
+    void setHotUpdatesEnabled(bool enabled);
+
+    /**
+     * Re-run changed modules in place (watch mode), see module.hot / import.meta.hot
+     * @param changedPaths Absolute paths of files that changed on disk
+     */
+    HotUpdateResult applyHotUpdate(const std::vector<std::string>& changedPaths);
+
     void clearCaches();
     ModuleResolver& resolver();
+    TranspileCache& transpileCache();
+    const ModulePrefetchStats& prefetchStats() const;
 
 private:
     Engine* engine_ = nullptr;
     ModuleResolver resolver_;
+    TranspileCache transpileCache_;  // Survives clearCaches(): reloads reuse unchanged files
     std::unordered_map<std::string, JSValueHandle> cjsCache_;
     std::unordered_set<std::string> loading_;
     std::unordered_set<std::string> loadedPaths_;
 
+    // Sources read and transpiled by prefetch(), by path; taken by the first load
+    std::unordered_map<std::string, std::string> prefetched_;
+    ModulePrefetchStats prefetchStats_;
+
+    // Module dependency graph, recorded as modules resolve each other
+    std::unordered_map<std::string, std::unordered_set<std::string>> importers_;     // Module -> its importers
+    std::unordered_map<std::string, std::unordered_set<std::string>> dependencies_;  // Module -> its imports
+    std::unordered_map<std::string, ResolvedModule> modules_;                        // Loaded modules by path
+
+    // module.hot contexts (protected) by path, and dispose() data for the next instance
+    std::unordered_map<std::string, JSValueHandle> hotContexts_;
+    std::unordered_map<std::string, JSValueHandle> hotData_;
+    JSValueHandle hotRuntime_;
+    bool hotUpdatesEnabled_ = false;
+    size_t moduleExecutions_ = 0;
+
+    void recordDependency(const std::string& importer, const std::string& dependency);
+    void forgetDependencies(const std::string& importer);
+    JSValueHandle callHotRuntime(const char* method, const std::vector<JSValueHandle>& args);
+    JSValueHandle createHotContext(const std::string& path);
+    bool acceptsDependency(const std::string& importer, const std::string& dependency, std::string& outSpecifier);
+
+    struct PrefetchTask;
+    void prefetch(const ResolvedModule& entry);
+    void prefetchModule(PrefetchTask& task);
+    bool takePrefetched(const ResolvedModule& resolved, std::string& source);
+    bool loadEntryModule(const ResolvedModule& resolved);
     bool loadEsmEntry(const ResolvedModule& resolved, const std::string& source);
-    JSValueHandle requireResolved(const ResolvedModule& resolved);
+    JSValueHandle loadModule(const ResolvedModule& resolved, std::string& error);
     JSValueHandle createRequireFunction(const std::string& referrer);
     std::string makeCjsWrapper(const std::string& code, const std::string& filename) const;
     std::string makeJsonWrapper(const std::string& jsonText) const;
@@ -0,0 +1,118 @@
+#pragma once
+
+/**
+ * Structured Clone
+ *
+ * Binary serialization of JS values following the HTML structured clone
+ * algorithm: primitives, plain objects, arrays, Date, RegExp, Map, Set,
+ * Error, BigInt, ArrayBuffer, SharedArrayBuffer and typed arrays/DataView,
+ * with shared and cyclic references preserved. Used for Worker.postMessage
+ * and the global structuredClone().
+ *
+ * The walk runs natively through the js::Engine API; a small JS helper
+ * installed by installStructuredClone() classifies objects and tracks
+ * identity. ArrayBuffer contents are copied with memcpy, and buffers in the
+ * transfer list are detached and carried as BackingStores instead.
+ * SharedArrayBuffers are never copied: the receiver wraps the same memory.
+ * Registered native handle types (GPU objects) are passed by pointer, each
+ * message holding its own reference (see NativeHandleOps).
+ */
+
+#include "mystral/js/engine.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mystral {
+namespace js {
+
+/**
+ * A native handle carried by a serialized value. Drops the message's
+ * reference if the value is never deserialized (e.g. the worker exited);
+ * structuredDeserialize hands the reference to the receiving object instead.
+ */
+struct NativeHandleRef {
+    void* handle = nullptr;
+    void (*release)(void* handle) = nullptr;  // Null if the message holds no reference
+
+    NativeHandleRef(void* h, void (*r)(void*)) : handle(h), release(r) {}
+    ~NativeHandleRef() {
+        if (handle && release) release(handle);
+    }
+    NativeHandleRef(const NativeHandleRef&) = delete;
+    NativeHandleRef& operator=(const NativeHandleRef&) = delete;
+};
+
+/**
+ * Serialized value plus the out-of-band buffers it references
+ */
+struct SerializedValue {
+    std::vector<uint8_t> data;
+    std::vector<std::shared_ptr<BackingStore>> transfers;  // Detached ArrayBuffers
+    std::vector<std::shared_ptr<BackingStore>> shared;     // SharedArrayBuffer memory
+    std::vector<std::shared_ptr<NativeHandleRef>> natives; // Native handles, in wire order
+};
+
+/**
+ * Called on the receiving engine to add methods to a cloned native handle
+ * (the object already has its private data and "_type" set)
+ */
+using NativeHandleReviver = void (*)(Engine* engine, JSValueHandle object, void* handle);
+
+/**
+ * How a registered native handle type crosses engines
+ */
+struct NativeHandleOps {
+    NativeHandleReviver reviver = nullptr;
+
+    // Reference counting. With addRef, every serialized handle takes its own
+    // reference, which the receiving object releases when it is collected.
+    // Without it the pointer crosses unowned and the sender must keep the
+    // resource alive.
+    void (*addRef)(void* handle) = nullptr;
+    void (*release)(void* handle) = nullptr;
+
+    // Transferable rather than shareable: the object must be in the transfer
+    // list (DataCloneError otherwise) and the sender's object loses its
+    // pointer. Without addRef the sender's reference moves to the receiver,
+    // which consumes it (e.g. queue.submit); release drops it if the message
+    // is never read.
+    bool transfer = false;
+};
+
+/**
+ * Let objects carrying a native pointer (private data) and this "_type" be
+ * cloned by reference: the receiver gets an object wrapping the same pointer.
+ * Shareable handles may also appear in a transfer list. Call before any
+ * engine clones such objects; safe from any thread.
+ */
+void registerNativeHandleType(const std::string& type, const NativeHandleOps& ops = {});
+
+/**
+ * Install the clone helpers and the global structuredClone(value, { transfer })
+ * Must be called once per engine before serialize/deserialize.
+ */
+void installStructuredClone(Engine* engine);
+
+/**
+ * Serialize a value. Buffers in transferList (a JS array, may be undefined)
+ * are detached and moved into out.transfers; transferable native handles are
+ * emptied on the sender.
+ * @return false with error set (DataCloneError message) if the value cannot be cloned;
+ *         nothing is detached in that case
+ */
+bool structuredSerialize(Engine* engine, JSValueHandle value, JSValueHandle transferList,
+                         SerializedValue& out, std::string& error);
+
+/**
+ * Rebuild a value serialized by structuredSerialize (possibly in another engine)
+ * @return The value, or {nullptr} with error set if the data is malformed
+ */
+JSValueHandle structuredDeserialize(Engine* engine, const uint8_t* data, size_t size,
+                                    const std::vector<std::shared_ptr<BackingStore>>& transfers,
+                                    const std::vector<std::shared_ptr<BackingStore>>& shared,
+                                    const std::vector<std::shared_ptr<NativeHandleRef>>& natives,
+                                    std::string& error);
+
+}  // namespace js
+}  // namespace mystral
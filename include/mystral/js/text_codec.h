@@ -0,0 +1,65 @@
+#pragma once
+
+/**
+ * Text Codec (TextEncoder, TextDecoder, atob, btoa)
+ *
+ * Native UTF-8 and base64 for JS engines that lack them (QuickJS, V8 and
+ * JSC embeddings have none of these Web APIs). ASCII runs are skipped 16
+ * bytes at a time with SSE2/NEON, so valid input is handed to the engine
+ * without being copied or rewritten; only invalid bytes take the slow path.
+ *
+ * installTextCodec() must run before the fetch polyfill, whose Response.text()
+ * and Blob depend on TextEncoder/TextDecoder.
+ */
+
+#include "mystral/js/engine.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mystral {
+namespace js {
+
+namespace utf8 {
+
+/**
+ * Length of the leading run of ASCII bytes (SIMD)
+ */
+size_t asciiPrefixLength(const uint8_t* data, size_t size);
+
+/**
+ * True if data is well-formed UTF-8 (no overlongs, surrogates or values past U+10FFFF)
+ */
+bool validate(const uint8_t* data, size_t size);
+
+/**
+ * Decode as the WHATWG UTF-8 decoder does: each maximal invalid subpart becomes U+FFFD
+ */
+std::string sanitize(const uint8_t* data, size_t size);
+
+/**
+ * Replace lone surrogates (as engines encode them in UTF-8) with U+FFFD in place
+ */
+void replaceSurrogates(std::string& text);
+
+}  // namespace utf8
+
+namespace base64 {
+
+std::string encode(const uint8_t* data, size_t size);
+
+/**
+ * Forgiving-base64 decode (ASCII whitespace ignored, padding optional)
+ * @return false if the input is not valid base64
+ */
+bool decode(const std::string& input, std::vector<uint8_t>& out);
+
+}  // namespace base64
+
+/**
+ * Install TextEncoder, TextDecoder, atob and btoa into an engine
+ */
+void installTextCodec(Engine* engine);
+
+}  // namespace js
+}  // namespace mystral
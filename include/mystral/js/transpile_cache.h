@@ -0,0 +1,88 @@
+#pragma once
+
+/**
+ * TranspileCache - reuses SWC TypeScript output across loads and runs
+ *
+ * Entries are keyed by a 128-bit hash of (transpiler id, filename, source),
+ * so a new SWC build, different transpile options or edited source never hit
+ * a stale entry. Two layers:
+ *   - memory: one entry per path; a hot reload re-transpiles only the files
+ *     whose content changed
+ *   - disk (optional): one file per key under directory(), written via a
+ *     temporary file and rename, so restarts skip SWC entirely
+ *
+ * The directory only ever holds cache files and is safe to delete.
+ * lookup() and store() may be called from any thread.
+ */
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace mystral {
+namespace js {
+
+class TranspileCache {
+public:
+    struct Entry {
+        std::string code;
+        std::string map;  // Source map JSON, empty when none was generated
+    };
+
+    struct Stats {
+        uint64_t memoryHits = 0;
+        uint64_t diskHits = 0;
+        uint64_t misses = 0;
+        uint64_t diskWrites = 0;
+    };
+
+    /**
+     * Persist entries under dir; an empty dir keeps the cache in memory only
+     */
+    void setDirectory(const std::string& dir);
+    const std::string& directory() const { return directory_; }
+
+    /**
+     * Cached output for this source of filename, if any
+     */
+    bool lookup(const std::string& filename, const std::string& source, Entry& out);
+
+    void store(const std::string& filename, const std::string& source, const Entry& entry);
+
+    Stats stats() const;
+
+    /**
+     * Per-user cache location:
+     *   Windows: %LOCALAPPDATA%\Mystral\cache\transpile
+     *   macOS:   ~/Library/Caches/Mystral/transpile
+     *   Linux:   $XDG_CACHE_HOME/mystral/transpile (~/.cache/mystral/transpile)
+     */
+    static std::string defaultDirectory();
+
+private:
+    struct Key {
+        uint64_t lo = 0;
+        uint64_t hi = 0;
+        bool operator==(const Key& other) const { return lo == other.lo && hi == other.hi; }
+    };
+
+    struct MemoryEntry {
+        Key key;
+        Entry entry;
+    };
+
+    static Key makeKey(const std::string& filename, const std::string& source);
+    std::string entryPath(const Key& key) const;
+    bool readEntry(const Key& key, size_t sourceSize, Entry& out) const;
+    bool writeEntry(const Key& key, size_t sourceSize, const Entry& entry) const;
+
+    std::string directory_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, MemoryEntry> memory_;  // By filename
+    Stats stats_;
+};
+
+}  // namespace js
+}  // namespace mystral
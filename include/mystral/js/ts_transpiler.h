@@ -7,10 +7,17 @@ namespace js {
 
 bool isTypeScriptTranspilerAvailable();
 
+/**
+ * Identifies the transpiler build and the options transpileTypeScript() passes
+ * to it. Output produced under a different id must not be reused.
+ */
+const std::string& typeScriptTranspilerId();
+
 bool transpileTypeScript(const std::string& source,
                           const std::string& filename,
                           std::string& outJs,
-                          std::string& outError);
+                          std::string& outError,
+                          std::string* outMap = nullptr);
 
 }  // namespace js
 }  // namespace mystral
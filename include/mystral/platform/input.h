@@ -9,6 +9,7 @@
 
 #include <functional>
 #include <string>
+#include <cstddef>
 #include <cstdint>
 
 namespace mystral {
@@ -46,6 +47,18 @@ struct MouseEventData {
     bool metaKey;
 };
 
+/**
+ * One pointer position sample, for getCoalescedEvents()/getPredictedEvents()
+ * Laid out as five doubles so a sample array maps onto a Float64Array.
+ */
+struct PointerSample {
+    double clientX;
+    double clientY;
+    double movementX;
+    double movementY;
+    double timeStamp;       // Milliseconds (SDL event clock)
+};
+
 /**
  * Pointer event data (matches DOM PointerEvent, extends MouseEvent)
  */
@@ -68,6 +81,12 @@ struct PointerEventData {
     double width;
     double height;
     double pressure;
+    // pointermove only: the raw samples merged into this event, and samples
+    // extrapolated past the last one. Valid for the duration of the callback.
+    const PointerSample* coalesced = nullptr;
+    size_t coalescedCount = 0;
+    const PointerSample* predicted = nullptr;
+    size_t predictedCount = 0;
 };
 
 /**
@@ -117,6 +136,55 @@ struct ResizeEventData {
     int height;
 };
 
+/**
+ * Polling-style input state, updated in place as SDL events are processed
+ *
+ * The runtime exposes both arrays to JS without copying (mystral.input.state
+ * and navigator.getGamepads()), so the layout below is part of the JS API.
+ * Keys are indexed by SDL scancode (1 = down). Movement and wheel slots
+ * accumulate over one pollEvents() and are zeroed at the start of the next.
+ * Gamepads are refreshed once per pollEvents().
+ */
+struct InputState {
+    static constexpr size_t kKeyCount = 512;
+    static constexpr size_t kMaxGamepads = 4;
+    static constexpr size_t kGamepadAxes = 6;
+    static constexpr size_t kGamepadButtons = 17;
+
+    // Slots in values[]
+    enum Slot : size_t {
+        MouseX,
+        MouseY,
+        MovementX,
+        MovementY,
+        MouseButtons,        // DOM buttons bitmask
+        WheelX,
+        WheelY,
+        GamepadGeneration,   // Bumped on every connect/disconnect
+        GamepadBase,         // Per pad: connected, axes, button values
+    };
+    static constexpr size_t kGamepadStride = 1 + kGamepadAxes + kGamepadButtons;
+    static constexpr size_t kValueCount = GamepadBase + kMaxGamepads * kGamepadStride;
+
+    uint8_t keys[kKeyCount];
+    float values[kValueCount];
+};
+
+/**
+ * The process-wide input state (stable address for the lifetime of the process)
+ */
+InputState& getInputState();
+
+/**
+ * Zero the per-poll movement and wheel slots (called at the start of pollEvents)
+ */
+void beginInputFrame();
+
+/**
+ * Refresh gamepad slots of the input state (called at the end of pollEvents)
+ */
+void updateGamepadState();
+
 /**
  * Input event callback types
  */
@@ -137,6 +205,17 @@ void setWheelCallback(WheelCallback callback);
 void setGamepadCallback(GamepadCallback callback);
 void setResizeCallback(ResizeCallback callback);
 
+/**
+ * Merge mouse motion into one mousemove/pointermove per pollEvents()
+ * On by default. When off, every SDL motion event is dispatched.
+ */
+void setMotionCoalescing(bool enabled);
+
+/**
+ * Dispatch motion queued since the last flush (called at the end of pollEvents)
+ */
+void flushPointerMotion();
+
 /**
  * Get current gamepad state
  */
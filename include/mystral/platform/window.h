@@ -22,6 +22,13 @@ void destroyWindow();
  */
 bool pollEvents();
 
+/**
+ * Sleep until an SDL event is queued or the timeout elapses.
+ * The event is left in the queue for the next pollEvents().
+ * @return true if an event is waiting
+ */
+bool waitForEvent(int timeoutMs);
+
 /**
  * Check if window should quit
  */
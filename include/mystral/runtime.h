@@ -21,6 +21,43 @@ struct RuntimeConfig {
     bool noSdl = false;  // Run without SDL (headless GPU mode, no window)
     bool watch = false;  // Watch mode: reload script on file changes
     bool debug = false;  // Enable verbose debug logging
+    bool transpileCache = true;  // Keep SWC TypeScript output on disk across runs (in memory either way)
+    double maxFps = 0;   // Frame rate cap for requestAnimationFrame (0 = uncapped)
+    bool lowLatency = false;  // Start a frame as soon as input arrives instead of at the next deadline
+    bool coalescePointerMoves = true;  // One mousemove/pointermove per frame; samples via getCoalescedEvents()
+    bool virtualTime = false;  // Deterministic clock: advances fixedDtMs per frame, never sleeps
+    double fixedDtMs = 1000.0 / 60.0;  // Virtual time step per frame
+    size_t frameStatsWindow = 600;  // Rendered frames kept for performance.frameStats() and getStats()
+};
+
+/**
+ * Runtime measurements for benchmarking (mystral bench)
+ * Frame times are main-thread work per rendered frame over the stats window.
+ */
+struct RuntimeStats {
+    // Startup, in milliseconds
+    double gpuInitMs = 0;     // Window, WebGPU device and surface
+    double jsInitMs = 0;      // JS engine and native bindings
+    double scriptLoadMs = 0;  // Last loadScript()
+
+    // Frames since resetStats()
+    size_t frames = 0;
+    size_t longFrames = 0;
+    double frameMeanMs = 0;
+    double frameP50Ms = 0;
+    double frameP95Ms = 0;
+    double frameP99Ms = 0;
+    double frameMaxMs = 0;
+
+    // Memory, in bytes
+    uint64_t jsHeapBytes = 0;
+    uint64_t nativeBytes = 0;  // Process resident set
+    uint64_t gpuBytes = 0;     // User buffers and textures not yet destroyed or collected (estimate)
+
+    // WebGPU calls since resetStats()
+    uint64_t drawCalls = 0;
+    uint64_t dispatches = 0;
+    uint64_t submits = 0;
 };
 
 /**
@@ -180,6 +217,21 @@ public:
      */
     virtual bool captureFrame(std::vector<uint8_t>& outData, uint32_t& outWidth, uint32_t& outHeight) = 0;
 
+    // ========================================================================
+    // Statistics
+    // ========================================================================
+
+    /**
+     * Current measurements
+     * @param longFrameMs Frames whose work exceeds this count as long
+     */
+    virtual RuntimeStats getStats(double longFrameMs = 1000.0 / 60.0) = 0;
+
+    /**
+     * Start a new measurement window (frame times and WebGPU call counts)
+     */
+    virtual void resetStats() = 0;
+
 protected:
     Runtime() = default;
 };
@@ -141,6 +141,10 @@ public:
     // This affects whether instance_index in shaders includes firstInstance offset
     bool hasIndirectFirstInstance() const { return hasIndirectFirstInstance_; }
 
+    // Check if the device may be used from several threads at once
+    // (Dawn ImplicitDeviceSynchronization; always true for wgpu-native)
+    bool hasThreadSafeDevice() const { return hasThreadSafeDevice_; }
+
     // Platform types for createSurface
     enum PlatformType {
         PLATFORM_METAL = 0,
@@ -164,6 +168,7 @@ private:
 
     bool initialized_ = false;
     bool hasIndirectFirstInstance_ = false;  // Whether INDIRECT_FIRST_INSTANCE feature is available
+    bool hasThreadSafeDevice_ = false;  // Whether worker threads may encode on the device
     bool headless_ = false;  // Running without SDL/window
 
     // Offscreen rendering (for headless mode)
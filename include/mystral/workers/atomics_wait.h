@@ -0,0 +1,46 @@
+#pragma once
+
+/**
+ * Atomics.wait / Atomics.notify fallback
+ *
+ * V8 and QuickJS implement Atomics.wait/notify themselves, keyed by memory
+ * address, so they work across engines sharing a SharedArrayBuffer. For an
+ * engine without them, installAtomicsFallback() defines both on top of a
+ * process-wide parking lot (mutex + condition variable per waiter).
+ */
+
+#include <cstdint>
+
+namespace mystral {
+namespace js {
+class Engine;
+}
+
+namespace workers {
+
+enum class AtomicsWaitResult {
+    Ok,        // Woken by atomicsNotify
+    NotEqual,  // *address != expected on entry
+    TimedOut
+};
+
+/**
+ * Block the calling thread until notified or the timeout elapses
+ * @param timeoutMs Milliseconds; infinite (or NaN) waits forever
+ */
+AtomicsWaitResult atomicsWait(int32_t* address, int32_t expected, double timeoutMs);
+
+/**
+ * Wake up to count threads waiting on address (FIFO)
+ * @return Number of threads woken
+ */
+int atomicsNotify(int32_t* address, int count);
+
+/**
+ * Define Atomics.wait/notify in the engine if it does not provide them
+ * @param canBlock False on the main thread: Atomics.wait throws there
+ */
+void installAtomicsFallback(js::Engine* engine, bool canBlock);
+
+}  // namespace workers
+}  // namespace mystral
@@ -0,0 +1,186 @@
+#pragma once
+
+/**
+ * SpscChannel - Single-producer/single-consumer message channel
+ *
+ * A bounded lock-free ring buffer plus a wakeup signal. Each WorkerThread
+ * direction has exactly one producer thread and one consumer thread, so
+ * push/pop are a couple of atomic loads/stores with no locks.
+ *
+ * The ring never drops or blocks: when it is full the producer spills into a
+ * mutex-protected overflow list (and keeps using it until the consumer has
+ * drained it, so FIFO order holds). That path only runs under bursts larger
+ * than the ring capacity.
+ */
+
+#include "mystral/workers/wakeup_signal.h"
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+namespace mystral {
+namespace workers {
+
+/**
+ * Bounded lock-free SPSC ring (capacity rounded up to a power of two)
+ */
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        slots_.resize(size);
+        mask_ = size - 1;
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /**
+     * Producer only. Returns false if the ring is full (item untouched).
+     */
+    bool tryPush(T& item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ > mask_) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ > mask_) return false;
+        }
+        slots_[tail & mask_] = std::move(item);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer only.
+     */
+    bool tryPop(T& out) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cachedTail_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_) return false;
+        }
+        out = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer only. Moves up to max items into out; publishes the new head once.
+     */
+    size_t popBatch(std::vector<T>& out, size_t max) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        cachedTail_ = tail_.load(std::memory_order_acquire);
+        size_t count = cachedTail_ - head;
+        if (count > max) count = max;
+        for (size_t i = 0; i < count; i++) {
+            out.push_back(std::move(slots_[(head + i) & mask_]));
+        }
+        if (count > 0) head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * Any thread (approximate while the other side is active)
+     */
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    std::vector<T> slots_;
+    size_t mask_ = 0;
+
+    // Producer and consumer indices on separate cache lines, each with a
+    // cached copy of the other side's index to avoid cross-core traffic
+    alignas(64) std::atomic<size_t> head_{0};
+    size_t cachedTail_ = 0;
+    alignas(64) std::atomic<size_t> tail_{0};
+    size_t cachedHead_ = 0;
+};
+
+/**
+ * SPSC ring + overflow + wakeup signal
+ */
+template <typename T>
+class SpscChannel {
+public:
+    explicit SpscChannel(size_t capacity = 1024, WakeupSignal* extraSignal = nullptr)
+        : ring_(capacity), extraSignal_(extraSignal) {}
+
+    /**
+     * Producer only. Never blocks on the consumer; wakes it if asleep.
+     */
+    void push(T item) {
+        if (overflowSize_.load(std::memory_order_acquire) > 0 || !ring_.tryPush(item)) {
+            std::lock_guard<std::mutex> lock(overflowMutex_);
+            overflow_.push_back(std::move(item));
+            overflowSize_.store(overflow_.size(), std::memory_order_release);
+        }
+        signal_.notify();
+        if (extraSignal_) extraSignal_->notify();
+    }
+
+    /**
+     * Consumer only.
+     */
+    bool tryPop(T& out) {
+        if (ring_.tryPop(out)) return true;
+        if (overflowSize_.load(std::memory_order_acquire) == 0) return false;
+
+        std::lock_guard<std::mutex> lock(overflowMutex_);
+        // Ring items predate overflow items; recheck after taking the lock
+        if (ring_.tryPop(out)) return true;
+        if (overflow_.empty()) return false;
+        out = std::move(overflow_.front());
+        overflow_.pop_front();
+        overflowSize_.store(overflow_.size(), std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer only. Appends up to max items to out in FIFO order.
+     */
+    size_t popBatch(std::vector<T>& out, size_t max = std::numeric_limits<size_t>::max()) {
+        size_t count = ring_.popBatch(out, max);
+        if (count < max && overflowSize_.load(std::memory_order_acquire) > 0) {
+            std::lock_guard<std::mutex> lock(overflowMutex_);
+            count += ring_.popBatch(out, max - count);
+            while (count < max && !overflow_.empty()) {
+                out.push_back(std::move(overflow_.front()));
+                overflow_.pop_front();
+                count++;
+            }
+            overflowSize_.store(overflow_.size(), std::memory_order_release);
+        }
+        return count;
+    }
+
+    /**
+     * Any thread; lock-free
+     */
+    bool hasItems() const {
+        return !ring_.empty() || overflowSize_.load(std::memory_order_acquire) > 0;
+    }
+
+    /**
+     * Signal notified on every push (consumer sleeps on it)
+     */
+    WakeupSignal& signal() { return signal_; }
+
+private:
+    SpscRing<T> ring_;
+    std::mutex overflowMutex_;
+    std::deque<T> overflow_;
+    std::atomic<size_t> overflowSize_{0};
+    WakeupSignal signal_;
+    WakeupSignal* extraSignal_;
+};
+
+}  // namespace workers
+}  // namespace mystral
@@ -0,0 +1,54 @@
+#pragma once
+
+/**
+ * WakeupSignal - Lightweight cross-thread wakeup
+ *
+ * An epoch counter a consumer can sleep on until a producer bumps it.
+ * notify() is a single atomic increment unless someone is actually
+ * sleeping, so producers can call it on every message.
+ *
+ * Linux sleeps on a futex; other platforms fall back to a condition variable.
+ *
+ * Usage (consumer):
+ *   uint32_t epoch = signal.epoch();   // Read BEFORE checking for work
+ *   if (!haveWork()) signal.wait(epoch, timeoutMs);
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <condition_variable>
+
+namespace mystral {
+namespace workers {
+
+class WakeupSignal {
+public:
+    /**
+     * Current epoch; pass to wait() to avoid missing a notify in between
+     */
+    uint32_t epoch() const { return epoch_.load(std::memory_order_acquire); }
+
+    /**
+     * Wake every thread sleeping in wait()
+     */
+    void notify();
+
+    /**
+     * Sleep until the epoch differs from observedEpoch or the timeout elapses
+     * @param timeoutMs Negative waits without a timeout
+     * @return true if notified, false on timeout
+     */
+    bool wait(uint32_t observedEpoch, double timeoutMs = -1);
+
+private:
+    std::atomic<uint32_t> epoch_{0};
+    std::atomic<int> sleepers_{0};
+#if !defined(__linux__)
+    std::mutex mutex_;
+    std::condition_variable cv_;
+#endif
+};
+
+}  // namespace workers
+}  // namespace mystral
@@ -0,0 +1,88 @@
+#pragma once
+
+/**
+ * WorkerEventLoop - Timers, fetch and async fs for a worker thread
+ *
+ * Each worker owns one: it runs the worker thread's own libuv loop
+ * (async::EventLoop::instance() is per thread) together with that thread's
+ * AsyncHttpClient and AsyncFileReader, and keeps the worker's
+ * setTimeout/setInterval timers. fetch() and the async natives come from the
+ * same async::installFetchBindings() the main thread uses.
+ *
+ * Worker thread usage:
+ *   loop.init(engine, id);
+ *   while (running) {
+ *       loop.runOnce();                       // Timers and I/O completions
+ *       ...process messages...
+ *       loop.wait(channel.signal(), epoch);   // Sleep until message, timer or I/O
+ *   }
+ *   loop.shutdown();                          // Before the engine is destroyed
+ *
+ * The posting thread calls wakeup() after notifying the signal, which
+ * interrupts a wait() that is blocked inside the libuv loop.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include "mystral/async/fetch_bindings.h"
+#include "mystral/async/timer_queue.h"
+#include "mystral/js/engine.h"
+
+namespace mystral {
+namespace async {
+class EventLoop;
+}
+
+namespace workers {
+
+class WakeupSignal;
+
+class WorkerEventLoop {
+public:
+    /**
+     * Start the loop and install setTimeout/setInterval, fetch and the async
+     * file natives into the worker's engine. Worker thread only.
+     */
+    void init(js::Engine* engine, int workerId);
+
+    /**
+     * Poll I/O and run due timers and finished fetch/file callbacks (non-blocking)
+     */
+    void runOnce();
+
+    /**
+     * Sleep until the signal moves past observedEpoch, the next timer is due
+     * or (while requests are in flight) an I/O completion arrives
+     */
+    void wait(WakeupSignal& signal, uint32_t observedEpoch);
+
+    /**
+     * Interrupt wait(). Safe from any thread at any time.
+     */
+    void wakeup();
+
+    /**
+     * Cancel in-flight requests (their callbacks run), drop timers and close
+     * the loop. Must run on the worker thread while the engine is alive.
+     */
+    void shutdown();
+
+private:
+    void runDueTimers();
+
+    js::Engine* engine_ = nullptr;
+    int workerId_ = -1;
+
+    async::TimerQueue timers_;
+
+    async::FileCallbackQueue fileCallbacks_;
+
+    // wakeup() only touches the libuv loop while the worker sleeps inside it
+    std::atomic<bool> inLoopWait_{false};
+    std::mutex loopMutex_;
+    async::EventLoop* loop_ = nullptr;
+};
+
+}  // namespace workers
+}  // namespace mystral
@@ -58,11 +58,22 @@ public:
     void postToWorker(int id, WorkerMessage msg);
 
     /**
-     * Terminate a worker
+     * Terminate a worker (non-blocking)
+     * The thread is joined later, once it has finished its current job.
      * @param id Worker ID
      */
     void terminateWorker(int id);
 
+    /**
+     * Terminate all workers (e.g. on hot reload)
+     */
+    void terminateAll();
+
+    /**
+     * Number of live (non-terminated) workers
+     */
+    size_t activeWorkerCount() const;
+
     /**
      * Register a callback for receiving messages from a worker
      * @param id Worker ID
@@ -84,6 +95,14 @@ public:
      */
     bool processWorkerMessages(js::Engine* mainEngine);
 
+    /**
+     * Block until any worker posts a message or the timeout elapses
+     * Lets an idle main loop sleep instead of polling.
+     * @param timeoutMs Maximum wait (negative waits indefinitely)
+     * @return true if woken by a worker message
+     */
+    bool waitForMessages(double timeoutMs);
+
     /**
      * Shutdown all workers
      */
@@ -102,8 +121,12 @@ private:
     WorkerRegistry();
     ~WorkerRegistry();
 
+    void reapRetiredWorkers();
+
+    WakeupSignal messageSignal_;  // Notified by every worker -> main post (outlives workers)
     std::unordered_map<int, std::unique_ptr<WorkerThread>> workers_;
     std::unordered_map<int, JSWorkerCallback> callbacks_;
+    std::vector<std::unique_ptr<WorkerThread>> retired_;  // Terminated, not yet joined
     int nextId_ = 1;
     mutable std::mutex mutex_;
     bool initialized_ = false;
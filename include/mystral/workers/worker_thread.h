@@ -4,40 +4,42 @@
  * WorkerThread - Web Worker implementation
  *
  * Each WorkerThread runs its own JavaScript engine in a separate thread,
- * communicating with the main thread via message passing.
+ * communicating with the main thread via message passing over a pair of
+ * lock-free SPSC channels (main -> worker, worker -> main).
  *
  * Usage:
  *   auto worker = std::make_unique<WorkerThread>(id, jsCode);
  *   worker->start();
  *   worker->postMessage(data, transfers);
  *   // ... later ...
- *   while (worker->hasMessages()) {
- *       auto msg = worker->popMessage();
- *       // Handle message from worker
- *   }
+ *   std::vector<WorkerMessage> batch;
+ *   worker->popMessages(batch);
+ *   // Handle messages from worker
  *   worker->terminate();
+ *   worker->join();
  */
 
 #include <memory>
+#include <cstdint>
 #include <string>
 #include <vector>
-#include <queue>
-#include <mutex>
-#include <condition_variable>
 #include <thread>
 #include <atomic>
 #include <functional>
+#include "mystral/js/engine.h"
+#include "mystral/js/structured_clone.h"
+#include "mystral/workers/spsc_channel.h"
+#include "mystral/workers/worker_event_loop.h"
 
 namespace mystral {
 namespace workers {
 
 /**
- * Shared ArrayBuffer data for transfer between threads
+ * Backing store of a transferred ArrayBuffer
+ * The sending engine detaches its ArrayBuffer and the receiving engine wraps
+ * the same memory, so a transfer costs O(1) regardless of size.
  */
-struct ArrayBufferData {
-    std::vector<uint8_t> data;
-    bool transferred = false;  // If true, original is detached
-};
+using ArrayBufferData = js::BackingStore;
 
 /**
  * Message passed between main thread and worker
@@ -50,8 +52,10 @@ struct WorkerMessage {
     };
 
     Type type = Type::MESSAGE;
-    std::vector<uint8_t> payload;  // JSON-serialized data
-    std::vector<std::shared_ptr<ArrayBufferData>> transfers;
+    std::vector<uint8_t> payload;  // Structured-clone data (ERROR: message, then '\0' and stack if known)
+    std::vector<std::shared_ptr<ArrayBufferData>> transfers;  // Referenced from payload by index
+    std::vector<std::shared_ptr<ArrayBufferData>> shared;     // SharedArrayBuffer memory (not copied)
+    std::vector<std::shared_ptr<js::NativeHandleRef>> natives;  // GPU handles, each holding a reference
 };
 
 /**
@@ -68,8 +72,9 @@ public:
      * Create a worker thread
      * @param id Unique worker ID
      * @param code JavaScript code to execute
+     * @param outSignal Optional signal notified whenever the worker posts a message
      */
-    WorkerThread(int id, const std::string& code);
+    WorkerThread(int id, const std::string& code, WakeupSignal* outSignal = nullptr);
     ~WorkerThread();
 
     /**
@@ -79,17 +84,28 @@ public:
 
     /**
      * Post a message to the worker
-     * @param data JSON-serialized message data
+     * @param data Structured-clone serialized message data
      * @param transfers ArrayBuffers to transfer (not copy)
      */
     void postMessage(std::vector<uint8_t> data,
                      std::vector<std::shared_ptr<ArrayBufferData>> transfers = {});
 
     /**
-     * Terminate the worker
+     * Post a fully built message (payload, transfers and shared buffers)
+     */
+    void postMessage(WorkerMessage msg);
+
+    /**
+     * Request termination of the worker (non-blocking)
+     * The thread exits after its current JS job returns; call join() to reclaim it.
      */
     void terminate();
 
+    /**
+     * Wait for the worker thread to exit
+     */
+    void join();
+
     /**
      * Check if the worker has messages to process
      */
@@ -100,6 +116,12 @@ public:
      */
     WorkerMessage popMessage();
 
+    /**
+     * Pop up to max messages from the worker's output queue in one go
+     * @return Number of messages appended to out
+     */
+    size_t popMessages(std::vector<WorkerMessage>& out, size_t max = SIZE_MAX);
+
     /**
      * Check if the worker is still running
      */
@@ -115,16 +137,17 @@ private:
     std::string code_;
     std::unique_ptr<std::thread> thread_;
 
-    // Thread-safe message queues
-    mutable std::mutex inMutex_;
-    mutable std::mutex outMutex_;
-    std::queue<WorkerMessage> inQueue_;   // Main -> Worker
-    std::queue<WorkerMessage> outQueue_;  // Worker -> Main
-    std::condition_variable inCondition_;
+    // Message channels: each has exactly one producer and one consumer thread
+    static constexpr size_t kChannelCapacity = 4096;
+    SpscChannel<WorkerMessage> inChannel_;   // Main -> Worker
+    SpscChannel<WorkerMessage> outChannel_;  // Worker -> Main
 
     std::atomic<bool> running_{false};
     std::atomic<bool> terminated_{false};
 
+    // Timers, fetch and async fs; owned here so wakeup() from the main thread stays valid
+    WorkerEventLoop eventLoop_;
+
     void threadMain();
     void processMessages(void* engine);  // void* is js::Engine*
     void setupWorkerGlobals(void* engine);
@@ -5,7 +5,8 @@ namespace mystral {
 namespace async {
 
 EventLoop& EventLoop::instance() {
-    static EventLoop instance;
+    // One loop per thread: workers run their own libuv loop alongside the main one
+    thread_local EventLoop instance;
     return instance;
 }
 
@@ -33,6 +34,15 @@ void EventLoop::init() {
         return;
     }
 
+    uv_async_init(&loop_, &wakeupAsync_, nullptr);
+    uv_unref(reinterpret_cast<uv_handle_t*>(&wakeupAsync_));
+    uv_timer_init(&loop_, &waitTimer_);
+    uv_unref(reinterpret_cast<uv_handle_t*>(&waitTimer_));
+    {
+        std::lock_guard<std::mutex> lock(wakeupMutex_);
+        wakeupActive_ = true;
+    }
+
     initialized_ = true;
     std::cout << "[EventLoop] libuv " << uv_version_string()
               << " initialized" << std::endl;
@@ -56,6 +66,31 @@ bool EventLoop::runOnce() {
 #endif
 }
 
+void EventLoop::waitForEvents(double timeoutMs) {
+#ifdef MYSTRAL_HAS_LIBUV
+    if (!initialized_ || !uv_loop_alive(&loop_)) {
+        return;
+    }
+
+    // The loop is alive, so UV_RUN_ONCE blocks until something happens;
+    // the timer caps the wait (its callback does nothing, waking is enough)
+    if (timeoutMs >= 0) {
+        uv_timer_start(&waitTimer_, [](uv_timer_t*) {}, static_cast<uint64_t>(timeoutMs), 0);
+    }
+    uv_run(&loop_, UV_RUN_ONCE);
+    uv_timer_stop(&waitTimer_);
+#endif
+}
+
+void EventLoop::wakeup() {
+#ifdef MYSTRAL_HAS_LIBUV
+    std::lock_guard<std::mutex> lock(wakeupMutex_);
+    if (wakeupActive_) {
+        uv_async_send(&wakeupAsync_);
+    }
+#endif
+}
+
 bool EventLoop::hasPendingWork() const {
 #ifdef MYSTRAL_HAS_LIBUV
     if (!initialized_) {
@@ -74,6 +109,11 @@ void EventLoop::shutdown() {
         return;
     }
 
+    {
+        std::lock_guard<std::mutex> lock(wakeupMutex_);
+        wakeupActive_ = false;
+    }
+
     // Close all active handles
     // Walk all handles and request close
     uv_walk(&loop_, [](uv_handle_t* handle, void*) {
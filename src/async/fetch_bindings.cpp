@@ -0,0 +1,387 @@
+/**
+ * Fetch Bindings
+ *
+ * __readFileAsync, __httpRequestAsync and the fetch/Response/Headers polyfill
+ * built on them. Installed into the main engine and into every worker engine,
+ * after js::installTextCodec() (Response.text() uses the native TextDecoder);
+ * I/O goes through the calling thread's AsyncFileReader and AsyncHttpClient,
+ * so each thread's callbacks are delivered by its own loop.
+ */
+
+#include "mystral/async/fetch_bindings.h"
+#include "mystral/js/engine.h"
+#include "mystral/http/async_http_client.h"
+#include "mystral/fs/async_file.h"
+#include "mystral/vfs/embedded_bundle.h"
+#include <iostream>
+
+namespace mystral {
+namespace async {
+
+void FileCallbackQueue::push(js::JSValueHandle callback, std::vector<uint8_t> data, std::string error) {
+    pending_.push({callback, std::move(data), std::move(error)});
+}
+
+void FileCallbackQueue::drain(js::Engine* engine) {
+    while (!pending_.empty()) {
+        auto pending = std::move(pending_.front());
+        pending_.pop();
+
+        if (pending.error.empty()) {
+            // Success - create ArrayBuffer and call callback with (data, null)
+            auto dataVal = engine->newArrayBuffer(pending.data.data(), pending.data.size());
+            auto errorVal = engine->newNull();
+            std::vector<js::JSValueHandle> callbackArgs = { dataVal, errorVal };
+            engine->call(pending.callback, engine->newUndefined(), callbackArgs);
+        } else {
+            // Error - call callback with (null, error)
+            auto nullVal = engine->newNull();
+            auto errorVal = engine->newString(pending.error.c_str());
+            std::vector<js::JSValueHandle> callbackArgs = { nullVal, errorVal };
+            engine->call(pending.callback, engine->newUndefined(), callbackArgs);
+        }
+
+        // Unprotect the callback now that we're done with it
+        engine->unprotect(pending.callback);
+    }
+}
+
+void installFetchBindings(js::Engine* engine, FileCallbackQueue& fileCallbacks) {
+    if (!engine) return;
+
+    // Async file reading function - uses libuv thread pool for non-blocking I/O
+    // Takes (path, callback) where callback receives (data, error)
+    engine->setGlobalProperty("__readFileAsync",
+        engine->newFunction("__readFileAsync", [engine, &fileCallbacks](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (args.size() < 2) {
+                std::cerr << "[Fetch Async] Missing arguments (need path, callback)" << std::endl;
+                return engine->newUndefined();
+            }
+
+            std::string path = engine->toString(args[0]);
+
+            // Handle file:// prefix
+            if (path.substr(0, 7) == "file://") {
+                path = path.substr(7);
+            }
+
+            // Get and protect the callback so it survives until we call it
+            auto callback = args[1];
+            engine->protect(callback);
+
+            // Check embedded bundle first (synchronously - it's fast)
+            std::vector<uint8_t> embeddedData;
+            if (vfs::readEmbeddedFile(path, embeddedData)) {
+                std::cout << "[Fetch] Read " << embeddedData.size() << " bytes from bundle: " << path << std::endl;
+                // Queue callback for next tick instead of calling immediately
+                // This prevents stack overflow and matches browser async behavior
+                fileCallbacks.push(callback, std::move(embeddedData), "");
+                return engine->newUndefined();
+            }
+
+            // Use the async file reader with libuv thread pool
+            // The callback will be queued and invoked during processCompletedReads()
+            fs::getAsyncFileReader().readFile(path, [&fileCallbacks, callback](std::vector<uint8_t> data, std::string error) {
+                // This callback runs on this thread during processCompletedReads()
+                // Queue the callback with data for processing in the owning loop
+                fileCallbacks.push(callback, std::move(data), std::move(error));
+            });
+
+            return engine->newUndefined();
+        })
+    );
+
+
+    // Async HTTP request function - uses libuv for non-blocking I/O
+    // Takes (url, options, callback) where callback receives the result object
+    engine->setGlobalProperty("__httpRequestAsync",
+        engine->newFunction("__httpRequestAsync", [engine](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (args.size() < 3) {
+                std::cerr << "[HTTP Async] Missing arguments (need url, options, callback)" << std::endl;
+                return engine->newUndefined();
+            }
+
+            std::string url = engine->toString(args[0]);
+            std::string method = "GET";
+            std::vector<uint8_t> body;
+            http::HttpOptions options;
+
+            // Parse options object
+            if (!engine->isUndefined(args[1]) && !engine->isNull(args[1])) {
+                auto optObj = args[1];
+
+                auto methodVal = engine->getProperty(optObj, "method");
+                if (!engine->isUndefined(methodVal)) {
+                    method = engine->toString(methodVal);
+                }
+
+                auto bodyVal = engine->getProperty(optObj, "body");
+                if (!engine->isUndefined(bodyVal)) {
+                    if (engine->isString(bodyVal)) {
+                        std::string bodyStr = engine->toString(bodyVal);
+                        body.assign(bodyStr.begin(), bodyStr.end());
+                    } else {
+                        size_t size = 0;
+                        void* data = engine->getArrayBufferData(bodyVal, &size);
+                        if (data && size > 0) {
+                            body.assign(static_cast<uint8_t*>(data), static_cast<uint8_t*>(data) + size);
+                        }
+                    }
+                }
+            }
+
+            // Get and protect the callback
+            auto callback = args[2];
+            engine->protect(callback);
+
+            // Start async request
+            http::getAsyncHttpClient().request(method, url, body,
+                [engine, callback](http::HttpResponse response) {
+                    // This runs on this thread when the response arrives
+                    // Create result object
+                    auto result = engine->newObject();
+                    engine->setProperty(result, "ok", engine->newBoolean(response.ok));
+                    engine->setProperty(result, "status", engine->newNumber(response.status));
+                    engine->setProperty(result, "url", engine->newString(response.url.c_str()));
+
+                    if (!response.error.empty()) {
+                        engine->setProperty(result, "error", engine->newString(response.error.c_str()));
+                    }
+
+                    if (!response.data.empty()) {
+                        auto arrayBuffer = engine->newArrayBuffer(response.data.data(), response.data.size());
+                        engine->setProperty(result, "data", arrayBuffer);
+                    } else {
+                        engine->setProperty(result, "data", engine->newNull());
+                    }
+
+                    // Call the JS callback with the result
+                    std::vector<js::JSValueHandle> callbackArgs = { result };
+                    engine->call(callback, engine->newUndefined(), callbackArgs);
+
+                    // Unprotect the callback now that we're done
+                    engine->unprotect(callback);
+                },
+                options
+            );
+
+            return engine->newUndefined();
+        })
+    );
+
+    // JavaScript fetch polyfill
+    const char* fetchPolyfill = R"(
+// Blob class (Web API standard)
+if (typeof Blob === 'undefined') {
+    class Blob {
+        constructor(blobParts = [], options = {}) {
+            this.type = options.type || '';
+
+            // Concatenate all parts into a single ArrayBuffer
+            let totalSize = 0;
+            const parts = [];
+
+            for (const part of blobParts) {
+                if (part instanceof ArrayBuffer) {
+                    parts.push(new Uint8Array(part));
+                    totalSize += part.byteLength;
+                } else if (part instanceof Uint8Array) {
+                    parts.push(part);
+                    totalSize += part.byteLength;
+                } else if (part instanceof Blob) {
+                    // Need to get the Blob's internal data
+                    parts.push(new Uint8Array(part._data));
+                    totalSize += part._data.byteLength;
+                } else if (typeof part === 'string') {
+                    const encoder = new TextEncoder();
+                    const encoded = encoder.encode(part);
+                    parts.push(encoded);
+                    totalSize += encoded.byteLength;
+                }
+            }
+
+            // Create final buffer
+            const buffer = new ArrayBuffer(totalSize);
+            const view = new Uint8Array(buffer);
+            let offset = 0;
+            for (const part of parts) {
+                view.set(part, offset);
+                offset += part.byteLength;
+            }
+
+            this._data = buffer;
+            this.size = totalSize;
+        }
+
+        async arrayBuffer() {
+            return this._data;
+        }
+
+        async text() {
+            const decoder = new TextDecoder();
+            return decoder.decode(new Uint8Array(this._data));
+        }
+
+        slice(start = 0, end = this.size, type = '') {
+            const data = new Uint8Array(this._data, start, end - start);
+            return new Blob([data], { type });
+        }
+
+        async stream() {
+            // ReadableStream not implemented yet
+            throw new Error('Blob.stream() not implemented');
+        }
+    }
+    globalThis.Blob = Blob;
+}
+
+// Headers class - mimics Web Headers API
+class Headers {
+    constructor(init = {}) {
+        this._headers = new Map();
+        if (init) {
+            if (init instanceof Headers) {
+                init.forEach((value, key) => this._headers.set(key.toLowerCase(), value));
+            } else if (Array.isArray(init)) {
+                init.forEach(([key, value]) => this._headers.set(key.toLowerCase(), value));
+            } else if (typeof init === 'object') {
+                Object.entries(init).forEach(([key, value]) => this._headers.set(key.toLowerCase(), value));
+            }
+        }
+    }
+
+    get(name) {
+        return this._headers.get(name.toLowerCase()) || null;
+    }
+
+    set(name, value) {
+        this._headers.set(name.toLowerCase(), value);
+    }
+
+    has(name) {
+        return this._headers.has(name.toLowerCase());
+    }
+
+    delete(name) {
+        this._headers.delete(name.toLowerCase());
+    }
+
+    entries() {
+        return this._headers.entries();
+    }
+
+    keys() {
+        return this._headers.keys();
+    }
+
+    values() {
+        return this._headers.values();
+    }
+
+    forEach(callback) {
+        this._headers.forEach((value, key) => callback(value, key, this));
+    }
+
+    [Symbol.iterator]() {
+        return this._headers.entries();
+    }
+}
+globalThis.Headers = Headers;
+
+// Response class
+class Response {
+    constructor(data, options = {}) {
+        this._data = data;
+        this.ok = options.ok !== undefined ? options.ok : true;
+        this.status = options.status || 200;
+        this.statusText = options.statusText || 'OK';
+        this.url = options.url || '';
+        this.headers = new Headers(options.headers || {});
+    }
+
+    async arrayBuffer() {
+        return this._data;
+    }
+
+    async text() {
+        const decoder = new TextDecoder();
+        return decoder.decode(new Uint8Array(this._data));
+    }
+
+    async json() {
+        const text = await this.text();
+        return JSON.parse(text);
+    }
+
+    async blob() {
+        return new Blob([this._data]);
+    }
+}
+
+// Fetch function - supports file://, http://, and https://
+// HTTP requests are now async via libuv (non-blocking)
+async function fetch(url, options = {}) {
+    // Check URL type
+    if (url.startsWith('http://') || url.startsWith('https://')) {
+        // HTTP/HTTPS request via async libcurl + libuv (non-blocking)
+        return new Promise((resolve, reject) => {
+            __httpRequestAsync(url, options, (result) => {
+                if (result.error) {
+                    reject(new Error('Fetch error: ' + result.error));
+                } else {
+                    resolve(new Response(result.data || new ArrayBuffer(0), {
+                        ok: result.ok,
+                        status: result.status,
+                        statusText: result.ok ? 'OK' : 'Error',
+                        url: result.url || url
+                    }));
+                }
+            });
+        });
+    }
+
+    // File URL or relative path - use async file reading for non-blocking I/O
+    let path = url;
+    if (url.startsWith('file://')) {
+        path = url;
+    } else if (!url.includes('://')) {
+        // Relative path - treat as file
+        path = url;
+    } else {
+        throw new Error('Unsupported URL scheme: ' + url.split('://')[0]);
+    }
+
+    // Use async file reading to avoid blocking the render loop
+    return new Promise((resolve, reject) => {
+        __readFileAsync(path, (data, error) => {
+            if (error) {
+                reject(new Error('File read error: ' + error));
+            } else if (data === null) {
+                resolve(new Response(new ArrayBuffer(0), {
+                    ok: false,
+                    status: 404,
+                    statusText: 'Not Found',
+                    url: url
+                }));
+            } else {
+                resolve(new Response(data, {
+                    ok: true,
+                    status: 200,
+                    statusText: 'OK',
+                    url: url
+                }));
+            }
+        });
+    });
+}
+
+// Also expose globally
+globalThis.fetch = fetch;
+globalThis.Response = Response;
+)";
+
+    engine->eval(fetchPolyfill, "fetch-polyfill.js");
+}
+
+}  // namespace async
+}  // namespace mystral
@@ -0,0 +1,37 @@
+/**
+ * FrameScheduler Implementation
+ */
+
+#include "mystral/async/frame_scheduler.h"
+
+namespace mystral {
+namespace async {
+
+void FrameScheduler::setTargetFrameRate(double fps) {
+    if (!(fps > 0)) {
+        fps_ = 0;
+        interval_ = Clock::duration::zero();
+        next_ = Clock::time_point{};
+        return;
+    }
+
+    fps_ = fps;
+    interval_ = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / fps));
+    next_ = Clock::time_point{};  // Next frame resynchronizes to the new rate
+}
+
+void FrameScheduler::frameStarted(Clock::time_point now) {
+    if (!capped()) {
+        next_ = now;
+        return;
+    }
+
+    // Keep the cadence unless we fell more than a whole frame behind
+    next_ += interval_;
+    if (next_ < now) {
+        next_ = now + interval_;
+    }
+}
+
+}  // namespace async
+}  // namespace mystral
@@ -0,0 +1,51 @@
+/**
+ * RuntimeClock Implementation
+ */
+
+#include "mystral/async/runtime_clock.h"
+
+namespace mystral {
+namespace async {
+
+RuntimeClock& RuntimeClock::instance() {
+    static RuntimeClock clock;
+    return clock;
+}
+
+double RuntimeClock::realMs() {
+    // Same reference performance.now() has always used
+    auto now = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(now.time_since_epoch()).count();
+}
+
+void RuntimeClock::enableVirtualTime(double fixedDtMs) {
+    fixedDtMs_ = fixedDtMs > 0 ? fixedDtMs : 1000.0 / 60.0;
+    origin_ = Clock::now();
+    originMs_ = realMs();
+    elapsedNs_.store(0, std::memory_order_relaxed);
+    virtual_.store(true, std::memory_order_release);
+}
+
+RuntimeClock::Clock::time_point RuntimeClock::now() const {
+    if (!isVirtual()) {
+        return Clock::now();
+    }
+    return origin_ + std::chrono::nanoseconds(elapsedNs_.load(std::memory_order_acquire));
+}
+
+double RuntimeClock::nowMs() const {
+    if (!isVirtual()) {
+        return realMs();
+    }
+    return originMs_ + static_cast<double>(elapsedNs_.load(std::memory_order_acquire)) / 1e6;
+}
+
+void RuntimeClock::advance(double ms) {
+    if (!isVirtual() || !(ms > 0)) {
+        return;
+    }
+    elapsedNs_.fetch_add(static_cast<int64_t>(ms * 1e6), std::memory_order_acq_rel);
+}
+
+}  // namespace async
+}  // namespace mystral
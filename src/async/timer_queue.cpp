@@ -0,0 +1,213 @@
+/**
+ * TimerQueue Implementation
+ *
+ * heap_ holds (due, sequence, slot) entries; each live slot stores its
+ * entry's heap index, kept current by place() whenever an entry moves.
+ */
+
+#include "mystral/async/timer_queue.h"
+#include <cmath>
+
+namespace mystral {
+namespace async {
+
+// Generations wrap so ids stay below 2^53
+static constexpr uint32_t kGenerationMask = (1u << 29) - 1;
+
+bool TimerQueue::idFromNumber(double value, TimerId& id) {
+    if (!(value >= 1 && value < 9007199254740992.0) || std::floor(value) != value) {
+        return false;
+    }
+    id = static_cast<TimerId>(value);
+    return true;
+}
+
+TimerQueue::TimerId TimerQueue::makeId(uint32_t slot) const {
+    return (static_cast<TimerId>(slots_[slot].generation & kGenerationMask) << kIndexBits) | (slot + 1);
+}
+
+TimerQueue::Slot* TimerQueue::find(TimerId id) {
+    uint32_t index = static_cast<uint32_t>(id & kIndexMask);
+    if (index == 0 || index > slots_.size()) {
+        return nullptr;
+    }
+    Slot& slot = slots_[index - 1];
+    if (!slot.live || (slot.generation & kGenerationMask) != (id >> kIndexBits)) {
+        return nullptr;
+    }
+    return &slot;
+}
+
+TimerQueue::TimerId TimerQueue::add(js::JSValueHandle callback, int delayMs, int intervalMs, Clock::time_point now) {
+    if (delayMs < 0) delayMs = 0;
+
+    uint32_t slot;
+    if (!freeSlots_.empty()) {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+    }
+
+    Slot& s = slots_[slot];
+    s.live = true;
+    s.callback = callback;
+    s.intervalMs = intervalMs;
+    live_++;
+
+    push(slot, now + std::chrono::milliseconds(delayMs));
+    return makeId(slot);
+}
+
+bool TimerQueue::cancel(TimerId id, js::JSValueHandle& released) {
+    Slot* slot = find(id);
+    if (!slot) {
+        return false;
+    }
+
+    uint32_t index = static_cast<uint32_t>(slot - slots_.data());
+    bool queued = slot->heapIndex != kNotQueued;
+    if (queued) {
+        removeAt(slot->heapIndex);
+        released = slot->callback;
+    }
+    release(index);
+    return queued;
+}
+
+void TimerQueue::beginPass(Clock::time_point now) {
+    passNow_ = now;
+    passSequence_ = nextSequence_;
+}
+
+bool TimerQueue::popDue(Due& timer) {
+    if (heap_.empty()) {
+        return false;
+    }
+    const Entry& top = heap_.front();
+    if (top.due > passNow_ || top.sequence >= passSequence_) {
+        return false;
+    }
+
+    uint32_t slot = top.slot;
+    Slot& s = slots_[slot];
+    timer.id = makeId(slot);
+    timer.callback = s.callback;
+    timer.intervalMs = s.intervalMs;
+
+    removeAt(0);
+    if (s.intervalMs == 0) {
+        release(slot);
+    }
+    return true;
+}
+
+bool TimerQueue::rearm(const Due& timer) {
+    Slot* slot = find(timer.id);
+    if (!slot || slot->heapIndex != kNotQueued) {
+        return false;
+    }
+    push(static_cast<uint32_t>(slot - slots_.data()), passNow_ + std::chrono::milliseconds(timer.intervalMs));
+    return true;
+}
+
+double TimerQueue::msUntilNext(Clock::time_point now) const {
+    if (heap_.empty()) {
+        return -1;
+    }
+    double ms = std::chrono::duration<double, std::milli>(heap_.front().due - now).count();
+    return ms > 0 ? ms : 0;
+}
+
+std::vector<js::JSValueHandle> TimerQueue::clear() {
+    std::vector<js::JSValueHandle> callbacks;
+    callbacks.reserve(live_);
+    heap_.clear();
+    for (uint32_t i = 0; i < slots_.size(); i++) {
+        if (slots_[i].live) {
+            callbacks.push_back(slots_[i].callback);
+            release(i);
+        }
+    }
+    return callbacks;
+}
+
+// ============================================================================
+// Heap maintenance
+// ============================================================================
+
+void TimerQueue::release(uint32_t slot) {
+    Slot& s = slots_[slot];
+    s.live = false;
+    s.heapIndex = kNotQueued;
+    s.callback = {};
+    s.generation++;
+    freeSlots_.push_back(slot);
+    live_--;
+}
+
+void TimerQueue::place(uint32_t index, const Entry& entry) {
+    heap_[index] = entry;
+    slots_[entry.slot].heapIndex = index;
+}
+
+void TimerQueue::push(uint32_t slot, Clock::time_point due) {
+    heap_.push_back({due, nextSequence_++, slot});
+    uint32_t index = static_cast<uint32_t>(heap_.size() - 1);
+    slots_[slot].heapIndex = index;
+    siftUp(index);
+}
+
+void TimerQueue::removeAt(uint32_t index) {
+    slots_[heap_[index].slot].heapIndex = kNotQueued;
+    uint32_t last = static_cast<uint32_t>(heap_.size() - 1);
+    if (index != last) {
+        place(index, heap_[last]);
+        heap_.pop_back();
+        // The moved entry may belong above or below its new position
+        if (index > 0 && before(heap_[index], heap_[(index - 1) / 2])) {
+            siftUp(index);
+        } else {
+            siftDown(index);
+        }
+    } else {
+        heap_.pop_back();
+    }
+}
+
+void TimerQueue::siftUp(uint32_t index) {
+    Entry entry = heap_[index];
+    while (index > 0) {
+        uint32_t parent = (index - 1) / 2;
+        if (!before(entry, heap_[parent])) {
+            break;
+        }
+        place(index, heap_[parent]);
+        index = parent;
+    }
+    place(index, entry);
+}
+
+void TimerQueue::siftDown(uint32_t index) {
+    Entry entry = heap_[index];
+    uint32_t size = static_cast<uint32_t>(heap_.size());
+    while (true) {
+        uint32_t child = index * 2 + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && before(heap_[child + 1], heap_[child])) {
+            child++;
+        }
+        if (!before(heap_[child], entry)) {
+            break;
+        }
+        place(index, heap_[child]);
+        index = child;
+    }
+    place(index, entry);
+}
+
+}  // namespace async
+}  // namespace mystral
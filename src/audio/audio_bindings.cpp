@@ -5,6 +5,7 @@
  */
 
 #include "mystral/audio/audio_context.h"
+#include "mystral/jobs/job_system.h"
 #include "mystral/js/engine.h"
 #include <iostream>
 #include <unordered_map>
@@ -264,31 +265,57 @@ js::JSValueHandle createAudioContextJS(js::Engine* engine, AudioContext* ctxPtr)
         })
     );
 
-    // decodeAudioData(arrayBuffer) -> Promise<AudioBuffer>
-    engine->setProperty(jsCtx, "decodeAudioData",
-        engine->newFunction("decodeAudioData", [ctxPtr](void* c, const std::vector<js::JSValueHandle>& args) -> js::JSValueHandle {
-            if (args.empty()) return g_jsEngine->newUndefined();
+    // _decodeAudioDataAsync(arrayBuffer, callback(audioBuffer, error)) - decodes on the job pool
+    float sampleRate = ctxPtr->sampleRate();
+    engine->setProperty(jsCtx, "_decodeAudioDataAsync",
+        engine->newFunction("_decodeAudioDataAsync", [sampleRate](void* c, const std::vector<js::JSValueHandle>& args) -> js::JSValueHandle {
+            if (args.size() < 2) return g_jsEngine->newString("decodeAudioData: missing arguments");
 
             // Get ArrayBuffer data
             size_t length = 0;
             void* data = g_jsEngine->getArrayBufferData(args[0], &length);
 
             if (!data || length == 0) {
-                std::cerr << "[Audio] decodeAudioData: invalid ArrayBuffer" << std::endl;
-                return g_jsEngine->newUndefined();
-            }
-
-            auto buffer = ctxPtr->decodeAudioDataSync(static_cast<const uint8_t*>(data), length);
-            if (!buffer) {
-                std::cerr << "[Audio] decodeAudioData: failed to decode" << std::endl;
-                return g_jsEngine->newUndefined();
+                return g_jsEngine->newString("decodeAudioData: invalid ArrayBuffer");
             }
 
-            // For now, return the buffer directly (should be a Promise in full impl)
-            return createAudioBufferJS(g_jsEngine, buffer);
+            // Copy the input: the JS buffer may be detached or collected while we decode
+            struct DecodeJob {
+                std::vector<uint8_t> input;
+                std::shared_ptr<AudioBuffer> buffer;
+                js::JSValueHandle callback;
+            };
+            auto job = std::make_shared<DecodeJob>();
+            job->input.assign(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + length);
+            job->callback = args[1];
+            g_jsEngine->protect(job->callback);
+
+            jobs::JobSystem::instance().submit(
+                [job, sampleRate]() {
+                    job->buffer = decodeAudioFile(job->input.data(), job->input.size(), sampleRate);
+                    job->input = {};
+                },
+                [job]() {
+                    if (!g_jsEngine) return;  // Bindings were cleaned up meanwhile
+                    std::vector<js::JSValueHandle> callbackArgs;
+                    if (job->buffer) {
+                        callbackArgs = { createAudioBufferJS(g_jsEngine, job->buffer), g_jsEngine->newNull() };
+                    } else {
+                        std::cerr << "[Audio] decodeAudioData: failed to decode" << std::endl;
+                        callbackArgs = { g_jsEngine->newNull(), g_jsEngine->newString("decodeAudioData: failed to decode") };
+                    }
+                    g_jsEngine->call(job->callback, g_jsEngine->newUndefined(), callbackArgs);
+                    g_jsEngine->unprotect(job->callback);
+                },
+                jobs::JobPriority::Normal
+            );
+            return g_jsEngine->newUndefined();
         })
     );
 
+    // decodeAudioData(arrayBuffer, successCallback?, errorCallback?) -> Promise<AudioBuffer>
+    engine->setProperty(jsCtx, "decodeAudioData", engine->getGlobalProperty("__audioDecodeAudioData"));
+
     // resume() -> Promise - capture ctxPtr and jsCtxKey
     engine->setProperty(jsCtx, "resume",
         engine->newFunction("resume", [ctxPtr](void* c, const std::vector<js::JSValueHandle>& args) -> js::JSValueHandle {
@@ -340,6 +367,26 @@ void initializeAudioBindings(js::Engine* engine) {
 
     engine->setGlobalProperty("AudioContext", audioContextCtor);
 
+    // Promise wrapper shared by every context's decodeAudioData (uses this._decodeAudioDataAsync)
+    const char* decodePolyfill = R"(
+globalThis.__audioDecodeAudioData = function(arrayBuffer, successCallback, errorCallback) {
+    return new Promise((resolve, reject) => {
+        const fail = (message) => {
+            const error = new Error(message);
+            if (errorCallback) errorCallback(error);
+            reject(error);
+        };
+        const error = this._decodeAudioDataAsync(arrayBuffer, (audioBuffer, message) => {
+            if (message) return fail(message);
+            if (successCallback) successCallback(audioBuffer);
+            resolve(audioBuffer);
+        });
+        if (error) fail(error);
+    });
+};
+)";
+    engine->eval(decodePolyfill, "audio-decode.js");
+
     // Also support webkitAudioContext for compatibility
     engine->setGlobalProperty("webkitAudioContext", audioContextCtor);
 
@@ -3,6 +3,7 @@
  */
 
 #include "mystral/audio/audio_context.h"
+#include "mystral/async/runtime_clock.h"
 #include <SDL3/SDL.h>
 #include <iostream>
 #include <cstring>
@@ -199,6 +200,7 @@ void AudioBufferSourceNode::process(float* output, size_t numFrames, int numChan
 
 AudioContext::AudioContext() {
     destination_ = std::make_unique<AudioDestinationNode>(this);
+    clockOriginMs_ = async::RuntimeClock::instance().nowMs();
 
     // Initialize SDL audio
     if (!SDL_WasInit(SDL_INIT_AUDIO)) {
@@ -234,6 +236,12 @@ AudioContext::~AudioContext() {
 }
 
 double AudioContext::currentTime() const {
+    // Virtual time: the mixer and JS both follow the runtime clock, so
+    // scheduled sources start on the simulated timeline
+    auto& clock = async::RuntimeClock::instance();
+    if (clock.isVirtual()) {
+        return (clock.nowMs() - clockOriginMs_) / 1000.0;
+    }
     return static_cast<double>(sampleCount_) / sampleRate_;
 }
 
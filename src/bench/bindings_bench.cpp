@@ -0,0 +1,357 @@
+/**
+ * Binding-Layer Microbenchmarks (mystral-bench-bindings)
+ *
+ * Measures the cost of the js::Engine abstraction itself: native function
+ * calls by arity, property access, ArrayBuffer and typed array creation,
+ * protect/unprotect and calls into JS. Runs against every engine compiled
+ * into the build (QuickJS, V8, JavaScriptCore) and needs no GPU or window.
+ *
+ * Usage:
+ *   mystral-bench-bindings [--engine quickjs|v8|jsc] [--filter <substr>]
+ *                          [--min-time <ms>] [--samples <n>] [--json <file>]
+ *
+ * Each benchmark is calibrated until one sample takes --min-time, then the
+ * median of --samples samples is reported in nanoseconds per operation.
+ * Handles are released as they would be in binding code, so the numbers
+ * include the engine's handle bookkeeping.
+ */
+
+#include "mystral/js/engine.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using mystral::js::Engine;
+using mystral::js::EngineType;
+using mystral::js::JSValueHandle;
+
+namespace {
+
+struct Options {
+    std::string engine;  // Empty = every compiled-in engine
+    std::string filter;
+    double minTimeMs = 50;
+    int samples = 5;
+    std::string jsonPath;
+};
+
+/**
+ * One benchmark: run(n) performs the operation n times
+ */
+struct Benchmark {
+    std::string name;
+    std::function<void(Engine&, uint64_t)> run;
+};
+
+struct Result {
+    std::string engine;
+    std::string name;
+    double nsPerOp = 0;
+    uint64_t iterations = 0;
+};
+
+// Fixtures shared by the benchmarks of one engine (protected, so they outlive clearFrameHandles)
+struct Fixtures {
+    JSValueHandle object;
+    JSValueHandle jsLoops[5];     // function(n) calling the native function of arity i n times
+    JSValueHandle emptyLoop;      // function(n) with an empty loop body
+    JSValueHandle jsFunction0;    // function() {}
+    JSValueHandle jsFunction2;    // function(a, b) { return a; }
+    JSValueHandle number;
+    std::vector<uint8_t> bytes;
+    std::vector<float> floats;
+};
+
+Fixtures g_fixtures;
+
+/**
+ * Evaluate `expression` and keep the result alive across frames
+ */
+JSValueHandle protectedEval(Engine& engine, const char* expression) {
+    JSValueHandle value = engine.evalWithResult(expression, "bench-bindings.js");
+    engine.protect(value);
+    return value;
+}
+
+void setupFixtures(Engine& engine) {
+    g_fixtures.object = engine.newObject();
+    engine.protect(g_fixtures.object);
+    g_fixtures.number = engine.newNumber(42);
+    engine.protect(g_fixtures.number);
+    engine.setProperty(g_fixtures.object, "x", g_fixtures.number);
+
+    // Native functions of arity 0-4, each called from a tight JS loop
+    for (int arity = 0; arity <= 4; arity++) {
+        std::string name = "__benchNative" + std::to_string(arity);
+        engine.setGlobalProperty(name.c_str(), engine.newFunction(name.c_str(),
+            [&engine](void* ctx, const std::vector<JSValueHandle>& args) {
+                return engine.newUndefined();
+            }));
+
+        std::string argList;
+        for (int i = 0; i < arity; i++) {
+            argList += (i ? ", " : "") + std::to_string(i + 1);
+        }
+        std::string loop = "(function(n) { const f = " + name + "; for (let i = 0; i < n; i++) f(" + argList + "); })";
+        g_fixtures.jsLoops[arity] = protectedEval(engine, loop.c_str());
+    }
+
+    g_fixtures.emptyLoop = protectedEval(engine, "(function(n) { for (let i = 0; i < n; i++) {} })");
+    g_fixtures.jsFunction0 = protectedEval(engine, "(function() {})");
+    g_fixtures.jsFunction2 = protectedEval(engine, "(function(a, b) { return a; })");
+
+    g_fixtures.bytes.assign(1 << 20, 0xAB);
+    g_fixtures.floats.assign(1024, 1.0f);
+}
+
+void releaseFixtures(Engine& engine) {
+    for (auto& loop : g_fixtures.jsLoops) {
+        engine.unprotect(loop);
+    }
+    engine.unprotect(g_fixtures.emptyLoop);
+    engine.unprotect(g_fixtures.jsFunction0);
+    engine.unprotect(g_fixtures.jsFunction2);
+    engine.unprotect(g_fixtures.number);
+    engine.unprotect(g_fixtures.object);
+}
+
+/**
+ * Run a JS loop fixture for n iterations (one engine.call for the whole batch)
+ */
+void callLoop(Engine& engine, JSValueHandle loop, uint64_t n) {
+    JSValueHandle count = engine.newNumber(static_cast<double>(n));
+    JSValueHandle undefined = engine.newUndefined();
+    engine.releaseHandle(engine.call(loop, undefined, {count}));
+    engine.releaseHandle(undefined);
+    engine.releaseHandle(count);
+}
+
+std::vector<Benchmark> makeBenchmarks() {
+    std::vector<Benchmark> benchmarks;
+
+    benchmarks.push_back({"js_loop/empty", [](Engine& engine, uint64_t n) {
+        callLoop(engine, g_fixtures.emptyLoop, n);
+    }});
+    for (int arity = 0; arity <= 4; arity++) {
+        benchmarks.push_back({"native_call/arity" + std::to_string(arity), [arity](Engine& engine, uint64_t n) {
+            callLoop(engine, g_fixtures.jsLoops[arity], n);
+        }});
+    }
+
+    benchmarks.push_back({"property/get", [](Engine& engine, uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            engine.releaseHandle(engine.getProperty(g_fixtures.object, "x"));
+        }
+    }});
+    benchmarks.push_back({"property/set", [](Engine& engine, uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            engine.setProperty(g_fixtures.object, "y", g_fixtures.number);
+        }
+    }});
+    benchmarks.push_back({"property/set_new_number", [](Engine& engine, uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            JSValueHandle value = engine.newNumber(static_cast<double>(i));
+            engine.setProperty(g_fixtures.object, "y", value);
+            engine.releaseHandle(value);
+        }
+    }});
+
+    for (size_t size : {size_t(64), size_t(4096), size_t(1) << 20}) {
+        std::string suffix = "/" + std::to_string(size);
+        benchmarks.push_back({"array_buffer/copy" + suffix, [size](Engine& engine, uint64_t n) {
+            for (uint64_t i = 0; i < n; i++) {
+                engine.releaseHandle(engine.newArrayBuffer(g_fixtures.bytes.data(), size));
+            }
+        }});
+        benchmarks.push_back({"array_buffer/external" + suffix, [size](Engine& engine, uint64_t n) {
+            for (uint64_t i = 0; i < n; i++) {
+                engine.releaseHandle(engine.newArrayBufferExternal(g_fixtures.bytes.data(), size));
+            }
+        }});
+    }
+
+    // unprotect() also frees the handle, so each iteration needs a fresh value;
+    // subtract object/new for the cost of protect/unprotect alone
+    benchmarks.push_back({"object/new", [](Engine& engine, uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            engine.releaseHandle(engine.newObject());
+        }
+    }});
+    benchmarks.push_back({"object/new_protect_unprotect", [](Engine& engine, uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            JSValueHandle value = engine.newObject();
+            engine.protect(value);
+            engine.unprotect(value);
+        }
+    }});
+
+    benchmarks.push_back({"call_js/arity0", [](Engine& engine, uint64_t n) {
+        JSValueHandle undefined = engine.newUndefined();
+        for (uint64_t i = 0; i < n; i++) {
+            engine.releaseHandle(engine.call(g_fixtures.jsFunction0, undefined, {}));
+        }
+        engine.releaseHandle(undefined);
+    }});
+    benchmarks.push_back({"call_js/arity2", [](Engine& engine, uint64_t n) {
+        JSValueHandle undefined = engine.newUndefined();
+        for (uint64_t i = 0; i < n; i++) {
+            engine.releaseHandle(engine.call(g_fixtures.jsFunction2, undefined, {g_fixtures.number, g_fixtures.number}));
+        }
+        engine.releaseHandle(undefined);
+    }});
+
+    for (size_t count : {size_t(16), size_t(1024)}) {
+        std::string suffix = "/" + std::to_string(count);
+        benchmarks.push_back({"typed_array/float32_copy" + suffix, [count](Engine& engine, uint64_t n) {
+            for (uint64_t i = 0; i < n; i++) {
+                engine.releaseHandle(engine.createFloat32Array(g_fixtures.floats.data(), count));
+            }
+        }});
+        benchmarks.push_back({"typed_array/float32_view" + suffix, [count](Engine& engine, uint64_t n) {
+            for (uint64_t i = 0; i < n; i++) {
+                engine.releaseHandle(engine.createFloat32ArrayView(g_fixtures.floats.data(), count));
+            }
+        }});
+        benchmarks.push_back({"typed_array/uint8_copy" + suffix, [count](Engine& engine, uint64_t n) {
+            for (uint64_t i = 0; i < n; i++) {
+                engine.releaseHandle(engine.createUint8Array(g_fixtures.bytes.data(), count));
+            }
+        }});
+    }
+
+    return benchmarks;
+}
+
+/**
+ * Time one batch of n operations as one runtime frame would see it
+ */
+double timeBatch(Engine& engine, const Benchmark& benchmark, uint64_t n) {
+    engine.beginFrame();
+    auto start = std::chrono::steady_clock::now();
+    benchmark.run(engine, n);
+    auto end = std::chrono::steady_clock::now();
+    engine.clearFrameHandles();
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+Result runBenchmark(Engine& engine, const Benchmark& benchmark, const Options& options) {
+    // Grow the batch until one sample takes at least minTimeMs
+    uint64_t n = 1;
+    double ns = timeBatch(engine, benchmark, n);
+    while (ns < options.minTimeMs * 1e6 && n < (uint64_t(1) << 32)) {
+        double scale = ns > 0 ? options.minTimeMs * 1e6 / ns : 10;
+        n = std::max(n + 1, static_cast<uint64_t>(n * std::min(10.0, scale * 1.2)));
+        ns = timeBatch(engine, benchmark, n);
+    }
+
+    std::vector<double> perOp;
+    for (int i = 0; i < options.samples; i++) {
+        perOp.push_back(timeBatch(engine, benchmark, n) / n);
+    }
+    std::sort(perOp.begin(), perOp.end());
+
+    Result result;
+    result.engine = engine.getName();
+    result.name = benchmark.name;
+    result.nsPerOp = perOp[perOp.size() / 2];
+    result.iterations = n;
+    return result;
+}
+
+bool parseArgs(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--engine" && i + 1 < argc) {
+            options.engine = argv[++i];
+        } else if (arg == "--filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            options.minTimeMs = std::stod(argv[++i]);
+        } else if (arg == "--samples" && i + 1 < argc) {
+            options.samples = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--json" && i + 1 < argc) {
+            options.jsonPath = argv[++i];
+        } else if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: mystral-bench-bindings [--engine quickjs|v8|jsc] [--filter <substr>]\n"
+                         "                              [--min-time <ms>] [--samples <n>] [--json <file>]\n";
+            return false;
+        } else {
+            std::cerr << "Warning: Unknown option '" << arg << "'" << std::endl;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseArgs(argc, argv, options)) {
+        return 0;
+    }
+
+    struct EngineChoice {
+        EngineType type;
+        const char* name;
+    };
+    const EngineChoice engines[] = {
+        {EngineType::QuickJS, "quickjs"},
+        {EngineType::V8, "v8"},
+        {EngineType::JavaScriptCore, "jsc"},
+    };
+
+    std::vector<Result> results;
+    for (const auto& choice : engines) {
+        if (!options.engine.empty() && options.engine != choice.name) {
+            continue;
+        }
+        auto engine = mystral::js::createEngine(choice.type);
+        if (!engine) {
+            continue;  // Not compiled into this build
+        }
+
+        setupFixtures(*engine);
+        std::cout << "\n=== " << engine->getName() << " ===" << std::endl;
+        for (const auto& benchmark : makeBenchmarks()) {
+            if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos) {
+                continue;
+            }
+            Result result = runBenchmark(*engine, benchmark, options);
+            std::cout << std::left << std::setw(36) << result.name << std::right << std::fixed
+                      << std::setprecision(1) << std::setw(12) << result.nsPerOp << " ns/op"
+                      << std::setw(14) << result.iterations << " iters" << std::endl;
+            results.push_back(result);
+        }
+        releaseFixtures(*engine);
+        engine->gc();
+    }
+
+    if (results.empty()) {
+        std::cerr << "Error: No engine to benchmark" << (options.engine.empty() ? "" : " (--engine " + options.engine + ")") << std::endl;
+        return 1;
+    }
+
+    if (!options.jsonPath.empty()) {
+        std::ofstream out(options.jsonPath);
+        if (!out.is_open()) {
+            std::cerr << "Error: Cannot write " << options.jsonPath << std::endl;
+            return 1;
+        }
+        out << std::fixed << std::setprecision(2) << "[\n";
+        for (size_t i = 0; i < results.size(); i++) {
+            const auto& result = results[i];
+            out << "  {\"engine\": \"" << result.engine << "\", \"name\": \"" << result.name
+                << "\", \"nsPerOp\": " << result.nsPerOp << ", \"iterations\": " << result.iterations << "}"
+                << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "]\n";
+    }
+    return 0;
+}
@@ -0,0 +1,310 @@
+/**
+ * ESM Transform Benchmark (mystral-bench-esm)
+ *
+ * Times transformEsmToCjs(), the ESM to CommonJS rewrite that QuickJS and
+ * JavaScriptCore builds run on every ES module they load, over real files
+ * (bundled libraries make good inputs). No JS engine is involved.
+ *
+ * Usage:
+ *   mystral-bench-esm [--samples <n>] [--baseline] <file> [<file>...]
+ *
+ * Reports the median time per file over --samples runs, throughput in MB/s,
+ * and how many import/export statements the lexer found. --baseline also
+ * times the regex converter the lexer replaced on the same input (it builds
+ * a dozen std::regex objects per line, so expect about a second per 10 KB).
+ */
+
+#include "mystral/js/esm_lexer.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string trimLeft(const std::string& value) {
+    size_t start = 0;
+    while (start < value.size() && std::isspace(static_cast<unsigned char>(value[start]))) {
+        start++;
+    }
+    return value.substr(start);
+}
+
+std::vector<std::string> splitCommaSeparated(const std::string& value) {
+    std::vector<std::string> parts;
+    std::string current;
+    int depth = 0;
+    for (char c : value) {
+        if (c == '{' || c == '[' || c == '(') {
+            depth++;
+        } else if (c == '}' || c == ']' || c == ')') {
+            depth--;
+        }
+        if (c == ',' && depth == 0) {
+            parts.push_back(current);
+            current.clear();
+        } else {
+            current.push_back(c);
+        }
+    }
+    if (!current.empty()) {
+        parts.push_back(current);
+    }
+    return parts;
+}
+
+std::string trim(const std::string& value) {
+    size_t start = 0;
+    while (start < value.size() && std::isspace(static_cast<unsigned char>(value[start]))) {
+        start++;
+    }
+    size_t end = value.size();
+    while (end > start && std::isspace(static_cast<unsigned char>(value[end - 1]))) {
+        end--;
+    }
+    return value.substr(start, end - start);
+}
+
+// The line-based std::regex converter that transformEsmToCjs() replaced,
+// kept verbatim (regexes built per line, as shipped) for --baseline timing
+std::string regexTransformEsmToCjs(const std::string& source) {
+    std::istringstream input(source);
+    std::ostringstream output;
+    bool usesExports = false;
+
+    std::string line;
+    while (std::getline(input, line)) {
+        std::string trimmed = trimLeft(line);
+
+        std::smatch match;
+        std::regex importDefault(R"(^import\s+([A-Za-z_$][\w$]*)\s+from\s+['"]([^'"]+)['"]\s*;?\s*$)");
+        std::regex importAll(R"(^import\s+\*\s+as\s+([A-Za-z_$][\w$]*)\s+from\s+['"]([^'"]+)['"]\s*;?\s*$)");
+        std::regex importNamed(R"(^import\s+\{([^}]+)\}\s+from\s+['"]([^'"]+)['"]\s*;?\s*$)");
+        std::regex importMixed(R"(^import\s+([A-Za-z_$][\w$]*)\s*,\s*\{([^}]+)\}\s+from\s+['"]([^'"]+)['"]\s*;?\s*$)");
+        std::regex importMixedAll(R"(^import\s+([A-Za-z_$][\w$]*)\s*,\s*\*\s+as\s+([A-Za-z_$][\w$]*)\s+from\s+['"]([^'"]+)['"]\s*;?\s*$)");
+        std::regex importSideEffect(R"(^import\s+['"]([^'"]+)['"]\s*;?\s*$)");
+
+        if (std::regex_match(trimmed, match, importMixed)) {
+            std::string defaultName = match[1];
+            std::string namedList = trim(match[2]);
+            std::string spec = match[3];
+            output << "const __mod = require(\"" << spec << "\");\n";
+            output << "const " << defaultName << " = (__mod && __mod.__esModule) ? __mod.default : __mod;\n";
+            output << "const { " << namedList << " } = __mod;\n";
+            continue;
+        }
+        if (std::regex_match(trimmed, match, importMixedAll)) {
+            std::string defaultName = match[1];
+            std::string nsName = match[2];
+            std::string spec = match[3];
+            output << "const __mod = require(\"" << spec << "\");\n";
+            output << "const " << defaultName << " = (__mod && __mod.__esModule) ? __mod.default : __mod;\n";
+            output << "const " << nsName << " = __mod;\n";
+            continue;
+        }
+        if (std::regex_match(trimmed, match, importDefault)) {
+            std::string defaultName = match[1];
+            std::string spec = match[2];
+            output << "const __mod = require(\"" << spec << "\");\n";
+            output << "const " << defaultName << " = (__mod && __mod.__esModule) ? __mod.default : __mod;\n";
+            continue;
+        }
+        if (std::regex_match(trimmed, match, importAll)) {
+            std::string nsName = match[1];
+            std::string spec = match[2];
+            output << "const " << nsName << " = require(\"" << spec << "\");\n";
+            continue;
+        }
+        if (std::regex_match(trimmed, match, importNamed)) {
+            std::string namedList = trim(match[1]);
+            std::string spec = match[2];
+            output << "const { " << namedList << " } = require(\"" << spec << "\");\n";
+            continue;
+        }
+        if (std::regex_match(trimmed, match, importSideEffect)) {
+            std::string spec = match[1];
+            output << "require(\"" << spec << "\");\n";
+            continue;
+        }
+
+        std::regex exportDefaultFunc(R"(^export\s+default\s+function\s+([A-Za-z_$][\w$]*)\s*\()");
+        std::regex exportDefaultClass(R"(^export\s+default\s+class\s+([A-Za-z_$][\w$]*)\s*)");
+        std::regex exportDefault(R"(^export\s+default\s+(.+);?\s*$)");
+        std::regex exportNamedDecl(R"(^export\s+(const|let|var|function|class)\s+([A-Za-z_$][\w$]*)\s*)");
+        std::regex exportNamedList(R"(^export\s+\{([^}]+)\}\s*;?\s*$)");
+        std::regex exportNamedFrom(R"(^export\s+\{([^}]+)\}\s+from\s+['"]([^'"]+)['"]\s*;?\s*$)");
+        std::regex exportAllFrom(R"(^export\s+\*\s+from\s+['"]([^'"]+)['"]\s*;?\s*$)");
+
+        if (std::regex_search(trimmed, match, exportDefaultFunc)) {
+            usesExports = true;
+            line = std::regex_replace(line, std::regex("^\\s*export\\s+default\\s+"), "");
+            output << line << "\n";
+            output << "exports.default = " << match[1] << ";\n";
+            continue;
+        }
+        if (std::regex_search(trimmed, match, exportDefaultClass)) {
+            usesExports = true;
+            line = std::regex_replace(line, std::regex("^\\s*export\\s+default\\s+"), "");
+            output << line << "\n";
+            output << "exports.default = " << match[1] << ";\n";
+            continue;
+        }
+        if (std::regex_match(trimmed, match, exportNamedFrom)) {
+            usesExports = true;
+            std::string list = trim(match[1]);
+            std::string spec = match[2];
+            output << "const __mod = require(\"" << spec << "\");\n";
+            for (const auto& part : splitCommaSeparated(list)) {
+                std::string item = trim(part);
+                size_t asPos = item.find(" as ");
+                if (asPos != std::string::npos) {
+                    std::string left = trim(item.substr(0, asPos));
+                    std::string right = trim(item.substr(asPos + 4));
+                    if (left == "default") {
+                        output << "exports." << right << " = (__mod && __mod.__esModule) ? __mod.default : __mod;\n";
+                    } else {
+                        output << "exports." << right << " = __mod." << left << ";\n";
+                    }
+                } else {
+                    output << "exports." << item << " = __mod." << item << ";\n";
+                }
+            }
+            continue;
+        }
+        if (std::regex_match(trimmed, match, exportAllFrom)) {
+            usesExports = true;
+            std::string spec = match[1];
+            output << "Object.assign(exports, require(\"" << spec << "\"));\n";
+            continue;
+        }
+        if (std::regex_match(trimmed, match, exportNamedList)) {
+            usesExports = true;
+            std::string list = trim(match[1]);
+            for (const auto& part : splitCommaSeparated(list)) {
+                std::string item = trim(part);
+                size_t asPos = item.find(" as ");
+                if (asPos != std::string::npos) {
+                    std::string left = trim(item.substr(0, asPos));
+                    std::string right = trim(item.substr(asPos + 4));
+                    output << "exports." << right << " = " << left << ";\n";
+                } else {
+                    output << "exports." << item << " = " << item << ";\n";
+                }
+            }
+            continue;
+        }
+        if (std::regex_search(trimmed, match, exportNamedDecl)) {
+            usesExports = true;
+            line = std::regex_replace(line, std::regex("^\\s*export\\s+"), "");
+            output << line << "\n";
+            output << "exports." << match[2] << " = " << match[2] << ";\n";
+            continue;
+        }
+        if (std::regex_match(trimmed, match, exportDefault)) {
+            usesExports = true;
+            output << "exports.default = " << match[1] << ";\n";
+            continue;
+        }
+
+        output << line << "\n";
+    }
+
+    if (usesExports) {
+        std::ostringstream finalOut;
+        finalOut << "exports.__esModule = true;\n";
+        finalOut << output.str();
+        return finalOut.str();
+    }
+
+    return output.str();
+}
+
+
+bool readFile(const std::string& path, std::string& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    out = buffer.str();
+    return true;
+}
+
+// Median milliseconds over samples runs; outputSize gets the result's size
+double medianMs(const std::function<std::string()>& transform, int samples, size_t& outputSize) {
+    std::vector<double> times;
+    for (int s = 0; s < samples; s++) {
+        auto start = std::chrono::steady_clock::now();
+        std::string output = transform();
+        auto end = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        outputSize = output.size();
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+void report(const char* label, size_t sourceSize, size_t outputSize, double ms) {
+    double megabytes = sourceSize / (1024.0 * 1024.0);
+    std::cout << "  " << label << std::fixed << std::setprecision(1) << sourceSize / 1024.0 << " KB -> "
+              << outputSize / 1024.0 << " KB, " << std::setprecision(3) << ms << " ms ("
+              << std::setprecision(2) << (ms > 0 ? megabytes / (ms / 1000.0) : 0) << " MB/s)" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int samples = 5;
+    bool baseline = false;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--samples" && i + 1 < argc) {
+            samples = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--baseline") {
+            baseline = true;
+        } else if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: mystral-bench-esm [--samples <n>] [--baseline] <file> [<file>...]" << std::endl;
+            return 0;
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.empty()) {
+        std::cerr << "Usage: mystral-bench-esm [--samples <n>] [--baseline] <file> [<file>...]" << std::endl;
+        return 1;
+    }
+
+    int failures = 0;
+    for (const auto& path : files) {
+        std::string source;
+        if (!readFile(path, source)) {
+            std::cerr << "Cannot read " << path << std::endl;
+            failures++;
+            continue;
+        }
+
+        size_t statements = mystral::js::scanEsm(source).statements.size();
+        std::cout << path << " (" << statements << " statements)" << std::endl;
+
+        size_t outputSize = 0;
+        double lexerMs = medianMs([&] { return mystral::js::transformEsmToCjs(source); }, samples, outputSize);
+        report("lexer: ", source.size(), outputSize, lexerMs);
+
+        if (baseline) {
+            double regexMs = medianMs([&] { return regexTransformEsmToCjs(source); }, samples, outputSize);
+            report("regex: ", source.size(), outputSize, regexMs);
+            std::cout << "  speedup: " << std::setprecision(1) << (lexerMs > 0 ? regexMs / lexerMs : 0) << "x"
+                      << std::endl;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -13,11 +13,12 @@
 namespace mystral {
 namespace canvas {
 
-// Global storage for Canvas2D contexts (prevents them from being destroyed)
-static std::unordered_map<void*, std::unique_ptr<Canvas2DContext>> g_canvas2dContexts;
+// Storage for Canvas2D contexts (prevents them from being destroyed)
+// Per-thread: a worker that owns an OffscreenCanvas creates its contexts on its own engine
+static thread_local std::unordered_map<void*, std::unique_ptr<Canvas2DContext>> g_canvas2dContexts;
 
 // Store reference to JS engine for callbacks
-static js::Engine* g_jsEngine = nullptr;
+static thread_local js::Engine* g_jsEngine = nullptr;
 
 /**
  * Create a CanvasRenderingContext2D JS object that wraps a native Canvas2DContext
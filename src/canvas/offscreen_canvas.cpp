@@ -0,0 +1,152 @@
+/**
+ * OffscreenCanvas Implementation
+ *
+ * The triple buffer keeps three frames: the producer's back slot, the
+ * consumer's front slot and a shared middle slot. publish() swaps back with
+ * middle and marks it fresh; acquire() swaps front with middle only when it
+ * is fresh. One atomic exchange per side, no locks.
+ */
+
+#include "mystral/canvas/offscreen_canvas.h"
+#include "mystral/canvas/canvas2d.h"
+#include "mystral/js/structured_clone.h"
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+
+namespace mystral {
+namespace canvas {
+
+// Defined in canvas2d_bindings.cpp
+js::JSValueHandle createCanvas2DContext(js::Engine* engine, int width, int height);
+
+// ============================================================================
+// FrameTripleBuffer
+// ============================================================================
+
+void FrameTripleBuffer::publish() {
+    slots_[back_].serial = nextSerial_++;
+    int previous = middle_.exchange(back_ | kFreshBit, std::memory_order_acq_rel);
+    back_ = previous & ~kFreshBit;
+}
+
+const CanvasFrame* FrameTripleBuffer::acquire() {
+    if (middle_.load(std::memory_order_relaxed) & kFreshBit) {
+        int previous = middle_.exchange(front_, std::memory_order_acq_rel);
+        front_ = previous & ~kFreshBit;
+    }
+    const CanvasFrame& frame = slots_[front_];
+    return frame.serial ? &frame : nullptr;
+}
+
+// ============================================================================
+// TransferredCanvas
+// ============================================================================
+
+void TransferredCanvas::commit(const Canvas2DContext& context) {
+    const uint8_t* pixels = context.getPixelData();
+    size_t size = context.getPixelDataSize();
+    if (!pixels || size == 0) {
+        return;
+    }
+
+    CanvasFrame& frame = frames_.back();
+    frame.width = context.getWidth();
+    frame.height = context.getHeight();
+    frame.pixels.resize(size);
+    std::memcpy(frame.pixels.data(), pixels, size);
+    frames_.publish();
+}
+
+TransferredCanvas* createTransferredCanvas(int width, int height) {
+    return new TransferredCanvas(width, height);
+}
+
+// ============================================================================
+// JS bindings
+// ============================================================================
+
+// The 2D context of each canvas this thread has claimed (protected JS objects).
+// The thread keeps a reference to those canvases until it exits.
+struct OwnedContexts {
+    std::unordered_map<TransferredCanvas*, js::JSValueHandle> contexts;
+
+    ~OwnedContexts() {
+        for (auto& entry : contexts) {
+            entry.first->release();
+        }
+    }
+};
+static thread_local OwnedContexts g_owned;
+
+static void decorateOffscreenCanvas(js::Engine* engine, js::JSValueHandle object, TransferredCanvas* canvas) {
+    engine->setProperty(object, "width", engine->newNumber(canvas->width()));
+    engine->setProperty(object, "height", engine->newNumber(canvas->height()));
+
+    // getContext('2d') - the first thread to call it owns the canvas
+    engine->setProperty(object, "getContext",
+        engine->newFunction("getContext", [engine, canvas](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (args.empty() || engine->toString(args[0]) != "2d") {
+                return engine->newNull();
+            }
+
+            auto it = g_owned.contexts.find(canvas);
+            if (it != g_owned.contexts.end()) {
+                return it->second;
+            }
+            if (!canvas->claim()) {
+                engine->throwException("OffscreenCanvas is already rendered by another thread");
+                return engine->newUndefined();
+            }
+
+            // createCanvas2DContext() protects the context; it lives as long as this thread's engine
+            auto context = createCanvas2DContext(engine, canvas->width(), canvas->height());
+            canvas->addRef();
+            g_owned.contexts[canvas] = context;
+            return context;
+        })
+    );
+
+    // commit() - hand the current pixels to the compositor
+    engine->setProperty(object, "commit",
+        engine->newFunction("commit", [engine, canvas](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            auto it = g_owned.contexts.find(canvas);
+            if (it != g_owned.contexts.end()) {
+                auto* context = static_cast<Canvas2DContext*>(engine->getPrivateData(it->second));
+                if (context) {
+                    canvas->commit(*context);
+                }
+            }
+            return engine->newUndefined();
+        })
+    );
+}
+
+static void reviveOffscreenCanvas(js::Engine* engine, js::JSValueHandle object, void* handle) {
+    decorateOffscreenCanvas(engine, object, static_cast<TransferredCanvas*>(handle));
+}
+
+js::JSValueHandle createOffscreenCanvasObject(js::Engine* engine, TransferredCanvas* canvas) {
+    auto object = engine->newObject();
+    engine->setPrivateData(object, canvas);
+    engine->setProperty(object, "_type", engine->newString("offscreenCanvas"));
+    decorateOffscreenCanvas(engine, object, canvas);
+    canvas->addRef();
+    engine->registerRelease(object, [canvas]() { canvas->release(); });
+    return object;
+}
+
+void registerOffscreenCanvasHandle() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        js::NativeHandleOps ops;
+        ops.reviver = reviveOffscreenCanvas;
+        ops.addRef = [](void* handle) { static_cast<TransferredCanvas*>(handle)->addRef(); };
+        ops.release = [](void* handle) { static_cast<TransferredCanvas*>(handle)->release(); };
+        js::registerNativeHandleType("offscreenCanvas", ops);
+    });
+}
+
+}  // namespace canvas
+}  // namespace mystral
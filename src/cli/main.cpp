@@ -6,6 +6,7 @@
  * Usage:
  *   mystral run <script.js>                    Run a JavaScript file
  *   mystral run <script.js> --screenshot out.png  Run, screenshot, quit
+ *   mystral bench <script.js> --runs 5         Headless performance benchmark
  *   mystral --version                          Show version information
  *   mystral --help                             Show help
  */
@@ -15,6 +16,7 @@
 #include "mystral/js/module_resolver.h"
 #include "mystral/js/ts_transpiler.h"
 #include "mystral/debug/debug_server.h"
+#include "mystral/debug/trace.h"
 #include "mystral/video/async_capture.h"
 #include "mystral/video/video_recorder.h"
 #include <iostream>
@@ -32,6 +34,9 @@
 #include <regex>
 #include <queue>
 #include <array>
+#include <algorithm>
+#include <map>
+#include <iomanip>
 
 // WebP animation encoding (for video recording)
 #ifdef MYSTRAL_HAS_WEBP_MUX
@@ -299,6 +304,7 @@ USAGE:
     mystral compile <entry.js> [options]      Bundle JS + assets into a single binary
     mystral --compile <entry.js> [options]    Same as compile
     mystral bake <input.glb|input.js> [options]  Bake lightmaps for a scene
+    mystral bench <script.js> [options]       Benchmark a script headless with virtual time
     mystral --version                         Show version information
     mystral --help                            Show this help message
 
@@ -309,8 +315,18 @@ RUN OPTIONS:
     --headless            Run with hidden window (background mode)
     --no-sdl              Run without SDL (headless GPU, no window system required)
     --watch, -w           Watch mode: reload script on file changes
+    --no-transpile-cache  Don't keep transpiled TypeScript on disk between runs
     --screenshot <file>   Take screenshot after N frames and quit
     --frames <n>          Number of frames before screenshot (default: 60)
+    --max-fps <n>         Cap requestAnimationFrame to n frames per second (default: uncapped)
+    --low-latency         Start a frame as soon as input arrives instead of at the next deadline
+    --no-coalesce         Dispatch every mouse motion event instead of one pointermove per frame
+    --virtual-time        Deterministic time: each frame advances the clock by --fixed-dt and
+                          frames run back to back (performance.now, rAF, timers, audio)
+    --fixed-dt <ms>       Virtual time step per frame; implies --virtual-time
+                          (default: 1000/60, or 1000/--video-fps when recording)
+    --trace <file>        Record a frame timeline (main, worker and job threads) as Chrome
+                          trace-event JSON, viewable in Perfetto or chrome://tracing
     --quiet, -q           Suppress all output except errors
 
 VIDEO RECORDING OPTIONS:
@@ -337,6 +353,20 @@ COMPILE OPTIONS:
     --root <dir>          Root directory for bundle paths (default: cwd)
     --bundle-only         Create standalone .bundle file (no exe, for .app packaging)
 
+BENCH OPTIONS:
+    --warmup <n>          Frames run before measuring (default: 60)
+    --frames <n>          Frames measured per run (default: 300)
+    --runs <n>            Runs, each in a fresh process (default: 5)
+    --output <file>       Write the JSON report here (default: stdout)
+    --baseline <file>     Compare against an earlier report; exits 1 on regressions
+    --threshold <pct>     Allowed increase over the baseline (default: 5; zero metrics must stay zero)
+    --no-sdl              Run without SDL (default: hidden window)
+    --trace <file>        Trace each run (<file> gets a .runN suffix)
+
+    Runs are pinned: virtual time at 1000/60 ms per frame, no frame cap,
+    default window size unless --width/--height are given. Reported values
+    are medians across runs.
+
 BAKE OPTIONS (Lightmap Generation):
     --output <dir>        Output directory for lightmaps (default: ./lightmaps)
     --resolution <n>      Max lightmap atlas size (default: 2048)
@@ -383,6 +413,8 @@ EXAMPLES:
     mystral compile game.js --include assets --out game.bundle --bundle-only  # Standalone bundle file
     mystral bake scene.glb --output ./lightmaps               # Bake lightmaps for scene
     mystral bake game.js --resolution 1024 --samples 128      # Bake with custom settings
+    mystral bench game.js --output base.json                  # Record a baseline
+    mystral bench game.js --baseline base.json --threshold 10 # Regression check
 
 ENVIRONMENT:
     MYSTRAL_HEADLESS=1        Run in headless mode (hidden window)
@@ -412,13 +444,25 @@ struct CLIOptions {
     bool showVersion = false;
     bool headless = false;
     bool watch = false;  // Watch mode for hot reloading
+    bool noTranspileCache = false;  // Keep SWC output in memory only
 
     // Screenshot mode
     std::string screenshotPath;
     int frames = 60;
+    bool framesSet = false;  // --frames given (bench has its own default)
     bool quiet = false;
     bool noSdl = false;  // Run without SDL (headless GPU, no window)
 
+    // Frame pacing
+    double maxFps = 0;        // 0 = uncapped
+    bool lowLatency = false;  // Wake for input instead of sleeping to the frame deadline
+    bool noCoalesce = false;  // Dispatch every motion event (no per-frame pointermove merging)
+    bool virtualTime = false; // Deterministic clock advanced per frame
+    double fixedDtMs = 0;     // 0 = derive from the video/display frame rate
+
+    // Profiling
+    std::string tracePath;    // Write a trace-event timeline here on exit
+
     // Video recording mode
     std::string videoPath;      // Output video path
     int startFrame = 0;         // First frame to capture
@@ -444,6 +488,14 @@ struct CLIOptions {
     int bakeResolution = 2048;   // Max lightmap atlas size
     int bakeSamples = 64;        // Rays per texel
     int bakeBounces = 2;         // Light bounces for GI
+
+    // Bench options
+    int warmupFrames = 60;       // Frames before measuring
+    int benchRuns = 5;           // Fresh processes per benchmark
+    std::string baselinePath;    // Earlier report to compare against
+    double thresholdPct = 5;     // Allowed increase before a metric is a regression
+    std::string benchChildOut;   // Internal: run once and write results here
+    std::string selfPath;        // argv[0], to spawn bench runs
 };
 
 CLIOptions parseArgs(int argc, char* argv[]) {
@@ -474,6 +526,20 @@ CLIOptions parseArgs(int argc, char* argv[]) {
             opts.screenshotPath = argv[++i];
         } else if (arg == "--frames" && i + 1 < argc) {
             opts.frames = std::stoi(argv[++i]);
+            opts.framesSet = true;
+        } else if (arg == "--max-fps" && i + 1 < argc) {
+            opts.maxFps = std::stod(argv[++i]);
+        } else if (arg == "--low-latency") {
+            opts.lowLatency = true;
+        } else if (arg == "--no-coalesce") {
+            opts.noCoalesce = true;
+        } else if (arg == "--virtual-time") {
+            opts.virtualTime = true;
+        } else if (arg == "--fixed-dt" && i + 1 < argc) {
+            opts.fixedDtMs = std::stod(argv[++i]);
+            opts.virtualTime = true;
+        } else if (arg == "--trace" && i + 1 < argc) {
+            opts.tracePath = argv[++i];
         } else if (arg == "--quiet" || arg == "-q") {
             opts.quiet = true;
         } else if (arg == "--headless") {
@@ -482,6 +548,8 @@ CLIOptions parseArgs(int argc, char* argv[]) {
             opts.noSdl = true;
         } else if (arg == "--watch" || arg == "-w") {
             opts.watch = true;
+        } else if (arg == "--no-transpile-cache") {
+            opts.noTranspileCache = true;
         } else if (arg == "--bundle-only") {
             opts.bundleOnly = true;
         } else if ((arg == "--video" || arg == "--record") && i + 1 < argc) {
@@ -517,18 +585,32 @@ CLIOptions parseArgs(int argc, char* argv[]) {
             opts.bakeSamples = std::stoi(argv[++i]);
         } else if (arg == "--bounces" && i + 1 < argc) {
             opts.bakeBounces = std::stoi(argv[++i]);
+        } else if (arg == "--warmup" && i + 1 < argc) {
+            opts.warmupFrames = std::stoi(argv[++i]);
+        } else if (arg == "--runs" && i + 1 < argc) {
+            opts.benchRuns = std::stoi(argv[++i]);
+        } else if (arg == "--baseline" && i + 1 < argc) {
+            opts.baselinePath = argv[++i];
+        } else if (arg == "--threshold" && i + 1 < argc) {
+            opts.thresholdPct = std::stod(argv[++i]);
+        } else if (arg == "--bench-child" && i + 1 < argc) {
+            opts.benchChildOut = argv[++i];
         } else if ((arg == "run") && opts.command.empty()) {
             opts.command = "run";
         } else if ((arg == "compile" || arg == "--compile") && opts.command.empty()) {
             opts.command = "compile";
         } else if ((arg == "bake") && opts.command.empty()) {
             opts.command = "bake";
+        } else if ((arg == "bench") && opts.command.empty()) {
+            opts.command = "bench";
         } else if (opts.command == "run" && opts.scriptPath.empty()) {
             opts.scriptPath = arg;
         } else if (opts.command == "compile" && opts.scriptPath.empty() && (arg.empty() || arg[0] != '-')) {
             opts.scriptPath = arg;
         } else if (opts.command == "bake" && opts.scriptPath.empty() && (arg.empty() || arg[0] != '-')) {
             opts.scriptPath = arg;
+        } else if (opts.command == "bench" && opts.scriptPath.empty() && (arg.empty() || arg[0] != '-')) {
+            opts.scriptPath = arg;
         } else if (arg[0] == '-') {
             // Unknown flag - warn the user
             std::cerr << "Warning: Unknown option '" << arg << "'" << std::endl;
@@ -1285,6 +1367,13 @@ static int compileBundle(const CLIOptions& opts) {
     return 0;
 }
 
+// Write the --trace timeline; every exit path of runScript calls this before _exit()
+static void finishTrace(const CLIOptions& opts) {
+    if (!opts.tracePath.empty() && mystral::debug::trace::isEnabled()) {
+        mystral::debug::trace::stopAndWrite(opts.tracePath);
+    }
+}
+
 int runScript(const CLIOptions& opts) {
     // Enable headless mode via environment variable (SDL3 uses this)
     if (opts.headless) {
@@ -1318,6 +1407,12 @@ int runScript(const CLIOptions& opts) {
         if (opts.watch) {
             std::cout << "Watch mode: enabled (hot reload on file changes)" << std::endl;
         }
+        if (opts.virtualTime) {
+            std::cout << "Virtual time: enabled" << std::endl;
+        }
+        if (!opts.tracePath.empty()) {
+            std::cout << "Trace: " << opts.tracePath << std::endl;
+        }
         if (opts.debugPort > 0) {
             std::cout << "Debug server: port " << opts.debugPort << std::endl;
         }
@@ -1339,6 +1434,21 @@ int runScript(const CLIOptions& opts) {
     config.noSdl = opts.noSdl;
     config.watch = opts.watch;
     config.debug = debugMode;
+    config.transpileCache = !opts.noTranspileCache;
+    config.maxFps = opts.maxFps;
+    config.lowLatency = opts.lowLatency;
+    config.coalescePointerMoves = !opts.noCoalesce;
+    config.virtualTime = opts.virtualTime;
+    if (opts.fixedDtMs > 0) {
+        config.fixedDtMs = opts.fixedDtMs;
+    } else if (videoMode) {
+        config.fixedDtMs = 1000.0 / opts.videoFps;  // One recorded frame per step
+    }
+
+    if (!opts.tracePath.empty()) {
+        mystral::debug::trace::setThreadName("Main");
+        mystral::debug::trace::start();
+    }
 
     auto runtime = mystral::Runtime::create(config);
     if (!runtime) {
@@ -1364,8 +1474,10 @@ int runScript(const CLIOptions& opts) {
                 break;
             }
 
-            // Small delay to let GPU work complete
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            // Small delay to let GPU work complete (virtual time runs flat out)
+            if (!opts.virtualTime) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
         }
 
         auto endTime = std::chrono::high_resolution_clock::now();
@@ -1386,6 +1498,7 @@ int runScript(const CLIOptions& opts) {
         // In screenshot mode, use _exit() to avoid cleanup crashes
         // that can trigger the macOS crash dialog. The screenshot is
         // already saved, so we don't need graceful shutdown.
+        finishTrace(opts);
         std::cout.flush();
         std::cerr.flush();
         _exit(success ? 0 : 1);
@@ -1573,6 +1686,7 @@ int runScript(const CLIOptions& opts) {
                 }
             }
 
+            finishTrace(opts);
             std::cout.flush();
             std::cerr.flush();
             _exit(success ? 0 : 1);
@@ -1654,6 +1768,7 @@ int runScript(const CLIOptions& opts) {
         runtime.reset();
         SDL_PumpEvents();
 
+        finishTrace(opts);
         std::cout.flush();
         std::cerr.flush();
         _exit(success ? 0 : 1);
@@ -1895,6 +2010,7 @@ int runScript(const CLIOptions& opts) {
         if (!opts.quiet) {
             std::cout << "=== Script finished ===" << std::endl;
         }
+        finishTrace(opts);
 
         // Note: On macOS, SDL3's audio callback threads can prevent graceful shutdown.
         // The CoreAudio subsystem sometimes blocks even _exit(). SIGKILL is the only
@@ -1919,6 +2035,375 @@ int runScript(const CLIOptions& opts) {
     return 0;
 }
 
+// ============================================================================
+// Benchmark Mode (mystral bench)
+// ============================================================================
+
+/**
+ * A value recorded by each benchmark run
+ */
+struct BenchMetric {
+    const char* key;
+    bool gated;  // Compared against --baseline (all metrics are lower-is-better)
+};
+
+// Keys are unique across the report, so extractJsonNumber() on a report finds
+// the "summary" value, which is written first.
+static const BenchMetric kBenchMetrics[] = {
+    {"gpu_init_ms", false},
+    {"js_init_ms", false},
+    {"script_load_ms", false},
+    {"startup_ms", true},
+    {"frames_rendered", false},
+    {"frame_mean_ms", true},
+    {"frame_p50_ms", true},
+    {"frame_p95_ms", true},
+    {"frame_p99_ms", true},
+    {"frame_max_ms", false},
+    {"long_frames", true},
+    {"js_heap_bytes", true},
+    {"native_bytes", true},
+    {"gpu_bytes", true},
+    {"draw_calls_per_frame", true},
+    {"dispatches_per_frame", true},
+    {"submits_per_frame", true},
+};
+
+using BenchResult = std::map<std::string, double>;
+
+static void writeBenchResult(std::ostream& out, const BenchResult& result, const std::string& indent) {
+    bool first = true;
+    for (const auto& metric : kBenchMetrics) {
+        auto it = result.find(metric.key);
+        if (it == result.end()) continue;
+        out << (first ? "" : ",\n") << indent << "\"" << metric.key << "\": " << it->second;
+        first = false;
+    }
+    out << "\n";
+}
+
+/**
+ * Quote one argument for the std::system() command line
+ * POSIX sh: single quotes, with embedded ' written as '\''. Windows: double
+ * quotes with the C runtime's argv escaping (\" for a quote, backslashes
+ * doubled before a quote).
+ */
+static std::string quoteArg(const std::string& arg) {
+#ifdef _WIN32
+    std::string quoted = "\"";
+    size_t backslashes = 0;
+    for (char c : arg) {
+        if (c == '\\') {
+            backslashes++;
+            continue;
+        }
+        if (c == '"') {
+            quoted.append(backslashes * 2 + 1, '\\');
+        } else {
+            quoted.append(backslashes, '\\');
+        }
+        backslashes = 0;
+        quoted += c;
+    }
+    quoted.append(backslashes * 2, '\\');  // Before the closing quote
+    quoted += '"';
+    return quoted;
+#else
+    std::string quoted = "'";
+    for (char c : arg) {
+        if (c == '\'') {
+            quoted += "'\\''";
+        } else {
+            quoted += c;
+        }
+    }
+    quoted += '\'';
+    return quoted;
+#endif
+}
+
+/**
+ * Run the script once with the pinned configuration and write a flat JSON result
+ * (the child side of `mystral bench`; runs in its own process)
+ */
+static int runBenchmarkOnce(const CLIOptions& opts) {
+    if (!opts.noSdl) {
+        #ifdef _WIN32
+        _putenv_s("MYSTRAL_HEADLESS", "1");
+        #else
+        setenv("MYSTRAL_HEADLESS", "1", 1);
+        #endif
+    }
+
+    const double frameMs = 1000.0 / 60.0;
+    int measureFrames = opts.framesSet ? opts.frames : 300;
+
+    mystral::RuntimeConfig config;
+    config.width = opts.width;
+    config.height = opts.height;
+    config.title = opts.title.c_str();
+    config.noSdl = opts.noSdl;
+    config.debug = opts.debug;
+    config.maxFps = 0;
+    config.virtualTime = true;
+    config.fixedDtMs = frameMs;
+    config.frameStatsWindow = static_cast<size_t>(std::max(measureFrames, 1));
+
+    if (!opts.tracePath.empty()) {
+        mystral::debug::trace::setThreadName("Main");
+        mystral::debug::trace::start();
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    auto runtime = mystral::Runtime::create(config);
+    if (!runtime) {
+        std::cerr << "Error: Failed to create runtime!" << std::endl;
+        return 1;
+    }
+    if (!runtime->loadScript(opts.scriptPath)) {
+        std::cerr << "Error: Failed to evaluate script!" << std::endl;
+        return 1;
+    }
+    double startupMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+    for (int frame = 0; frame < opts.warmupFrames; frame++) {
+        if (!runtime->pollEvents()) {
+            std::cerr << "Error: Runtime quit during warmup at frame " << frame << std::endl;
+            return 1;
+        }
+    }
+
+    runtime->resetStats();
+    for (int frame = 0; frame < measureFrames; frame++) {
+        if (!runtime->pollEvents()) {
+            std::cerr << "Warning: Runtime quit early at frame " << frame << std::endl;
+            break;
+        }
+    }
+
+    auto stats = runtime->getStats(frameMs);
+    double frames = static_cast<double>(std::max<size_t>(stats.frames, 1));
+
+    BenchResult result;
+    result["gpu_init_ms"] = stats.gpuInitMs;
+    result["js_init_ms"] = stats.jsInitMs;
+    result["script_load_ms"] = stats.scriptLoadMs;
+    result["startup_ms"] = startupMs;
+    result["frames_rendered"] = static_cast<double>(stats.frames);
+    result["frame_mean_ms"] = stats.frameMeanMs;
+    result["frame_p50_ms"] = stats.frameP50Ms;
+    result["frame_p95_ms"] = stats.frameP95Ms;
+    result["frame_p99_ms"] = stats.frameP99Ms;
+    result["frame_max_ms"] = stats.frameMaxMs;
+    result["long_frames"] = static_cast<double>(stats.longFrames);
+    result["js_heap_bytes"] = static_cast<double>(stats.jsHeapBytes);
+    result["native_bytes"] = static_cast<double>(stats.nativeBytes);
+    result["gpu_bytes"] = static_cast<double>(stats.gpuBytes);
+    result["draw_calls_per_frame"] = stats.drawCalls / frames;
+    result["dispatches_per_frame"] = stats.dispatches / frames;
+    result["submits_per_frame"] = stats.submits / frames;
+
+    std::ofstream out(opts.benchChildOut);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot write " << opts.benchChildOut << std::endl;
+        return 1;
+    }
+    out << std::fixed << std::setprecision(3) << "{\n";
+    writeBenchResult(out, result, "  ");
+    out << "}\n";
+    out.close();
+
+    // Same shutdown as screenshot mode: the results are written, skip teardown
+    finishTrace(opts);
+    std::cout.flush();
+    std::cerr.flush();
+    _exit(out.good() ? 0 : 1);
+}
+
+/**
+ * mystral bench: run the script --runs times in fresh processes, report
+ * medians as JSON and optionally compare them against a baseline report
+ */
+static int runBenchmark(const CLIOptions& opts) {
+    namespace fs = std::filesystem;
+
+    int measureFrames = opts.framesSet ? opts.frames : 300;
+    if (opts.benchRuns < 1 || measureFrames < 1 || opts.warmupFrames < 0) {
+        std::cerr << "Error: --runs and --frames must be at least 1" << std::endl;
+        return 1;
+    }
+
+    std::string baselineJson;
+    if (!opts.baselinePath.empty()) {
+        try {
+            baselineJson = readFile(opts.baselinePath);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    if (!opts.quiet) {
+        std::cerr << "=== Mystral Bench ===" << std::endl;
+        std::cerr << "Script: " << opts.scriptPath << std::endl;
+        std::cerr << "Engine: " << mystral::getJSEngine() << " + " << mystral::getWebGPUBackend() << std::endl;
+        std::cerr << "Runs: " << opts.benchRuns << " x (" << opts.warmupFrames << " warmup + "
+                  << measureFrames << " frames), " << opts.width << "x" << opts.height
+                  << (opts.noSdl ? ", no-SDL" : ", headless") << std::endl;
+    }
+
+#ifdef _WIN32
+    int pid = _getpid();
+#else
+    int pid = static_cast<int>(getpid());
+#endif
+
+    std::vector<BenchResult> runs;
+    for (int run = 0; run < opts.benchRuns; run++) {
+        std::string resultPath = (fs::temp_directory_path() /
+            ("mystral-bench-" + std::to_string(pid) + "-" + std::to_string(run) + ".json")).string();
+
+        std::string command = quoteArg(opts.selfPath) + " bench " + quoteArg(opts.scriptPath) +
+            " --bench-child " + quoteArg(resultPath) +
+            " --warmup " + std::to_string(opts.warmupFrames) +
+            " --frames " + std::to_string(measureFrames) +
+            " --width " + std::to_string(opts.width) +
+            " --height " + std::to_string(opts.height);
+        if (opts.noSdl) {
+            command += " --no-sdl";
+        }
+        if (opts.debug) {
+            command += " --debug";
+        }
+        if (!opts.tracePath.empty()) {
+            command += " --trace " + quoteArg(opts.tracePath + ".run" + std::to_string(run));
+        }
+        // Runtime logging goes to stdout; keep it out of the report
+        if (!opts.debug) {
+#ifdef _WIN32
+            command += " >nul";
+#else
+            command += " >/dev/null";
+#endif
+        }
+#ifdef _WIN32
+        command = "\"" + command + "\"";  // cmd.exe strips the outer quotes
+#endif
+
+        int status = std::system(command.c_str());
+        std::string resultJson;
+        try {
+            resultJson = readFile(resultPath);
+        } catch (const std::exception&) {
+            std::cerr << "Error: Bench run " << (run + 1) << " failed (exit status " << status << ")" << std::endl;
+            return 1;
+        }
+        std::error_code ec;
+        fs::remove(resultPath, ec);
+
+        BenchResult result;
+        for (const auto& metric : kBenchMetrics) {
+            result[metric.key] = extractJsonNumber(resultJson, metric.key, 0);
+        }
+        runs.push_back(result);
+
+        if (!opts.quiet) {
+            std::cerr << std::fixed << std::setprecision(2)
+                      << "Run " << (run + 1) << "/" << opts.benchRuns
+                      << ": p50 " << result["frame_p50_ms"] << "ms, p99 " << result["frame_p99_ms"]
+                      << "ms, startup " << result["startup_ms"] << "ms" << std::endl;
+        }
+    }
+
+    // Medians across runs
+    BenchResult summary;
+    for (const auto& metric : kBenchMetrics) {
+        std::vector<double> values;
+        for (const auto& result : runs) {
+            values.push_back(result.at(metric.key));
+        }
+        std::sort(values.begin(), values.end());
+        size_t mid = values.size() / 2;
+        summary[metric.key] = values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2;
+    }
+
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(3);
+    report << "{\n  \"summary\": {\n";
+    writeBenchResult(report, summary, "    ");
+    report << "  },\n";
+    report << "  \"config\": {\n"
+           << "    \"script\": \"";
+    mystral::debug::trace::writeEscaped(report, fs::path(opts.scriptPath).generic_string().c_str());
+    report << "\",\n"
+           << "    \"version\": \"" << mystral::getVersion() << "\",\n"
+           << "    \"jsEngine\": \"" << mystral::getJSEngine() << "\",\n"
+           << "    \"webgpuBackend\": \"" << mystral::getWebGPUBackend() << "\",\n"
+           << "    \"mode\": \"" << (opts.noSdl ? "no-sdl" : "headless") << "\",\n"
+           << "    \"width\": " << opts.width << ",\n"
+           << "    \"height\": " << opts.height << ",\n"
+           << "    \"fixedDtMs\": " << 1000.0 / 60.0 << ",\n"
+           << "    \"warmup\": " << opts.warmupFrames << ",\n"
+           << "    \"frames\": " << measureFrames << ",\n"
+           << "    \"runs\": " << opts.benchRuns << "\n"
+           << "  },\n";
+    report << "  \"runs\": [\n";
+    for (size_t i = 0; i < runs.size(); i++) {
+        report << "    {\n";
+        writeBenchResult(report, runs[i], "      ");
+        report << "    }" << (i + 1 < runs.size() ? "," : "") << "\n";
+    }
+    report << "  ]\n}\n";
+
+    if (opts.outputPath.empty()) {
+        std::cout << report.str();
+    } else {
+        std::ofstream out(opts.outputPath);
+        if (!out.is_open() || !(out << report.str())) {
+            std::cerr << "Error: Cannot write " << opts.outputPath << std::endl;
+            return 1;
+        }
+        if (!opts.quiet) {
+            std::cerr << "Report: " << opts.outputPath << std::endl;
+        }
+    }
+
+    if (baselineJson.empty()) {
+        return 0;
+    }
+
+    // Compare medians against the baseline's summary
+    int regressions = 0;
+    std::cerr << std::endl << "Baseline: " << opts.baselinePath << " (threshold " << opts.thresholdPct << "%)" << std::endl;
+    for (const auto& metric : kBenchMetrics) {
+        if (!metric.gated) continue;
+        double base = extractJsonNumber(baselineJson, metric.key, -1);
+        if (base < 0) continue;  // Not in the baseline
+        double current = summary[metric.key];
+        // A zero baseline (long_frames, dispatches) has no relative change:
+        // anything above zero is a regression
+        double changePct = base > 0 ? (current - base) / base * 100.0 : 0.0;
+        bool regressed = base > 0 ? changePct > opts.thresholdPct : current > 0;
+        if (regressed) {
+            regressions++;
+        }
+        std::cerr << std::fixed << std::setprecision(3)
+                  << (regressed ? "  REGRESSION " : "  ok         ") << std::left << std::setw(22) << metric.key
+                  << std::right << base << " -> " << current << std::setprecision(1);
+        if (base > 0) {
+            std::cerr << " (" << (changePct >= 0 ? "+" : "") << changePct << "%)" << std::endl;
+        } else {
+            std::cerr << (current > 0 ? " (was zero)" : "") << std::endl;
+        }
+    }
+    if (regressions > 0) {
+        std::cerr << regressions << " metric(s) regressed beyond " << opts.thresholdPct << "%" << std::endl;
+        return 1;
+    }
+    std::cerr << "No regressions" << std::endl;
+    return 0;
+}
+
 /**
  * Bake lightmaps for a scene.
  * Generates a JavaScript wrapper that invokes the TypeScript lightmap baker.
@@ -2111,6 +2596,7 @@ int main(int argc, char* argv[]) {
 #endif
 
     CLIOptions opts = parseArgs(argc, argv);
+    opts.selfPath = argv[0];
     std::string embeddedEntry = mystral::vfs::getEmbeddedEntryPath();
 
     // Handle --version
@@ -2152,6 +2638,19 @@ int main(int argc, char* argv[]) {
         return bakeLightmaps(opts);
     }
 
+    // Handle 'bench' command
+    if (opts.command == "bench") {
+        if (opts.scriptPath.empty()) {
+            std::cerr << "Error: No script file specified for bench." << std::endl;
+            std::cerr << "Usage: mystral bench <script.js> [--runs n] [--baseline base.json]" << std::endl;
+            return 1;
+        }
+        if (!opts.benchChildOut.empty()) {
+            return runBenchmarkOnce(opts);
+        }
+        return runBenchmark(opts);
+    }
+
     // Handle 'run' command
     if (opts.command == "run") {
         if (opts.scriptPath.empty()) {
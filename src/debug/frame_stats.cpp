@@ -0,0 +1,142 @@
+/**
+ * FrameStats Implementation
+ */
+
+#include "mystral/debug/frame_stats.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#if defined(_WIN32)
+#ifndef PSAPI_VERSION
+#define PSAPI_VERSION 2  // K32GetProcessMemoryInfo lives in kernel32, no psapi link
+#endif
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace mystral {
+namespace debug {
+
+const char* FrameStats::phaseName(Phase phase) {
+    // Also the trace span names
+    switch (phase) {
+        case SdlPoll: return "sdl.poll";
+        case EventLoop: return "eventLoop.runOnce";
+        case HttpCompletions: return "http.completions";
+        case FsCompletions: return "fs.completions";
+        case FileWatcher: return "fileWatcher";
+        case Timers: return "timers";
+        case FileCallbacks: return "fileCallbacks";
+        case JobCompletions: return "jobs.completions";
+        case WorkerMessages: return "worker.messages";
+        case Microtasks: return "microtasks";
+        case AnimationFrame: return "rAF";
+        case ClearFrameHandles: return "clearFrameHandles";
+        default: return "unknown";
+    }
+}
+
+FrameStats::FrameStats(size_t window)
+    : ring_(window > 0 ? window : 1) {}
+
+void FrameStats::endIteration(uint64_t workNs, bool rendered) {
+    pending_.workNs += workNs;
+    if (!rendered) {
+        return;
+    }
+    ring_[next_] = pending_;
+    next_ = (next_ + 1) % ring_.size();
+    count_ = std::min(count_ + 1, ring_.size());
+    pending_ = Record();
+}
+
+// Nearest-rank percentiles over one sample per frame
+static FrameStats::Distribution distribution(std::vector<double>& samples) {
+    FrameStats::Distribution d;
+    if (samples.empty()) {
+        return d;
+    }
+    std::sort(samples.begin(), samples.end());
+    double sum = 0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+    auto percentile = [&samples](double p) {
+        size_t rank = static_cast<size_t>(std::ceil(p * samples.size()));
+        return samples[std::min(samples.size(), std::max<size_t>(rank, 1)) - 1];
+    };
+    d.mean = sum / samples.size();
+    d.p50 = percentile(0.50);
+    d.p95 = percentile(0.95);
+    d.p99 = percentile(0.99);
+    d.max = samples.back();
+    return d;
+}
+
+FrameStats::Summary FrameStats::summarize(double longFrameMs) const {
+    Summary summary;
+    summary.frames = count_;
+
+    std::vector<double> samples;
+    samples.reserve(count_);
+    for (size_t i = 0; i < count_; i++) {
+        double ms = ring_[i].workNs / 1e6;
+        if (ms > longFrameMs) {
+            summary.longFrames++;
+        }
+        samples.push_back(ms);
+    }
+    summary.frameMs = distribution(samples);
+
+    for (int phase = 0; phase < PhaseCount; phase++) {
+        samples.clear();
+        for (size_t i = 0; i < count_; i++) {
+            samples.push_back(ring_[i].phaseNs[phase] / 1e6);
+        }
+        summary.phaseMs[phase] = distribution(samples);
+    }
+    return summary;
+}
+
+void FrameStats::reset() {
+    next_ = 0;
+    count_ = 0;
+    pending_ = Record();
+}
+
+uint64_t processResidentBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.WorkingSetSize;
+    }
+    return 0;
+#elif defined(__APPLE__)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS) {
+        return info.resident_size;
+    }
+    return 0;
+#elif defined(__linux__)
+    // Second field of statm is resident pages (Android too)
+    FILE* file = std::fopen("/proc/self/statm", "r");
+    if (!file) {
+        return 0;
+    }
+    unsigned long long size = 0, resident = 0;
+    int fields = std::fscanf(file, "%llu %llu", &size, &resident);
+    std::fclose(file);
+    return fields == 2 ? resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE)) : 0;
+#else
+    return 0;
+#endif
+}
+
+}  // namespace debug
+}  // namespace mystral
@@ -0,0 +1,104 @@
+/**
+ * PerformanceTimeline Implementation
+ */
+
+#include "mystral/debug/performance_timeline.h"
+#include "mystral/debug/trace.h"
+
+namespace mystral {
+namespace debug {
+
+// Map a performance.now() time to the trace timeline, relative to the present
+static uint64_t toTraceNs(double timeMs, double nowMs) {
+    double backNs = (nowMs - timeMs) * 1e6;
+    uint64_t now = trace::nowNs();
+    if (backNs <= 0) {
+        return now;
+    }
+    return backNs < static_cast<double>(now) ? now - static_cast<uint64_t>(backNs) : 0;
+}
+
+PerformanceTimeline::PerformanceTimeline(size_t capacity)
+    : ring_(capacity > 0 ? capacity : 1) {}
+
+PerformanceTimeline::Entry& PerformanceTimeline::push() {
+    if (count_ < ring_.size()) {
+        return ring_[(first_ + count_++) % ring_.size()];
+    }
+    // Full: the oldest entry makes room
+    Entry& entry = ring_[first_];
+    first_ = (first_ + 1) % ring_.size();
+    return entry;
+}
+
+const PerformanceTimeline::Entry& PerformanceTimeline::mark(const std::string& name, double startTime, double nowMs) {
+    Entry& entry = push();
+    entry.name = name;
+    entry.type = EntryType::Mark;
+    entry.startTime = startTime;
+    entry.duration = 0;
+    entry.traceNs = toTraceNs(startTime, nowMs);
+
+    if (trace::isEnabled()) {
+        trace::recordInstant(trace::intern(name), "user", entry.traceNs);
+    }
+    return entry;
+}
+
+const PerformanceTimeline::Entry& PerformanceTimeline::measure(const std::string& name, double startTime,
+                                                               double endTime, double nowMs) {
+    Entry& entry = push();
+    entry.name = name;
+    entry.type = EntryType::Measure;
+    entry.startTime = startTime;
+    entry.duration = endTime - startTime;
+    entry.traceNs = toTraceNs(startTime, nowMs);
+
+    if (trace::isEnabled() && entry.duration >= 0) {
+        trace::recordComplete(trace::intern(name), "user", entry.traceNs,
+                              static_cast<uint64_t>(entry.duration * 1e6));
+    }
+    return entry;
+}
+
+bool PerformanceTimeline::findMark(const std::string& name, double& startTime) const {
+    for (size_t i = count_; i-- > 0;) {
+        const Entry& entry = ring_[(first_ + i) % ring_.size()];
+        if (entry.type == EntryType::Mark && entry.name == name) {
+            startTime = entry.startTime;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<PerformanceTimeline::Entry> PerformanceTimeline::entries(const std::string& name,
+                                                                     const EntryType* type) const {
+    std::vector<Entry> result;
+    for (size_t i = 0; i < count_; i++) {
+        const Entry& entry = ring_[(first_ + i) % ring_.size()];
+        if ((name.empty() || entry.name == name) && (!type || entry.type == *type)) {
+            result.push_back(entry);
+        }
+    }
+    return result;
+}
+
+void PerformanceTimeline::clear(EntryType type, const std::string& name) {
+    // Compact the survivors to the front of the ring, keeping their order
+    size_t kept = 0;
+    for (size_t i = 0; i < count_; i++) {
+        Entry& entry = ring_[(first_ + i) % ring_.size()];
+        if (entry.type == type && (name.empty() || entry.name == name)) {
+            continue;
+        }
+        Entry& slot = ring_[(first_ + kept++) % ring_.size()];
+        if (&slot != &entry) {
+            slot = std::move(entry);
+        }
+    }
+    count_ = kept;
+}
+
+}  // namespace debug
+}  // namespace mystral
@@ -0,0 +1,230 @@
+/**
+ * Trace Implementation
+ *
+ * Each recording thread owns a ThreadBuffer: a power-of-two ring of events
+ * written only by that thread and published with a release store of head.
+ * Buffers are registered once per thread per trace and kept alive by the
+ * registry, so events from workers that have already exited still end up in
+ * the file.
+ *
+ * stopAndWrite() disables recording, then waits for each ring's in-flight
+ * write to finish before reading it. A writer raises its ring's `writing`
+ * flag and only then re-checks g_enabled (both sequentially consistent), so
+ * it either sees the disable and backs out, or the reader sees the flag.
+ */
+
+#include "mystral/debug/trace.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace mystral {
+namespace debug {
+namespace trace {
+
+namespace detail {
+std::atomic<bool> g_enabled{false};
+}
+
+namespace {
+
+struct Event {
+    const char* name;
+    const char* category;
+    uint64_t startNs;
+    uint64_t durationNs;
+    char phase;  // 'X' complete, 'i' instant
+};
+
+struct ThreadBuffer {
+    std::vector<Event> events;  // Power-of-two size
+    std::atomic<uint64_t> head{0};
+    std::atomic<bool> writing{false};  // An event is being written (see stopAndWrite)
+    uint32_t tid = 0;
+    std::string name;  // Guarded by g_mutex
+};
+
+std::mutex g_mutex;
+std::vector<std::shared_ptr<ThreadBuffer>> g_buffers;
+size_t g_capacity = 1 << 16;
+uint64_t g_originNs = 0;
+std::atomic<uint32_t> g_generation{0};  // Bumped by start(); stale thread buffers re-register
+std::atomic<uint32_t> g_nextTid{1};
+
+thread_local std::shared_ptr<ThreadBuffer> t_buffer;
+thread_local uint32_t t_generation = 0;
+thread_local uint32_t t_tid = 0;
+thread_local std::string t_name;
+
+uint32_t threadId() {
+    if (t_tid == 0) {
+        t_tid = g_nextTid.fetch_add(1, std::memory_order_relaxed);
+    }
+    return t_tid;
+}
+
+ThreadBuffer* threadBuffer() {
+    uint32_t generation = g_generation.load(std::memory_order_acquire);
+    if (!t_buffer || t_generation != generation) {
+        auto buffer = std::make_shared<ThreadBuffer>();
+        buffer->tid = threadId();
+        std::lock_guard<std::mutex> lock(g_mutex);
+        buffer->events.resize(g_capacity);
+        buffer->name = t_name.empty() ? "Thread " + std::to_string(buffer->tid) : t_name;
+        g_buffers.push_back(buffer);
+        t_buffer = std::move(buffer);
+        t_generation = generation;
+    }
+    return t_buffer.get();
+}
+
+void record(const Event& event) {
+    if (!isEnabled()) {
+        return;
+    }
+    ThreadBuffer* buffer = threadBuffer();
+    buffer->writing.store(true, std::memory_order_seq_cst);
+    if (detail::g_enabled.load(std::memory_order_seq_cst)) {
+        uint64_t head = buffer->head.load(std::memory_order_relaxed);
+        buffer->events[head & (buffer->events.size() - 1)] = event;
+        buffer->head.store(head + 1, std::memory_order_release);
+    }
+    buffer->writing.store(false, std::memory_order_release);
+}
+
+}  // namespace
+
+void writeEscaped(std::ostream& out, const char* text) {
+    for (const char* p = text; *p; p++) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if (c == '"' || c == '\\') {
+            out << '\\' << *p;
+        } else if (c < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out << escaped;
+        } else {
+            out << *p;
+        }
+    }
+}
+
+uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void start(size_t eventsPerThread) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    size_t capacity = 1024;
+    while (capacity < eventsPerThread) {
+        capacity <<= 1;
+    }
+    g_capacity = capacity;
+    g_buffers.clear();
+    g_originNs = nowNs();
+    g_generation.fetch_add(1, std::memory_order_release);
+    detail::g_enabled.store(true, std::memory_order_release);
+}
+
+void setThreadName(const std::string& name) {
+    t_name = name;
+    threadId();  // Named threads get their track id (and sort position) early
+    if (t_buffer && t_generation == g_generation.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        t_buffer->name = name;
+    }
+}
+
+const char* intern(const std::string& name) {
+    static std::mutex mutex;
+    static std::unordered_set<std::string> names;
+    std::lock_guard<std::mutex> lock(mutex);
+    return names.insert(name).first->c_str();
+}
+
+void recordComplete(const char* name, const char* category, uint64_t startNs, uint64_t durationNs) {
+    record({name, category, startNs, durationNs, 'X'});
+}
+
+void recordInstant(const char* name, const char* category, uint64_t timeNs) {
+    record({name, category, timeNs, 0, 'i'});
+}
+
+bool stopAndWrite(const std::string& path) {
+    detail::g_enabled.store(false, std::memory_order_seq_cst);
+
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    uint64_t origin;
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        buffers = g_buffers;
+        origin = g_originNs;
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) {
+        std::cerr << "[Trace] Cannot write " << path << std::endl;
+        return false;
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"mystral\"}}";
+
+    size_t written = 0;
+    char number[64];
+    for (auto& buffer : buffers) {
+        {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+                << ",\"args\":{\"name\":\"";
+            writeEscaped(out, buffer->name.c_str());
+            out << "\"}}";
+        }
+        out << ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+            << ",\"args\":{\"sort_index\":" << buffer->tid << "}}";
+
+        // A writer that got past the enabled check may still be filling a slot
+        while (buffer->writing.load(std::memory_order_seq_cst)) {
+            std::this_thread::yield();
+        }
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t size = buffer->events.size();
+        uint64_t first = head > size ? head - size : 0;
+        for (uint64_t i = first; i < head; i++) {
+            const Event& event = buffer->events[i & (size - 1)];
+            if (event.startNs < origin) {
+                continue;
+            }
+            out << ",\n{\"name\":\"";
+            writeEscaped(out, event.name);
+            out << "\",\"cat\":\"";
+            writeEscaped(out, event.category);
+            std::snprintf(number, sizeof(number), "%.3f", (event.startNs - origin) / 1000.0);
+            out << "\",\"ph\":\"" << event.phase << "\",\"ts\":" << number;
+            if (event.phase == 'X') {
+                std::snprintf(number, sizeof(number), "%.3f", event.durationNs / 1000.0);
+                out << ",\"dur\":" << number;
+            } else {
+                out << ",\"s\":\"t\"";
+            }
+            out << ",\"pid\":1,\"tid\":" << buffer->tid << "}";
+            written++;
+        }
+    }
+    out << "\n]}\n";
+
+    std::cout << "[Trace] Wrote " << written << " events from " << buffers.size()
+              << " threads to " << path << std::endl;
+    return out.good();
+}
+
+}  // namespace trace
+}  // namespace debug
+}  // namespace mystral
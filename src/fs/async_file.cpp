@@ -5,7 +5,8 @@
  * keeping the main thread free for rendering.
  *
  * IMPORTANT: Callbacks are queued and processed separately via processCompletedReads()
- * to ensure they run safely on the main thread, not from within libuv callbacks.
+ * to ensure they run safely on the owning thread, not from within libuv callbacks.
+ * Each thread (main or worker) has its own reader on top of its own EventLoop.
  */
 
 #include "mystral/fs/async_file.h"
@@ -31,34 +32,33 @@ struct CompletedRead {
 };
 
 /**
- * Global queue for completed reads (accessed from both libuv thread pool and main thread)
+ * Internal implementation
  */
-static std::queue<CompletedRead> g_completedQueue;
-static std::mutex g_queueMutex;
+struct AsyncFileReader::Impl {
+    bool initialized = false;
 
-static void queueCompleted(AsyncFileCallback callback, std::vector<uint8_t> data, std::string error) {
-    std::lock_guard<std::mutex> lock(g_queueMutex);
-    g_completedQueue.push({std::move(callback), std::move(data), std::move(error)});
-}
+    // Completed reads waiting for the owning thread (filled from the loop's after-work callbacks)
+    std::queue<CompletedRead> completedQueue;
+    std::mutex queueMutex;
+
+    void queueCompleted(AsyncFileCallback callback, std::vector<uint8_t> data, std::string error) {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        completedQueue.push({std::move(callback), std::move(data), std::move(error)});
+    }
+};
 
 /**
  * Context for a single file read operation
  */
 struct ReadContext {
     uv_work_t work;
+    AsyncFileReader::Impl* owner;
     std::string path;
     AsyncFileCallback callback;
     std::vector<uint8_t> data;
     std::string error;
 };
 
-/**
- * Internal implementation
- */
-struct AsyncFileReader::Impl {
-    bool initialized = false;
-};
-
 /**
  * Worker function - runs on thread pool
  */
@@ -84,7 +84,7 @@ static void readFileWorker(uv_work_t* req) {
 }
 
 /**
- * After work callback - runs on main thread (libuv event loop)
+ * After work callback - runs on the owning thread (libuv event loop)
  * DON'T invoke JS callbacks here - queue them for safe processing
  */
 static void readFileAfterWork(uv_work_t* req, int status) {
@@ -95,8 +95,8 @@ static void readFileAfterWork(uv_work_t* req, int status) {
         ctx->data.clear();
     }
 
-    // Queue the result for callback invocation on main thread
-    queueCompleted(
+    // Queue the result for callback invocation on the owning thread
+    ctx->owner->queueCompleted(
         std::move(ctx->callback),
         std::move(ctx->data),
         std::move(ctx->error)
@@ -110,7 +110,7 @@ static void readFileAfterWork(uv_work_t* req, int status) {
 // ============================================================================
 
 AsyncFileReader& AsyncFileReader::instance() {
-    static AsyncFileReader instance;
+    thread_local AsyncFileReader instance;
     return instance;
 }
 
@@ -165,6 +165,7 @@ void AsyncFileReader::readFile(const std::string& path, AsyncFileCallback callba
     // Create context for this read operation
     auto* ctx = new ReadContext();
     ctx->work.data = ctx;
+    ctx->owner = impl_.get();
     ctx->path = path;
     ctx->callback = std::move(callback);
 
@@ -183,8 +184,8 @@ bool AsyncFileReader::processCompletedReads() {
     // Move completed items out of the queue while holding the lock
     std::queue<CompletedRead> toProcess;
     {
-        std::lock_guard<std::mutex> lock(g_queueMutex);
-        std::swap(toProcess, g_completedQueue);
+        std::lock_guard<std::mutex> lock(impl_->queueMutex);
+        std::swap(toProcess, impl_->completedQueue);
     }
 
     bool hadCallbacks = !toProcess.empty();
@@ -215,7 +216,7 @@ struct AsyncFileReader::Impl {
 };
 
 AsyncFileReader& AsyncFileReader::instance() {
-    static AsyncFileReader instance;
+    thread_local AsyncFileReader instance;
     return instance;
 }
 
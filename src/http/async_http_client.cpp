@@ -5,7 +5,8 @@
  * Socket events are monitored via uv_poll_t, timeouts via uv_timer_t.
  *
  * IMPORTANT: Callbacks are queued and processed separately via processCompletedRequests()
- * to ensure they run safely on the main thread, not from within libuv callbacks.
+ * to ensure they run safely on the owning thread, not from within libuv callbacks.
+ * Each thread (main or worker) has its own client driven by its own EventLoop.
  */
 
 #include "mystral/http/async_http_client.h"
@@ -72,6 +73,7 @@ struct SocketContext {
  */
 struct AsyncHttpClientImpl {
     CURLM* multiHandle = nullptr;
+    uv_loop_t* loop = nullptr;  // The owning thread's loop (set by init)
     uv_timer_t timeoutTimer;
     bool initialized = false;
     int activeRequests = 0;
@@ -243,7 +245,7 @@ static int socketCallback(CURL* easy, curl_socket_t s, int what, void* userp, vo
     auto* impl = static_cast<AsyncHttpClientImpl*>(userp);
     if (!impl) return 0;
 
-    uv_loop_t* loop = async::EventLoop::instance().handle();
+    uv_loop_t* loop = impl->loop;
     if (!loop) return 0;
 
     if (what == CURL_POLL_REMOVE) {
@@ -309,8 +311,13 @@ static int timerCallback(CURLM* multi, long timeout_ms, void* userp) {
 // AsyncHttpClient Implementation
 // ============================================================================
 
+static std::mutex& curlGlobalMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
 AsyncHttpClient& AsyncHttpClient::instance() {
-    static AsyncHttpClient instance;
+    thread_local AsyncHttpClient instance;
     return instance;
 }
 
@@ -329,8 +336,12 @@ void AsyncHttpClient::init() {
         return;
     }
 
-    // Initialize curl globally (thread-safe in modern curl)
-    curl_global_init(CURL_GLOBAL_DEFAULT);
+    // Initialize curl globally (reference counted; serialized because worker
+    // threads create their own clients and older curl isn't thread-safe here)
+    {
+        std::lock_guard<std::mutex> lock(curlGlobalMutex());
+        curl_global_init(CURL_GLOBAL_DEFAULT);
+    }
 
     // Create multi handle
     impl_->multiHandle = curl_multi_init();
@@ -348,6 +359,7 @@ void AsyncHttpClient::init() {
     curl_multi_setopt(impl_->multiHandle, CURLMOPT_TIMERDATA, impl_.get());
 
     // Initialize the timeout timer
+    impl_->loop = loop;
     uv_timer_init(loop, &impl_->timeoutTimer);
     impl_->timeoutTimer.data = impl_.get();
 
@@ -400,9 +412,13 @@ void AsyncHttpClient::shutdown() {
         impl_->multiHandle = nullptr;
     }
 
-    curl_global_cleanup();
+    {
+        std::lock_guard<std::mutex> lock(curlGlobalMutex());
+        curl_global_cleanup();
+    }
 
     impl_->initialized = false;
+    impl_->loop = nullptr;
     impl_->activeRequests = 0;
     std::cout << "[AsyncHttp] Shutdown complete" << std::endl;
 }
@@ -561,7 +577,7 @@ struct AsyncHttpClient::Impl {
 };
 
 AsyncHttpClient& AsyncHttpClient::instance() {
-    static AsyncHttpClient instance;
+    thread_local AsyncHttpClient instance;
     return instance;
 }
 
@@ -0,0 +1,120 @@
+/**
+ * Job System JavaScript Bindings
+ *
+ * mystral.jobs.parallelFor(count, kernelName, sharedBuffers, params) runs a
+ * native kernel across the job pool and returns when every chunk is done.
+ * The call is synchronous, so the buffers (ArrayBuffer, SharedArrayBuffer or
+ * typed arrays) are used in place: nothing is copied and the JS thread can't
+ * touch them while the kernel runs.
+ */
+
+#include "mystral/jobs/job_bindings.h"
+#include "mystral/jobs/job_system.h"
+#include "mystral/js/engine.h"
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+namespace mystral {
+namespace jobs {
+
+void initializeJobBindings(js::Engine* engine) {
+    if (!engine) return;
+
+    auto& jobs = JobSystem::instance();
+
+    // __jobsParallelFor(count, kernelName, buffers[], params[]) -> error string or undefined
+    engine->setGlobalProperty("__jobsParallelFor",
+        engine->newFunction("__jobsParallelFor", [engine, &jobs](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (args.size() < 4) {
+                return engine->newString("parallelFor(count, kernelName, sharedBuffers, params) requires 4 arguments");
+            }
+
+            // Past 2^53 a number no longer holds every integer; also keeps the size_t cast defined
+            double countValue = engine->toNumber(args[0]);
+            if (!std::isfinite(countValue) || countValue < 0 || countValue > 9007199254740992.0 ||
+                countValue > static_cast<double>(SIZE_MAX)) {
+                return engine->newString("parallelFor: count must be a non-negative number no larger than 2^53");
+            }
+            size_t count = static_cast<size_t>(countValue);
+            std::string name = engine->toString(args[1]);
+
+            KernelArgs kernelArgs;
+            auto buffers = args[2];
+            auto bufferCount = static_cast<uint32_t>(engine->toNumber(engine->getProperty(buffers, "length")));
+            for (uint32_t i = 0; i < bufferCount; i++) {
+                auto item = engine->getPropertyIndex(buffers, i);
+                KernelBuffer buffer;
+                buffer.data = engine->getArrayBufferData(item, &buffer.length);
+                // A null pointer is only acceptable for an empty buffer (kernels reject it anyway)
+                if (!buffer.data && !engine->isObject(item)) {
+                    return engine->newString(("parallelFor: sharedBuffers[" + std::to_string(i) +
+                                              "] is not an ArrayBuffer or typed array").c_str());
+                }
+                kernelArgs.buffers.push_back(buffer);
+            }
+
+            auto params = args[3];
+            auto paramCount = static_cast<uint32_t>(engine->toNumber(engine->getProperty(params, "length")));
+            for (uint32_t i = 0; i < paramCount; i++) {
+                kernelArgs.params.push_back(engine->toNumber(engine->getPropertyIndex(params, i)));
+            }
+
+            std::string error;
+            if (!jobs.runKernel(name, count, kernelArgs, error)) {
+                return engine->newString(error.c_str());
+            }
+            return engine->newUndefined();
+        })
+    );
+
+    // __jobsKernelNames() -> string[]
+    engine->setGlobalProperty("__jobsKernelNames",
+        engine->newFunction("__jobsKernelNames", [engine, &jobs](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            auto names = jobs.kernelNames();
+            auto result = engine->newArray(names.size());
+            for (size_t i = 0; i < names.size(); i++) {
+                engine->setPropertyIndex(result, static_cast<uint32_t>(i), engine->newString(names[i].c_str()));
+            }
+            return result;
+        })
+    );
+
+    engine->setGlobalProperty("__jobsThreadCount", engine->newNumber(static_cast<double>(jobs.threadCount())));
+
+    const char* jobsPolyfill = R"(
+(function() {
+    const mystral = globalThis.mystral || (globalThis.mystral = {});
+    const toArray = (value) => {
+        if (value === undefined || value === null) return [];
+        if (Array.isArray(value)) return value;
+        if (ArrayBuffer.isView(value) && !(value instanceof DataView)) return Array.from(value);
+        return [value];
+    };
+
+    mystral.jobs = {
+        // Pool threads (the calling thread also runs chunks)
+        threadCount: __jobsThreadCount,
+
+        // Names of the registered native kernels
+        get kernels() {
+            return __jobsKernelNames();
+        },
+
+        // Run a native kernel over [0, count) on the job pool; blocks until done
+        parallelFor(count, kernelName, sharedBuffers, params) {
+            const buffers = Array.isArray(sharedBuffers) ? sharedBuffers
+                : (sharedBuffers === undefined || sharedBuffers === null ? [] : [sharedBuffers]);
+            const error = __jobsParallelFor(Number(count), String(kernelName), buffers, toArray(params));
+            if (error) throw new Error(error);
+        },
+    };
+})();
+)";
+
+    engine->eval(jobsPolyfill, "jobs-polyfill.js");
+    std::cout << "[Jobs] mystral.jobs initialized (" << jobs.threadCount() << " threads)" << std::endl;
+}
+
+}  // namespace jobs
+}  // namespace mystral
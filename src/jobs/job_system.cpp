@@ -0,0 +1,283 @@
+/**
+ * JobSystem Implementation
+ *
+ * Work stealing with a mutex per deque: jobs here are coarse (a decode, a
+ * chunk of thousands of items), so a short uncontended lock per pop is
+ * noise next to the job itself and keeps the queues simple.
+ */
+
+#include "mystral/jobs/job_system.h"
+#include "mystral/debug/trace.h"
+#include <algorithm>
+#include <iostream>
+
+namespace mystral {
+namespace jobs {
+
+// Index of the pool thread we are running on (-1 on other threads)
+static thread_local int t_queueIndex = -1;
+
+JobSystem& JobSystem::instance() {
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::JobSystem() {
+    unsigned hw = std::thread::hardware_concurrency();
+    // Leave a core for the main thread; always have at least one pool thread
+    size_t count = hw > 1 ? hw - 1 : 1;
+
+    for (size_t i = 0; i < count; i++) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+
+    running_ = true;
+    for (size_t i = 0; i < count; i++) {
+        threads_.emplace_back([this, i]() { threadMain(i); });
+    }
+
+    registerBuiltinKernels(*this);
+
+    std::cout << "[Jobs] Started " << count << " pool threads" << std::endl;
+}
+
+JobSystem::~JobSystem() {
+    shutdown();
+}
+
+void JobSystem::shutdown() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    wakeup_.notify();
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    threads_.clear();
+
+    for (auto& queue : queues_) {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        for (auto& jobs : queue->jobs) jobs.clear();
+    }
+    queued_ = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(completionMutex_);
+        completions_.clear();
+    }
+    outstanding_ = 0;
+}
+
+void JobSystem::push(Job job, JobPriority priority, size_t queueIndex) {
+    {
+        WorkQueue& queue = *queues_[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs[static_cast<int>(priority)].push_back(std::move(job));
+    }
+    queued_.fetch_add(1, std::memory_order_seq_cst);
+    wakeup_.notify();
+}
+
+void JobSystem::submit(Job job, JobPriority priority) {
+    if (!running_.load() || threads_.empty()) {
+        job();  // Pool is gone (shutdown); don't lose the work
+        return;
+    }
+
+    // Jobs spawned from a pool thread stay local; others are spread round-robin
+    size_t index = t_queueIndex >= 0
+        ? static_cast<size_t>(t_queueIndex)
+        : nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    push(std::move(job), priority, index);
+}
+
+void JobSystem::submit(Job work, Job complete, JobPriority priority) {
+    outstanding_.fetch_add(1, std::memory_order_acq_rel);
+    submit([this, work = std::move(work), complete = std::move(complete)]() mutable {
+        work();
+        std::lock_guard<std::mutex> lock(completionMutex_);
+        completions_.push_back(std::move(complete));
+    }, priority);
+}
+
+size_t JobSystem::runCompletions() {
+    std::vector<Job> ready;
+    {
+        std::lock_guard<std::mutex> lock(completionMutex_);
+        if (completions_.empty()) return 0;
+        std::swap(ready, completions_);
+    }
+
+    for (auto& complete : ready) {
+        MYSTRAL_TRACE_SCOPE_CAT("job.completion", "jobs");
+        complete();
+        outstanding_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+    return ready.size();
+}
+
+bool JobSystem::findJob(size_t self, Job& out) {
+    for (int priority = 0; priority < kPriorityCount; priority++) {
+        // Own queue first, newest job (its data is most likely still in cache)
+        {
+            WorkQueue& queue = *queues_[self];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            auto& jobs = queue.jobs[priority];
+            if (!jobs.empty()) {
+                out = std::move(jobs.back());
+                jobs.pop_back();
+                queued_.fetch_sub(1, std::memory_order_seq_cst);
+                return true;
+            }
+        }
+
+        // Steal the oldest job at this priority from another thread
+        for (size_t offset = 1; offset < queues_.size(); offset++) {
+            WorkQueue& victim = *queues_[(self + offset) % queues_.size()];
+            std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+            if (!lock.owns_lock()) continue;
+            auto& jobs = victim.jobs[priority];
+            if (!jobs.empty()) {
+                out = std::move(jobs.front());
+                jobs.pop_front();
+                queued_.fetch_sub(1, std::memory_order_seq_cst);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void JobSystem::threadMain(size_t index) {
+    t_queueIndex = static_cast<int>(index);
+    debug::trace::setThreadName("Job " + std::to_string(index));
+
+    while (running_.load()) {
+        Job job;
+        if (findJob(index, job)) {
+            MYSTRAL_TRACE_SCOPE_CAT("job", "jobs");
+            job();
+            continue;
+        }
+
+        // Nothing found (or a steal lost a try_lock race): sleep only if the
+        // deques are really empty, re-checked after reading the epoch
+        uint32_t epoch = wakeup_.epoch();
+        if (queued_.load(std::memory_order_seq_cst) == 0 && running_.load()) {
+            wakeup_.wait(epoch);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+size_t JobSystem::parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+    if (count == 0) return grain;
+
+    size_t threads = threads_.size() + 1;  // Pool plus the calling thread
+    if (grain == 0) {
+        // ~4 chunks per thread evens out uneven chunk costs
+        grain = std::max<size_t>(1, (count + threads * 4 - 1) / (threads * 4));
+    }
+    size_t chunks = (count + grain - 1) / grain;
+
+    if (chunks == 1 || !running_.load() || threads_.empty()) {
+        fn(0, count);
+        return grain;
+    }
+
+    // Chunks are claimed from a shared counter, so a helper that starts late
+    // just finds nothing left. State is shared because helpers may outlive us.
+    struct State {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        size_t count;
+        size_t grain;
+        size_t chunks;
+        const std::function<void(size_t, size_t)>* fn;
+
+        void runChunks() {
+            for (;;) {
+                size_t chunk = next.fetch_add(1, std::memory_order_relaxed);
+                if (chunk >= chunks) return;
+                size_t begin = chunk * grain;
+                (*fn)(begin, std::min(begin + grain, count));
+                done.fetch_add(1, std::memory_order_release);
+            }
+        }
+    };
+
+    auto state = std::make_shared<State>();
+    state->count = count;
+    state->grain = grain;
+    state->chunks = chunks;
+    state->fn = &fn;
+
+    size_t helpers = std::min(threads_.size(), chunks - 1);
+    for (size_t i = 0; i < helpers; i++) {
+        submit([state]() { state->runChunks(); }, JobPriority::High);
+    }
+
+    state->runChunks();
+
+    // Remaining chunks are already running on other threads
+    while (state->done.load(std::memory_order_acquire) < chunks) {
+        std::this_thread::yield();
+    }
+    return grain;
+}
+
+void JobSystem::registerKernel(const std::string& name, Kernel kernel) {
+    std::lock_guard<std::mutex> lock(kernelMutex_);
+    kernels_[name] = std::move(kernel);
+}
+
+std::vector<std::string> JobSystem::kernelNames() const {
+    std::lock_guard<std::mutex> lock(kernelMutex_);
+    std::vector<std::string> names;
+    names.reserve(kernels_.size());
+    for (const auto& [name, kernel] : kernels_) {
+        names.push_back(name);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+bool JobSystem::runKernel(const std::string& name, size_t count, const KernelArgs& args, std::string& error) {
+    Kernel kernel;
+    {
+        std::lock_guard<std::mutex> lock(kernelMutex_);
+        auto it = kernels_.find(name);
+        if (it == kernels_.end()) {
+            error = "Unknown kernel '" + name + "'";
+            return false;
+        }
+        kernel = it->second;
+    }
+
+    KernelArgs call = args;
+    call.count = count;
+
+    if (kernel.validate) {
+        error = kernel.validate(call, count);
+        if (!error.empty()) {
+            error = name + ": " + error;
+            return false;
+        }
+    }
+
+    size_t grain = parallelFor(count, kernel.grain, [&](size_t begin, size_t end) {
+        kernel.run(call, begin, end);
+    });
+
+    if (kernel.finish && count > 0) {
+        kernel.finish(call, count, grain);
+    }
+    return true;
+}
+
+}  // namespace jobs
+}  // namespace mystral
@@ -0,0 +1,218 @@
+/**
+ * Built-in parallelFor kernels
+ *
+ * Kernels work on raw typed-array bytes. Matrices are column-major mat4
+ * (WebGPU / gl-matrix layout). Every kernel validates buffer sizes up front
+ * so a chunk can never read or write out of bounds.
+ */
+
+#include "mystral/jobs/job_system.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace mystral {
+namespace jobs {
+
+namespace {
+
+// Run before computing count * bytesPerItem, which must not wrap
+std::string checkCount(size_t count, size_t bytesPerItem) {
+    if (count > std::numeric_limits<size_t>::max() / bytesPerItem) {
+        return "count " + std::to_string(count) + " is too large";
+    }
+    return "";
+}
+
+std::string checkBuffers(const KernelArgs& args, std::initializer_list<size_t> minBytes) {
+    if (args.buffers.size() < minBytes.size()) {
+        return "expected " + std::to_string(minBytes.size()) + " buffers, got " + std::to_string(args.buffers.size());
+    }
+    size_t i = 0;
+    for (size_t bytes : minBytes) {
+        const KernelBuffer& buffer = args.buffers[i];
+        if (!buffer.data || buffer.length < bytes) {
+            return "buffer " + std::to_string(i) + " needs at least " + std::to_string(bytes) +
+                   " bytes, got " + std::to_string(buffer.length);
+        }
+        i++;
+    }
+    return "";
+}
+
+float* floats(const KernelArgs& args, size_t index) {
+    return static_cast<float*>(args.buffers[index].data);
+}
+
+// out = a * b (column-major 4x4)
+void mat4Mul(float* out, const float* a, const float* b) {
+    for (int col = 0; col < 4; col++) {
+        float b0 = b[col * 4 + 0], b1 = b[col * 4 + 1], b2 = b[col * 4 + 2], b3 = b[col * 4 + 3];
+        for (int row = 0; row < 4; row++) {
+            out[col * 4 + row] = a[row] * b0 + a[4 + row] * b1 + a[8 + row] * b2 + a[12 + row] * b3;
+        }
+    }
+}
+
+// Matrix buffers hold either one matrix per item or a single shared matrix
+bool isBroadcast(const KernelBuffer& buffer, size_t count) {
+    return count > 1 && buffer.length / (16 * sizeof(float)) < count;
+}
+
+/**
+ * cullSpheres: buffers [spheres f32 (x,y,z,r) * count, planes f32 (nx,ny,nz,d) * 6, visible u8 * count]
+ * A sphere is visible unless it lies entirely behind one of the six planes.
+ */
+Kernel cullSpheres() {
+    Kernel kernel;
+    kernel.grain = 4096;
+    kernel.validate = [](const KernelArgs& args, size_t count) {
+        std::string error = checkCount(count, 4 * sizeof(float));
+        if (!error.empty()) return error;
+        return checkBuffers(args, {count * 4 * sizeof(float), 24 * sizeof(float), count});
+    };
+    kernel.run = [](const KernelArgs& args, size_t begin, size_t end) {
+        const float* spheres = floats(args, 0);
+        const float* planes = floats(args, 1);
+        auto* visible = static_cast<uint8_t*>(args.buffers[2].data);
+        for (size_t i = begin; i < end; i++) {
+            const float* s = spheres + i * 4;
+            uint8_t inside = 1;
+            for (int p = 0; p < 6; p++) {
+                const float* plane = planes + p * 4;
+                if (plane[0] * s[0] + plane[1] * s[1] + plane[2] * s[2] + plane[3] < -s[3]) {
+                    inside = 0;
+                    break;
+                }
+            }
+            visible[i] = inside;
+        }
+    };
+    return kernel;
+}
+
+/**
+ * mat4Multiply: buffers [a f32 mat4 * count (or 1), b f32 mat4 * count (or 1), out f32 mat4 * count]
+ * out[i] = a[i] * b[i]; e.g. world = parentWorld * local, or viewProj * model.
+ */
+Kernel mat4Multiply() {
+    Kernel kernel;
+    kernel.grain = 1024;
+    kernel.validate = [](const KernelArgs& args, size_t count) {
+        std::string error = checkCount(count, 16 * sizeof(float));
+        if (!error.empty()) return error;
+        return checkBuffers(args, {16 * sizeof(float), 16 * sizeof(float), count * 16 * sizeof(float)});
+    };
+    kernel.run = [](const KernelArgs& args, size_t begin, size_t end) {
+        bool broadcastA = isBroadcast(args.buffers[0], args.count);
+        bool broadcastB = isBroadcast(args.buffers[1], args.count);
+        const float* a = floats(args, 0);
+        const float* b = floats(args, 1);
+        float* out = floats(args, 2);
+        for (size_t i = begin; i < end; i++) {
+            mat4Mul(out + i * 16, broadcastA ? a : a + i * 16, broadcastB ? b : b + i * 16);
+        }
+    };
+    return kernel;
+}
+
+/**
+ * transformAABB: buffers [matrices f32 mat4 * count (or 1), local f32 (min xyz, max xyz) * count, world f32 * 6 * count]
+ * Arvo's method: the world box of a transformed box without transforming 8 corners.
+ */
+Kernel transformAABB() {
+    Kernel kernel;
+    kernel.grain = 2048;
+    kernel.validate = [](const KernelArgs& args, size_t count) {
+        std::string error = checkCount(count, 6 * sizeof(float));
+        if (!error.empty()) return error;
+        return checkBuffers(args, {16 * sizeof(float), count * 6 * sizeof(float), count * 6 * sizeof(float)});
+    };
+    kernel.run = [](const KernelArgs& args, size_t begin, size_t end) {
+        bool broadcast = isBroadcast(args.buffers[0], args.count);
+        const float* matrices = floats(args, 0);
+        const float* local = floats(args, 1);
+        float* world = floats(args, 2);
+        for (size_t i = begin; i < end; i++) {
+            const float* m = broadcast ? matrices : matrices + i * 16;
+            const float* box = local + i * 6;
+            float* out = world + i * 6;
+            for (int row = 0; row < 3; row++) {
+                float lo = m[12 + row];
+                float hi = m[12 + row];
+                for (int col = 0; col < 3; col++) {
+                    float a = m[col * 4 + row] * box[col];
+                    float b = m[col * 4 + row] * box[3 + col];
+                    lo += std::min(a, b);
+                    hi += std::max(a, b);
+                }
+                out[row] = lo;
+                out[3 + row] = hi;
+            }
+        }
+    };
+    return kernel;
+}
+
+/**
+ * sortByKey: buffers [keys f32 * count, indices u32 * count (output)], params [descending]
+ * Writes the item order sorted by key (stable). Chunks sort their own range;
+ * finish() merges the sorted runs pairwise.
+ */
+Kernel sortByKey() {
+    Kernel kernel;
+    kernel.grain = 8192;
+    kernel.validate = [](const KernelArgs& args, size_t count) {
+        if (count > UINT32_MAX) return std::string("count exceeds uint32 index range");
+        std::string error = checkCount(count, sizeof(uint32_t));
+        if (!error.empty()) return error;
+        return checkBuffers(args, {count * sizeof(float), count * sizeof(uint32_t)});
+    };
+
+    auto makeLess = [](const KernelArgs& args) {
+        const float* keys = floats(args, 0);
+        bool descending = !args.params.empty() && args.params[0] != 0;
+        return [keys, descending](uint32_t a, uint32_t b) {
+            return descending ? keys[a] > keys[b] : keys[a] < keys[b];
+        };
+    };
+
+    kernel.run = [makeLess](const KernelArgs& args, size_t begin, size_t end) {
+        auto* indices = static_cast<uint32_t*>(args.buffers[1].data);
+        for (size_t i = begin; i < end; i++) {
+            indices[i] = static_cast<uint32_t>(i);
+        }
+        std::stable_sort(indices + begin, indices + end, makeLess(args));
+    };
+
+    kernel.finish = [makeLess](const KernelArgs& args, size_t count, size_t grain) {
+        auto* indices = static_cast<uint32_t*>(args.buffers[1].data);
+        auto less = makeLess(args);
+        // Each level's merges touch disjoint ranges, so they run in parallel too
+        for (size_t width = grain; width < count; width *= 2) {
+            size_t pairs = (count - width + width * 2 - 1) / (width * 2);
+            JobSystem::instance().parallelFor(pairs, 1, [&](size_t first, size_t last) {
+                for (size_t pair = first; pair < last; pair++) {
+                    size_t begin = pair * width * 2;
+                    size_t end = std::min(begin + width * 2, count);
+                    std::inplace_merge(indices + begin, indices + begin + width, indices + end, less);
+                }
+            });
+        }
+    };
+    return kernel;
+}
+
+}  // namespace
+
+void registerBuiltinKernels(JobSystem& jobs) {
+    jobs.registerKernel("cullSpheres", cullSpheres());
+    jobs.registerKernel("mat4Multiply", mat4Multiply());
+    jobs.registerKernel("transformAABB", transformAABB());
+    jobs.registerKernel("sortByKey", sortByKey());
+}
+
+}  // namespace jobs
+}  // namespace mystral
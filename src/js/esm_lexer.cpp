@@ -0,0 +1,979 @@
+/**
+ * ESM Lexer Implementation
+ */
+
+#include "mystral/js/esm_lexer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace mystral {
+namespace js {
+
+namespace {
+
+enum class TokenType {
+    End,
+    Identifier,
+    String,
+    Number,
+    Template,  // A whole template, or the piece up to/after a ${...} substitution
+    Regex,
+    Punct,
+};
+
+struct Token {
+    TokenType type = TokenType::End;
+    size_t start = 0;
+    size_t end = 0;
+    bool newlineBefore = false;
+};
+
+bool isIdentStart(unsigned char c) {
+    return std::isalpha(c) || c == '_' || c == '$' || c == '\\' || c == '#' || c >= 0x80;
+}
+
+bool isIdentPart(unsigned char c) {
+    return isIdentStart(c) || std::isdigit(c);
+}
+
+// Keywords after which a `/` starts a regex rather than a division
+bool isRegexKeyword(const char* word, size_t length) {
+    static const char* const kKeywords[] = {
+        "return", "typeof", "instanceof", "in", "of", "new", "delete", "void",
+        "throw", "case", "do", "else", "yield", "await",
+    };
+    for (const char* keyword : kKeywords) {
+        if (std::strlen(keyword) == length && std::memcmp(keyword, word, length) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Keywords whose parenthesized head is followed by a statement, where a `/`
+// after the `)` starts a regex: if (x) /re/.test(s)
+bool isControlKeyword(const char* word, size_t length) {
+    static const char* const kKeywords[] = {"if", "while", "for", "with"};
+    for (const char* keyword : kKeywords) {
+        if (std::strlen(keyword) == length && std::memcmp(keyword, word, length) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Tokenizer that understands just enough JS to never mistake the inside of a
+ * string, comment, template or regex for code. Tracks bracket depth, with a
+ * template substitution counting as one level.
+ */
+class Lexer {
+public:
+    struct State {
+        size_t pos;
+        int depth;
+        std::vector<int> templates;
+        std::vector<bool> parens;
+        bool regexAllowed;
+        bool afterControl;
+    };
+
+    explicit Lexer(const std::string& source)
+        : src_(source.data())
+        , size_(source.size()) {
+        // Hashbang line
+        if (size_ >= 2 && src_[0] == '#' && src_[1] == '!') {
+            while (pos_ < size_ && src_[pos_] != '\n') pos_++;
+        }
+    }
+
+    int depth() const { return depth_; }
+    State save() const { return {pos_, depth_, templates_, parens_, regexAllowed_, afterControl_}; }
+    void restore(const State& state) {
+        pos_ = state.pos;
+        depth_ = state.depth;
+        templates_ = state.templates;
+        parens_ = state.parens;
+        regexAllowed_ = state.regexAllowed;
+        afterControl_ = state.afterControl;
+    }
+
+    Token next() {
+        Token token;
+        token.newlineBefore = skipTrivia();
+        token.start = pos_;
+        if (pos_ >= size_) {
+            token.end = pos_;
+            return token;
+        }
+
+        unsigned char c = static_cast<unsigned char>(src_[pos_]);
+        bool afterControl = afterControl_;
+        afterControl_ = false;
+        if (isIdentStart(c)) {
+            pos_++;
+            while (pos_ < size_ && isIdentPart(static_cast<unsigned char>(src_[pos_]))) pos_++;
+            token.type = TokenType::Identifier;
+            regexAllowed_ = isRegexKeyword(src_ + token.start, pos_ - token.start);
+            afterControl_ = isControlKeyword(src_ + token.start, pos_ - token.start);
+        } else if (std::isdigit(c) || (c == '.' && pos_ + 1 < size_ && std::isdigit(static_cast<unsigned char>(src_[pos_ + 1])))) {
+            pos_++;
+            while (pos_ < size_ && (std::isalnum(static_cast<unsigned char>(src_[pos_])) || src_[pos_] == '_' || src_[pos_] == '.')) pos_++;
+            token.type = TokenType::Number;
+            regexAllowed_ = false;
+        } else if (c == '"' || c == '\'') {
+            scanString(static_cast<char>(c));
+            token.type = TokenType::String;
+            regexAllowed_ = false;
+        } else if (c == '`') {
+            pos_++;
+            scanTemplate();
+            token.type = TokenType::Template;
+        } else if (c == '}' && !templates_.empty() && templates_.back() == depth_ - 1) {
+            // End of a ${...} substitution: back inside the template
+            pos_++;
+            depth_--;
+            templates_.pop_back();
+            scanTemplate();
+            token.type = TokenType::Template;
+        } else if (c == '/' && regexAllowed_ && scanRegex()) {
+            token.type = TokenType::Regex;
+            regexAllowed_ = false;
+        } else {
+            scanPunct(static_cast<char>(c), afterControl);
+            token.type = TokenType::Punct;
+        }
+
+        token.end = pos_;
+        return token;
+    }
+
+private:
+    const char* src_;
+    size_t size_;
+    size_t pos_ = 0;
+    int depth_ = 0;
+    std::vector<int> templates_;  // depth_ outside each open ${ substitution
+    std::vector<bool> parens_;    // Per open `(`: whether it follows if/while/for/with
+    bool regexAllowed_ = true;
+    bool afterControl_ = false;   // Last token was if/while/for/with
+
+    // Skip whitespace and comments; returns whether a line break was crossed
+    bool skipTrivia() {
+        bool newline = false;
+        while (pos_ < size_) {
+            char c = src_[pos_];
+            if (c == '\n') {
+                newline = true;
+                pos_++;
+            } else if (c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f') {
+                pos_++;
+            } else if (c == '/' && pos_ + 1 < size_ && src_[pos_ + 1] == '/') {
+                while (pos_ < size_ && src_[pos_] != '\n') pos_++;
+            } else if (c == '/' && pos_ + 1 < size_ && src_[pos_ + 1] == '*') {
+                const char* close = nullptr;
+                for (size_t i = pos_ + 2; i + 1 < size_; i++) {
+                    if (src_[i] == '\n') newline = true;
+                    if (src_[i] == '*' && src_[i + 1] == '/') {
+                        close = src_ + i;
+                        break;
+                    }
+                }
+                pos_ = close ? static_cast<size_t>(close - src_) + 2 : size_;
+            } else if (static_cast<unsigned char>(c) == 0xC2 && pos_ + 1 < size_ &&
+                       static_cast<unsigned char>(src_[pos_ + 1]) == 0xA0) {
+                pos_ += 2;  // NBSP
+            } else if (static_cast<unsigned char>(c) == 0xEF && pos_ + 2 < size_ &&
+                       static_cast<unsigned char>(src_[pos_ + 1]) == 0xBB &&
+                       static_cast<unsigned char>(src_[pos_ + 2]) == 0xBF) {
+                pos_ += 3;  // BOM
+            } else {
+                break;
+            }
+        }
+        return newline;
+    }
+
+    void scanString(char quote) {
+        pos_++;
+        while (pos_ < size_) {
+            char c = src_[pos_];
+            if (c == '\\') {
+                pos_ += 2;
+            } else if (c == quote) {
+                pos_++;
+                return;
+            } else if (c == '\n') {
+                return;  // Unterminated; let the engine report it
+            } else {
+                pos_++;
+            }
+        }
+        pos_ = size_;
+    }
+
+    // Scan template text up to the closing backtick or the next ${
+    void scanTemplate() {
+        while (pos_ < size_) {
+            char c = src_[pos_];
+            if (c == '\\') {
+                pos_ += 2;
+            } else if (c == '`') {
+                pos_++;
+                regexAllowed_ = false;
+                return;
+            } else if (c == '$' && pos_ + 1 < size_ && src_[pos_ + 1] == '{') {
+                pos_ += 2;
+                templates_.push_back(depth_);
+                depth_++;
+                regexAllowed_ = true;
+                return;
+            } else {
+                pos_++;
+            }
+        }
+        pos_ = size_;
+    }
+
+    /**
+     * Scan a regex literal at pos_ (a `/` where an expression can start)
+     * A regex cannot span lines, so on a line break this was a division after
+     * all: return false and let it lex as punctuation.
+     */
+    bool scanRegex() {
+        size_t i = pos_ + 1;
+        bool inClass = false;
+        while (i < size_) {
+            char c = src_[i];
+            if (c == '\n' || c == '\r') {
+                return false;
+            } else if (c == '\\') {
+                i += 2;
+                continue;
+            } else if (c == '[') {
+                inClass = true;
+            } else if (c == ']') {
+                inClass = false;
+            } else if (c == '/' && !inClass) {
+                i++;
+                while (i < size_ && isIdentPart(static_cast<unsigned char>(src_[i]))) i++;
+                pos_ = i;
+                return true;
+            }
+            i++;
+        }
+        return false;
+    }
+
+    void scanPunct(char c, bool afterControl) {
+        if (c == '.' && pos_ + 2 < size_ && src_[pos_ + 1] == '.' && src_[pos_ + 2] == '.') {
+            pos_ += 3;
+            regexAllowed_ = true;
+            return;
+        }
+        if (pos_ + 1 < size_) {
+            char n = src_[pos_ + 1];
+            if ((c == '+' && n == '+') || (c == '-' && n == '-')) {
+                pos_ += 2;
+                regexAllowed_ = false;
+                return;
+            }
+            if (c == '=' && n == '>') {
+                pos_ += 2;
+                regexAllowed_ = true;
+                return;
+            }
+        }
+
+        pos_++;
+        if (c == '(' || c == '[' || c == '{') {
+            depth_++;
+        } else if ((c == ')' || c == ']' || c == '}') && depth_ > 0) {
+            depth_--;
+        }
+        // `}` usually ends a block, after which a statement (maybe a regex) starts;
+        // so does the `)` closing an if/while/for/with head
+        regexAllowed_ = c != ')' && c != ']';
+        if (c == '(') {
+            parens_.push_back(afterControl);
+        } else if (c == ')' && !parens_.empty()) {
+            regexAllowed_ = parens_.back();
+            parens_.pop_back();
+        }
+    }
+};
+
+/**
+ * Recognizes import/export statements in the token stream
+ */
+class Scanner {
+public:
+    explicit Scanner(const std::string& source)
+        : src_(source)
+        , lex_(source) {}
+
+    EsmScanResult run() {
+        Token prev;
+        while (true) {
+            int depth = lex_.depth();
+            Token token = lex_.next();
+            if (token.type == TokenType::End) break;
+
+            if (token.type == TokenType::Identifier && !isPunct(prev, '.')) {
+                if (is(token, "import")) {
+                    auto state = lex_.save();
+                    if (depth == 0 && parseImport(token)) {
+                        prev = Token();
+                        continue;
+                    }
+                    lex_.restore(state);
+                    scanLiteralCall(result_.dynamicImports);
+                    scanImportMeta(token);
+                } else if (is(token, "require")) {
+                    scanLiteralCall(result_.requireCalls);
+                } else if (is(token, "export") && depth == 0) {
+                    auto state = lex_.save();
+                    if (parseExport(token)) {
+                        prev = Token();
+                        continue;
+                    }
+                    lex_.restore(state);
+                }
+            }
+            prev = token;
+        }
+        return std::move(result_);
+    }
+
+private:
+    const std::string& src_;
+    Lexer lex_;
+    EsmScanResult result_;
+    size_t lastEnd_ = 0;
+
+    Token next() {
+        Token token = lex_.next();
+        if (token.type != TokenType::End) lastEnd_ = token.end;
+        return token;
+    }
+
+    Token peek() {
+        auto state = lex_.save();
+        Token token = lex_.next();
+        lex_.restore(state);
+        return token;
+    }
+
+    std::string text(const Token& token) const {
+        return src_.substr(token.start, token.end - token.start);
+    }
+
+    bool is(const Token& token, const char* word) const {
+        size_t length = std::strlen(word);
+        return token.type == TokenType::Identifier && token.end - token.start == length &&
+               src_.compare(token.start, length, word) == 0;
+    }
+
+    bool isPunct(const Token& token, char c) const {
+        return token.type == TokenType::Punct && token.end - token.start == 1 && src_[token.start] == c;
+    }
+
+    bool isPunct(const Token& token, const char* punct) const {
+        size_t length = std::strlen(punct);
+        return token.type == TokenType::Punct && token.end - token.start == length &&
+               src_.compare(token.start, length, punct) == 0;
+    }
+
+    // String literal value with simple escapes decoded
+    std::string decodeString(const Token& token) const {
+        std::string out;
+        size_t end = token.end > token.start + 1 ? token.end - 1 : token.end;
+        for (size_t i = token.start + 1; i < end; i++) {
+            char c = src_[i];
+            if (c == '\\' && i + 1 < end) {
+                char e = src_[++i];
+                switch (e) {
+                    case 'n': out += '\n'; break;
+                    case 't': out += '\t'; break;
+                    case 'r': out += '\r'; break;
+                    case '0': out += '\0'; break;
+                    default: out += e; break;
+                }
+            } else {
+                out += c;
+            }
+        }
+        return out;
+    }
+
+    void setSpecifier(EsmStatement& statement, const Token& token) const {
+        statement.specifier = decodeString(token);
+        statement.specifierLiteral = text(token);
+    }
+
+    // Import attributes, then the optional semicolon
+    void finish(EsmStatement& statement) {
+        Token attr = peek();
+        if (is(attr, "with") || (is(attr, "assert") && !attr.newlineBefore)) {
+            auto state = lex_.save();
+            next();
+            if (isPunct(peek(), '{')) {
+                skipBalanced();
+            } else {
+                lex_.restore(state);
+            }
+        }
+        if (isPunct(peek(), ';')) {
+            next();
+        }
+        statement.end = lastEnd_;
+        result_.statements.push_back(std::move(statement));
+    }
+
+    // Consume a bracketed group starting at the next token
+    void skipBalanced() {
+        int depth = lex_.depth();
+        Token token = next();
+        while (token.type != TokenType::End && lex_.depth() > depth) {
+            token = next();
+        }
+    }
+
+    // `name` or "string" in an import/export list (strings keep their quotes)
+    bool readModuleName(const Token& token, std::string& out) const {
+        if (token.type != TokenType::Identifier && token.type != TokenType::String) return false;
+        out = text(token);
+        return true;
+    }
+
+    // { a, b as c, "d" as e } after the opening brace
+    bool parseNameList(std::vector<std::pair<std::string, std::string>>& names) {
+        while (true) {
+            Token token = next();
+            if (isPunct(token, '}')) return true;
+
+            std::string first;
+            if (!readModuleName(token, first)) return false;
+            std::string second = first;
+
+            token = next();
+            if (is(token, "as")) {
+                if (!readModuleName(next(), second)) return false;
+                token = next();
+            }
+            names.emplace_back(first, second);
+
+            if (isPunct(token, '}')) return true;
+            if (!isPunct(token, ',')) return false;
+        }
+    }
+
+    bool parseImport(const Token& keyword) {
+        EsmStatement statement;
+        statement.kind = EsmStatement::Kind::Import;
+        statement.start = keyword.start;
+
+        Token token = next();
+        if (token.type == TokenType::String) {
+            setSpecifier(statement, token);
+            finish(statement);
+            return true;
+        }
+
+        if (token.type == TokenType::Identifier) {
+            Token after = peek();
+            if (!isPunct(after, ',') && !is(after, "from")) return false;
+            statement.defaultName = text(token);
+            token = next();
+            if (isPunct(token, ',')) {
+                token = next();
+            }
+        }
+
+        if (isPunct(token, '*')) {
+            if (!is(next(), "as")) return false;
+            Token name = next();
+            if (name.type != TokenType::Identifier) return false;
+            statement.namespaceName = text(name);
+            token = next();
+        } else if (isPunct(token, '{')) {
+            if (!parseNameList(statement.names)) return false;
+            token = next();
+        }
+
+        if (!is(token, "from")) return false;
+        token = next();
+        if (token.type != TokenType::String) return false;
+        setSpecifier(statement, token);
+        finish(statement);
+        return true;
+    }
+
+    // import("literal") / require("literal") anywhere; never consumes tokens
+    void scanLiteralCall(std::vector<std::string>& out) {
+        auto state = lex_.save();
+        if (isPunct(lex_.next(), '(')) {
+            Token spec = lex_.next();
+            if (spec.type == TokenType::String && isPunct(lex_.next(), ')')) {
+                out.push_back(decodeString(spec));
+            }
+        }
+        lex_.restore(state);
+    }
+
+    // import.meta anywhere; never consumes tokens
+    void scanImportMeta(const Token& keyword) {
+        auto state = lex_.save();
+        if (isPunct(lex_.next(), '.')) {
+            Token meta = lex_.next();
+            if (is(meta, "meta")) {
+                result_.importMetas.emplace_back(keyword.start, meta.end);
+            }
+        }
+        lex_.restore(state);
+    }
+
+    bool parseExport(const Token& keyword) {
+        EsmStatement statement;
+        statement.start = keyword.start;
+
+        auto afterKeyword = lex_.save();
+        Token token = next();
+
+        if (isPunct(token, '*')) {
+            statement.kind = EsmStatement::Kind::ExportAll;
+            token = next();
+            if (is(token, "as")) {
+                if (!readModuleName(next(), statement.namespaceName)) return false;
+                token = next();
+            }
+            if (!is(token, "from")) return false;
+            token = next();
+            if (token.type != TokenType::String) return false;
+            setSpecifier(statement, token);
+            finish(statement);
+            return true;
+        }
+
+        if (isPunct(token, '{')) {
+            if (!parseNameList(statement.names)) return false;
+            statement.kind = EsmStatement::Kind::ExportList;
+            if (is(peek(), "from")) {
+                next();
+                token = next();
+                if (token.type != TokenType::String) return false;
+                statement.kind = EsmStatement::Kind::ExportFrom;
+                setSpecifier(statement, token);
+            }
+            finish(statement);
+            return true;
+        }
+
+        if (is(token, "default")) {
+            statement.kind = EsmStatement::Kind::ExportDefault;
+            statement.end = token.end;
+            auto afterDefault = lex_.save();
+            parseDefaultDeclaration(statement);
+            // The main loop lexes the declaration/expression itself
+            lex_.restore(afterDefault);
+            result_.statements.push_back(std::move(statement));
+            return true;
+        }
+
+        statement.kind = EsmStatement::Kind::ExportDeclaration;
+        statement.end = keyword.end;
+        if (is(token, "var") || is(token, "let") || is(token, "const")) {
+            parseDeclarators(statement.declared);
+        } else {
+            if (is(token, "async")) {
+                token = next();
+            }
+            if (is(token, "function")) {
+                token = next();
+                if (isPunct(token, '*')) token = next();
+            } else if (is(token, "class")) {
+                token = next();
+            } else {
+                return false;
+            }
+            if (token.type != TokenType::Identifier) return false;
+            statement.declared.push_back(text(token));
+        }
+        if (statement.declared.empty()) return false;
+
+        lex_.restore(afterKeyword);
+        result_.statements.push_back(std::move(statement));
+        return true;
+    }
+
+    // After `export default`: is it a (possibly anonymous) function or class declaration?
+    void parseDefaultDeclaration(EsmStatement& statement) {
+        Token token = next();
+        if (is(token, "async")) {
+            Token function = next();
+            if (!is(function, "function") || function.newlineBefore) return;
+            token = function;
+        }
+
+        if (is(token, "function")) {
+            statement.defaultIsDeclaration = true;
+            size_t nameAt = token.end;
+            Token name = next();
+            if (isPunct(name, '*')) {
+                nameAt = name.end;
+                name = next();
+            }
+            if (name.type == TokenType::Identifier) {
+                statement.defaultName = text(name);
+            } else {
+                statement.nameInsertAt = nameAt;
+            }
+        } else if (is(token, "class")) {
+            statement.defaultIsDeclaration = true;
+            Token name = next();
+            if (name.type == TokenType::Identifier && !is(name, "extends")) {
+                statement.defaultName = text(name);
+            } else {
+                statement.nameInsertAt = token.end;
+            }
+        }
+    }
+
+    void parseDeclarators(std::vector<std::string>& names) {
+        while (true) {
+            if (!parseBinding(names)) return;
+            if (isPunct(peek(), '=')) {
+                next();
+                skipExpression();
+            }
+            if (!isPunct(peek(), ',')) return;
+            next();
+        }
+    }
+
+    // A binding identifier or destructuring pattern; collects the bound names
+    bool parseBinding(std::vector<std::string>& names) {
+        Token token = next();
+        if (token.type == TokenType::Identifier) {
+            names.push_back(text(token));
+            return true;
+        }
+
+        if (isPunct(token, '{')) {
+            while (true) {
+                token = next();
+                if (isPunct(token, '}')) return true;
+                if (isPunct(token, "...")) {
+                    if (!parseBinding(names)) return false;
+                } else {
+                    bool shorthand = token.type == TokenType::Identifier;
+                    std::string key = text(token);
+                    if (isPunct(token, '[')) {
+                        // Computed key: skip to the matching ]
+                        int depth = lex_.depth();
+                        while (lex_.depth() >= depth && token.type != TokenType::End) token = next();
+                        shorthand = false;
+                    } else if (token.type != TokenType::Identifier && token.type != TokenType::String &&
+                               token.type != TokenType::Number) {
+                        return false;
+                    }
+                    if (isPunct(peek(), ':')) {
+                        next();
+                        if (!parseBinding(names)) return false;
+                    } else if (shorthand) {
+                        names.push_back(key);
+                    } else {
+                        return false;
+                    }
+                    if (isPunct(peek(), '=')) {
+                        next();
+                        skipExpression();
+                    }
+                }
+                token = next();
+                if (isPunct(token, '}')) return true;
+                if (!isPunct(token, ',')) return false;
+            }
+        }
+
+        if (isPunct(token, '[')) {
+            while (true) {
+                Token ahead = peek();
+                if (isPunct(ahead, ',')) {
+                    next();
+                    continue;
+                }
+                if (isPunct(ahead, ']')) {
+                    next();
+                    return true;
+                }
+                if (isPunct(ahead, "...")) next();
+                if (!parseBinding(names)) return false;
+                if (isPunct(peek(), '=')) {
+                    next();
+                    skipExpression();
+                }
+                token = next();
+                if (isPunct(token, ']')) return true;
+                if (!isPunct(token, ',')) return false;
+            }
+        }
+
+        return false;
+    }
+
+    static bool isOperatorKeyword(const std::string& word) {
+        return word == "in" || word == "instanceof" || word == "of" || word == "typeof" ||
+               word == "new" || word == "delete" || word == "void" || word == "await" || word == "yield";
+    }
+
+    bool endsExpression(const Token& token) const {
+        switch (token.type) {
+            case TokenType::Identifier: return !isOperatorKeyword(text(token));
+            case TokenType::String:
+            case TokenType::Number:
+            case TokenType::Regex:
+                return true;
+            case TokenType::Template:
+                return src_[token.end - 1] == '`';
+            case TokenType::Punct:
+                return isPunct(token, ')') || isPunct(token, ']') || isPunct(token, '}') ||
+                       isPunct(token, "++") || isPunct(token, "--");
+            default:
+                return false;
+        }
+    }
+
+    bool startsStatement(const Token& token) const {
+        if (token.type == TokenType::Identifier) {
+            std::string word = text(token);
+            return word != "in" && word != "instanceof";
+        }
+        return token.type == TokenType::String || token.type == TokenType::Number;
+    }
+
+    /**
+     * Skip an initializer: stops before a `,` `;` or closing bracket at its own
+     * level, or where automatic semicolon insertion would end the statement.
+     */
+    void skipExpression() {
+        int base = lex_.depth();
+        Token prev;
+        bool first = true;
+        while (true) {
+            auto state = lex_.save();
+            int depth = lex_.depth();
+            Token token = lex_.next();
+            if (token.type == TokenType::End) {
+                lex_.restore(state);
+                return;
+            }
+            if (depth == base) {
+                if (isPunct(token, ',') || isPunct(token, ';') || isPunct(token, ')') ||
+                    isPunct(token, ']') || isPunct(token, '}')) {
+                    lex_.restore(state);
+                    return;
+                }
+                if (!first && token.newlineBefore && endsExpression(prev) && startsStatement(token)) {
+                    lex_.restore(state);
+                    return;
+                }
+            }
+            lastEnd_ = token.end;
+            prev = token;
+            first = false;
+        }
+    }
+};
+
+// Property key for Object.defineProperty: names from string literals keep their quotes
+std::string propertyLiteral(const std::string& name) {
+    if (!name.empty() && (name[0] == '"' || name[0] == '\'')) return name;
+    return "\"" + name + "\"";
+}
+
+// Member access for a name that may be a string literal
+std::string memberAccess(const std::string& object, const std::string& name) {
+    if (!name.empty() && (name[0] == '"' || name[0] == '\'')) return object + "[" + name + "]";
+    return object + "." + name;
+}
+
+std::string interopDefault(const std::string& module) {
+    return "(" + module + " && " + module + ".__esModule ? " + module + ".default : " + module + ")";
+}
+
+}  // namespace
+
+EsmScanResult scanEsm(const std::string& source) {
+    return Scanner(source).run();
+}
+
+std::string transformEsmToCjs(const std::string& source) {
+    EsmScanResult scan = scanEsm(source);
+    bool hashbang = source.size() >= 2 && source[0] == '#' && source[1] == '!';
+    if (scan.statements.empty() && scan.importMetas.empty() && !hashbang) {
+        return source;
+    }
+
+    std::string body;
+    body.reserve(source.size() + scan.statements.size() * 48);
+    std::string getters;
+    bool hasExports = false;
+    bool usesExportStar = false;
+    int tempCount = 0;
+
+    auto newTemp = [&tempCount]() {
+        return "__esm_import" + std::to_string(tempCount++);
+    };
+    auto exportGetter = [&getters](const std::string& name, const std::string& expr) {
+        getters += "__esm_export(" + propertyLiteral(name) + ", function() { return " + expr + "; }); ";
+    };
+    // Copies source[from, to), replacing the import.meta expressions in it
+    // (they never overlap a rewritten statement span)
+    size_t nextMeta = 0;
+    auto appendSource = [&](size_t from, size_t to) {
+        while (nextMeta < scan.importMetas.size() && scan.importMetas[nextMeta].first < to) {
+            const auto& meta = scan.importMetas[nextMeta++];
+            if (meta.first < from) continue;
+            body.append(source, from, meta.first - from);
+            body += "__esm_importMeta";
+            from = meta.second;
+        }
+        body.append(source, from, to - from);
+    };
+
+    size_t cursor = 0;
+    for (const auto& statement : scan.statements) {
+        appendSource(cursor, statement.start);
+        std::string replacement;
+
+        switch (statement.kind) {
+            case EsmStatement::Kind::Import: {
+                const std::string& spec = statement.specifierLiteral;
+                bool importsDefault = !statement.defaultName.empty();
+                for (const auto& name : statement.names) {
+                    if (name.first == "default") importsDefault = true;
+                }
+                bool hasBindings = importsDefault || !statement.namespaceName.empty() || !statement.names.empty();
+
+                if (!hasBindings) {
+                    replacement = "require(" + spec + ");";
+                    break;
+                }
+
+                std::string module = "require(" + spec + ")";
+                if (importsDefault || (!statement.namespaceName.empty() && !statement.names.empty())) {
+                    std::string temp = newTemp();
+                    replacement = "var " + temp + " = " + module + "; ";
+                    module = temp;
+                }
+                if (!statement.defaultName.empty()) {
+                    replacement += "const " + statement.defaultName + " = " + interopDefault(module) + "; ";
+                }
+                if (!statement.namespaceName.empty()) {
+                    replacement += "const " + statement.namespaceName + " = " + module + "; ";
+                }
+                std::string destructure;
+                for (const auto& name : statement.names) {
+                    if (name.first == "default") {
+                        replacement += "const " + name.second + " = " + interopDefault(module) + "; ";
+                        continue;
+                    }
+                    if (!destructure.empty()) destructure += ", ";
+                    destructure += name.first == name.second ? name.first : name.first + ": " + name.second;
+                }
+                if (!destructure.empty()) {
+                    replacement += "const { " + destructure + " } = " + module + "; ";
+                }
+                replacement.pop_back();
+                break;
+            }
+
+            case EsmStatement::Kind::ExportDeclaration:
+                hasExports = true;
+                for (const auto& name : statement.declared) {
+                    exportGetter(name, name);
+                }
+                break;
+
+            case EsmStatement::Kind::ExportDefault:
+                hasExports = true;
+                if (statement.defaultIsDeclaration) {
+                    exportGetter("default", statement.defaultName.empty() ? "__esm_default" : statement.defaultName);
+                } else {
+                    replacement = "exports.default = ";
+                }
+                break;
+
+            case EsmStatement::Kind::ExportList:
+                hasExports = true;
+                for (const auto& name : statement.names) {
+                    exportGetter(name.second, name.first);
+                }
+                break;
+
+            case EsmStatement::Kind::ExportFrom: {
+                hasExports = true;
+                std::string temp = newTemp();
+                replacement = "var " + temp + " = require(" + statement.specifierLiteral + ");";
+                for (const auto& name : statement.names) {
+                    exportGetter(name.second, name.first == "default" ? interopDefault(temp) : memberAccess(temp, name.first));
+                }
+                break;
+            }
+
+            case EsmStatement::Kind::ExportAll:
+                hasExports = true;
+                if (!statement.namespaceName.empty()) {
+                    std::string temp = newTemp();
+                    replacement = "var " + temp + " = require(" + statement.specifierLiteral + ");";
+                    exportGetter(statement.namespaceName, temp);
+                } else {
+                    usesExportStar = true;
+                    replacement = "__esm_exportStar(require(" + statement.specifierLiteral + "));";
+                }
+                break;
+        }
+
+        body += replacement;
+        // Keep the following code on its original line
+        body.append(std::count(source.begin() + statement.start, source.begin() + statement.end, '\n'), '\n');
+        cursor = statement.end;
+
+        if (statement.nameInsertAt != std::string::npos) {
+            appendSource(cursor, statement.nameInsertAt);
+            body += " __esm_default";
+            cursor = statement.nameInsertAt;
+        }
+    }
+    appendSource(cursor, source.size());
+
+    if (hashbang) {
+        body[0] = '/';
+        body[1] = '/';
+    }
+
+    // Prelude on the first line, so line numbers are unchanged
+    std::string prelude;
+    if (!scan.importMetas.empty()) {
+        // module.hot is set by the module system when hot updates are available
+        prelude += "var __esm_importMeta = { url: \"file://\" + __filename, hot: module.hot }; ";
+    }
+    if (!hasExports) {
+        return prelude + body;
+    }
+    prelude += "Object.defineProperty(exports, \"__esModule\", { value: true }); ";
+    prelude += "function __esm_export(name, get) { Object.defineProperty(exports, name, { enumerable: true, configurable: true, get: get }); } ";
+    if (usesExportStar) {
+        prelude += "function __esm_exportStar(m) { Object.keys(m).forEach(function(k) { "
+                   "if (k !== \"default\" && k !== \"__esModule\" && !Object.prototype.hasOwnProperty.call(exports, k)) "
+                   "__esm_export(k, function() { return m[k]; }); }); } ";
+    }
+    prelude += getters;
+    return prelude + body;
+}
+
+}  // namespace js
+}  // namespace mystral
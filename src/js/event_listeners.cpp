@@ -0,0 +1,34 @@
+/**
+ * EventListenerTable Implementation
+ */
+
+#include "mystral/js/event_listeners.h"
+
+namespace mystral {
+namespace js {
+
+EventListenerTable::TypeId EventListenerTable::intern(const std::string& type) {
+    auto it = ids_.find(type);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    TypeId id = static_cast<TypeId>(lists_.size());
+    ids_.emplace(type, id);
+    lists_.emplace_back();
+    targetMasks_.push_back(0);
+    return id;
+}
+
+EventListenerTable::TypeId EventListenerTable::find(const std::string& type) const {
+    auto it = ids_.find(type);
+    return it != ids_.end() ? it->second : kNoType;
+}
+
+void EventListenerTable::add(EventTarget target, const std::string& type, JSValueHandle callback, bool useCapture) {
+    TypeId id = intern(type);
+    lists_[id][static_cast<size_t>(target)].push_back({callback, useCapture});
+    targetMasks_[id] |= targetBit(target);
+}
+
+}  // namespace js
+}  // namespace mystral
@@ -18,7 +18,8 @@ namespace mystral {
 namespace js {
 
 // Store native function callbacks (since we can't capture lambdas in JSC callbacks)
-static std::unordered_map<void*, NativeFunction> g_nativeFunctions;
+// Thread-local: worker threads run their own context group (see workers::WorkerThread)
+static thread_local std::unordered_map<void*, NativeFunction> g_nativeFunctions;
 
 class JSCEngine : public Engine {
 public:
@@ -148,6 +149,20 @@ public:
         return {(void*)result, context_};
     }
 
+    JSValueHandle newStringUtf8(const char* data, size_t length) override {
+        // Goes through CFString so embedded NULs survive
+        CFStringRef cfStr = CFStringCreateWithBytes(kCFAllocatorDefault, reinterpret_cast<const UInt8*>(data),
+                                                    static_cast<CFIndex>(length), kCFStringEncodingUTF8, false);
+        if (!cfStr) {
+            return newString("");  // Invalid UTF-8
+        }
+        JSStringRef str = JSStringCreateWithCFString(cfStr);
+        CFRelease(cfStr);
+        JSValueRef result = JSValueMakeString(context_, str);
+        JSStringRelease(str);
+        return {(void*)result, context_};
+    }
+
     JSValueHandle newObject() override {
         return {(void*)JSObjectMake(context_, nullptr, nullptr), context_};
     }
@@ -214,6 +229,32 @@ public:
         return {(void*)arrayBuffer, context_};
     }
 
+    // detachArrayBuffer: the JSC C API cannot detach, so the Engine default
+    // (copy, source left intact) is used. Receiving a store is still zero-copy.
+    JSValueHandle newArrayBufferFromStore(std::shared_ptr<BackingStore> store) override {
+        if (!store) return newNull();
+
+        auto* holder = new std::shared_ptr<BackingStore>(std::move(store));
+        JSValueRef exception = nullptr;
+        JSObjectRef arrayBuffer = JSObjectMakeArrayBufferWithBytesNoCopy(
+            context_,
+            (*holder)->data,
+            (*holder)->length,
+            [](void*, void* deallocatorContext) {
+                delete static_cast<std::shared_ptr<BackingStore>*>(deallocatorContext);
+            },
+            holder,
+            &exception
+        );
+
+        if (exception) {
+            delete holder;
+            return {nullptr, context_};
+        }
+
+        return {(void*)arrayBuffer, context_};
+    }
+
     void* getArrayBufferData(JSValueHandle value, size_t* size) override {
         JSValueRef val = (JSValueRef)value.ptr;
         if (!val) return nullptr;
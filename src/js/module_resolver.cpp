@@ -59,6 +59,44 @@ bool ModuleResolver::resolve(const std::string& specifier,
                              ResolveMode mode,
                              ResolvedModule& out,
                              std::string& error) {
+    stats_.resolves++;
+
+    // Everything below depends only on the referrer's directory
+    std::string key = specifier;
+    key += '\n';
+    key += referrer.empty() ? std::string() : dirname(referrer);
+    key += mode == ResolveMode::Import ? "\ni" : "\nr";
+
+    auto cached = resolveCache_.find(key);
+    if (cached != resolveCache_.end()) {
+        stats_.resolveHits++;
+        if (cached->second.ok) {
+            out = cached->second.module;
+            error.clear();
+            return true;
+        }
+        error = cached->second.error;
+        return false;
+    }
+
+    CachedResolution entry;
+    entry.ok = resolveUncached(specifier, referrer, mode, entry.module, entry.error);
+    bool ok = entry.ok;
+    if (ok) {
+        out = entry.module;
+        error.clear();
+    } else {
+        error = entry.error;
+    }
+    resolveCache_.emplace(std::move(key), std::move(entry));
+    return ok;
+}
+
+bool ModuleResolver::resolveUncached(const std::string& specifier,
+                                     const std::string& referrer,
+                                     ResolveMode mode,
+                                     ResolvedModule& out,
+                                     std::string& error) {
     error.clear();
 
     std::string normalized = normalizeSpecifier(specifier);
@@ -187,8 +225,8 @@ bool ModuleResolver::resolveImports(const std::string& specifier,
         return false;
     }
 
-    PackageInfo pkg;
-    if (!loadPackageJson(packageRoot, pkg, error) || !pkg.hasImports) {
+    const PackageInfo* pkg = loadPackageJson(packageRoot, error);
+    if (!pkg || !pkg->hasImports) {
         if (error.empty()) {
             error = "No imports defined in package.json";
         }
@@ -203,7 +241,7 @@ bool ModuleResolver::resolveImports(const std::string& specifier,
     }
 
     std::string target;
-    if (!resolveExportsTarget(pkg.importsValue, specifier, conditions, target, error)) {
+    if (!resolveExportsTarget(pkg->importsValue, specifier, conditions, target, error)) {
         return false;
     }
 
@@ -256,12 +294,11 @@ bool ModuleResolver::resolvePackage(const std::string& specifier,
         return false;
     }
 
-    PackageInfo pkg;
     std::string pkgError;
-    bool hasPackageJson = loadPackageJson(packageRoot, pkg, pkgError);
+    const PackageInfo* pkg = loadPackageJson(packageRoot, pkgError);
 
-    if (hasPackageJson && pkg.hasExports) {
-        if (resolvePackageExports(pkg, subpath, mode, out, error)) {
+    if (pkg && pkg->hasExports) {
+        if (resolvePackageExports(*pkg, subpath, mode, out, error)) {
             return true;
         }
         return false;
@@ -272,8 +309,8 @@ bool ModuleResolver::resolvePackage(const std::string& specifier,
         return resolvePath(combined, "", mode, out, error);
     }
 
-    if (hasPackageJson) {
-        if (resolvePackageMain(pkg, mode, out, error)) {
+    if (pkg) {
+        if (resolvePackageMain(*pkg, mode, out, error)) {
             return true;
         }
     }
@@ -322,17 +359,16 @@ bool ModuleResolver::resolveAsDirectory(const std::string& path,
 
     std::string pkgPath = (fs::path(path) / "package.json").string();
     if (fileExists(pkgPath)) {
-        PackageInfo pkg;
         std::string pkgError;
-        if (loadPackageJson(path, pkg, pkgError)) {
-            if (pkg.hasExports && mode == ResolveMode::Import) {
-                if (resolvePackageExports(pkg, ".", mode, out, error)) {
+        if (const PackageInfo* pkg = loadPackageJson(path, pkgError)) {
+            if (pkg->hasExports && mode == ResolveMode::Import) {
+                if (resolvePackageExports(*pkg, ".", mode, out, error)) {
                     return true;
                 }
                 return false;
             }
-            if (!pkg.main.empty()) {
-                if (resolvePath((fs::path(path) / pkg.main).generic_string(), "", mode, out, error)) {
+            if (!pkg->main.empty()) {
+                if (resolvePath((fs::path(path) / pkg->main).generic_string(), "", mode, out, error)) {
                     return true;
                 }
             }
@@ -394,22 +430,29 @@ bool ModuleResolver::resolvePackageExports(const PackageInfo& pkg,
     return resolvePath(combined, "", mode, out, error);
 }
 
-bool ModuleResolver::loadPackageJson(const std::string& packageRoot,
-                                     PackageInfo& out,
-                                     std::string& error) const {
+const ModuleResolver::PackageInfo* ModuleResolver::loadPackageJson(const std::string& packageRoot,
+                                                                  std::string& error) const {
     auto cacheIt = packageCache_.find(packageRoot);
     if (cacheIt != packageCache_.end()) {
-        out = cacheIt->second;
-        return true;
+        if (!cacheIt->second.ok) {
+            error = cacheIt->second.error;
+            return nullptr;
+        }
+        return &cacheIt->second.info;
     }
 
+    // Failures are cached too (element references stay valid across rehashing)
+    CachedPackage& entry = packageCache_[packageRoot];
+    stats_.packageJsonReads++;
+
     std::string pkgPath = (fs::path(packageRoot) / "package.json").string();
     std::string data;
     ResolvedPath resolvedPath;
     resolvedPath.path = pkgPath;
     resolvedPath.isBundle = useBundle_;
     if (!readFile(resolvedPath, data, error)) {
-        return false;
+        entry.error = error;
+        return nullptr;
     }
 
     JsonValue root;
@@ -417,10 +460,11 @@ bool ModuleResolver::loadPackageJson(const std::string& packageRoot,
         if (error.empty()) {
             error = "Invalid package.json";
         }
-        return false;
+        entry.error = error;
+        return nullptr;
     }
 
-    PackageInfo info;
+    PackageInfo& info = entry.info;
     info.rootPath = packageRoot;
 
     auto nameIt = root.objectVal.find("name");
@@ -438,17 +482,16 @@ bool ModuleResolver::loadPackageJson(const std::string& packageRoot,
     auto exportsIt = root.objectVal.find("exports");
     if (exportsIt != root.objectVal.end()) {
         info.hasExports = true;
-        info.exportsValue = exportsIt->second;
+        info.exportsValue = std::move(exportsIt->second);
     }
     auto importsIt = root.objectVal.find("imports");
     if (importsIt != root.objectVal.end()) {
         info.hasImports = true;
-        info.importsValue = importsIt->second;
+        info.importsValue = std::move(importsIt->second);
     }
 
-    packageCache_[packageRoot] = info;
-    out = info;
-    return true;
+    entry.ok = true;
+    return &info;
 }
 
 bool ModuleResolver::findPackageRoot(const std::string& startDir,
@@ -482,6 +525,13 @@ bool ModuleResolver::findPackageRoot(const std::string& startDir,
 
 bool ModuleResolver::findNearestPackage(const std::string& startDir,
                                         std::string& outRoot) const {
+    auto cached = nearestPackageCache_.find(startDir);
+    if (cached != nearestPackageCache_.end()) {
+        outRoot = cached->second;
+        return !outRoot.empty();
+    }
+    std::string& result = nearestPackageCache_[startDir];
+
     fs::path current = fs::path(startDir);
     if (!useBundle_) {
         current = fs::absolute(current).lexically_normal();
@@ -490,7 +540,8 @@ bool ModuleResolver::findNearestPackage(const std::string& startDir,
     while (true) {
         fs::path pkgPath = current / "package.json";
         if (fileExists(pkgPath.generic_string())) {
-            outRoot = current.generic_string();
+            result = current.generic_string();
+            outRoot = result;
             return true;
         }
         if (current == current.root_path()) {
@@ -534,17 +585,9 @@ std::string ModuleResolver::detectPackageTypeForPath(const std::string& path) co
         return "";
     }
 
-    auto it = packageCache_.find(packageRoot);
-    if (it != packageCache_.end()) {
-        return it->second.type;
-    }
-
-    PackageInfo info;
     std::string error;
-    if (loadPackageJson(packageRoot, info, error)) {
-        return info.type;
-    }
-    return "";
+    const PackageInfo* info = loadPackageJson(packageRoot, error);
+    return info ? info->type : std::string();
 }
 
 bool ModuleResolver::readFile(const ResolvedPath& path, std::string& out, std::string& error) const {
@@ -571,13 +614,66 @@ bool ModuleResolver::readFile(const ResolvedPath& path, std::string& out, std::s
     return true;
 }
 
-bool ModuleResolver::fileExists(const std::string& path) const {
+ModuleResolver::PathKind ModuleResolver::pathKind(const std::string& path) const {
+    auto cached = statCache_.find(path);
+    if (cached != statCache_.end()) {
+        stats_.statHits++;
+        return cached->second;
+    }
+
+    stats_.statCalls++;
+    PathKind kind = PathKind::Missing;
     if (useBundle_) {
+        // Bundles have no directory entries; dirExists() probes for files instead
         std::vector<uint8_t> data;
-        return vfs::readEmbeddedFile(path, data);
+        if (vfs::readEmbeddedFile(path, data)) {
+            kind = PathKind::File;
+        }
+    } else {
+        std::error_code ec;
+        fs::file_status status = fs::status(path, ec);
+        if (!ec) {
+            if (fs::is_regular_file(status)) {
+                kind = PathKind::File;
+            } else if (fs::is_directory(status)) {
+                kind = PathKind::Directory;
+            }
+        }
+    }
+    statCache_.emplace(path, kind);
+    return kind;
+}
+
+void ModuleResolver::invalidate(const std::string& path) {
+    std::string generic = fs::path(path).generic_string();
+    statCache_.erase(path);
+    statCache_.erase(generic);
+    if (fs::path(generic).filename() == "package.json") {
+        std::string root = fs::path(generic).parent_path().generic_string();
+        packageCache_.erase(root);
+        packageCache_.erase(fs::path(root).string());
     }
-    std::error_code ec;
-    return fs::exists(path, ec) && fs::is_regular_file(path, ec);
+
+    for (auto it = statCache_.begin(); it != statCache_.end();) {
+        if (it->second == PathKind::Missing) {
+            it = statCache_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    resolveCache_.clear();
+    nearestPackageCache_.clear();
+}
+
+void ModuleResolver::clearCaches() {
+    resolveCache_.clear();
+    statCache_.clear();
+    packageCache_.clear();
+    nearestPackageCache_.clear();
+}
+
+bool ModuleResolver::fileExists(const std::string& path) const {
+    return pathKind(path) == PathKind::File;
 }
 
 bool ModuleResolver::dirExists(const std::string& path) const {
@@ -591,8 +687,7 @@ bool ModuleResolver::dirExists(const std::string& path) const {
         std::string indexCjs = (fs::path(path) / "index.cjs").string();
         return fileExists(indexJs) || fileExists(indexMjs) || fileExists(indexCjs);
     }
-    std::error_code ec;
-    return fs::exists(path, ec) && fs::is_directory(path, ec);
+    return pathKind(path) == PathKind::Directory;
 }
 
 bool ModuleResolver::resolveExportsTarget(const JsonValue& exportsValue,
@@ -1,18 +1,22 @@
 #include "mystral/js/module_system.h"
 
+#include "mystral/debug/trace.h"
+#include "mystral/jobs/job_system.h"
+#include "mystral/js/esm_lexer.h"
 #include "mystral/js/ts_transpiler.h"
 
 #include <cctype>
 #include <iostream>
-#include <regex>
-#include <sstream>
+#include <utility>
+#include <vector>
 
 namespace mystral {
 namespace js {
 
 namespace {
 
-ModuleSystem* g_moduleSystem = nullptr;
+// Thread-local: module loading is owned by the main engine; worker engines see nullptr
+thread_local ModuleSystem* g_moduleSystem = nullptr;
 
 bool startsWith(const std::string& value, const std::string& prefix) {
     return value.rfind(prefix, 0) == 0;
@@ -27,49 +31,6 @@ bool isTypeScriptPath(const std::string& path) {
     return ext == ".ts" || ext == ".tsx" || ext == ".mts" || ext == ".cts";
 }
 
-std::string trimLeft(const std::string& value) {
-    size_t start = 0;
-    while (start < value.size() && std::isspace(static_cast<unsigned char>(value[start]))) {
-        start++;
-    }
-    return value.substr(start);
-}
-
-std::vector<std::string> splitCommaSeparated(const std::string& value) {
-    std::vector<std::string> parts;
-    std::string current;
-    int depth = 0;
-    for (char c : value) {
-        if (c == '{' || c == '[' || c == '(') {
-            depth++;
-        } else if (c == '}' || c == ']' || c == ')') {
-            depth--;
-        }
-        if (c == ',' && depth == 0) {
-            parts.push_back(current);
-            current.clear();
-        } else {
-            current.push_back(c);
-        }
-    }
-    if (!current.empty()) {
-        parts.push_back(current);
-    }
-    return parts;
-}
-
-std::string trim(const std::string& value) {
-    size_t start = 0;
-    while (start < value.size() && std::isspace(static_cast<unsigned char>(value[start]))) {
-        start++;
-    }
-    size_t end = value.size();
-    while (end > start && std::isspace(static_cast<unsigned char>(value[end - 1]))) {
-        end--;
-    }
-    return value.substr(start, end - start);
-}
-
 }  // namespace
 
 ModuleSystem* getModuleSystem() {
@@ -113,15 +74,27 @@ bool ModuleSystem::loadEntry(const std::string& entryPath) {
 
     loadedPaths_.insert(resolved.resolved.path);
 
+    prefetch(resolved);
+    bool loaded = loadEntryModule(resolved);
+    // Anything the entry didn't load is read again if a later require() wants it
+    prefetched_.clear();
+    return loaded;
+}
+
+bool ModuleSystem::loadEntryModule(const ResolvedModule& resolved) {
+    modules_[resolved.resolved.path] = resolved;
     std::string source;
-    if (!resolver_.readFile(resolved.resolved, source, error)) {
-        std::cerr << "[Modules] Failed to read entry: " << error << std::endl;
-        return false;
-    }
+    std::string error;
+    if (!takePrefetched(resolved, source)) {
+        if (!resolver_.readFile(resolved.resolved, source, error)) {
+            std::cerr << "[Modules] Failed to read entry: " << error << std::endl;
+            return false;
+        }
 
-    if (!maybeTranspileTypeScript(resolved, source, error)) {
-        std::cerr << "[Modules] Failed to transpile TypeScript: " << error << std::endl;
-        return false;
+        if (!maybeTranspileTypeScript(resolved, source, error)) {
+            std::cerr << "[Modules] Failed to transpile TypeScript: " << error << std::endl;
+            return false;
+        }
     }
 
     if (resolved.format == ModuleFormat::ESM) {
@@ -162,53 +135,52 @@ JSValueHandle ModuleSystem::require(const std::string& specifier, const std::str
         engine_->throwException(error.c_str());
         return engine_->newUndefined();
     }
+    recordDependency(referrer, resolved.resolved.path);
 
-    if (resolved.format == ModuleFormat::ESM) {
-        // JSC and QuickJS don't have native ESM support in eval(), so transpile to CJS.
-        if (engine_->getType() == EngineType::JavaScriptCore ||
-            engine_->getType() == EngineType::QuickJS) {
-            std::string source;
-            if (!resolver_.readFile(resolved.resolved, source, error)) {
-                std::cerr << "[Modules] Failed to read module: " << error << std::endl;
-                engine_->throwException(error.c_str());
-                return engine_->newUndefined();
-            }
-            if (!maybeTranspileTypeScript(resolved, source, error)) {
-                std::cerr << "[Modules] Failed to transpile TypeScript: " << error << std::endl;
-                engine_->throwException(error.c_str());
-                return engine_->newUndefined();
-            }
-            std::string cjs = transpileEsmToCjs(source);
-            ResolvedModule cjsModule = resolved;
-            cjsModule.format = ModuleFormat::CJS;
-            loadedPaths_.insert(resolved.resolved.path);
-            return executeCjsModule(cjsModule, cjs, false);
-        }
-        std::string message = "Cannot require ES module: " + resolved.resolved.path;
-        std::cerr << "[Modules] " << message << std::endl;
-        engine_->throwException(message.c_str());
+    JSValueHandle exports = loadModule(resolved, error);
+    if (!error.empty()) {
+        engine_->throwException(error.c_str());
         return engine_->newUndefined();
     }
-
-    loadedPaths_.insert(resolved.resolved.path);
-    return requireResolved(resolved);
+    return exports;
 }
 
-JSValueHandle ModuleSystem::requireResolved(const ResolvedModule& resolved) {
-    std::string error;
-    std::string source;
-    if (!resolver_.readFile(resolved.resolved, source, error)) {
-        std::cerr << "[Modules] Failed to read module: " << error << std::endl;
-        engine_->throwException(error.c_str());
-        return engine_->newUndefined();
+JSValueHandle ModuleSystem::loadModule(const ResolvedModule& resolved, std::string& error) {
+    error.clear();
+    auto cached = cjsCache_.find(resolved.resolved.path);
+    if (cached != cjsCache_.end()) {
+        return cached->second;
     }
 
-    if (!maybeTranspileTypeScript(resolved, source, error)) {
-        std::cerr << "[Modules] Failed to transpile TypeScript: " << error << std::endl;
-        engine_->throwException(error.c_str());
+    bool esm = resolved.format == ModuleFormat::ESM;
+    if (esm && engine_->getType() != EngineType::JavaScriptCore &&
+        engine_->getType() != EngineType::QuickJS) {
+        error = "Cannot require ES module: " + resolved.resolved.path;
+        std::cerr << "[Modules] " << error << std::endl;
         return engine_->newUndefined();
     }
 
+    loadedPaths_.insert(resolved.resolved.path);
+    modules_[resolved.resolved.path] = resolved;
+
+    std::string source;
+    if (!takePrefetched(resolved, source)) {
+        if (!resolver_.readFile(resolved.resolved, source, error)) {
+            std::cerr << "[Modules] Failed to read module: " << error << std::endl;
+            return engine_->newUndefined();
+        }
+        if (!maybeTranspileTypeScript(resolved, source, error)) {
+            std::cerr << "[Modules] Failed to transpile TypeScript: " << error << std::endl;
+            return engine_->newUndefined();
+        }
+    }
+
+    if (esm) {
+        // JSC and QuickJS don't have native ESM support in eval(), so transpile to CJS.
+        ResolvedModule cjsModule = resolved;
+        cjsModule.format = ModuleFormat::CJS;
+        return executeCjsModule(cjsModule, transpileEsmToCjs(source), false);
+    }
     return executeCjsModule(resolved, source, resolved.format == ModuleFormat::JSON);
 }
 
@@ -238,6 +210,13 @@ JSValueHandle ModuleSystem::executeCjsModule(const ResolvedModule& resolved,
     JSValueHandle exportsObj = engine_->newObject();
     JSValueHandle moduleObj = engine_->newObject();
     engine_->setProperty(moduleObj, "exports", exportsObj);
+    if (hotUpdatesEnabled_) {
+        JSValueHandle hot = createHotContext(resolved.resolved.path);
+        if (hot.ptr) {
+            engine_->setProperty(moduleObj, "hot", hot);
+        }
+    }
+    moduleExecutions_++;
 
     engine_->protect(exportsObj);
     cjsCache_[resolved.resolved.path] = exportsObj;
@@ -301,7 +280,11 @@ bool ModuleSystem::resolveForImport(const std::string& specifier,
                                     const std::string& referrer,
                                     ResolvedModule& out,
                                     std::string& error) {
-    return resolver_.resolve(specifier, referrer, ResolveMode::Import, out, error);
+    if (!resolver_.resolve(specifier, referrer, ResolveMode::Import, out, error)) {
+        return false;
+    }
+    recordDependency(referrer, out.resolved.path);
+    return true;
 }
 
 bool ModuleSystem::getEsmSource(const ResolvedModule& resolved,
@@ -314,11 +297,13 @@ bool ModuleSystem::getEsmSource(const ResolvedModule& resolved,
     (void)referrer;
 
     if (resolved.format == ModuleFormat::ESM) {
-        if (!resolver_.readFile(resolved.resolved, outSource, error)) {
-            return false;
-        }
-        if (!maybeTranspileTypeScript(resolved, outSource, error)) {
-            return false;
+        if (!takePrefetched(resolved, outSource)) {
+            if (!resolver_.readFile(resolved.resolved, outSource, error)) {
+                return false;
+            }
+            if (!maybeTranspileTypeScript(resolved, outSource, error)) {
+                return false;
+            }
         }
         outFilename = resolved.resolved.path;
         loadedPaths_.insert(resolved.resolved.path);
@@ -398,181 +383,477 @@ std::string ModuleSystem::escapeJsString(const std::string& input) const {
 }
 
 std::string ModuleSystem::transpileEsmToCjs(const std::string& source) const {
-    std::istringstream input(source);
-    std::ostringstream output;
-    bool usesExports = false;
-
-    std::string line;
-    while (std::getline(input, line)) {
-        std::string trimmed = trimLeft(line);
-
-        std::smatch match;
-        std::regex importDefault(R"(^import\s+([A-Za-z_$][\w$]*)\s+from\s+['"]([^'"]+)['"]\s*;?\s*$)");
-        std::regex importAll(R"(^import\s+\*\s+as\s+([A-Za-z_$][\w$]*)\s+from\s+['"]([^'"]+)['"]\s*;?\s*$)");
-        std::regex importNamed(R"(^import\s+\{([^}]+)\}\s+from\s+['"]([^'"]+)['"]\s*;?\s*$)");
-        std::regex importMixed(R"(^import\s+([A-Za-z_$][\w$]*)\s*,\s*\{([^}]+)\}\s+from\s+['"]([^'"]+)['"]\s*;?\s*$)");
-        std::regex importMixedAll(R"(^import\s+([A-Za-z_$][\w$]*)\s*,\s*\*\s+as\s+([A-Za-z_$][\w$]*)\s+from\s+['"]([^'"]+)['"]\s*;?\s*$)");
-        std::regex importSideEffect(R"(^import\s+['"]([^'"]+)['"]\s*;?\s*$)");
-
-        if (std::regex_match(trimmed, match, importMixed)) {
-            std::string defaultName = match[1];
-            std::string namedList = trim(match[2]);
-            std::string spec = match[3];
-            output << "const __mod = require(\"" << spec << "\");\n";
-            output << "const " << defaultName << " = (__mod && __mod.__esModule) ? __mod.default : __mod;\n";
-            output << "const { " << namedList << " } = __mod;\n";
-            continue;
+    return transformEsmToCjs(source);
+}
+
+bool ModuleSystem::maybeTranspileTypeScript(const ResolvedModule& resolved,
+                                            std::string& source,
+                                            std::string& error) {
+    if (!isTypeScriptPath(resolved.resolved.path)) {
+        return true;
+    }
+
+    if (!isTypeScriptTranspilerAvailable()) {
+        error = "TypeScript support is not enabled (missing SWC)";
+        return false;
+    }
+
+    TranspileCache::Entry cached;
+    if (transpileCache_.lookup(resolved.resolved.path, source, cached)) {
+        source.swap(cached.code);
+        return true;
+    }
+
+    TranspileCache::Entry transpiled;
+    if (!transpileTypeScript(source, resolved.resolved.path, transpiled.code, error, &transpiled.map)) {
+        if (error.empty()) {
+            error = "TypeScript transpile failed";
         }
-        if (std::regex_match(trimmed, match, importMixedAll)) {
-            std::string defaultName = match[1];
-            std::string nsName = match[2];
-            std::string spec = match[3];
-            output << "const __mod = require(\"" << spec << "\");\n";
-            output << "const " << defaultName << " = (__mod && __mod.__esModule) ? __mod.default : __mod;\n";
-            output << "const " << nsName << " = __mod;\n";
-            continue;
+        return false;
+    }
+
+    transpileCache_.store(resolved.resolved.path, source, transpiled);
+    source.swap(transpiled.code);
+    return true;
+}
+
+// ============================================================================
+// Hot updates
+//
+// Every module run through executeCjsModule() gets a module.hot context
+// (import.meta.hot after the ESM transform) from a small JS runtime:
+//   hot.accept()                  this module can be re-run in place
+//   hot.accept(cb)                ... and cb(newExports) runs afterwards
+//   hot.accept(dep(s), cb)        updates to these imports stop here; cb gets
+//                                 the new exports (an array for an array of deps)
+//   hot.dispose(cb)               cb(data) runs before the module is replaced;
+//                                 the next instance sees it as hot.data
+//   hot.decline()                 updates to this module need a full reload
+// An update walks from each changed module up through its importers until
+// every path ends at a module that accepts it; all modules on the way are
+// disposed, dropped from the cache and re-run by re-requiring the accepting
+// modules. Reaching a module without importers (the entry) or one that can't
+// be re-run (a V8 ES module) means a full reload.
+// ============================================================================
+
+namespace {
+
+const char* kHotRuntimeSource = R"(
+(function() {
+    function HotContext(data) {
+        this.data = data;
+        this._self = false;
+        this._selfCallback = null;
+        this._deps = [];
+        this._dispose = [];
+        this._declined = false;
+    }
+    HotContext.prototype.accept = function(deps, callback) {
+        if (deps === undefined || typeof deps === 'function') {
+            this._self = true;
+            this._selfCallback = deps || null;
+            return;
         }
-        if (std::regex_match(trimmed, match, importDefault)) {
-            std::string defaultName = match[1];
-            std::string spec = match[2];
-            output << "const __mod = require(\"" << spec << "\");\n";
-            output << "const " << defaultName << " = (__mod && __mod.__esModule) ? __mod.default : __mod;\n";
-            continue;
+        var single = !Array.isArray(deps);
+        this._deps.push({ deps: single ? [deps] : deps.slice(), single: single, callback: callback || null });
+    };
+    HotContext.prototype.dispose = function(callback) {
+        this._dispose.push(callback);
+    };
+    HotContext.prototype.decline = function() {
+        this._declined = true;
+    };
+
+    function report(e) {
+        console.error('[HotReload] ' + (e && e.stack ? e.stack : e));
+    }
+
+    return {
+        create: function(data) {
+            return new HotContext(data || {});
+        },
+        // 0 = not accepted, 1 = accepts itself, 2 = declined
+        state: function(hot) {
+            return hot._declined ? 2 : (hot._self ? 1 : 0);
+        },
+        acceptedDeps: function(hot) {
+            var out = [];
+            hot._deps.forEach(function(entry) { out.push.apply(out, entry.deps); });
+            return out;
+        },
+        dispose: function(hot) {
+            var data = {};
+            hot._dispose.forEach(function(callback) {
+                try { callback(data); } catch (e) { report(e); }
+            });
+            return data;
+        },
+        acceptSelf: function(hot, exports) {
+            if (!hot._selfCallback) return;
+            try { hot._selfCallback(exports); } catch (e) { report(e); }
+        },
+        acceptDep: function(hot, specifier, exports) {
+            hot._deps.forEach(function(entry) {
+                var index = entry.deps.indexOf(specifier);
+                if (index < 0 || !entry.callback) return;
+                var arg = entry.single ? exports : entry.deps.map(function(dep, i) {
+                    return i === index ? exports : undefined;
+                });
+                try { entry.callback(arg); } catch (e) { report(e); }
+            });
         }
-        if (std::regex_match(trimmed, match, importAll)) {
-            std::string nsName = match[1];
-            std::string spec = match[2];
-            output << "const " << nsName << " = require(\"" << spec << "\");\n";
-            continue;
+    };
+})()
+)";
+
+enum HotState {
+    kHotNotAccepted = 0,
+    kHotSelfAccepting = 1,
+    kHotDeclined = 2,
+};
+
+}  // namespace
+
+void ModuleSystem::setHotUpdatesEnabled(bool enabled) {
+    hotUpdatesEnabled_ = enabled;
+}
+
+void ModuleSystem::recordDependency(const std::string& importer, const std::string& dependency) {
+    if (importer.empty() || importer == dependency) {
+        return;
+    }
+    importers_[dependency].insert(importer);
+    dependencies_[importer].insert(dependency);
+}
+
+void ModuleSystem::forgetDependencies(const std::string& importer) {
+    auto deps = dependencies_.find(importer);
+    if (deps == dependencies_.end()) {
+        return;
+    }
+    for (const auto& dependency : deps->second) {
+        auto importers = importers_.find(dependency);
+        if (importers != importers_.end()) {
+            importers->second.erase(importer);
         }
-        if (std::regex_match(trimmed, match, importNamed)) {
-            std::string namedList = trim(match[1]);
-            std::string spec = match[2];
-            output << "const { " << namedList << " } = require(\"" << spec << "\");\n";
-            continue;
+    }
+    dependencies_.erase(deps);
+}
+
+JSValueHandle ModuleSystem::callHotRuntime(const char* method, const std::vector<JSValueHandle>& args) {
+    if (!hotRuntime_.ptr) {
+        hotRuntime_ = engine_->evalScriptWithResult(kHotRuntimeSource, "hot-runtime.js");
+        if (!hotRuntime_.ptr) {
+            return {};
         }
-        if (std::regex_match(trimmed, match, importSideEffect)) {
-            std::string spec = match[1];
-            output << "require(\"" << spec << "\");\n";
-            continue;
+        engine_->protect(hotRuntime_);
+    }
+    JSValueHandle fn = engine_->getProperty(hotRuntime_, method);
+    if (!fn.ptr) {
+        return {};
+    }
+    JSValueHandle undefinedThis = engine_->newUndefined();
+    JSValueHandle result = engine_->call(fn, undefinedThis, args);
+    engine_->releaseHandle(undefinedThis);
+    engine_->releaseHandle(fn);
+    return result;
+}
+
+JSValueHandle ModuleSystem::createHotContext(const std::string& path) {
+    JSValueHandle data;
+    auto saved = hotData_.find(path);
+    bool hasSavedData = saved != hotData_.end();
+    if (hasSavedData) {
+        data = saved->second;
+        hotData_.erase(saved);
+    } else {
+        data = engine_->newUndefined();
+    }
+
+    JSValueHandle hot = callHotRuntime("create", {data});
+    // The context holds on to data from here
+    if (hasSavedData) {
+        engine_->unprotect(data);
+    } else {
+        engine_->releaseHandle(data);
+    }
+    if (!hot.ptr) {
+        return {};
+    }
+
+    engine_->protect(hot);
+    auto existing = hotContexts_.find(path);
+    if (existing != hotContexts_.end()) {
+        engine_->unprotect(existing->second);
+    }
+    hotContexts_[path] = hot;
+    return hot;
+}
+
+bool ModuleSystem::acceptsDependency(const std::string& importer,
+                                     const std::string& dependency,
+                                     std::string& outSpecifier) {
+    auto hot = hotContexts_.find(importer);
+    if (hot == hotContexts_.end()) {
+        return false;
+    }
+
+    JSValueHandle deps = callHotRuntime("acceptedDeps", {hot->second});
+    if (!deps.ptr) {
+        return false;
+    }
+    JSValueHandle length = engine_->getProperty(deps, "length");
+    size_t count = static_cast<size_t>(engine_->toNumber(length));
+    engine_->releaseHandle(length);
+    bool accepted = false;
+    for (size_t i = 0; i < count && !accepted; i++) {
+        JSValueHandle item = engine_->getPropertyIndex(deps, static_cast<uint32_t>(i));
+        std::string specifier = engine_->toString(item);
+        engine_->releaseHandle(item);
+        ResolvedModule resolved;
+        std::string error;
+        // Modules with hot contexts run as CommonJS: their imports went through require()
+        if (resolver_.resolve(specifier, importer, ResolveMode::Require, resolved, error) &&
+            resolved.resolved.path == dependency) {
+            outSpecifier = specifier;
+            accepted = true;
         }
+    }
+    engine_->releaseHandle(deps);
+    return accepted;
+}
 
-        std::regex exportDefaultFunc(R"(^export\s+default\s+function\s+([A-Za-z_$][\w$]*)\s*\()");
-        std::regex exportDefaultClass(R"(^export\s+default\s+class\s+([A-Za-z_$][\w$]*)\s*)");
-        std::regex exportDefault(R"(^export\s+default\s+(.+);?\s*$)");
-        std::regex exportNamedDecl(R"(^export\s+(const|let|var|function|class)\s+([A-Za-z_$][\w$]*)\s*)");
-        std::regex exportNamedList(R"(^export\s+\{([^}]+)\}\s*;?\s*$)");
-        std::regex exportNamedFrom(R"(^export\s+\{([^}]+)\}\s+from\s+['"]([^'"]+)['"]\s*;?\s*$)");
-        std::regex exportAllFrom(R"(^export\s+\*\s+from\s+['"]([^'"]+)['"]\s*;?\s*$)");
+HotUpdateResult ModuleSystem::applyHotUpdate(const std::vector<std::string>& changedPaths) {
+    HotUpdateResult result;
+    if (!engine_) {
+        return result;
+    }
 
-        if (std::regex_search(trimmed, match, exportDefaultFunc)) {
-            usesExports = true;
-            line = std::regex_replace(line, std::regex("^\\s*export\\s+default\\s+"), "");
-            output << line << "\n";
-            output << "exports.default = " << match[1] << ";\n";
-            continue;
+    std::vector<std::string> queue;
+    for (const auto& path : changedPaths) {
+        if (loadedPaths_.count(path) > 0) {
+            queue.push_back(path);
         }
-        if (std::regex_search(trimmed, match, exportDefaultClass)) {
-            usesExports = true;
-            line = std::regex_replace(line, std::regex("^\\s*export\\s+default\\s+"), "");
-            output << line << "\n";
-            output << "exports.default = " << match[1] << ";\n";
+    }
+    if (queue.empty()) {
+        return result;
+    }
+
+    auto fullReload = [&result](const std::string& reason) {
+        result.kind = HotUpdateResult::Kind::FullReload;
+        result.reason = reason;
+        return result;
+    };
+
+    struct DependencyAccept {
+        std::string importer;
+        std::string specifier;
+        std::string module;
+    };
+
+    // Find the accepting modules; everything walked through is invalidated
+    std::unordered_set<std::string> invalidated;
+    std::vector<std::string> selfAccepting;
+    std::vector<DependencyAccept> dependencyAccepting;
+    while (!queue.empty()) {
+        std::string path = std::move(queue.back());
+        queue.pop_back();
+        if (!invalidated.insert(path).second) {
             continue;
         }
-        if (std::regex_match(trimmed, match, exportNamedFrom)) {
-            usesExports = true;
-            std::string list = trim(match[1]);
-            std::string spec = match[2];
-            output << "const __mod = require(\"" << spec << "\");\n";
-            for (const auto& part : splitCommaSeparated(list)) {
-                std::string item = trim(part);
-                size_t asPos = item.find(" as ");
-                if (asPos != std::string::npos) {
-                    std::string left = trim(item.substr(0, asPos));
-                    std::string right = trim(item.substr(asPos + 4));
-                    if (left == "default") {
-                        output << "exports." << right << " = (__mod && __mod.__esModule) ? __mod.default : __mod;\n";
-                    } else {
-                        output << "exports." << right << " = __mod." << left << ";\n";
-                    }
-                } else {
-                    output << "exports." << item << " = __mod." << item << ";\n";
-                }
-            }
-            continue;
+
+        auto hot = hotContexts_.find(path);
+        if (hot == hotContexts_.end()) {
+            return fullReload(path + " can't be updated in place");
+        }
+        JSValueHandle state = callHotRuntime("state", {hot->second});
+        int hotState = state.ptr ? static_cast<int>(engine_->toNumber(state)) : kHotNotAccepted;
+        engine_->releaseHandle(state);
+        if (hotState == kHotDeclined) {
+            return fullReload(path + " declines hot updates");
         }
-        if (std::regex_match(trimmed, match, exportAllFrom)) {
-            usesExports = true;
-            std::string spec = match[1];
-            output << "Object.assign(exports, require(\"" << spec << "\"));\n";
+        if (hotState == kHotSelfAccepting) {
+            selfAccepting.push_back(path);
             continue;
         }
-        if (std::regex_match(trimmed, match, exportNamedList)) {
-            usesExports = true;
-            std::string list = trim(match[1]);
-            for (const auto& part : splitCommaSeparated(list)) {
-                std::string item = trim(part);
-                size_t asPos = item.find(" as ");
-                if (asPos != std::string::npos) {
-                    std::string left = trim(item.substr(0, asPos));
-                    std::string right = trim(item.substr(asPos + 4));
-                    output << "exports." << right << " = " << left << ";\n";
-                } else {
-                    output << "exports." << item << " = " << item << ";\n";
-                }
+
+        auto importers = importers_.find(path);
+        if (importers == importers_.end() || importers->second.empty()) {
+            return fullReload("no module accepts the update to " + path);
+        }
+        for (const auto& importer : importers->second) {
+            std::string specifier;
+            if (acceptsDependency(importer, path, specifier)) {
+                dependencyAccepting.push_back({importer, specifier, path});
+            } else {
+                queue.push_back(importer);
             }
-            continue;
         }
-        if (std::regex_search(trimmed, match, exportNamedDecl)) {
-            usesExports = true;
-            line = std::regex_replace(line, std::regex("^\\s*export\\s+"), "");
-            output << line << "\n";
-            output << "exports." << match[2] << " = " << match[2] << ";\n";
+    }
+
+    // Dispose everything first, so no re-run module sees a stale dependency
+    std::unordered_map<std::string, JSValueHandle> oldContexts;
+    for (const auto& path : invalidated) {
+        auto hot = hotContexts_.find(path);
+        JSValueHandle data = callHotRuntime("dispose", {hot->second});
+        if (data.ptr) {
+            engine_->protect(data);
+            hotData_[path] = data;
+        }
+        oldContexts[path] = hot->second;
+        hotContexts_.erase(hot);
+
+        auto cached = cjsCache_.find(path);
+        if (cached != cjsCache_.end()) {
+            engine_->unprotect(cached->second);
+            cjsCache_.erase(cached);
+        }
+        forgetDependencies(path);
+    }
+
+    size_t executionsBefore = moduleExecutions_;
+    std::string error;
+    for (const auto& path : selfAccepting) {
+        JSValueHandle exports = loadModule(modules_[path], error);
+        if (!error.empty() || !cjsCache_.count(path)) {
+            std::cerr << "[HotReload] Failed to update " << path << std::endl;
             continue;
         }
-        if (std::regex_match(trimmed, match, exportDefault)) {
-            usesExports = true;
-            output << "exports.default = " << match[1] << ";\n";
+        JSValueHandle done = callHotRuntime("acceptSelf", {oldContexts[path], exports});
+        engine_->releaseHandle(done);
+    }
+    for (const auto& accept : dependencyAccepting) {
+        auto hot = hotContexts_.find(accept.importer);
+        if (invalidated.count(accept.importer) > 0 || hot == hotContexts_.end()) {
+            continue;  // The importer was re-run itself and required the new module
+        }
+        JSValueHandle exports = loadModule(modules_[accept.module], error);
+        if (!error.empty() || !cjsCache_.count(accept.module)) {
+            std::cerr << "[HotReload] Failed to update " << accept.module << std::endl;
             continue;
         }
-
-        output << line << "\n";
+        recordDependency(accept.importer, accept.module);
+        JSValueHandle specifier = engine_->newString(accept.specifier.c_str());
+        JSValueHandle done = callHotRuntime("acceptDep", {hot->second, specifier, exports});
+        engine_->releaseHandle(done);
+        engine_->releaseHandle(specifier);
     }
 
-    if (usesExports) {
-        std::ostringstream finalOut;
-        finalOut << "exports.__esModule = true;\n";
-        finalOut << output.str();
-        return finalOut.str();
+    for (auto& entry : oldContexts) {
+        engine_->unprotect(entry.second);
     }
 
-    return output.str();
+    result.kind = HotUpdateResult::Kind::Applied;
+    result.modulesReevaluated = moduleExecutions_ - executionsBefore;
+    return result;
 }
 
-bool ModuleSystem::maybeTranspileTypeScript(const ResolvedModule& resolved,
-                                            std::string& source,
-                                            std::string& error) {
-    if (!isTypeScriptPath(resolved.resolved.path)) {
-        return true;
+// ============================================================================
+// Prefetch
+//
+// Before the entry is evaluated, the import graph is walked breadth first:
+// each wave of newly found modules is read, transpiled (TypeScript) and
+// scanned for static import/export/require() specifiers on the job pool,
+// then the main thread resolves the specifiers into the next wave. Only
+// sources are prepared - evaluation still happens in the order the engine
+// asks for modules. Specifiers that fail to resolve or files that fail to
+// read are skipped here and reported by the normal load path.
+// ============================================================================
+
+struct ModuleSystem::PrefetchTask {
+    ResolvedModule module;
+    std::string source;
+    bool ok = false;
+    std::vector<std::pair<std::string, ResolveMode>> dependencies;
+};
+
+void ModuleSystem::prefetch(const ResolvedModule& entry) {
+    MYSTRAL_TRACE_SCOPE_CAT("modules.prefetch", "modules");
+    prefetched_.clear();
+    prefetchStats_ = {};
+    uint64_t start = debug::trace::nowNs();
+
+    std::unordered_set<std::string> seen;
+    seen.insert(entry.resolved.path);
+    std::vector<PrefetchTask> wave(1);
+    wave[0].module = entry;
+
+    auto& jobs = jobs::JobSystem::instance();
+    while (!wave.empty()) {
+        jobs.parallelFor(wave.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                prefetchModule(wave[i]);
+            }
+        });
+        prefetchStats_.waves++;
+
+        std::vector<PrefetchTask> nextWave;
+        for (auto& task : wave) {
+            if (!task.ok) {
+                continue;
+            }
+            for (const auto& dependency : task.dependencies) {
+                PrefetchTask next;
+                std::string error;
+                if (!resolver_.resolve(dependency.first, task.module.resolved.path, dependency.second,
+                                       next.module, error)) {
+                    continue;  // Builtin or missing; the load path reports it if it matters
+                }
+                if (seen.insert(next.module.resolved.path).second) {
+                    nextWave.push_back(std::move(next));
+                }
+            }
+            prefetched_[task.module.resolved.path] = std::move(task.source);
+            prefetchStats_.modules++;
+        }
+        wave.swap(nextWave);
     }
 
-    if (!isTypeScriptTranspilerAvailable()) {
-        error = "TypeScript support is not enabled (missing SWC)";
-        return false;
+    prefetchStats_.elapsedMs = (debug::trace::nowNs() - start) / 1e6;
+}
+
+// Runs on a job thread: touches only the task, the resolver's file reads and
+// the (thread-safe) transpile cache
+void ModuleSystem::prefetchModule(PrefetchTask& task) {
+    MYSTRAL_TRACE_SCOPE_CAT("modules.prefetchModule", "modules");
+    std::string error;
+    if (!resolver_.readFile(task.module.resolved, task.source, error) ||
+        !maybeTranspileTypeScript(task.module, task.source, error)) {
+        return;
     }
+    task.ok = true;
 
-    std::string outJs;
-    if (!transpileTypeScript(source, resolved.resolved.path, outJs, error)) {
-        if (error.empty()) {
-            error = "TypeScript transpile failed";
+    if (task.module.format == ModuleFormat::JSON) {
+        return;
+    }
+    EsmScanResult scan = scanEsm(task.source);
+    if (task.module.format == ModuleFormat::ESM) {
+        for (const auto& statement : scan.statements) {
+            if (!statement.specifierLiteral.empty()) {
+                task.dependencies.emplace_back(statement.specifier, ResolveMode::Import);
+            }
+        }
+    } else {
+        for (const auto& specifier : scan.requireCalls) {
+            task.dependencies.emplace_back(specifier, ResolveMode::Require);
         }
-        return false;
     }
+}
 
-    source.swap(outJs);
+bool ModuleSystem::takePrefetched(const ResolvedModule& resolved, std::string& source) {
+    auto it = prefetched_.find(resolved.resolved.path);
+    if (it == prefetched_.end()) {
+        return false;
+    }
+    source.swap(it->second);
+    prefetched_.erase(it);
     return true;
 }
 
+const ModulePrefetchStats& ModuleSystem::prefetchStats() const {
+    return prefetchStats_;
+}
+
 const std::unordered_set<std::string>& ModuleSystem::loadedPaths() const {
     return loadedPaths_;
 }
@@ -584,11 +865,32 @@ void ModuleSystem::clearCaches() {
     cjsCache_.clear();
     loading_.clear();
     loadedPaths_.clear();
+    prefetched_.clear();
+
+    for (auto& entry : hotContexts_) {
+        engine_->unprotect(entry.second);
+    }
+    hotContexts_.clear();
+    for (auto& entry : hotData_) {
+        engine_->unprotect(entry.second);
+    }
+    hotData_.clear();
+    if (hotRuntime_.ptr) {
+        engine_->unprotect(hotRuntime_);
+        hotRuntime_ = {};
+    }
+    importers_.clear();
+    dependencies_.clear();
+    modules_.clear();
 }
 
 ModuleResolver& ModuleSystem::resolver() {
     return resolver_;
 }
 
+TranspileCache& ModuleSystem::transpileCache() {
+    return transpileCache_;
+}
+
 }  // namespace js
 }  // namespace mystral
@@ -10,10 +10,18 @@
 #include <iostream>
 #include <unordered_map>
 #include <unordered_set>
+#include <atomic>
 #include <chrono>
+#include <cstdlib>
 #include <cstring>
 #include <sstream>
 
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
 #ifdef __ANDROID__
 #include <android/log.h>
 #define ANDROID_LOG_TAG "MystralJS"
@@ -35,10 +43,105 @@ namespace mystral {
 namespace js {
 
 // Store native function callbacks
-static std::unordered_map<JSValue*, NativeFunction> g_nativeFunctions;
+// Thread-local: worker threads run their own engine (see workers::WorkerThread)
+static thread_local std::unordered_map<JSValue*, NativeFunction> g_nativeFunctions;
+
+// Set of protected handles that should not be deleted by nativeCallback cleanup
+// Thread-local so a worker engine's teardown never touches the main engine's handles
+static thread_local std::unordered_set<void*> g_protectedHandles;
+
+// ArrayBuffers created from a BackingStore on this thread, keyed by data pointer.
+// Lets detachArrayBuffer() hand the same store on again (round trips stay zero-copy).
+static thread_local std::unordered_map<void*, std::weak_ptr<BackingStore>> g_adoptedStores;
+
+// SharedArrayBuffer memory is allocated with a refcount header so every
+// runtime (main thread and workers) can wrap the same block. QuickJS calls
+// sab_dup/sab_free as wrappers are created and finalized.
+struct SharedBlockHeader {
+    std::atomic<int> refCount;
+};
+static constexpr size_t kSharedBlockHeaderSize = 16;  // Keeps data 16-byte aligned
+
+static SharedBlockHeader* sharedBlockHeader(void* data) {
+    return reinterpret_cast<SharedBlockHeader*>(static_cast<uint8_t*>(data) - kSharedBlockHeaderSize);
+}
+
+static void* quickjsSabAlloc(void* opaque, size_t size) {
+    (void)opaque;
+    void* block = std::calloc(1, kSharedBlockHeaderSize + size);
+    if (!block) return nullptr;
+    new (block) SharedBlockHeader{{1}};
+    return static_cast<uint8_t*>(block) + kSharedBlockHeaderSize;
+}
+
+static void quickjsSabFree(void* opaque, void* ptr) {
+    (void)opaque;
+    SharedBlockHeader* header = sharedBlockHeader(ptr);
+    if (header->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        header->~SharedBlockHeader();
+        std::free(header);
+    }
+}
+
+static void quickjsSabDup(void* opaque, void* ptr) {
+    (void)opaque;
+    sharedBlockHeader(ptr)->refCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+static void quickjsReleaseStore(JSRuntime* rt, void* opaque, void* ptr) {
+    (void)rt;
+    auto* holder = static_cast<std::shared_ptr<BackingStore>*>(opaque);
+    auto it = g_adoptedStores.find(ptr);
+    if (it != g_adoptedStores.end() && it->second.lock() == *holder) {
+        g_adoptedStores.erase(it);
+    }
+    delete holder;
+}
+
+// The runtime allocates through the C heap so a detached ArrayBuffer's memory
+// can leave QuickJS as-is: detachArrayBuffer() names the block in
+// g_stealPointer, and the free QuickJS issues for it during the detach is
+// skipped. The BackingStore then owns the block and std::free()s it.
+static thread_local void* g_stealPointer = nullptr;
+static thread_local bool g_stolen = false;
 
-// Global set of protected handles that should not be deleted by nativeCallback cleanup
-static std::unordered_set<void*> g_protectedHandles;
+static void* quickjsCalloc(void* opaque, size_t count, size_t size) {
+    (void)opaque;
+    return std::calloc(count, size);
+}
+
+static void* quickjsMalloc(void* opaque, size_t size) {
+    (void)opaque;
+    return std::malloc(size);
+}
+
+static void quickjsFree(void* opaque, void* ptr) {
+    (void)opaque;
+    if (ptr && ptr == g_stealPointer) {
+        g_stolen = true;
+        return;
+    }
+    std::free(ptr);
+}
+
+static void* quickjsRealloc(void* opaque, void* ptr, size_t size) {
+    (void)opaque;
+    return std::realloc(ptr, size);
+}
+
+static size_t quickjsMallocUsableSize(const void* ptr) {
+#if defined(__APPLE__)
+    return malloc_size(ptr);
+#elif defined(_WIN32)
+    return _msize(const_cast<void*>(ptr));
+#else
+    return malloc_usable_size(const_cast<void*>(ptr));
+#endif
+}
+
+static const JSMallocFunctions kQuickjsMallocFunctions = {
+    quickjsCalloc, quickjsMalloc, quickjsFree, quickjsRealloc, quickjsMallocUsableSize
+};
 
 static char* quickjsModuleNormalize(JSContext* ctx,
                                     const char* module_base_name,
@@ -100,7 +203,7 @@ public:
     QuickJSEngine() {
         std::cout << "[QuickJS] Creating engine..." << std::endl;
 
-        runtime_ = JS_NewRuntime();
+        runtime_ = JS_NewRuntime2(&kQuickjsMallocFunctions, nullptr);
         if (!runtime_) {
             std::cerr << "[QuickJS] Failed to create runtime" << std::endl;
             return;
@@ -114,6 +217,15 @@ public:
 
         JS_SetModuleLoaderFunc(runtime_, quickjsModuleNormalize, quickjsModuleLoader, nullptr);
 
+        // SharedArrayBuffers use process-wide refcounted blocks so they can be
+        // shared with worker runtimes. Atomics.wait throws until
+        // setAtomicsWaitAllowed() (worker runtimes only).
+        static const JSSharedArrayBufferFunctions sabFunctions = {
+            quickjsSabAlloc, quickjsSabFree, quickjsSabDup, nullptr
+        };
+        JS_SetSharedArrayBufferFunctions(runtime_, &sabFunctions);
+        JS_SetCanBlock(runtime_, false);
+
         // Set up standard globals
         setupGlobals();
 
@@ -312,6 +424,11 @@ public:
         return {val, context_};
     }
 
+    JSValueHandle newStringUtf8(const char* data, size_t length) override {
+        JSValue* val = new JSValue(JS_NewStringLen(context_, data, length));
+        return {val, context_};
+    }
+
     JSValueHandle newObject() override {
         JSValue* val = new JSValue(JS_NewObject(context_));
         return {val, context_};
@@ -334,6 +451,91 @@ public:
         return {val, context_};
     }
 
+    std::shared_ptr<BackingStore> detachArrayBuffer(JSValueHandle value) override {
+        JSValue* val = (JSValue*)value.ptr;
+        if (!val) return nullptr;
+
+        size_t len = 0;
+        uint8_t* data = JS_GetArrayBuffer(context_, &len, *val);
+        if (!data) {
+            // Not an ArrayBuffer (JS_GetArrayBuffer threw a TypeError) - clear it
+            JS_FreeValue(context_, JS_GetException(context_));
+            return nullptr;
+        }
+
+        // Buffers we adopted earlier can be passed on as-is
+        auto it = g_adoptedStores.find(data);
+        if (it != g_adoptedStores.end()) {
+            if (std::shared_ptr<BackingStore> store = it->second.lock()) {
+                JS_DetachArrayBuffer(context_, *val);
+                return store;
+            }
+        }
+
+        // Buffers QuickJS allocated are freed on detach; keep that block instead
+        g_stealPointer = data;
+        g_stolen = false;
+        JS_DetachArrayBuffer(context_, *val);
+        g_stealPointer = nullptr;
+
+        if (g_stolen) {
+            auto store = std::make_shared<BackingStore>();
+            store->data = data;
+            store->length = len;
+            store->release = [](void* p) { std::free(p); };
+            return store;
+        }
+
+        // External memory (no free function) is still valid after the detach; copy it
+        return BackingStore::allocate(len, data);
+    }
+
+    JSValueHandle newArrayBufferFromStore(std::shared_ptr<BackingStore> store) override {
+        if (!store) return newNull();
+        void* data = store->data;
+        auto* holder = new std::shared_ptr<BackingStore>(store);
+        g_adoptedStores[data] = store;
+        JSValue* val = new JSValue(JS_NewArrayBuffer(context_, (uint8_t*)data, store->length,
+                                                     quickjsReleaseStore, holder, false));
+        return {val, context_};
+    }
+
+    std::shared_ptr<BackingStore> getSharedArrayBufferStore(JSValueHandle value) override {
+        JSValue* val = (JSValue*)value.ptr;
+        if (!val) return nullptr;
+
+        JSValue global = JS_GetGlobalObject(context_);
+        JSValue ctor = JS_GetPropertyStr(context_, global, "SharedArrayBuffer");
+        bool isShared = JS_IsInstanceOf(context_, *val, ctor) == 1;
+        JS_FreeValue(context_, ctor);
+        JS_FreeValue(context_, global);
+        if (!isShared) return nullptr;
+
+        size_t len = 0;
+        uint8_t* data = JS_GetArrayBuffer(context_, &len, *val);
+        if (!data) return nullptr;
+
+        // Hold a block reference for as long as the store is alive
+        quickjsSabDup(nullptr, data);
+        auto store = std::make_shared<BackingStore>();
+        store->data = data;
+        store->length = len;
+        store->release = [](void* p) { quickjsSabFree(nullptr, p); };
+        return store;
+    }
+
+    JSValueHandle newSharedArrayBuffer(std::shared_ptr<BackingStore> store) override {
+        if (!store) return newNull();
+        // is_shared: QuickJS takes its own block reference through sab_dup
+        JSValue* val = new JSValue(JS_NewArrayBuffer(context_, (uint8_t*)store->data, store->length,
+                                                     nullptr, nullptr, true));
+        return {val, context_};
+    }
+
+    void setAtomicsWaitAllowed(bool allowed) override {
+        JS_SetCanBlock(runtime_, allowed);
+    }
+
     void* getArrayBufferData(JSValueHandle value, size_t* size) override {
         JSValue* val = (JSValue*)value.ptr;
         if (!val) return nullptr;
@@ -474,9 +676,10 @@ public:
 
     std::string toString(JSValueHandle value) override {
         JSValue* val = (JSValue*)value.ptr;
-        const char* str = JS_ToCString(context_, *val);
+        size_t length = 0;
+        const char* str = JS_ToCStringLen(context_, &length, *val);
         if (!str) return "";
-        std::string result(str);
+        std::string result(str, length);
         JS_FreeCString(context_, str);
         return result;
     }
@@ -600,10 +803,27 @@ public:
         delete val;
     }
 
+    void releaseHandle(JSValueHandle value) override {
+        if (!value.ptr || g_protectedHandles.count(value.ptr)) return;
+        JSValue* val = (JSValue*)value.ptr;
+        JS_FreeValue(context_, *val);
+        delete val;
+    }
+
     void gc() override {
         JS_RunGC(runtime_);
     }
 
+    HeapStats getHeapStats() override {
+        JSMemoryUsage usage;
+        JS_ComputeMemoryUsage(runtime_, &usage);
+        HeapStats stats;
+        stats.usedBytes = usage.memory_used_size > 0 ? static_cast<size_t>(usage.memory_used_size) : 0;
+        stats.totalBytes = usage.malloc_size > 0 ? static_cast<size_t>(usage.malloc_size) : 0;
+        stats.limitBytes = usage.malloc_limit > 0 ? static_cast<size_t>(usage.malloc_limit) : 0;  // -1 when unlimited
+        return stats;
+    }
+
     // ========================================================================
     // Error Handling
     // ========================================================================
@@ -816,10 +1036,10 @@ private:
     std::unordered_map<void*, void*> privateDataMap_;  // Map JS object ptr to native data
     std::vector<NativeFunction*> allocatedFunctions_;  // Track allocated function pointers
 
-    static QuickJSEngine* engineInstance_;  // For performance.now access
+    static thread_local QuickJSEngine* engineInstance_;  // For performance.now access (per thread)
 };
 
-QuickJSEngine* QuickJSEngine::engineInstance_ = nullptr;
+thread_local QuickJSEngine* QuickJSEngine::engineInstance_ = nullptr;
 
 // Factory function
 std::unique_ptr<Engine> createQuickJSEngine() {
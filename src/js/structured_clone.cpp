@@ -0,0 +1,1006 @@
+/**
+ * Structured Clone Implementation
+ *
+ * Wire format (all integers little-endian, lengths/counts as LEB128 varints):
+ *
+ *   header:  'm' <version:u8> <transferCount:varint> <value>
+ *   value:   '_' undefined | '0' null | 'T' true | 'F' false
+ *            'I' <int32>            'D' <float64>
+ *            'S' <len> <utf8>       'Z' <len> <utf8>          (BigInt, decimal)
+ *            'R' <id>                                          (back-reference)
+ *            'O' <count> (<len> <utf8 key> <value>)*
+ *            'A' <length> <value>*
+ *            'd' <float64>                                     (Date)
+ *            'r' <source> <flags>                              (RegExp, as strings)
+ *            'M' <count> (<key> <value>)*     'E' <count> <value>*   (Map, Set)
+ *            'e' <name> <message> <stack>                      (Error, as strings)
+ *            'B' <length> <bytes>                              (ArrayBuffer)
+ *            'H' <index>                                       (SharedArrayBuffer, into shared list)
+ *            'V' <kind:u8> <byteOffset> <length> <buffer value> (TypedArray/DataView)
+ *            'N' <type> <index>                                (native handle, into natives list)
+ *
+ * Every object gets an id in the order it is first visited; transferred
+ * ArrayBuffers take ids 0..transferCount-1, so 'R' covers both cycles and
+ * transfers. Object classification and identity live in the JS helper below
+ * (one call per object); everything else goes through the Engine API.
+ *
+ * Native handles are objects whose private data is a pointer and whose
+ * "_type" names a type registered with registerNativeHandleType(). Only the
+ * pointer crosses, as a NativeHandleRef that owns the message's reference;
+ * the receiver gets a bare object with the same private data and "_type".
+ * Transferable handles are emptied on the sender once serialization succeeds.
+ */
+
+#include "mystral/js/structured_clone.h"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace mystral {
+namespace js {
+
+namespace {
+
+constexpr uint8_t kFormatVersion = 2;
+constexpr int kMaxDepth = 2048;
+
+// Native handle types, shared by every engine in the process
+std::mutex g_nativeTypesMutex;
+std::unordered_map<std::string, NativeHandleOps> g_nativeTypes;
+std::atomic<bool> g_hasNativeTypes{false};
+
+bool isNativeHandleType(const std::string& type, NativeHandleOps* ops = nullptr) {
+    std::lock_guard<std::mutex> lock(g_nativeTypesMutex);
+    auto it = g_nativeTypes.find(type);
+    if (it == g_nativeTypes.end()) return false;
+    if (ops) *ops = it->second;
+    return true;
+}
+
+// Object classes returned by the helper's visit(); negative = back-reference
+enum CloneClass {
+    kClassObject = 0,
+    kClassArray = 1,
+    kClassDate = 2,
+    kClassRegExp = 3,
+    kClassMap = 4,
+    kClassSet = 5,
+    kClassError = 6,
+    kClassArrayBuffer = 7,
+    kClassBigInt = 8,
+    kClassUncloneable = 9,
+    kClassSharedArrayBuffer = 10,
+    kClassView = 16,  // + index into viewTypes (Int8Array ... DataView)
+    kClassViewEnd = 28
+};
+
+const char* kHelperSource = R"JS(
+(function() {
+    const CLASS_OBJECT = 0, CLASS_ARRAY = 1, CLASS_DATE = 2, CLASS_REGEXP = 3, CLASS_MAP = 4,
+          CLASS_SET = 5, CLASS_ERROR = 6, CLASS_ARRAYBUFFER = 7, CLASS_BIGINT = 8,
+          CLASS_UNCLONEABLE = 9, CLASS_SHAREDARRAYBUFFER = 10, CLASS_VIEW = 16;
+    // Index = view kind on the wire; entries are undefined if the engine lacks the type
+    const viewTypes = ['Int8Array', 'Uint8Array', 'Uint8ClampedArray', 'Int16Array', 'Uint16Array',
+                       'Int32Array', 'Uint32Array', 'Float32Array', 'Float64Array',
+                       'BigInt64Array', 'BigUint64Array', 'DataView'].map((name) => globalThis[name]);
+    const errorTypes = { EvalError, RangeError, ReferenceError, SyntaxError, TypeError, URIError };
+    const SharedBuffer = globalThis.SharedArrayBuffer;
+    let memo = new Map();
+    let nextId = 0;
+    let transferred = [];
+    let transferredHandles = new Set();
+    let moved = [];
+
+    const helpers = {
+        // Start a walk. Transferred buffers take ids 0..n-1; returns n, or -1 if invalid.
+        // Native handles (objects with a _type) may be listed too; see claim().
+        begin(transfer) {
+            memo = new Map();
+            nextId = 0;
+            transferred = [];
+            transferredHandles = new Set();
+            moved = [];
+            if (transfer === undefined || transfer === null) return 0;
+            if (!Array.isArray(transfer)) return -1;
+            for (const buffer of transfer) {
+                if (buffer !== null && typeof buffer === 'object' && typeof buffer._type === 'string') {
+                    if (transferredHandles.has(buffer)) return -1;
+                    transferredHandles.add(buffer);
+                    continue;
+                }
+                if (!(buffer instanceof ArrayBuffer) || memo.has(buffer)) return -1;
+                memo.set(buffer, nextId++);
+                transferred.push(buffer);
+            }
+            return nextId;
+        },
+        // The ArrayBuffers from the last begin(), in id order
+        transferredBuffers() {
+            return transferred;
+        },
+        // A transferable native handle is being written: true if it was listed
+        claim(handle) {
+            if (!transferredHandles.has(handle)) return false;
+            moved.push(handle);
+            return true;
+        },
+        // The native handles claim() accepted, to be emptied on success
+        movedHandles() {
+            return moved;
+        },
+        end() {
+            memo = new Map();
+            transferred = [];
+            transferredHandles = new Set();
+            moved = [];
+        },
+        visit(value) {
+            const type = typeof value;
+            if (type === 'bigint') return CLASS_BIGINT;
+            if (type !== 'object') return CLASS_UNCLONEABLE;  // function, symbol
+            const seen = memo.get(value);
+            if (seen !== undefined) return -1 - seen;
+            memo.set(value, nextId++);
+            if (Array.isArray(value)) return CLASS_ARRAY;
+            if (value instanceof ArrayBuffer) return CLASS_ARRAYBUFFER;
+            if (SharedBuffer && value instanceof SharedBuffer) return CLASS_SHAREDARRAYBUFFER;
+            if (ArrayBuffer.isView(value)) {
+                for (let i = 0; i < viewTypes.length; i++) {
+                    if (viewTypes[i] && value instanceof viewTypes[i]) return CLASS_VIEW + i;
+                }
+                return CLASS_UNCLONEABLE;
+            }
+            if (value instanceof Date) return CLASS_DATE;
+            if (value instanceof RegExp) return CLASS_REGEXP;
+            if (value instanceof Map) return CLASS_MAP;
+            if (value instanceof Set) return CLASS_SET;
+            if (value instanceof Error) return CLASS_ERROR;
+            if (value instanceof Promise || value instanceof WeakMap || value instanceof WeakSet) {
+                return CLASS_UNCLONEABLE;
+            }
+            return CLASS_OBJECT;
+        },
+        keys(value) {
+            return Object.keys(value);
+        },
+        // Property access for keys with embedded NULs, which the Engine API cannot name
+        get(target, key) {
+            return target[key];
+        },
+        set(target, key, value) {
+            target[key] = value;
+        },
+        expand(value, cls) {
+            switch (cls) {
+                case CLASS_DATE: return value.getTime();
+                case CLASS_REGEXP: return [value.source, value.flags];
+                case CLASS_MAP: {
+                    const out = [];
+                    value.forEach((v, k) => { out.push(k, v); });
+                    return out;
+                }
+                case CLASS_SET: return Array.from(value);
+                case CLASS_ERROR: return [String(value.name), String(value.message), String(value.stack || '')];
+                case CLASS_BIGINT: return value.toString();
+                default: {
+                    const length = value instanceof DataView ? value.byteLength : value.length;
+                    return [value.buffer, value.byteOffset, length];
+                }
+            }
+        },
+        make(cls, a, b, c) {
+            switch (cls) {
+                case CLASS_DATE: return new Date(a);
+                case CLASS_REGEXP: return new RegExp(a, b);
+                case CLASS_MAP: return new Map();
+                case CLASS_SET: return new Set();
+                case CLASS_BIGINT: return BigInt(a);
+                case CLASS_ERROR: {
+                    const error = new (errorTypes[a] || Error)(b);
+                    if (c) error.stack = c;
+                    return error;
+                }
+                default: return new viewTypes[cls - CLASS_VIEW](a, b, c);
+            }
+        },
+        add(target, a, b) {
+            if (target instanceof Map) target.set(a, b);
+            else target.add(a);
+        },
+        fail(message) {
+            const error = new Error(message);
+            error.name = 'DataCloneError';
+            return error;
+        }
+    };
+
+    Object.defineProperty(globalThis, '__structuredCloneHelpers', { value: helpers });
+
+    globalThis.structuredClone = function(value, options) {
+        const result = __structuredClone(value, options && options.transfer);
+        if (typeof result === 'string') throw helpers.fail(result);
+        return result[0];
+    };
+})();
+)JS";
+
+/**
+ * Handles to the JS helper functions for one serialize/deserialize call
+ */
+struct Helpers {
+    Engine* engine = nullptr;
+    JSValueHandle object, begin, transferredBuffers, claim, movedHandles, end, visit, keys, get, set, expand,
+        make, add;
+
+    explicit Helpers(Engine* e) : engine(e) {}
+    ~Helpers() {
+        for (auto h : {begin, transferredBuffers, claim, movedHandles, end, visit, keys, get, set, expand, make, add,
+                       object}) {
+            engine->releaseHandle(h);
+        }
+    }
+
+    bool load() {
+        object = engine->getGlobalProperty("__structuredCloneHelpers");
+        if (!object.ptr || !engine->isObject(object)) return false;
+        begin = engine->getProperty(object, "begin");
+        transferredBuffers = engine->getProperty(object, "transferredBuffers");
+        claim = engine->getProperty(object, "claim");
+        movedHandles = engine->getProperty(object, "movedHandles");
+        end = engine->getProperty(object, "end");
+        visit = engine->getProperty(object, "visit");
+        keys = engine->getProperty(object, "keys");
+        get = engine->getProperty(object, "get");
+        set = engine->getProperty(object, "set");
+        expand = engine->getProperty(object, "expand");
+        make = engine->getProperty(object, "make");
+        add = engine->getProperty(object, "add");
+        return true;
+    }
+
+    JSValueHandle call(JSValueHandle fn, const std::vector<JSValueHandle>& args) {
+        return engine->call(fn, object, args);
+    }
+};
+
+bool hasNul(const std::string& s) {
+    return s.find('\0') != std::string::npos;
+}
+
+uint32_t arrayLength(Engine* engine, JSValueHandle array) {
+    JSValueHandle length = engine->getProperty(array, "length");
+    uint32_t n = static_cast<uint32_t>(engine->toNumber(length));
+    engine->releaseHandle(length);
+    return n;
+}
+
+// ============================================================================
+// Serializer
+// ============================================================================
+
+class Serializer {
+public:
+    Serializer(Engine* engine, Helpers& helpers, SerializedValue& out)
+        : engine_(engine), helpers_(helpers), out_(out.data), shared_(out.shared), natives_(out.natives) {}
+
+    std::string error;
+
+    void putByte(uint8_t b) { out_.push_back(b); }
+
+    void putVarint(uint64_t v) {
+        while (v >= 0x80) {
+            out_.push_back(static_cast<uint8_t>(v | 0x80));
+            v >>= 7;
+        }
+        out_.push_back(static_cast<uint8_t>(v));
+    }
+
+    void putBytes(const void* data, size_t size) {
+        if (size == 0) return;
+        size_t offset = out_.size();
+        out_.resize(offset + size);
+        std::memcpy(out_.data() + offset, data, size);
+    }
+
+    void putString(const std::string& s) {
+        putVarint(s.size());
+        putBytes(s.data(), s.size());
+    }
+
+    void putDouble(double d) {
+        putBytes(&d, sizeof(d));
+    }
+
+    bool writeValue(JSValueHandle value, int depth) {
+        if (engine_->isUndefined(value)) { putByte('_'); return true; }
+        if (engine_->isNull(value)) { putByte('0'); return true; }
+        if (engine_->isBoolean(value)) { putByte(engine_->toBoolean(value) ? 'T' : 'F'); return true; }
+        if (engine_->isNumber(value)) { writeNumber(engine_->toNumber(value)); return true; }
+        if (engine_->isString(value)) {
+            putByte('S');
+            putString(engine_->toString(value));
+            return true;
+        }
+
+        if (depth > kMaxDepth) {
+            return fail("Object graph is too deep to be cloned");
+        }
+
+        int cls = callForInt(helpers_.visit, {value});
+        if (cls < 0) {
+            putByte('R');
+            putVarint(static_cast<uint64_t>(-1 - cls));
+            return true;
+        }
+
+        switch (cls) {
+            case kClassObject: {
+                std::string type;
+                NativeHandleOps ops;
+                void* handle = g_hasNativeTypes.load(std::memory_order_relaxed) ? nativeHandle(value, type, ops)
+                                                                               : nullptr;
+                return handle ? writeNativeHandle(value, type, handle, ops) : writeObject(value, depth);
+            }
+            case kClassArray: return writeArray(value, depth);
+            case kClassDate: {
+                JSValueHandle time = expand(value, cls);
+                putByte('d');
+                putDouble(engine_->toNumber(time));
+                engine_->releaseHandle(time);
+                return true;
+            }
+            case kClassRegExp: return writeStrings('r', value, cls, 2);
+            case kClassError: return writeStrings('e', value, cls, 3);
+            case kClassBigInt: {
+                JSValueHandle digits = expand(value, cls);
+                putByte('Z');
+                putString(engine_->toString(digits));
+                engine_->releaseHandle(digits);
+                return true;
+            }
+            case kClassMap:
+            case kClassSet: return writeCollection(value, cls, depth);
+            case kClassArrayBuffer: {
+                // Fast path: raw bytes straight from the backing store
+                size_t size = 0;
+                void* data = engine_->getArrayBufferData(value, &size);
+                putByte('B');
+                putVarint(data ? size : 0);
+                if (data) putBytes(data, size);
+                return true;
+            }
+            case kClassSharedArrayBuffer: {
+                auto store = engine_->getSharedArrayBufferStore(value);
+                if (!store) return fail("SharedArrayBuffer cannot be shared by this engine");
+                putByte('H');
+                putVarint(shared_.size());
+                shared_.push_back(std::move(store));
+                return true;
+            }
+            default:
+                if (cls >= kClassView && cls < kClassViewEnd) {
+                    return writeView(value, cls, depth);
+                }
+                return fail("Value could not be cloned");
+        }
+    }
+
+    // After a successful walk: give each native handle in the message its reference
+    void retainNativeHandles() {
+        for (size_t i = 0; i < natives_.size(); i++) {
+            const NativeHandleOps& ops = nativeOps_[i];
+            if (ops.addRef) ops.addRef(natives_[i]->handle);
+            if (ops.addRef || ops.transfer) natives_[i]->release = ops.release;
+        }
+    }
+
+private:
+    Engine* engine_;
+    Helpers& helpers_;
+    std::vector<uint8_t>& out_;
+    std::vector<std::shared_ptr<BackingStore>>& shared_;
+    std::vector<std::shared_ptr<NativeHandleRef>>& natives_;
+    std::vector<NativeHandleOps> nativeOps_;  // Parallel to natives_
+
+    bool fail(const char* message) {
+        if (error.empty()) error = message;
+        return false;
+    }
+
+    int callForInt(JSValueHandle fn, const std::vector<JSValueHandle>& args) {
+        JSValueHandle result = helpers_.call(fn, args);
+        if (!result.ptr) return kClassUncloneable;
+        int n = static_cast<int>(engine_->toNumber(result));
+        engine_->releaseHandle(result);
+        return n;
+    }
+
+    JSValueHandle expand(JSValueHandle value, int cls) {
+        JSValueHandle clsHandle = engine_->newNumber(cls);
+        JSValueHandle result = helpers_.call(helpers_.expand, {value, clsHandle});
+        engine_->releaseHandle(clsHandle);
+        return result;
+    }
+
+    void writeNumber(double d) {
+        // Small integers (array indices, counts, enum values) get the compact encoding
+        if (d >= -2147483648.0 && d <= 2147483647.0 && d == std::floor(d) && !(d == 0 && std::signbit(d))) {
+            int32_t i = static_cast<int32_t>(d);
+            putByte('I');
+            putBytes(&i, sizeof(i));
+        } else {
+            putByte('D');
+            putDouble(d);
+        }
+    }
+
+    bool writeStrings(uint8_t tag, JSValueHandle value, int cls, uint32_t count) {
+        JSValueHandle parts = expand(value, cls);
+        if (!parts.ptr) return fail("Value could not be cloned");
+        putByte(tag);
+        for (uint32_t i = 0; i < count; i++) {
+            JSValueHandle part = engine_->getPropertyIndex(parts, i);
+            putString(engine_->toString(part));
+            engine_->releaseHandle(part);
+        }
+        engine_->releaseHandle(parts);
+        return true;
+    }
+
+    // The pointer of a registered native handle, or null for any other object
+    void* nativeHandle(JSValueHandle value, std::string& type, NativeHandleOps& ops) {
+        void* handle = engine_->getPrivateData(value);
+        if (!handle) return nullptr;
+
+        JSValueHandle typeProp = engine_->getProperty(value, "_type");
+        type = engine_->isString(typeProp) ? engine_->toString(typeProp) : std::string();
+        engine_->releaseHandle(typeProp);
+        return !type.empty() && isNativeHandleType(type, &ops) ? handle : nullptr;
+    }
+
+    // References are taken in retainNativeHandles(), once nothing can fail
+    bool writeNativeHandle(JSValueHandle value, const std::string& type, void* handle, const NativeHandleOps& ops) {
+        if (ops.transfer) {
+            JSValueHandle listed = helpers_.call(helpers_.claim, {value});
+            bool ok = listed.ptr && engine_->toBoolean(listed);
+            engine_->releaseHandle(listed);
+            if (!ok) {
+                std::string message = "A " + type + " can only be transferred; add it to the transfer list";
+                return fail(message.c_str());
+            }
+        }
+
+        putByte('N');
+        putString(type);
+        putVarint(natives_.size());
+        natives_.push_back(std::make_shared<NativeHandleRef>(handle, nullptr));
+        nativeOps_.push_back(ops);
+        return true;
+    }
+
+    bool writeObject(JSValueHandle value, int depth) {
+        JSValueHandle keys = helpers_.call(helpers_.keys, {value});
+        if (!keys.ptr) return fail("Value could not be cloned");
+
+        uint32_t count = arrayLength(engine_, keys);
+        putByte('O');
+        putVarint(count);
+
+        bool ok = true;
+        for (uint32_t i = 0; i < count && ok; i++) {
+            JSValueHandle key = engine_->getPropertyIndex(keys, i);
+            std::string name = engine_->toString(key);
+
+            putString(name);
+            JSValueHandle prop = hasNul(name) ? helpers_.call(helpers_.get, {value, key})
+                                              : engine_->getProperty(value, name.c_str());
+            engine_->releaseHandle(key);
+            ok = writeValue(prop, depth + 1);
+            engine_->releaseHandle(prop);
+        }
+        engine_->releaseHandle(keys);
+        return ok;
+    }
+
+    bool writeArray(JSValueHandle value, int depth) {
+        uint32_t length = arrayLength(engine_, value);
+        putByte('A');
+        putVarint(length);
+
+        for (uint32_t i = 0; i < length; i++) {
+            JSValueHandle element = engine_->getPropertyIndex(value, i);
+            bool ok = writeValue(element, depth + 1);
+            engine_->releaseHandle(element);
+            if (!ok) return false;
+        }
+        return true;
+    }
+
+    bool writeCollection(JSValueHandle value, int cls, int depth) {
+        JSValueHandle entries = expand(value, cls);
+        if (!entries.ptr) return fail("Value could not be cloned");
+
+        uint32_t length = arrayLength(engine_, entries);
+        putByte(cls == kClassMap ? 'M' : 'E');
+        putVarint(cls == kClassMap ? length / 2 : length);
+
+        bool ok = true;
+        for (uint32_t i = 0; i < length && ok; i++) {
+            JSValueHandle entry = engine_->getPropertyIndex(entries, i);
+            ok = writeValue(entry, depth + 1);
+            engine_->releaseHandle(entry);
+        }
+        engine_->releaseHandle(entries);
+        return ok;
+    }
+
+    bool writeView(JSValueHandle value, int cls, int depth) {
+        JSValueHandle parts = expand(value, cls);
+        if (!parts.ptr) return fail("Value could not be cloned");
+
+        JSValueHandle buffer = engine_->getPropertyIndex(parts, 0);
+        JSValueHandle byteOffset = engine_->getPropertyIndex(parts, 1);
+        JSValueHandle length = engine_->getPropertyIndex(parts, 2);
+
+        putByte('V');
+        putByte(static_cast<uint8_t>(cls - kClassView));
+        putVarint(static_cast<uint64_t>(engine_->toNumber(byteOffset)));
+        putVarint(static_cast<uint64_t>(engine_->toNumber(length)));
+        bool ok = writeValue(buffer, depth + 1);
+
+        for (auto h : {buffer, byteOffset, length, parts}) {
+            engine_->releaseHandle(h);
+        }
+        return ok;
+    }
+};
+
+// ============================================================================
+// Deserializer
+// ============================================================================
+
+class Deserializer {
+public:
+    Deserializer(Engine* engine, Helpers& helpers, const uint8_t* data, size_t size,
+                 const std::vector<std::shared_ptr<BackingStore>>& shared,
+                 const std::vector<std::shared_ptr<NativeHandleRef>>& natives)
+        : engine_(engine), helpers_(helpers), p_(data), end_(data + size), shared_(shared), natives_(natives) {}
+
+    ~Deserializer() {
+        for (auto h : refs_) {
+            if (h.ptr != keep_) engine_->releaseHandle(h);
+        }
+    }
+
+    std::string error;
+
+    // Objects are owned by refs_ (released in the destructor); only primitives
+    // returned from readValue() belong to the caller.
+    struct Value {
+        JSValueHandle handle;
+        bool owned = false;
+    };
+
+    void addReference(JSValueHandle h) { refs_.push_back(h); }
+
+    void keep(JSValueHandle h) { keep_ = h.ptr; }
+
+    bool readByte(uint8_t& b) {
+        if (p_ >= end_) return fail();
+        b = *p_++;
+        return true;
+    }
+
+    bool readVarint(uint64_t& v) {
+        v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t b;
+            if (!readByte(b)) return false;
+            v |= static_cast<uint64_t>(b & 0x7f) << shift;
+            if (!(b & 0x80)) return true;
+        }
+        return fail();
+    }
+
+    bool readString(std::string& s) {
+        uint64_t len;
+        if (!readVarint(len) || static_cast<uint64_t>(end_ - p_) < len) return fail();
+        s.assign(reinterpret_cast<const char*>(p_), static_cast<size_t>(len));
+        p_ += len;
+        return true;
+    }
+
+    bool readDouble(double& d) {
+        if (end_ - p_ < static_cast<ptrdiff_t>(sizeof(d))) return fail();
+        std::memcpy(&d, p_, sizeof(d));
+        p_ += sizeof(d);
+        return true;
+    }
+
+    bool readValue(Value& out, int depth) {
+        uint8_t tag;
+        if (!readByte(tag)) return false;
+        if (depth > kMaxDepth) return fail();
+
+        out.owned = true;
+        switch (tag) {
+            case '_': out.handle = engine_->newUndefined(); return true;
+            case '0': out.handle = engine_->newNull(); return true;
+            case 'T': out.handle = engine_->newBoolean(true); return true;
+            case 'F': out.handle = engine_->newBoolean(false); return true;
+            case 'I': {
+                int32_t i;
+                if (end_ - p_ < static_cast<ptrdiff_t>(sizeof(i))) return fail();
+                std::memcpy(&i, p_, sizeof(i));
+                p_ += sizeof(i);
+                out.handle = engine_->newNumber(i);
+                return true;
+            }
+            case 'D': {
+                double d;
+                if (!readDouble(d)) return false;
+                out.handle = engine_->newNumber(d);
+                return true;
+            }
+            case 'S': {
+                std::string s;
+                if (!readString(s)) return false;
+                out.handle = newString(s);
+                return true;
+            }
+            case 'Z': {
+                std::string digits;
+                if (!readString(digits)) return false;
+                out.handle = make(kClassBigInt, {newString(digits)});
+                return out.handle.ptr != nullptr || fail();
+            }
+            case 'R': {
+                uint64_t id;
+                if (!readVarint(id) || id >= refs_.size() || !refs_[id].ptr) return fail();
+                out.handle = refs_[id];
+                out.owned = false;
+                return true;
+            }
+            default:
+                break;
+        }
+
+        // Everything below is an object and gets the next reference id
+        out.owned = false;
+        switch (tag) {
+            case 'O': return readObject(out, depth);
+            case 'A': return readArray(out, depth);
+            case 'd': {
+                double time;
+                if (!readDouble(time)) return false;
+                return adopt(out, make(kClassDate, {engine_->newNumber(time)}));
+            }
+            case 'r': {
+                std::string source, flags;
+                if (!readString(source) || !readString(flags)) return false;
+                return adopt(out, make(kClassRegExp, {newString(source), newString(flags)}));
+            }
+            case 'e': {
+                std::string name, message, stack;
+                if (!readString(name) || !readString(message) || !readString(stack)) return false;
+                return adopt(out, make(kClassError, {newString(name), newString(message), newString(stack)}));
+            }
+            case 'M':
+            case 'E': return readCollection(out, tag == 'M', depth);
+            case 'B': {
+                uint64_t size;
+                if (!readVarint(size) || static_cast<uint64_t>(end_ - p_) < size) return fail();
+                JSValueHandle buffer = engine_->newArrayBuffer(p_, static_cast<size_t>(size));
+                p_ += size;
+                return adopt(out, buffer);
+            }
+            case 'H': {
+                uint64_t index;
+                if (!readVarint(index) || index >= shared_.size()) return fail();
+                JSValueHandle buffer = engine_->newSharedArrayBuffer(shared_[index]);
+                if (!buffer.ptr || engine_->isNull(buffer)) {
+                    error = "SharedArrayBuffer cannot be shared by this engine";
+                    return false;
+                }
+                return adopt(out, buffer);
+            }
+            case 'V': return readView(out, depth);
+            case 'N': {
+                std::string type;
+                uint64_t index;
+                NativeHandleOps ops;
+                if (!readString(type) || !readVarint(index) || index >= natives_.size() ||
+                    !natives_[index]->handle || !isNativeHandleType(type, &ops)) {
+                    return fail();
+                }
+
+                // Take over the message's reference (each handle is read at most once)
+                NativeHandleRef& ref = *natives_[index];
+                void* handle = ref.handle;
+                void (*release)(void*) = ref.release;
+                ref.handle = nullptr;
+                ref.release = nullptr;
+
+                JSValueHandle obj = engine_->newObject();
+                engine_->setPrivateData(obj, handle);
+                engine_->setProperty(obj, "_type", newString(type));
+                if (ops.addRef && release) {
+                    engine_->registerRelease(obj, [release, handle]() { release(handle); });
+                }
+                if (ops.reviver) ops.reviver(engine_, obj, handle);
+                return adopt(out, obj);
+            }
+            default:
+                return fail();
+        }
+    }
+
+private:
+    Engine* engine_;
+    Helpers& helpers_;
+    const uint8_t* p_;
+    const uint8_t* end_;
+    const std::vector<std::shared_ptr<BackingStore>>& shared_;
+    const std::vector<std::shared_ptr<NativeHandleRef>>& natives_;
+    std::vector<JSValueHandle> refs_;
+    void* keep_ = nullptr;
+
+    bool fail() {
+        if (error.empty()) error = "Malformed structured clone data";
+        return false;
+    }
+
+    // Strings may contain NULs, so always pass the length
+    JSValueHandle newString(const std::string& s) {
+        return engine_->newStringUtf8(s.data(), s.size());
+    }
+
+    void release(const Value& v) {
+        if (v.owned) engine_->releaseHandle(v.handle);
+    }
+
+    bool adopt(Value& out, JSValueHandle h) {
+        if (!h.ptr) return fail();
+        refs_.push_back(h);
+        out.handle = h;
+        return true;
+    }
+
+    // Call helpers.make(cls, ...args); releases the argument handles
+    JSValueHandle make(int cls, std::vector<JSValueHandle> args) {
+        args.insert(args.begin(), engine_->newNumber(cls));
+        JSValueHandle result = helpers_.call(helpers_.make, args);
+        for (auto h : args) engine_->releaseHandle(h);
+        return result;
+    }
+
+    bool readObject(Value& out, int depth) {
+        JSValueHandle obj = engine_->newObject();
+        adopt(out, obj);
+
+        uint64_t count;
+        if (!readVarint(count)) return false;
+        for (uint64_t i = 0; i < count; i++) {
+            std::string key;
+            Value prop;
+            if (!readString(key) || !readValue(prop, depth + 1)) return false;
+            if (hasNul(key)) {
+                JSValueHandle keyString = newString(key);
+                engine_->releaseHandle(helpers_.call(helpers_.set, {obj, keyString, prop.handle}));
+                engine_->releaseHandle(keyString);
+            } else {
+                engine_->setProperty(obj, key.c_str(), prop.handle);
+            }
+            release(prop);
+        }
+        return true;
+    }
+
+    bool readArray(Value& out, int depth) {
+        uint64_t length;
+        if (!readVarint(length) || length > static_cast<uint64_t>(end_ - p_)) return fail();
+        JSValueHandle array = engine_->newArray(static_cast<size_t>(length));
+        adopt(out, array);
+
+        for (uint64_t i = 0; i < length; i++) {
+            Value element;
+            if (!readValue(element, depth + 1)) return false;
+            engine_->setPropertyIndex(array, static_cast<uint32_t>(i), element.handle);
+            release(element);
+        }
+        return true;
+    }
+
+    bool readCollection(Value& out, bool isMap, int depth) {
+        if (!adopt(out, make(isMap ? kClassMap : kClassSet, {}))) return false;
+        JSValueHandle collection = out.handle;
+
+        uint64_t count;
+        if (!readVarint(count)) return false;
+        for (uint64_t i = 0; i < count; i++) {
+            Value key, value;
+            if (!readValue(key, depth + 1)) return false;
+            if (isMap && !readValue(value, depth + 1)) {
+                release(key);
+                return false;
+            }
+            std::vector<JSValueHandle> args = {collection, key.handle};
+            if (isMap) args.push_back(value.handle);
+            engine_->releaseHandle(helpers_.call(helpers_.add, args));
+            release(key);
+            if (isMap) release(value);
+        }
+        return true;
+    }
+
+    bool readView(Value& out, int depth) {
+        // The view's id precedes its buffer's (matches visit order when writing)
+        size_t slot = refs_.size();
+        refs_.push_back({});
+
+        uint8_t kind;
+        uint64_t byteOffset, length;
+        Value buffer;
+        if (!readByte(kind) || !readVarint(byteOffset) || !readVarint(length)) return false;
+        if (kind >= kClassViewEnd - kClassView) return fail();
+        if (!readValue(buffer, depth + 1)) return false;
+
+        // The buffer handle is not ours to release inside make(), so build the call here
+        JSValueHandle clsHandle = engine_->newNumber(kClassView + kind);
+        JSValueHandle offsetHandle = engine_->newNumber(static_cast<double>(byteOffset));
+        JSValueHandle lengthHandle = engine_->newNumber(static_cast<double>(length));
+        JSValueHandle view = helpers_.call(helpers_.make, {clsHandle, buffer.handle, offsetHandle, lengthHandle});
+        for (auto h : {clsHandle, offsetHandle, lengthHandle}) engine_->releaseHandle(h);
+        release(buffer);
+
+        if (!view.ptr) return fail();
+        refs_[slot] = view;
+        out.handle = view;
+        return true;
+    }
+};
+
+}  // namespace
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void registerNativeHandleType(const std::string& type, const NativeHandleOps& ops) {
+    std::lock_guard<std::mutex> lock(g_nativeTypesMutex);
+    g_nativeTypes[type] = ops;
+    g_hasNativeTypes.store(true);
+}
+
+void installStructuredClone(Engine* engine) {
+    if (!engine) return;
+
+    // __structuredClone(value, transfer) -> [clone] or an error message string
+    engine->setGlobalProperty("__structuredClone",
+        engine->newFunction("__structuredClone", [engine](void* ctx, const std::vector<JSValueHandle>& args) {
+            JSValueHandle value = args.empty() ? engine->newUndefined() : args[0];
+            JSValueHandle transfer = args.size() > 1 ? args[1] : engine->newUndefined();
+
+            SerializedValue serialized;
+            std::string error;
+            if (!structuredSerialize(engine, value, transfer, serialized, error)) {
+                return engine->newString(error.c_str());
+            }
+
+            JSValueHandle clone = structuredDeserialize(engine, serialized.data.data(), serialized.data.size(),
+                                                        serialized.transfers, serialized.shared, serialized.natives,
+                                                        error);
+            if (!clone.ptr) {
+                return engine->newString(error.c_str());
+            }
+
+            JSValueHandle result = engine->newArray(1);
+            engine->setPropertyIndex(result, 0, clone);
+            engine->releaseHandle(clone);
+            return result;
+        })
+    );
+
+    engine->eval(kHelperSource, "structured-clone.js");
+}
+
+bool structuredSerialize(Engine* engine, JSValueHandle value, JSValueHandle transferList,
+                         SerializedValue& out, std::string& error) {
+    Helpers helpers(engine);
+    if (!helpers.load()) {
+        error = "structuredClone is not installed in this engine";
+        return false;
+    }
+
+    bool hasTransfer = transferList.ptr && !engine->isUndefined(transferList) && !engine->isNull(transferList);
+    JSValueHandle beginArg = hasTransfer ? transferList : engine->newUndefined();
+    JSValueHandle countHandle = helpers.call(helpers.begin, {beginArg});
+    int transferCount = countHandle.ptr ? static_cast<int>(engine->toNumber(countHandle)) : -1;
+    engine->releaseHandle(countHandle);
+    if (!hasTransfer) engine->releaseHandle(beginArg);
+    if (transferCount < 0) {
+        error = "Transfer list must contain distinct ArrayBuffers or native handles";
+        return false;
+    }
+
+    out.data.clear();
+    out.transfers.clear();
+    out.shared.clear();
+    out.natives.clear();
+    Serializer serializer(engine, helpers, out);
+    serializer.putByte('m');
+    serializer.putByte(kFormatVersion);
+    serializer.putVarint(static_cast<uint64_t>(transferCount));
+    bool ok = serializer.writeValue(value, 0);
+
+    if (!ok) {
+        engine->releaseHandle(helpers.call(helpers.end, {}));
+        error = serializer.error;
+        out.data.clear();
+        out.shared.clear();
+        out.natives.clear();
+        return false;
+    }
+
+    // Only detach once the whole value serialized successfully
+    JSValueHandle buffers = helpers.call(helpers.transferredBuffers, {});
+    out.transfers.reserve(transferCount);
+    for (int i = 0; i < transferCount; i++) {
+        JSValueHandle buffer = engine->getPropertyIndex(buffers, static_cast<uint32_t>(i));
+        auto store = engine->detachArrayBuffer(buffer);
+        engine->releaseHandle(buffer);
+        out.transfers.push_back(store ? std::move(store) : BackingStore::allocate(0));
+    }
+    engine->releaseHandle(buffers);
+
+    serializer.retainNativeHandles();
+    JSValueHandle moved = helpers.call(helpers.movedHandles, {});
+    uint32_t movedCount = moved.ptr ? arrayLength(engine, moved) : 0;
+    for (uint32_t i = 0; i < movedCount; i++) {
+        JSValueHandle handle = engine->getPropertyIndex(moved, i);
+        engine->setPrivateData(handle, nullptr);
+        engine->releaseHandle(handle);
+    }
+    engine->releaseHandle(moved);
+    engine->releaseHandle(helpers.call(helpers.end, {}));
+    return true;
+}
+
+JSValueHandle structuredDeserialize(Engine* engine, const uint8_t* data, size_t size,
+                                    const std::vector<std::shared_ptr<BackingStore>>& transfers,
+                                    const std::vector<std::shared_ptr<BackingStore>>& shared,
+                                    const std::vector<std::shared_ptr<NativeHandleRef>>& natives,
+                                    std::string& error) {
+    Helpers helpers(engine);
+    if (!helpers.load()) {
+        error = "structuredClone is not installed in this engine";
+        return {nullptr, nullptr};
+    }
+
+    Deserializer reader(engine, helpers, data, size, shared, natives);
+    uint8_t magic = 0, version = 0;
+    uint64_t transferCount = 0;
+    if (!reader.readByte(magic) || !reader.readByte(version) || !reader.readVarint(transferCount) ||
+        magic != 'm' || version != kFormatVersion || transferCount != transfers.size()) {
+        error = "Malformed structured clone data";
+        return {nullptr, nullptr};
+    }
+
+    for (const auto& store : transfers) {
+        reader.addReference(engine->newArrayBufferFromStore(store));
+    }
+
+    Deserializer::Value root;
+    if (!reader.readValue(root, 0)) {
+        error = reader.error;
+        if (root.owned) engine->releaseHandle(root.handle);
+        return {nullptr, nullptr};
+    }
+    reader.keep(root.handle);
+    return root.handle;
+}
+
+}  // namespace js
+}  // namespace mystral
@@ -0,0 +1,461 @@
+/**
+ * Text Codec Implementation
+ *
+ * Decoding validates first and, for valid input, passes the caller's bytes
+ * straight to Engine::newStringUtf8(). Validation skips ASCII runs with
+ * asciiPrefixLength() and checks each multi-byte sequence against the
+ * WHATWG byte ranges, so JSON and source files (mostly ASCII) cost about one
+ * SIMD compare per 16 bytes.
+ */
+
+#include "mystral/js/text_codec.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MYSTRAL_TEXT_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define MYSTRAL_TEXT_NEON 1
+#endif
+
+namespace mystral {
+namespace js {
+
+namespace utf8 {
+
+size_t asciiPrefixLength(const uint8_t* data, size_t size) {
+    size_t i = 0;
+#if defined(MYSTRAL_TEXT_SSE2)
+    for (; i + 16 <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        if (_mm_movemask_epi8(chunk) != 0) break;
+    }
+#elif defined(MYSTRAL_TEXT_NEON)
+    for (; i + 16 <= size; i += 16) {
+        if (vmaxvq_u8(vld1q_u8(data + i)) >= 0x80) break;
+    }
+#endif
+    // Eight bytes at a time, then finish the block that stopped the wide loop
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        if (word & 0x8080808080808080ull) break;
+    }
+    while (i < size && data[i] < 0x80) i++;
+    return i;
+}
+
+/**
+ * Length of the valid sequence starting at data[i] (a non-ASCII byte), or 0.
+ * On 0, *resume is where decoding continues: the first byte that did not fit,
+ * so it is reprocessed as the WHATWG decoder does.
+ */
+static size_t sequenceLength(const uint8_t* data, size_t size, size_t i, size_t* resume) {
+    uint8_t lead = data[i];
+    size_t need;
+    uint8_t lower = 0x80, upper = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        need = 1;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        need = 2;
+        if (lead == 0xE0) lower = 0xA0;       // Overlong
+        else if (lead == 0xED) upper = 0x9F;  // Surrogates
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        need = 3;
+        if (lead == 0xF0) lower = 0x90;       // Overlong
+        else if (lead == 0xF4) upper = 0x8F;  // Past U+10FFFF
+    } else {
+        *resume = i + 1;
+        return 0;
+    }
+
+    size_t j = i + 1;
+    for (size_t k = 0; k < need; k++, j++) {
+        if (j >= size || data[j] < lower || data[j] > upper) {
+            *resume = j;
+            return 0;
+        }
+        lower = 0x80;
+        upper = 0xBF;
+    }
+    return need + 1;
+}
+
+bool validate(const uint8_t* data, size_t size) {
+    size_t i = 0;
+    while (i < size) {
+        i += asciiPrefixLength(data + i, size - i);
+        if (i >= size) break;
+
+        size_t resume;
+        size_t length = sequenceLength(data, size, i, &resume);
+        if (length == 0) return false;
+        i += length;
+    }
+    return true;
+}
+
+std::string sanitize(const uint8_t* data, size_t size) {
+    static const char kReplacement[] = "\xEF\xBF\xBD";
+
+    std::string out;
+    out.reserve(size + size / 8);
+    size_t i = 0;
+    while (i < size) {
+        size_t ascii = asciiPrefixLength(data + i, size - i);
+        out.append(reinterpret_cast<const char*>(data + i), ascii);
+        i += ascii;
+        if (i >= size) break;
+
+        size_t resume;
+        size_t length = sequenceLength(data, size, i, &resume);
+        if (length > 0) {
+            out.append(reinterpret_cast<const char*>(data + i), length);
+            i += length;
+        } else {
+            out.append(kReplacement, 3);
+            i = resume;
+        }
+    }
+    return out;
+}
+
+void replaceSurrogates(std::string& text) {
+    size_t size = text.size();
+    for (size_t i = 0; i + 2 < size; i++) {
+        if (static_cast<uint8_t>(text[i]) == 0xED && static_cast<uint8_t>(text[i + 1]) >= 0xA0) {
+            text[i] = '\xEF';
+            text[i + 1] = '\xBF';
+            text[i + 2] = '\xBD';
+            i += 2;
+        }
+    }
+}
+
+}  // namespace utf8
+
+namespace base64 {
+
+static const char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+std::string encode(const uint8_t* data, size_t size) {
+    std::string out;
+    out.resize((size + 2) / 3 * 4);
+    char* p = &out[0];
+
+    size_t i = 0;
+    for (; i + 3 <= size; i += 3) {
+        uint32_t n = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8) | data[i + 2];
+        *p++ = kAlphabet[(n >> 18) & 63];
+        *p++ = kAlphabet[(n >> 12) & 63];
+        *p++ = kAlphabet[(n >> 6) & 63];
+        *p++ = kAlphabet[n & 63];
+    }
+    if (i < size) {
+        uint32_t n = uint32_t(data[i]) << 16;
+        if (i + 1 < size) n |= uint32_t(data[i + 1]) << 8;
+        *p++ = kAlphabet[(n >> 18) & 63];
+        *p++ = kAlphabet[(n >> 12) & 63];
+        *p++ = i + 1 < size ? kAlphabet[(n >> 6) & 63] : '=';
+        *p++ = '=';
+    }
+    return out;
+}
+
+bool decode(const std::string& input, std::vector<uint8_t>& out) {
+    static const struct Table {
+        int8_t values[256];
+        Table() {
+            std::memset(values, -1, sizeof(values));
+            for (int i = 0; i < 64; i++) values[static_cast<uint8_t>(kAlphabet[i])] = static_cast<int8_t>(i);
+        }
+    } table;
+
+    // Strip ASCII whitespace, then up to two '=' when the length is a multiple of 4
+    std::string text;
+    text.reserve(input.size());
+    for (char c : input) {
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\f' && c != '\r') text.push_back(c);
+    }
+    if (text.size() % 4 == 0 && !text.empty() && text.back() == '=') {
+        text.pop_back();
+        if (!text.empty() && text.back() == '=') text.pop_back();
+    }
+    if (text.size() % 4 == 1) {
+        return false;
+    }
+
+    out.clear();
+    out.reserve(text.size() * 3 / 4);
+    uint32_t buffer = 0;
+    int bits = 0;
+    for (char c : text) {
+        int8_t value = table.values[static_cast<uint8_t>(c)];
+        if (value < 0) return false;
+        buffer = (buffer << 6) | static_cast<uint32_t>(value);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out.push_back(static_cast<uint8_t>(buffer >> bits));
+        }
+    }
+    return true;
+}
+
+}  // namespace base64
+
+// ============================================================================
+// JS bindings
+// ============================================================================
+
+namespace {
+
+const char* kTextCodecSource = R"JS(
+(function() {
+    const UTF8_LABELS = ['utf-8', 'utf8', 'unicode-1-1-utf-8', 'unicode11utf8', 'unicode20utf8', 'x-unicode20utf8'];
+
+    function toBytes(input) {
+        if (input === undefined || input === null) return new Uint8Array(0);
+        if (input instanceof Uint8Array) return input;
+        if (ArrayBuffer.isView(input)) return new Uint8Array(input.buffer, input.byteOffset, input.byteLength);
+        if (input instanceof ArrayBuffer) return new Uint8Array(input);
+        if (typeof SharedArrayBuffer !== 'undefined' && input instanceof SharedArrayBuffer) return new Uint8Array(input);
+        throw new TypeError('TextDecoder.decode: input must be an ArrayBuffer or ArrayBufferView');
+    }
+
+    // Bytes at the end of a chunk that start a sequence completed by the next chunk
+    function incompleteTail(bytes) {
+        const n = bytes.length;
+        for (let k = 1; k <= 3 && k <= n; k++) {
+            const b = bytes[n - k];
+            if ((b & 0xC0) === 0x80) continue;
+            const need = b >= 0xF0 ? 4 : b >= 0xE0 ? 3 : b >= 0xC0 ? 2 : 1;
+            return need > k ? k : 0;
+        }
+        return 0;
+    }
+
+    class TextDecoder {
+        constructor(label = 'utf-8', options = {}) {
+            const name = String(label).trim().toLowerCase();
+            if (!UTF8_LABELS.includes(name)) {
+                throw new RangeError(`TextDecoder: encoding '${label}' is not supported`);
+            }
+            this._fatal = !!(options && options.fatal);
+            this._ignoreBOM = !!(options && options.ignoreBOM);
+            this._pending = null;
+            this._bomSeen = false;
+        }
+        get encoding() { return 'utf-8'; }
+        get fatal() { return this._fatal; }
+        get ignoreBOM() { return this._ignoreBOM; }
+
+        decode(input, options) {
+            let bytes = toBytes(input);
+            const stream = !!(options && options.stream);
+
+            if (this._pending) {
+                const merged = new Uint8Array(this._pending.length + bytes.length);
+                merged.set(this._pending);
+                merged.set(bytes, this._pending.length);
+                bytes = merged;
+                this._pending = null;
+            }
+            if (stream) {
+                const tail = incompleteTail(bytes);
+                if (tail) {
+                    this._pending = bytes.slice(bytes.length - tail);
+                    bytes = bytes.subarray(0, bytes.length - tail);
+                }
+            }
+
+            const result = __textDecode(bytes, this._fatal, this._ignoreBOM || this._bomSeen);
+            if (stream) {
+                if (bytes.length) this._bomSeen = true;
+            } else {
+                this._bomSeen = false;
+            }
+            if (result === null) {
+                this._pending = null;
+                throw new TypeError('TextDecoder: the encoded data was not valid utf-8');
+            }
+            return result;
+        }
+    }
+
+    class TextEncoder {
+        get encoding() { return 'utf-8'; }
+        encode(input = '') {
+            return __textEncode(String(input));
+        }
+        encodeInto(source, destination) {
+            if (!(destination instanceof Uint8Array)) {
+                throw new TypeError('TextEncoder.encodeInto: destination must be a Uint8Array');
+            }
+            return __textEncodeInto(String(source), destination);
+        }
+    }
+
+    function invalidCharacter(message) {
+        if (typeof DOMException === 'function') return new DOMException(message, 'InvalidCharacterError');
+        const error = new Error(message);
+        error.name = 'InvalidCharacterError';
+        return error;
+    }
+
+    globalThis.TextDecoder = TextDecoder;
+    globalThis.TextEncoder = TextEncoder;
+    globalThis.atob = function(data) {
+        const result = __atob(String(data));
+        if (result === null) throw invalidCharacter('atob: the string to be decoded is not correctly encoded');
+        return result;
+    };
+    globalThis.btoa = function(data) {
+        const result = __btoa(String(data));
+        if (result === null) throw invalidCharacter('btoa: the string contains characters outside of the Latin1 range');
+        return result;
+    };
+})();
+)JS";
+
+// Latin1 code points (one per byte) as UTF-8, for atob's binary strings
+std::string latin1ToUtf8(const uint8_t* data, size_t size) {
+    std::string out;
+    out.reserve(size + size / 2);
+    for (size_t i = 0; i < size; i++) {
+        uint8_t b = data[i];
+        if (b < 0x80) {
+            out.push_back(static_cast<char>(b));
+        } else {
+            out.push_back(static_cast<char>(0xC0 | (b >> 6)));
+            out.push_back(static_cast<char>(0x80 | (b & 0x3F)));
+        }
+    }
+    return out;
+}
+
+// The inverse for btoa; false if a code point is above U+00FF
+bool utf8ToLatin1(const std::string& text, std::vector<uint8_t>& out) {
+    out.clear();
+    out.reserve(text.size());
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(text.data());
+    size_t size = text.size();
+    for (size_t i = 0; i < size; i++) {
+        uint8_t b = p[i];
+        if (b < 0x80) {
+            out.push_back(b);
+        } else if ((b == 0xC2 || b == 0xC3) && i + 1 < size) {
+            out.push_back(static_cast<uint8_t>(((b & 0x03) << 6) | (p[++i] & 0x3F)));
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+void installTextCodec(Engine* engine) {
+    if (!engine) return;
+
+    // __textDecode(bytes, fatal, ignoreBOM) -> string, or null if fatal and invalid
+    engine->setGlobalProperty("__textDecode",
+        engine->newFunction("__textDecode", [engine](void* ctx, const std::vector<JSValueHandle>& args) {
+            size_t size = 0;
+            const uint8_t* data = args.empty() ? nullptr
+                : static_cast<const uint8_t*>(engine->getArrayBufferData(args[0], &size));
+            if (!data || size == 0) {
+                return engine->newString("");
+            }
+
+            bool fatal = args.size() > 1 && engine->toBoolean(args[1]);
+            bool ignoreBOM = args.size() > 2 && engine->toBoolean(args[2]);
+            if (!ignoreBOM && size >= 3 && data[0] == 0xEF && data[1] == 0xBB && data[2] == 0xBF) {
+                data += 3;
+                size -= 3;
+            }
+
+            if (utf8::validate(data, size)) {
+                return engine->newStringUtf8(reinterpret_cast<const char*>(data), size);
+            }
+            if (fatal) {
+                return engine->newNull();
+            }
+            std::string text = utf8::sanitize(data, size);
+            return engine->newStringUtf8(text.data(), text.size());
+        })
+    );
+
+    // __textEncode(string) -> Uint8Array
+    engine->setGlobalProperty("__textEncode",
+        engine->newFunction("__textEncode", [engine](void* ctx, const std::vector<JSValueHandle>& args) {
+            std::string text = args.empty() ? std::string() : engine->toString(args[0]);
+            utf8::replaceSurrogates(text);
+            return engine->createUint8Array(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+        })
+    );
+
+    // __textEncodeInto(string, Uint8Array) -> { read, written }
+    // Only whole code points are written; read counts UTF-16 code units
+    engine->setGlobalProperty("__textEncodeInto",
+        engine->newFunction("__textEncodeInto", [engine](void* ctx, const std::vector<JSValueHandle>& args) {
+            std::string text = args.empty() ? std::string() : engine->toString(args[0]);
+            utf8::replaceSurrogates(text);
+
+            size_t capacity = 0;
+            uint8_t* dest = args.size() > 1
+                ? static_cast<uint8_t*>(engine->getArrayBufferData(args[1], &capacity)) : nullptr;
+            if (!dest) capacity = 0;
+
+            const uint8_t* src = reinterpret_cast<const uint8_t*>(text.data());
+            size_t size = text.size();
+            size_t written = std::min(utf8::asciiPrefixLength(src, size), capacity);
+            size_t read = written;
+            if (written) std::memcpy(dest, src, written);
+
+            while (written < size) {
+                uint8_t lead = src[written];
+                size_t length = lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+                if (written + length > capacity) break;
+                std::memcpy(dest + written, src + written, length);
+                written += length;
+                read += length == 4 ? 2 : 1;
+            }
+
+            JSValueHandle result = engine->newObject();
+            engine->setProperty(result, "read", engine->newNumber(static_cast<double>(read)));
+            engine->setProperty(result, "written", engine->newNumber(static_cast<double>(written)));
+            return result;
+        })
+    );
+
+    // __atob(string) -> binary string, or null if not valid base64
+    engine->setGlobalProperty("__atob",
+        engine->newFunction("__atob", [engine](void* ctx, const std::vector<JSValueHandle>& args) {
+            std::vector<uint8_t> bytes;
+            if (args.empty() || !base64::decode(engine->toString(args[0]), bytes)) {
+                return engine->newNull();
+            }
+            std::string text = latin1ToUtf8(bytes.data(), bytes.size());
+            return engine->newStringUtf8(text.data(), text.size());
+        })
+    );
+
+    // __btoa(binary string) -> base64, or null if a character is outside Latin1
+    engine->setGlobalProperty("__btoa",
+        engine->newFunction("__btoa", [engine](void* ctx, const std::vector<JSValueHandle>& args) {
+            std::vector<uint8_t> bytes;
+            if (!utf8ToLatin1(args.empty() ? std::string() : engine->toString(args[0]), bytes)) {
+                return engine->newNull();
+            }
+            return engine->newString(base64::encode(bytes.data(), bytes.size()).c_str());
+        })
+    );
+
+    engine->eval(kTextCodecSource, "text-codec.js");
+}
+
+}  // namespace js
+}  // namespace mystral
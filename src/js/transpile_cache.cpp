@@ -0,0 +1,235 @@
+/**
+ * TranspileCache Implementation
+ *
+ * Disk entry layout (<key>.ts.js):
+ *   "mystral-transpile 1\n"
+ *   "<source bytes> <code bytes> <map bytes>\n"
+ *   code, then map
+ */
+
+#include "mystral/js/transpile_cache.h"
+#include "mystral/js/ts_transpiler.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <pwd.h>
+#endif
+
+namespace mystral {
+namespace js {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char* kEntryMagic = "mystral-transpile 1";
+
+constexpr uint64_t kFnvPrime = 0x100000001b3ULL;
+
+// FNV-1a, continued from hash
+uint64_t fnv1a(uint64_t hash, const std::string& data) {
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= kFnvPrime;
+    }
+    // Separator, so ("ab", "c") and ("a", "bc") differ
+    hash ^= 0xff;
+    hash *= kFnvPrime;
+    return hash;
+}
+
+std::string toHex(uint64_t value) {
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(value));
+    return buf;
+}
+
+}  // namespace
+
+void TranspileCache::setDirectory(const std::string& dir) {
+    directory_.clear();
+    if (dir.empty()) {
+        return;
+    }
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    if (!ec || fs::is_directory(dir, ec)) {
+        directory_ = dir;
+    }
+}
+
+TranspileCache::Key TranspileCache::makeKey(const std::string& filename, const std::string& source) {
+    // Two FNV-1a streams with different offset bases form a 128-bit key
+    Key key;
+    key.lo = 0xcbf29ce484222325ULL;
+    key.hi = 0x84222325cbf29ce4ULL;
+    for (const std::string* part : {&typeScriptTranspilerId(), &filename, &source}) {
+        key.lo = fnv1a(key.lo, *part);
+        key.hi = fnv1a(key.hi, *part);
+    }
+    return key;
+}
+
+std::string TranspileCache::entryPath(const Key& key) const {
+    return (fs::path(directory_) / (toHex(key.hi) + toHex(key.lo) + ".ts.js")).string();
+}
+
+bool TranspileCache::lookup(const std::string& filename, const std::string& source, Entry& out) {
+    Key key = makeKey(filename, source);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = memory_.find(filename);
+        if (it != memory_.end() && it->second.key == key) {
+            out = it->second.entry;
+            stats_.memoryHits++;
+            return true;
+        }
+    }
+
+    if (!directory_.empty() && readEntry(key, source.size(), out)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        memory_[filename] = {key, out};
+        stats_.diskHits++;
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.misses++;
+    return false;
+}
+
+void TranspileCache::store(const std::string& filename, const std::string& source, const Entry& entry) {
+    Key key = makeKey(filename, source);
+    bool written = !directory_.empty() && writeEntry(key, source.size(), entry);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    memory_[filename] = {key, entry};
+    if (written) {
+        stats_.diskWrites++;
+    }
+}
+
+TranspileCache::Stats TranspileCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+bool TranspileCache::readEntry(const Key& key, size_t sourceSize, Entry& out) const {
+    std::ifstream file(entryPath(key), std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::string magic;
+    std::string sizes;
+    if (!std::getline(file, magic) || magic != kEntryMagic || !std::getline(file, sizes)) {
+        return false;
+    }
+    unsigned long long storedSourceSize = 0;
+    unsigned long long codeSize = 0;
+    unsigned long long mapSize = 0;
+    std::istringstream sizeStream(sizes);
+    if (!(sizeStream >> storedSourceSize >> codeSize >> mapSize) || storedSourceSize != sourceSize) {
+        return false;
+    }
+
+    Entry entry;
+    entry.code.resize(static_cast<size_t>(codeSize));
+    entry.map.resize(static_cast<size_t>(mapSize));
+    if (!file.read(entry.code.data(), static_cast<std::streamsize>(codeSize)) ||
+        !file.read(entry.map.data(), static_cast<std::streamsize>(mapSize))) {
+        return false;  // Truncated
+    }
+
+    out = std::move(entry);
+    return true;
+}
+
+bool TranspileCache::writeEntry(const Key& key, size_t sourceSize, const Entry& entry) const {
+    static std::atomic<uint32_t> tempCounter{0};
+
+    std::string path = entryPath(key);
+    // Unique per process and thread, so concurrent writers never share a temp file
+    std::string tempPath = path + ".tmp" +
+        std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()) & 0xffffff) + "-" +
+        std::to_string(tempCounter.fetch_add(1));
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file << kEntryMagic << '\n'
+             << sourceSize << ' ' << entry.code.size() << ' ' << entry.map.size() << '\n';
+        file.write(entry.code.data(), static_cast<std::streamsize>(entry.code.size()));
+        file.write(entry.map.data(), static_cast<std::streamsize>(entry.map.size()));
+        if (!file) {
+            file.close();
+            std::error_code ec;
+            fs::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    // Readers see either no entry or a complete one
+    std::error_code ec;
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+std::string TranspileCache::defaultDirectory() {
+    std::string base;
+
+#ifdef _WIN32
+    char* localAppData = nullptr;
+    size_t len = 0;
+    if (_dupenv_s(&localAppData, &len, "LOCALAPPDATA") == 0 && localAppData) {
+        base = std::string(localAppData);
+        free(localAppData);
+    } else {
+        return "";
+    }
+    base += "\\Mystral\\cache\\transpile";
+#elif defined(__APPLE__)
+    const char* home = getenv("HOME");
+    if (!home) {
+        struct passwd* pw = getpwuid(getuid());
+        home = pw ? pw->pw_dir : nullptr;
+    }
+    if (!home) {
+        return "";
+    }
+    base = std::string(home) + "/Library/Caches/Mystral/transpile";
+#else
+    const char* xdgCache = getenv("XDG_CACHE_HOME");
+    if (xdgCache && xdgCache[0] != '\0') {
+        base = std::string(xdgCache) + "/mystral/transpile";
+    } else {
+        const char* home = getenv("HOME");
+        if (!home) {
+            struct passwd* pw = getpwuid(getuid());
+            home = pw ? pw->pw_dir : nullptr;
+        }
+        if (!home) {
+            return "";
+        }
+        base = std::string(home) + "/.cache/mystral/transpile";
+    }
+#endif
+
+    return base;
+}
+
+}  // namespace js
+}  // namespace mystral
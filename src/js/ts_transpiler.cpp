@@ -6,9 +6,20 @@
 #include "swc.h"
 #endif
 
+// Content hash of the linked SWC library, set by CMake
+#ifndef MYSTRAL_SWC_BUILD_ID
+#define MYSTRAL_SWC_BUILD_ID "unknown"
+#endif
+
 namespace mystral {
 namespace js {
 
+namespace {
+
+constexpr const char* kSourceMapMode = "none";
+
+}  // namespace
+
 bool isTypeScriptTranspilerAvailable() {
 #if defined(MYSTRAL_HAS_SWC)
     return true;
@@ -17,24 +28,33 @@ bool isTypeScriptTranspilerAvailable() {
 #endif
 }
 
+const std::string& typeScriptTranspilerId() {
+    static const std::string id = std::string("swc/") + MYSTRAL_SWC_BUILD_ID + " sourcemap=" + kSourceMapMode;
+    return id;
+}
+
 bool transpileTypeScript(const std::string& source,
                           const std::string& filename,
                           std::string& outJs,
-                          std::string& outError) {
+                          std::string& outError,
+                          std::string* outMap) {
     outJs.clear();
     outError.clear();
+    if (outMap) {
+        outMap->clear();
+    }
 
 #if defined(MYSTRAL_HAS_SWC)
     char* outCode = nullptr;
-    char* outMap = nullptr;
+    char* outMapText = nullptr;
     char* outErr = nullptr;
 
     int result = swc_transpile_ts(
         source.c_str(),
         filename.c_str(),
-        "none",
+        kSourceMapMode,
         &outCode,
-        &outMap,
+        &outMapText,
         &outErr);
 
     if (result != 0) {
@@ -47,8 +67,8 @@ bool transpileTypeScript(const std::string& source,
         if (outCode) {
             swc_free(outCode);
         }
-        if (outMap) {
-            swc_free(outMap);
+        if (outMapText) {
+            swc_free(outMapText);
         }
         return false;
     }
@@ -63,8 +83,11 @@ bool transpileTypeScript(const std::string& source,
         swc_free(outCode);
     }
 
-    if (outMap) {
-        swc_free(outMap);
+    if (outMapText) {
+        if (outMap) {
+            outMap->assign(outMapText);
+        }
+        swc_free(outMapText);
     }
 
     return true;
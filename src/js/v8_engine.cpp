@@ -28,10 +28,12 @@ static std::unique_ptr<v8::Platform> g_platform;
 static bool g_initialized = false;
 
 // Store native function callbacks
-static std::unordered_map<void*, NativeFunction> g_nativeFunctions;
+// Thread-local: worker threads run their own isolate (see workers::WorkerThread)
+static thread_local std::unordered_map<void*, NativeFunction> g_nativeFunctions;
 
-// Global set of protected handles that should not be deleted by nativeCallback cleanup
-static std::unordered_set<void*> g_protectedHandles;
+// Set of protected handles that should not be deleted by nativeCallback cleanup
+// Thread-local so handles from different isolates never mix
+static thread_local std::unordered_set<void*> g_protectedHandles;
 
 /**
  * Initialize V8 (call once at startup)
@@ -74,6 +76,7 @@ public:
         isolate_ = v8::Isolate::New(create_params);
         allocator_ = create_params.array_buffer_allocator;
         isolate_->SetData(0, this);
+        isolate_->SetAllowAtomicsWait(false);  // Until setAtomicsWaitAllowed() (workers)
 
         // Create context
         v8::Isolate::Scope isolate_scope(isolate_);
@@ -371,6 +374,18 @@ public:
         return {persistent, isolate_};
     }
 
+    JSValueHandle newStringUtf8(const char* data, size_t length) override {
+        v8::Isolate::Scope isolate_scope(isolate_);
+        v8::HandleScope handle_scope(isolate_);
+        v8::Local<v8::String> str;
+        if (!v8::String::NewFromUtf8(isolate_, data, v8::NewStringType::kNormal, static_cast<int>(length)).ToLocal(&str)) {
+            str = v8::String::Empty(isolate_);  // Over V8's maximum string length
+        }
+        v8::Persistent<v8::Value>* persistent = new v8::Persistent<v8::Value>(isolate_, str);
+        frameHandles_.insert(persistent);
+        return {persistent, isolate_};
+    }
+
     JSValueHandle newObject() override {
         v8::Isolate::Scope isolate_scope(isolate_);
         v8::HandleScope handle_scope(isolate_);
@@ -437,6 +452,93 @@ public:
         return {persistent, isolate_};
     }
 
+    std::shared_ptr<BackingStore> detachArrayBuffer(JSValueHandle value) override {
+        v8::Isolate::Scope isolate_scope(isolate_);
+        v8::HandleScope handle_scope(isolate_);
+
+        v8::Persistent<v8::Value>* persistent = (v8::Persistent<v8::Value>*)value.ptr;
+        if (!persistent) return nullptr;
+
+        v8::Local<v8::Value> val = persistent->Get(isolate_);
+        if (!val->IsArrayBuffer()) return nullptr;
+
+        v8::Local<v8::ArrayBuffer> arrayBuffer = val.As<v8::ArrayBuffer>();
+        if (!arrayBuffer->IsDetachable()) return nullptr;
+
+        // The V8 backing store is refcounted and isolate-independent: keep a
+        // reference in the release callback and detach the JS object.
+        std::shared_ptr<v8::BackingStore> backingStore = arrayBuffer->GetBackingStore();
+        if (arrayBuffer->Detach(v8::Local<v8::Value>()).IsNothing()) return nullptr;
+
+        auto store = std::make_shared<BackingStore>();
+        store->data = backingStore->Data();
+        store->length = backingStore->ByteLength();
+        store->release = [backingStore](void*) mutable { backingStore.reset(); };
+        return store;
+    }
+
+    JSValueHandle newArrayBufferFromStore(std::shared_ptr<BackingStore> store) override {
+        if (!store) return newNull();
+
+        v8::Isolate::Scope isolate_scope(isolate_);
+        v8::HandleScope handle_scope(isolate_);
+        v8::Local<v8::Context> context = context_.Get(isolate_);
+        v8::Context::Scope context_scope(context);
+
+        auto* holder = new std::shared_ptr<BackingStore>(std::move(store));
+        std::unique_ptr<v8::BackingStore> backingStore = v8::ArrayBuffer::NewBackingStore(
+            (*holder)->data, (*holder)->length,
+            [](void*, size_t, void* deleterData) {
+                delete static_cast<std::shared_ptr<BackingStore>*>(deleterData);
+            },
+            holder);
+
+        v8::Local<v8::ArrayBuffer> arrayBuffer = v8::ArrayBuffer::New(
+            isolate_, std::move(backingStore));
+
+        v8::Persistent<v8::Value>* persistent = new v8::Persistent<v8::Value>(isolate_, arrayBuffer);
+        frameHandles_.insert(persistent);
+        return {persistent, isolate_};
+    }
+
+    std::shared_ptr<BackingStore> getSharedArrayBufferStore(JSValueHandle value) override {
+        v8::Isolate::Scope isolate_scope(isolate_);
+        v8::HandleScope handle_scope(isolate_);
+
+        v8::Persistent<v8::Value>* persistent = (v8::Persistent<v8::Value>*)value.ptr;
+        if (!persistent) return nullptr;
+
+        v8::Local<v8::Value> val = persistent->Get(isolate_);
+        if (!val->IsSharedArrayBuffer()) return nullptr;
+
+        // Shared backing stores are process-wide; other isolates wrap the same one
+        std::shared_ptr<v8::BackingStore> backingStore = val.As<v8::SharedArrayBuffer>()->GetBackingStore();
+        auto store = std::make_shared<BackingStore>();
+        store->data = backingStore->Data();
+        store->length = backingStore->ByteLength();
+        store->owner = backingStore;
+        return store;
+    }
+
+    JSValueHandle newSharedArrayBuffer(std::shared_ptr<BackingStore> store) override {
+        auto backingStore = store ? std::static_pointer_cast<v8::BackingStore>(store->owner) : nullptr;
+        if (!backingStore) return newNull();
+
+        v8::Isolate::Scope isolate_scope(isolate_);
+        v8::HandleScope handle_scope(isolate_);
+        v8::Local<v8::Context> context = context_.Get(isolate_);
+        v8::Context::Scope context_scope(context);
+
+        v8::Local<v8::SharedArrayBuffer> buffer = v8::SharedArrayBuffer::New(isolate_, backingStore);
+        v8::Persistent<v8::Value>* persistent = new v8::Persistent<v8::Value>(isolate_, buffer);
+        frameHandles_.insert(persistent);
+        return {persistent, isolate_};
+    }
+
+    void setAtomicsWaitAllowed(bool allowed) override {
+        isolate_->SetAllowAtomicsWait(allowed);
+    }
+
     void* getArrayBufferData(JSValueHandle value, size_t* size) override {
         v8::Isolate::Scope isolate_scope(isolate_);
         v8::HandleScope handle_scope(isolate_);
@@ -454,6 +556,12 @@ public:
             return backingStore->Data();
         }
 
+        if (val->IsSharedArrayBuffer()) {
+            std::shared_ptr<v8::BackingStore> backingStore = val.As<v8::SharedArrayBuffer>()->GetBackingStore();
+            if (size) *size = backingStore->ByteLength();
+            return backingStore->Data();
+        }
+
         // Check if it's a TypedArray
         if (val->IsTypedArray()) {
             v8::Local<v8::TypedArray> typedArray = val.As<v8::TypedArray>();
@@ -592,7 +700,7 @@ public:
             return "";
         }
         v8::String::Utf8Value utf8(isolate_, str);
-        return *utf8 ? *utf8 : "";
+        return *utf8 ? std::string(*utf8, utf8.length()) : "";
     }
 
     bool isUndefined(JSValueHandle value) override {
@@ -772,10 +880,28 @@ public:
         delete persistent;
     }
 
+    void releaseHandle(JSValueHandle value) override {
+        if (!value.ptr || g_protectedHandles.count(value.ptr)) return;
+        auto* persistent = (v8::Persistent<v8::Value>*)value.ptr;
+        if (frameHandles_.erase(persistent) == 0) return;  // Not ours to free
+        persistent->Reset();
+        delete persistent;
+    }
+
     void gc() override {
         isolate_->LowMemoryNotification();
     }
 
+    HeapStats getHeapStats() override {
+        v8::HeapStatistics heap;
+        isolate_->GetHeapStatistics(&heap);
+        HeapStats stats;
+        stats.usedBytes = heap.used_heap_size();
+        stats.totalBytes = heap.total_heap_size();
+        stats.limitBytes = heap.heap_size_limit();
+        return stats;
+    }
+
     void beginFrame() override {
         inFrame_ = true;
         isolate_->SetIdle(false);
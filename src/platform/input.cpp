@@ -6,6 +6,7 @@
 
 #include "mystral/platform/input.h"
 #include <SDL3/SDL.h>
+#include <algorithm>
 #include <iostream>
 #include <unordered_map>
 #include <vector>
@@ -34,6 +35,21 @@ static bool g_metaKey = false;
 // Mouse button state
 static int g_mouseButtons = 0;
 
+// Motion coalescing: moves between flushes become one mousemove/pointermove
+static bool g_coalesceMotion = true;
+static std::vector<PointerSample> g_motionSamples;     // Pending since the last flush
+static std::vector<PointerSample> g_predictedSamples;  // Reused for each dispatch
+
+// Prediction extrapolates at most this far past the last sample
+static constexpr double kPredictionHorizonMs = 8.0;
+static constexpr size_t kMaxPredictedSamples = 3;
+
+static_assert(sizeof(PointerSample) == 5 * sizeof(double), "PointerSample must map onto a Float64Array");
+
+// Polling state shared with JS (zero-initialized static storage)
+static InputState g_inputState;
+static int g_gamepadGeneration = 0;
+
 /**
  * SDL key to DOM "key" property
  */
@@ -283,45 +299,69 @@ void setResizeCallback(ResizeCallback callback) {
     g_resizeCallback = callback;
 }
 
-/**
- * Process keyboard event
- */
-void processKeyboardEvent(const SDL_KeyboardEvent& event, bool isDown) {
-    if (!g_keyboardCallback) return;
+InputState& getInputState() {
+    return g_inputState;
+}
 
-    updateModifiers(event.mod);
+void beginInputFrame() {
+    g_inputState.values[InputState::MovementX] = 0;
+    g_inputState.values[InputState::MovementY] = 0;
+    g_inputState.values[InputState::WheelX] = 0;
+    g_inputState.values[InputState::WheelY] = 0;
+}
 
-    KeyboardEventData data;
-    data.type = isDown ? "keydown" : "keyup";
-    data.key = sdlKeyToDOMKey(event.key);
-    data.code = sdlKeyToDOMCode(event.key, event.scancode);
-    data.keyCode = event.key;  // Legacy
-    data.repeat = event.repeat;
-    data.ctrlKey = g_ctrlKey;
-    data.shiftKey = g_shiftKey;
-    data.altKey = g_altKey;
-    data.metaKey = g_metaKey;
+void setMotionCoalescing(bool enabled) {
+    if (!enabled) flushPointerMotion();
+    g_coalesceMotion = enabled;
+}
 
-    // If shift is held and it's a letter, uppercase it
-    if (g_shiftKey && data.key.length() == 1 && data.key[0] >= 'a' && data.key[0] <= 'z') {
-        data.key[0] = data.key[0] - 32;  // Convert to uppercase
+/**
+ * Extrapolate the motion in samples linearly, spaced like the input samples
+ */
+static void predictMotion(const PointerSample* samples, size_t count) {
+    g_predictedSamples.clear();
+    if (count < 2) return;
+
+    const PointerSample& first = samples[0];
+    const PointerSample& last = samples[count - 1];
+    double span = last.timeStamp - first.timeStamp;
+    if (span <= 0) return;
+
+    double interval = span / (count - 1);
+    double vx = (last.clientX - first.clientX) / span;
+    double vy = (last.clientY - first.clientY) / span;
+    for (size_t i = 1; i <= kMaxPredictedSamples && interval * i <= kPredictionHorizonMs; i++) {
+        PointerSample p;
+        p.clientX = last.clientX + vx * interval * i;
+        p.clientY = last.clientY + vy * interval * i;
+        p.movementX = vx * interval;
+        p.movementY = vy * interval;
+        p.timeStamp = last.timeStamp + interval * i;
+        g_predictedSamples.push_back(p);
     }
-
-    g_keyboardCallback(data);
 }
 
 /**
- * Process mouse motion event
+ * Dispatch one mousemove/pointermove for a run of motion samples
+ * Position is the last sample's; movement is summed over all of them.
  */
-void processMouseMotion(const SDL_MouseMotionEvent& event) {
+static void dispatchMotion(const PointerSample* samples, size_t count) {
+    const PointerSample& last = samples[count - 1];
+    double movementX = 0;
+    double movementY = 0;
+    for (size_t i = 0; i < count; i++) {
+        movementX += samples[i].movementX;
+        movementY += samples[i].movementY;
+    }
+
     // Dispatch mouse event
     if (g_mouseCallback) {
         MouseEventData data;
         data.type = "mousemove";
-        data.clientX = event.x;
-        data.clientY = event.y;
-        data.movementX = event.xrel;
-        data.movementY = event.yrel;
+        data.clientX = last.clientX;
+        data.clientY = last.clientY;
+        data.movementX = movementX;
+        data.movementY = movementY;
         data.button = 0;
         data.buttons = g_mouseButtons;
         data.ctrlKey = g_ctrlKey;
@@ -334,12 +374,14 @@ void processMouseMotion(const SDL_MouseMotionEvent& event) {
 
     // Dispatch pointer event
     if (g_pointerCallback) {
+        predictMotion(samples, count);
+
         PointerEventData data;
         data.type = "pointermove";
-        data.clientX = event.x;
-        data.clientY = event.y;
-        data.movementX = event.xrel;
-        data.movementY = event.yrel;
+        data.clientX = last.clientX;
+        data.clientY = last.clientY;
+        data.movementX = movementX;
+        data.movementY = movementY;
         data.button = 0;
         data.buttons = g_mouseButtons;
         data.ctrlKey = g_ctrlKey;
@@ -352,15 +394,83 @@ void processMouseMotion(const SDL_MouseMotionEvent& event) {
         data.width = 1;
         data.height = 1;
         data.pressure = g_mouseButtons ? 0.5 : 0;
+        data.coalesced = samples;
+        data.coalescedCount = count;
+        data.predicted = g_predictedSamples.data();
+        data.predictedCount = g_predictedSamples.size();
 
         g_pointerCallback(data);
     }
 }
 
+void flushPointerMotion() {
+    if (g_motionSamples.empty()) return;
+    dispatchMotion(g_motionSamples.data(), g_motionSamples.size());
+    g_motionSamples.clear();
+}
+
+/**
+ * Process keyboard event
+ */
+void processKeyboardEvent(const SDL_KeyboardEvent& event, bool isDown) {
+    // Queued motion happened before this key: deliver it first
+    flushPointerMotion();
+
+    updateModifiers(event.mod);
+    if (event.scancode < InputState::kKeyCount) {
+        g_inputState.keys[event.scancode] = isDown ? 1 : 0;
+    }
+
+    if (!g_keyboardCallback) return;
+
+    KeyboardEventData data;
+    data.type = isDown ? "keydown" : "keyup";
+    data.key = sdlKeyToDOMKey(event.key);
+    data.code = sdlKeyToDOMCode(event.key, event.scancode);
+    data.keyCode = event.key;  // Legacy
+    data.repeat = event.repeat;
+    data.ctrlKey = g_ctrlKey;
+    data.shiftKey = g_shiftKey;
+    data.altKey = g_altKey;
+    data.metaKey = g_metaKey;
+
+    // If shift is held and it's a letter, uppercase it
+    if (g_shiftKey && data.key.length() == 1 && data.key[0] >= 'a' && data.key[0] <= 'z') {
+        data.key[0] = data.key[0] - 32;  // Convert to uppercase
+    }
+
+    g_keyboardCallback(data);
+}
+
+/**
+ * Process mouse motion event
+ */
+void processMouseMotion(const SDL_MouseMotionEvent& event) {
+    PointerSample sample;
+    sample.clientX = event.x;
+    sample.clientY = event.y;
+    sample.movementX = event.xrel;
+    sample.movementY = event.yrel;
+    sample.timeStamp = event.timestamp / 1e6;  // SDL timestamps are nanoseconds
+
+    g_inputState.values[InputState::MouseX] = event.x;
+    g_inputState.values[InputState::MouseY] = event.y;
+    g_inputState.values[InputState::MovementX] += event.xrel;
+    g_inputState.values[InputState::MovementY] += event.yrel;
+
+    if (!g_coalesceMotion) {
+        dispatchMotion(&sample, 1);
+        return;
+    }
+    g_motionSamples.push_back(sample);
+}
+
 /**
  * Process mouse button event
  */
 void processMouseButton(const SDL_MouseButtonEvent& event, bool isDown) {
+    flushPointerMotion();
+
     // Map SDL button to DOM button
     int domButton = 0;
     int buttonBit = 1;
@@ -378,6 +488,7 @@ void processMouseButton(const SDL_MouseButtonEvent& event, bool isDown) {
     } else {
         g_mouseButtons &= ~buttonBit;
     }
+    g_inputState.values[InputState::MouseButtons] = g_mouseButtons;
 
     // Dispatch mouse event
     if (g_mouseCallback) {
@@ -432,6 +543,12 @@ void processMouseButton(const SDL_MouseButtonEvent& event, bool isDown) {
  * Process mouse wheel event
  */
 void processMouseWheel(const SDL_MouseWheelEvent& event) {
+    flushPointerMotion();
+
+    // Same sign and scale as WheelEvent.deltaX/deltaY below
+    g_inputState.values[InputState::WheelX] += event.x * -120.0f;
+    g_inputState.values[InputState::WheelY] += event.y * -120.0f;
+
     if (!g_wheelCallback) return;
 
     // Get current mouse position
@@ -468,6 +585,7 @@ void processGamepadConnected(SDL_JoystickID id) {
 
     g_gamepads[id] = gamepad;
     g_gamepadOrder.push_back(id);
+    g_inputState.values[InputState::GamepadGeneration] = ++g_gamepadGeneration;
 
     if (g_gamepadCallback) {
         GamepadEventData data;
@@ -532,6 +650,7 @@ void processGamepadDisconnected(SDL_JoystickID id) {
             break;
         }
     }
+    g_inputState.values[InputState::GamepadGeneration] = ++g_gamepadGeneration;
 }
 
 /**
@@ -548,27 +667,21 @@ void processResize(int width, int height) {
 }
 
 /**
- * Get gamepad state
+ * Gamepad at a W3C index, or nullptr
  */
-bool getGamepadState(int index, GamepadState* state) {
+static SDL_Gamepad* gamepadAt(int index) {
     if (index < 0 || index >= (int)g_gamepadOrder.size()) {
-        return false;
+        return nullptr;
     }
 
-    SDL_JoystickID id = g_gamepadOrder[index];
-    auto it = g_gamepads.find(id);
-    if (it == g_gamepads.end()) {
-        return false;
-    }
-
-    SDL_Gamepad* gamepad = it->second;
-
-    state->index = index;
-    state->id = SDL_GetGamepadName(gamepad);
-    state->connected = true;
-    state->numAxes = 6;
-    state->numButtons = 17;
+    auto it = g_gamepads.find(g_gamepadOrder[index]);
+    return it != g_gamepads.end() ? it->second : nullptr;
+}
 
+/**
+ * Read axes and buttons (standard mapping) into state
+ */
+static void readGamepadInputs(SDL_Gamepad* gamepad, GamepadState* state) {
     // Standard gamepad mapping (matches W3C Gamepad API)
     // Axes: leftStickX, leftStickY, rightStickX, rightStickY, leftTrigger, rightTrigger
     state->axes[0] = SDL_GetGamepadAxis(gamepad, SDL_GAMEPAD_AXIS_LEFTX) / 32767.0;
@@ -618,10 +731,57 @@ bool getGamepadState(int index, GamepadState* state) {
             state->buttonValues[i] = 0.0;
         }
     }
+}
+
+/**
+ * Get gamepad state
+ */
+bool getGamepadState(int index, GamepadState* state) {
+    SDL_Gamepad* gamepad = gamepadAt(index);
+    if (!gamepad) {
+        return false;
+    }
+
+    state->index = index;
+    state->id = SDL_GetGamepadName(gamepad);
+    state->connected = true;
+    state->numAxes = 6;
+    state->numButtons = 17;
+    readGamepadInputs(gamepad, state);
 
     return true;
 }
 
+/**
+ * Update gamepad slots of the input state
+ */
+void updateGamepadState() {
+    for (size_t i = 0; i < InputState::kMaxGamepads; i++) {
+        float* slot = g_inputState.values + InputState::GamepadBase + i * InputState::kGamepadStride;
+        SDL_Gamepad* gamepad = gamepadAt((int)i);
+        if (!gamepad) {
+            if (slot[0] != 0) {
+                std::fill(slot, slot + InputState::kGamepadStride, 0.0f);
+            }
+            continue;
+        }
+
+        // Inputs only: the name lookup would allocate every frame
+        GamepadState state;
+        readGamepadInputs(gamepad, &state);
+
+        slot[0] = 1;
+        float* axes = slot + 1;
+        for (size_t a = 0; a < InputState::kGamepadAxes; a++) {
+            axes[a] = (float)state.axes[a];
+        }
+        float* buttons = axes + InputState::kGamepadAxes;
+        for (size_t b = 0; b < InputState::kGamepadButtons; b++) {
+            buttons[b] = (float)state.buttonValues[b];
+        }
+    }
+}
+
 /**
  * Get gamepad count
  */
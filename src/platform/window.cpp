@@ -135,12 +135,15 @@ void destroyWindow() {
  * @return false if quit event received
  */
 bool pollEvents() {
+    beginInputFrame();
+
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
         switch (event.type) {
             case SDL_EVENT_QUIT:
                 std::cout << "[Window] Quit event received" << std::endl;
                 g_window.shouldQuit = true;
+                flushPointerMotion();  // Deliver motion coalesced before the quit
                 return false;
 
             case SDL_EVENT_WINDOW_RESIZED:
@@ -184,9 +187,21 @@ bool pollEvents() {
         }
     }
 
+    // One mousemove/pointermove per poll for all motion this frame
+    flushPointerMotion();
+    updateGamepadState();
+
     return !g_window.shouldQuit;
 }
 
+/**
+ * Wait for an SDL event without consuming it
+ * @return true if an event is waiting
+ */
+bool waitForEvent(int timeoutMs) {
+    return SDL_WaitEventTimeout(nullptr, timeoutMs);
+}
+
 /**
  * Check if window should quit
  */
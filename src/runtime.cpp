@@ -3,7 +3,10 @@
 #include "mystral/platform/input.h"
 #include "mystral/webgpu/context.h"
 #include "mystral/js/engine.h"
+#include "mystral/js/event_listeners.h"
 #include "mystral/js/module_system.h"
+#include "mystral/js/structured_clone.h"
+#include "mystral/js/text_codec.h"
 #include "mystral/http/http_client.h"
 #include "mystral/http/async_http_client.h"
 #include "mystral/fs/async_file.h"
@@ -12,6 +15,17 @@
 #include "mystral/audio/audio_bindings.h"
 #include "mystral/vfs/embedded_bundle.h"
 #include "mystral/async/event_loop.h"
+#include "mystral/async/fetch_bindings.h"
+#include "mystral/async/frame_scheduler.h"
+#include "mystral/async/runtime_clock.h"
+#include "mystral/async/timer_queue.h"
+#include "mystral/debug/frame_stats.h"
+#include "mystral/debug/performance_timeline.h"
+#include "mystral/debug/trace.h"
+#include "mystral/workers/worker_registry.h"
+#include "mystral/workers/atomics_wait.h"
+#include "mystral/jobs/job_system.h"
+#include "mystral/jobs/job_bindings.h"
 #include "storage/local_storage.h"
 
 // Ray tracing bindings (conditional)
@@ -41,7 +55,10 @@
 #include <chrono>
 #include <memory>
 #include <vector>
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <unordered_map>
 #include <unordered_set>
 #include <queue>
 #include <mutex>
@@ -149,8 +166,13 @@ static void installCrashHandlers() {
 namespace webgpu {
     bool initBindings(js::Engine* engine, void* wgpuInstance, void* wgpuDevice, void* wgpuQueue, void* wgpuSurface, uint32_t surfaceFormat, uint32_t width, uint32_t height, bool debug = false);
     void setOffscreenTexture(void* texture, void* textureView);
+    void setDeviceThreadSafe(bool threadSafe);
     void beginDawnFrame();
     void endDawnFrame();
+    uint64_t gpuMemoryBytes();
+    void getGpuCounters(uint64_t& drawCalls, uint64_t& dispatches, uint64_t& submits);
+    void resetGpuCounters();
+    void resetCanvasControl();
 }
 
 /**
@@ -163,7 +185,13 @@ public:
         , running_(true)  // Start as running so pollEvents() works without run()
         , width_(config.width)
         , height_(config.height)
-    {}
+        , frameStats_(config.frameStatsWindow)
+    {
+        frameScheduler_.setTargetFrameRate(config.maxFps);
+        if (config.virtualTime) {
+            async::RuntimeClock::instance().enableVirtualTime(config.fixedDtMs);
+        }
+    }
 
     ~RuntimeImpl() override {
         shutdown();
@@ -171,6 +199,7 @@ public:
 
     bool initialize() {
         std::cout << "[Mystral] Initializing runtime..." << std::endl;
+        initStartNs_ = debug::trace::nowNs();
         std::cout << "[Mystral] Window: " << width_ << "x" << height_ << std::endl;
 
         // NOTE: Crash handlers are installed AFTER full initialization
@@ -380,6 +409,9 @@ public:
 
     // Helper method to initialize JS engine and bindings (shared by SDL and no-SDL paths)
     bool initializeJSAndBindings() {
+        uint64_t jsInitStart = debug::trace::nowNs();
+        gpuInitMs_ = (jsInitStart - initStartNs_) / 1e6;
+
         // Initialize JavaScript engine
         LOGI("Creating JavaScript engine...");
         jsEngine_ = js::createEngine();
@@ -403,15 +435,27 @@ public:
         // Set up Node.js-compatible process object (process.exit, etc.)
         setupProcess();
 
+        // TextEncoder/TextDecoder and atob/btoa (Response.text() and the loaders depend on them)
+        js::installTextCodec(jsEngine_.get());
+
         // Set up fetch API
         setupFetch();
 
         // Set up file system and path APIs (fs.readFile, path.join, etc.)
         setupFileSystem();
 
-        // Set up URL parsing and Worker polyfill (needed for Draco decoder, etc.)
+        // Set up URL parsing (blob: URLs are used to create workers)
         setupURL();
 
+        // structuredClone() - also the serializer behind Worker.postMessage
+        js::installStructuredClone(jsEngine_.get());
+
+        // Set up Web Workers on native threads (needed for Draco decoder, etc.)
+        setupWorkers();
+
+        // Set up the native job pool (mystral.jobs.parallelFor, background decoding)
+        jobs::initializeJobBindings(jsEngine_.get());
+
         // Set up module system (ESM/CJS resolution)
         setupModules();
 
@@ -440,6 +484,8 @@ public:
             std::cerr << "[Mystral] Failed to initialize WebGPU bindings" << std::endl;
             return false;
         }
+        // Workers get a device proxy for command encoding only when the device allows it
+        webgpu::setDeviceThreadSafe(webgpu_->hasThreadSafeDevice());
 
         // In no-SDL mode, set the offscreen texture for headless rendering
         if (config_.noSdl) {
@@ -468,6 +514,7 @@ public:
         // Initialize file watcher (uses libuv fs_event for hot reload)
         fs::getFileWatcher().init();
 
+        jsInitMs_ = (debug::trace::nowNs() - jsInitStart) / 1e6;
         std::cout << "[Mystral] Runtime initialized" << std::endl;
         return true;
     }
@@ -491,6 +538,28 @@ public:
         // Shutdown file watcher
         fs::getFileWatcher().shutdown();
 
+        // Stop all worker threads (each owns its own JS engine)
+        workers::WorkerRegistry::instance().shutdown();
+
+        // Stop the job pool; undelivered completions (and their JS callbacks) are dropped
+        jobs::JobSystem::instance().shutdown();
+        if (jsEngine_ && workerDispatch_.ptr) {
+            jsEngine_->unprotect(workerDispatch_);
+            workerDispatch_ = {};
+        }
+        if (jsEngine_) {
+            for (auto* factory : {&makeKeyboardEvent_, &makeMouseEvent_, &makePointerEvent_, &makeWheelEvent_}) {
+                if (factory->ptr) {
+                    jsEngine_->unprotect(*factory);
+                    *factory = {};
+                }
+            }
+            for (auto& typeString : eventTypeStrings_) {
+                if (typeString.ptr) jsEngine_->unprotect(typeString);
+            }
+            eventTypeStrings_.clear();
+        }
+
 #ifdef MYSTRAL_USE_LIBUV_TIMERS
         // Clean up libuv timers before shutting down the event loop
         for (auto& [id, ctx] : uvTimers_) {
@@ -517,17 +586,14 @@ public:
         rafCallbacks_.clear();
 
         // Unprotect all timer callbacks before clearing
-#ifndef MYSTRAL_USE_LIBUV_TIMERS
-        if (jsEngine_) {
-            for (auto& timer : timerCallbacks_) {
-                if (!timer.cancelled) {
-                    jsEngine_->unprotect(timer.callback);
-                }
+#ifdef MYSTRAL_USE_LIBUV_TIMERS
+        cancelledTimerIds_.clear();
+#endif
+        for (auto& callback : timerQueue_.clear()) {
+            if (jsEngine_) {
+                jsEngine_->unprotect(callback);
             }
         }
-        timerCallbacks_.clear();
-#endif
-        cancelledTimerIds_.clear();
 
         if (moduleSystem_) {
             moduleSystem_->clearCaches();
@@ -564,23 +630,14 @@ public:
         // Store script path for reloading
         scriptPath_ = path;
 
-        // Set up file watching if watch mode is enabled
-        if (config_.watch && fs::getFileWatcher().isReady()) {
-            if (watchId_ >= 0) {
-                fs::getFileWatcher().unwatch(watchId_);
-            }
-            watchId_ = fs::getFileWatcher().watch(path, [this](const std::string& changedPath, fs::FileChangeType type) {
-                if (type == fs::FileChangeType::Modified || type == fs::FileChangeType::Renamed) {
-                    std::cout << "[HotReload] File changed: " << changedPath << std::endl;
-                    reloadRequested_ = true;
-                }
-            });
-            if (watchId_ >= 0) {
-                std::cout << "[HotReload] Watching for changes: " << path << std::endl;
-            }
-        }
+        uint64_t loadStart = debug::trace::nowNs();
+        bool loaded = moduleSystem_->loadEntry(path);
+        scriptLoadMs_ = (debug::trace::nowNs() - loadStart) / 1e6;
+        logModuleLoadStats();
 
-        return moduleSystem_->loadEntry(path);
+        // Watch mode: watch every module the script loaded
+        watchLoadedModules();
+        return loaded;
     }
 
     bool evalScript(const std::string& code, const std::string& filename) override {
@@ -612,6 +669,12 @@ public:
         }
         rafCallbacks_.clear();
 
+        // Stop workers started by the previous script
+        workers::WorkerRegistry::instance().terminateAll();
+
+        // The new script may transfer or draw on the main canvas again
+        webgpu::resetCanvasControl();
+
         // Clear module caches so script is re-read from disk
         if (moduleSystem_) {
             moduleSystem_->clearCaches();
@@ -619,6 +682,8 @@ public:
 
         // Reload the script
         bool success = moduleSystem_->loadEntry(scriptPath_);
+        logModuleLoadStats();
+        watchLoadedModules();
 
         if (success) {
             std::cout << "[HotReload] Script reloaded successfully" << std::endl;
@@ -630,6 +695,106 @@ public:
     }
 
 private:
+    // ========================================================================
+    // Hot Reload (watch mode)
+    //
+    // Every loaded module file is watched. Changes are batched until files
+    // stop changing for kHotReloadDebounceNs, then handed to the module
+    // system, which re-runs only the changed modules and their importers up
+    // to modules that accept the update (module.hot / import.meta.hot).
+    // Timers, rAF callbacks and other state survive; if nothing accepts an
+    // update, the whole script is reloaded as before.
+    // ========================================================================
+
+    static constexpr uint64_t kHotReloadDebounceNs = 50'000'000;
+
+    void watchLoadedModules() {
+        if (!config_.watch || !moduleSystem_ || !fs::getFileWatcher().isReady() ||
+            moduleSystem_->resolver().usingBundle()) {
+            return;
+        }
+
+        size_t added = 0;
+        for (const auto& path : moduleSystem_->loadedPaths()) {
+            if (moduleWatchIds_.count(path) > 0 || path.find("/node_modules/") != std::string::npos) {
+                continue;
+            }
+            int watchId = fs::getFileWatcher().watch(path, [this](const std::string& changedPath, fs::FileChangeType type) {
+                onModuleFileChanged(changedPath, type);
+            });
+            if (watchId >= 0) {
+                moduleWatchIds_[path] = watchId;
+                added++;
+            }
+        }
+        if (added > 0) {
+            std::cout << "[HotReload] Watching " << moduleWatchIds_.size() << " module files for changes" << std::endl;
+        }
+    }
+
+    void onModuleFileChanged(const std::string& path, fs::FileChangeType type) {
+        if (moduleSystem_) {
+            moduleSystem_->resolver().invalidate(path);
+        }
+        if (pendingModuleChanges_.insert(path).second) {
+            std::cout << "[HotReload] File " << (type == fs::FileChangeType::Deleted ? "deleted: " : "changed: ")
+                      << path << std::endl;
+        }
+        lastModuleChangeNs_ = debug::trace::nowNs();
+    }
+
+    void applyModuleChanges() {
+        std::vector<std::string> changed(pendingModuleChanges_.begin(), pendingModuleChanges_.end());
+        pendingModuleChanges_.clear();
+
+        // Editors that save by renaming replace the watched file; watch it afresh
+        for (const auto& path : changed) {
+            auto it = moduleWatchIds_.find(path);
+            if (it != moduleWatchIds_.end()) {
+                fs::getFileWatcher().unwatch(it->second);
+                moduleWatchIds_.erase(it);
+            }
+        }
+
+        uint64_t start = debug::trace::nowNs();
+        js::HotUpdateResult update = moduleSystem_->applyHotUpdate(changed);
+        switch (update.kind) {
+            case js::HotUpdateResult::Kind::Applied:
+                std::cout << "[HotReload] Updated " << update.modulesReevaluated << " module(s) in "
+                          << (debug::trace::nowNs() - start) / 1e6 << " ms" << std::endl;
+                break;
+            case js::HotUpdateResult::Kind::FullReload:
+                std::cout << "[HotReload] Full reload: " << update.reason << std::endl;
+                reloadScript();
+                break;
+            case js::HotUpdateResult::Kind::NoChange:
+                break;
+        }
+        watchLoadedModules();
+    }
+
+    void logModuleLoadStats() {
+        if (!config_.debug || !moduleSystem_) return;
+        const js::ModulePrefetchStats& prefetch = moduleSystem_->prefetchStats();
+        std::cout << "[Modules] Prefetched " << prefetch.modules << " modules in " << prefetch.waves
+                  << " waves (" << prefetch.elapsedMs << " ms, "
+                  << jobs::JobSystem::instance().threadCount() + 1 << " threads)" << std::endl;
+
+        const js::ResolverStats& resolver = moduleSystem_->resolver().stats();
+        std::cout << "[Modules] Resolver: " << resolver.resolves << " resolves (" << resolver.resolveHits
+                  << " cached), " << resolver.statCalls << " stat calls (" << resolver.statHits << " cached), "
+                  << resolver.packageJsonReads << " package.json reads" << std::endl;
+
+        auto& cache = moduleSystem_->transpileCache();
+        js::TranspileCache::Stats stats = cache.stats();
+        if (stats.memoryHits + stats.diskHits + stats.misses == 0) return;  // No TypeScript loaded
+        std::cout << "[Modules] TypeScript transpile cache: " << stats.memoryHits << " memory hits, "
+                  << stats.diskHits << " disk hits, " << stats.misses << " misses, "
+                  << stats.diskWrites << " written"
+                  << (cache.directory().empty() ? " (memory only)" : " (" + cache.directory() + ")")
+                  << std::endl;
+    }
+
     void clearAllTimers() {
 #ifdef MYSTRAL_USE_LIBUV_TIMERS
         // Stop and clean up all libuv timers
@@ -649,17 +814,12 @@ private:
                 pendingTimerCallbacks_.pop();
             }
         }
-#else
-        // Clear std::chrono-based timers
-        for (auto& timer : timerCallbacks_) {
-            if (!timer.cancelled) {
-                jsEngine_->unprotect(timer.callback);
-            }
-        }
-        timerCallbacks_.clear();
-        cancelledTimerIds_.clear();
-#endif
         nextTimerId_ = 1;
+#endif
+        // Clear runtime-clock timers
+        for (auto& callback : timerQueue_.clear()) {
+            jsEngine_->unprotect(callback);
+        }
     }
 
 public:
@@ -696,7 +856,9 @@ public:
 
             // In no-SDL (headless) mode, exit when there's no more work to do
             if (config_.noSdl) {
-                bool hasWork = !rafCallbacks_.empty() || hasActiveTimers();
+                bool hasWork = !rafCallbacks_.empty() || hasActiveTimers() ||
+                               workers::WorkerRegistry::instance().activeWorkerCount() > 0 ||
+                               jobs::JobSystem::instance().hasPendingWork();
                 if (!hasWork) {
                     idleFrames++;
                     if (idleFrames >= maxIdleFrames) {
@@ -708,11 +870,122 @@ public:
                     idleFrames = 0;
                 }
             }
+
+            // Sleep until the next frame is due (or something needs attention)
+            if (running_) {
+                waitForNextFrame();
+            }
         }
 
         std::cout << "[Mystral] Main loop ended" << std::endl;
     }
 
+    /**
+     * Block between loop iterations instead of spinning.
+     *
+     * With requestAnimationFrame callbacks pending, wait for the frame
+     * deadline (no wait when uncapped; vsync'd presents pace the loop). In
+     * low-latency mode any SDL input starts the frame early.
+     *
+     * With nothing to render, sleep until the next timer, I/O completion,
+     * worker message or input event, whichever comes first. The sleep is
+     * capped so job completions and state changes are still noticed.
+     */
+    void waitForNextFrame() {
+        using Clock = async::FrameScheduler::Clock;
+        constexpr double kMaxIdleWaitMs = 100.0;
+        constexpr double kWakeCheckMs = 10.0;  // Polling interval when a source can't wake us
+
+        auto now = Clock::now();
+        bool framePending = !rafCallbacks_.empty();
+        if (framePending && !frameScheduler_.capped()) {
+            return;
+        }
+
+        // Virtual time never sleeps: frames run back to back, and an idle loop
+        // jumps to the next timer unless real I/O, workers or jobs are pending
+        auto& clock = async::RuntimeClock::instance();
+        if (clock.isVirtual()) {
+            if (framePending) {
+                return;
+            }
+            if (!hasRealTimeWork()) {
+                clock.advance(timerQueue_.msUntilNext(clock.now()));
+                return;
+            }
+        }
+
+        double waitMs;
+        if (framePending) {
+            waitMs = std::chrono::duration<double, std::milli>(frameScheduler_.nextFrameTime() - now).count();
+        } else {
+            waitMs = kMaxIdleWaitMs;
+            double timerMs = clock.isVirtual() ? -1 : timerQueue_.msUntilNext(now);
+            if (timerMs >= 0 && timerMs < waitMs) {
+                waitMs = timerMs;
+            }
+        }
+        if (jobs::JobSystem::instance().hasPendingWork()) {
+            waitMs = std::min(waitMs, 1.0);  // Completions are polled, not signalled
+        }
+        if (waitMs <= 0) {
+            return;
+        }
+
+        if (!config_.noSdl && (config_.lowLatency || !framePending)) {
+            // SDL can't see libuv or worker wakeups, so idle waits are sliced.
+            // Round up so a frame wait doesn't end just short of the deadline.
+            bool gotEvent = platform::waitForEvent(static_cast<int>(
+                framePending ? std::ceil(waitMs) : std::min(waitMs, kWakeCheckMs)));
+            inputWake_ = framePending && gotEvent;
+            return;
+        }
+
+        if (!framePending) {
+            auto& loop = async::EventLoop::instance();
+            auto& registry = workers::WorkerRegistry::instance();
+            bool hasWorkers = registry.activeWorkerCount() > 0;
+            if (loop.hasPendingWork()) {
+                // I/O in flight (and libuv timers): completions end the wait
+                loop.waitForEvents(hasWorkers ? std::min(waitMs, kWakeCheckMs) : waitMs);
+                return;
+            }
+            if (hasWorkers) {
+                registry.waitForMessages(waitMs);
+                return;
+            }
+        }
+
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(waitMs));
+    }
+
+    /**
+     * Whether requestAnimationFrame callbacks should run this iteration
+     *
+     * waitForNextFrame() can return before the frame deadline (pending jobs
+     * are polled every millisecond), so the cap is enforced here. Only input
+     * in low-latency mode starts a frame early; virtual time runs frames
+     * back to back.
+     */
+    bool frameDue() {
+        bool inputWake = inputWake_;
+        inputWake_ = false;
+        if (rafCallbacks_.empty()) {
+            return false;
+        }
+        if (!frameScheduler_.capped() || inputWake || async::RuntimeClock::instance().isVirtual()) {
+            return true;
+        }
+        return async::FrameScheduler::Clock::now() >= frameScheduler_.nextFrameTime();
+    }
+
+    // Work that completes in real time: I/O in flight, workers, job completions
+    bool hasRealTimeWork() const {
+        return async::EventLoop::instance().hasPendingWork() ||
+               workers::WorkerRegistry::instance().activeWorkerCount() > 0 ||
+               jobs::JobSystem::instance().hasPendingWork();
+    }
+
     // Check if there are any active (non-cancelled) timers
     bool hasActiveTimers() const {
 #ifdef MYSTRAL_USE_LIBUV_TIMERS
@@ -721,15 +994,8 @@ public:
                 return true;
             }
         }
-        return false;
-#else
-        for (const auto& timer : timerCallbacks_) {
-            if (!timer.cancelled) {
-                return true;
-            }
-        }
-        return false;
 #endif
+        return !timerQueue_.empty();
     }
 
     void renderFrame() {
@@ -740,8 +1006,12 @@ public:
     }
 
     bool pollEvents() override {
+        MYSTRAL_TRACE_SCOPE("frame");
+        uint64_t iterationStart = debug::trace::nowNs();
+
         // Poll SDL events through our platform layer (skip in no-SDL mode)
         if (!config_.noSdl) {
+            debug::FramePhase phase(frameStats_, debug::FrameStats::SdlPoll);
             if (!platform::pollEvents()) {
                 running_ = false;
                 return false;
@@ -750,49 +1020,96 @@ public:
 
         // Poll libuv event loop - process any ready I/O callbacks (non-blocking)
         // This handles async HTTP requests, file I/O, and libuv-based timers
-        async::EventLoop::instance().runOnce();
+        {
+            debug::FramePhase phase(frameStats_, debug::FrameStats::EventLoop);
+            async::EventLoop::instance().runOnce();
+        }
 
         // Process completed async HTTP requests (invoke their JS callbacks)
         // This must be called after runOnce() to invoke callbacks safely on the main thread
-        http::getAsyncHttpClient().processCompletedRequests();
+        {
+            debug::FramePhase phase(frameStats_, debug::FrameStats::HttpCompletions);
+            http::getAsyncHttpClient().processCompletedRequests();
+        }
 
         // Process completed async file reads (queues their callbacks)
         // Note: We don't process the pending callbacks immediately because we might
         // still be in a nested callback stack. The callbacks will be processed next frame.
-        fs::getAsyncFileReader().processCompletedReads();
+        {
+            debug::FramePhase phase(frameStats_, debug::FrameStats::FsCompletions);
+            fs::getAsyncFileReader().processCompletedReads();
+        }
 
         // Process file watch events (for hot reload)
-        fs::getFileWatcher().processPendingEvents();
+        {
+            debug::FramePhase phase(frameStats_, debug::FrameStats::FileWatcher);
+            fs::getFileWatcher().processPendingEvents();
+        }
 
-        // Check if hot reload was requested
-        if (reloadRequested_) {
-            reloadRequested_ = false;
-            reloadScript();
+        // Apply file changes once they have settled (hot reload)
+        if (!pendingModuleChanges_.empty() &&
+            debug::trace::nowNs() - lastModuleChangeNs_ >= kHotReloadDebounceNs) {
+            applyModuleChanges();
         }
 
         // Execute timer callbacks (setTimeout, setInterval)
-        executeTimerCallbacks();
+        {
+            debug::FramePhase phase(frameStats_, debug::FrameStats::Timers);
+            executeTimerCallbacks();
+        }
 
         // Process any queued file callbacks that were deferred from previous frames
         // We process them here (after other callbacks) to ensure we're not in a nested callback stack
-        processPendingFileCallbacks();
+        {
+            debug::FramePhase phase(frameStats_, debug::FrameStats::FileCallbacks);
+            processPendingFileCallbacks();
+        }
 
-        // Process completed async Draco decode results
-        processPendingDracoCallbacks();
+        // Deliver results of finished background jobs (Draco, image and audio decode)
+        {
+            debug::FramePhase phase(frameStats_, debug::FrameStats::JobCompletions);
+            jobs::JobSystem::instance().runCompletions();
+        }
+
+        // Deliver messages posted by worker threads
+        {
+            debug::FramePhase phase(frameStats_, debug::FrameStats::WorkerMessages);
+            workers::WorkerRegistry::instance().processWorkerMessages(jsEngine_.get());
+        }
 
         // Process microtask queue for promises
-        processMicrotasks();
+        {
+            debug::FramePhase phase(frameStats_, debug::FrameStats::Microtasks);
+            processMicrotasks();
+        }
 
         // Begin frame — enables per-frame allocation tracking
         jsEngine_->beginFrame();
         webgpu::beginDawnFrame();
 
-        // Execute requestAnimationFrame callbacks (renders a frame)
-        executeAnimationFrameCallbacks();
+        // Execute requestAnimationFrame callbacks (renders a frame) once the frame is due
+        bool frameRendered = frameDue();
+        if (frameRendered) {
+            debug::FramePhase phase(frameStats_, debug::FrameStats::AnimationFrame);
+            executeAnimationFrameCallbacks();
+        }
 
         // Free non-protected handles, per-frame native allocations, and Dawn resources
-        jsEngine_->clearFrameHandles();
-        webgpu::endDawnFrame();
+        {
+            debug::FramePhase phase(frameStats_, debug::FrameStats::ClearFrameHandles);
+            jsEngine_->clearFrameHandles();
+            webgpu::endDawnFrame();
+        }
+
+        // Virtual time moves one fixed step per frame. While nothing renders and
+        // real-time work (a fetch, a worker) is outstanding it holds still, so
+        // how long that work takes never shows up in the timeline.
+        auto& clock = async::RuntimeClock::instance();
+        if (clock.isVirtual() && (frameRendered || !hasRealTimeWork())) {
+            clock.advance(clock.fixedDtMs());
+        }
+
+        frameStats_.endIteration(debug::trace::nowNs() - iterationStart, frameRendered);
 
         // TODO: Translate to Web events via InputShim
         // TODO: Dispatch to JS
@@ -886,6 +1203,39 @@ public:
         return webgpu_->captureFrame(outData, outWidth, outHeight);
     }
 
+    // ========================================================================
+    // Statistics
+    // ========================================================================
+
+    RuntimeStats getStats(double longFrameMs) override {
+        RuntimeStats stats;
+        stats.gpuInitMs = gpuInitMs_;
+        stats.jsInitMs = jsInitMs_;
+        stats.scriptLoadMs = scriptLoadMs_;
+
+        auto summary = frameStats_.summarize(longFrameMs);
+        stats.frames = summary.frames;
+        stats.longFrames = summary.longFrames;
+        stats.frameMeanMs = summary.frameMs.mean;
+        stats.frameP50Ms = summary.frameMs.p50;
+        stats.frameP95Ms = summary.frameMs.p95;
+        stats.frameP99Ms = summary.frameMs.p99;
+        stats.frameMaxMs = summary.frameMs.max;
+
+        if (jsEngine_) {
+            stats.jsHeapBytes = jsEngine_->getHeapStats().usedBytes;
+        }
+        stats.nativeBytes = debug::processResidentBytes();
+        stats.gpuBytes = webgpu::gpuMemoryBytes();
+        webgpu::getGpuCounters(stats.drawCalls, stats.dispatches, stats.submits);
+        return stats;
+    }
+
+    void resetStats() override {
+        frameStats_.reset();
+        webgpu::resetGpuCounters();
+    }
+
 private:
     void setupAnimationFrame() {
         if (!jsEngine_) return;
@@ -927,14 +1277,39 @@ private:
                 return jsEngine_->newUndefined();
             })
         );
+
+        // mystral.targetFrameRate - read or change the frame rate cap (0 = uncapped)
+        jsEngine_->setGlobalProperty("__getTargetFrameRate",
+            jsEngine_->newFunction("__getTargetFrameRate", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                return jsEngine_->newNumber(frameScheduler_.targetFrameRate());
+            })
+        );
+        jsEngine_->setGlobalProperty("__setTargetFrameRate",
+            jsEngine_->newFunction("__setTargetFrameRate", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                frameScheduler_.setTargetFrameRate(args.empty() ? 0 : jsEngine_->toNumber(args[0]));
+                return jsEngine_->newUndefined();
+            })
+        );
+        jsEngine_->eval(R"(
+(function() {
+    const mystral = globalThis.mystral || (globalThis.mystral = {});
+    Object.defineProperty(mystral, 'targetFrameRate', {
+        get: __getTargetFrameRate,
+        set: __setTargetFrameRate,
+        enumerable: true,
+        configurable: true,
+    });
+})();
+)", "frame-scheduler.js");
     }
 
     void executeAnimationFrameCallbacks() {
         if (rafCallbacks_.empty()) return;
 
-        // Get current time
-        auto now = std::chrono::high_resolution_clock::now();
-        double timestamp = std::chrono::duration<double, std::milli>(now.time_since_epoch()).count();
+        frameScheduler_.frameStarted(async::FrameScheduler::Clock::now());
+
+        // Frame timestamp from the runtime clock (virtual under --virtual-time)
+        double timestamp = async::RuntimeClock::instance().nowMs();
 
         // Copy callbacks (they might add new ones during execution)
         auto callbacks = std::move(rafCallbacks_);
@@ -952,12 +1327,14 @@ private:
         if (!jsEngine_) return;
 
 #ifdef MYSTRAL_USE_LIBUV_TIMERS
-        // libuv-based timers for precise timing
-        setupLibuvTimers();
-#else
-        // Fallback to std::chrono-based timers
-        setupChronoTimers();
+        // libuv-based timers for precise timing (real time only)
+        if (!async::RuntimeClock::instance().isVirtual()) {
+            setupLibuvTimers();
+            return;
+        }
 #endif
+        // Timers on the runtime clock (no libuv, or --virtual-time)
+        setupChronoTimers();
     }
 
 #ifdef MYSTRAL_USE_LIBUV_TIMERS
@@ -1110,9 +1487,8 @@ private:
     }
 #endif // MYSTRAL_USE_LIBUV_TIMERS
 
-#ifndef MYSTRAL_USE_LIBUV_TIMERS
     void setupChronoTimers() {
-        // setTimeout (fallback using std::chrono)
+        // setTimeout (runtime clock)
         jsEngine_->setGlobalProperty("setTimeout",
             jsEngine_->newFunction("setTimeout", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
                 if (args.empty()) {
@@ -1124,40 +1500,14 @@ private:
                     delay = (int)jsEngine_->toNumber(args[1]);
                 }
 
-                int id = nextTimerId_++;
                 jsEngine_->protect(args[0]);
+                auto id = timerQueue_.add(args[0], delay, 0, async::RuntimeClock::instance().now());
 
-                auto targetTime = std::chrono::high_resolution_clock::now() +
-                                  std::chrono::milliseconds(delay);
-
-                timerCallbacks_.push_back({id, args[0], targetTime, 0, false});
-
-                return jsEngine_->newNumber(id);
-            })
-        );
-
-        // clearTimeout (fallback)
-        jsEngine_->setGlobalProperty("clearTimeout",
-            jsEngine_->newFunction("clearTimeout", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                if (args.empty()) {
-                    return jsEngine_->newUndefined();
-                }
-
-                int id = (int)jsEngine_->toNumber(args[0]);
-
-                for (auto& timer : timerCallbacks_) {
-                    if (timer.id == id && !timer.cancelled) {
-                        timer.cancelled = true;
-                        jsEngine_->unprotect(timer.callback);
-                        break;
-                    }
-                }
-
-                return jsEngine_->newUndefined();
+                return jsEngine_->newNumber((double)id);
             })
         );
 
-        // setInterval (fallback)
+        // setInterval (runtime clock)
         jsEngine_->setGlobalProperty("setInterval",
             jsEngine_->newFunction("setInterval", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
                 if (args.empty()) {
@@ -1170,58 +1520,210 @@ private:
                 }
                 if (delay < 1) delay = 1;
 
-                int id = nextTimerId_++;
                 jsEngine_->protect(args[0]);
+                auto id = timerQueue_.add(args[0], delay, delay, async::RuntimeClock::instance().now());
 
-                auto targetTime = std::chrono::high_resolution_clock::now() +
-                                  std::chrono::milliseconds(delay);
+                return jsEngine_->newNumber((double)id);
+            })
+        );
 
-                timerCallbacks_.push_back({id, args[0], targetTime, delay, false});
+        // clearTimeout / clearInterval - one id space, as in browsers
+        auto clearTimer = [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            async::TimerQueue::TimerId id;
+            js::JSValueHandle callback;
+            if (!args.empty() && async::TimerQueue::idFromNumber(jsEngine_->toNumber(args[0]), id) &&
+                timerQueue_.cancel(id, callback)) {
+                jsEngine_->unprotect(callback);
+            }
+            return jsEngine_->newUndefined();
+        };
+        jsEngine_->setGlobalProperty("clearTimeout", jsEngine_->newFunction("clearTimeout", clearTimer));
+        jsEngine_->setGlobalProperty("clearInterval", jsEngine_->newFunction("clearInterval", clearTimer));
+    }
 
-                return jsEngine_->newNumber(id);
+    void setupPerformance() {
+        if (!jsEngine_) return;
+
+        // Create performance object with now() method
+        auto performance = jsEngine_->newObject();
+
+        jsEngine_->setProperty(performance, "now",
+            jsEngine_->newFunction("now", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                // Milliseconds on the runtime clock (epoch-based; virtual under --virtual-time)
+                return jsEngine_->newNumber(async::RuntimeClock::instance().nowMs());
             })
         );
 
-        // clearInterval (fallback)
-        jsEngine_->setGlobalProperty("clearInterval",
-            jsEngine_->newFunction("clearInterval", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
+        // User Timing natives; performance.mark/measure below wrap them
+        jsEngine_->setGlobalProperty("__performanceMark",
+            jsEngine_->newFunction("__performanceMark", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
                 if (args.empty()) {
+                    jsEngine_->throwException("performance.mark requires a name");
                     return jsEngine_->newUndefined();
                 }
+                double now = async::RuntimeClock::instance().nowMs();
+                double startTime = args.size() > 1 && jsEngine_->isNumber(args[1]) ? jsEngine_->toNumber(args[1]) : now;
+                return newPerformanceEntry(userTiming_.mark(jsEngine_->toString(args[0]), startTime, now));
+            })
+        );
 
-                int id = (int)jsEngine_->toNumber(args[0]);
-                cancelledTimerIds_.insert(id);
-
-                for (auto& timer : timerCallbacks_) {
-                    if (timer.id == id && !timer.cancelled) {
-                        timer.cancelled = true;
-                        jsEngine_->unprotect(timer.callback);
-                        break;
+        // __performanceMeasure(name, start, end, duration): start/end are mark names, times, or undefined
+        jsEngine_->setGlobalProperty("__performanceMeasure",
+            jsEngine_->newFunction("__performanceMeasure", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                if (args.empty()) {
+                    jsEngine_->throwException("performance.measure requires a name");
+                    return jsEngine_->newUndefined();
+                }
+                double now = async::RuntimeClock::instance().nowMs();
+                double times[2] = {0, now};  // Defaults: time origin to now
+                bool given[2] = {false, false};
+                for (size_t i = 0; i < 2; i++) {
+                    if (args.size() <= i + 1 || jsEngine_->isUndefined(args[i + 1])) {
+                        continue;
+                    }
+                    given[i] = true;
+                    if (jsEngine_->isNumber(args[i + 1])) {
+                        times[i] = jsEngine_->toNumber(args[i + 1]);
+                        continue;
+                    }
+                    std::string markName = jsEngine_->toString(args[i + 1]);
+                    if (!userTiming_.findMark(markName, times[i])) {
+                        jsEngine_->throwException(("The mark '" + markName + "' does not exist").c_str());
+                        return jsEngine_->newUndefined();
                     }
                 }
+                if (args.size() > 3 && jsEngine_->isNumber(args[3])) {
+                    double duration = jsEngine_->toNumber(args[3]);
+                    if (given[0] && !given[1]) {
+                        times[1] = times[0] + duration;
+                    } else {
+                        times[0] = times[1] - duration;
+                    }
+                }
+                return newPerformanceEntry(userTiming_.measure(jsEngine_->toString(args[0]), times[0], times[1], now));
+            })
+        );
+
+        // __performanceGetEntries(name, type): empty name or type matches all
+        jsEngine_->setGlobalProperty("__performanceGetEntries",
+            jsEngine_->newFunction("__performanceGetEntries", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                std::string name = args.size() > 0 && jsEngine_->isString(args[0]) ? jsEngine_->toString(args[0]) : "";
+                std::string typeName = args.size() > 1 && jsEngine_->isString(args[1]) ? jsEngine_->toString(args[1]) : "";
+                debug::PerformanceTimeline::EntryType type = debug::PerformanceTimeline::EntryType::Mark;
+                if (typeName == "measure") {
+                    type = debug::PerformanceTimeline::EntryType::Measure;
+                } else if (!typeName.empty() && typeName != "mark") {
+                    return jsEngine_->newArray();  // No other entry types are recorded
+                }
+                auto entries = userTiming_.entries(name, typeName.empty() ? nullptr : &type);
+                auto array = jsEngine_->newArray(entries.size());
+                for (size_t i = 0; i < entries.size(); i++) {
+                    jsEngine_->setPropertyIndex(array, (uint32_t)i, newPerformanceEntry(entries[i]));
+                }
+                return array;
+            })
+        );
 
+        // __performanceClear(type, name): no name clears every entry of that type
+        jsEngine_->setGlobalProperty("__performanceClear",
+            jsEngine_->newFunction("__performanceClear", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                if (args.empty()) return jsEngine_->newUndefined();
+                auto type = jsEngine_->toString(args[0]) == "measure" ? debug::PerformanceTimeline::EntryType::Measure
+                                                                     : debug::PerformanceTimeline::EntryType::Mark;
+                std::string name = args.size() > 1 && jsEngine_->isString(args[1]) ? jsEngine_->toString(args[1]) : "";
+                userTiming_.clear(type, name);
                 return jsEngine_->newUndefined();
             })
         );
-    }
-#endif // !MYSTRAL_USE_LIBUV_TIMERS
 
-    void setupPerformance() {
-        if (!jsEngine_) return;
+        // performance.memory - JS heap plus process and GPU totals (bytes)
+        jsEngine_->setGlobalProperty("__performanceMemory",
+            jsEngine_->newFunction("__performanceMemory", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                auto heap = jsEngine_->getHeapStats();
+                auto memory = jsEngine_->newObject();
+                jsEngine_->setProperty(memory, "usedJSHeapSize", jsEngine_->newNumber((double)heap.usedBytes));
+                jsEngine_->setProperty(memory, "totalJSHeapSize", jsEngine_->newNumber((double)heap.totalBytes));
+                jsEngine_->setProperty(memory, "jsHeapSizeLimit", jsEngine_->newNumber((double)heap.limitBytes));
+                jsEngine_->setProperty(memory, "nativeBytes", jsEngine_->newNumber((double)debug::processResidentBytes()));
+                jsEngine_->setProperty(memory, "gpuBytes", jsEngine_->newNumber((double)webgpu::gpuMemoryBytes()));
+                return memory;
+            })
+        );
 
-        // Create performance object with now() method
-        auto performance = jsEngine_->newObject();
+        // performance.frameStats({ longFrameMs, reset }) - rolling window of rendered frames
+        jsEngine_->setGlobalProperty("__performanceFrameStats",
+            jsEngine_->newFunction("__performanceFrameStats", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                double longFrameMs = args.size() > 0 && jsEngine_->isNumber(args[0]) ? jsEngine_->toNumber(args[0]) : 1000.0 / 60.0;
+                auto summary = frameStats_.summarize(longFrameMs);
+                if (args.size() > 1 && jsEngine_->toBoolean(args[1])) {
+                    frameStats_.reset();
+                }
 
-        jsEngine_->setProperty(performance, "now",
-            jsEngine_->newFunction("now", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                // Return time in milliseconds since epoch (or some stable reference)
-                auto now = std::chrono::high_resolution_clock::now();
-                double timestamp = std::chrono::duration<double, std::milli>(now.time_since_epoch()).count();
-                return jsEngine_->newNumber(timestamp);
+                auto newDistribution = [this](const debug::FrameStats::Distribution& d) {
+                    auto obj = jsEngine_->newObject();
+                    jsEngine_->setProperty(obj, "mean", jsEngine_->newNumber(d.mean));
+                    jsEngine_->setProperty(obj, "p50", jsEngine_->newNumber(d.p50));
+                    jsEngine_->setProperty(obj, "p95", jsEngine_->newNumber(d.p95));
+                    jsEngine_->setProperty(obj, "p99", jsEngine_->newNumber(d.p99));
+                    jsEngine_->setProperty(obj, "max", jsEngine_->newNumber(d.max));
+                    return obj;
+                };
+
+                auto stats = jsEngine_->newObject();
+                jsEngine_->setProperty(stats, "frames", jsEngine_->newNumber((double)summary.frames));
+                jsEngine_->setProperty(stats, "longFrames", jsEngine_->newNumber((double)summary.longFrames));
+                jsEngine_->setProperty(stats, "longFrameMs", jsEngine_->newNumber(longFrameMs));
+                jsEngine_->setProperty(stats, "frameMs", newDistribution(summary.frameMs));
+                auto phases = jsEngine_->newObject();
+                for (int phase = 0; phase < debug::FrameStats::PhaseCount; phase++) {
+                    jsEngine_->setProperty(phases, debug::FrameStats::phaseName((debug::FrameStats::Phase)phase),
+                                           newDistribution(summary.phaseMs[phase]));
+                }
+                jsEngine_->setProperty(stats, "phases", phases);
+                return stats;
             })
         );
 
         jsEngine_->setGlobalProperty("performance", performance);
+
+        jsEngine_->eval(R"(
+(function() {
+    const perf = globalThis.performance;
+    perf.timeOrigin = 0;  // performance.now() is already epoch-based
+    perf.mark = function(name, options) {
+        return __performanceMark(String(name), options && options.startTime);
+    };
+    perf.measure = function(name, startOrOptions, endMark) {
+        if (startOrOptions && typeof startOrOptions === 'object') {
+            const o = startOrOptions;
+            return __performanceMeasure(String(name), o.start, o.end, o.duration);
+        }
+        return __performanceMeasure(String(name), startOrOptions, endMark);
+    };
+    perf.getEntries = function() { return __performanceGetEntries('', ''); };
+    perf.getEntriesByName = function(name, type) { return __performanceGetEntries(String(name), type || ''); };
+    perf.getEntriesByType = function(type) { return __performanceGetEntries('', String(type)); };
+    perf.clearMarks = function(name) { __performanceClear('mark', name); };
+    perf.clearMeasures = function(name) { __performanceClear('measure', name); };
+    perf.frameStats = function(options) {
+        options = options || {};
+        return __performanceFrameStats(options.longFrameMs, !!options.reset);
+    };
+    Object.defineProperty(perf, 'memory', { get: __performanceMemory, enumerable: true, configurable: true });
+})();
+)", "performance.js");
+    }
+
+    /**
+     * A PerformanceEntry-shaped object for a User Timing entry
+     */
+    js::JSValueHandle newPerformanceEntry(const debug::PerformanceTimeline::Entry& entry) {
+        auto obj = jsEngine_->newObject();
+        jsEngine_->setProperty(obj, "name", jsEngine_->newString(entry.name.c_str()));
+        jsEngine_->setProperty(obj, "entryType", jsEngine_->newString(debug::PerformanceTimeline::typeName(entry.type)));
+        jsEngine_->setProperty(obj, "startTime", jsEngine_->newNumber(entry.startTime));
+        jsEngine_->setProperty(obj, "duration", jsEngine_->newNumber(entry.duration));
+        return obj;
     }
 
     void setupProcess() {
@@ -1520,59 +2022,6 @@ private:
             })
         );
 
-        // Async file reading function - uses libuv thread pool for non-blocking I/O
-        // Takes (path, callback) where callback receives (data, error)
-        jsEngine_->setGlobalProperty("__readFileAsync",
-            jsEngine_->newFunction("__readFileAsync", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                if (args.size() < 2) {
-                    std::cerr << "[Fetch Async] Missing arguments (need path, callback)" << std::endl;
-                    return jsEngine_->newUndefined();
-                }
-
-                std::string path = jsEngine_->toString(args[0]);
-
-                // Handle file:// prefix
-                if (path.substr(0, 7) == "file://") {
-                    path = path.substr(7);
-                }
-
-                // Get and protect the callback so it survives until we call it
-                auto callback = args[1];
-                jsEngine_->protect(callback);
-
-                // Capture jsEngine pointer for the callback
-                auto* engine = jsEngine_.get();
-
-                // Check embedded bundle first (synchronously - it's fast)
-                std::vector<uint8_t> embeddedData;
-                if (vfs::readEmbeddedFile(path, embeddedData)) {
-                    std::cout << "[Fetch] Read " << embeddedData.size() << " bytes from bundle: " << path << std::endl;
-                    // Queue callback for next tick instead of calling immediately
-                    // This prevents stack overflow and matches browser async behavior
-                    pendingFileCallbacks_.push({
-                        callback,
-                        std::move(embeddedData),
-                        "" // no error
-                    });
-                    return jsEngine_->newUndefined();
-                }
-
-                // Use the async file reader with libuv thread pool
-                // The callback will be queued and invoked during processCompletedReads()
-                fs::getAsyncFileReader().readFile(path, [this, callback](std::vector<uint8_t> data, std::string error) {
-                    // This callback runs on the main thread during processCompletedReads()
-                    // Queue the callback with data for processing in the main loop
-                    pendingFileCallbacks_.push({
-                        callback,
-                        std::move(data),
-                        std::move(error)
-                    });
-                });
-
-                return jsEngine_->newUndefined();
-            })
-        );
-
         // Native HTTP request function
         jsEngine_->setGlobalProperty("__httpRequest",
             jsEngine_->newFunction("__httpRequest", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
@@ -1642,344 +2091,12 @@ private:
 
                 std::cout << "[HTTP] Response: " << response.status << " (" << response.data.size() << " bytes)" << std::endl;
 
-                return result;
-            })
-        );
-
-        // Async HTTP request function - uses libuv for non-blocking I/O
-        // Takes (url, options, callback) where callback receives the result object
-        jsEngine_->setGlobalProperty("__httpRequestAsync",
-            jsEngine_->newFunction("__httpRequestAsync", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                if (args.size() < 3) {
-                    std::cerr << "[HTTP Async] Missing arguments (need url, options, callback)" << std::endl;
-                    return jsEngine_->newUndefined();
-                }
-
-                std::string url = jsEngine_->toString(args[0]);
-                std::string method = "GET";
-                std::vector<uint8_t> body;
-                http::HttpOptions options;
-
-                // Parse options object
-                if (!jsEngine_->isUndefined(args[1]) && !jsEngine_->isNull(args[1])) {
-                    auto optObj = args[1];
-
-                    auto methodVal = jsEngine_->getProperty(optObj, "method");
-                    if (!jsEngine_->isUndefined(methodVal)) {
-                        method = jsEngine_->toString(methodVal);
-                    }
-
-                    auto bodyVal = jsEngine_->getProperty(optObj, "body");
-                    if (!jsEngine_->isUndefined(bodyVal)) {
-                        if (jsEngine_->isString(bodyVal)) {
-                            std::string bodyStr = jsEngine_->toString(bodyVal);
-                            body.assign(bodyStr.begin(), bodyStr.end());
-                        } else {
-                            size_t size = 0;
-                            void* data = jsEngine_->getArrayBufferData(bodyVal, &size);
-                            if (data && size > 0) {
-                                body.assign(static_cast<uint8_t*>(data), static_cast<uint8_t*>(data) + size);
-                            }
-                        }
-                    }
-                }
-
-                // Get and protect the callback
-                auto callback = args[2];
-                jsEngine_->protect(callback);
-
-                // Capture jsEngine pointer for the callback
-                auto* engine = jsEngine_.get();
-
-                // Start async request
-                http::getAsyncHttpClient().request(method, url, body,
-                    [engine, callback](http::HttpResponse response) {
-                        // This runs on the main thread when the response arrives
-                        // Create result object
-                        auto result = engine->newObject();
-                        engine->setProperty(result, "ok", engine->newBoolean(response.ok));
-                        engine->setProperty(result, "status", engine->newNumber(response.status));
-                        engine->setProperty(result, "url", engine->newString(response.url.c_str()));
-
-                        if (!response.error.empty()) {
-                            engine->setProperty(result, "error", engine->newString(response.error.c_str()));
-                        }
-
-                        if (!response.data.empty()) {
-                            auto arrayBuffer = engine->newArrayBuffer(response.data.data(), response.data.size());
-                            engine->setProperty(result, "data", arrayBuffer);
-                        } else {
-                            engine->setProperty(result, "data", engine->newNull());
-                        }
-
-                        // Call the JS callback with the result
-                        std::vector<js::JSValueHandle> callbackArgs = { result };
-                        engine->call(callback, engine->newUndefined(), callbackArgs);
-
-                        // Unprotect the callback now that we're done
-                        engine->unprotect(callback);
-                    },
-                    options
-                );
-
-                return jsEngine_->newUndefined();
-            })
-        );
-
-        // JavaScript fetch polyfill
-        const char* fetchPolyfill = R"(
-// TextDecoder polyfill (if not available)
-if (typeof TextDecoder === 'undefined') {
-    class TextDecoder {
-        constructor(encoding = 'utf-8') {
-            this.encoding = encoding;
-        }
-        decode(input) {
-            if (!input) return '';
-            const bytes = input instanceof Uint8Array ? input : new Uint8Array(input);
-            let result = '';
-            for (let i = 0; i < bytes.length; i++) {
-                result += String.fromCharCode(bytes[i]);
-            }
-            // Handle UTF-8 decoding properly
-            try {
-                return decodeURIComponent(escape(result));
-            } catch (e) {
-                return result;
-            }
-        }
-    }
-    globalThis.TextDecoder = TextDecoder;
-}
-
-// TextEncoder polyfill (if not available)
-if (typeof TextEncoder === 'undefined') {
-    class TextEncoder {
-        constructor() {
-            this.encoding = 'utf-8';
-        }
-        encode(str) {
-            const utf8 = unescape(encodeURIComponent(str));
-            const result = new Uint8Array(utf8.length);
-            for (let i = 0; i < utf8.length; i++) {
-                result[i] = utf8.charCodeAt(i);
-            }
-            return result;
-        }
-    }
-    globalThis.TextEncoder = TextEncoder;
-}
-
-// Blob class (Web API standard)
-if (typeof Blob === 'undefined') {
-    class Blob {
-        constructor(blobParts = [], options = {}) {
-            this.type = options.type || '';
-
-            // Concatenate all parts into a single ArrayBuffer
-            let totalSize = 0;
-            const parts = [];
-
-            for (const part of blobParts) {
-                if (part instanceof ArrayBuffer) {
-                    parts.push(new Uint8Array(part));
-                    totalSize += part.byteLength;
-                } else if (part instanceof Uint8Array) {
-                    parts.push(part);
-                    totalSize += part.byteLength;
-                } else if (part instanceof Blob) {
-                    // Need to get the Blob's internal data
-                    parts.push(new Uint8Array(part._data));
-                    totalSize += part._data.byteLength;
-                } else if (typeof part === 'string') {
-                    const encoder = new TextEncoder();
-                    const encoded = encoder.encode(part);
-                    parts.push(encoded);
-                    totalSize += encoded.byteLength;
-                }
-            }
-
-            // Create final buffer
-            const buffer = new ArrayBuffer(totalSize);
-            const view = new Uint8Array(buffer);
-            let offset = 0;
-            for (const part of parts) {
-                view.set(part, offset);
-                offset += part.byteLength;
-            }
-
-            this._data = buffer;
-            this.size = totalSize;
-        }
-
-        async arrayBuffer() {
-            return this._data;
-        }
-
-        async text() {
-            const decoder = new TextDecoder();
-            return decoder.decode(new Uint8Array(this._data));
-        }
-
-        slice(start = 0, end = this.size, type = '') {
-            const data = new Uint8Array(this._data, start, end - start);
-            return new Blob([data], { type });
-        }
-
-        async stream() {
-            // ReadableStream not implemented yet
-            throw new Error('Blob.stream() not implemented');
-        }
-    }
-    globalThis.Blob = Blob;
-}
-
-// Headers class - mimics Web Headers API
-class Headers {
-    constructor(init = {}) {
-        this._headers = new Map();
-        if (init) {
-            if (init instanceof Headers) {
-                init.forEach((value, key) => this._headers.set(key.toLowerCase(), value));
-            } else if (Array.isArray(init)) {
-                init.forEach(([key, value]) => this._headers.set(key.toLowerCase(), value));
-            } else if (typeof init === 'object') {
-                Object.entries(init).forEach(([key, value]) => this._headers.set(key.toLowerCase(), value));
-            }
-        }
-    }
-
-    get(name) {
-        return this._headers.get(name.toLowerCase()) || null;
-    }
-
-    set(name, value) {
-        this._headers.set(name.toLowerCase(), value);
-    }
-
-    has(name) {
-        return this._headers.has(name.toLowerCase());
-    }
-
-    delete(name) {
-        this._headers.delete(name.toLowerCase());
-    }
-
-    entries() {
-        return this._headers.entries();
-    }
-
-    keys() {
-        return this._headers.keys();
-    }
-
-    values() {
-        return this._headers.values();
-    }
-
-    forEach(callback) {
-        this._headers.forEach((value, key) => callback(value, key, this));
-    }
-
-    [Symbol.iterator]() {
-        return this._headers.entries();
-    }
-}
-globalThis.Headers = Headers;
-
-// Response class
-class Response {
-    constructor(data, options = {}) {
-        this._data = data;
-        this.ok = options.ok !== undefined ? options.ok : true;
-        this.status = options.status || 200;
-        this.statusText = options.statusText || 'OK';
-        this.url = options.url || '';
-        this.headers = new Headers(options.headers || {});
-    }
-
-    async arrayBuffer() {
-        return this._data;
-    }
-
-    async text() {
-        const decoder = new TextDecoder();
-        return decoder.decode(new Uint8Array(this._data));
-    }
-
-    async json() {
-        const text = await this.text();
-        return JSON.parse(text);
-    }
-
-    async blob() {
-        return new Blob([this._data]);
-    }
-}
-
-// Fetch function - supports file://, http://, and https://
-// HTTP requests are now async via libuv (non-blocking)
-async function fetch(url, options = {}) {
-    // Check URL type
-    if (url.startsWith('http://') || url.startsWith('https://')) {
-        // HTTP/HTTPS request via async libcurl + libuv (non-blocking)
-        return new Promise((resolve, reject) => {
-            __httpRequestAsync(url, options, (result) => {
-                if (result.error) {
-                    reject(new Error('Fetch error: ' + result.error));
-                } else {
-                    resolve(new Response(result.data || new ArrayBuffer(0), {
-                        ok: result.ok,
-                        status: result.status,
-                        statusText: result.ok ? 'OK' : 'Error',
-                        url: result.url || url
-                    }));
-                }
-            });
-        });
-    }
-
-    // File URL or relative path - use async file reading for non-blocking I/O
-    let path = url;
-    if (url.startsWith('file://')) {
-        path = url;
-    } else if (!url.includes('://')) {
-        // Relative path - treat as file
-        path = url;
-    } else {
-        throw new Error('Unsupported URL scheme: ' + url.split('://')[0]);
-    }
-
-    // Use async file reading to avoid blocking the render loop
-    return new Promise((resolve, reject) => {
-        __readFileAsync(path, (data, error) => {
-            if (error) {
-                reject(new Error('File read error: ' + error));
-            } else if (data === null) {
-                resolve(new Response(new ArrayBuffer(0), {
-                    ok: false,
-                    status: 404,
-                    statusText: 'Not Found',
-                    url: url
-                }));
-            } else {
-                resolve(new Response(data, {
-                    ok: true,
-                    status: 200,
-                    statusText: 'OK',
-                    url: url
-                }));
-            }
-        });
-    });
-}
-
-// Also expose globally
-globalThis.fetch = fetch;
-globalThis.Response = Response;
-)";
+                return result;
+            })
+        );
 
-        jsEngine_->eval(fetchPolyfill, "fetch-polyfill.js");
+        // fetch, Response and the async natives it uses (shared with worker threads)
+        async::installFetchBindings(jsEngine_.get(), fileCallbacks_);
         std::cout << "[Mystral] Fetch API initialized (file://, http://, https://)" << std::endl;
     }
 
@@ -2635,8 +2752,7 @@ globalThis.Response = Response;
     void setupURL() {
         if (!jsEngine_) return;
 
-        // URL, URLSearchParams, and Worker polyfills for native runtime
-        // Worker is a main-thread polyfill that simulates async message passing
+        // URL and URLSearchParams polyfills for native runtime
         const char* urlPolyfill = R"JS(
 // URLSearchParams polyfill
 if (typeof URLSearchParams === 'undefined') {
@@ -2767,137 +2883,209 @@ if (typeof URL === 'undefined') {
 
     globalThis.URL = URL;
 }
+)JS";
 
-// Worker polyfill — runs worker code on the main thread with async message passing.
-// This enables WebWorker-based libraries (like Draco decoder) to function in native runtime.
-if (typeof Worker === 'undefined') {
-    class Worker {
-        constructor(url) {
-            this.onmessage = null;
-            this.onerror = null;
-            this._terminated = false;
-            this._workerSelf = null;
-
-            // Extract code from blob URL
-            let code = '';
-            if (typeof url === 'string' && url.startsWith('blob:')) {
-                const blob = URL._getBlobData(url);
-                if (blob && blob._data) {
-                    const decoder = new TextDecoder();
-                    code = decoder.decode(new Uint8Array(blob._data));
-                }
-            }
+        jsEngine_->eval(urlPolyfill, "url-polyfill.js");
+        std::cout << "[Mystral] URL polyfills initialized" << std::endl;
+    }
 
-            if (!code) {
-                const worker = this;
-                setTimeout(() => {
-                    if (worker.onerror) worker.onerror(new ErrorEvent('error', { message: 'Failed to load worker script' }));
-                }, 0);
-                return;
-            }
+    // ========================================================================
+    // Web Workers
+    // Each Worker runs its own JS engine on an OS thread (workers::WorkerThread).
+    // Messages are routed through WorkerRegistry and delivered to JS from
+    // pollEvents() via processWorkerMessages().
+    // ========================================================================
+    void setupWorkers() {
+        if (!jsEngine_) return;
 
-            // Build a worker-like scope with self, postMessage, etc.
-            const worker = this;
-            const workerSelf = {
-                onmessage: null,
-                postMessage: function(data) {
-                    if (worker._terminated) return;
-                    // Async delivery to main thread's onmessage handler
-                    setTimeout(() => {
-                        if (worker.onmessage && !worker._terminated) {
-                            try { worker.onmessage({ data }); }
-                            catch (e) { console.error('[Worker] onmessage error:', e); }
-                        }
-                    }, 0);
+        // __workerCreate(code) -> worker id (or -1)
+        jsEngine_->setGlobalProperty("__workerCreate",
+            jsEngine_->newFunction("__workerCreate", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                if (args.empty()) return jsEngine_->newNumber(-1);
+                auto& registry = workers::WorkerRegistry::instance();
+                if (!registry.isAvailable()) return jsEngine_->newNumber(-1);
+
+                std::string code = jsEngine_->toString(args[0]);
+                int id = registry.createWorker(code);
+                if (id > 0) {
+                    registry.registerCallback(id, [this](int workerId, const workers::WorkerMessage& msg) {
+                        dispatchWorkerMessage(workerId, msg);
+                    });
                 }
-            };
-            workerSelf.self = workerSelf;
-
-            // importScripts polyfill — uses __readFileSync (synchronous bundle/FS read)
-            // combined with TextDecoder to load and execute scripts synchronously,
-            // matching the browser WebWorker importScripts() behavior.
-            workerSelf.importScripts = function() {
-                for (let i = 0; i < arguments.length; i++) {
-                    const url = arguments[i];
-                    const data = __readFileSync(url);
-                    if (!data) {
-                        throw new Error('importScripts: Failed to load script: ' + url);
-                    }
-                    const code = new TextDecoder().decode(new Uint8Array(data));
-                    (0, eval)(code);
+                return jsEngine_->newNumber(id);
+            })
+        );
+
+        // __workerPost(id, data, transfer) -> undefined, or a DataCloneError message
+        jsEngine_->setGlobalProperty("__workerPost",
+            jsEngine_->newFunction("__workerPost", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                if (args.size() < 2) return jsEngine_->newUndefined();
+                int id = static_cast<int>(jsEngine_->toNumber(args[0]));
+
+                js::SerializedValue serialized;
+                std::string error;
+                js::JSValueHandle transfer = args.size() > 2 ? args[2] : js::JSValueHandle{};
+                if (!js::structuredSerialize(jsEngine_.get(), args[1], transfer, serialized, error)) {
+                    return jsEngine_->newString(error.c_str());
                 }
-            };
 
-            // Execute the worker code as a function with self and postMessage in scope.
-            // The worker code can set self.onmessage and call postMessage() / self.postMessage().
-            // We also provide a patched eval that handles Emscripten's `(var X = ...)` pattern,
-            // which is invalid as an expression but common in WASM module loaders.
-            try {
-                const wrapped = '(function(self, postMessage, __nativeEval, importScripts) {\n' +
-                    'var eval = function(code) {\n' +
-                    '  try { return __nativeEval(code); }\n' +
-                    '  catch(e) {\n' +
-                    '    if (e instanceof SyntaxError) {\n' +
-                    '      var t = code.trim();\n' +
-                    '      if (t[0]==="(" && t[t.length-1]===")") {\n' +
-                    '        var inner = t.slice(1, -1).trim();\n' +
-                    '        if (/^(?:var|let|const)\\s/.test(inner)) {\n' +
-                    '          __nativeEval(inner);\n' +
-                    '          var m = inner.match(/^(?:var|let|const)\\s+(\\w+)/);\n' +
-                    '          if (m) return __nativeEval(m[1]);\n' +
-                    '        }\n' +
-                    '      }\n' +
-                    '    }\n' +
-                    '    throw e;\n' +
-                    '  }\n' +
-                    '};\n' +
-                    code + '\n})';
-                const fn = (0, eval)(wrapped);
-                fn(workerSelf, workerSelf.postMessage, (0, eval), workerSelf.importScripts);
-            } catch (e) {
-                console.error('[Worker] Initialization error:', e);
-                const w = this;
-                setTimeout(() => { if (w.onerror) w.onerror(e); }, 0);
+                workers::WorkerMessage msg;
+                msg.payload = std::move(serialized.data);
+                msg.transfers = std::move(serialized.transfers);
+                msg.shared = std::move(serialized.shared);
+                msg.natives = std::move(serialized.natives);
+                workers::WorkerRegistry::instance().postToWorker(id, std::move(msg));
+                return jsEngine_->newUndefined();
+            })
+        );
+
+        // __workerTerminate(id)
+        jsEngine_->setGlobalProperty("__workerTerminate",
+            jsEngine_->newFunction("__workerTerminate", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                if (args.empty()) return jsEngine_->newUndefined();
+                int id = static_cast<int>(jsEngine_->toNumber(args[0]));
+                workers::WorkerRegistry::instance().terminateWorker(id);
+                return jsEngine_->newUndefined();
+            })
+        );
+
+        const char* workerPolyfill = R"JS(
+// Worker — backed by native OS threads. Each worker has its own JS engine,
+// so worker code runs in parallel with the main thread.
+if (typeof Worker === 'undefined') {
+    const _workers = new Map();
+
+    // Resolve worker source: Blob, blob: URL, or a file path
+    function _readWorkerSource(url) {
+        if (typeof Blob !== 'undefined' && url instanceof Blob) {
+            return new TextDecoder().decode(new Uint8Array(url._data));
+        }
+        url = String(url);
+        if (url.startsWith('blob:')) {
+            const blob = URL._getBlobData(url);
+            return blob && blob._data ? new TextDecoder().decode(new Uint8Array(blob._data)) : '';
+        }
+        const data = __readFileSync(url);
+        return data ? new TextDecoder().decode(new Uint8Array(data)) : '';
+    }
+
+    class Worker {
+        constructor(url, options) {
+            this.onmessage = null;
+            this.onerror = null;
+            this._listeners = { message: [], error: [] };
+            this._id = -1;
+
+            const code = _readWorkerSource(url);
+            const id = code ? __workerCreate(code) : -1;
+            if (id < 0) {
+                const message = code ? 'Failed to start worker thread' : 'Failed to load worker script';
+                setTimeout(() => this._dispatch('error', { message: message, error: new Error(message) }), 0);
                 return;
             }
 
-            this._workerSelf = workerSelf;
+            this._id = id;
+            _workers.set(id, this);
         }
 
-        postMessage(data) {
-            if (this._terminated) return;
-            const ws = this._workerSelf;
-            if (!ws || !ws.onmessage) return;
-            // Async delivery to worker's onmessage handler
-            const terminated = () => this._terminated;
-            const handler = ws.onmessage;
-            setTimeout(() => {
-                if (!terminated() && handler) {
-                    try { handler({ data }); }
-                    catch (e) { console.error('[Worker] message handler error:', e); }
-                }
-            }, 0);
+        postMessage(data, transfer) {
+            if (this._id < 0) return;
+            if (transfer && !Array.isArray(transfer)) transfer = transfer.transfer;
+            const error = __workerPost(this._id, data, transfer);
+            if (error) throw __structuredCloneHelpers.fail(error);
         }
 
         terminate() {
-            this._terminated = true;
-            this._workerSelf = null;
+            if (this._id < 0) return;
+            __workerTerminate(this._id);
+            _workers.delete(this._id);
+            this._id = -1;
         }
 
         addEventListener(type, handler) {
-            if (type === 'message') this.onmessage = handler;
-            else if (type === 'error') this.onerror = handler;
+            if (this._listeners[type] && typeof handler === 'function') this._listeners[type].push(handler);
         }
 
-        removeEventListener() {}
+        removeEventListener(type, handler) {
+            const list = this._listeners[type];
+            if (!list) return;
+            const idx = list.indexOf(handler);
+            if (idx !== -1) list.splice(idx, 1);
+        }
+
+        _dispatch(type, event) {
+            const handler = type === 'message' ? this.onmessage : this.onerror;
+            try {
+                if (handler) handler.call(this, event);
+                for (const fn of this._listeners[type]) fn.call(this, event);
+            } catch (e) {
+                console.error('[Worker] ' + type + ' handler error:', e);
+            }
+        }
     }
 
+    // Called from native code for each message a worker thread posts.
+    // type: 0 = message (deserialized data), 1 = error (message text, stack)
+    globalThis.__workerDispatch = function(id, type, payload, stack) {
+        const worker = _workers.get(id);
+        if (!worker) return;
+        if (type === 0) {
+            worker._dispatch('message', { data: payload, target: worker });
+        } else {
+            const error = new Error(payload);
+            if (stack) error.stack = stack;
+            worker._dispatch('error', { message: payload, error: error, target: worker });
+        }
+    };
+
     globalThis.Worker = Worker;
 }
 )JS";
 
-        jsEngine_->eval(urlPolyfill, "url-worker-polyfill.js");
-        std::cout << "[Mystral] URL and Worker polyfills initialized" << std::endl;
+        jsEngine_->eval(workerPolyfill, "worker-polyfill.js");
+
+        // SharedArrayBuffers are shared with workers; make sure Atomics.wait/notify
+        // exist. The main thread must never block, so Atomics.wait throws here.
+        workers::installAtomicsFallback(jsEngine_.get(), false);
+
+        workerDispatch_ = jsEngine_->getGlobalProperty("__workerDispatch");
+        jsEngine_->protect(workerDispatch_);
+        std::cout << "[Mystral] Worker API initialized (native threads)" << std::endl;
+    }
+
+    void dispatchWorkerMessage(int workerId, const workers::WorkerMessage& msg) {
+        if (!jsEngine_ || !workerDispatch_.ptr) return;
+        if (msg.type == workers::WorkerMessage::Type::TERMINATE) return;
+
+        js::JSValueHandle payload;
+        js::JSValueHandle stack = jsEngine_->newUndefined();
+        int type = 0;
+        if (msg.type == workers::WorkerMessage::Type::MESSAGE) {
+            std::string error;
+            payload = js::structuredDeserialize(jsEngine_.get(), msg.payload.data(), msg.payload.size(),
+                                                msg.transfers, msg.shared, msg.natives, error);
+            if (!payload.ptr) {
+                std::cerr << "[Worker] Failed to read message from worker " << workerId << ": " << error << std::endl;
+                return;
+            }
+        } else {
+            type = 1;
+            std::string text(msg.payload.begin(), msg.payload.end());
+            size_t split = text.find('\0');
+            if (split != std::string::npos) {
+                stack = jsEngine_->newStringUtf8(text.data() + split + 1, text.size() - split - 1);
+                text.resize(split);
+            }
+            payload = jsEngine_->newStringUtf8(text.data(), text.size());
+        }
+
+        std::vector<js::JSValueHandle> callArgs = {
+            jsEngine_->newNumber(workerId),
+            jsEngine_->newNumber(type),
+            payload,
+            stack
+        };
+        jsEngine_->call(workerDispatch_, jsEngine_->newUndefined(), callArgs);
     }
 
     void setupModules() {
@@ -2906,6 +3094,10 @@ if (typeof Worker === 'undefined') {
         std::string rootDir = std::filesystem::current_path().string();
         moduleSystem_ = std::make_unique<js::ModuleSystem>(jsEngine_.get(), rootDir);
         js::setModuleSystem(moduleSystem_.get());
+        if (config_.transpileCache) {
+            moduleSystem_->transpileCache().setDirectory(js::TranspileCache::defaultDirectory());
+        }
+        moduleSystem_->setHotUpdatesEnabled(config_.watch);
 
         jsEngine_->setGlobalProperty("__mystralRequire",
             jsEngine_->newFunction("__mystralRequire", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
@@ -3204,7 +3396,7 @@ globalThis.loadGLTF = loadGLTF;
         if (!jsEngine_) return;
 
         // Callback-based native Draco decoder: __mystralNativeDecodeDraco(buffer, attrs, callback)
-        // Runs decoding on a libuv thread pool thread, calls callback(result, error) on main thread.
+        // Runs decoding on the job pool, calls callback(result, error) on main thread.
         jsEngine_->setGlobalProperty("__mystralNativeDecodeDraco",
             jsEngine_->newFunction("__mystralNativeDecodeDraco", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
                 if (args.size() < 3) {
@@ -3235,8 +3427,7 @@ globalThis.loadGLTF = loadGLTF;
                 jsEngine_->protect(callback);
 
                 // Create decode context with a copy of the compressed data
-                auto* decCtx = new DracoDecodeContext();
-                decCtx->work.data = decCtx;
+                auto decCtx = std::make_shared<DracoDecodeContext>();
                 decCtx->compressedData.assign(
                     static_cast<const uint8_t*>(compressedData),
                     static_cast<const uint8_t*>(compressedData) + compressedSize);
@@ -3244,16 +3435,11 @@ globalThis.loadGLTF = loadGLTF;
                 decCtx->normAttrId = normAttrId;
                 decCtx->uvAttrId = uvAttrId;
                 decCtx->callback = callback;
-                decCtx->runtime = this;
-
-                // Queue decoding on libuv thread pool
-                uv_queue_work(
-                    async::EventLoop::instance().handle(),
-                    &decCtx->work,
-                    // Worker function — runs on thread pool
-                    [](uv_work_t* req) {
-                        auto* dc = static_cast<DracoDecodeContext*>(req->data);
 
+                // Queue decoding on the job pool
+                jobs::JobSystem::instance().submit(
+                    // Worker function — runs on a pool thread
+                    [dc = decCtx.get()]() {
                         draco::DecoderBuffer decoderBuffer;
                         decoderBuffer.Init(reinterpret_cast<const char*>(dc->compressedData.data()),
                                            dc->compressedData.size());
@@ -3325,13 +3511,11 @@ globalThis.loadGLTF = loadGLTF;
                         dc->numPoints = numPoints;
                         dc->numFaces = numFaces;
                     },
-                    // After-work callback — runs on main thread (libuv loop iteration)
-                    [](uv_work_t* req, int status) {
-                        auto* dc = static_cast<DracoDecodeContext*>(req->data);
-                        // Queue the result for processing on the JS main thread
-                        std::lock_guard<std::mutex> lock(dc->runtime->dracoMutex_);
-                        dc->runtime->pendingDracoCallbacks_.push(std::unique_ptr<DracoDecodeContext>(dc));
-                    }
+                    // Completion — runs on the main thread (runCompletions in pollEvents)
+                    [this, decCtx]() {
+                        deliverDracoResult(decCtx.get());
+                    },
+                    jobs::JobPriority::Normal
                 );
 
                 return jsEngine_->newUndefined();
@@ -3354,7 +3538,7 @@ globalThis.__mystralNativeDecodeDracoAsync = function(buffer, attrs) {
 )";
         jsEngine_->eval(dracoPolyfill, "draco-polyfill.js");
 
-        std::cout << "[Mystral] Native Draco decoder initialized (async, libuv thread pool)" << std::endl;
+        std::cout << "[Mystral] Native Draco decoder initialized (async, job pool)" << std::endl;
 #endif
     }
 
@@ -3368,65 +3552,57 @@ globalThis.__mystralNativeDecodeDracoAsync = function(buffer, attrs) {
 #endif
     }
 
-    void processPendingDracoCallbacks() {
 #ifdef MYSTRAL_HAS_DRACO
-        std::queue<std::unique_ptr<DracoDecodeContext>> toProcess;
-        {
-            std::lock_guard<std::mutex> lock(dracoMutex_);
-            std::swap(toProcess, pendingDracoCallbacks_);
-        }
-
-        while (!toProcess.empty()) {
-            auto dc = std::move(toProcess.front());
-            toProcess.pop();
-
-            if (!dc->error.empty()) {
-                // Error — call callback(null, errorString)
-                auto nullVal = jsEngine_->newNull();
-                auto errorVal = jsEngine_->newString(dc->error.c_str());
-                std::vector<js::JSValueHandle> callbackArgs = { nullVal, errorVal };
-                jsEngine_->call(dc->callback, jsEngine_->newUndefined(), callbackArgs);
-                std::cerr << "[Draco] " << dc->error << std::endl;
-            } else {
-                // Success — build JS result object with ArrayBuffers
-                auto result = jsEngine_->newObject();
-
-                if (!dc->positions.empty()) {
-                    jsEngine_->setProperty(result, "positions",
-                        jsEngine_->newArrayBuffer(
-                            reinterpret_cast<const uint8_t*>(dc->positions.data()),
-                            dc->positions.size() * sizeof(float)));
-                }
-                if (!dc->normals.empty()) {
-                    jsEngine_->setProperty(result, "normals",
-                        jsEngine_->newArrayBuffer(
-                            reinterpret_cast<const uint8_t*>(dc->normals.data()),
-                            dc->normals.size() * sizeof(float)));
-                }
-                if (!dc->uvs.empty()) {
-                    jsEngine_->setProperty(result, "uvs",
-                        jsEngine_->newArrayBuffer(
-                            reinterpret_cast<const uint8_t*>(dc->uvs.data()),
-                            dc->uvs.size() * sizeof(float)));
-                }
-                if (!dc->indices.empty()) {
-                    jsEngine_->setProperty(result, "indices",
-                        jsEngine_->newArrayBuffer(
-                            reinterpret_cast<const uint8_t*>(dc->indices.data()),
-                            dc->indices.size() * sizeof(uint32_t)));
-                }
-
-                std::cout << "[Draco] Decoded mesh: " << dc->numPoints << " points, " << dc->numFaces << " faces" << std::endl;
-
-                auto nullVal = jsEngine_->newNull();
-                std::vector<js::JSValueHandle> callbackArgs = { result, nullVal };
-                jsEngine_->call(dc->callback, jsEngine_->newUndefined(), callbackArgs);
+    struct DracoDecodeContext;
+
+    // Call the JS callback of a finished Draco decode (main thread)
+    void deliverDracoResult(DracoDecodeContext* dc) {
+        if (!dc->error.empty()) {
+            // Error — call callback(null, errorString)
+            auto nullVal = jsEngine_->newNull();
+            auto errorVal = jsEngine_->newString(dc->error.c_str());
+            std::vector<js::JSValueHandle> callbackArgs = { nullVal, errorVal };
+            jsEngine_->call(dc->callback, jsEngine_->newUndefined(), callbackArgs);
+            std::cerr << "[Draco] " << dc->error << std::endl;
+        } else {
+            // Success — build JS result object with ArrayBuffers
+            auto result = jsEngine_->newObject();
+
+            if (!dc->positions.empty()) {
+                jsEngine_->setProperty(result, "positions",
+                    jsEngine_->newArrayBuffer(
+                        reinterpret_cast<const uint8_t*>(dc->positions.data()),
+                        dc->positions.size() * sizeof(float)));
+            }
+            if (!dc->normals.empty()) {
+                jsEngine_->setProperty(result, "normals",
+                    jsEngine_->newArrayBuffer(
+                        reinterpret_cast<const uint8_t*>(dc->normals.data()),
+                        dc->normals.size() * sizeof(float)));
+            }
+            if (!dc->uvs.empty()) {
+                jsEngine_->setProperty(result, "uvs",
+                    jsEngine_->newArrayBuffer(
+                        reinterpret_cast<const uint8_t*>(dc->uvs.data()),
+                        dc->uvs.size() * sizeof(float)));
+            }
+            if (!dc->indices.empty()) {
+                jsEngine_->setProperty(result, "indices",
+                    jsEngine_->newArrayBuffer(
+                        reinterpret_cast<const uint8_t*>(dc->indices.data()),
+                        dc->indices.size() * sizeof(uint32_t)));
             }
 
-            jsEngine_->unprotect(dc->callback);
+            std::cout << "[Draco] Decoded mesh: " << dc->numPoints << " points, " << dc->numFaces << " faces" << std::endl;
+
+            auto nullVal = jsEngine_->newNull();
+            std::vector<js::JSValueHandle> callbackArgs = { result, nullVal };
+            jsEngine_->call(dc->callback, jsEngine_->newUndefined(), callbackArgs);
         }
-#endif
+
+        jsEngine_->unprotect(dc->callback);
     }
+#endif
 
     void executeTimerCallbacks() {
 #ifdef MYSTRAL_USE_LIBUV_TIMERS
@@ -3462,91 +3638,27 @@ globalThis.__mystralNativeDecodeDracoAsync = function(buffer, attrs) {
             }
             // For setInterval, libuv automatically repeats - nothing to do
         }
-#else
-        // Fallback: std::chrono-based timer processing
-        if (timerCallbacks_.empty()) return;
-
-        auto now = std::chrono::high_resolution_clock::now();
-
-        // Process timers - collect expired ones
-        std::vector<TimerCallback> toExecute;
-        std::vector<TimerCallback> remaining;
-
-        for (auto& timer : timerCallbacks_) {
-            if (timer.cancelled) {
-                continue;  // Skip cancelled timers
-            }
-
-            if (now >= timer.targetTime) {
-                toExecute.push_back(timer);
-            } else {
-                remaining.push_back(timer);
-            }
-        }
-
-        timerCallbacks_ = std::move(remaining);
+#endif
+        // Runtime-clock timers (no libuv, or --virtual-time)
+        // Only the heap top is inspected when nothing is due
+        timerQueue_.beginPass(async::RuntimeClock::instance().now());
 
-        // Execute expired timers
-        for (auto& timer : toExecute) {
-            // Call the callback
+        async::TimerQueue::Due timer;
+        while (timerQueue_.popDue(timer)) {
             std::vector<js::JSValueHandle> args;
             jsEngine_->call(timer.callback, jsEngine_->newUndefined(), args);
 
-            if (timer.intervalMs > 0) {
-                // Check if interval was cancelled during callback execution
-                bool wasCancelled = false;
-                for (const auto& t : timerCallbacks_) {
-                    if (t.id == timer.id && t.cancelled) {
-                        wasCancelled = true;
-                        break;
-                    }
-                }
-                // Also check cancelledTimerIds_ set
-                if (cancelledTimerIds_.count(timer.id) > 0) {
-                    wasCancelled = true;
-                }
-
-                if (!wasCancelled) {
-                    // Re-schedule interval
-                    timer.targetTime = now + std::chrono::milliseconds(timer.intervalMs);
-                    timerCallbacks_.push_back(timer);
-                } else {
-                    jsEngine_->unprotect(timer.callback);
-                    cancelledTimerIds_.erase(timer.id);
-                }
-            } else {
-                // setTimeout - unprotect and done
+            // Intervals re-arm unless cleared during their own callback
+            if (timer.intervalMs == 0 || !timerQueue_.rearm(timer)) {
                 jsEngine_->unprotect(timer.callback);
             }
         }
-#endif
     }
 
     void processPendingFileCallbacks() {
         // Process pending file callbacks - these come from async file reads
         // We process them on the main thread to ensure JS context safety
-
-        while (!pendingFileCallbacks_.empty()) {
-            auto pending = std::move(pendingFileCallbacks_.front());
-            pendingFileCallbacks_.pop();
-
-            if (pending.error.empty()) {
-                // Success - create ArrayBuffer and call callback with (data, null)
-                auto dataVal = jsEngine_->newArrayBuffer(pending.data.data(), pending.data.size());
-                auto errorVal = jsEngine_->newNull();
-                std::vector<js::JSValueHandle> callbackArgs = { dataVal, errorVal };
-                jsEngine_->call(pending.callback, jsEngine_->newUndefined(), callbackArgs);
-            } else {
-                // Error - call callback with (null, error)
-                auto nullVal = jsEngine_->newNull();
-                auto errorVal = jsEngine_->newString(pending.error.c_str());
-                std::vector<js::JSValueHandle> callbackArgs = { nullVal, errorVal };
-                jsEngine_->call(pending.callback, jsEngine_->newUndefined(), callbackArgs);
-            }
-
-            // Unprotect the callback now that we're done with it
-            jsEngine_->unprotect(pending.callback);
-        }
+        fileCallbacks_.drain(jsEngine_.get());
     }
 
     void processMicrotasks() {
@@ -3586,6 +3698,16 @@ globalThis.__mystralNativeDecodeDracoAsync = function(buffer, attrs) {
     };
     std::vector<RAFCallback> rafCallbacks_;
     int nextRafId_ = 1;
+    async::FrameScheduler frameScheduler_;  // --max-fps / mystral.targetFrameRate
+    bool inputWake_ = false;  // Low-latency wait ended on input; the next frame may start early
+    debug::FrameStats frameStats_;           // performance.frameStats() and getStats()
+    debug::PerformanceTimeline userTiming_;  // performance.mark/measure entries
+
+    // Startup timings (getStats)
+    uint64_t initStartNs_ = 0;
+    double gpuInitMs_ = 0;
+    double jsInitMs_ = 0;
+    double scriptLoadMs_ = 0;
 
     // setTimeout/setInterval state
 #ifdef MYSTRAL_USE_LIBUV_TIMERS
@@ -3608,32 +3730,19 @@ globalThis.__mystralNativeDecodeDracoAsync = function(buffer, attrs) {
     };
     std::queue<PendingTimerCallback> pendingTimerCallbacks_;
     std::mutex timerMutex_;
-#else
-    // Fallback: std::chrono-based timers (for platforms without libuv)
-    struct TimerCallback {
-        int id;
-        js::JSValueHandle callback;
-        std::chrono::high_resolution_clock::time_point targetTime;
-        int intervalMs;  // 0 for setTimeout, >0 for setInterval
-        bool cancelled;
-    };
-    std::vector<TimerCallback> timerCallbacks_;
-#endif
     std::unordered_set<int> cancelledTimerIds_;  // Track IDs cancelled during callback execution
     int nextTimerId_ = 1;
+#endif
+    // Runtime-clock timers (platforms without libuv, and --virtual-time).
+    // Heap-ordered with slot-map ids: no per-frame scans or copies.
+    async::TimerQueue timerQueue_;
 
     // Pending async file read callbacks (processed on main thread)
-    struct PendingFileCallback {
-        js::JSValueHandle callback;
-        std::vector<uint8_t> data;
-        std::string error;
-    };
-    std::queue<PendingFileCallback> pendingFileCallbacks_;
+    async::FileCallbackQueue fileCallbacks_;
 
 #ifdef MYSTRAL_HAS_DRACO
-    // Context for async Draco decode work (libuv thread pool)
+    // Context for async Draco decode work (job pool)
     struct DracoDecodeContext {
-        uv_work_t work;
         // Input (copied from JS, safe to read on worker thread)
         std::vector<uint8_t> compressedData;
         int posAttrId = -1;
@@ -3647,30 +3756,33 @@ globalThis.__mystralNativeDecodeDracoAsync = function(buffer, attrs) {
         uint32_t numPoints = 0;
         uint32_t numFaces = 0;
         std::string error;
-        // JS callback + back-reference
+        // JS callback (protected until delivered)
         js::JSValueHandle callback;
-        RuntimeImpl* runtime = nullptr;
     };
-    std::queue<std::unique_ptr<DracoDecodeContext>> pendingDracoCallbacks_;
-    std::mutex dracoMutex_;
 #endif
 
     // DOM Event system
-    struct EventListener {
-        js::JSValueHandle callback;
-        bool useCapture;
-    };
-    // Event listeners: target -> eventType -> list of listeners
-    // Targets: "document", "window", "canvas"
-    std::map<std::string, std::map<std::string, std::vector<EventListener>>> eventListeners_;
+    // Listeners by interned event type id and target (document, window, canvas)
+    js::EventListenerTable eventListeners_;
+    // Interned event type strings as JS values, indexed by type id (protected)
+    std::vector<js::JSValueHandle> eventTypeStrings_;
+    // Fixed-shape event constructors, one per input event kind (protected)
+    js::JSValueHandle makeKeyboardEvent_;
+    js::JSValueHandle makeMouseEvent_;
+    js::JSValueHandle makePointerEvent_;
+    js::JSValueHandle makeWheelEvent_;
 
     // Cached canvas element (created once, returned by getElementById)
     js::JSValueHandle canvasElement_;
 
+    // JS-side Worker message dispatcher (__workerDispatch), protected
+    js::JSValueHandle workerDispatch_;
+
     // Hot reload state
     std::string scriptPath_;  // Path to the currently loaded script
-    int watchId_ = -1;        // File watcher ID (-1 if not watching)
-    bool reloadRequested_ = false;  // Set when a file change is detected
+    std::unordered_map<std::string, int> moduleWatchIds_;  // Watched module file -> watch ID
+    std::unordered_set<std::string> pendingModuleChanges_;  // Changed files waiting for the debounce
+    uint64_t lastModuleChangeNs_ = 0;
 
     void setupDOMEvents() {
         if (!jsEngine_) return;
@@ -3698,7 +3810,7 @@ globalThis.__mystralNativeDecodeDracoAsync = function(buffer, attrs) {
                 bool useCapture = args.size() > 2 ? jsEngine_->toBoolean(args[2]) : false;
 
                 jsEngine_->protect(callback);
-                eventListeners_["canvas"][eventType].push_back({callback, useCapture});
+                eventListeners_.add(js::EventTarget::Canvas, eventType, callback, useCapture);
 
                 // std::cout << "[DOM] canvas.addEventListener('" << eventType << "')" << std::endl;
 
@@ -3807,7 +3919,7 @@ globalThis.__mystralNativeDecodeDracoAsync = function(buffer, attrs) {
                 bool useCapture = args.size() > 2 ? jsEngine_->toBoolean(args[2]) : false;
 
                 jsEngine_->protect(callback);
-                eventListeners_["document"][eventType].push_back({callback, useCapture});
+                eventListeners_.add(js::EventTarget::Document, eventType, callback, useCapture);
 
                 return jsEngine_->newUndefined();
             })
@@ -3816,17 +3928,8 @@ globalThis.__mystralNativeDecodeDracoAsync = function(buffer, attrs) {
         // document.removeEventListener
         jsEngine_->setProperty(document, "removeEventListener",
             jsEngine_->newFunction("removeEventListener", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                if (args.size() < 2) return jsEngine_->newUndefined();
-
-                std::string eventType = jsEngine_->toString(args[0]);
-                js::JSValueHandle callback = args[1];
-
-                auto& listeners = eventListeners_["document"][eventType];
-                for (auto it = listeners.begin(); it != listeners.end(); ++it) {
-                    // Note: Comparing function handles is tricky. For now, we don't properly compare.
-                    // A full implementation would need to track callback identity.
-                }
-
+                // Note: Comparing function handles is tricky. For now, we don't properly compare.
+                // A full implementation would need to track callback identity.
                 return jsEngine_->newUndefined();
             })
         );
@@ -3978,7 +4081,7 @@ globalThis.__mystralNativeDecodeDracoAsync = function(buffer, attrs) {
                 bool useCapture = args.size() > 2 ? jsEngine_->toBoolean(args[2]) : false;
 
                 jsEngine_->protect(callback);
-                eventListeners_["window"][eventType].push_back({callback, useCapture});
+                eventListeners_.add(js::EventTarget::Window, eventType, callback, useCapture);
 
                 return jsEngine_->newUndefined();
             })
@@ -4007,6 +4110,8 @@ globalThis.__mystralNativeDecodeDracoAsync = function(buffer, attrs) {
             dispatchMouseEvent(e);
         });
 
+        platform::setMotionCoalescing(config_.coalescePointerMoves);
+
         platform::setPointerCallback([this](const platform::PointerEventData& e) {
             dispatchPointerEvent(e);
         });
@@ -4023,52 +4128,7 @@ globalThis.__mystralNativeDecodeDracoAsync = function(buffer, attrs) {
             dispatchResizeEvent(e);
         });
 
-        // Set up navigator.getGamepads()
-        auto navigator = jsEngine_->getGlobalProperty("navigator");
-        if (jsEngine_->isUndefined(navigator)) {
-            navigator = jsEngine_->newObject();
-            jsEngine_->setGlobalProperty("navigator", navigator);
-        }
-
-        jsEngine_->setProperty(navigator, "getGamepads",
-            jsEngine_->newFunction("getGamepads", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                int count = platform::getGamepadCount();
-                auto gamepads = jsEngine_->newArray(4);  // Standard says 4 slots
-
-                for (int i = 0; i < 4; i++) {
-                    platform::GamepadState state;
-                    if (platform::getGamepadState(i, &state)) {
-                        auto gamepad = jsEngine_->newObject();
-                        jsEngine_->setProperty(gamepad, "index", jsEngine_->newNumber(state.index));
-                        jsEngine_->setProperty(gamepad, "id", jsEngine_->newString(state.id.c_str()));
-                        jsEngine_->setProperty(gamepad, "connected", jsEngine_->newBoolean(state.connected));
-
-                        // Axes
-                        auto axes = jsEngine_->newArray(state.numAxes);
-                        for (int a = 0; a < state.numAxes; a++) {
-                            jsEngine_->setPropertyIndex(axes, a, jsEngine_->newNumber(state.axes[a]));
-                        }
-                        jsEngine_->setProperty(gamepad, "axes", axes);
-
-                        // Buttons
-                        auto buttons = jsEngine_->newArray(state.numButtons);
-                        for (int b = 0; b < state.numButtons; b++) {
-                            auto btn = jsEngine_->newObject();
-                            jsEngine_->setProperty(btn, "pressed", jsEngine_->newBoolean(state.buttons[b]));
-                            jsEngine_->setProperty(btn, "value", jsEngine_->newNumber(state.buttonValues[b]));
-                            jsEngine_->setPropertyIndex(buttons, b, btn);
-                        }
-                        jsEngine_->setProperty(gamepad, "buttons", buttons);
-
-                        jsEngine_->setPropertyIndex(gamepads, i, gamepad);
-                    } else {
-                        jsEngine_->setPropertyIndex(gamepads, i, jsEngine_->newNull());
-                    }
-                }
-
-                return gamepads;
-            })
-        );
+        setupInputState();
 
         // Pre-cache image format support for @loaders.gl
         // This must run before any user script that uses the GLTF loader
@@ -4091,142 +4151,387 @@ globalThis.__mystralNativeDecodeDracoAsync = function(buffer, attrs) {
         )";
         jsEngine_->eval(imageSupportInit, "image-support-init");
 
+        // Event factories: one constructor per event kind so every event of a
+        // kind shares a shape, with preventDefault/stopPropagation on the
+        // prototype. Dispatch fills fields positionally in a single call.
+        const char* eventFactoriesInit = R"(
+            (function() {
+                function preventDefault() {}
+                function stopPropagation() {}
+                function setModifiers(e, mods) {
+                    e.ctrlKey = (mods & 1) !== 0;
+                    e.shiftKey = (mods & 2) !== 0;
+                    e.altKey = (mods & 4) !== 0;
+                    e.metaKey = (mods & 8) !== 0;
+                }
+                function setMouse(e, type, x, y, mx, my, button, buttons, mods) {
+                    e.type = type;
+                    e.clientX = x; e.clientY = y;
+                    e.pageX = x; e.pageY = y;
+                    e.offsetX = x; e.offsetY = y;
+                    e.movementX = mx; e.movementY = my;
+                    e.button = button; e.buttons = buttons;
+                    setModifiers(e, mods);
+                }
+
+                function KeyboardEvent(type, key, code, keyCode, repeat, mods) {
+                    this.type = type;
+                    this.key = key;
+                    this.code = code;
+                    this.keyCode = keyCode;
+                    this.repeat = repeat;
+                    setModifiers(this, mods);
+                }
+                function MouseEvent(type, x, y, mx, my, button, buttons, mods) {
+                    setMouse(this, type, x, y, mx, my, button, buttons, mods);
+                }
+                function PointerEvent(type, x, y, mx, my, button, buttons, mods,
+                                      pointerId, pointerType, isPrimary, width, height, pressure,
+                                      coalesced, predicted) {
+                    setMouse(this, type, x, y, mx, my, button, buttons, mods);
+                    this.pointerId = pointerId;
+                    this.pointerType = pointerType;
+                    this.isPrimary = isPrimary;
+                    this.width = width;
+                    this.height = height;
+                    this.pressure = pressure;
+                    // Native sample buffers; events are only built when asked for
+                    this._coalesced = coalesced;
+                    this._predicted = predicted;
+                }
+                function modifiersOf(e) {
+                    return (e.ctrlKey ? 1 : 0) | (e.shiftKey ? 2 : 0) | (e.altKey ? 4 : 0) | (e.metaKey ? 8 : 0);
+                }
+                function samplesToEvents(e, buffer) {
+                    var events = [];
+                    if (!buffer) return events;
+                    var s = new Float64Array(buffer);
+                    var mods = modifiersOf(e);
+                    for (var i = 0; i + 4 < s.length; i += 5) {
+                        var sample = new PointerEvent(e.type, s[i], s[i + 1], s[i + 2], s[i + 3],
+                                                      e.button, e.buttons, mods, e.pointerId, e.pointerType,
+                                                      e.isPrimary, e.width, e.height, e.pressure, null, null);
+                        sample.timeStamp = s[i + 4];
+                        events.push(sample);
+                    }
+                    return events;
+                }
+                PointerEvent.prototype.getCoalescedEvents = function() {
+                    return samplesToEvents(this, this._coalesced);
+                };
+                PointerEvent.prototype.getPredictedEvents = function() {
+                    return samplesToEvents(this, this._predicted);
+                };
+                function WheelEvent(type, x, y, dx, dy, dz, deltaMode, mods) {
+                    this.type = type;
+                    this.clientX = x; this.clientY = y;
+                    this.deltaX = dx; this.deltaY = dy; this.deltaZ = dz;
+                    this.deltaMode = deltaMode;
+                    setModifiers(this, mods);
+                }
+                [KeyboardEvent, MouseEvent, PointerEvent, WheelEvent].forEach(function(C) {
+                    C.prototype.preventDefault = preventDefault;
+                    C.prototype.stopPropagation = stopPropagation;
+                });
+
+                return {
+                    keyboard: function(type, key, code, keyCode, repeat, mods) {
+                        return new KeyboardEvent(type, key, code, keyCode, repeat, mods);
+                    },
+                    mouse: function(type, x, y, mx, my, button, buttons, mods) {
+                        return new MouseEvent(type, x, y, mx, my, button, buttons, mods);
+                    },
+                    pointer: function(type, x, y, mx, my, button, buttons, mods,
+                                      pointerId, pointerType, isPrimary, width, height, pressure,
+                                      coalesced, predicted) {
+                        return new PointerEvent(type, x, y, mx, my, button, buttons, mods,
+                                                pointerId, pointerType, isPrimary, width, height, pressure,
+                                                coalesced, predicted);
+                    },
+                    wheel: function(type, x, y, dx, dy, dz, deltaMode, mods) {
+                        return new WheelEvent(type, x, y, dx, dy, dz, deltaMode, mods);
+                    }
+                };
+            })()
+        )";
+        // Classic script: module-mode eval does not yield the expression value
+        auto factories = jsEngine_->evalScriptWithResult(eventFactoriesInit, "event-factories.js");
+        if (factories.ptr) {
+            makeKeyboardEvent_ = jsEngine_->getProperty(factories, "keyboard");
+            makeMouseEvent_ = jsEngine_->getProperty(factories, "mouse");
+            makePointerEvent_ = jsEngine_->getProperty(factories, "pointer");
+            makeWheelEvent_ = jsEngine_->getProperty(factories, "wheel");
+            for (auto* factory : {&makeKeyboardEvent_, &makeMouseEvent_, &makePointerEvent_, &makeWheelEvent_}) {
+                jsEngine_->protect(*factory);
+            }
+            jsEngine_->releaseHandle(factories);
+        }
+
         std::cout << "[Mystral] DOM event system initialized" << std::endl;
     }
 
-    void dispatchKeyboardEvent(const platform::KeyboardEventData& e) {
-        auto event = jsEngine_->newObject();
-        jsEngine_->setProperty(event, "type", jsEngine_->newString(e.type.c_str()));
-        jsEngine_->setProperty(event, "key", jsEngine_->newString(e.key.c_str()));
-        jsEngine_->setProperty(event, "code", jsEngine_->newString(e.code.c_str()));
-        jsEngine_->setProperty(event, "keyCode", jsEngine_->newNumber(e.keyCode));
-        jsEngine_->setProperty(event, "repeat", jsEngine_->newBoolean(e.repeat));
-        jsEngine_->setProperty(event, "ctrlKey", jsEngine_->newBoolean(e.ctrlKey));
-        jsEngine_->setProperty(event, "shiftKey", jsEngine_->newBoolean(e.shiftKey));
-        jsEngine_->setProperty(event, "altKey", jsEngine_->newBoolean(e.altKey));
-        jsEngine_->setProperty(event, "metaKey", jsEngine_->newBoolean(e.metaKey));
-
-        // preventDefault and stopPropagation (stubs)
-        jsEngine_->setProperty(event, "preventDefault",
-            jsEngine_->newFunction("preventDefault", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                return js::JSValueHandle{nullptr, nullptr};
-            })
-        );
-        jsEngine_->setProperty(event, "stopPropagation",
-            jsEngine_->newFunction("stopPropagation", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                return js::JSValueHandle{nullptr, nullptr};
+    /**
+     * mystral.input.state and navigator.getGamepads()
+     * Both read platform::InputState through external ArrayBuffers, so polling
+     * input allocates nothing: the views and Gamepad objects are created once
+     * and getGamepads() returns the same array every call.
+     */
+    void setupInputState() {
+        auto& state = platform::getInputState();
+        using platform::InputState;
+
+        jsEngine_->setGlobalProperty("__inputKeys",
+            jsEngine_->newArrayBufferExternal(state.keys, sizeof(state.keys)));
+        jsEngine_->setGlobalProperty("__inputValues",
+            jsEngine_->newArrayBufferExternal(state.values, sizeof(state.values)));
+
+        // Slot indices of values[]
+        auto layout = jsEngine_->newObject();
+        jsEngine_->setProperty(layout, "mouseX", jsEngine_->newNumber(InputState::MouseX));
+        jsEngine_->setProperty(layout, "mouseY", jsEngine_->newNumber(InputState::MouseY));
+        jsEngine_->setProperty(layout, "movementX", jsEngine_->newNumber(InputState::MovementX));
+        jsEngine_->setProperty(layout, "movementY", jsEngine_->newNumber(InputState::MovementY));
+        jsEngine_->setProperty(layout, "buttons", jsEngine_->newNumber(InputState::MouseButtons));
+        jsEngine_->setProperty(layout, "wheelX", jsEngine_->newNumber(InputState::WheelX));
+        jsEngine_->setProperty(layout, "wheelY", jsEngine_->newNumber(InputState::WheelY));
+        jsEngine_->setProperty(layout, "gamepadGeneration", jsEngine_->newNumber(InputState::GamepadGeneration));
+        jsEngine_->setProperty(layout, "gamepadBase", jsEngine_->newNumber(InputState::GamepadBase));
+        jsEngine_->setProperty(layout, "gamepadStride", jsEngine_->newNumber(InputState::kGamepadStride));
+        jsEngine_->setProperty(layout, "gamepadAxes", jsEngine_->newNumber(InputState::kGamepadAxes));
+        jsEngine_->setProperty(layout, "gamepadButtons", jsEngine_->newNumber(InputState::kGamepadButtons));
+        jsEngine_->setProperty(layout, "maxGamepads", jsEngine_->newNumber(InputState::kMaxGamepads));
+        jsEngine_->setGlobalProperty("__inputLayout", layout);
+
+        // DOM code -> index into keys[]
+        auto keyCodes = jsEngine_->newObject();
+        for (uint32_t scancode = 0; scancode < InputState::kKeyCount; scancode++) {
+            std::string code = platform::sdlKeyToDOMCode(0, scancode);
+            if (code != "Unidentified") {
+                jsEngine_->setProperty(keyCodes, code.c_str(), jsEngine_->newNumber(scancode));
+            }
+        }
+        jsEngine_->setGlobalProperty("__inputKeyCodes", keyCodes);
+
+        // Gamepad name, read only when a pad connects or disconnects
+        jsEngine_->setGlobalProperty("__inputGamepadId",
+            jsEngine_->newFunction("__inputGamepadId", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                platform::GamepadState pad;
+                int index = args.empty() ? -1 : (int)jsEngine_->toNumber(args[0]);
+                if (!platform::getGamepadState(index, &pad)) return jsEngine_->newString("");
+                return jsEngine_->newString(pad.id.c_str());
             })
         );
 
-        // Dispatch to document, window, and canvas listeners
-        dispatchToListeners("document", e.type, event);
-        dispatchToListeners("window", e.type, event);
-        dispatchToListeners("canvas", e.type, event);
+        jsEngine_->eval(R"(
+(function() {
+    const mystral = globalThis.mystral || (globalThis.mystral = {});
+    const L = __inputLayout;
+    const keys = new Uint8Array(__inputKeys);
+    const values = new Float32Array(__inputValues);
+    const keyCodes = __inputKeyCodes;
+
+    mystral.input = {
+        state: { keys: keys, values: values, layout: L },
+        keyCodes: keyCodes,
+        isKeyDown(code) {
+            const index = keyCodes[code];
+            return index !== undefined && keys[index] !== 0;
+        },
+    };
+
+    function GamepadButton(slot) { this._slot = slot; }
+    Object.defineProperties(GamepadButton.prototype, {
+        pressed: { get() { return values[this._slot] > 0.5; } },
+        touched: { get() { return values[this._slot] > 0.5; } },
+        value: { get() { return values[this._slot]; } },
+    });
+
+    function Gamepad(index) {
+        const base = L.gamepadBase + index * L.gamepadStride;
+        this.index = index;
+        this.id = '';
+        this.mapping = 'standard';
+        this._base = base;
+        // Live views: read them again each frame rather than copying
+        this.axes = values.subarray(base + 1, base + 1 + L.gamepadAxes);
+        this.buttons = [];
+        for (let b = 0; b < L.gamepadButtons; b++) {
+            this.buttons.push(new GamepadButton(base + 1 + L.gamepadAxes + b));
+        }
     }
+    Object.defineProperty(Gamepad.prototype, 'connected', {
+        get() { return values[this._base] !== 0; },
+    });
 
-    void dispatchMouseEvent(const platform::MouseEventData& e) {
-        auto event = jsEngine_->newObject();
-        jsEngine_->setProperty(event, "type", jsEngine_->newString(e.type.c_str()));
-        jsEngine_->setProperty(event, "clientX", jsEngine_->newNumber(e.clientX));
-        jsEngine_->setProperty(event, "clientY", jsEngine_->newNumber(e.clientY));
-        jsEngine_->setProperty(event, "pageX", jsEngine_->newNumber(e.clientX));
-        jsEngine_->setProperty(event, "pageY", jsEngine_->newNumber(e.clientY));
-        jsEngine_->setProperty(event, "offsetX", jsEngine_->newNumber(e.clientX));
-        jsEngine_->setProperty(event, "offsetY", jsEngine_->newNumber(e.clientY));
-        jsEngine_->setProperty(event, "movementX", jsEngine_->newNumber(e.movementX));
-        jsEngine_->setProperty(event, "movementY", jsEngine_->newNumber(e.movementY));
-        jsEngine_->setProperty(event, "button", jsEngine_->newNumber(e.button));
-        jsEngine_->setProperty(event, "buttons", jsEngine_->newNumber(e.buttons));
-        jsEngine_->setProperty(event, "ctrlKey", jsEngine_->newBoolean(e.ctrlKey));
-        jsEngine_->setProperty(event, "shiftKey", jsEngine_->newBoolean(e.shiftKey));
-        jsEngine_->setProperty(event, "altKey", jsEngine_->newBoolean(e.altKey));
-        jsEngine_->setProperty(event, "metaKey", jsEngine_->newBoolean(e.metaKey));
-
-        jsEngine_->setProperty(event, "preventDefault",
-            jsEngine_->newFunction("preventDefault", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                return js::JSValueHandle{nullptr, nullptr};
-            })
-        );
-        jsEngine_->setProperty(event, "stopPropagation",
-            jsEngine_->newFunction("stopPropagation", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                return js::JSValueHandle{nullptr, nullptr};
-            })
-        );
+    const pads = [];
+    const slots = [];
+    for (let i = 0; i < L.maxGamepads; i++) {
+        pads.push(new Gamepad(i));
+        slots.push(null);
+    }
+    let generation = -1;
+
+    const nav = globalThis.navigator || (globalThis.navigator = {});
+    nav.getGamepads = function() {
+        const current = values[L.gamepadGeneration];
+        const refreshIds = current !== generation;
+        generation = current;
+        for (let i = 0; i < pads.length; i++) {
+            const pad = pads[i];
+            if (values[pad._base] !== 0) {
+                if (refreshIds) pad.id = __inputGamepadId(i);
+                slots[i] = pad;
+            } else {
+                slots[i] = null;
+            }
+        }
+        return slots;
+    };
+})();
+)", "input-state.js");
+    }
 
-        dispatchToListeners("document", e.type, event);
-        dispatchToListeners("window", e.type, event);
-        dispatchToListeners("canvas", e.type, event);
+    // Modifier keys packed for the event factories (ctrl, shift, alt, meta)
+    static int modifierBits(bool ctrlKey, bool shiftKey, bool altKey, bool metaKey) {
+        return (ctrlKey ? 1 : 0) | (shiftKey ? 2 : 0) | (altKey ? 4 : 0) | (metaKey ? 8 : 0);
     }
 
-    void dispatchPointerEvent(const platform::PointerEventData& e) {
-        auto event = jsEngine_->newObject();
-        jsEngine_->setProperty(event, "type", jsEngine_->newString(e.type.c_str()));
-        jsEngine_->setProperty(event, "clientX", jsEngine_->newNumber(e.clientX));
-        jsEngine_->setProperty(event, "clientY", jsEngine_->newNumber(e.clientY));
-        jsEngine_->setProperty(event, "pageX", jsEngine_->newNumber(e.clientX));
-        jsEngine_->setProperty(event, "pageY", jsEngine_->newNumber(e.clientY));
-        jsEngine_->setProperty(event, "offsetX", jsEngine_->newNumber(e.clientX));
-        jsEngine_->setProperty(event, "offsetY", jsEngine_->newNumber(e.clientY));
-        jsEngine_->setProperty(event, "movementX", jsEngine_->newNumber(e.movementX));
-        jsEngine_->setProperty(event, "movementY", jsEngine_->newNumber(e.movementY));
-        jsEngine_->setProperty(event, "button", jsEngine_->newNumber(e.button));
-        jsEngine_->setProperty(event, "buttons", jsEngine_->newNumber(e.buttons));
-        jsEngine_->setProperty(event, "ctrlKey", jsEngine_->newBoolean(e.ctrlKey));
-        jsEngine_->setProperty(event, "shiftKey", jsEngine_->newBoolean(e.shiftKey));
-        jsEngine_->setProperty(event, "altKey", jsEngine_->newBoolean(e.altKey));
-        jsEngine_->setProperty(event, "metaKey", jsEngine_->newBoolean(e.metaKey));
-        // PointerEvent specific properties
-        jsEngine_->setProperty(event, "pointerId", jsEngine_->newNumber(e.pointerId));
-        jsEngine_->setProperty(event, "pointerType", jsEngine_->newString(e.pointerType.c_str()));
-        jsEngine_->setProperty(event, "isPrimary", jsEngine_->newBoolean(e.isPrimary));
-        jsEngine_->setProperty(event, "width", jsEngine_->newNumber(e.width));
-        jsEngine_->setProperty(event, "height", jsEngine_->newNumber(e.height));
-        jsEngine_->setProperty(event, "pressure", jsEngine_->newNumber(e.pressure));
-
-        jsEngine_->setProperty(event, "preventDefault",
-            jsEngine_->newFunction("preventDefault", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                return js::JSValueHandle{nullptr, nullptr};
-            })
-        );
-        jsEngine_->setProperty(event, "stopPropagation",
-            jsEngine_->newFunction("stopPropagation", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                return js::JSValueHandle{nullptr, nullptr};
-            })
-        );
+    /**
+     * Interned id of an event type, or kNoType when no target listens for it
+     * Dispatchers return early on kNoType, so unheard input events never
+     * allocate a JS object.
+     */
+    js::EventListenerTable::TypeId listenedEventType(const std::string& type) const {
+        auto id = eventListeners_.find(type);
+        return eventListeners_.hasListeners(id) ? id : js::EventListenerTable::kNoType;
+    }
 
-        dispatchToListeners("document", e.type, event);
-        dispatchToListeners("window", e.type, event);
-        dispatchToListeners("canvas", e.type, event);
+    // The event type as a JS string, created once per type id
+    js::JSValueHandle eventTypeString(js::EventListenerTable::TypeId id, const std::string& type) {
+        if (id >= eventTypeStrings_.size()) {
+            eventTypeStrings_.resize(id + 1);
+        }
+        if (!eventTypeStrings_[id].ptr) {
+            eventTypeStrings_[id] = jsEngine_->newString(type.c_str());
+            jsEngine_->protect(eventTypeStrings_[id]);
+        }
+        return eventTypeStrings_[id];
     }
 
-    void dispatchWheelEvent(const platform::WheelEventData& e) {
-        auto event = jsEngine_->newObject();
-        jsEngine_->setProperty(event, "type", jsEngine_->newString(e.type.c_str()));
-        jsEngine_->setProperty(event, "clientX", jsEngine_->newNumber(e.clientX));
-        jsEngine_->setProperty(event, "clientY", jsEngine_->newNumber(e.clientY));
-        jsEngine_->setProperty(event, "deltaX", jsEngine_->newNumber(e.deltaX));
-        jsEngine_->setProperty(event, "deltaY", jsEngine_->newNumber(e.deltaY));
-        jsEngine_->setProperty(event, "deltaZ", jsEngine_->newNumber(e.deltaZ));
-        jsEngine_->setProperty(event, "deltaMode", jsEngine_->newNumber(e.deltaMode));
-        jsEngine_->setProperty(event, "ctrlKey", jsEngine_->newBoolean(e.ctrlKey));
-        jsEngine_->setProperty(event, "shiftKey", jsEngine_->newBoolean(e.shiftKey));
-        jsEngine_->setProperty(event, "altKey", jsEngine_->newBoolean(e.altKey));
-        jsEngine_->setProperty(event, "metaKey", jsEngine_->newBoolean(e.metaKey));
-
-        jsEngine_->setProperty(event, "preventDefault",
-            jsEngine_->newFunction("preventDefault", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                return js::JSValueHandle{nullptr, nullptr};
-            })
-        );
+    // Build an event through one of the factories, releasing the argument handles
+    js::JSValueHandle makeEvent(js::JSValueHandle factory, const std::vector<js::JSValueHandle>& args) {
+        if (!factory.ptr) {
+            for (const auto& arg : args) {
+                jsEngine_->releaseHandle(arg);
+            }
+            return {};
+        }
+        auto thisArg = jsEngine_->newUndefined();
+        auto event = jsEngine_->call(factory, thisArg, args);
+        jsEngine_->releaseHandle(thisArg);
+        for (const auto& arg : args) {
+            jsEngine_->releaseHandle(arg);
+        }
+        return event;
+    }
+
+    // Pointer samples as an ArrayBuffer of Float64 (x, y, movementX, movementY, timeStamp), or null
+    js::JSValueHandle pointerSamples(const platform::PointerSample* samples, size_t count) {
+        if (!samples || count == 0) return jsEngine_->newNull();
+        return jsEngine_->newArrayBuffer(reinterpret_cast<const uint8_t*>(samples),
+                                         count * sizeof(platform::PointerSample));
+    }
+
+    // Dispatch to document, window, and canvas listeners, then drop our handle
+    void dispatchToAllTargets(js::EventListenerTable::TypeId type, js::JSValueHandle event) {
+        if (!event.ptr) return;
+        dispatchToListeners(js::EventTarget::Document, type, event);
+        dispatchToListeners(js::EventTarget::Window, type, event);
+        dispatchToListeners(js::EventTarget::Canvas, type, event);
+        jsEngine_->releaseHandle(event);
+    }
+
+    void dispatchKeyboardEvent(const platform::KeyboardEventData& e) {
+        auto type = listenedEventType(e.type);
+        if (type == js::EventListenerTable::kNoType) return;
+
+        auto event = makeEvent(makeKeyboardEvent_, {
+            eventTypeString(type, e.type),
+            jsEngine_->newString(e.key.c_str()),
+            jsEngine_->newString(e.code.c_str()),
+            jsEngine_->newNumber(e.keyCode),
+            jsEngine_->newBoolean(e.repeat),
+            jsEngine_->newNumber(modifierBits(e.ctrlKey, e.shiftKey, e.altKey, e.metaKey)),
+        });
+        dispatchToAllTargets(type, event);
+    }
+
+    void dispatchMouseEvent(const platform::MouseEventData& e) {
+        auto type = listenedEventType(e.type);
+        if (type == js::EventListenerTable::kNoType) return;
+
+        auto event = makeEvent(makeMouseEvent_, {
+            eventTypeString(type, e.type),
+            jsEngine_->newNumber(e.clientX),
+            jsEngine_->newNumber(e.clientY),
+            jsEngine_->newNumber(e.movementX),
+            jsEngine_->newNumber(e.movementY),
+            jsEngine_->newNumber(e.button),
+            jsEngine_->newNumber(e.buttons),
+            jsEngine_->newNumber(modifierBits(e.ctrlKey, e.shiftKey, e.altKey, e.metaKey)),
+        });
+        dispatchToAllTargets(type, event);
+    }
+
+    void dispatchPointerEvent(const platform::PointerEventData& e) {
+        auto type = listenedEventType(e.type);
+        if (type == js::EventListenerTable::kNoType) return;
+
+        auto event = makeEvent(makePointerEvent_, {
+            eventTypeString(type, e.type),
+            jsEngine_->newNumber(e.clientX),
+            jsEngine_->newNumber(e.clientY),
+            jsEngine_->newNumber(e.movementX),
+            jsEngine_->newNumber(e.movementY),
+            jsEngine_->newNumber(e.button),
+            jsEngine_->newNumber(e.buttons),
+            jsEngine_->newNumber(modifierBits(e.ctrlKey, e.shiftKey, e.altKey, e.metaKey)),
+            // PointerEvent specific properties
+            jsEngine_->newNumber(e.pointerId),
+            jsEngine_->newString(e.pointerType.c_str()),
+            jsEngine_->newBoolean(e.isPrimary),
+            jsEngine_->newNumber(e.width),
+            jsEngine_->newNumber(e.height),
+            jsEngine_->newNumber(e.pressure),
+            pointerSamples(e.coalesced, e.coalescedCount),
+            pointerSamples(e.predicted, e.predictedCount),
+        });
+        dispatchToAllTargets(type, event);
+    }
 
-        dispatchToListeners("document", e.type, event);
-        dispatchToListeners("window", e.type, event);
-        dispatchToListeners("canvas", e.type, event);
+    void dispatchWheelEvent(const platform::WheelEventData& e) {
+        auto type = listenedEventType(e.type);
+        if (type == js::EventListenerTable::kNoType) return;
+
+        auto event = makeEvent(makeWheelEvent_, {
+            eventTypeString(type, e.type),
+            jsEngine_->newNumber(e.clientX),
+            jsEngine_->newNumber(e.clientY),
+            jsEngine_->newNumber(e.deltaX),
+            jsEngine_->newNumber(e.deltaY),
+            jsEngine_->newNumber(e.deltaZ),
+            jsEngine_->newNumber(e.deltaMode),
+            jsEngine_->newNumber(modifierBits(e.ctrlKey, e.shiftKey, e.altKey, e.metaKey)),
+        });
+        dispatchToAllTargets(type, event);
     }
 
     void dispatchGamepadEvent(const platform::GamepadEventData& e) {
+        auto type = eventListeners_.find(e.type);
+        if (!eventListeners_.hasListeners(type, js::EventTarget::Window)) return;
+
         auto event = jsEngine_->newObject();
-        jsEngine_->setProperty(event, "type", jsEngine_->newString(e.type.c_str()));
+        jsEngine_->setProperty(event, "type", eventTypeString(type, e.type));
 
         // Create gamepad object
         auto gamepad = jsEngine_->newObject();
@@ -4236,7 +4541,8 @@ globalThis.__mystralNativeDecodeDracoAsync = function(buffer, attrs) {
 
         jsEngine_->setProperty(event, "gamepad", gamepad);
 
-        dispatchToListeners("window", e.type, event);
+        dispatchToListeners(js::EventTarget::Window, type, event);
+        jsEngine_->releaseHandle(event);
     }
 
     void dispatchResizeEvent(const platform::ResizeEventData& e) {
@@ -4249,32 +4555,30 @@ globalThis.__mystralNativeDecodeDracoAsync = function(buffer, attrs) {
         jsEngine_->setProperty(window, "innerWidth", jsEngine_->newNumber(e.width));
         jsEngine_->setProperty(window, "innerHeight", jsEngine_->newNumber(e.height));
 
+        auto type = eventListeners_.find("resize");
+        if (!eventListeners_.hasListeners(type, js::EventTarget::Window)) return;
+
         auto event = jsEngine_->newObject();
-        jsEngine_->setProperty(event, "type", jsEngine_->newString("resize"));
+        jsEngine_->setProperty(event, "type", eventTypeString(type, "resize"));
 
-        dispatchToListeners("window", "resize", event);
+        dispatchToListeners(js::EventTarget::Window, type, event);
+        jsEngine_->releaseHandle(event);
     }
 
-    void dispatchToListeners(const std::string& target, const std::string& eventType, js::JSValueHandle event) {
-        auto targetIt = eventListeners_.find(target);
-        if (targetIt == eventListeners_.end()) {
-            // Debug: no listeners registered for this target
-            return;
-        }
-
-        auto typeIt = targetIt->second.find(eventType);
-        if (typeIt == targetIt->second.end()) {
-            // Debug: no listeners for this event type on this target
-            return;
-        }
-
-        // Copy listeners in case they modify the list during iteration
-        auto listeners = typeIt->second;
-
-        for (const auto& listener : listeners) {
-            std::vector<js::JSValueHandle> args = {event};
-            jsEngine_->call(listener.callback, jsEngine_->newUndefined(), args);
+    void dispatchToListeners(js::EventTarget target, js::EventListenerTable::TypeId type, js::JSValueHandle event) {
+        if (!eventListeners_.hasListeners(type, target)) return;
+
+        // Listeners added during dispatch are not called for this event. Index
+        // instead of iterating: an addEventListener call may grow the table.
+        size_t count = eventListeners_.listeners(target, type).size();
+        auto thisArg = jsEngine_->newUndefined();
+        std::vector<js::JSValueHandle> args = {event};
+        for (size_t i = 0; i < count; i++) {
+            js::JSValueHandle callback = eventListeners_.listeners(target, type)[i].callback;
+            auto result = jsEngine_->call(callback, thisArg, args);
+            jsEngine_->releaseHandle(result);
         }
+        jsEngine_->releaseHandle(thisArg);
     }
 
     // Test function to send a mock pointer event - call this after script evaluation
@@ -19,13 +19,19 @@
  */
 
 #include "mystral/js/engine.h"
+#include "mystral/js/structured_clone.h"
+#include "mystral/debug/trace.h"
 #include <iostream>
 #include <vector>
+#include <algorithm>
 #include <unordered_map>
 #include <string>
 #include <fstream>
 #include <thread>
 #include <chrono>
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 // stb_image for image loading (implementation in stb_impl.cpp)
 #include "stb_image.h"
@@ -38,8 +44,12 @@
 // GLTF/GLB loader
 #include "mystral/gltf/gltf_loader.h"
 
+// Job pool for off-thread image decoding
+#include "mystral/jobs/job_system.h"
+
 // Canvas 2D context (Skia-backed)
 #include "mystral/canvas/canvas2d.h"
+#include "mystral/canvas/offscreen_canvas.h"
 
 // Forward declaration for Canvas2D bindings
 namespace mystral {
@@ -83,7 +93,13 @@ static WGPUDevice g_device = nullptr;
 static WGPUQueue g_queue = nullptr;
 static WGPUSurface g_surface = nullptr;
 static WGPUInstance g_instance = nullptr;
-static js::Engine* g_engine = nullptr;
+// Engine of the calling thread: the main engine, or a worker engine using the
+// worker device proxy (see initWorkerBindings)
+static thread_local js::Engine* g_engine = nullptr;
+// True on worker threads: they encode only, never touch the surface or present
+static thread_local bool g_workerEncoding = false;
+// Set when the device may be used from several threads at once
+static bool g_threadSafeDevice = false;
 
 // Offscreen rendering support (for no-SDL mode)
 static WGPUTexture g_offscreenTexture = nullptr;
@@ -109,14 +125,15 @@ static uint32_t g_screenshotBytesPerRow = 0;
 
 // Global state for render pass (needed for callbacks in lambdas)
 // These need to be declared here so they're visible to all lambdas
-static WGPURenderPassEncoder g_jsRenderPass = nullptr;
-static WGPUComputePassEncoder g_jsComputePass = nullptr;
-static WGPUCommandEncoder g_jsCommandEncoder = nullptr;
+// Per-thread: workers record their own passes concurrently with the main thread
+static thread_local WGPURenderPassEncoder g_jsRenderPass = nullptr;
+static thread_local WGPUComputePassEncoder g_jsComputePass = nullptr;
+static thread_local WGPUCommandEncoder g_jsCommandEncoder = nullptr;
 
 // Per-encoder render pass tracking (fixes issue with multiple encoders)
 // Maps command encoder pointer to its active render pass encoder
-static std::unordered_map<WGPUCommandEncoder, WGPURenderPassEncoder> g_encoderRenderPassMap;
-static std::unordered_map<WGPUCommandEncoder, WGPUComputePassEncoder> g_encoderComputePassMap;
+static thread_local std::unordered_map<WGPUCommandEncoder, WGPURenderPassEncoder> g_encoderRenderPassMap;
+static thread_local std::unordered_map<WGPUCommandEncoder, WGPUComputePassEncoder> g_encoderComputePassMap;
 
 // Track whether the current frame's surface render pass has been ended
 // This prevents presenting the surface before its render commands are submitted
@@ -130,6 +147,9 @@ static std::vector<uint8_t> g_screenshotData;
 
 // Main canvas 2D context (for Canvas 2D to WebGPU compositing)
 static canvas::Canvas2DContext* g_mainCanvas2DContext = nullptr;
+// Set once the main canvas was handed to an OffscreenCanvas; frames come from its triple buffer.
+// Both belong to the running script: resetCanvasControl() clears them on reload.
+static canvas::TransferredCanvas* g_transferredCanvas = nullptr;
 
 // Texture registry for tracking user-created textures
 // Maps texture ID to {texture, format, dimensions, etc.}
@@ -158,6 +178,25 @@ struct BufferInfo {
 static std::unordered_map<uint64_t, BufferInfo> g_bufferRegistry;
 static uint64_t g_nextBufferId = 1;
 
+// Bytes held by user buffers and textures that are neither destroyed nor
+// collected (performance.memory.gpuBytes). Only the main thread changes these:
+// the worker device proxy cannot create buffers or textures, and a worker's
+// copy of a buffer only drops its own reference (registerGpuHandleTypes).
+// Relaxed atomics, so the totals can be sampled from any thread.
+static std::atomic<uint64_t> g_gpuBufferBytes{0};
+static std::atomic<uint64_t> g_gpuTextureBytes{0};
+
+// Render pass draws, compute dispatches and queue submits since resetGpuCounters().
+// Workers record and submit too, so these are atomic.
+static std::atomic<uint64_t> g_drawCalls{0};
+static std::atomic<uint64_t> g_dispatches{0};
+static std::atomic<uint64_t> g_submits{0};
+
+// Draws recorded into each render bundle, counted when a pass executes it.
+// Bundles may be finished on a worker and executed on the main thread.
+static std::mutex g_renderBundleDrawsMutex;
+static std::unordered_map<WGPURenderBundle, uint32_t> g_renderBundleDraws;
+
 // Pipeline registries for getBindGroupLayout support
 static std::unordered_map<uint64_t, WGPUComputePipeline> g_computePipelineRegistry;
 static uint64_t g_nextComputePipelineId = 1;
@@ -220,6 +259,59 @@ static const char* formatToString(WGPUTextureFormat format) {
     }
 }
 
+/**
+ * Bytes per texel of the formats stringToFormat() accepts
+ */
+static uint32_t formatBytesPerTexel(WGPUTextureFormat format) {
+    switch (format) {
+        case WGPUTextureFormat_R8Unorm: return 1;
+        case WGPUTextureFormat_RG8Unorm:
+        case WGPUTextureFormat_R16Float: return 2;
+        case WGPUTextureFormat_RGBA16Float:
+        case WGPUTextureFormat_RG32Float:
+        case WGPUTextureFormat_Depth24PlusStencil8: return 8;
+        case WGPUTextureFormat_RGBA32Float: return 16;
+        default: return 4;
+    }
+}
+
+/**
+ * Estimated allocation size of a texture: every mip level of every layer
+ */
+static uint64_t textureBytes(WGPUTextureFormat format, uint32_t width, uint32_t height, uint32_t depthOrArrayLayers,
+                             uint32_t mipLevelCount, uint32_t sampleCount, WGPUTextureDimension dimension) {
+    uint64_t bytes = 0;
+    for (uint32_t level = 0; level < mipLevelCount; level++) {
+        uint64_t w = std::max<uint32_t>(1, width >> level);
+        uint64_t h = std::max<uint32_t>(1, height >> level);
+        uint64_t d = dimension == WGPUTextureDimension_3D ? std::max<uint32_t>(1, depthOrArrayLayers >> level) : depthOrArrayLayers;
+        bytes += w * h * d;
+    }
+    return bytes * formatBytesPerTexel(format) * std::max<uint32_t>(1, sampleCount);
+}
+
+/**
+ * Bytes held by user-created buffers and textures not yet destroyed or collected
+ */
+uint64_t gpuMemoryBytes() {
+    return g_gpuBufferBytes.load(std::memory_order_relaxed) + g_gpuTextureBytes.load(std::memory_order_relaxed);
+}
+
+/**
+ * WebGPU call counts since the last resetGpuCounters()
+ */
+void getGpuCounters(uint64_t& drawCalls, uint64_t& dispatches, uint64_t& submits) {
+    drawCalls = g_drawCalls.load(std::memory_order_relaxed);
+    dispatches = g_dispatches.load(std::memory_order_relaxed);
+    submits = g_submits.load(std::memory_order_relaxed);
+}
+
+void resetGpuCounters() {
+    g_drawCalls.store(0, std::memory_order_relaxed);
+    g_dispatches.store(0, std::memory_order_relaxed);
+    g_submits.store(0, std::memory_order_relaxed);
+}
+
 /**
  * Parse texture format string to enum
  */
@@ -341,2770 +433,3132 @@ static WGPUTexture getCurrentSwapchainTexture() {
 }
 
 /**
- * Initialize WebGPU bindings in the JS engine
+ * Decode PNG/JPEG (stb_image) or WebP (libwebp) bytes to RGBA8
+ * Thread-safe; runs on job pool threads for __decodeImageDataAsync.
+ * @return Store owning the pixels, or nullptr with error set
  */
-bool initBindings(js::Engine* engine, void* wgpuInstance, void* wgpuDevice, void* wgpuQueue, void* wgpuSurface, uint32_t surfaceFormat, uint32_t width, uint32_t height, bool debug) {
-    if (!engine) {
-        std::cerr << "[WebGPU] No JS engine provided for bindings" << std::endl;
-        return false;
+static std::shared_ptr<js::BackingStore> decodeImageBytes(const unsigned char* inputBytes, size_t inputSize,
+                                                          int& width, int& height, std::string& error) {
+    width = 0;
+    height = 0;
+
+    // Check if this is a WebP image (starts with "RIFF" and has "WEBP" at offset 8)
+    bool isWebP = inputSize >= 12 &&
+        inputBytes[0] == 'R' && inputBytes[1] == 'I' &&
+        inputBytes[2] == 'F' && inputBytes[3] == 'F' &&
+        inputBytes[8] == 'W' && inputBytes[9] == 'E' &&
+        inputBytes[10] == 'B' && inputBytes[11] == 'P';
+
+    auto store = std::make_shared<js::BackingStore>();
+    if (isWebP) {
+#ifdef MYSTRAL_HAS_WEBP
+        // Decode WebP using libwebp
+        store->data = WebPDecodeRGBA(inputBytes, inputSize, &width, &height);
+        if (!store->data) {
+            error = "Failed to decode WebP image";
+            return nullptr;
+        }
+        store->release = [](void* data) { WebPFree(data); };
+        if (g_verboseLogging) std::cout << "[createImageBitmap] Decoded WebP " << width << "x" << height << " image" << std::endl;
+#else
+        error = "WebP image detected but libwebp support not compiled in. Rebuild with MYSTRAL_HAS_WEBP.";
+        return nullptr;
+#endif
+    } else {
+        // Decode using stb_image (PNG, JPEG, etc.)
+        int channels;
+        store->data = stbi_load_from_memory(inputBytes, (int)inputSize, &width, &height, &channels, 4);
+        if (!store->data) {
+            error = std::string("Failed to decode image: ") + stbi_failure_reason();
+            return nullptr;
+        }
+        store->release = [](void* data) { stbi_image_free(data); };
+        if (g_verboseLogging) std::cout << "[createImageBitmap] Decoded " << width << "x" << height << " image" << std::endl;
     }
 
-#if defined(MYSTRAL_WEBGPU_WGPU) || defined(MYSTRAL_WEBGPU_DAWN)
-    // Set verbose logging based on debug flag
-    g_verboseLogging = debug;
+    store->length = static_cast<size_t>(width) * height * 4;
+    return store;
+}
 
-    g_engine = engine;
-    g_instance = (WGPUInstance)wgpuInstance;
-    g_device = (WGPUDevice)wgpuDevice;
-    g_queue = (WGPUQueue)wgpuQueue;
-    g_surface = (WGPUSurface)wgpuSurface;
+/**
+ * Wrap decoded pixels in the { width, height, _data, _closed } object createImageBitmap expects
+ */
+static js::JSValueHandle makeDecodedImage(int width, int height, std::shared_ptr<js::BackingStore> pixels) {
+    auto result = g_engine->newObject();
+    g_engine->setProperty(result, "width", g_engine->newNumber(width));
+    g_engine->setProperty(result, "height", g_engine->newNumber(height));
+    g_engine->setProperty(result, "_data", g_engine->newArrayBufferFromStore(std::move(pixels)));  // Internal pixel data
+    g_engine->setProperty(result, "_closed", g_engine->newBoolean(false));
+    return result;
+}
 
-    // Set canvas dimensions from window size
-    g_canvasWidth = width;
-    g_canvasHeight = height;
-    g_surfaceFormat = (WGPUTextureFormat)surfaceFormat;
+// device.createCommandEncoder(descriptor?)
+// Shared by the main-thread device and the worker device proxy; g_engine is the calling thread's engine
+static js::JSValueHandle createCommandEncoder(void* ctx, const std::vector<js::JSValueHandle>& args) {
+    WGPUCommandEncoderDescriptor desc = {};
+    WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(g_device, &desc);
 
-    if (g_verboseLogging) {
-        std::cout << "[WebGPU] Initializing JavaScript bindings..." << std::endl;
-        std::cout << "[WebGPU] Surface format: " << surfaceFormat << std::endl;
-    }
+    // Store in global for use by beginRenderPass
+    // Note: Multiple encoders are supported via per-encoder render pass tracking
+    g_jsCommandEncoder = encoder;
 
-    // ========================================================================
-    // Create a mock parent element for the canvas (needed by Debugger)
-    // ========================================================================
-    auto parentElement = engine->newObject();
-    engine->setProperty(parentElement, "style", engine->newObject());
-    engine->setProperty(parentElement, "appendChild",
-        engine->newFunction("appendChild", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-            // No-op in native runtime
-            return args.empty() ? g_engine->newUndefined() : args[0];
-        })
-    );
-    engine->setProperty(parentElement, "removeChild",
-        engine->newFunction("removeChild", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-            return args.empty() ? g_engine->newUndefined() : args[0];
-        })
-    );
+    // Suspend frame tracking while creating encoder wrapper
+    // This prevents the wrapper's methods from being garbage collected at frame end
+    g_engine->suspendFrameTracking();
 
-    // ========================================================================
-    // Get existing canvas from runtime.cpp's document.getElementById
-    // The canvas was created by setupDOMEvents() with addEventListener, style, etc.
-    // We just need to add WebGPU-specific methods (getContext) to it.
-    // ========================================================================
-    auto existingDocument = engine->getGlobalProperty("document");
-    auto getElementByIdFunc = engine->getProperty(existingDocument, "getElementById");
+    auto jsEncoder = g_engine->newObject();
+    g_engine->setPrivateData(jsEncoder, encoder);
 
-    // Call document.getElementById('canvas') to get the existing canvas
-    std::vector<js::JSValueHandle> args;
-    args.push_back(engine->newString("canvas"));
-    auto canvasObject = engine->call(getElementByIdFunc, existingDocument, args);
+    // Capture encoder pointer for use in closures
+    WGPUCommandEncoder capturedEncoder = encoder;
 
-    if (engine->isNull(canvasObject) || engine->isUndefined(canvasObject)) {
-        std::cerr << "[WebGPU] Warning: No existing canvas found, creating new one" << std::endl;
-        canvasObject = engine->newObject();
-        engine->setProperty(canvasObject, "width", engine->newNumber(g_canvasWidth));
-        engine->setProperty(canvasObject, "height", engine->newNumber(g_canvasHeight));
-        engine->setProperty(canvasObject, "clientWidth", engine->newNumber(g_canvasWidth));
-        engine->setProperty(canvasObject, "clientHeight", engine->newNumber(g_canvasHeight));
-    }
+    // encoder.beginRenderPass(descriptor)
+    g_engine->setProperty(jsEncoder, "beginRenderPass",
+        g_engine->newFunction("beginRenderPass", [capturedEncoder](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (args.empty()) {
+                g_engine->throwException("beginRenderPass requires a descriptor");
+                return g_engine->newUndefined();
+            }
 
-    // Update canvas dimensions (in case they differ)
-    engine->setProperty(canvasObject, "width", engine->newNumber(g_canvasWidth));
-    engine->setProperty(canvasObject, "height", engine->newNumber(g_canvasHeight));
-    engine->setProperty(canvasObject, "clientWidth", engine->newNumber(g_canvasWidth));
-    engine->setProperty(canvasObject, "clientHeight", engine->newNumber(g_canvasHeight));
+            // Use the captured encoder for this specific command encoder
+            WGPUCommandEncoder encoderToUse = capturedEncoder;
+            if (!encoderToUse) {
+                g_engine->throwException("Command encoder not available");
+                return g_engine->newUndefined();
+            }
 
-    // canvas.parentElement - mock parent element (for Debugger compatibility)
-    engine->setProperty(canvasObject, "parentElement", parentElement);
+            auto descriptor = args[0];
+            auto colorAttachments = g_engine->getProperty(descriptor, "colorAttachments");
+
+            // Parse all color attachments (deferred renderer uses multiple)
+            auto attachmentsLengthProp = g_engine->getProperty(colorAttachments, "length");
+            int numAttachments = g_engine->isUndefined(attachmentsLengthProp) ? 0 : (int)g_engine->toNumber(attachmentsLengthProp);
+            std::vector<WGPURenderPassColorAttachment> colorAttachmentList;
+            colorAttachmentList.reserve(numAttachments);
+
+            double firstR = 0, firstG = 0, firstB = 0, firstA = 1;
+
+            for (int i = 0; i < numAttachments; i++) {
+                auto attachment = g_engine->getPropertyIndex(colorAttachments, i);
+                auto viewHandle = g_engine->getProperty(attachment, "view");
+                WGPUTextureView view = (WGPUTextureView)g_engine->getPrivateData(viewHandle);
+
+                // Debug: Log first color attachment for comparison with g_currentTextureView
+                // (workers never render to the surface, so they skip the tracking)
+                if (i == 0 && !g_workerEncoding) {
+                    if (g_verboseLogging) {
+                        std::cout << "[WebGPU] Render pass attachment[0]: view=" << (void*)view
+                                  << ", g_currentTextureView=" << (void*)g_currentTextureView
+                                  << ", matches=" << (view == g_currentTextureView ? "YES" : "NO") << std::endl;
+                    }
 
-    // canvas.getContext('webgpu') -> GPUCanvasContext
-    // This is the WebGPU-specific method we add to the existing canvas
-    engine->setProperty(canvasObject, "getContext",
-        engine->newFunction("getContext", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-            if (args.empty()) {
-                return g_engine->newNull();
-            }
+                    // Track if this render pass uses the surface texture
+                    if (view == g_currentTextureView && g_currentTextureView != nullptr) {
+                        g_surfaceRenderEncoder = encoderToUse;
+                        g_surfaceRenderPassEnded = false;
+                    }
+                }
 
-            std::string contextType = g_engine->toString(args[0]);
+                // Debug: Log GBuffer pass attachments
+                if (numAttachments >= 5 && i == 0) {
+                    if (g_verboseLogging) std::cout << "[WebGPU] GBuffer pass - 5 attachments, view[0]=" << (void*)view << std::endl;
+                }
+                if (!view && numAttachments >= 5) {
+                    std::cerr << "[WebGPU] ERROR: GBuffer attachment " << i << " has null view!" << std::endl;
+                }
 
-            // Handle Canvas 2D context
-            if (contextType == "2d") {
-                if (g_verboseLogging) std::cout << "[Canvas] Creating 2D context (" << g_canvasWidth << "x" << g_canvasHeight << ")" << std::endl;
-                auto ctx2d = canvas::createCanvas2DContext(g_engine, g_canvasWidth, g_canvasHeight);
+                // Parse loadOp (default 'clear')
+                WGPULoadOp loadOp = WGPULoadOp_Clear;
+                auto loadOpProp = g_engine->getProperty(attachment, "loadOp");
+                if (!g_engine->isUndefined(loadOpProp)) {
+                    std::string loadOpStr = g_engine->toString(loadOpProp);
+                    if (loadOpStr == "load") loadOp = WGPULoadOp_Load;
+                }
 
-                // Set reference back to canvas
-                auto canvas = g_engine->getGlobalProperty("canvas");
-                g_engine->setProperty(ctx2d, "canvas", canvas);
+                // Parse storeOp (default 'store')
+                WGPUStoreOp storeOp = WGPUStoreOp_Store;
+                auto storeOpProp = g_engine->getProperty(attachment, "storeOp");
+                if (!g_engine->isUndefined(storeOpProp)) {
+                    std::string storeOpStr = g_engine->toString(storeOpProp);
+                    if (storeOpStr == "discard") storeOp = WGPUStoreOp_Discard;
+                }
 
-                // Store the native context for Canvas 2D to WebGPU compositing
-                g_mainCanvas2DContext = static_cast<canvas::Canvas2DContext*>(g_engine->getPrivateData(ctx2d));
-                if (g_verboseLogging) std::cout << "[Canvas] Main canvas using 2D context - will composite to WebGPU" << std::endl;
+                // Parse clearValue only if loadOp is 'clear'
+                double r = 0, g = 0, b = 0, a = 1;
+                if (loadOp == WGPULoadOp_Clear) {
+                    auto clearValue = g_engine->getProperty(attachment, "clearValue");
+                    if (!g_engine->isUndefined(clearValue)) {
+                        // Check if it's an array [r, g, b, a] or object {r, g, b, a}
+                        if (g_engine->isArray(clearValue)) {
+                            r = g_engine->toNumber(g_engine->getPropertyIndex(clearValue, 0));
+                            g = g_engine->toNumber(g_engine->getPropertyIndex(clearValue, 1));
+                            b = g_engine->toNumber(g_engine->getPropertyIndex(clearValue, 2));
+                            a = g_engine->toNumber(g_engine->getPropertyIndex(clearValue, 3));
+                        } else {
+                            r = g_engine->toNumber(g_engine->getProperty(clearValue, "r"));
+                            g = g_engine->toNumber(g_engine->getProperty(clearValue, "g"));
+                            b = g_engine->toNumber(g_engine->getProperty(clearValue, "b"));
+                            a = g_engine->toNumber(g_engine->getProperty(clearValue, "a"));
+                        }
+                    }
+                }
 
-                return ctx2d;
+                if (i == 0) {
+                    firstR = r; firstG = g; firstB = b; firstA = a;
+                }
+
+                WGPURenderPassColorAttachment colorAttachment = {};
+                colorAttachment.view = view;
+                colorAttachment.loadOp = loadOp;
+                colorAttachment.storeOp = storeOp;
+                colorAttachment.clearValue = {r, g, b, a};
+                colorAttachment.depthSlice = WGPU_DEPTH_SLICE_UNDEFINED;
+                colorAttachmentList.push_back(colorAttachment);
             }
 
-            if (contextType != "webgpu") {
-                std::cerr << "[Canvas] Unknown context type: " << contextType << std::endl;
-                return g_engine->newNull();
+            WGPURenderPassDescriptor renderPassDesc = {};
+            renderPassDesc.colorAttachmentCount = colorAttachmentList.size();
+            renderPassDesc.colorAttachments = colorAttachmentList.data();
+
+            // Parse depth stencil attachment if present
+            WGPURenderPassDepthStencilAttachment depthStencilAttachment = {};
+            auto depthStencilProp = g_engine->getProperty(descriptor, "depthStencilAttachment");
+            if (!g_engine->isUndefined(depthStencilProp)) {
+                auto depthViewHandle = g_engine->getProperty(depthStencilProp, "view");
+                WGPUTextureView depthView = (WGPUTextureView)g_engine->getPrivateData(depthViewHandle);
+                depthStencilAttachment.view = depthView;
+
+                // Depth clear value (default 1.0)
+                auto depthClearValueProp = g_engine->getProperty(depthStencilProp, "depthClearValue");
+                depthStencilAttachment.depthClearValue = g_engine->isUndefined(depthClearValueProp)
+                    ? 1.0f : (float)g_engine->toNumber(depthClearValueProp);
+
+                // Depth load/store ops (default clear/store)
+                auto depthLoadOpProp = g_engine->getProperty(depthStencilProp, "depthLoadOp");
+                if (!g_engine->isUndefined(depthLoadOpProp)) {
+                    std::string loadOpStr = g_engine->toString(depthLoadOpProp);
+                    if (loadOpStr == "load") depthStencilAttachment.depthLoadOp = WGPULoadOp_Load;
+                    else depthStencilAttachment.depthLoadOp = WGPULoadOp_Clear;
+                } else {
+                    depthStencilAttachment.depthLoadOp = WGPULoadOp_Clear;
+                }
+
+                auto depthStoreOpProp = g_engine->getProperty(depthStencilProp, "depthStoreOp");
+                if (!g_engine->isUndefined(depthStoreOpProp)) {
+                    std::string storeOpStr = g_engine->toString(depthStoreOpProp);
+                    if (storeOpStr == "discard") depthStencilAttachment.depthStoreOp = WGPUStoreOp_Discard;
+                    else depthStencilAttachment.depthStoreOp = WGPUStoreOp_Store;
+                } else {
+                    depthStencilAttachment.depthStoreOp = WGPUStoreOp_Store;
+                }
+
+                // Stencil ops (default undefined/disabled)
+                depthStencilAttachment.stencilClearValue = 0;
+                depthStencilAttachment.stencilLoadOp = WGPULoadOp_Undefined;
+                depthStencilAttachment.stencilStoreOp = WGPUStoreOp_Undefined;
+
+                renderPassDesc.depthStencilAttachment = &depthStencilAttachment;
+                if (g_verboseLogging) std::cout << "[WebGPU] Render pass with depth attachment, clear=" << depthStencilAttachment.depthClearValue << std::endl;
             }
 
-            // Create GPUCanvasContext
-            auto canvasContext = g_engine->newObject();
+            // Begin render pass on the captured encoder (not the global)
+            WGPURenderPassEncoder renderPass = wgpuCommandEncoderBeginRenderPass(encoderToUse, &renderPassDesc);
 
-            // Store reference to our surface
-            g_engine->setPrivateData(canvasContext, g_surface);
+            // Store in per-encoder map (fixes issue with multiple encoders)
+            g_encoderRenderPassMap[encoderToUse] = renderPass;
 
-            // context.canvas - reference back to canvas
-            auto canvas = g_engine->getGlobalProperty("canvas");
-            g_engine->setProperty(canvasContext, "canvas", canvas);
+            // Also set global for backwards compatibility with render pass methods
+            g_jsRenderPass = renderPass;
 
-            // context.configure({ device, format, alphaMode })
-            g_engine->setProperty(canvasContext, "configure",
-                g_engine->newFunction("configure", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                    if (args.empty()) {
-                        g_engine->throwException("configure requires a descriptor");
-                        return g_engine->newUndefined();
-                    }
+            if (g_verboseLogging) std::cout << "[WebGPU] Render pass started (" << numAttachments << " attachments), clear: (" << firstR << "," << firstG << "," << firstB << "," << firstA << ")" << std::endl;
 
-                    auto descriptor = args[0];
+            // Suspend frame tracking while creating render pass wrapper
+            g_engine->suspendFrameTracking();
 
-                    // Get format
-                    std::string format = g_engine->toString(g_engine->getProperty(descriptor, "format"));
-                    g_surfaceFormat = stringToFormat(format);
-                    // Note: alphaMode and device are stored but surface is already configured
+            auto jsRenderPass = g_engine->newObject();
+            g_engine->setPrivateData(jsRenderPass, renderPass);
 
-                    g_contextConfigured = true;
-                    if (g_verboseLogging) std::cout << "[Canvas] Context configured with format: " << format << std::endl;
+            // renderPass.setPipeline(pipeline)
+            g_engine->setProperty(jsRenderPass, "setPipeline",
+                g_engine->newFunction("setPipeline", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    if (args.empty()) return g_engine->newUndefined();
 
-                    return g_engine->newUndefined();
-                })
-            );
+                    WGPURenderPipeline pipeline = (WGPURenderPipeline)g_engine->getPrivateData(args[0]);
+                    if (g_jsRenderPass && pipeline) {
+                        wgpuRenderPassEncoderSetPipeline(g_jsRenderPass, pipeline);
+                        if (g_verboseLogging) std::cout << "[WebGPU] Pipeline set" << std::endl;
+                    }
 
-            // context.unconfigure()
-            g_engine->setProperty(canvasContext, "unconfigure",
-                g_engine->newFunction("unconfigure", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                    g_contextConfigured = false;
                     return g_engine->newUndefined();
                 })
             );
 
-            // context.getCurrentTexture() -> GPUTexture
-            g_engine->setProperty(canvasContext, "getCurrentTexture",
-                g_engine->newFunction("getCurrentTexture", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                    // Get current swapchain texture
-                    WGPUTexture texture = getCurrentSwapchainTexture();
-                    if (!texture) {
-                        g_engine->throwException("Failed to get current texture");
+            // renderPass.setBindGroup(index, bindGroup, dynamicOffsets?)
+            g_engine->setProperty(jsRenderPass, "setBindGroup",
+                g_engine->newFunction("setBindGroup", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    if (args.size() < 2) {
+                        g_engine->throwException("setBindGroup requires index and bindGroup");
                         return g_engine->newUndefined();
                     }
 
-                    g_currentTexture = texture;
-                    static int frameCount = 0;
-                    if (frameCount++ < 3) {
-                        if (g_verboseLogging) std::cout << "[Canvas] Got texture: " << texture << std::endl;
+                    uint32_t groupIndex = (uint32_t)g_engine->toNumber(args[0]);
+                    WGPUBindGroup bindGroup = (WGPUBindGroup)g_engine->getPrivateData(args[1]);
+
+                    if (g_jsRenderPass && bindGroup) {
+                        // TODO: Support dynamic offsets
+                        wgpuRenderPassEncoderSetBindGroup(g_jsRenderPass, groupIndex, bindGroup, 0, nullptr);
+                        if (g_verboseLogging) std::cout << "[WebGPU] Set bind group at index " << groupIndex << std::endl;
                     }
 
-                    // Register in texture registry so createView can find it
-                    uint64_t textureId = g_nextTextureId++;
-                    g_textureRegistry[textureId] = {texture, g_surfaceFormat, g_canvasWidth, g_canvasHeight, 1, 1, WGPUTextureDimension_2D};
+                    return g_engine->newUndefined();
+                })
+            );
 
-                    // Create JS wrapper for texture
-                    auto jsTexture = g_engine->newObject();
-                    g_engine->setPrivateData(jsTexture, texture);
+            // renderPass.draw(vertexCount, instanceCount?, firstVertex?, firstInstance?)
+            g_engine->setProperty(jsRenderPass, "draw",
+                g_engine->newFunction("draw", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    if (args.empty()) return g_engine->newUndefined();
 
-                    // texture.width / height / depthOrArrayLayers
-                    g_engine->setProperty(jsTexture, "width", g_engine->newNumber(g_canvasWidth));
-                    g_engine->setProperty(jsTexture, "height", g_engine->newNumber(g_canvasHeight));
-                    g_engine->setProperty(jsTexture, "depthOrArrayLayers", g_engine->newNumber(1));
+                    uint32_t vertexCount = (uint32_t)g_engine->toNumber(args[0]);
+                    uint32_t instanceCount = args.size() > 1 ? (uint32_t)g_engine->toNumber(args[1]) : 1;
+                    uint32_t firstVertex = args.size() > 2 ? (uint32_t)g_engine->toNumber(args[2]) : 0;
+                    uint32_t firstInstance = args.size() > 3 ? (uint32_t)g_engine->toNumber(args[3]) : 0;
 
-                    // texture.format
-                    g_engine->setProperty(jsTexture, "format", g_engine->newString(formatToString(g_surfaceFormat)));
-                    g_engine->setProperty(jsTexture, "_textureId", g_engine->newNumber((double)textureId));
+                    if (g_jsRenderPass) {
+                        wgpuRenderPassEncoderDraw(g_jsRenderPass, vertexCount, instanceCount, firstVertex, firstInstance);
+                        g_drawCalls.fetch_add(1, std::memory_order_relaxed);
+                        if (g_verboseLogging) std::cout << "[WebGPU] Draw: " << vertexCount << " vertices" << std::endl;
+                    }
 
-                    // texture.createView(descriptor?) -> GPUTextureView
-                    // Capture textureId to look up the correct texture (not g_currentTexture which may change)
-                    g_engine->setProperty(jsTexture, "createView",
-                        g_engine->newFunction("createView", [textureId](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                            // Look up texture from registry using captured textureId
-                            auto it = g_textureRegistry.find(textureId);
-                            if (it == g_textureRegistry.end()) {
-                                std::cerr << "[WebGPU] Canvas createView: Texture " << textureId << " not found in registry" << std::endl;
-                                g_engine->throwException("Texture not found in registry");
-                                return g_engine->newUndefined();
-                            }
+                    return g_engine->newUndefined();
+                })
+            );
 
-                            WGPUTexture texture = it->second.texture;
-                            if (!texture) {
-                                g_engine->throwException("No current texture");
-                                return g_engine->newUndefined();
-                            }
+            // renderPass.setVertexBuffer(slot, buffer, offset?, size?)
+            g_engine->setProperty(jsRenderPass, "setVertexBuffer",
+                g_engine->newFunction("setVertexBuffer", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    if (args.size() < 2) return g_engine->newUndefined();
 
-                            // Create texture view
-                            WGPUTextureViewDescriptor viewDesc = {};
-                            viewDesc.format = it->second.format;
-                            viewDesc.dimension = WGPUTextureViewDimension_2D;
-                            viewDesc.baseMipLevel = 0;
-                            viewDesc.mipLevelCount = 1;
-                            viewDesc.baseArrayLayer = 0;
-                            viewDesc.arrayLayerCount = 1;
-                            viewDesc.aspect = WGPUTextureAspect_All;
+                    uint32_t slot = (uint32_t)g_engine->toNumber(args[0]);
+                    WGPUBuffer buffer = (WGPUBuffer)g_engine->getPrivateData(args[1]);
+                    uint64_t offset = args.size() > 2 ? (uint64_t)g_engine->toNumber(args[2]) : 0;
+                    uint64_t size = args.size() > 3 ? (uint64_t)g_engine->toNumber(args[3]) : WGPU_WHOLE_SIZE;
 
-                            WGPUTextureView view = wgpuTextureCreateView(texture, &viewDesc);
+                    if (g_jsRenderPass && buffer) {
+                        wgpuRenderPassEncoderSetVertexBuffer(g_jsRenderPass, slot, buffer, offset, size);
+                        if (g_verboseLogging) std::cout << "[WebGPU] Set vertex buffer at slot " << slot << std::endl;
+                    }
 
-                            g_currentTextureView = view;
-                            g_currentViewSourceTexture = texture;  // Track which texture the view was created from
+                    return g_engine->newUndefined();
+                })
+            );
 
-                            // Create JS wrapper
-                            auto jsView = g_engine->newObject();
-                            g_engine->setPrivateData(jsView, view);
-                            g_engine->setProperty(jsView, "_type", g_engine->newString("textureView"));
+            // renderPass.setIndexBuffer(buffer, format, offset?, size?)
+            g_engine->setProperty(jsRenderPass, "setIndexBuffer",
+                g_engine->newFunction("setIndexBuffer", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    if (args.size() < 2) return g_engine->newUndefined();
 
-                            return jsView;
-                        })
-                    );
+                    WGPUBuffer buffer = (WGPUBuffer)g_engine->getPrivateData(args[0]);
+                    std::string formatStr = g_engine->toString(args[1]);
+                    uint64_t offset = args.size() > 2 ? (uint64_t)g_engine->toNumber(args[2]) : 0;
+                    uint64_t size = args.size() > 3 ? (uint64_t)g_engine->toNumber(args[3]) : WGPU_WHOLE_SIZE;
 
-                    // texture.destroy()
-                    g_engine->setProperty(jsTexture, "destroy",
-                        g_engine->newFunction("destroy", [textureId](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                            // Swapchain textures are managed by the surface, but remove from registry
-                            g_textureRegistry.erase(textureId);
-                            return g_engine->newUndefined();
-                        })
-                    );
+                    WGPUIndexFormat format = WGPUIndexFormat_Uint16;
+                    if (formatStr == "uint32") format = WGPUIndexFormat_Uint32;
+                    else if (formatStr == "uint16") format = WGPUIndexFormat_Uint16;
 
-                    return jsTexture;
+                    if (g_jsRenderPass && buffer) {
+                        wgpuRenderPassEncoderSetIndexBuffer(g_jsRenderPass, buffer, format, offset, size);
+                        if (g_verboseLogging) std::cout << "[WebGPU] Set index buffer, format: " << formatStr << std::endl;
+                    }
+
+                    return g_engine->newUndefined();
                 })
             );
 
-            if (g_verboseLogging) std::cout << "[Canvas] WebGPU context created" << std::endl;
-            return canvasContext;
-        })
-    );
-
-    // Set global canvas - this is the SAME object as document.getElementById('canvas')
-    // so it now has both WebGPU getContext AND event listener support
-    engine->setGlobalProperty("canvas", canvasObject);
+            // renderPass.drawIndexed(indexCount, instanceCount?, firstIndex?, baseVertex?, firstInstance?)
+            g_engine->setProperty(jsRenderPass, "drawIndexed",
+                g_engine->newFunction("drawIndexed", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    if (args.empty()) return g_engine->newUndefined();
+
+                    uint32_t indexCount = (uint32_t)g_engine->toNumber(args[0]);
+                    uint32_t instanceCount = args.size() > 1 ? (uint32_t)g_engine->toNumber(args[1]) : 1;
+                    uint32_t firstIndex = args.size() > 2 ? (uint32_t)g_engine->toNumber(args[2]) : 0;
+                    int32_t baseVertex = args.size() > 3 ? (int32_t)g_engine->toNumber(args[3]) : 0;
+                    uint32_t firstInstance = args.size() > 4 ? (uint32_t)g_engine->toNumber(args[4]) : 0;
+
+                    if (g_jsRenderPass) {
+                        wgpuRenderPassEncoderDrawIndexed(g_jsRenderPass, indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
+                        g_drawCalls.fetch_add(1, std::memory_order_relaxed);
+                        if (g_verboseLogging) std::cout << "[WebGPU] DrawIndexed: " << indexCount << " indices, firstInstance=" << firstInstance << std::endl;
+                    }
 
-    // ========================================================================
-    // Add missing methods to the existing document (from runtime.cpp)
-    // We DON'T create a new document - just augment the existing one
-    // ========================================================================
+                    return g_engine->newUndefined();
+                })
+            );
 
-    // Add querySelector to existing document (if not present)
-    engine->setProperty(existingDocument, "querySelector",
-        engine->newFunction("querySelector", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-            // Check if querying for canvas
-            if (!args.empty()) {
-                std::string selector = g_engine->toString(args[0]);
-                if (selector == "canvas" || selector.find("canvas") != std::string::npos) {
-                    return g_engine->getGlobalProperty("canvas");
-                }
-            }
-            return g_engine->newNull();
-        })
-    );
+            // renderPass.drawIndirect(indirectBuffer, indirectOffset)
+            g_engine->setProperty(jsRenderPass, "drawIndirect",
+                g_engine->newFunction("drawIndirect", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    if (args.size() < 2) return g_engine->newUndefined();
 
-    // Add createElement to existing document
-    // NOTE: runtime.cpp sets up a createElement with canvas support (toDataURL) for @loaders.gl WebP detection
-    // We ALWAYS override it here to add proper Canvas 2D support for offscreen canvases
-    engine->setProperty(existingDocument, "createElement",
-        engine->newFunction("createElement", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-            auto element = g_engine->newObject();
+                    WGPUBuffer indirectBuffer = (WGPUBuffer)g_engine->getPrivateData(args[0]);
+                    uint64_t indirectOffset = (uint64_t)g_engine->toNumber(args[1]);
 
-            // Get tag name if provided
-            std::string tagName = "";
-            if (!args.empty()) {
-                tagName = g_engine->toString(args[0]);
-            }
+                    if (g_jsRenderPass && indirectBuffer) {
+                        wgpuRenderPassEncoderDrawIndirect(g_jsRenderPass, indirectBuffer, indirectOffset);
+                        g_drawCalls.fetch_add(1, std::memory_order_relaxed);
+                        if (g_verboseLogging) std::cout << "[WebGPU] DrawIndirect at offset " << indirectOffset << std::endl;
+                    }
 
-            // Add basic DOM element properties
-            g_engine->setProperty(element, "style", g_engine->newObject());
-            g_engine->setProperty(element, "className", g_engine->newString(""));
-            g_engine->setProperty(element, "innerHTML", g_engine->newString(""));
-            g_engine->setProperty(element, "textContent", g_engine->newString(""));
-            g_engine->setProperty(element, "tagName", g_engine->newString(tagName.c_str()));
-            g_engine->setProperty(element, "appendChild",
-                g_engine->newFunction("appendChild", [](void* c, const std::vector<js::JSValueHandle>& a) {
-                    return a.empty() ? g_engine->newUndefined() : a[0];
-                })
-            );
-            g_engine->setProperty(element, "removeChild",
-                g_engine->newFunction("removeChild", [](void* c, const std::vector<js::JSValueHandle>& a) {
-                    return a.empty() ? g_engine->newUndefined() : a[0];
-                })
-            );
-            g_engine->setProperty(element, "remove",
-                g_engine->newFunction("remove", [](void* c, const std::vector<js::JSValueHandle>& a) {
-                    // No-op in native runtime - element is not attached to DOM
                     return g_engine->newUndefined();
                 })
             );
-            g_engine->setProperty(element, "addEventListener",
-                g_engine->newFunction("addEventListener", [](void* c, const std::vector<js::JSValueHandle>& a) {
-                    // No-op in native runtime
+
+            // renderPass.drawIndexedIndirect(indirectBuffer, indirectOffset)
+            g_engine->setProperty(jsRenderPass, "drawIndexedIndirect",
+                g_engine->newFunction("drawIndexedIndirect", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    if (args.size() < 2) return g_engine->newUndefined();
+
+                    WGPUBuffer indirectBuffer = (WGPUBuffer)g_engine->getPrivateData(args[0]);
+                    uint64_t indirectOffset = (uint64_t)g_engine->toNumber(args[1]);
+
+                    if (g_jsRenderPass && indirectBuffer) {
+                        wgpuRenderPassEncoderDrawIndexedIndirect(g_jsRenderPass, indirectBuffer, indirectOffset);
+                        g_drawCalls.fetch_add(1, std::memory_order_relaxed);
+                        if (g_verboseLogging) std::cout << "[WebGPU] DrawIndexedIndirect at offset " << indirectOffset << std::endl;
+                    }
+
                     return g_engine->newUndefined();
                 })
             );
-            g_engine->setProperty(element, "removeEventListener",
-                g_engine->newFunction("removeEventListener", [](void* c, const std::vector<js::JSValueHandle>& a) {
+
+            // renderPass.setViewport(x, y, width, height, minDepth, maxDepth)
+            g_engine->setProperty(jsRenderPass, "setViewport",
+                g_engine->newFunction("setViewport", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    if (args.size() < 6) return g_engine->newUndefined();
+
+                    float x = (float)g_engine->toNumber(args[0]);
+                    float y = (float)g_engine->toNumber(args[1]);
+                    float width = (float)g_engine->toNumber(args[2]);
+                    float height = (float)g_engine->toNumber(args[3]);
+                    float minDepth = (float)g_engine->toNumber(args[4]);
+                    float maxDepth = (float)g_engine->toNumber(args[5]);
+
+                    if (g_jsRenderPass) {
+                        wgpuRenderPassEncoderSetViewport(g_jsRenderPass, x, y, width, height, minDepth, maxDepth);
+                        if (g_verboseLogging) std::cout << "[WebGPU] SetViewport: " << x << "," << y << " " << width << "x" << height << std::endl;
+                    }
+
                     return g_engine->newUndefined();
                 })
             );
 
-            // Special handling for canvas elements - add Canvas 2D support
-            if (tagName == "canvas" || tagName == "CANVAS") {
-                // Create OffscreenCanvas struct to store state
-                int canvasId = g_nextOffscreenCanvasId++;
-                auto offscreenCanvas = std::make_unique<OffscreenCanvas>();
-                OffscreenCanvas* canvasPtr = offscreenCanvas.get();
-                g_offscreenCanvases[canvasId] = std::move(offscreenCanvas);
+            // renderPass.setScissorRect(x, y, width, height)
+            g_engine->setProperty(jsRenderPass, "setScissorRect",
+                g_engine->newFunction("setScissorRect", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    if (args.size() < 4) return g_engine->newUndefined();
 
-                // Store the canvas ID as private data for getContext lookup
-                g_engine->setPrivateData(element, reinterpret_cast<void*>(static_cast<intptr_t>(canvasId)));
+                    uint32_t x = (uint32_t)g_engine->toNumber(args[0]);
+                    uint32_t y = (uint32_t)g_engine->toNumber(args[1]);
+                    uint32_t width = (uint32_t)g_engine->toNumber(args[2]);
+                    uint32_t height = (uint32_t)g_engine->toNumber(args[3]);
 
-                // Also store as property for debugging
-                g_engine->setProperty(element, "_offscreenCanvasId", g_engine->newNumber(canvasId));
+                    if (g_jsRenderPass) {
+                        wgpuRenderPassEncoderSetScissorRect(g_jsRenderPass, x, y, width, height);
+                        if (g_verboseLogging) std::cout << "[WebGPU] SetScissorRect: " << x << "," << y << " " << width << "x" << height << std::endl;
+                    }
 
-                // Default canvas dimensions (stored in struct)
-                g_engine->setProperty(element, "width", g_engine->newNumber(canvasPtr->width));
-                g_engine->setProperty(element, "height", g_engine->newNumber(canvasPtr->height));
+                    return g_engine->newUndefined();
+                })
+            );
 
-                // Store reference to element globally so getContext can find it
-                std::string globalName = "__offscreenCanvas_" + std::to_string(canvasId);
-                g_engine->setGlobalProperty(globalName.c_str(), element);
+            // renderPass.setBlendConstant(color)
+            g_engine->setProperty(jsRenderPass, "setBlendConstant",
+                g_engine->newFunction("setBlendConstant", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    if (args.empty()) return g_engine->newUndefined();
+
+                    auto color = args[0];
+                    WGPUColor blendColor = {};
+                    if (g_engine->isArray(color)) {
+                        blendColor.r = g_engine->toNumber(g_engine->getPropertyIndex(color, 0));
+                        blendColor.g = g_engine->toNumber(g_engine->getPropertyIndex(color, 1));
+                        blendColor.b = g_engine->toNumber(g_engine->getPropertyIndex(color, 2));
+                        blendColor.a = g_engine->toNumber(g_engine->getPropertyIndex(color, 3));
+                    } else {
+                        blendColor.r = g_engine->toNumber(g_engine->getProperty(color, "r"));
+                        blendColor.g = g_engine->toNumber(g_engine->getProperty(color, "g"));
+                        blendColor.b = g_engine->toNumber(g_engine->getProperty(color, "b"));
+                        blendColor.a = g_engine->toNumber(g_engine->getProperty(color, "a"));
+                    }
 
-                // Create getContext function
-                // Capture canvasId to ensure each canvas element's getContext uses its own canvas
-                // This fixes the bug where all canvases shared the same context
-                auto getContextFn = g_engine->newFunction("getContext", [canvasId, canvasPtr](void* c, const std::vector<js::JSValueHandle>& contextArgs) {
-                    if (contextArgs.empty()) {
-                        return g_engine->newNull();
+                    if (g_jsRenderPass) {
+                        wgpuRenderPassEncoderSetBlendConstant(g_jsRenderPass, &blendColor);
                     }
 
-                    std::string contextType = g_engine->toString(contextArgs[0]);
+                    return g_engine->newUndefined();
+                })
+            );
 
-                    // Use the captured canvasId to find the correct canvas
-                    // This ensures each canvas element's getContext returns its own context
-                    auto it = g_offscreenCanvases.find(canvasId);
-                    if (it == g_offscreenCanvases.end()) {
-                        std::cerr << "[Canvas] Canvas not found: " << canvasId << std::endl;
-                        return g_engine->newNull();
+            // renderPass.setStencilReference(reference)
+            g_engine->setProperty(jsRenderPass, "setStencilReference",
+                g_engine->newFunction("setStencilReference", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    if (args.empty()) return g_engine->newUndefined();
+
+                    uint32_t reference = (uint32_t)g_engine->toNumber(args[0]);
+                    if (g_jsRenderPass) {
+                        wgpuRenderPassEncoderSetStencilReference(g_jsRenderPass, reference);
                     }
 
-                    OffscreenCanvas* canvas = it->second.get();
+                    return g_engine->newUndefined();
+                })
+            );
 
-                    if (contextType == "2d") {
-                        // Return cached context if already created
-                        if (canvas->hasContext2d) {
-                            return canvas->context2d;
+            // renderPass.executeBundles(bundles)
+            // Used by Three.js for mipmap generation
+            WGPURenderPassEncoder capturedRenderPassForBundles = renderPass;
+            g_engine->setProperty(jsRenderPass, "executeBundles",
+                g_engine->newFunction("executeBundles", [capturedRenderPassForBundles](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    if (args.empty() || !capturedRenderPassForBundles) return g_engine->newUndefined();
+
+                    auto bundlesArray = args[0];
+                    auto lengthProp = g_engine->getProperty(bundlesArray, "length");
+                    int bundleCount = g_engine->isUndefined(lengthProp) ? 0 : (int)g_engine->toNumber(lengthProp);
+
+                    std::vector<WGPURenderBundle> bundles;
+                    bundles.reserve(bundleCount);
+                    for (int i = 0; i < bundleCount; i++) {
+                        auto bundleHandle = g_engine->getPropertyIndex(bundlesArray, i);
+                        WGPURenderBundle bundle = (WGPURenderBundle)g_engine->getPrivateData(bundleHandle);
+                        if (bundle) {
+                            bundles.push_back(bundle);
+                        } else if (g_engine->isObject(bundleHandle)) {
+                            // Emptied when posted to another thread
+                            g_engine->throwException("executeBundles: render bundle was transferred");
+                            return g_engine->newUndefined();
                         }
+                    }
 
-                        // Get current dimensions from the canvas element (in case they were changed)
-                        std::string globalName = "__offscreenCanvas_" + std::to_string(canvasId);
-                        auto canvasElement = g_engine->getGlobalProperty(globalName.c_str());
-                        if (!g_engine->isNull(canvasElement) && !g_engine->isUndefined(canvasElement)) {
-                            auto widthProp = g_engine->getProperty(canvasElement, "width");
-                            auto heightProp = g_engine->getProperty(canvasElement, "height");
-                            if (!g_engine->isUndefined(widthProp)) {
-                                canvas->width = static_cast<int>(g_engine->toNumber(widthProp));
-                            }
-                            if (!g_engine->isUndefined(heightProp)) {
-                                canvas->height = static_cast<int>(g_engine->toNumber(heightProp));
+                    if (!bundles.empty()) {
+                        wgpuRenderPassEncoderExecuteBundles(capturedRenderPassForBundles, bundles.size(), bundles.data());
+                        uint64_t bundleDraws = 0;
+                        {
+                            std::lock_guard<std::mutex> lock(g_renderBundleDrawsMutex);
+                            for (WGPURenderBundle bundle : bundles) {
+                                auto it = g_renderBundleDraws.find(bundle);
+                                if (it != g_renderBundleDraws.end()) bundleDraws += it->second;
                             }
                         }
-
-                        // Create Canvas 2D context
-                        if (g_verboseLogging) std::cout << "[Canvas] Creating offscreen 2D context (" << canvas->width << "x" << canvas->height << ")" << std::endl;
-                        canvas->context2d = canvas::createCanvas2DContext(g_engine, canvas->width, canvas->height);
-                        canvas->hasContext2d = true;
-                        g_engine->protect(canvas->context2d);
-                        return canvas->context2d;
+                        g_drawCalls.fetch_add(bundleDraws, std::memory_order_relaxed);
+                        if (g_verboseLogging) std::cout << "[WebGPU] Executed " << bundles.size() << " render bundles" << std::endl;
                     }
 
-                    if (contextType == "webgpu") {
-                        // Create GPUCanvasContext for offscreen canvas
-                        // This shares the main surface/device for simplicity
-                        if (g_verboseLogging) std::cout << "[Canvas] Creating offscreen WebGPU context" << std::endl;
+                    return g_engine->newUndefined();
+                })
+            );
 
-                        // Suspend frame tracking - this context persists across frames
-                        g_engine->suspendFrameTracking();
+            // renderPass.end() - capture encoder and render pass for cleanup
+            WGPUCommandEncoder capturedEncoderForEnd = encoderToUse;
+            WGPURenderPassEncoder capturedRenderPass = renderPass;
+            g_engine->setProperty(jsRenderPass, "end",
+                g_engine->newFunction("end", [capturedEncoderForEnd, capturedRenderPass](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    if (capturedRenderPass) {
+                        wgpuRenderPassEncoderEnd(capturedRenderPass);
+                        wgpuRenderPassEncoderRelease(capturedRenderPass);
+
+                        // Remove from per-encoder map
+                        g_encoderRenderPassMap.erase(capturedEncoderForEnd);
+
+                        // Clear global if it matches
+                        if (g_jsRenderPass == capturedRenderPass) {
+                            g_jsRenderPass = nullptr;
+                        }
 
-                        auto canvasContext = g_engine->newObject();
+                        // Mark surface render pass as ended
+                        if (!g_workerEncoding && g_surfaceRenderEncoder == capturedEncoderForEnd) {
+                            g_surfaceRenderPassEnded = true;
+                        }
+                        if (g_verboseLogging) std::cout << "[WebGPU] Render pass ended" << std::endl;
+                    }
+                    return g_engine->newUndefined();
+                })
+            );
 
-                        // Store reference to our surface
-                        g_engine->setPrivateData(canvasContext, g_surface);
+            // Resume frame tracking
+            g_engine->resumeFrameTracking();
 
-                        // context.canvas - reference back to canvas element
-                        std::string globalName = "__offscreenCanvas_" + std::to_string(canvasId);
-                        auto canvasElement = g_engine->getGlobalProperty(globalName.c_str());
-                        g_engine->setProperty(canvasContext, "canvas", canvasElement);
+            return jsRenderPass;
+        })
+    );
 
-                        // context.configure({ device, format, alphaMode })
-                        g_engine->setProperty(canvasContext, "configure",
-                            g_engine->newFunction("configure", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                if (args.empty()) {
-                                    g_engine->throwException("configure requires a descriptor");
-                                    return g_engine->newUndefined();
-                                }
-                                auto descriptor = args[0];
-                                std::string format = g_engine->toString(g_engine->getProperty(descriptor, "format"));
-                                g_surfaceFormat = stringToFormat(format);
-                                g_contextConfigured = true;
-                                if (g_verboseLogging) std::cout << "[Canvas] Offscreen context configured with format: " << format << std::endl;
-                                return g_engine->newUndefined();
-                            })
-                        );
+    // encoder.beginComputePass(descriptor?)
+    g_engine->setProperty(jsEncoder, "beginComputePass",
+        g_engine->newFunction("beginComputePass", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (!g_jsCommandEncoder) {
+                g_engine->throwException("No command encoder");
+                return g_engine->newUndefined();
+            }
 
-                        // context.unconfigure()
-                        g_engine->setProperty(canvasContext, "unconfigure",
-                            g_engine->newFunction("unconfigure", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                return g_engine->newUndefined();
-                            })
-                        );
+            WGPUComputePassDescriptor computePassDesc = {};
+            g_jsComputePass = wgpuCommandEncoderBeginComputePass(g_jsCommandEncoder, &computePassDesc);
 
-                        // context.getCurrentTexture() -> GPUTexture
-                        g_engine->setProperty(canvasContext, "getCurrentTexture",
-                            g_engine->newFunction("getCurrentTexture", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                WGPUTexture texture = getCurrentSwapchainTexture();
-                                if (!texture) {
-                                    g_engine->throwException("Failed to get current texture");
-                                    return g_engine->newUndefined();
-                                }
-                                g_currentTexture = texture;
-                                if (g_verboseLogging) std::cout << "[Canvas] Offscreen got texture: " << (void*)texture << std::endl;
+            auto jsComputePass = g_engine->newObject();
 
-                                // Register in texture registry so createView can find it
-                                uint64_t textureId = g_nextTextureId++;
-                                g_textureRegistry[textureId] = {texture, g_surfaceFormat, g_canvasWidth, g_canvasHeight, 1, 1, WGPUTextureDimension_2D};
+            // computePass.setPipeline(pipeline)
+            g_engine->setProperty(jsComputePass, "setPipeline",
+                g_engine->newFunction("setPipeline", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    if (args.empty()) return g_engine->newUndefined();
+                    WGPUComputePipeline pipeline = (WGPUComputePipeline)g_engine->getPrivateData(args[0]);
+                    if (g_jsComputePass && pipeline) {
+                        wgpuComputePassEncoderSetPipeline(g_jsComputePass, pipeline);
+                    }
+                    return g_engine->newUndefined();
+                })
+            );
 
-                                // Suspend frame tracking for texture wrapper (persists until next frame)
-                                g_engine->suspendFrameTracking();
+            // computePass.setBindGroup(index, bindGroup, dynamicOffsets?)
+            g_engine->setProperty(jsComputePass, "setBindGroup",
+                g_engine->newFunction("setBindGroup", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    if (args.size() < 2) return g_engine->newUndefined();
+                    uint32_t index = (uint32_t)g_engine->toNumber(args[0]);
+                    WGPUBindGroup bindGroup = (WGPUBindGroup)g_engine->getPrivateData(args[1]);
+                    if (g_jsComputePass && bindGroup) {
+                        wgpuComputePassEncoderSetBindGroup(g_jsComputePass, index, bindGroup, 0, nullptr);
+                    }
+                    return g_engine->newUndefined();
+                })
+            );
 
-                                // Create JS wrapper for texture
-                                auto jsTexture = g_engine->newObject();
-                                g_engine->setPrivateData(jsTexture, texture);
+            // computePass.dispatchWorkgroups(countX, countY?, countZ?)
+            g_engine->setProperty(jsComputePass, "dispatchWorkgroups",
+                g_engine->newFunction("dispatchWorkgroups", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    if (args.empty()) return g_engine->newUndefined();
+                    uint32_t countX = (uint32_t)g_engine->toNumber(args[0]);
+                    uint32_t countY = args.size() > 1 ? (uint32_t)g_engine->toNumber(args[1]) : 1;
+                    uint32_t countZ = args.size() > 2 ? (uint32_t)g_engine->toNumber(args[2]) : 1;
+                    if (g_jsComputePass) {
+                        wgpuComputePassEncoderDispatchWorkgroups(g_jsComputePass, countX, countY, countZ);
+                        g_dispatches.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    return g_engine->newUndefined();
+                })
+            );
 
-                                // texture.width / height / depthOrArrayLayers
-                                g_engine->setProperty(jsTexture, "width", g_engine->newNumber(g_canvasWidth));
-                                g_engine->setProperty(jsTexture, "height", g_engine->newNumber(g_canvasHeight));
-                                g_engine->setProperty(jsTexture, "depthOrArrayLayers", g_engine->newNumber(1));
+            // computePass.end()
+            g_engine->setProperty(jsComputePass, "end",
+                g_engine->newFunction("end", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    if (g_jsComputePass) {
+                        wgpuComputePassEncoderEnd(g_jsComputePass);
+                        wgpuComputePassEncoderRelease(g_jsComputePass);
+                        g_jsComputePass = nullptr;
+                    }
+                    return g_engine->newUndefined();
+                })
+            );
 
-                                // texture.format
-                                g_engine->setProperty(jsTexture, "format", g_engine->newString(formatToString(g_surfaceFormat)));
-                                g_engine->setProperty(jsTexture, "_textureId", g_engine->newNumber((double)textureId));
+            if (g_verboseLogging) std::cout << "[WebGPU] Compute pass started" << std::endl;
+            return jsComputePass;
+        })
+    );
 
-                                // texture.createView(descriptor?) -> GPUTextureView
-                                // Capture textureId to look up the correct texture (not g_currentTexture which may change)
-                                g_engine->setProperty(jsTexture, "createView",
-                                    g_engine->newFunction("createView", [textureId](void* c, const std::vector<js::JSValueHandle>& a) {
-                                        // Look up texture from registry using captured textureId
-                                        auto it = g_textureRegistry.find(textureId);
-                                        if (it == g_textureRegistry.end()) {
-                                            std::cerr << "[WebGPU] Offscreen createView: Texture " << textureId << " not found in registry" << std::endl;
-                                            g_engine->throwException("Texture not found in registry");
-                                            return g_engine->newUndefined();
-                                        }
+    // encoder.copyBufferToBuffer(source, sourceOffset, destination, destinationOffset, size)
+    g_engine->setProperty(jsEncoder, "copyBufferToBuffer",
+        g_engine->newFunction("copyBufferToBuffer", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (args.size() < 5 || !g_jsCommandEncoder) return g_engine->newUndefined();
 
-                                        WGPUTexture texture = it->second.texture;
-                                        if (!texture) {
-                                            g_engine->throwException("No current texture");
-                                            return g_engine->newUndefined();
-                                        }
+            WGPUBuffer source = (WGPUBuffer)g_engine->getPrivateData(args[0]);
+            uint64_t sourceOffset = (uint64_t)g_engine->toNumber(args[1]);
+            WGPUBuffer destination = (WGPUBuffer)g_engine->getPrivateData(args[2]);
+            uint64_t destOffset = (uint64_t)g_engine->toNumber(args[3]);
+            uint64_t size = (uint64_t)g_engine->toNumber(args[4]);
 
-                                        WGPUTextureViewDescriptor viewDesc = {};
-                                        viewDesc.format = it->second.format;
-                                        viewDesc.dimension = WGPUTextureViewDimension_2D;
-                                        viewDesc.baseMipLevel = 0;
-                                        viewDesc.mipLevelCount = 1;
-                                        viewDesc.baseArrayLayer = 0;
-                                        viewDesc.arrayLayerCount = 1;
-                                        viewDesc.aspect = WGPUTextureAspect_All;
+            if (source && destination) {
+                wgpuCommandEncoderCopyBufferToBuffer(g_jsCommandEncoder, source, sourceOffset, destination, destOffset, size);
+            }
+            return g_engine->newUndefined();
+        })
+    );
 
-                                        WGPUTextureView view = wgpuTextureCreateView(texture, &viewDesc);
-                                        g_currentTextureView = view;
-                                        g_currentViewSourceTexture = texture;  // Track which texture the view was created from
-                                        if (g_verboseLogging) std::cout << "[Canvas] Offscreen createView: texture=" << (void*)texture
-                                                  << ", view=" << (void*)view << std::endl;
+    // encoder.copyBufferToTexture(source, destination, copySize)
+    g_engine->setProperty(jsEncoder, "copyBufferToTexture",
+        g_engine->newFunction("copyBufferToTexture", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (args.size() < 3 || !g_jsCommandEncoder) return g_engine->newUndefined();
+
+            auto sourceProp = args[0];
+            auto destProp = args[1];
+            auto sizeProp = args[2];
+
+            // Source (buffer info)
+            WGPUBuffer buffer = (WGPUBuffer)g_engine->getPrivateData(g_engine->getProperty(sourceProp, "buffer"));
+            uint64_t offset = (uint64_t)g_engine->toNumber(g_engine->getProperty(sourceProp, "offset"));
+            uint32_t bytesPerRow = (uint32_t)g_engine->toNumber(g_engine->getProperty(sourceProp, "bytesPerRow"));
+            uint32_t rowsPerImage = (uint32_t)g_engine->toNumber(g_engine->getProperty(sourceProp, "rowsPerImage"));
+
+            // Destination (texture info)
+            WGPUTexture texture = (WGPUTexture)g_engine->getPrivateData(g_engine->getProperty(destProp, "texture"));
+            uint32_t mipLevel = (uint32_t)g_engine->toNumber(g_engine->getProperty(destProp, "mipLevel"));
+            auto originProp = g_engine->getProperty(destProp, "origin");
+            uint32_t originX = 0, originY = 0, originZ = 0;
+            if (!g_engine->isUndefined(originProp)) {
+                originX = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originProp, 0));
+                originY = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originProp, 1));
+                originZ = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originProp, 2));
+            }
 
-                                        auto jsView = g_engine->newObject();
-                                        g_engine->setPrivateData(jsView, view);
-                                        g_engine->setProperty(jsView, "_type", g_engine->newString("textureView"));
+            // Copy size
+            uint32_t width = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeProp, 0));
+            uint32_t height = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeProp, 1));
+            uint32_t depthOrLayers = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeProp, 2));
+            if (depthOrLayers == 0) depthOrLayers = 1;
+
+            if (buffer && texture) {
+                WGPUImageCopyBuffer_Compat srcCopy = {};
+                srcCopy.buffer = buffer;
+                srcCopy.layout.offset = offset;
+                srcCopy.layout.bytesPerRow = bytesPerRow;
+                srcCopy.layout.rowsPerImage = rowsPerImage > 0 ? rowsPerImage : height;
+
+                WGPUImageCopyTexture_Compat dstCopy = {};
+                dstCopy.texture = texture;
+                dstCopy.mipLevel = mipLevel;
+                dstCopy.origin = {originX, originY, originZ};
+
+                WGPUExtent3D copySize = {width, height, depthOrLayers};
+                wgpuCommandEncoderCopyBufferToTexture(g_jsCommandEncoder, &srcCopy, &dstCopy, &copySize);
+            }
+            return g_engine->newUndefined();
+        })
+    );
 
-                                        return jsView;
-                                    })
-                                );
+    // encoder.copyTextureToBuffer(source, destination, copySize)
+    g_engine->setProperty(jsEncoder, "copyTextureToBuffer",
+        g_engine->newFunction("copyTextureToBuffer", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (args.size() < 3 || !g_jsCommandEncoder) return g_engine->newUndefined();
+
+            auto sourceProp = args[0];
+            auto destProp = args[1];
+            auto sizeProp = args[2];
+
+            // Source (texture info)
+            WGPUTexture texture = (WGPUTexture)g_engine->getPrivateData(g_engine->getProperty(sourceProp, "texture"));
+            uint32_t mipLevel = (uint32_t)g_engine->toNumber(g_engine->getProperty(sourceProp, "mipLevel"));
+            auto originProp = g_engine->getProperty(sourceProp, "origin");
+            uint32_t originX = 0, originY = 0, originZ = 0;
+            if (!g_engine->isUndefined(originProp)) {
+                originX = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originProp, 0));
+                originY = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originProp, 1));
+                originZ = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originProp, 2));
+            }
 
-                                // texture.destroy()
-                                g_engine->setProperty(jsTexture, "destroy",
-                                    g_engine->newFunction("destroy", [textureId](void* c, const std::vector<js::JSValueHandle>& a) {
-                                        // Swapchain textures are managed by the surface, but remove from registry
-                                        g_textureRegistry.erase(textureId);
-                                        return g_engine->newUndefined();
-                                    })
-                                );
+            // Destination (buffer info)
+            WGPUBuffer buffer = (WGPUBuffer)g_engine->getPrivateData(g_engine->getProperty(destProp, "buffer"));
+            uint64_t offset = (uint64_t)g_engine->toNumber(g_engine->getProperty(destProp, "offset"));
+            uint32_t bytesPerRow = (uint32_t)g_engine->toNumber(g_engine->getProperty(destProp, "bytesPerRow"));
+            uint32_t rowsPerImage = (uint32_t)g_engine->toNumber(g_engine->getProperty(destProp, "rowsPerImage"));
+
+            // Copy size - can be array [w,h,d] or object {width, height, depthOrArrayLayers}
+            uint32_t width = 0, height = 0, depthOrLayers = 1;
+            auto widthProp = g_engine->getProperty(sizeProp, "width");
+            if (!g_engine->isUndefined(widthProp)) {
+                // Object format: { width, height, depthOrArrayLayers }
+                width = (uint32_t)g_engine->toNumber(widthProp);
+                height = (uint32_t)g_engine->toNumber(g_engine->getProperty(sizeProp, "height"));
+                auto depthProp = g_engine->getProperty(sizeProp, "depthOrArrayLayers");
+                depthOrLayers = g_engine->isUndefined(depthProp) ? 1 : (uint32_t)g_engine->toNumber(depthProp);
+            } else {
+                // Array format: [width, height, depth]
+                width = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeProp, 0));
+                height = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeProp, 1));
+                depthOrLayers = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeProp, 2));
+            }
+            if (depthOrLayers == 0) depthOrLayers = 1;
 
-                                // Resume frame tracking for texture
-                                g_engine->resumeFrameTracking();
+            if (g_verboseLogging) {
+                std::cout << "[WebGPU] copyTextureToBuffer: texture=" << texture
+                          << ", buffer=" << buffer
+                          << ", size=" << width << "x" << height << "x" << depthOrLayers
+                          << ", bytesPerRow=" << bytesPerRow << std::endl;
+            }
 
-                                return jsTexture;
-                            })
-                        );
+            if (buffer && texture) {
+                WGPUImageCopyTexture_Compat srcCopy = {};
+                srcCopy.texture = texture;
+                srcCopy.mipLevel = mipLevel;
+                srcCopy.origin = {originX, originY, originZ};
 
-                        // Resume frame tracking
-                        g_engine->resumeFrameTracking();
+                WGPUImageCopyBuffer_Compat dstCopy = {};
+                dstCopy.buffer = buffer;
+                dstCopy.layout.offset = offset;
+                dstCopy.layout.bytesPerRow = bytesPerRow;
+                dstCopy.layout.rowsPerImage = rowsPerImage > 0 ? rowsPerImage : height;
 
-                        return canvasContext;
-                    }
+                WGPUExtent3D copySize = {width, height, depthOrLayers};
+                wgpuCommandEncoderCopyTextureToBuffer(g_jsCommandEncoder, &srcCopy, &dstCopy, &copySize);
+            }
+            return g_engine->newUndefined();
+        })
+    );
 
-                    // Ignore webgl requests silently (PixiJS feature detection)
-                    if (contextType == "webgl" || contextType == "webgl2" || contextType == "experimental-webgl") {
-                        return g_engine->newNull();
-                    }
+    // encoder.copyTextureToTexture(source, destination, copySize)
+    g_engine->setProperty(jsEncoder, "copyTextureToTexture",
+        g_engine->newFunction("copyTextureToTexture", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (args.size() < 3 || !g_jsCommandEncoder) return g_engine->newUndefined();
+
+            auto sourceProp = args[0];
+            auto destProp = args[1];
+            auto sizeProp = args[2];
+
+            // Source texture
+            WGPUTexture srcTexture = (WGPUTexture)g_engine->getPrivateData(g_engine->getProperty(sourceProp, "texture"));
+            uint32_t srcMipLevel = (uint32_t)g_engine->toNumber(g_engine->getProperty(sourceProp, "mipLevel"));
+            auto srcOriginProp = g_engine->getProperty(sourceProp, "origin");
+            uint32_t srcOriginX = 0, srcOriginY = 0, srcOriginZ = 0;
+            if (!g_engine->isUndefined(srcOriginProp)) {
+                srcOriginX = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(srcOriginProp, 0));
+                srcOriginY = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(srcOriginProp, 1));
+                srcOriginZ = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(srcOriginProp, 2));
+            }
 
-                    std::cerr << "[Canvas] Unsupported context type: " << contextType << std::endl;
-                    return g_engine->newNull();
-                });
+            // Destination texture
+            WGPUTexture dstTexture = (WGPUTexture)g_engine->getPrivateData(g_engine->getProperty(destProp, "texture"));
+            uint32_t dstMipLevel = (uint32_t)g_engine->toNumber(g_engine->getProperty(destProp, "mipLevel"));
+            auto dstOriginProp = g_engine->getProperty(destProp, "origin");
+            uint32_t dstOriginX = 0, dstOriginY = 0, dstOriginZ = 0;
+            if (!g_engine->isUndefined(dstOriginProp)) {
+                dstOriginX = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(dstOriginProp, 0));
+                dstOriginY = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(dstOriginProp, 1));
+                dstOriginZ = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(dstOriginProp, 2));
+            }
 
-                g_engine->setProperty(element, "getContext", getContextFn);
-                if (g_verboseLogging) std::cout << "[Canvas] Created offscreen canvas " << canvasId << std::endl;
+            // Copy size - handle both array and object forms
+            uint32_t width = 1, height = 1, depthOrLayers = 1;
+            if (g_engine->isArray(sizeProp)) {
+                width = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeProp, 0));
+                height = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeProp, 1));
+                auto depthVal = g_engine->getPropertyIndex(sizeProp, 2);
+                if (!g_engine->isUndefined(depthVal)) {
+                    depthOrLayers = (uint32_t)g_engine->toNumber(depthVal);
+                }
+            } else {
+                width = (uint32_t)g_engine->toNumber(g_engine->getProperty(sizeProp, "width"));
+                height = (uint32_t)g_engine->toNumber(g_engine->getProperty(sizeProp, "height"));
+                auto depthVal = g_engine->getProperty(sizeProp, "depthOrArrayLayers");
+                if (!g_engine->isUndefined(depthVal)) {
+                    depthOrLayers = (uint32_t)g_engine->toNumber(depthVal);
+                }
+            }
+            if (depthOrLayers == 0) depthOrLayers = 1;
 
-                // toDataURL for compatibility (returns empty data URI)
-                g_engine->setProperty(element, "toDataURL",
-                    g_engine->newFunction("toDataURL", [](void* c, const std::vector<js::JSValueHandle>& a) {
-                        std::string mimeType = "image/png";
-                        if (!a.empty()) {
-                            mimeType = g_engine->toString(a[0]);
-                        }
-                        // Return a minimal data URI (for @loaders.gl WebP detection)
-                        if (mimeType.find("webp") != std::string::npos) {
-                            return g_engine->newString("data:image/webp;base64,");
-                        }
-                        return g_engine->newString("data:image/png;base64,");
-                    })
-                );
+            if (srcTexture && dstTexture) {
+                WGPUImageCopyTexture_Compat srcCopy = {};
+                srcCopy.texture = srcTexture;
+                srcCopy.mipLevel = srcMipLevel;
+                srcCopy.origin = {srcOriginX, srcOriginY, srcOriginZ};
 
-                // getBoundingClientRect - return canvas dimensions
-                g_engine->setProperty(element, "getBoundingClientRect",
-                    g_engine->newFunction("getBoundingClientRect", [](void* c, const std::vector<js::JSValueHandle>& a) {
-                        // Get dimensions from the main canvas if available
-                        auto rect = g_engine->newObject();
-                        g_engine->setProperty(rect, "x", g_engine->newNumber(0));
-                        g_engine->setProperty(rect, "y", g_engine->newNumber(0));
-                        g_engine->setProperty(rect, "width", g_engine->newNumber(g_canvasWidth));
-                        g_engine->setProperty(rect, "height", g_engine->newNumber(g_canvasHeight));
-                        g_engine->setProperty(rect, "top", g_engine->newNumber(0));
-                        g_engine->setProperty(rect, "left", g_engine->newNumber(0));
-                        g_engine->setProperty(rect, "right", g_engine->newNumber(g_canvasWidth));
-                        g_engine->setProperty(rect, "bottom", g_engine->newNumber(g_canvasHeight));
-                        return rect;
-                    })
-                );
-            }
+                WGPUImageCopyTexture_Compat dstCopy = {};
+                dstCopy.texture = dstTexture;
+                dstCopy.mipLevel = dstMipLevel;
+                dstCopy.origin = {dstOriginX, dstOriginY, dstOriginZ};
 
-            return element;
+                WGPUExtent3D copySize = {width, height, depthOrLayers};
+                wgpuCommandEncoderCopyTextureToTexture(g_jsCommandEncoder, &srcCopy, &dstCopy, &copySize);
+            }
+            return g_engine->newUndefined();
         })
     );
 
-    // Add document.body if not present, or enhance existing body with required methods
-    auto existingBody = engine->getProperty(existingDocument, "body");
-    if (engine->isUndefined(existingBody) || engine->isNull(existingBody)) {
-        existingBody = engine->newObject();
-        engine->setProperty(existingDocument, "body", existingBody);
-    }
-    // Always add/update these methods on body
-    engine->setProperty(existingBody, "style", engine->newObject());
-    engine->setProperty(existingBody, "appendChild",
-        engine->newFunction("appendChild", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-            return args.empty() ? g_engine->newUndefined() : args[0];
-        })
-    );
-    engine->setProperty(existingBody, "removeChild",
-        engine->newFunction("removeChild", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-            return args.empty() ? g_engine->newUndefined() : args[0];
+    // encoder.clearBuffer(buffer, offset?, size?)
+    g_engine->setProperty(jsEncoder, "clearBuffer",
+        g_engine->newFunction("clearBuffer", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (args.empty() || !g_jsCommandEncoder) return g_engine->newUndefined();
+
+            WGPUBuffer buffer = (WGPUBuffer)g_engine->getPrivateData(args[0]);
+            uint64_t offset = args.size() > 1 ? (uint64_t)g_engine->toNumber(args[1]) : 0;
+            uint64_t size = args.size() > 2 ? (uint64_t)g_engine->toNumber(args[2]) : WGPU_WHOLE_SIZE;
+
+            if (buffer) {
+                wgpuCommandEncoderClearBuffer(g_jsCommandEncoder, buffer, offset, size);
+            }
+            return g_engine->newUndefined();
         })
     );
 
-    // ========================================================================
-    // Navigator object
-    // ========================================================================
-    auto navigatorHandle = engine->getGlobalProperty("navigator");
-    if (engine->isUndefined(navigatorHandle)) {
-        navigatorHandle = engine->newObject();
-        engine->setGlobalProperty("navigator", navigatorHandle);
-    }
+    // encoder.finish(descriptor?)
+    g_engine->setProperty(jsEncoder, "finish",
+        g_engine->newFunction("finish", [capturedEncoder](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            // Use captured encoder for this specific command encoder
+            WGPUCommandEncoder encoderToFinish = capturedEncoder;
+
+            // Auto-end any active render/compute passes for THIS encoder
+            // Look up from per-encoder map, not global
+            auto renderPassIt = g_encoderRenderPassMap.find(encoderToFinish);
+            if (renderPassIt != g_encoderRenderPassMap.end() && renderPassIt->second) {
+                WGPURenderPassEncoder renderPass = renderPassIt->second;
+                if (g_verboseLogging) std::cout << "[WebGPU] Auto-ending render pass (pass=" << (void*)renderPass << ", encoder=" << (void*)encoderToFinish << ")" << std::endl;
+                wgpuRenderPassEncoderEnd(renderPass);
+                wgpuRenderPassEncoderRelease(renderPass);
+                g_encoderRenderPassMap.erase(renderPassIt);
+
+                // Clear global if it matches
+                if (g_jsRenderPass == renderPass) {
+                    g_jsRenderPass = nullptr;
+                }
 
-    // Add common navigator properties for browser compatibility
-    // PixiJS and other libraries check these for feature detection
-    engine->setProperty(navigatorHandle, "userAgent",
-        engine->newString("Mozilla/5.0 (Macintosh; MystralNative/0.1) AppleWebKit/537.36 Chrome/120.0.0.0 Safari/537.36"));
-    engine->setProperty(navigatorHandle, "platform", engine->newString("MystralNative"));
-    engine->setProperty(navigatorHandle, "vendor", engine->newString("Mystral Engine"));
-    engine->setProperty(navigatorHandle, "language", engine->newString("en-US"));
-    engine->setProperty(navigatorHandle, "languages", engine->newArray(1));  // ["en-US"]
-    engine->setProperty(navigatorHandle, "onLine", engine->newBoolean(true));
-    engine->setProperty(navigatorHandle, "hardwareConcurrency", engine->newNumber(8));
-    engine->setProperty(navigatorHandle, "maxTouchPoints", engine->newNumber(0));
+                // Mark surface render pass as ended
+                if (!g_workerEncoding && g_surfaceRenderEncoder == encoderToFinish) {
+                    g_surfaceRenderPassEnded = true;
+                    if (g_verboseLogging) std::cout << "[WebGPU] Surface render pass auto-ended (encoder=" << (void*)encoderToFinish << ")" << std::endl;
+                }
+            }
 
-    // Create navigator.gpu object
-    auto gpuObject = engine->newObject();
+            auto computePassIt = g_encoderComputePassMap.find(encoderToFinish);
+            if (computePassIt != g_encoderComputePassMap.end() && computePassIt->second) {
+                WGPUComputePassEncoder computePass = computePassIt->second;
+                if (g_verboseLogging) std::cout << "[WebGPU] Auto-ending compute pass (pass=" << (void*)computePass << ", encoder=" << (void*)encoderToFinish << ")" << std::endl;
+                wgpuComputePassEncoderEnd(computePass);
+                wgpuComputePassEncoderRelease(computePass);
+                g_encoderComputePassMap.erase(computePassIt);
+
+                // Clear global if it matches
+                if (g_jsComputePass == computePass) {
+                    g_jsComputePass = nullptr;
+                }
+            }
 
-    // ========================================================================
-    // navigator.gpu.requestAdapter()
-    // ========================================================================
-    engine->setProperty(gpuObject, "requestAdapter",
-        engine->newFunction("requestAdapter", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-            // In native runtime, we already have an adapter, so just return a mock adapter object
-            auto adapter = g_engine->newObject();
+            WGPUCommandBufferDescriptor cmdDesc = {};
+            WGPUCommandBuffer cmdBuffer = nullptr;
 
-            // adapter.requestDevice()
-            g_engine->setProperty(adapter, "requestDevice",
-                g_engine->newFunction("requestDevice", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                    // Return a device object wrapping our native device
-                    auto device = g_engine->newObject();
-                    g_engine->setPrivateData(device, g_device);
+            if (encoderToFinish) {
+                cmdBuffer = wgpuCommandEncoderFinish(encoderToFinish, &cmdDesc);
+                wgpuCommandEncoderRelease(encoderToFinish);
 
-                    // device.queue
-                    auto queue = g_engine->newObject();
-                    g_engine->setPrivateData(queue, g_queue);
+                // Clear global if it matches
+                if (g_jsCommandEncoder == encoderToFinish) {
+                    g_jsCommandEncoder = nullptr;
+                }
 
-                    // queue.submit(commandBuffers)
-                    g_engine->setProperty(queue, "submit",
-                        g_engine->newFunction("submit", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                            if (args.empty()) {
-                                return g_engine->newUndefined();
-                            }
+                if (g_verboseLogging) std::cout << "[WebGPU] Command encoder finished, buffer: " << cmdBuffer << std::endl;
+            }
 
-                            // Get command buffers array and submit them
-                            auto cmdBuffersArray = args[0];
+            auto jsCommandBuffer = g_engine->newObject();
+            g_engine->setPrivateData(jsCommandBuffer, cmdBuffer);
+            g_engine->setProperty(jsCommandBuffer, "_type", g_engine->newString("commandBuffer"));
 
-                            // Get array length
-                            auto lengthProp = g_engine->getProperty(cmdBuffersArray, "length");
-                            int length = (int)g_engine->toNumber(lengthProp);
+            return jsCommandBuffer;
+        })
+    );
 
-                            // Collect command buffers
-                            std::vector<WGPUCommandBuffer> cmdBuffers;
-                            for (int i = 0; i < length; i++) {
-                                auto cmdBufferHandle = g_engine->getPropertyIndex(cmdBuffersArray, i);
-                                WGPUCommandBuffer cmdBuffer = (WGPUCommandBuffer)g_engine->getPrivateData(cmdBufferHandle);
-                                if (cmdBuffer) {
-                                    cmdBuffers.push_back(cmdBuffer);
-                                }
-                            }
+    // Resume frame tracking now that encoder wrapper is created
+    g_engine->resumeFrameTracking();
 
-                            // Submit user command buffers first
-                            static int submitCount = 0;
-                            submitCount++;
-                            if (!cmdBuffers.empty() && g_queue) {
-                                wgpuQueueSubmit(g_queue, cmdBuffers.size(), cmdBuffers.data());
-                                // Release command buffers after submission (they're consumed by submit)
-                                for (auto cmdBuf : cmdBuffers) {
-                                    wgpuCommandBufferRelease(cmdBuf);
-                                }
-                                // Tick to flush GPU work
-#if defined(MYSTRAL_WEBGPU_DAWN)
-                                wgpuDeviceTick(g_device);
-#elif defined(MYSTRAL_WEBGPU_WGPU)
-                                wgpuDevicePoll(g_device, false, nullptr);
-#endif
-                                if (g_verboseLogging) std::cout << "[WebGPU] Submit #" << submitCount << ": " << cmdBuffers.size() << " command buffers, g_currentTexture=" << (void*)g_currentTexture << std::endl;
-                            } else {
-                                if (g_verboseLogging) std::cout << "[WebGPU] Submit #" << submitCount << ": EMPTY (length=" << length << "), g_currentTexture=" << (void*)g_currentTexture << std::endl;
-                            }
+    return jsEncoder;
+}
 
-                            // Copy texture to screenshot buffer ONLY when about to present
-                            // This prevents capturing intermediate render passes (e.g., Three.js post-processing)
-                            // Only capture when the surface render pass has ended, matching the present condition
-                            // Also ensure we only capture once per frame (Three.js does multiple queue.submit() per frame)
-                            WGPUTexture screenshotTexture = g_currentViewSourceTexture ? g_currentViewSourceTexture : g_currentTexture;
-                            if (g_surfaceRenderPassEnded && !g_screenshotCapturedThisFrame && screenshotTexture && g_device && g_queue) {
-                                // Calculate buffer requirements
-                                uint32_t bytesPerPixel = 4;  // BGRA8
-                                uint32_t unalignedBytesPerRow = g_canvasWidth * bytesPerPixel;
-                                uint32_t bytesPerRow = (unalignedBytesPerRow + 255) & ~255;  // Align to 256
-                                size_t requiredSize = bytesPerRow * g_canvasHeight;
+// device.createRenderBundleEncoder(descriptor)
+// Used by Three.js for mipmap generation
+static js::JSValueHandle createRenderBundleEncoder(void* ctx, const std::vector<js::JSValueHandle>& args) {
+    if (args.empty()) {
+        g_engine->throwException("createRenderBundleEncoder requires a descriptor");
+        return g_engine->newUndefined();
+    }
 
-                                // Create or resize screenshot buffer if needed
-                                if (!g_screenshotBuffer || g_screenshotBufferSize < requiredSize) {
-                                    if (g_screenshotBuffer) {
-                                        wgpuBufferDestroy(g_screenshotBuffer);
-                                        wgpuBufferRelease(g_screenshotBuffer);
-                                    }
+    auto descriptor = args[0];
 
-                                    WGPUBufferDescriptor bufferDesc = {};
-                                    bufferDesc.size = requiredSize;
-                                    bufferDesc.usage = WGPUBufferUsage_CopyDst | WGPUBufferUsage_MapRead;
-                                    bufferDesc.mappedAtCreation = false;
+    // Parse color formats
+    auto colorFormats = g_engine->getProperty(descriptor, "colorFormats");
+    auto colorFormatsLength = g_engine->getProperty(colorFormats, "length");
+    int colorFormatCount = g_engine->isUndefined(colorFormatsLength) ? 0 : (int)g_engine->toNumber(colorFormatsLength);
 
-                                    g_screenshotBuffer = wgpuDeviceCreateBuffer(g_device, &bufferDesc);
-                                    g_screenshotBufferSize = requiredSize;
-                                    g_screenshotBytesPerRow = bytesPerRow;
-                                }
+    std::vector<WGPUTextureFormat> formats;
+    formats.reserve(colorFormatCount);
+    for (int i = 0; i < colorFormatCount; i++) {
+        auto formatProp = g_engine->getPropertyIndex(colorFormats, i);
+        if (!g_engine->isUndefined(formatProp) && !g_engine->isNull(formatProp)) {
+            formats.push_back(stringToFormat(g_engine->toString(formatProp)));
+        }
+    }
 
-                                // Create encoder to copy texture to buffer
-                                WGPUCommandEncoderDescriptor encDesc = {};
-                                WGPUCommandEncoder copyEncoder = wgpuDeviceCreateCommandEncoder(g_device, &encDesc);
+    // Parse depth stencil format
+    WGPUTextureFormat depthFormat = WGPUTextureFormat_Undefined;
+    auto depthFormatProp = g_engine->getProperty(descriptor, "depthStencilFormat");
+    if (!g_engine->isUndefined(depthFormatProp) && !g_engine->isNull(depthFormatProp)) {
+        depthFormat = stringToFormat(g_engine->toString(depthFormatProp));
+    }
 
-                                WGPUImageCopyTexture_Compat srcCopy = {};
-                                srcCopy.texture = screenshotTexture;
-                                srcCopy.mipLevel = 0;
-                                srcCopy.origin = {0, 0, 0};
-                                srcCopy.aspect = WGPUTextureAspect_All;
+    // Parse sample count
+    uint32_t sampleCount = 1;
+    auto sampleCountProp = g_engine->getProperty(descriptor, "sampleCount");
+    if (!g_engine->isUndefined(sampleCountProp)) {
+        sampleCount = (uint32_t)g_engine->toNumber(sampleCountProp);
+    }
 
-                                WGPUImageCopyBuffer_Compat dstCopy = {};
-                                dstCopy.buffer = g_screenshotBuffer;
-                                dstCopy.layout.offset = 0;
-                                dstCopy.layout.bytesPerRow = bytesPerRow;
-                                dstCopy.layout.rowsPerImage = g_canvasHeight;
+    WGPURenderBundleEncoderDescriptor desc = {};
+    desc.colorFormatCount = formats.size();
+    desc.colorFormats = formats.data();
+    desc.depthStencilFormat = depthFormat;
+    desc.sampleCount = sampleCount;
 
-                                WGPUExtent3D copySize = {g_canvasWidth, g_canvasHeight, 1};
-                                wgpuCommandEncoderCopyTextureToBuffer(copyEncoder, &srcCopy, &dstCopy, &copySize);
+    WGPURenderBundleEncoder bundleEncoder = wgpuDeviceCreateRenderBundleEncoder(g_device, &desc);
 
-                                if (g_verboseLogging) std::cout << "[Screenshot] Copying from texture " << (void*)screenshotTexture
-                                          << " (format=" << g_surfaceFormat << ", size=" << g_canvasWidth << "x" << g_canvasHeight << ")" << std::endl;
+    if (!bundleEncoder) {
+        g_engine->throwException("Failed to create render bundle encoder");
+        return g_engine->newUndefined();
+    }
 
-                                WGPUCommandBufferDescriptor cmdDesc = {};
-                                WGPUCommandBuffer copyCmd = wgpuCommandEncoderFinish(copyEncoder, &cmdDesc);
-                                wgpuQueueSubmit(g_queue, 1, &copyCmd);
+    auto jsEncoder = g_engine->newObject();
+    g_engine->setPrivateData(jsEncoder, bundleEncoder);
 
-                                wgpuCommandBufferRelease(copyCmd);
-                                wgpuCommandEncoderRelease(copyEncoder);
+    // Capture for closures
+    WGPURenderBundleEncoder capturedEncoder = bundleEncoder;
+    auto drawCount = std::make_shared<uint32_t>(0);  // Draws recorded so far (see executeBundles)
 
-                                // Wait for GPU work to complete before present
-                                // This ensures the screenshot copy finishes before the texture is released
-                                for (int syncIter = 0; syncIter < 100; syncIter++) {
-#if defined(MYSTRAL_WEBGPU_DAWN)
-                                    wgpuDeviceTick(g_device);
-                                    if (g_instance) {
-                                        wgpuInstanceProcessEvents(g_instance);
-                                    }
-#elif defined(MYSTRAL_WEBGPU_WGPU)
-                                    // wgpu-native: use wgpuDevicePoll to flush GPU work
-                                    wgpuDevicePoll(g_device, false, nullptr);
-#endif
-                                }
+    // renderBundleEncoder.setPipeline(pipeline)
+    g_engine->setProperty(jsEncoder, "setPipeline",
+        g_engine->newFunction("setPipeline", [capturedEncoder](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (args.empty()) return g_engine->newUndefined();
+            WGPURenderPipeline pipeline = (WGPURenderPipeline)g_engine->getPrivateData(args[0]);
+            wgpuRenderBundleEncoderSetPipeline(capturedEncoder, pipeline);
+            return g_engine->newUndefined();
+        })
+    );
 
-                                g_screenshotReady = true;
-                                g_screenshotCapturedThisFrame = true;
-                            }
+    // renderBundleEncoder.setVertexBuffer(slot, buffer, offset?, size?)
+    g_engine->setProperty(jsEncoder, "setVertexBuffer",
+        g_engine->newFunction("setVertexBuffer", [capturedEncoder](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (args.size() < 2) return g_engine->newUndefined();
+            uint32_t slot = (uint32_t)g_engine->toNumber(args[0]);
+            WGPUBuffer buffer = (WGPUBuffer)g_engine->getPrivateData(args[1]);
+            uint64_t offset = args.size() > 2 && !g_engine->isUndefined(args[2]) ? (uint64_t)g_engine->toNumber(args[2]) : 0;
+            uint64_t size = args.size() > 3 && !g_engine->isUndefined(args[3]) ? (uint64_t)g_engine->toNumber(args[3]) : WGPU_WHOLE_SIZE;
+            wgpuRenderBundleEncoderSetVertexBuffer(capturedEncoder, slot, buffer, offset, size);
+            return g_engine->newUndefined();
+        })
+    );
 
-                            // Present the surface only if:
-                            // 1. We have a current texture
-                            // 2. The surface render pass has been ended (commands submitted)
-                            // This prevents presenting before the render commands are in this submit
-                            if (g_surface && g_currentTexture && g_surfaceRenderPassEnded) {
-                                if (g_verboseLogging) std::cout << "[WebGPU] Presenting surface" << std::endl;
-                                wgpuSurfacePresent(g_surface);
+    // renderBundleEncoder.setIndexBuffer(buffer, format, offset?, size?)
+    g_engine->setProperty(jsEncoder, "setIndexBuffer",
+        g_engine->newFunction("setIndexBuffer", [capturedEncoder](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (args.size() < 2) return g_engine->newUndefined();
+            WGPUBuffer buffer = (WGPUBuffer)g_engine->getPrivateData(args[0]);
+            std::string formatStr = g_engine->toString(args[1]);
+            WGPUIndexFormat format = formatStr == "uint32" ? WGPUIndexFormat_Uint32 : WGPUIndexFormat_Uint16;
+            uint64_t offset = args.size() > 2 && !g_engine->isUndefined(args[2]) ? (uint64_t)g_engine->toNumber(args[2]) : 0;
+            uint64_t size = args.size() > 3 && !g_engine->isUndefined(args[3]) ? (uint64_t)g_engine->toNumber(args[3]) : WGPU_WHOLE_SIZE;
+            wgpuRenderBundleEncoderSetIndexBuffer(capturedEncoder, buffer, format, offset, size);
+            return g_engine->newUndefined();
+        })
+    );
 
-                                // Reset surface render tracking for next frame
-                                g_surfaceRenderEncoder = nullptr;
-                                g_surfaceRenderPassEnded = false;
-                                g_screenshotCapturedThisFrame = false;
+    // renderBundleEncoder.setBindGroup(index, bindGroup, dynamicOffsets?)
+    g_engine->setProperty(jsEncoder, "setBindGroup",
+        g_engine->newFunction("setBindGroup", [capturedEncoder](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (args.size() < 2) return g_engine->newUndefined();
+            uint32_t index = (uint32_t)g_engine->toNumber(args[0]);
+            WGPUBindGroup bindGroup = (WGPUBindGroup)g_engine->getPrivateData(args[1]);
+
+            // Parse dynamic offsets if provided
+            std::vector<uint32_t> dynamicOffsets;
+            if (args.size() > 2 && !g_engine->isUndefined(args[2])) {
+                auto offsetsArray = args[2];
+                auto lengthProp = g_engine->getProperty(offsetsArray, "length");
+                int offsetCount = g_engine->isUndefined(lengthProp) ? 0 : (int)g_engine->toNumber(lengthProp);
+                for (int i = 0; i < offsetCount; i++) {
+                    dynamicOffsets.push_back((uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(offsetsArray, i)));
+                }
+            }
 
-                                // Release the texture view if we created one
-                                if (g_currentTextureView) {
-                                    wgpuTextureViewRelease(g_currentTextureView);
-                                    g_currentTextureView = nullptr;
-                                }
+            wgpuRenderBundleEncoderSetBindGroup(capturedEncoder, index, bindGroup, dynamicOffsets.size(), dynamicOffsets.data());
+            return g_engine->newUndefined();
+        })
+    );
 
-                                // Null out the textures since they're now invalid after present
-                                g_currentTexture = nullptr;
-                                g_currentViewSourceTexture = nullptr;
-                            }
+    // renderBundleEncoder.draw(vertexCount, instanceCount?, firstVertex?, firstInstance?)
+    g_engine->setProperty(jsEncoder, "draw",
+        g_engine->newFunction("draw", [capturedEncoder, drawCount](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (args.empty()) return g_engine->newUndefined();
+            uint32_t vertexCount = (uint32_t)g_engine->toNumber(args[0]);
+            uint32_t instanceCount = args.size() > 1 ? (uint32_t)g_engine->toNumber(args[1]) : 1;
+            uint32_t firstVertex = args.size() > 2 ? (uint32_t)g_engine->toNumber(args[2]) : 0;
+            uint32_t firstInstance = args.size() > 3 ? (uint32_t)g_engine->toNumber(args[3]) : 0;
+            wgpuRenderBundleEncoderDraw(capturedEncoder, vertexCount, instanceCount, firstVertex, firstInstance);
+            (*drawCount)++;
+            return g_engine->newUndefined();
+        })
+    );
 
-                            return g_engine->newUndefined();
-                        })
-                    );
+    // renderBundleEncoder.drawIndexed(indexCount, instanceCount?, firstIndex?, baseVertex?, firstInstance?)
+    g_engine->setProperty(jsEncoder, "drawIndexed",
+        g_engine->newFunction("drawIndexed", [capturedEncoder, drawCount](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (args.empty()) return g_engine->newUndefined();
+            uint32_t indexCount = (uint32_t)g_engine->toNumber(args[0]);
+            uint32_t instanceCount = args.size() > 1 ? (uint32_t)g_engine->toNumber(args[1]) : 1;
+            uint32_t firstIndex = args.size() > 2 ? (uint32_t)g_engine->toNumber(args[2]) : 0;
+            int32_t baseVertex = args.size() > 3 ? (int32_t)g_engine->toNumber(args[3]) : 0;
+            uint32_t firstInstance = args.size() > 4 ? (uint32_t)g_engine->toNumber(args[4]) : 0;
+            wgpuRenderBundleEncoderDrawIndexed(capturedEncoder, indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
+            (*drawCount)++;
+            return g_engine->newUndefined();
+        })
+    );
 
-                    // queue.writeBuffer(buffer, offset, data, dataOffset?, size?)
-                    g_engine->setProperty(queue, "writeBuffer",
-                        g_engine->newFunction("writeBuffer", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                            if (args.size() < 3) {
-                                g_engine->throwException("writeBuffer requires buffer, offset, and data");
-                                return g_engine->newUndefined();
-                            }
+    // renderBundleEncoder.finish(descriptor?)
+    g_engine->setProperty(jsEncoder, "finish",
+        g_engine->newFunction("finish", [capturedEncoder, drawCount](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            WGPURenderBundleDescriptor desc = {};
+            WGPURenderBundle bundle = wgpuRenderBundleEncoderFinish(capturedEncoder, &desc);
+            if (bundle) {
+                std::lock_guard<std::mutex> lock(g_renderBundleDrawsMutex);
+                g_renderBundleDraws[bundle] = *drawCount;
+            }
 
-                            WGPUBuffer buffer = (WGPUBuffer)g_engine->getPrivateData(args[0]);
-                            uint64_t offset = (uint64_t)g_engine->toNumber(args[1]);
+            auto jsBundle = g_engine->newObject();
+            g_engine->setPrivateData(jsBundle, bundle);
+            g_engine->setProperty(jsBundle, "_type", g_engine->newString("renderBundle"));
+            if (bundle) {
+                g_engine->registerRelease(jsBundle, [bundle]() {
+                    wgpuRenderBundleRelease(bundle);
+                });
+            }
 
-                            // Get ArrayBuffer data
-                            size_t dataSize = 0;
-                            void* dataPtr = g_engine->getArrayBufferData(args[2], &dataSize);
+            if (g_verboseLogging) std::cout << "[WebGPU] Render bundle finished" << std::endl;
+            return jsBundle;
+        })
+    );
 
-                            if (!dataPtr || dataSize == 0) {
-                                g_engine->throwException("writeBuffer: invalid data");
-                                return g_engine->newUndefined();
-                            }
+    if (g_verboseLogging) std::cout << "[WebGPU] Created render bundle encoder" << std::endl;
+    return jsEncoder;
+}
 
-                            // Optional dataOffset and size
-                            size_t dataOffset = args.size() > 3 ? (size_t)g_engine->toNumber(args[3]) : 0;
-                            size_t writeSize = args.size() > 4 ? (size_t)g_engine->toNumber(args[4]) : (dataSize - dataOffset);
+/**
+ * GPU objects cross postMessage by reference so workers can encode with them.
+ * Every message takes its own reference, so collecting the sender's wrapper
+ * (registerRelease) cannot free an object the receiver still uses.
+ * Command buffers and render bundles are transferred, not shared: the sender's
+ * wrapper is emptied. A command buffer's single reference moves with it and is
+ * consumed by queue.submit().
+ */
+static void registerGpuHandleTypes() {
+    auto shared = [](const char* type, void (*addRef)(void*), void (*release)(void*), bool transfer = false) {
+        js::NativeHandleOps ops;
+        ops.addRef = addRef;
+        ops.release = release;
+        ops.transfer = transfer;
+        js::registerNativeHandleType(type, ops);
+    };
+    shared("buffer",
+           [](void* h) { wgpuBufferAddRef(static_cast<WGPUBuffer>(h)); },
+           [](void* h) { wgpuBufferRelease(static_cast<WGPUBuffer>(h)); });
+    shared("bindGroup",
+           [](void* h) { wgpuBindGroupAddRef(static_cast<WGPUBindGroup>(h)); },
+           [](void* h) { wgpuBindGroupRelease(static_cast<WGPUBindGroup>(h)); });
+    shared("bindGroupLayout",
+           [](void* h) { wgpuBindGroupLayoutAddRef(static_cast<WGPUBindGroupLayout>(h)); },
+           [](void* h) { wgpuBindGroupLayoutRelease(static_cast<WGPUBindGroupLayout>(h)); });
+    shared("sampler",
+           [](void* h) { wgpuSamplerAddRef(static_cast<WGPUSampler>(h)); },
+           [](void* h) { wgpuSamplerRelease(static_cast<WGPUSampler>(h)); });
+    shared("textureView",
+           [](void* h) { wgpuTextureViewAddRef(static_cast<WGPUTextureView>(h)); },
+           [](void* h) { wgpuTextureViewRelease(static_cast<WGPUTextureView>(h)); });
+    shared("renderPipeline",
+           [](void* h) { wgpuRenderPipelineAddRef(static_cast<WGPURenderPipeline>(h)); },
+           [](void* h) { wgpuRenderPipelineRelease(static_cast<WGPURenderPipeline>(h)); });
+    shared("computePipeline",
+           [](void* h) { wgpuComputePipelineAddRef(static_cast<WGPUComputePipeline>(h)); },
+           [](void* h) { wgpuComputePipelineRelease(static_cast<WGPUComputePipeline>(h)); });
+    shared("renderBundle",
+           [](void* h) { wgpuRenderBundleAddRef(static_cast<WGPURenderBundle>(h)); },
+           [](void* h) { wgpuRenderBundleRelease(static_cast<WGPURenderBundle>(h)); },
+           true);
+
+    js::NativeHandleOps commandBuffer;
+    commandBuffer.release = [](void* h) { wgpuCommandBufferRelease(static_cast<WGPUCommandBuffer>(h)); };
+    commandBuffer.transfer = true;
+    js::registerNativeHandleType("commandBuffer", commandBuffer);
+}
 
-                            if (buffer && g_queue) {
-                                wgpuQueueWriteBuffer(g_queue, buffer, offset, (uint8_t*)dataPtr + dataOffset, writeSize);
-                            }
+/**
+ * Initialize WebGPU bindings in the JS engine
+ */
+bool initBindings(js::Engine* engine, void* wgpuInstance, void* wgpuDevice, void* wgpuQueue, void* wgpuSurface, uint32_t surfaceFormat, uint32_t width, uint32_t height, bool debug) {
+    if (!engine) {
+        std::cerr << "[WebGPU] No JS engine provided for bindings" << std::endl;
+        return false;
+    }
 
-                            return g_engine->newUndefined();
-                        })
-                    );
+#if defined(MYSTRAL_WEBGPU_WGPU) || defined(MYSTRAL_WEBGPU_DAWN)
+    // Set verbose logging based on debug flag
+    g_verboseLogging = debug;
 
-                    // queue.writeTexture(destination, data, dataLayout, size)
-                    g_engine->setProperty(queue, "writeTexture",
-                        g_engine->newFunction("writeTexture", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                            if (args.size() < 4) {
-                                g_engine->throwException("writeTexture requires destination, data, dataLayout, and size");
-                                return g_engine->newUndefined();
-                            }
+    g_engine = engine;
+    g_instance = (WGPUInstance)wgpuInstance;
 
-                            // Parse destination {texture, mipLevel?, origin?, aspect?}
-                            auto destination = args[0];
-                            auto textureHandle = g_engine->getProperty(destination, "texture");
-                            WGPUTexture texture = (WGPUTexture)g_engine->getPrivateData(textureHandle);
+    registerGpuHandleTypes();
+    g_device = (WGPUDevice)wgpuDevice;
+    g_queue = (WGPUQueue)wgpuQueue;
+    g_surface = (WGPUSurface)wgpuSurface;
 
-                            if (!texture) {
-                                g_engine->throwException("writeTexture: invalid texture");
-                                return g_engine->newUndefined();
-                            }
+    // Set canvas dimensions from window size
+    g_canvasWidth = width;
+    g_canvasHeight = height;
+    g_surfaceFormat = (WGPUTextureFormat)surfaceFormat;
 
-                            auto mipLevelVal = g_engine->getProperty(destination, "mipLevel");
-                            uint32_t mipLevel = g_engine->isUndefined(mipLevelVal) ? 0 : (uint32_t)g_engine->toNumber(mipLevelVal);
+    if (g_verboseLogging) {
+        std::cout << "[WebGPU] Initializing JavaScript bindings..." << std::endl;
+        std::cout << "[WebGPU] Surface format: " << surfaceFormat << std::endl;
+    }
 
-                            // Parse origin
-                            auto originVal = g_engine->getProperty(destination, "origin");
-                            uint32_t originX = 0, originY = 0, originZ = 0;
-                            if (!g_engine->isUndefined(originVal)) {
-                                auto lengthProp = g_engine->getProperty(originVal, "length");
-                                if (!g_engine->isUndefined(lengthProp)) {
-                                    // Array format
-                                    int len = (int)g_engine->toNumber(lengthProp);
-                                    if (len >= 1) originX = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originVal, 0));
-                                    if (len >= 2) originY = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originVal, 1));
-                                    if (len >= 3) originZ = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originVal, 2));
-                                } else {
-                                    // Object format
-                                    auto x = g_engine->getProperty(originVal, "x");
-                                    auto y = g_engine->getProperty(originVal, "y");
-                                    auto z = g_engine->getProperty(originVal, "z");
-                                    if (!g_engine->isUndefined(x)) originX = (uint32_t)g_engine->toNumber(x);
-                                    if (!g_engine->isUndefined(y)) originY = (uint32_t)g_engine->toNumber(y);
-                                    if (!g_engine->isUndefined(z)) originZ = (uint32_t)g_engine->toNumber(z);
-                                }
-                            }
+    // ========================================================================
+    // Create a mock parent element for the canvas (needed by Debugger)
+    // ========================================================================
+    auto parentElement = engine->newObject();
+    engine->setProperty(parentElement, "style", engine->newObject());
+    engine->setProperty(parentElement, "appendChild",
+        engine->newFunction("appendChild", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            // No-op in native runtime
+            return args.empty() ? g_engine->newUndefined() : args[0];
+        })
+    );
+    engine->setProperty(parentElement, "removeChild",
+        engine->newFunction("removeChild", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            return args.empty() ? g_engine->newUndefined() : args[0];
+        })
+    );
 
-                            // Get ArrayBuffer data
-                            size_t dataSize = 0;
-                            void* dataPtr = g_engine->getArrayBufferData(args[1], &dataSize);
+    // ========================================================================
+    // Get existing canvas from runtime.cpp's document.getElementById
+    // The canvas was created by setupDOMEvents() with addEventListener, style, etc.
+    // We just need to add WebGPU-specific methods (getContext) to it.
+    // ========================================================================
+    auto existingDocument = engine->getGlobalProperty("document");
+    auto getElementByIdFunc = engine->getProperty(existingDocument, "getElementById");
 
-                            if (!dataPtr || dataSize == 0) {
-                                g_engine->throwException("writeTexture: invalid data");
-                                return g_engine->newUndefined();
-                            }
+    // Call document.getElementById('canvas') to get the existing canvas
+    std::vector<js::JSValueHandle> args;
+    args.push_back(engine->newString("canvas"));
+    auto canvasObject = engine->call(getElementByIdFunc, existingDocument, args);
 
-                            // Parse size FIRST (need height for rowsPerImage default)
-                            auto sizeVal = args[3];
-                            uint32_t width = 1, height = 1, depthOrArrayLayers = 1;
-                            auto lengthProp = g_engine->getProperty(sizeVal, "length");
-                            if (!g_engine->isUndefined(lengthProp)) {
-                                int len = (int)g_engine->toNumber(lengthProp);
-                                if (len >= 1) width = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeVal, 0));
-                                if (len >= 2) height = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeVal, 1));
-                                if (len >= 3) depthOrArrayLayers = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeVal, 2));
-                            } else {
-                                auto w = g_engine->getProperty(sizeVal, "width");
-                                auto h = g_engine->getProperty(sizeVal, "height");
-                                auto d = g_engine->getProperty(sizeVal, "depthOrArrayLayers");
-                                if (!g_engine->isUndefined(w)) width = (uint32_t)g_engine->toNumber(w);
-                                if (!g_engine->isUndefined(h)) height = (uint32_t)g_engine->toNumber(h);
-                                if (!g_engine->isUndefined(d)) depthOrArrayLayers = (uint32_t)g_engine->toNumber(d);
-                            }
+    if (engine->isNull(canvasObject) || engine->isUndefined(canvasObject)) {
+        std::cerr << "[WebGPU] Warning: No existing canvas found, creating new one" << std::endl;
+        canvasObject = engine->newObject();
+        engine->setProperty(canvasObject, "width", engine->newNumber(g_canvasWidth));
+        engine->setProperty(canvasObject, "height", engine->newNumber(g_canvasHeight));
+        engine->setProperty(canvasObject, "clientWidth", engine->newNumber(g_canvasWidth));
+        engine->setProperty(canvasObject, "clientHeight", engine->newNumber(g_canvasHeight));
+    }
 
-                            // Parse dataLayout {offset?, bytesPerRow, rowsPerImage?}
-                            auto dataLayout = args[2];
-                            auto layoutOffsetVal = g_engine->getProperty(dataLayout, "offset");
-                            uint64_t layoutOffset = g_engine->isUndefined(layoutOffsetVal) ? 0 : (uint64_t)g_engine->toNumber(layoutOffsetVal);
+    // Update canvas dimensions (in case they differ)
+    engine->setProperty(canvasObject, "width", engine->newNumber(g_canvasWidth));
+    engine->setProperty(canvasObject, "height", engine->newNumber(g_canvasHeight));
+    engine->setProperty(canvasObject, "clientWidth", engine->newNumber(g_canvasWidth));
+    engine->setProperty(canvasObject, "clientHeight", engine->newNumber(g_canvasHeight));
 
-                            uint32_t bytesPerRow = (uint32_t)g_engine->toNumber(g_engine->getProperty(dataLayout, "bytesPerRow"));
+    // canvas.parentElement - mock parent element (for Debugger compatibility)
+    engine->setProperty(canvasObject, "parentElement", parentElement);
 
-                            auto rowsPerImageVal = g_engine->getProperty(dataLayout, "rowsPerImage");
-                            // rowsPerImage must be >= height for 2D textures (wgpu validation requirement)
-                            uint32_t rowsPerImage = g_engine->isUndefined(rowsPerImageVal) ? height : (uint32_t)g_engine->toNumber(rowsPerImageVal);
-                            if (rowsPerImage == 0) rowsPerImage = height;
+    // canvas.transferControlToOffscreen() -> OffscreenCanvas
+    // The returned canvas can be posted to a worker; its committed frames are composited here
+    canvas::registerOffscreenCanvasHandle();
+    engine->setProperty(canvasObject, "transferControlToOffscreen",
+        engine->newFunction("transferControlToOffscreen", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (g_transferredCanvas || g_mainCanvas2DContext) {
+                g_engine->throwException("Cannot transfer control from a canvas that has a rendering context");
+                return g_engine->newUndefined();
+            }
+            g_transferredCanvas = canvas::createTransferredCanvas(g_canvasWidth, g_canvasHeight);
+            if (g_verboseLogging) std::cout << "[Canvas] Main canvas transferred to OffscreenCanvas" << std::endl;
+            return canvas::createOffscreenCanvasObject(g_engine, g_transferredCanvas);
+        })
+    );
 
-                            // Create copy structures
-                            WGPUImageCopyTexture_Compat destCopy = {};
-                            destCopy.texture = texture;
-                            destCopy.mipLevel = mipLevel;
-                            destCopy.origin = {originX, originY, originZ};
-                            destCopy.aspect = WGPUTextureAspect_All;
+    // canvas.getContext('webgpu') -> GPUCanvasContext
+    // This is the WebGPU-specific method we add to the existing canvas
+    engine->setProperty(canvasObject, "getContext",
+        engine->newFunction("getContext", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (args.empty()) {
+                return g_engine->newNull();
+            }
 
-                            WGPUTextureDataLayout_Compat layout = {};
-                            layout.offset = layoutOffset;
-                            layout.bytesPerRow = bytesPerRow;
-                            layout.rowsPerImage = rowsPerImage;
+            std::string contextType = g_engine->toString(args[0]);
 
-                            WGPUExtent3D copySize = {width, height, depthOrArrayLayers};
+            if (g_transferredCanvas) {
+                g_engine->throwException("Canvas control was transferred to an OffscreenCanvas");
+                return g_engine->newUndefined();
+            }
 
-                            // Write texture
-                            wgpuQueueWriteTexture(g_queue, &destCopy, (uint8_t*)dataPtr + layoutOffset, dataSize - layoutOffset, &layout, &copySize);
+            // Handle Canvas 2D context
+            if (contextType == "2d") {
+                if (g_verboseLogging) std::cout << "[Canvas] Creating 2D context (" << g_canvasWidth << "x" << g_canvasHeight << ")" << std::endl;
+                auto ctx2d = canvas::createCanvas2DContext(g_engine, g_canvasWidth, g_canvasHeight);
 
-                            if (g_verboseLogging) std::cout << "[WebGPU] writeTexture: " << width << "x" << height << " (" << dataSize << " bytes)" << std::endl;
+                // Set reference back to canvas
+                auto canvas = g_engine->getGlobalProperty("canvas");
+                g_engine->setProperty(ctx2d, "canvas", canvas);
 
-                            return g_engine->newUndefined();
-                        })
-                    );
+                // Store the native context for Canvas 2D to WebGPU compositing
+                g_mainCanvas2DContext = static_cast<canvas::Canvas2DContext*>(g_engine->getPrivateData(ctx2d));
+                if (g_verboseLogging) std::cout << "[Canvas] Main canvas using 2D context - will composite to WebGPU" << std::endl;
 
-                    // queue.copyExternalImageToTexture(source, destination, copySize)
-                    // Standard WebGPU way to upload ImageBitmap to texture
-                    g_engine->setProperty(queue, "copyExternalImageToTexture",
-                        g_engine->newFunction("copyExternalImageToTexture", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                            if (args.size() < 3) {
-                                g_engine->throwException("copyExternalImageToTexture requires source, destination, and copySize");
-                                return g_engine->newUndefined();
-                            }
+                return ctx2d;
+            }
 
-                            // Parse source (ImageBitmap-like object or canvas element)
-                            auto source = args[0];
-                            auto sourceObj = g_engine->getProperty(source, "source");
-                            if (g_engine->isUndefined(sourceObj)) {
-                                sourceObj = source; // source might be passed directly
-                            }
+            if (contextType != "webgpu") {
+                std::cerr << "[Canvas] Unknown context type: " << contextType << std::endl;
+                return g_engine->newNull();
+            }
 
-                            // Parse flipY option (default false per WebGPU spec)
-                            bool flipY = false;
-                            auto flipYProp = g_engine->getProperty(source, "flipY");
-                            if (!g_engine->isUndefined(flipYProp)) {
-                                flipY = g_engine->toBoolean(flipYProp);
-                            }
+            // Create GPUCanvasContext
+            auto canvasContext = g_engine->newObject();
 
-                            int imgWidth = 0;
-                            int imgHeight = 0;
-                            size_t dataSize = 0;
-                            void* dataPtr = nullptr;
+            // Store reference to our surface
+            g_engine->setPrivateData(canvasContext, g_surface);
 
-                            // Try to get data from ImageBitmap
-                            auto imageData = g_engine->getProperty(sourceObj, "_data");
-                            if (!g_engine->isUndefined(imageData)) {
-                                // Standard ImageBitmap with _data
-                                imgWidth = (int)g_engine->toNumber(g_engine->getProperty(sourceObj, "width"));
-                                imgHeight = (int)g_engine->toNumber(g_engine->getProperty(sourceObj, "height"));
-                                dataPtr = g_engine->getArrayBufferData(imageData, &dataSize);
-                            } else {
-                                // Check if it's a canvas element
-                                auto tagName = g_engine->getProperty(sourceObj, "tagName");
-                                std::string tagNameStr = g_engine->isUndefined(tagName) ? "" : g_engine->toString(tagName);
+            // context.canvas - reference back to canvas
+            auto canvas = g_engine->getGlobalProperty("canvas");
+            g_engine->setProperty(canvasContext, "canvas", canvas);
 
-                                if (tagNameStr == "CANVAS" || tagNameStr == "canvas") {
-                                    // Get the canvas ID from private data or property
-                                    auto canvasIdProp = g_engine->getProperty(sourceObj, "_offscreenCanvasId");
-                                    if (!g_engine->isUndefined(canvasIdProp)) {
-                                        int canvasId = (int)g_engine->toNumber(canvasIdProp);
-                                        auto it = g_offscreenCanvases.find(canvasId);
-                                        if (it != g_offscreenCanvases.end() && it->second->hasContext2d) {
-                                            // Get pixel data from the 2D context
-                                            auto ctx2dHandle = it->second->context2d;
-                                            auto nativeCtx = static_cast<canvas::Canvas2DContext*>(g_engine->getPrivateData(ctx2dHandle));
-                                            if (nativeCtx) {
-                                                imgWidth = it->second->width;
-                                                imgHeight = it->second->height;
-                                                dataPtr = const_cast<void*>(static_cast<const void*>(nativeCtx->getPixelData()));
-                                                dataSize = nativeCtx->getPixelDataSize();
-                                            }
-                                        }
-                                    }
-                                }
+            // context.configure({ device, format, alphaMode })
+            g_engine->setProperty(canvasContext, "configure",
+                g_engine->newFunction("configure", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    if (args.empty()) {
+                        g_engine->throwException("configure requires a descriptor");
+                        return g_engine->newUndefined();
+                    }
 
-                                // Check if it's already a 2D context (has getImageData method or _contextType)
-                                auto contextType = g_engine->getProperty(sourceObj, "_contextType");
-                                if (!g_engine->isUndefined(contextType)) {
-                                    std::string ctxTypeStr = g_engine->toString(contextType);
-                                    if (ctxTypeStr == "2d") {
-                                        // It's a 2D context, get the canvas and then get pixel data
-                                        auto canvas = g_engine->getProperty(sourceObj, "canvas");
-                                        if (!g_engine->isUndefined(canvas)) {
-                                            auto canvasIdProp = g_engine->getProperty(canvas, "_offscreenCanvasId");
-                                            if (!g_engine->isUndefined(canvasIdProp)) {
-                                                int canvasId = (int)g_engine->toNumber(canvasIdProp);
-                                                auto it = g_offscreenCanvases.find(canvasId);
-                                                if (it != g_offscreenCanvases.end() && it->second->hasContext2d) {
-                                                    auto nativeCtx = static_cast<canvas::Canvas2DContext*>(g_engine->getPrivateData(sourceObj));
-                                                    if (nativeCtx) {
-                                                        imgWidth = it->second->width;
-                                                        imgHeight = it->second->height;
-                                                        dataPtr = const_cast<void*>(static_cast<const void*>(nativeCtx->getPixelData()));
-                                                        dataSize = nativeCtx->getPixelDataSize();
-                                                    }
-                                                }
-                                            }
-                                        }
-                                    }
-                                }
-                            }
+                    auto descriptor = args[0];
 
-                            if (!dataPtr || dataSize == 0) {
-                                // Try to get width/height anyway for better error message
-                                auto widthProp = g_engine->getProperty(sourceObj, "width");
-                                auto heightProp = g_engine->getProperty(sourceObj, "height");
-                                if (!g_engine->isUndefined(widthProp)) imgWidth = (int)g_engine->toNumber(widthProp);
-                                if (!g_engine->isUndefined(heightProp)) imgHeight = (int)g_engine->toNumber(heightProp);
+                    // Get format
+                    std::string format = g_engine->toString(g_engine->getProperty(descriptor, "format"));
+                    g_surfaceFormat = stringToFormat(format);
+                    // Note: alphaMode and device are stored but surface is already configured
 
-                                std::cerr << "[WebGPU] copyExternalImageToTexture: unsupported source type, width=" << imgWidth << ", height=" << imgHeight << std::endl;
-                                // Return silently instead of throwing - PixiJS might be able to continue
-                                return g_engine->newUndefined();
-                            }
+                    g_contextConfigured = true;
+                    if (g_verboseLogging) std::cout << "[Canvas] Context configured with format: " << format << std::endl;
 
-                            // Parse destination
-                            auto destination = args[1];
-                            auto textureObj = g_engine->getProperty(destination, "texture");
-                            WGPUTexture texture = (WGPUTexture)g_engine->getPrivateData(textureObj);
-                            if (!texture) {
-                                g_engine->throwException("copyExternalImageToTexture: invalid texture");
-                                return g_engine->newUndefined();
-                            }
+                    return g_engine->newUndefined();
+                })
+            );
 
-                            // Optional mipLevel and origin
-                            uint32_t mipLevel = 0;
-                            auto mipLevelVal = g_engine->getProperty(destination, "mipLevel");
-                            if (!g_engine->isUndefined(mipLevelVal)) {
-                                mipLevel = (uint32_t)g_engine->toNumber(mipLevelVal);
-                            }
+            // context.unconfigure()
+            g_engine->setProperty(canvasContext, "unconfigure",
+                g_engine->newFunction("unconfigure", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    g_contextConfigured = false;
+                    return g_engine->newUndefined();
+                })
+            );
 
-                            uint32_t originX = 0, originY = 0, originZ = 0;
-                            auto originVal = g_engine->getProperty(destination, "origin");
-                            if (!g_engine->isUndefined(originVal)) {
-                                if (g_engine->isArray(originVal)) {
-                                    originX = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originVal, 0));
-                                    originY = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originVal, 1));
-                                    originZ = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originVal, 2));
-                                }
-                            }
+            // context.getCurrentTexture() -> GPUTexture
+            g_engine->setProperty(canvasContext, "getCurrentTexture",
+                g_engine->newFunction("getCurrentTexture", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    // Get current swapchain texture
+                    WGPUTexture texture = getCurrentSwapchainTexture();
+                    if (!texture) {
+                        g_engine->throwException("Failed to get current texture");
+                        return g_engine->newUndefined();
+                    }
 
-                            // Parse copySize
-                            auto sizeVal = args[2];
-                            uint32_t width = imgWidth, height = imgHeight, depthOrArrayLayers = 1;
-                            if (g_engine->isArray(sizeVal)) {
-                                width = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeVal, 0));
-                                height = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeVal, 1));
-                                auto depthVal = g_engine->getPropertyIndex(sizeVal, 2);
-                                if (!g_engine->isUndefined(depthVal)) {
-                                    depthOrArrayLayers = (uint32_t)g_engine->toNumber(depthVal);
-                                }
-                            } else if (!g_engine->isUndefined(sizeVal)) {
-                                auto widthVal = g_engine->getProperty(sizeVal, "width");
-                                auto heightVal = g_engine->getProperty(sizeVal, "height");
-                                if (!g_engine->isUndefined(widthVal)) width = (uint32_t)g_engine->toNumber(widthVal);
-                                if (!g_engine->isUndefined(heightVal)) height = (uint32_t)g_engine->toNumber(heightVal);
-                            }
+                    g_currentTexture = texture;
+                    static int frameCount = 0;
+                    if (frameCount++ < 3) {
+                        if (g_verboseLogging) std::cout << "[Canvas] Got texture: " << texture << std::endl;
+                    }
 
-                            // Handle flipY by creating a flipped copy of the data
-                            std::vector<uint8_t> flippedData;
-                            void* uploadDataPtr = dataPtr;
-                            if (flipY && dataPtr && imgHeight > 0) {
-                                size_t bytesPerRow = imgWidth * 4;  // RGBA
-                                flippedData.resize(dataSize);
-                                const uint8_t* srcData = static_cast<const uint8_t*>(dataPtr);
-                                for (int y = 0; y < imgHeight; y++) {
-                                    // Copy row (imgHeight - 1 - y) to row y
-                                    const uint8_t* srcRow = srcData + (imgHeight - 1 - y) * bytesPerRow;
-                                    uint8_t* dstRow = flippedData.data() + y * bytesPerRow;
-                                    std::memcpy(dstRow, srcRow, bytesPerRow);
-                                }
-                                uploadDataPtr = flippedData.data();
-                                if (g_verboseLogging) std::cout << "[WebGPU] copyExternalImageToTexture: flipY applied" << std::endl;
+                    // Register in texture registry so createView can find it
+                    uint64_t textureId = g_nextTextureId++;
+                    g_textureRegistry[textureId] = {texture, g_surfaceFormat, g_canvasWidth, g_canvasHeight, 1, 1, WGPUTextureDimension_2D};
+
+                    // Create JS wrapper for texture
+                    auto jsTexture = g_engine->newObject();
+                    g_engine->setPrivateData(jsTexture, texture);
+
+                    // texture.width / height / depthOrArrayLayers
+                    g_engine->setProperty(jsTexture, "width", g_engine->newNumber(g_canvasWidth));
+                    g_engine->setProperty(jsTexture, "height", g_engine->newNumber(g_canvasHeight));
+                    g_engine->setProperty(jsTexture, "depthOrArrayLayers", g_engine->newNumber(1));
+
+                    // texture.format
+                    g_engine->setProperty(jsTexture, "format", g_engine->newString(formatToString(g_surfaceFormat)));
+                    g_engine->setProperty(jsTexture, "_textureId", g_engine->newNumber((double)textureId));
+
+                    // texture.createView(descriptor?) -> GPUTextureView
+                    // Capture textureId to look up the correct texture (not g_currentTexture which may change)
+                    g_engine->setProperty(jsTexture, "createView",
+                        g_engine->newFunction("createView", [textureId](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                            // Look up texture from registry using captured textureId
+                            auto it = g_textureRegistry.find(textureId);
+                            if (it == g_textureRegistry.end()) {
+                                std::cerr << "[WebGPU] Canvas createView: Texture " << textureId << " not found in registry" << std::endl;
+                                g_engine->throwException("Texture not found in registry");
+                                return g_engine->newUndefined();
                             }
 
-                            // Use writeTexture internally (same effect as copyExternalImageToTexture)
-                            WGPUImageCopyTexture_Compat destCopy = {};
-                            destCopy.texture = texture;
-                            destCopy.mipLevel = mipLevel;
-                            destCopy.origin = {originX, originY, originZ};
-                            destCopy.aspect = WGPUTextureAspect_All;
+                            WGPUTexture texture = it->second.texture;
+                            if (!texture) {
+                                g_engine->throwException("No current texture");
+                                return g_engine->newUndefined();
+                            }
 
-                            WGPUTextureDataLayout_Compat layout = {};
-                            layout.offset = 0;
-                            layout.bytesPerRow = imgWidth * 4;  // RGBA
-                            layout.rowsPerImage = imgHeight;
+                            // Create texture view
+                            WGPUTextureViewDescriptor viewDesc = {};
+                            viewDesc.format = it->second.format;
+                            viewDesc.dimension = WGPUTextureViewDimension_2D;
+                            viewDesc.baseMipLevel = 0;
+                            viewDesc.mipLevelCount = 1;
+                            viewDesc.baseArrayLayer = 0;
+                            viewDesc.arrayLayerCount = 1;
+                            viewDesc.aspect = WGPUTextureAspect_All;
 
-                            WGPUExtent3D copySize = {width, height, depthOrArrayLayers};
+                            WGPUTextureView view = wgpuTextureCreateView(texture, &viewDesc);
 
-                            wgpuQueueWriteTexture(g_queue, &destCopy, uploadDataPtr, dataSize, &layout, &copySize);
+                            g_currentTextureView = view;
+                            g_currentViewSourceTexture = texture;  // Track which texture the view was created from
 
-                            if (g_verboseLogging) std::cout << "[WebGPU] copyExternalImageToTexture: " << width << "x" << height << (flipY ? " (flipY)" : "") << std::endl;
+                            // Create JS wrapper
+                            auto jsView = g_engine->newObject();
+                            g_engine->setPrivateData(jsView, view);
+                            g_engine->setProperty(jsView, "_type", g_engine->newString("textureView"));
 
-                            return g_engine->newUndefined();
+                            return jsView;
                         })
                     );
 
-                    // queue.onSubmittedWorkDone() - returns Promise that resolves when GPU work is done
-                    g_engine->setProperty(queue, "onSubmittedWorkDone",
-                        g_engine->newFunction("onSubmittedWorkDone", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                            // For now, return a Promise that resolves immediately
-                            // Dawn's wgpuQueueOnSubmittedWorkDone is callback-based, which is complex to integrate
-                            // Since we're running single-threaded and submit() is synchronous, work is already done
-                            return g_engine->evalWithResult("Promise.resolve()", "<onSubmittedWorkDone>");
+                    // texture.destroy()
+                    g_engine->setProperty(jsTexture, "destroy",
+                        g_engine->newFunction("destroy", [textureId](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                            // Swapchain textures are managed by the surface, but remove from registry
+                            g_textureRegistry.erase(textureId);
+                            return g_engine->newUndefined();
                         })
                     );
 
-                    g_engine->setProperty(device, "queue", queue);
-
-                    // device.limits - expose device limits
-                    auto deviceLimits = g_engine->newObject();
-                    g_engine->setProperty(deviceLimits, "maxTextureDimension2D", g_engine->newNumber(8192));
-                    g_engine->setProperty(deviceLimits, "maxColorAttachmentBytesPerSample", g_engine->newNumber(64));
-                    g_engine->setProperty(deviceLimits, "maxBindGroups", g_engine->newNumber(4));
-                    g_engine->setProperty(deviceLimits, "maxBindingsPerBindGroup", g_engine->newNumber(1000));
-                    g_engine->setProperty(deviceLimits, "maxUniformBufferBindingSize", g_engine->newNumber(65536));
-                    g_engine->setProperty(deviceLimits, "maxStorageBufferBindingSize", g_engine->newNumber(134217728));
-                    g_engine->setProperty(deviceLimits, "maxSampledTexturesPerShaderStage", g_engine->newNumber(16));
-                    g_engine->setProperty(deviceLimits, "maxSamplersPerShaderStage", g_engine->newNumber(16));
-                    g_engine->setProperty(deviceLimits, "maxStorageTexturesPerShaderStage", g_engine->newNumber(8));
-                    g_engine->setProperty(deviceLimits, "maxUniformBuffersPerShaderStage", g_engine->newNumber(12));
-                    g_engine->setProperty(deviceLimits, "maxStorageBuffersPerShaderStage", g_engine->newNumber(8));
-                    g_engine->setProperty(deviceLimits, "maxDynamicUniformBuffersPerPipelineLayout", g_engine->newNumber(8));
-                    g_engine->setProperty(deviceLimits, "minUniformBufferOffsetAlignment", g_engine->newNumber(256));
-                    g_engine->setProperty(deviceLimits, "minStorageBufferOffsetAlignment", g_engine->newNumber(256));
-                    g_engine->setProperty(device, "limits", deviceLimits);
+                    return jsTexture;
+                })
+            );
 
-                    // device.features - Set-like object with enabled features
-                    // These should match the features exposed in adapter.features that were requested
-                    auto deviceFeatures = g_engine->newArray(0);
-                    g_engine->setProperty(deviceFeatures, "has",
-                        g_engine->newFunction("has", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                            if (args.empty()) return g_engine->newBoolean(false);
-                            std::string featureName = g_engine->toString(args[0]);
-                            // indirect-first-instance enables non-zero firstInstance in indirect draws
-                            if (featureName == "indirect-first-instance") {
-                                return g_engine->newBoolean(true);
-                            }
-                            // timestamp-query is NOT supported yet - bindings not implemented
-                            return g_engine->newBoolean(false);
-                        })
-                    );
-                    g_engine->setProperty(device, "features", deviceFeatures);
+            if (g_verboseLogging) std::cout << "[Canvas] WebGPU context created" << std::endl;
+            return canvasContext;
+        })
+    );
 
-                    // device.createBuffer(descriptor)
-                    g_engine->setProperty(device, "createBuffer",
-                        g_engine->newFunction("createBuffer", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                            if (args.empty()) {
-                                g_engine->throwException("createBuffer requires a descriptor");
-                                return g_engine->newUndefined();
-                            }
+    // Set global canvas - this is the SAME object as document.getElementById('canvas')
+    // so it now has both WebGPU getContext AND event listener support
+    engine->setGlobalProperty("canvas", canvasObject);
 
-                            auto descriptor = args[0];
-                            double size = g_engine->toNumber(g_engine->getProperty(descriptor, "size"));
-                            double usage = g_engine->toNumber(g_engine->getProperty(descriptor, "usage"));
+    // ========================================================================
+    // Add missing methods to the existing document (from runtime.cpp)
+    // We DON'T create a new document - just augment the existing one
+    // ========================================================================
 
-                            // Check for mappedAtCreation
-                            auto mappedAtCreationProp = g_engine->getProperty(descriptor, "mappedAtCreation");
-                            bool mappedAtCreation = !g_engine->isUndefined(mappedAtCreationProp) && g_engine->toBoolean(mappedAtCreationProp);
+    // Add querySelector to existing document (if not present)
+    engine->setProperty(existingDocument, "querySelector",
+        engine->newFunction("querySelector", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            // Check if querying for canvas
+            if (!args.empty()) {
+                std::string selector = g_engine->toString(args[0]);
+                if (selector == "canvas" || selector.find("canvas") != std::string::npos) {
+                    return g_engine->getGlobalProperty("canvas");
+                }
+            }
+            return g_engine->newNull();
+        })
+    );
 
-                            WGPUBufferDescriptor bufferDesc = {};
-                            bufferDesc.size = (uint64_t)size;
-                            bufferDesc.usage = (WGPUBufferUsage)(uint32_t)usage;
-                            bufferDesc.mappedAtCreation = mappedAtCreation;
+    // Add createElement to existing document
+    // NOTE: runtime.cpp sets up a createElement with canvas support (toDataURL) for @loaders.gl WebP detection
+    // We ALWAYS override it here to add proper Canvas 2D support for offscreen canvases
+    engine->setProperty(existingDocument, "createElement",
+        engine->newFunction("createElement", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            auto element = g_engine->newObject();
 
-                            WGPUBuffer buffer = wgpuDeviceCreateBuffer(g_device, &bufferDesc);
-                            if (!buffer) {
-                                g_engine->throwException("Failed to create buffer");
-                                return g_engine->newUndefined();
-                            }
+            // Get tag name if provided
+            std::string tagName = "";
+            if (!args.empty()) {
+                tagName = g_engine->toString(args[0]);
+            }
 
-                            // Register buffer for mapping operations
-                            uint64_t bufferId = g_nextBufferId++;
-                            // mappedAtCreation buffers are mapped for write
-                            WGPUMapMode initialMapMode = mappedAtCreation ? WGPUMapMode_Write : WGPUMapMode_None;
-                            g_bufferRegistry[bufferId] = {buffer, (uint64_t)size, (WGPUBufferUsage)(uint32_t)usage, mappedAtCreation, nullptr, 0, initialMapMode};
+            // Add basic DOM element properties
+            g_engine->setProperty(element, "style", g_engine->newObject());
+            g_engine->setProperty(element, "className", g_engine->newString(""));
+            g_engine->setProperty(element, "innerHTML", g_engine->newString(""));
+            g_engine->setProperty(element, "textContent", g_engine->newString(""));
+            g_engine->setProperty(element, "tagName", g_engine->newString(tagName.c_str()));
+            g_engine->setProperty(element, "appendChild",
+                g_engine->newFunction("appendChild", [](void* c, const std::vector<js::JSValueHandle>& a) {
+                    return a.empty() ? g_engine->newUndefined() : a[0];
+                })
+            );
+            g_engine->setProperty(element, "removeChild",
+                g_engine->newFunction("removeChild", [](void* c, const std::vector<js::JSValueHandle>& a) {
+                    return a.empty() ? g_engine->newUndefined() : a[0];
+                })
+            );
+            g_engine->setProperty(element, "remove",
+                g_engine->newFunction("remove", [](void* c, const std::vector<js::JSValueHandle>& a) {
+                    // No-op in native runtime - element is not attached to DOM
+                    return g_engine->newUndefined();
+                })
+            );
+            g_engine->setProperty(element, "addEventListener",
+                g_engine->newFunction("addEventListener", [](void* c, const std::vector<js::JSValueHandle>& a) {
+                    // No-op in native runtime
+                    return g_engine->newUndefined();
+                })
+            );
+            g_engine->setProperty(element, "removeEventListener",
+                g_engine->newFunction("removeEventListener", [](void* c, const std::vector<js::JSValueHandle>& a) {
+                    return g_engine->newUndefined();
+                })
+            );
 
-                            auto jsBuffer = g_engine->newObject();
-                            g_engine->setPrivateData(jsBuffer, buffer);
-                            g_engine->setProperty(jsBuffer, "size", g_engine->newNumber(size));
-                            g_engine->setProperty(jsBuffer, "_bufferId", g_engine->newNumber((double)bufferId));
-                            g_engine->setProperty(jsBuffer, "usage", g_engine->newNumber(usage));
+            // Special handling for canvas elements - add Canvas 2D support
+            if (tagName == "canvas" || tagName == "CANVAS") {
+                // Create OffscreenCanvas struct to store state
+                int canvasId = g_nextOffscreenCanvasId++;
+                auto offscreenCanvas = std::make_unique<OffscreenCanvas>();
+                OffscreenCanvas* canvasPtr = offscreenCanvas.get();
+                g_offscreenCanvases[canvasId] = std::move(offscreenCanvas);
 
-                            // Set initial mapState
-                            g_engine->setProperty(jsBuffer, "mapState", g_engine->newString(mappedAtCreation ? "mapped" : "unmapped"));
+                // Store the canvas ID as private data for getContext lookup
+                g_engine->setPrivateData(element, reinterpret_cast<void*>(static_cast<intptr_t>(canvasId)));
 
-                            // buffer.mapAsync(mode, offset?, size?) -> Promise
-                            // Returns a Promise that resolves when the buffer is mapped
-                            g_engine->setProperty(jsBuffer, "mapAsync",
-                                g_engine->newFunction("mapAsync", [bufferId](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    auto it = g_bufferRegistry.find(bufferId);
-                                    if (it == g_bufferRegistry.end()) {
-                                        std::cerr << "[WebGPU] mapAsync: Buffer " << bufferId << " not found" << std::endl;
-                                        return g_engine->evalWithResult("Promise.reject(new Error('Buffer not found'))", "mapAsync-error");
-                                    }
+                // Also store as property for debugging
+                g_engine->setProperty(element, "_offscreenCanvasId", g_engine->newNumber(canvasId));
 
-                                    auto& bufferInfo = it->second;
+                // Default canvas dimensions (stored in struct)
+                g_engine->setProperty(element, "width", g_engine->newNumber(canvasPtr->width));
+                g_engine->setProperty(element, "height", g_engine->newNumber(canvasPtr->height));
 
-                                    // Already mapped (mappedAtCreation)?
-                                    if (bufferInfo.isMapped) {
-                                        return g_engine->evalWithResult("Promise.resolve()", "mapAsync-already-mapped");
-                                    }
+                // Store reference to element globally so getContext can find it
+                std::string globalName = "__offscreenCanvas_" + std::to_string(canvasId);
+                g_engine->setGlobalProperty(globalName.c_str(), element);
 
-                                    // Get mode (default to READ)
-                                    WGPUMapMode mode = WGPUMapMode_Read;
-                                    if (!args.empty()) {
-                                        uint32_t jsMode = (uint32_t)g_engine->toNumber(args[0]);
-                                        // GPUMapMode.READ = 1, GPUMapMode.WRITE = 2
-                                        if (jsMode == 2) mode = WGPUMapMode_Write;
-                                    }
+                // Create getContext function
+                // Capture canvasId to ensure each canvas element's getContext uses its own canvas
+                // This fixes the bug where all canvases shared the same context
+                auto getContextFn = g_engine->newFunction("getContext", [canvasId, canvasPtr](void* c, const std::vector<js::JSValueHandle>& contextArgs) {
+                    if (contextArgs.empty()) {
+                        return g_engine->newNull();
+                    }
 
-                                    uint64_t offset = args.size() > 1 ? (uint64_t)g_engine->toNumber(args[1]) : 0;
-                                    uint64_t mapSize = args.size() > 2 ? (uint64_t)g_engine->toNumber(args[2]) : bufferInfo.size;
+                    std::string contextType = g_engine->toString(contextArgs[0]);
 
-                                    // Debug: Log buffer info
-                                    bool hasMapRead = (bufferInfo.usage & WGPUBufferUsage_MapRead) != 0;
-                                    (void)hasMapRead;  // Used for debug logging when enabled
+                    // Use the captured canvasId to find the correct canvas
+                    // This ensures each canvas element's getContext returns its own context
+                    auto it = g_offscreenCanvases.find(canvasId);
+                    if (it == g_offscreenCanvases.end()) {
+                        std::cerr << "[Canvas] Canvas not found: " << canvasId << std::endl;
+                        return g_engine->newNull();
+                    }
 
-                                    // Ensure all pending GPU work is processed before attempting to map
-                                    // This is critical for buffers that were just used in a copy operation
-                                    for (int prePoll = 0; prePoll < 100; prePoll++) {
-#if defined(MYSTRAL_WEBGPU_WGPU)
-                                        wgpuDevicePoll(g_device, false, nullptr);
-#else
-                                        if (g_instance) {
-                                            wgpuInstanceProcessEvents(g_instance);
-                                        }
-                                        if (g_device) {
-                                            wgpuDeviceTick(g_device);
-                                        }
-#endif
-                                    }
+                    OffscreenCanvas* canvas = it->second.get();
 
-                                    // Synchronous mapping: use global callback + device poll
-                                    g_bufferMapData.completed = false;
-                                    g_bufferMapData.status = WGPUBufferMapAsyncStatus_Unknown_Compat;
-                                    g_bufferMapData.errorMessage.clear();
+                    if (contextType == "2d") {
+                        // Return cached context if already created
+                        if (canvas->hasContext2d) {
+                            return canvas->context2d;
+                        }
 
-#if WGPU_BUFFER_MAP_USES_CALLBACK_INFO
-                                    // Dawn uses CallbackInfo struct with 4-param callback
-                                    // Use AllowSpontaneous mode so callback can be invoked at any time
-                                    WGPUBufferMapCallbackInfo mapCallbackInfo = {};
-                                    mapCallbackInfo.mode = WGPUCallbackMode_AllowSpontaneous;
-                                    mapCallbackInfo.callback = onBufferMapped;
-                                    mapCallbackInfo.userdata1 = &g_bufferMapData;
-                                    mapCallbackInfo.userdata2 = nullptr;
+                        // Get current dimensions from the canvas element (in case they were changed)
+                        std::string globalName = "__offscreenCanvas_" + std::to_string(canvasId);
+                        auto canvasElement = g_engine->getGlobalProperty(globalName.c_str());
+                        if (!g_engine->isNull(canvasElement) && !g_engine->isUndefined(canvasElement)) {
+                            auto widthProp = g_engine->getProperty(canvasElement, "width");
+                            auto heightProp = g_engine->getProperty(canvasElement, "height");
+                            if (!g_engine->isUndefined(widthProp)) {
+                                canvas->width = static_cast<int>(g_engine->toNumber(widthProp));
+                            }
+                            if (!g_engine->isUndefined(heightProp)) {
+                                canvas->height = static_cast<int>(g_engine->toNumber(heightProp));
+                            }
+                        }
 
-                                    wgpuBufferMapAsync(bufferInfo.buffer, mode, offset, mapSize, mapCallbackInfo);
-#else
-                                    // wgpu-native uses separate callback and userdata
-                                    wgpuBufferMapAsync(bufferInfo.buffer, mode, offset, mapSize, onBufferMapped, &g_bufferMapData);
-#endif
-
-                                    // Poll device until mapping completes
-                                    // Add small sleep to avoid busy-looping and let GPU work complete
-                                    int pollCount = 0;
-                                    while (!g_bufferMapData.completed && pollCount < 10000) {
-#if defined(MYSTRAL_WEBGPU_WGPU)
-                                        wgpuDevicePoll(g_device, true, nullptr);
-#else
-                                        if (g_instance) {
-                                            wgpuInstanceProcessEvents(g_instance);
-                                        }
-                                        if (g_device) {
-                                            wgpuDeviceTick(g_device);
-                                        }
-#endif
-                                        // Small sleep every 100 iterations to avoid busy loop
-                                        if (pollCount % 100 == 0) {
-                                            std::this_thread::sleep_for(std::chrono::milliseconds(1));
-                                        }
-                                        pollCount++;
-                                    }
+                        // Create Canvas 2D context
+                        if (g_verboseLogging) std::cout << "[Canvas] Creating offscreen 2D context (" << canvas->width << "x" << canvas->height << ")" << std::endl;
+                        canvas->context2d = canvas::createCanvas2DContext(g_engine, canvas->width, canvas->height);
+                        canvas->hasContext2d = true;
+                        g_engine->protect(canvas->context2d);
+                        return canvas->context2d;
+                    }
 
-                                    if (g_bufferMapData.status == WGPUBufferMapAsyncStatus_Success_Compat) {
-                                        bufferInfo.isMapped = true;
-                                        bufferInfo.mapMode = mode;  // Store whether mapped for read or write
-                                        return g_engine->evalWithResult("Promise.resolve()", "mapAsync-success");
-                                    } else {
-                                        std::cerr << "[WebGPU] mapAsync: Failed with status " << g_bufferMapData.status;
-                                        if (!g_bufferMapData.errorMessage.empty()) {
-                                            std::cerr << " - " << g_bufferMapData.errorMessage;
-                                        }
-                                        std::cerr << std::endl;
-                                        return g_engine->evalWithResult("Promise.reject(new Error('Buffer map failed'))", "mapAsync-failed");
-                                    }
-                                })
-                            );
+                    if (contextType == "webgpu") {
+                        // Create GPUCanvasContext for offscreen canvas
+                        // This shares the main surface/device for simplicity
+                        if (g_verboseLogging) std::cout << "[Canvas] Creating offscreen WebGPU context" << std::endl;
 
-                            // buffer.getMappedRange(offset?, size?) -> ArrayBuffer
-                            // Capture bufferId in closure to identify the correct buffer
-                            g_engine->setProperty(jsBuffer, "getMappedRange",
-                                g_engine->newFunction("getMappedRange", [bufferId](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    // Look up this specific buffer by its ID
-                                    auto it = g_bufferRegistry.find(bufferId);
-                                    if (it == g_bufferRegistry.end()) {
-                                        std::cerr << "[WebGPU] getMappedRange: Buffer " << bufferId << " not found in registry" << std::endl;
-                                        return g_engine->newUndefined();
-                                    }
+                        // Suspend frame tracking - this context persists across frames
+                        g_engine->suspendFrameTracking();
 
-                                    auto& bufferInfo = it->second;
+                        auto canvasContext = g_engine->newObject();
 
-                                    if (!bufferInfo.isMapped && !bufferInfo.mappedData) {
-                                        if (g_verboseLogging) std::cerr << "[WebGPU] getMappedRange: Buffer " << bufferId << " is not mapped" << std::endl;
-                                        return g_engine->newUndefined();
-                                    }
+                        // Store reference to our surface
+                        g_engine->setPrivateData(canvasContext, g_surface);
 
-                                    uint64_t offset = args.empty() ? 0 : (uint64_t)g_engine->toNumber(args[0]);
-                                    uint64_t rangeSize = args.size() > 1 ? (uint64_t)g_engine->toNumber(args[1]) : bufferInfo.size - offset;
+                        // context.canvas - reference back to canvas element
+                        std::string globalName = "__offscreenCanvas_" + std::to_string(canvasId);
+                        auto canvasElement = g_engine->getGlobalProperty(globalName.c_str());
+                        g_engine->setProperty(canvasContext, "canvas", canvasElement);
 
-                                    // Use wgpuBufferGetConstMappedRange for MAP_READ, wgpuBufferGetMappedRange for MAP_WRITE
-                                    // Dawn requires the const version for read-only mapped buffers
-                                    const void* mappedData = nullptr;
-                                    if (bufferInfo.mapMode == WGPUMapMode_Read) {
-                                        mappedData = wgpuBufferGetConstMappedRange(bufferInfo.buffer, offset, rangeSize);
-                                    } else {
-                                        mappedData = wgpuBufferGetMappedRange(bufferInfo.buffer, offset, rangeSize);
-                                    }
+                        // context.configure({ device, format, alphaMode })
+                        g_engine->setProperty(canvasContext, "configure",
+                            g_engine->newFunction("configure", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                                if (args.empty()) {
+                                    g_engine->throwException("configure requires a descriptor");
+                                    return g_engine->newUndefined();
+                                }
+                                auto descriptor = args[0];
+                                std::string format = g_engine->toString(g_engine->getProperty(descriptor, "format"));
+                                g_surfaceFormat = stringToFormat(format);
+                                g_contextConfigured = true;
+                                if (g_verboseLogging) std::cout << "[Canvas] Offscreen context configured with format: " << format << std::endl;
+                                return g_engine->newUndefined();
+                            })
+                        );
 
-                                    if (mappedData) {
-                                        // Use newArrayBufferExternal to avoid copying
-                                        // Cast away const for read-only buffers - the JS side shouldn't modify but we need void*
-                                        return g_engine->newArrayBufferExternal(const_cast<void*>(mappedData), rangeSize);
-                                    }
+                        // context.unconfigure()
+                        g_engine->setProperty(canvasContext, "unconfigure",
+                            g_engine->newFunction("unconfigure", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                                return g_engine->newUndefined();
+                            })
+                        );
 
-                                    if (g_verboseLogging) std::cerr << "[WebGPU] getMappedRange: GetMappedRange returned null for buffer " << bufferId << std::endl;
+                        // context.getCurrentTexture() -> GPUTexture
+                        g_engine->setProperty(canvasContext, "getCurrentTexture",
+                            g_engine->newFunction("getCurrentTexture", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                                WGPUTexture texture = getCurrentSwapchainTexture();
+                                if (!texture) {
+                                    g_engine->throwException("Failed to get current texture");
                                     return g_engine->newUndefined();
-                                })
-                            );
+                                }
+                                g_currentTexture = texture;
+                                if (g_verboseLogging) std::cout << "[Canvas] Offscreen got texture: " << (void*)texture << std::endl;
 
-                            // buffer.unmap()
-                            // Capture bufferId in closure to identify the correct buffer
-                            g_engine->setProperty(jsBuffer, "unmap",
-                                g_engine->newFunction("unmap", [bufferId](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    // Look up this specific buffer by its ID
-                                    auto it = g_bufferRegistry.find(bufferId);
-                                    if (it == g_bufferRegistry.end()) {
-                                        std::cerr << "[WebGPU] unmap: Buffer " << bufferId << " not found in registry" << std::endl;
-                                        return g_engine->newUndefined();
-                                    }
+                                // Register in texture registry so createView can find it
+                                uint64_t textureId = g_nextTextureId++;
+                                g_textureRegistry[textureId] = {texture, g_surfaceFormat, g_canvasWidth, g_canvasHeight, 1, 1, WGPUTextureDimension_2D};
 
-                                    auto& bufferInfo = it->second;
-                                    if (bufferInfo.isMapped) {
-                                        wgpuBufferUnmap(bufferInfo.buffer);
-                                        bufferInfo.isMapped = false;
-                                        bufferInfo.mappedData = nullptr;
-                                        bufferInfo.mappedSize = 0;
-                                    }
-                                    return g_engine->newUndefined();
-                                })
-                            );
+                                // Suspend frame tracking for texture wrapper (persists until next frame)
+                                g_engine->suspendFrameTracking();
 
-                            // buffer.destroy()
-                            // Capture bufferId in closure to identify the correct buffer
-                            g_engine->setProperty(jsBuffer, "destroy",
-                                g_engine->newFunction("destroy", [bufferId](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    auto it = g_bufferRegistry.find(bufferId);
-                                    if (it != g_bufferRegistry.end()) {
-                                        wgpuBufferDestroy(it->second.buffer);
-                                        wgpuBufferRelease(it->second.buffer);
-                                        g_bufferRegistry.erase(it);
-                                    }
-                                    return g_engine->newUndefined();
-                                })
-                            );
+                                // Create JS wrapper for texture
+                                auto jsTexture = g_engine->newObject();
+                                g_engine->setPrivateData(jsTexture, texture);
 
-                            return jsBuffer;
-                        })
-                    );
+                                // texture.width / height / depthOrArrayLayers
+                                g_engine->setProperty(jsTexture, "width", g_engine->newNumber(g_canvasWidth));
+                                g_engine->setProperty(jsTexture, "height", g_engine->newNumber(g_canvasHeight));
+                                g_engine->setProperty(jsTexture, "depthOrArrayLayers", g_engine->newNumber(1));
 
-                    // device.createShaderModule(descriptor)
-                    g_engine->setProperty(device, "createShaderModule",
-                        g_engine->newFunction("createShaderModule", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                            if (args.empty()) {
-                                g_engine->throwException("createShaderModule requires a descriptor");
-                                return g_engine->newUndefined();
-                            }
+                                // texture.format
+                                g_engine->setProperty(jsTexture, "format", g_engine->newString(formatToString(g_surfaceFormat)));
+                                g_engine->setProperty(jsTexture, "_textureId", g_engine->newNumber((double)textureId));
 
-                            auto descriptor = args[0];
-                            std::string code = g_engine->toString(g_engine->getProperty(descriptor, "code"));
+                                // texture.createView(descriptor?) -> GPUTextureView
+                                // Capture textureId to look up the correct texture (not g_currentTexture which may change)
+                                g_engine->setProperty(jsTexture, "createView",
+                                    g_engine->newFunction("createView", [textureId](void* c, const std::vector<js::JSValueHandle>& a) {
+                                        // Look up texture from registry using captured textureId
+                                        auto it = g_textureRegistry.find(textureId);
+                                        if (it == g_textureRegistry.end()) {
+                                            std::cerr << "[WebGPU] Offscreen createView: Texture " << textureId << " not found in registry" << std::endl;
+                                            g_engine->throwException("Texture not found in registry");
+                                            return g_engine->newUndefined();
+                                        }
 
-                            // Debug: Print first 500 chars of shader code
-                            if (g_verboseLogging && code.length() > 0) {
-                                std::cout << "[Shader] Creating shader (" << code.length() << " chars):\n"
-                                          << code.substr(0, std::min((size_t)500, code.length()))
-                                          << (code.length() > 500 ? "\n..." : "") << std::endl;
-                            }
+                                        WGPUTexture texture = it->second.texture;
+                                        if (!texture) {
+                                            g_engine->throwException("No current texture");
+                                            return g_engine->newUndefined();
+                                        }
 
-                            WGPUShaderModuleWGSLDescriptor_Compat wgslDesc = {};
-                            WGPUShaderModuleDescriptor shaderDesc = {};
-                            setupShaderModuleWGSL(&shaderDesc, &wgslDesc, code.c_str());
+                                        WGPUTextureViewDescriptor viewDesc = {};
+                                        viewDesc.format = it->second.format;
+                                        viewDesc.dimension = WGPUTextureViewDimension_2D;
+                                        viewDesc.baseMipLevel = 0;
+                                        viewDesc.mipLevelCount = 1;
+                                        viewDesc.baseArrayLayer = 0;
+                                        viewDesc.arrayLayerCount = 1;
+                                        viewDesc.aspect = WGPUTextureAspect_All;
 
-                            WGPUShaderModule shaderModule = wgpuDeviceCreateShaderModule(g_device, &shaderDesc);
+                                        WGPUTextureView view = wgpuTextureCreateView(texture, &viewDesc);
+                                        g_currentTextureView = view;
+                                        g_currentViewSourceTexture = texture;  // Track which texture the view was created from
+                                        if (g_verboseLogging) std::cout << "[Canvas] Offscreen createView: texture=" << (void*)texture
+                                                  << ", view=" << (void*)view << std::endl;
 
-                            auto jsShader = g_engine->newObject();
-                            g_engine->setPrivateData(jsShader, shaderModule);
+                                        auto jsView = g_engine->newObject();
+                                        g_engine->setPrivateData(jsView, view);
+                                        g_engine->setProperty(jsView, "_type", g_engine->newString("textureView"));
 
-                            return jsShader;
-                        })
-                    );
+                                        return jsView;
+                                    })
+                                );
 
-                    // device.createRenderPipeline(descriptor)
-                    g_engine->setProperty(device, "createRenderPipeline",
-                        g_engine->newFunction("createRenderPipeline", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                            if (args.empty()) {
-                                g_engine->throwException("createRenderPipeline requires a descriptor");
-                                return g_engine->newUndefined();
-                            }
+                                // texture.destroy()
+                                g_engine->setProperty(jsTexture, "destroy",
+                                    g_engine->newFunction("destroy", [textureId](void* c, const std::vector<js::JSValueHandle>& a) {
+                                        // Swapchain textures are managed by the surface, but remove from registry
+                                        g_textureRegistry.erase(textureId);
+                                        return g_engine->newUndefined();
+                                    })
+                                );
 
-                            auto descriptor = args[0];
+                                // Resume frame tracking for texture
+                                g_engine->resumeFrameTracking();
 
-                            // Get vertex stage
-                            auto vertex = g_engine->getProperty(descriptor, "vertex");
-                            auto vertexModule = g_engine->getProperty(vertex, "module");
-                            std::string vertexEntry = g_engine->toString(g_engine->getProperty(vertex, "entryPoint"));
+                                return jsTexture;
+                            })
+                        );
 
-                            // Get fragment stage (optional - depth-only pipelines don't have fragment)
-                            auto fragment = g_engine->getProperty(descriptor, "fragment");
-                            WGPUShaderModule fsModule = nullptr;
-                            std::string fragmentEntry = "main";
-                            bool hasFragment = !g_engine->isUndefined(fragment) && !g_engine->isNull(fragment);
-                            if (hasFragment) {
-                                auto fragmentModule = g_engine->getProperty(fragment, "module");
-                                fsModule = (WGPUShaderModule)g_engine->getPrivateData(fragmentModule);
-                                auto fragEntryProp = g_engine->getProperty(fragment, "entryPoint");
-                                if (!g_engine->isUndefined(fragEntryProp)) {
-                                    fragmentEntry = g_engine->toString(fragEntryProp);
-                                }
-                            }
+                        // Resume frame tracking
+                        g_engine->resumeFrameTracking();
 
-                            // Get native shader modules
-                            WGPUShaderModule vsModule = (WGPUShaderModule)g_engine->getPrivateData(vertexModule);
+                        return canvasContext;
+                    }
 
-                            // Create pipeline descriptor
-                            WGPURenderPipelineDescriptor pipelineDesc = {};
+                    // Ignore webgl requests silently (PixiJS feature detection)
+                    if (contextType == "webgl" || contextType == "webgl2" || contextType == "experimental-webgl") {
+                        return g_engine->newNull();
+                    }
 
-                            // Check for layout property
-                            auto layoutProp = g_engine->getProperty(descriptor, "layout");
-                            if (!g_engine->isUndefined(layoutProp)) {
-                                // Check if it's "auto" string or a PipelineLayout object
-                                if (g_engine->isString(layoutProp)) {
-                                    std::string layoutStr = g_engine->toString(layoutProp);
-                                    if (layoutStr == "auto") {
-                                        pipelineDesc.layout = nullptr;  // Auto layout
-                                    }
-                                } else {
-                                    // It's a PipelineLayout object
-                                    WGPUPipelineLayout layout = (WGPUPipelineLayout)g_engine->getPrivateData(layoutProp);
-                                    pipelineDesc.layout = layout;
-                                }
-                            }
+                    std::cerr << "[Canvas] Unsupported context type: " << contextType << std::endl;
+                    return g_engine->newNull();
+                });
 
-                            // Vertex state
-                            pipelineDesc.vertex.module = vsModule;
-                            WGPU_SET_ENTRY_POINT(pipelineDesc.vertex, vertexEntry.c_str());
+                g_engine->setProperty(element, "getContext", getContextFn);
+                if (g_verboseLogging) std::cout << "[Canvas] Created offscreen canvas " << canvasId << std::endl;
 
-                            // Parse vertex buffers if present
-                            std::vector<WGPUVertexBufferLayout> vertexBuffers;
-                            std::vector<std::vector<WGPUVertexAttribute>> allAttributes; // Keep attributes alive
+                // toDataURL for compatibility (returns empty data URI)
+                g_engine->setProperty(element, "toDataURL",
+                    g_engine->newFunction("toDataURL", [](void* c, const std::vector<js::JSValueHandle>& a) {
+                        std::string mimeType = "image/png";
+                        if (!a.empty()) {
+                            mimeType = g_engine->toString(a[0]);
+                        }
+                        // Return a minimal data URI (for @loaders.gl WebP detection)
+                        if (mimeType.find("webp") != std::string::npos) {
+                            return g_engine->newString("data:image/webp;base64,");
+                        }
+                        return g_engine->newString("data:image/png;base64,");
+                    })
+                );
 
-                            auto buffersArray = g_engine->getProperty(vertex, "buffers");
-                            if (!g_engine->isUndefined(buffersArray)) {
-                                auto buffersLen = g_engine->getProperty(buffersArray, "length");
-                                int bufferCount = (int)g_engine->toNumber(buffersLen);
+                // getBoundingClientRect - return canvas dimensions
+                g_engine->setProperty(element, "getBoundingClientRect",
+                    g_engine->newFunction("getBoundingClientRect", [](void* c, const std::vector<js::JSValueHandle>& a) {
+                        // Get dimensions from the main canvas if available
+                        auto rect = g_engine->newObject();
+                        g_engine->setProperty(rect, "x", g_engine->newNumber(0));
+                        g_engine->setProperty(rect, "y", g_engine->newNumber(0));
+                        g_engine->setProperty(rect, "width", g_engine->newNumber(g_canvasWidth));
+                        g_engine->setProperty(rect, "height", g_engine->newNumber(g_canvasHeight));
+                        g_engine->setProperty(rect, "top", g_engine->newNumber(0));
+                        g_engine->setProperty(rect, "left", g_engine->newNumber(0));
+                        g_engine->setProperty(rect, "right", g_engine->newNumber(g_canvasWidth));
+                        g_engine->setProperty(rect, "bottom", g_engine->newNumber(g_canvasHeight));
+                        return rect;
+                    })
+                );
+            }
 
-                                for (int i = 0; i < bufferCount; i++) {
-                                    auto buffer = g_engine->getPropertyIndex(buffersArray, i);
+            return element;
+        })
+    );
 
-                                    WGPUVertexBufferLayout layout = {};
-                                    layout.arrayStride = (uint64_t)g_engine->toNumber(g_engine->getProperty(buffer, "arrayStride"));
-                                    layout.stepMode = WGPUVertexStepMode_Vertex;
+    // Add document.body if not present, or enhance existing body with required methods
+    auto existingBody = engine->getProperty(existingDocument, "body");
+    if (engine->isUndefined(existingBody) || engine->isNull(existingBody)) {
+        existingBody = engine->newObject();
+        engine->setProperty(existingDocument, "body", existingBody);
+    }
+    // Always add/update these methods on body
+    engine->setProperty(existingBody, "style", engine->newObject());
+    engine->setProperty(existingBody, "appendChild",
+        engine->newFunction("appendChild", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            return args.empty() ? g_engine->newUndefined() : args[0];
+        })
+    );
+    engine->setProperty(existingBody, "removeChild",
+        engine->newFunction("removeChild", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            return args.empty() ? g_engine->newUndefined() : args[0];
+        })
+    );
 
-                                    // Parse step mode if present
-                                    auto stepModeProp = g_engine->getProperty(buffer, "stepMode");
-                                    if (!g_engine->isUndefined(stepModeProp)) {
-                                        std::string stepModeStr = g_engine->toString(stepModeProp);
-                                        if (stepModeStr == "instance") {
-                                            layout.stepMode = WGPUVertexStepMode_Instance;
-                                        }
-                                    }
+    // ========================================================================
+    // Navigator object
+    // ========================================================================
+    auto navigatorHandle = engine->getGlobalProperty("navigator");
+    if (engine->isUndefined(navigatorHandle)) {
+        navigatorHandle = engine->newObject();
+        engine->setGlobalProperty("navigator", navigatorHandle);
+    }
 
-                                    // Parse attributes
-                                    auto attrsArray = g_engine->getProperty(buffer, "attributes");
-                                    if (!g_engine->isUndefined(attrsArray)) {
-                                        auto attrsLen = g_engine->getProperty(attrsArray, "length");
-                                        int attrCount = (int)g_engine->toNumber(attrsLen);
+    // Add common navigator properties for browser compatibility
+    // PixiJS and other libraries check these for feature detection
+    engine->setProperty(navigatorHandle, "userAgent",
+        engine->newString("Mozilla/5.0 (Macintosh; MystralNative/0.1) AppleWebKit/537.36 Chrome/120.0.0.0 Safari/537.36"));
+    engine->setProperty(navigatorHandle, "platform", engine->newString("MystralNative"));
+    engine->setProperty(navigatorHandle, "vendor", engine->newString("Mystral Engine"));
+    engine->setProperty(navigatorHandle, "language", engine->newString("en-US"));
+    engine->setProperty(navigatorHandle, "languages", engine->newArray(1));  // ["en-US"]
+    engine->setProperty(navigatorHandle, "onLine", engine->newBoolean(true));
+    engine->setProperty(navigatorHandle, "hardwareConcurrency", engine->newNumber(8));
+    engine->setProperty(navigatorHandle, "maxTouchPoints", engine->newNumber(0));
 
-                                        std::vector<WGPUVertexAttribute> attributes;
-                                        for (int j = 0; j < attrCount; j++) {
-                                            auto attr = g_engine->getPropertyIndex(attrsArray, j);
+    // Create navigator.gpu object
+    auto gpuObject = engine->newObject();
 
-                                            WGPUVertexAttribute va = {};
-                                            va.shaderLocation = (uint32_t)g_engine->toNumber(g_engine->getProperty(attr, "shaderLocation"));
-                                            va.offset = (uint64_t)g_engine->toNumber(g_engine->getProperty(attr, "offset"));
+    // ========================================================================
+    // navigator.gpu.requestAdapter()
+    // ========================================================================
+    engine->setProperty(gpuObject, "requestAdapter",
+        engine->newFunction("requestAdapter", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            // In native runtime, we already have an adapter, so just return a mock adapter object
+            auto adapter = g_engine->newObject();
 
-                                            std::string formatStr = g_engine->toString(g_engine->getProperty(attr, "format"));
-                                            // Parse vertex format
-                                            if (formatStr == "float32") va.format = WGPUVertexFormat_Float32;
-                                            else if (formatStr == "float32x2") va.format = WGPUVertexFormat_Float32x2;
-                                            else if (formatStr == "float32x3") va.format = WGPUVertexFormat_Float32x3;
-                                            else if (formatStr == "float32x4") va.format = WGPUVertexFormat_Float32x4;
-                                            else if (formatStr == "uint8x2") va.format = WGPUVertexFormat_Uint8x2;
-                                            else if (formatStr == "uint8x4") va.format = WGPUVertexFormat_Uint8x4;
-                                            else if (formatStr == "sint8x2") va.format = WGPUVertexFormat_Sint8x2;
-                                            else if (formatStr == "sint8x4") va.format = WGPUVertexFormat_Sint8x4;
-                                            else if (formatStr == "unorm8x2") va.format = WGPUVertexFormat_Unorm8x2;
-                                            else if (formatStr == "unorm8x4") va.format = WGPUVertexFormat_Unorm8x4;
-                                            else if (formatStr == "snorm8x2") va.format = WGPUVertexFormat_Snorm8x2;
-                                            else if (formatStr == "snorm8x4") va.format = WGPUVertexFormat_Snorm8x4;
-                                            else if (formatStr == "uint16x2") va.format = WGPUVertexFormat_Uint16x2;
-                                            else if (formatStr == "uint16x4") va.format = WGPUVertexFormat_Uint16x4;
-                                            else if (formatStr == "sint16x2") va.format = WGPUVertexFormat_Sint16x2;
-                                            else if (formatStr == "sint16x4") va.format = WGPUVertexFormat_Sint16x4;
-                                            else if (formatStr == "unorm16x2") va.format = WGPUVertexFormat_Unorm16x2;
-                                            else if (formatStr == "unorm16x4") va.format = WGPUVertexFormat_Unorm16x4;
-                                            else if (formatStr == "snorm16x2") va.format = WGPUVertexFormat_Snorm16x2;
-                                            else if (formatStr == "snorm16x4") va.format = WGPUVertexFormat_Snorm16x4;
-                                            else if (formatStr == "float16x2") va.format = WGPUVertexFormat_Float16x2;
-                                            else if (formatStr == "float16x4") va.format = WGPUVertexFormat_Float16x4;
-                                            else if (formatStr == "uint32") va.format = WGPUVertexFormat_Uint32;
-                                            else if (formatStr == "uint32x2") va.format = WGPUVertexFormat_Uint32x2;
-                                            else if (formatStr == "uint32x3") va.format = WGPUVertexFormat_Uint32x3;
-                                            else if (formatStr == "uint32x4") va.format = WGPUVertexFormat_Uint32x4;
-                                            else if (formatStr == "sint32") va.format = WGPUVertexFormat_Sint32;
-                                            else if (formatStr == "sint32x2") va.format = WGPUVertexFormat_Sint32x2;
-                                            else if (formatStr == "sint32x3") va.format = WGPUVertexFormat_Sint32x3;
-                                            else if (formatStr == "sint32x4") va.format = WGPUVertexFormat_Sint32x4;
-                                            else va.format = WGPUVertexFormat_Float32x3; // Default
+            // adapter.requestDevice()
+            g_engine->setProperty(adapter, "requestDevice",
+                g_engine->newFunction("requestDevice", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                    // Return a device object wrapping our native device
+                    auto device = g_engine->newObject();
+                    g_engine->setPrivateData(device, g_device);
 
-                                            attributes.push_back(va);
-                                        }
+                    // device.queue
+                    auto queue = g_engine->newObject();
+                    g_engine->setPrivateData(queue, g_queue);
 
-                                        allAttributes.push_back(attributes);
-                                        layout.attributeCount = attributes.size();
-                                        layout.attributes = allAttributes.back().data();
-                                    }
+                    // queue.submit(commandBuffers)
+                    g_engine->setProperty(queue, "submit",
+                        g_engine->newFunction("submit", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                            MYSTRAL_TRACE_SCOPE_CAT("gpu.submit", "webgpu");
+                            if (args.empty()) {
+                                return g_engine->newUndefined();
+                            }
 
-                                    vertexBuffers.push_back(layout);
+                            // Get command buffers array and submit them
+                            auto cmdBuffersArray = args[0];
+
+                            // Get array length
+                            auto lengthProp = g_engine->getProperty(cmdBuffersArray, "length");
+                            int length = (int)g_engine->toNumber(lengthProp);
+
+                            // Collect command buffers. Each can be submitted once: submit consumes
+                            // its reference and empties the wrapper, as does posting it to a worker.
+                            std::vector<WGPUCommandBuffer> cmdBuffers;
+                            std::vector<js::JSValueHandle> cmdBufferHandles;
+                            for (int i = 0; i < length; i++) {
+                                auto cmdBufferHandle = g_engine->getPropertyIndex(cmdBuffersArray, i);
+                                WGPUCommandBuffer cmdBuffer = (WGPUCommandBuffer)g_engine->getPrivateData(cmdBufferHandle);
+                                bool duplicate = std::find(cmdBuffers.begin(), cmdBuffers.end(), cmdBuffer) != cmdBuffers.end();
+                                if (!cmdBuffer || duplicate) {
+                                    if (!g_engine->isObject(cmdBufferHandle)) continue;
+                                    g_engine->throwException("submit: command buffer was already submitted or transferred");
+                                    return g_engine->newUndefined();
                                 }
+                                cmdBuffers.push_back(cmdBuffer);
+                                cmdBufferHandles.push_back(cmdBufferHandle);
+                            }
 
-                                pipelineDesc.vertex.bufferCount = vertexBuffers.size();
-                                pipelineDesc.vertex.buffers = vertexBuffers.data();
+                            // Submit user command buffers first
+                            static int submitCount = 0;
+                            submitCount++;
+                            if (!cmdBuffers.empty() && g_queue) {
+                                wgpuQueueSubmit(g_queue, cmdBuffers.size(), cmdBuffers.data());
+                                g_submits.fetch_add(1, std::memory_order_relaxed);
+                                // Release command buffers after submission (they're consumed by submit)
+                                for (auto cmdBuf : cmdBuffers) {
+                                    wgpuCommandBufferRelease(cmdBuf);
+                                }
+                                for (auto cmdBufferHandle : cmdBufferHandles) {
+                                    g_engine->setPrivateData(cmdBufferHandle, nullptr);
+                                }
+                                // Tick to flush GPU work
+#if defined(MYSTRAL_WEBGPU_DAWN)
+                                wgpuDeviceTick(g_device);
+#elif defined(MYSTRAL_WEBGPU_WGPU)
+                                wgpuDevicePoll(g_device, false, nullptr);
+#endif
+                                if (g_verboseLogging) std::cout << "[WebGPU] Submit #" << submitCount << ": " << cmdBuffers.size() << " command buffers, g_currentTexture=" << (void*)g_currentTexture << std::endl;
+                            } else {
+                                if (g_verboseLogging) std::cout << "[WebGPU] Submit #" << submitCount << ": EMPTY (length=" << length << "), g_currentTexture=" << (void*)g_currentTexture << std::endl;
                             }
 
-                            // Fragment state (only if fragment shader exists)
-                            WGPUColorTargetState colorTarget = {};
-                            WGPUFragmentState fragmentState = {};
-                            std::vector<WGPUColorTargetState> colorTargets;
-                            bool targetsExplicitlySpecified = false;
-                            if (hasFragment && fsModule) {
-                                // Parse targets from fragment descriptor
-                                auto targetsProp = g_engine->getProperty(fragment, "targets");
-                                if (!g_engine->isUndefined(targetsProp)) {
-                                    targetsExplicitlySpecified = true;  // Even if empty array
-                                    auto targetsLen = g_engine->getProperty(targetsProp, "length");
-                                    int targetCount = (int)g_engine->toNumber(targetsLen);
-                                    for (int i = 0; i < targetCount; i++) {
-                                        auto target = g_engine->getPropertyIndex(targetsProp, i);
-                                        WGPUColorTargetState targetState = {};
+                            // Copy texture to screenshot buffer ONLY when about to present
+                            // This prevents capturing intermediate render passes (e.g., Three.js post-processing)
+                            // Only capture when the surface render pass has ended, matching the present condition
+                            // Also ensure we only capture once per frame (Three.js does multiple queue.submit() per frame)
+                            WGPUTexture screenshotTexture = g_currentViewSourceTexture ? g_currentViewSourceTexture : g_currentTexture;
+                            if (g_surfaceRenderPassEnded && !g_screenshotCapturedThisFrame && screenshotTexture && g_device && g_queue) {
+                                // Calculate buffer requirements
+                                uint32_t bytesPerPixel = 4;  // BGRA8
+                                uint32_t unalignedBytesPerRow = g_canvasWidth * bytesPerPixel;
+                                uint32_t bytesPerRow = (unalignedBytesPerRow + 255) & ~255;  // Align to 256
+                                size_t requiredSize = bytesPerRow * g_canvasHeight;
 
-                                        auto formatProp = g_engine->getProperty(target, "format");
-                                        if (!g_engine->isUndefined(formatProp)) {
-                                            std::string formatStr = g_engine->toString(formatProp);
-                                            targetState.format = stringToFormat(formatStr);
-                                            if (targetCount >= 5) {
-                                                if (g_verboseLogging) std::cout << "[WebGPU] Pipeline target " << i << ": format=" << formatStr << " (enum=" << targetState.format << ")" << std::endl;
-                                            }
-                                        } else {
-                                            targetState.format = g_surfaceFormat;
-                                        }
-                                        targetState.writeMask = WGPUColorWriteMask_All;
+                                // Create or resize screenshot buffer if needed
+                                if (!g_screenshotBuffer || g_screenshotBufferSize < requiredSize) {
+                                    if (g_screenshotBuffer) {
+                                        wgpuBufferDestroy(g_screenshotBuffer);
+                                        wgpuBufferRelease(g_screenshotBuffer);
+                                    }
 
-                                        // Parse blend state if provided
-                                        auto blendProp = g_engine->getProperty(target, "blend");
-                                        if (!g_engine->isUndefined(blendProp)) {
-                                            // Store blend state in a persistent container
-                                            static std::vector<std::unique_ptr<WGPUBlendState>> blendStates;
-                                            auto blendState = std::make_unique<WGPUBlendState>();
+                                    WGPUBufferDescriptor bufferDesc = {};
+                                    bufferDesc.size = requiredSize;
+                                    bufferDesc.usage = WGPUBufferUsage_CopyDst | WGPUBufferUsage_MapRead;
+                                    bufferDesc.mappedAtCreation = false;
 
-                                            // Helper lambda to parse blend factor
-                                            auto parseBlendFactor = [](const std::string& str) -> WGPUBlendFactor {
-                                                if (str == "zero") return WGPUBlendFactor_Zero;
-                                                if (str == "one") return WGPUBlendFactor_One;
-                                                if (str == "src") return WGPUBlendFactor_Src;
-                                                if (str == "one-minus-src") return WGPUBlendFactor_OneMinusSrc;
-                                                if (str == "src-alpha") return WGPUBlendFactor_SrcAlpha;
-                                                if (str == "one-minus-src-alpha") return WGPUBlendFactor_OneMinusSrcAlpha;
-                                                if (str == "dst") return WGPUBlendFactor_Dst;
-                                                if (str == "one-minus-dst") return WGPUBlendFactor_OneMinusDst;
-                                                if (str == "dst-alpha") return WGPUBlendFactor_DstAlpha;
-                                                if (str == "one-minus-dst-alpha") return WGPUBlendFactor_OneMinusDstAlpha;
-                                                if (str == "src-alpha-saturated") return WGPUBlendFactor_SrcAlphaSaturated;
-                                                if (str == "constant") return WGPUBlendFactor_Constant;
-                                                if (str == "one-minus-constant") return WGPUBlendFactor_OneMinusConstant;
-                                                return WGPUBlendFactor_One;  // Default
-                                            };
+                                    g_screenshotBuffer = wgpuDeviceCreateBuffer(g_device, &bufferDesc);
+                                    g_screenshotBufferSize = requiredSize;
+                                    g_screenshotBytesPerRow = bytesPerRow;
+                                }
 
-                                            // Helper lambda to parse blend operation
-                                            auto parseBlendOp = [](const std::string& str) -> WGPUBlendOperation {
-                                                if (str == "add") return WGPUBlendOperation_Add;
-                                                if (str == "subtract") return WGPUBlendOperation_Subtract;
-                                                if (str == "reverse-subtract") return WGPUBlendOperation_ReverseSubtract;
-                                                if (str == "min") return WGPUBlendOperation_Min;
-                                                if (str == "max") return WGPUBlendOperation_Max;
-                                                return WGPUBlendOperation_Add;  // Default
-                                            };
+                                // Create encoder to copy texture to buffer
+                                WGPUCommandEncoderDescriptor encDesc = {};
+                                WGPUCommandEncoder copyEncoder = wgpuDeviceCreateCommandEncoder(g_device, &encDesc);
 
-                                            // Parse color blend component
-                                            auto colorProp = g_engine->getProperty(blendProp, "color");
-                                            if (!g_engine->isUndefined(colorProp)) {
-                                                auto srcFactor = g_engine->getProperty(colorProp, "srcFactor");
-                                                auto dstFactor = g_engine->getProperty(colorProp, "dstFactor");
-                                                auto operation = g_engine->getProperty(colorProp, "operation");
-                                                if (!g_engine->isUndefined(srcFactor))
-                                                    blendState->color.srcFactor = parseBlendFactor(g_engine->toString(srcFactor));
-                                                else
-                                                    blendState->color.srcFactor = WGPUBlendFactor_One;
-                                                if (!g_engine->isUndefined(dstFactor))
-                                                    blendState->color.dstFactor = parseBlendFactor(g_engine->toString(dstFactor));
-                                                else
-                                                    blendState->color.dstFactor = WGPUBlendFactor_Zero;
-                                                if (!g_engine->isUndefined(operation))
-                                                    blendState->color.operation = parseBlendOp(g_engine->toString(operation));
-                                                else
-                                                    blendState->color.operation = WGPUBlendOperation_Add;
-                                            } else {
-                                                // Default color blend (no blending)
-                                                blendState->color.srcFactor = WGPUBlendFactor_One;
-                                                blendState->color.dstFactor = WGPUBlendFactor_Zero;
-                                                blendState->color.operation = WGPUBlendOperation_Add;
-                                            }
+                                WGPUImageCopyTexture_Compat srcCopy = {};
+                                srcCopy.texture = screenshotTexture;
+                                srcCopy.mipLevel = 0;
+                                srcCopy.origin = {0, 0, 0};
+                                srcCopy.aspect = WGPUTextureAspect_All;
 
-                                            // Parse alpha blend component
-                                            auto alphaProp = g_engine->getProperty(blendProp, "alpha");
-                                            if (!g_engine->isUndefined(alphaProp)) {
-                                                auto srcFactor = g_engine->getProperty(alphaProp, "srcFactor");
-                                                auto dstFactor = g_engine->getProperty(alphaProp, "dstFactor");
-                                                auto operation = g_engine->getProperty(alphaProp, "operation");
-                                                if (!g_engine->isUndefined(srcFactor))
-                                                    blendState->alpha.srcFactor = parseBlendFactor(g_engine->toString(srcFactor));
-                                                else
-                                                    blendState->alpha.srcFactor = WGPUBlendFactor_One;
-                                                if (!g_engine->isUndefined(dstFactor))
-                                                    blendState->alpha.dstFactor = parseBlendFactor(g_engine->toString(dstFactor));
-                                                else
-                                                    blendState->alpha.dstFactor = WGPUBlendFactor_Zero;
-                                                if (!g_engine->isUndefined(operation))
-                                                    blendState->alpha.operation = parseBlendOp(g_engine->toString(operation));
-                                                else
-                                                    blendState->alpha.operation = WGPUBlendOperation_Add;
-                                            } else {
-                                                // Default alpha blend (no blending)
-                                                blendState->alpha.srcFactor = WGPUBlendFactor_One;
-                                                blendState->alpha.dstFactor = WGPUBlendFactor_Zero;
-                                                blendState->alpha.operation = WGPUBlendOperation_Add;
-                                            }
+                                WGPUImageCopyBuffer_Compat dstCopy = {};
+                                dstCopy.buffer = g_screenshotBuffer;
+                                dstCopy.layout.offset = 0;
+                                dstCopy.layout.bytesPerRow = bytesPerRow;
+                                dstCopy.layout.rowsPerImage = g_canvasHeight;
+
+                                WGPUExtent3D copySize = {g_canvasWidth, g_canvasHeight, 1};
+                                wgpuCommandEncoderCopyTextureToBuffer(copyEncoder, &srcCopy, &dstCopy, &copySize);
+
+                                if (g_verboseLogging) std::cout << "[Screenshot] Copying from texture " << (void*)screenshotTexture
+                                          << " (format=" << g_surfaceFormat << ", size=" << g_canvasWidth << "x" << g_canvasHeight << ")" << std::endl;
+
+                                WGPUCommandBufferDescriptor cmdDesc = {};
+                                WGPUCommandBuffer copyCmd = wgpuCommandEncoderFinish(copyEncoder, &cmdDesc);
+                                wgpuQueueSubmit(g_queue, 1, &copyCmd);
+
+                                wgpuCommandBufferRelease(copyCmd);
+                                wgpuCommandEncoderRelease(copyEncoder);
+
+                                // Wait for GPU work to complete before present
+                                // This ensures the screenshot copy finishes before the texture is released
+                                for (int syncIter = 0; syncIter < 100; syncIter++) {
+#if defined(MYSTRAL_WEBGPU_DAWN)
+                                    wgpuDeviceTick(g_device);
+                                    if (g_instance) {
+                                        wgpuInstanceProcessEvents(g_instance);
+                                    }
+#elif defined(MYSTRAL_WEBGPU_WGPU)
+                                    // wgpu-native: use wgpuDevicePoll to flush GPU work
+                                    wgpuDevicePoll(g_device, false, nullptr);
+#endif
+                                }
+
+                                g_screenshotReady = true;
+                                g_screenshotCapturedThisFrame = true;
+                            }
+
+                            // Present the surface only if:
+                            // 1. We have a current texture
+                            // 2. The surface render pass has been ended (commands submitted)
+                            // This prevents presenting before the render commands are in this submit
+                            if (g_surface && g_currentTexture && g_surfaceRenderPassEnded) {
+                                if (g_verboseLogging) std::cout << "[WebGPU] Presenting surface" << std::endl;
+                                wgpuSurfacePresent(g_surface);
+
+                                // Reset surface render tracking for next frame
+                                g_surfaceRenderEncoder = nullptr;
+                                g_surfaceRenderPassEnded = false;
+                                g_screenshotCapturedThisFrame = false;
+
+                                // Release the texture view if we created one
+                                if (g_currentTextureView) {
+                                    wgpuTextureViewRelease(g_currentTextureView);
+                                    g_currentTextureView = nullptr;
+                                }
+
+                                // Null out the textures since they're now invalid after present
+                                g_currentTexture = nullptr;
+                                g_currentViewSourceTexture = nullptr;
+                            }
+
+                            return g_engine->newUndefined();
+                        })
+                    );
+
+                    // queue.writeBuffer(buffer, offset, data, dataOffset?, size?)
+                    g_engine->setProperty(queue, "writeBuffer",
+                        g_engine->newFunction("writeBuffer", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                            MYSTRAL_TRACE_SCOPE_CAT("gpu.writeBuffer", "webgpu");
+                            if (args.size() < 3) {
+                                g_engine->throwException("writeBuffer requires buffer, offset, and data");
+                                return g_engine->newUndefined();
+                            }
+
+                            WGPUBuffer buffer = (WGPUBuffer)g_engine->getPrivateData(args[0]);
+                            uint64_t offset = (uint64_t)g_engine->toNumber(args[1]);
+
+                            // Get ArrayBuffer data
+                            size_t dataSize = 0;
+                            void* dataPtr = g_engine->getArrayBufferData(args[2], &dataSize);
+
+                            if (!dataPtr || dataSize == 0) {
+                                g_engine->throwException("writeBuffer: invalid data");
+                                return g_engine->newUndefined();
+                            }
+
+                            // Optional dataOffset and size
+                            size_t dataOffset = args.size() > 3 ? (size_t)g_engine->toNumber(args[3]) : 0;
+                            size_t writeSize = args.size() > 4 ? (size_t)g_engine->toNumber(args[4]) : (dataSize - dataOffset);
+
+                            if (buffer && g_queue) {
+                                wgpuQueueWriteBuffer(g_queue, buffer, offset, (uint8_t*)dataPtr + dataOffset, writeSize);
+                            }
+
+                            return g_engine->newUndefined();
+                        })
+                    );
+
+                    // queue.writeTexture(destination, data, dataLayout, size)
+                    g_engine->setProperty(queue, "writeTexture",
+                        g_engine->newFunction("writeTexture", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                            MYSTRAL_TRACE_SCOPE_CAT("gpu.writeTexture", "webgpu");
+                            if (args.size() < 4) {
+                                g_engine->throwException("writeTexture requires destination, data, dataLayout, and size");
+                                return g_engine->newUndefined();
+                            }
+
+                            // Parse destination {texture, mipLevel?, origin?, aspect?}
+                            auto destination = args[0];
+                            auto textureHandle = g_engine->getProperty(destination, "texture");
+                            WGPUTexture texture = (WGPUTexture)g_engine->getPrivateData(textureHandle);
+
+                            if (!texture) {
+                                g_engine->throwException("writeTexture: invalid texture");
+                                return g_engine->newUndefined();
+                            }
+
+                            auto mipLevelVal = g_engine->getProperty(destination, "mipLevel");
+                            uint32_t mipLevel = g_engine->isUndefined(mipLevelVal) ? 0 : (uint32_t)g_engine->toNumber(mipLevelVal);
+
+                            // Parse origin
+                            auto originVal = g_engine->getProperty(destination, "origin");
+                            uint32_t originX = 0, originY = 0, originZ = 0;
+                            if (!g_engine->isUndefined(originVal)) {
+                                auto lengthProp = g_engine->getProperty(originVal, "length");
+                                if (!g_engine->isUndefined(lengthProp)) {
+                                    // Array format
+                                    int len = (int)g_engine->toNumber(lengthProp);
+                                    if (len >= 1) originX = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originVal, 0));
+                                    if (len >= 2) originY = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originVal, 1));
+                                    if (len >= 3) originZ = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originVal, 2));
+                                } else {
+                                    // Object format
+                                    auto x = g_engine->getProperty(originVal, "x");
+                                    auto y = g_engine->getProperty(originVal, "y");
+                                    auto z = g_engine->getProperty(originVal, "z");
+                                    if (!g_engine->isUndefined(x)) originX = (uint32_t)g_engine->toNumber(x);
+                                    if (!g_engine->isUndefined(y)) originY = (uint32_t)g_engine->toNumber(y);
+                                    if (!g_engine->isUndefined(z)) originZ = (uint32_t)g_engine->toNumber(z);
+                                }
+                            }
+
+                            // Get ArrayBuffer data
+                            size_t dataSize = 0;
+                            void* dataPtr = g_engine->getArrayBufferData(args[1], &dataSize);
+
+                            if (!dataPtr || dataSize == 0) {
+                                g_engine->throwException("writeTexture: invalid data");
+                                return g_engine->newUndefined();
+                            }
+
+                            // Parse size FIRST (need height for rowsPerImage default)
+                            auto sizeVal = args[3];
+                            uint32_t width = 1, height = 1, depthOrArrayLayers = 1;
+                            auto lengthProp = g_engine->getProperty(sizeVal, "length");
+                            if (!g_engine->isUndefined(lengthProp)) {
+                                int len = (int)g_engine->toNumber(lengthProp);
+                                if (len >= 1) width = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeVal, 0));
+                                if (len >= 2) height = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeVal, 1));
+                                if (len >= 3) depthOrArrayLayers = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeVal, 2));
+                            } else {
+                                auto w = g_engine->getProperty(sizeVal, "width");
+                                auto h = g_engine->getProperty(sizeVal, "height");
+                                auto d = g_engine->getProperty(sizeVal, "depthOrArrayLayers");
+                                if (!g_engine->isUndefined(w)) width = (uint32_t)g_engine->toNumber(w);
+                                if (!g_engine->isUndefined(h)) height = (uint32_t)g_engine->toNumber(h);
+                                if (!g_engine->isUndefined(d)) depthOrArrayLayers = (uint32_t)g_engine->toNumber(d);
+                            }
+
+                            // Parse dataLayout {offset?, bytesPerRow, rowsPerImage?}
+                            auto dataLayout = args[2];
+                            auto layoutOffsetVal = g_engine->getProperty(dataLayout, "offset");
+                            uint64_t layoutOffset = g_engine->isUndefined(layoutOffsetVal) ? 0 : (uint64_t)g_engine->toNumber(layoutOffsetVal);
+
+                            uint32_t bytesPerRow = (uint32_t)g_engine->toNumber(g_engine->getProperty(dataLayout, "bytesPerRow"));
+
+                            auto rowsPerImageVal = g_engine->getProperty(dataLayout, "rowsPerImage");
+                            // rowsPerImage must be >= height for 2D textures (wgpu validation requirement)
+                            uint32_t rowsPerImage = g_engine->isUndefined(rowsPerImageVal) ? height : (uint32_t)g_engine->toNumber(rowsPerImageVal);
+                            if (rowsPerImage == 0) rowsPerImage = height;
+
+                            // Create copy structures
+                            WGPUImageCopyTexture_Compat destCopy = {};
+                            destCopy.texture = texture;
+                            destCopy.mipLevel = mipLevel;
+                            destCopy.origin = {originX, originY, originZ};
+                            destCopy.aspect = WGPUTextureAspect_All;
+
+                            WGPUTextureDataLayout_Compat layout = {};
+                            layout.offset = layoutOffset;
+                            layout.bytesPerRow = bytesPerRow;
+                            layout.rowsPerImage = rowsPerImage;
+
+                            WGPUExtent3D copySize = {width, height, depthOrArrayLayers};
+
+                            // Write texture
+                            wgpuQueueWriteTexture(g_queue, &destCopy, (uint8_t*)dataPtr + layoutOffset, dataSize - layoutOffset, &layout, &copySize);
+
+                            if (g_verboseLogging) std::cout << "[WebGPU] writeTexture: " << width << "x" << height << " (" << dataSize << " bytes)" << std::endl;
+
+                            return g_engine->newUndefined();
+                        })
+                    );
+
+                    // queue.copyExternalImageToTexture(source, destination, copySize)
+                    // Standard WebGPU way to upload ImageBitmap to texture
+                    g_engine->setProperty(queue, "copyExternalImageToTexture",
+                        g_engine->newFunction("copyExternalImageToTexture", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                            if (args.size() < 3) {
+                                g_engine->throwException("copyExternalImageToTexture requires source, destination, and copySize");
+                                return g_engine->newUndefined();
+                            }
+
+                            // Parse source (ImageBitmap-like object or canvas element)
+                            auto source = args[0];
+                            auto sourceObj = g_engine->getProperty(source, "source");
+                            if (g_engine->isUndefined(sourceObj)) {
+                                sourceObj = source; // source might be passed directly
+                            }
 
-                                            targetState.blend = blendState.get();
-                                            blendStates.push_back(std::move(blendState));
+                            // Parse flipY option (default false per WebGPU spec)
+                            bool flipY = false;
+                            auto flipYProp = g_engine->getProperty(source, "flipY");
+                            if (!g_engine->isUndefined(flipYProp)) {
+                                flipY = g_engine->toBoolean(flipYProp);
+                            }
 
-                                            if (g_verboseLogging) std::cout << "[WebGPU] Pipeline target " << i << " has blend state" << std::endl;
-                                        }
+                            int imgWidth = 0;
+                            int imgHeight = 0;
+                            size_t dataSize = 0;
+                            void* dataPtr = nullptr;
 
-                                        colorTargets.push_back(targetState);
+                            // Try to get data from ImageBitmap
+                            auto imageData = g_engine->getProperty(sourceObj, "_data");
+                            if (!g_engine->isUndefined(imageData)) {
+                                // Standard ImageBitmap with _data
+                                imgWidth = (int)g_engine->toNumber(g_engine->getProperty(sourceObj, "width"));
+                                imgHeight = (int)g_engine->toNumber(g_engine->getProperty(sourceObj, "height"));
+                                dataPtr = g_engine->getArrayBufferData(imageData, &dataSize);
+                            } else {
+                                // Check if it's a canvas element
+                                auto tagName = g_engine->getProperty(sourceObj, "tagName");
+                                std::string tagNameStr = g_engine->isUndefined(tagName) ? "" : g_engine->toString(tagName);
+
+                                if (tagNameStr == "CANVAS" || tagNameStr == "canvas") {
+                                    // Get the canvas ID from private data or property
+                                    auto canvasIdProp = g_engine->getProperty(sourceObj, "_offscreenCanvasId");
+                                    if (!g_engine->isUndefined(canvasIdProp)) {
+                                        int canvasId = (int)g_engine->toNumber(canvasIdProp);
+                                        auto it = g_offscreenCanvases.find(canvasId);
+                                        if (it != g_offscreenCanvases.end() && it->second->hasContext2d) {
+                                            // Get pixel data from the 2D context
+                                            auto ctx2dHandle = it->second->context2d;
+                                            auto nativeCtx = static_cast<canvas::Canvas2DContext*>(g_engine->getPrivateData(ctx2dHandle));
+                                            if (nativeCtx) {
+                                                imgWidth = it->second->width;
+                                                imgHeight = it->second->height;
+                                                dataPtr = const_cast<void*>(static_cast<const void*>(nativeCtx->getPixelData()));
+                                                dataSize = nativeCtx->getPixelDataSize();
+                                            }
+                                        }
                                     }
                                 }
-                                // Only add default target if targets wasn't explicitly specified
-                                // If targets: [] was specified, don't add any (depth-only pass)
-                                if (colorTargets.empty() && !targetsExplicitlySpecified) {
-                                    // Default single target only when targets is not specified at all
-                                    colorTarget.format = g_surfaceFormat;
-                                    colorTarget.writeMask = WGPUColorWriteMask_All;
-                                    colorTargets.push_back(colorTarget);
+
+                                // Check if it's already a 2D context (has getImageData method or _contextType)
+                                auto contextType = g_engine->getProperty(sourceObj, "_contextType");
+                                if (!g_engine->isUndefined(contextType)) {
+                                    std::string ctxTypeStr = g_engine->toString(contextType);
+                                    if (ctxTypeStr == "2d") {
+                                        // It's a 2D context, get the canvas and then get pixel data
+                                        auto canvas = g_engine->getProperty(sourceObj, "canvas");
+                                        if (!g_engine->isUndefined(canvas)) {
+                                            auto canvasIdProp = g_engine->getProperty(canvas, "_offscreenCanvasId");
+                                            if (!g_engine->isUndefined(canvasIdProp)) {
+                                                int canvasId = (int)g_engine->toNumber(canvasIdProp);
+                                                auto it = g_offscreenCanvases.find(canvasId);
+                                                if (it != g_offscreenCanvases.end() && it->second->hasContext2d) {
+                                                    auto nativeCtx = static_cast<canvas::Canvas2DContext*>(g_engine->getPrivateData(sourceObj));
+                                                    if (nativeCtx) {
+                                                        imgWidth = it->second->width;
+                                                        imgHeight = it->second->height;
+                                                        dataPtr = const_cast<void*>(static_cast<const void*>(nativeCtx->getPixelData()));
+                                                        dataSize = nativeCtx->getPixelDataSize();
+                                                    }
+                                                }
+                                            }
+                                        }
+                                    }
                                 }
+                            }
 
-                                fragmentState.module = fsModule;
-                                WGPU_SET_ENTRY_POINT(fragmentState, fragmentEntry.c_str());
-                                fragmentState.targetCount = colorTargets.size();
-                                fragmentState.targets = colorTargets.data();
-                                pipelineDesc.fragment = &fragmentState;
-                                if (g_verboseLogging) std::cout << "[WebGPU] Render pipeline with " << colorTargets.size() << " color targets" << std::endl;
-                            } else {
-                                // Depth-only pipeline - no fragment state
-                                pipelineDesc.fragment = nullptr;
+                            if (!dataPtr || dataSize == 0) {
+                                // Try to get width/height anyway for better error message
+                                auto widthProp = g_engine->getProperty(sourceObj, "width");
+                                auto heightProp = g_engine->getProperty(sourceObj, "height");
+                                if (!g_engine->isUndefined(widthProp)) imgWidth = (int)g_engine->toNumber(widthProp);
+                                if (!g_engine->isUndefined(heightProp)) imgHeight = (int)g_engine->toNumber(heightProp);
+
+                                std::cerr << "[WebGPU] copyExternalImageToTexture: unsupported source type, width=" << imgWidth << ", height=" << imgHeight << std::endl;
+                                // Return silently instead of throwing - PixiJS might be able to continue
+                                return g_engine->newUndefined();
                             }
 
-                            // Primitive state
-                            pipelineDesc.primitive.topology = WGPUPrimitiveTopology_TriangleList;
-                            pipelineDesc.primitive.stripIndexFormat = WGPUIndexFormat_Undefined;
-                            pipelineDesc.primitive.frontFace = WGPUFrontFace_CCW;
-                            pipelineDesc.primitive.cullMode = WGPUCullMode_None;
+                            // Parse destination
+                            auto destination = args[1];
+                            auto textureObj = g_engine->getProperty(destination, "texture");
+                            WGPUTexture texture = (WGPUTexture)g_engine->getPrivateData(textureObj);
+                            if (!texture) {
+                                g_engine->throwException("copyExternalImageToTexture: invalid texture");
+                                return g_engine->newUndefined();
+                            }
 
-                            // Parse primitive state if provided
-                            auto primitiveProp = g_engine->getProperty(descriptor, "primitive");
-                            if (!g_engine->isUndefined(primitiveProp)) {
-                                auto topologyProp = g_engine->getProperty(primitiveProp, "topology");
-                                if (!g_engine->isUndefined(topologyProp)) {
-                                    std::string topologyStr = g_engine->toString(topologyProp);
-                                    if (topologyStr == "point-list") pipelineDesc.primitive.topology = WGPUPrimitiveTopology_PointList;
-                                    else if (topologyStr == "line-list") pipelineDesc.primitive.topology = WGPUPrimitiveTopology_LineList;
-                                    else if (topologyStr == "line-strip") pipelineDesc.primitive.topology = WGPUPrimitiveTopology_LineStrip;
-                                    else if (topologyStr == "triangle-list") pipelineDesc.primitive.topology = WGPUPrimitiveTopology_TriangleList;
-                                    else if (topologyStr == "triangle-strip") pipelineDesc.primitive.topology = WGPUPrimitiveTopology_TriangleStrip;
+                            // Optional mipLevel and origin
+                            uint32_t mipLevel = 0;
+                            auto mipLevelVal = g_engine->getProperty(destination, "mipLevel");
+                            if (!g_engine->isUndefined(mipLevelVal)) {
+                                mipLevel = (uint32_t)g_engine->toNumber(mipLevelVal);
+                            }
+
+                            uint32_t originX = 0, originY = 0, originZ = 0;
+                            auto originVal = g_engine->getProperty(destination, "origin");
+                            if (!g_engine->isUndefined(originVal)) {
+                                if (g_engine->isArray(originVal)) {
+                                    originX = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originVal, 0));
+                                    originY = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originVal, 1));
+                                    originZ = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originVal, 2));
                                 }
-                                auto cullModeProp = g_engine->getProperty(primitiveProp, "cullMode");
-                                if (!g_engine->isUndefined(cullModeProp)) {
-                                    std::string cullModeStr = g_engine->toString(cullModeProp);
-                                    if (cullModeStr == "none") pipelineDesc.primitive.cullMode = WGPUCullMode_None;
-                                    else if (cullModeStr == "front") pipelineDesc.primitive.cullMode = WGPUCullMode_Front;
-                                    else if (cullModeStr == "back") pipelineDesc.primitive.cullMode = WGPUCullMode_Back;
+                            }
+
+                            // Parse copySize
+                            auto sizeVal = args[2];
+                            uint32_t width = imgWidth, height = imgHeight, depthOrArrayLayers = 1;
+                            if (g_engine->isArray(sizeVal)) {
+                                width = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeVal, 0));
+                                height = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeVal, 1));
+                                auto depthVal = g_engine->getPropertyIndex(sizeVal, 2);
+                                if (!g_engine->isUndefined(depthVal)) {
+                                    depthOrArrayLayers = (uint32_t)g_engine->toNumber(depthVal);
                                 }
-                                auto frontFaceProp = g_engine->getProperty(primitiveProp, "frontFace");
-                                if (!g_engine->isUndefined(frontFaceProp)) {
-                                    std::string frontFaceStr = g_engine->toString(frontFaceProp);
-                                    if (frontFaceStr == "ccw") pipelineDesc.primitive.frontFace = WGPUFrontFace_CCW;
-                                    else if (frontFaceStr == "cw") pipelineDesc.primitive.frontFace = WGPUFrontFace_CW;
+                            } else if (!g_engine->isUndefined(sizeVal)) {
+                                auto widthVal = g_engine->getProperty(sizeVal, "width");
+                                auto heightVal = g_engine->getProperty(sizeVal, "height");
+                                if (!g_engine->isUndefined(widthVal)) width = (uint32_t)g_engine->toNumber(widthVal);
+                                if (!g_engine->isUndefined(heightVal)) height = (uint32_t)g_engine->toNumber(heightVal);
+                            }
+
+                            // Handle flipY by creating a flipped copy of the data
+                            std::vector<uint8_t> flippedData;
+                            void* uploadDataPtr = dataPtr;
+                            if (flipY && dataPtr && imgHeight > 0) {
+                                size_t bytesPerRow = imgWidth * 4;  // RGBA
+                                flippedData.resize(dataSize);
+                                const uint8_t* srcData = static_cast<const uint8_t*>(dataPtr);
+                                for (int y = 0; y < imgHeight; y++) {
+                                    // Copy row (imgHeight - 1 - y) to row y
+                                    const uint8_t* srcRow = srcData + (imgHeight - 1 - y) * bytesPerRow;
+                                    uint8_t* dstRow = flippedData.data() + y * bytesPerRow;
+                                    std::memcpy(dstRow, srcRow, bytesPerRow);
                                 }
+                                uploadDataPtr = flippedData.data();
+                                if (g_verboseLogging) std::cout << "[WebGPU] copyExternalImageToTexture: flipY applied" << std::endl;
                             }
 
-                            // Depth stencil state
-                            WGPUDepthStencilState depthStencilState = {};
-                            bool hasDepthStencil = false;
+                            // Use writeTexture internally (same effect as copyExternalImageToTexture)
+                            WGPUImageCopyTexture_Compat destCopy = {};
+                            destCopy.texture = texture;
+                            destCopy.mipLevel = mipLevel;
+                            destCopy.origin = {originX, originY, originZ};
+                            destCopy.aspect = WGPUTextureAspect_All;
 
-                            auto depthStencilProp = g_engine->getProperty(descriptor, "depthStencil");
-                            if (!g_engine->isUndefined(depthStencilProp)) {
-                                hasDepthStencil = true;
+                            WGPUTextureDataLayout_Compat layout = {};
+                            layout.offset = 0;
+                            layout.bytesPerRow = imgWidth * 4;  // RGBA
+                            layout.rowsPerImage = imgHeight;
 
-                                auto formatProp = g_engine->getProperty(depthStencilProp, "format");
-                                if (!g_engine->isUndefined(formatProp)) {
-                                    depthStencilState.format = stringToFormat(g_engine->toString(formatProp));
-                                } else {
-                                    depthStencilState.format = WGPUTextureFormat_Depth24Plus;
-                                }
+                            WGPUExtent3D copySize = {width, height, depthOrArrayLayers};
 
-                                auto depthWriteEnabledProp = g_engine->getProperty(depthStencilProp, "depthWriteEnabled");
-                                depthStencilState.depthWriteEnabled = g_engine->isUndefined(depthWriteEnabledProp)
-                                    ? WGPU_OPTIONAL_BOOL_TRUE
-                                    : (g_engine->toBoolean(depthWriteEnabledProp) ? WGPU_OPTIONAL_BOOL_TRUE : WGPU_OPTIONAL_BOOL_FALSE);
+                            wgpuQueueWriteTexture(g_queue, &destCopy, uploadDataPtr, dataSize, &layout, &copySize);
 
-                                auto depthCompareProp = g_engine->getProperty(depthStencilProp, "depthCompare");
-                                if (!g_engine->isUndefined(depthCompareProp)) {
-                                    std::string compareStr = g_engine->toString(depthCompareProp);
-                                    if (compareStr == "never") depthStencilState.depthCompare = WGPUCompareFunction_Never;
-                                    else if (compareStr == "less") depthStencilState.depthCompare = WGPUCompareFunction_Less;
-                                    else if (compareStr == "less-equal") depthStencilState.depthCompare = WGPUCompareFunction_LessEqual;
-                                    else if (compareStr == "greater") depthStencilState.depthCompare = WGPUCompareFunction_Greater;
-                                    else if (compareStr == "greater-equal") depthStencilState.depthCompare = WGPUCompareFunction_GreaterEqual;
-                                    else if (compareStr == "equal") depthStencilState.depthCompare = WGPUCompareFunction_Equal;
-                                    else if (compareStr == "not-equal") depthStencilState.depthCompare = WGPUCompareFunction_NotEqual;
-                                    else if (compareStr == "always") depthStencilState.depthCompare = WGPUCompareFunction_Always;
-                                } else {
-                                    depthStencilState.depthCompare = WGPUCompareFunction_Less;
-                                }
+                            if (g_verboseLogging) std::cout << "[WebGPU] copyExternalImageToTexture: " << width << "x" << height << (flipY ? " (flipY)" : "") << std::endl;
 
-                                // Default stencil operations
-                                depthStencilState.stencilFront.compare = WGPUCompareFunction_Always;
-                                depthStencilState.stencilFront.failOp = WGPUStencilOperation_Keep;
-                                depthStencilState.stencilFront.depthFailOp = WGPUStencilOperation_Keep;
-                                depthStencilState.stencilFront.passOp = WGPUStencilOperation_Keep;
-                                depthStencilState.stencilBack = depthStencilState.stencilFront;
-                                depthStencilState.stencilReadMask = 0xFFFFFFFF;
-                                depthStencilState.stencilWriteMask = 0xFFFFFFFF;
+                            return g_engine->newUndefined();
+                        })
+                    );
+
+                    // queue.onSubmittedWorkDone() - returns Promise that resolves when GPU work is done
+                    g_engine->setProperty(queue, "onSubmittedWorkDone",
+                        g_engine->newFunction("onSubmittedWorkDone", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                            // For now, return a Promise that resolves immediately
+                            // Dawn's wgpuQueueOnSubmittedWorkDone is callback-based, which is complex to integrate
+                            // Since we're running single-threaded and submit() is synchronous, work is already done
+                            return g_engine->evalWithResult("Promise.resolve()", "<onSubmittedWorkDone>");
+                        })
+                    );
+
+                    g_engine->setProperty(device, "queue", queue);
+
+                    // device.limits - expose device limits
+                    auto deviceLimits = g_engine->newObject();
+                    g_engine->setProperty(deviceLimits, "maxTextureDimension2D", g_engine->newNumber(8192));
+                    g_engine->setProperty(deviceLimits, "maxColorAttachmentBytesPerSample", g_engine->newNumber(64));
+                    g_engine->setProperty(deviceLimits, "maxBindGroups", g_engine->newNumber(4));
+                    g_engine->setProperty(deviceLimits, "maxBindingsPerBindGroup", g_engine->newNumber(1000));
+                    g_engine->setProperty(deviceLimits, "maxUniformBufferBindingSize", g_engine->newNumber(65536));
+                    g_engine->setProperty(deviceLimits, "maxStorageBufferBindingSize", g_engine->newNumber(134217728));
+                    g_engine->setProperty(deviceLimits, "maxSampledTexturesPerShaderStage", g_engine->newNumber(16));
+                    g_engine->setProperty(deviceLimits, "maxSamplersPerShaderStage", g_engine->newNumber(16));
+                    g_engine->setProperty(deviceLimits, "maxStorageTexturesPerShaderStage", g_engine->newNumber(8));
+                    g_engine->setProperty(deviceLimits, "maxUniformBuffersPerShaderStage", g_engine->newNumber(12));
+                    g_engine->setProperty(deviceLimits, "maxStorageBuffersPerShaderStage", g_engine->newNumber(8));
+                    g_engine->setProperty(deviceLimits, "maxDynamicUniformBuffersPerPipelineLayout", g_engine->newNumber(8));
+                    g_engine->setProperty(deviceLimits, "minUniformBufferOffsetAlignment", g_engine->newNumber(256));
+                    g_engine->setProperty(deviceLimits, "minStorageBufferOffsetAlignment", g_engine->newNumber(256));
+                    g_engine->setProperty(device, "limits", deviceLimits);
 
-                                pipelineDesc.depthStencil = &depthStencilState;
+                    // device.features - Set-like object with enabled features
+                    // These should match the features exposed in adapter.features that were requested
+                    auto deviceFeatures = g_engine->newArray(0);
+                    g_engine->setProperty(deviceFeatures, "has",
+                        g_engine->newFunction("has", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                            if (args.empty()) return g_engine->newBoolean(false);
+                            std::string featureName = g_engine->toString(args[0]);
+                            // indirect-first-instance enables non-zero firstInstance in indirect draws
+                            if (featureName == "indirect-first-instance") {
+                                return g_engine->newBoolean(true);
                             }
+                            // timestamp-query is NOT supported yet - bindings not implemented
+                            return g_engine->newBoolean(false);
+                        })
+                    );
+                    g_engine->setProperty(device, "features", deviceFeatures);
 
-                            // Multisample state - parse from descriptor or use defaults
-                            pipelineDesc.multisample.count = 1;
-                            pipelineDesc.multisample.mask = 0xFFFFFFFF;
-                            pipelineDesc.multisample.alphaToCoverageEnabled = false;
-
-                            auto multisampleProp = g_engine->getProperty(descriptor, "multisample");
-                            if (!g_engine->isUndefined(multisampleProp)) {
-                                auto countProp = g_engine->getProperty(multisampleProp, "count");
-                                if (!g_engine->isUndefined(countProp)) {
-                                    pipelineDesc.multisample.count = (uint32_t)g_engine->toNumber(countProp);
-                                }
+                    // device.createBuffer(descriptor)
+                    g_engine->setProperty(device, "createBuffer",
+                        g_engine->newFunction("createBuffer", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                            if (args.empty()) {
+                                g_engine->throwException("createBuffer requires a descriptor");
+                                return g_engine->newUndefined();
+                            }
 
-                                auto maskProp = g_engine->getProperty(multisampleProp, "mask");
-                                if (!g_engine->isUndefined(maskProp)) {
-                                    pipelineDesc.multisample.mask = (uint32_t)g_engine->toNumber(maskProp);
-                                }
+                            auto descriptor = args[0];
+                            double size = g_engine->toNumber(g_engine->getProperty(descriptor, "size"));
+                            double usage = g_engine->toNumber(g_engine->getProperty(descriptor, "usage"));
 
-                                auto alphaToCoverageProp = g_engine->getProperty(multisampleProp, "alphaToCoverageEnabled");
-                                if (!g_engine->isUndefined(alphaToCoverageProp)) {
-                                    pipelineDesc.multisample.alphaToCoverageEnabled = g_engine->toBoolean(alphaToCoverageProp);
-                                }
+                            // Check for mappedAtCreation
+                            auto mappedAtCreationProp = g_engine->getProperty(descriptor, "mappedAtCreation");
+                            bool mappedAtCreation = !g_engine->isUndefined(mappedAtCreationProp) && g_engine->toBoolean(mappedAtCreationProp);
 
-                                if (g_verboseLogging) {
-                                    std::cout << "[WebGPU] Render pipeline multisample: count=" << pipelineDesc.multisample.count
-                                              << ", mask=" << pipelineDesc.multisample.mask << std::endl;
-                                }
-                            }
+                            WGPUBufferDescriptor bufferDesc = {};
+                            bufferDesc.size = (uint64_t)size;
+                            bufferDesc.usage = (WGPUBufferUsage)(uint32_t)usage;
+                            bufferDesc.mappedAtCreation = mappedAtCreation;
 
-                            // Create pipeline
-                            WGPURenderPipeline pipeline = wgpuDeviceCreateRenderPipeline(g_device, &pipelineDesc);
-                            if (!pipeline) {
-                                g_engine->throwException("Failed to create render pipeline");
+                            WGPUBuffer buffer = wgpuDeviceCreateBuffer(g_device, &bufferDesc);
+                            if (!buffer) {
+                                g_engine->throwException("Failed to create buffer");
                                 return g_engine->newUndefined();
                             }
 
-                            // Register pipeline for getBindGroupLayout
-                            uint64_t pipelineId = g_nextRenderPipelineId++;
-                            g_renderPipelineRegistry[pipelineId] = pipeline;
+                            // Register buffer for mapping operations
+                            uint64_t bufferId = g_nextBufferId++;
+                            // mappedAtCreation buffers are mapped for write
+                            WGPUMapMode initialMapMode = mappedAtCreation ? WGPUMapMode_Write : WGPUMapMode_None;
+                            g_bufferRegistry[bufferId] = {buffer, (uint64_t)size, (WGPUBufferUsage)(uint32_t)usage, mappedAtCreation, nullptr, 0, initialMapMode};
+                            g_gpuBufferBytes.fetch_add((uint64_t)size, std::memory_order_relaxed);
 
-                            auto jsPipeline = g_engine->newObject();
-                            g_engine->setPrivateData(jsPipeline, pipeline);
-                            g_engine->setProperty(jsPipeline, "_pipelineId", g_engine->newNumber((double)pipelineId));
-                            g_engine->setProperty(jsPipeline, "_type", g_engine->newString("renderPipeline"));
+                            auto jsBuffer = g_engine->newObject();
+                            g_engine->setPrivateData(jsBuffer, buffer);
+                            g_engine->setProperty(jsBuffer, "size", g_engine->newNumber(size));
+                            g_engine->setProperty(jsBuffer, "_bufferId", g_engine->newNumber((double)bufferId));
+                            g_engine->setProperty(jsBuffer, "_type", g_engine->newString("buffer"));
+                            g_engine->setProperty(jsBuffer, "usage", g_engine->newNumber(usage));
 
-                            // Add getBindGroupLayout method using captured pipelineId
-                            g_engine->setProperty(jsPipeline, "getBindGroupLayout",
-                                g_engine->newFunction("getBindGroupLayout", [pipelineId](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    auto it = g_renderPipelineRegistry.find(pipelineId);
-                                    if (it == g_renderPipelineRegistry.end() || !it->second) {
-                                        std::cerr << "[WebGPU] getBindGroupLayout: Render pipeline not found" << std::endl;
-                                        return g_engine->newUndefined();
+                            // Set initial mapState
+                            g_engine->setProperty(jsBuffer, "mapState", g_engine->newString(mappedAtCreation ? "mapped" : "unmapped"));
+
+                            // buffer.mapAsync(mode, offset?, size?) -> Promise
+                            // Returns a Promise that resolves when the buffer is mapped
+                            g_engine->setProperty(jsBuffer, "mapAsync",
+                                g_engine->newFunction("mapAsync", [bufferId](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                                    auto it = g_bufferRegistry.find(bufferId);
+                                    if (it == g_bufferRegistry.end()) {
+                                        std::cerr << "[WebGPU] mapAsync: Buffer " << bufferId << " not found" << std::endl;
+                                        return g_engine->evalWithResult("Promise.reject(new Error('Buffer not found'))", "mapAsync-error");
                                     }
 
-                                    uint32_t groupIndex = args.empty() ? 0 : (uint32_t)g_engine->toNumber(args[0]);
-                                    WGPUBindGroupLayout layout = wgpuRenderPipelineGetBindGroupLayout(it->second, groupIndex);
+                                    auto& bufferInfo = it->second;
 
-                                    if (!layout) {
-                                        std::cerr << "[WebGPU] getBindGroupLayout: Failed to get layout for group " << groupIndex << std::endl;
-                                        return g_engine->newUndefined();
+                                    // Already mapped (mappedAtCreation)?
+                                    if (bufferInfo.isMapped) {
+                                        return g_engine->evalWithResult("Promise.resolve()", "mapAsync-already-mapped");
                                     }
 
-                                    auto jsLayout = g_engine->newObject();
-                                    g_engine->setPrivateData(jsLayout, layout);
-                                    g_engine->setProperty(jsLayout, "_type", g_engine->newString("bindGroupLayout"));
-
-                                    return jsLayout;
-                                })
-                            );
+                                    // Get mode (default to READ)
+                                    WGPUMapMode mode = WGPUMapMode_Read;
+                                    if (!args.empty()) {
+                                        uint32_t jsMode = (uint32_t)g_engine->toNumber(args[0]);
+                                        // GPUMapMode.READ = 1, GPUMapMode.WRITE = 2
+                                        if (jsMode == 2) mode = WGPUMapMode_Write;
+                                    }
 
-                            if (g_verboseLogging) std::cout << "[WebGPU] Render pipeline created (id=" << pipelineId << ")" << std::endl;
-                            return jsPipeline;
-                        })
-                    );
+                                    uint64_t offset = args.size() > 1 ? (uint64_t)g_engine->toNumber(args[1]) : 0;
+                                    uint64_t mapSize = args.size() > 2 ? (uint64_t)g_engine->toNumber(args[2]) : bufferInfo.size;
 
-                    // device.createComputePipeline(descriptor)
-                    g_engine->setProperty(device, "createComputePipeline",
-                        g_engine->newFunction("createComputePipeline", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                            if (args.empty()) {
-                                g_engine->throwException("createComputePipeline requires a descriptor");
-                                return g_engine->newUndefined();
-                            }
+                                    // Debug: Log buffer info
+                                    bool hasMapRead = (bufferInfo.usage & WGPUBufferUsage_MapRead) != 0;
+                                    (void)hasMapRead;  // Used for debug logging when enabled
 
-                            auto descriptor = args[0];
+                                    // Ensure all pending GPU work is processed before attempting to map
+                                    // This is critical for buffers that were just used in a copy operation
+                                    for (int prePoll = 0; prePoll < 100; prePoll++) {
+#if defined(MYSTRAL_WEBGPU_WGPU)
+                                        wgpuDevicePoll(g_device, false, nullptr);
+#else
+                                        if (g_instance) {
+                                            wgpuInstanceProcessEvents(g_instance);
+                                        }
+                                        if (g_device) {
+                                            wgpuDeviceTick(g_device);
+                                        }
+#endif
+                                    }
 
-                            // Get layout
-                            auto layoutProp = g_engine->getProperty(descriptor, "layout");
-                            WGPUPipelineLayout layout = nullptr;
-                            bool isAutoLayout = false;
-                            if (!g_engine->isUndefined(layoutProp) && !g_engine->isString(layoutProp)) {
-                                layout = (WGPUPipelineLayout)g_engine->getPrivateData(layoutProp);
-                            } else if (g_engine->isString(layoutProp)) {
-                                std::string layoutStr = g_engine->toString(layoutProp);
-                                if (layoutStr == "auto") {
-                                    isAutoLayout = true;
-                                    if (g_verboseLogging) std::cout << "[WebGPU] Using 'auto' layout for compute pipeline" << std::endl;
-                                    std::cout.flush();
-                                }
-                            }
+                                    // Synchronous mapping: use global callback + device poll
+                                    g_bufferMapData.completed = false;
+                                    g_bufferMapData.status = WGPUBufferMapAsyncStatus_Unknown_Compat;
+                                    g_bufferMapData.errorMessage.clear();
 
-                            // Get compute stage
-                            auto computeProp = g_engine->getProperty(descriptor, "compute");
-                            auto moduleProp = g_engine->getProperty(computeProp, "module");
-                            WGPUShaderModule module = (WGPUShaderModule)g_engine->getPrivateData(moduleProp);
+#if WGPU_BUFFER_MAP_USES_CALLBACK_INFO
+                                    // Dawn uses CallbackInfo struct with 4-param callback
+                                    // Use AllowSpontaneous mode so callback can be invoked at any time
+                                    WGPUBufferMapCallbackInfo mapCallbackInfo = {};
+                                    mapCallbackInfo.mode = WGPUCallbackMode_AllowSpontaneous;
+                                    mapCallbackInfo.callback = onBufferMapped;
+                                    mapCallbackInfo.userdata1 = &g_bufferMapData;
+                                    mapCallbackInfo.userdata2 = nullptr;
 
-                            // Entry point (default "main")
-                            std::string entryPoint = "main";
-                            auto entryPointProp = g_engine->getProperty(computeProp, "entryPoint");
-                            if (!g_engine->isUndefined(entryPointProp)) {
-                                entryPoint = g_engine->toString(entryPointProp);
-                            }
+                                    wgpuBufferMapAsync(bufferInfo.buffer, mode, offset, mapSize, mapCallbackInfo);
+#else
+                                    // wgpu-native uses separate callback and userdata
+                                    wgpuBufferMapAsync(bufferInfo.buffer, mode, offset, mapSize, onBufferMapped, &g_bufferMapData);
+#endif
 
-                            // Create pipeline
-                            WGPUComputePipelineDescriptor pipelineDesc = {};
-                            pipelineDesc.layout = layout;
-                            pipelineDesc.compute.module = module;
-                            WGPU_SET_ENTRY_POINT(pipelineDesc.compute, entryPoint.c_str());
+                                    // Poll device until mapping completes
+                                    // Add small sleep to avoid busy-looping and let GPU work complete
+                                    int pollCount = 0;
+                                    while (!g_bufferMapData.completed && pollCount < 10000) {
+#if defined(MYSTRAL_WEBGPU_WGPU)
+                                        wgpuDevicePoll(g_device, true, nullptr);
+#else
+                                        if (g_instance) {
+                                            wgpuInstanceProcessEvents(g_instance);
+                                        }
+                                        if (g_device) {
+                                            wgpuDeviceTick(g_device);
+                                        }
+#endif
+                                        // Small sleep every 100 iterations to avoid busy loop
+                                        if (pollCount % 100 == 0) {
+                                            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                                        }
+                                        pollCount++;
+                                    }
 
-                            WGPUComputePipeline pipeline = wgpuDeviceCreateComputePipeline(g_device, &pipelineDesc);
-                            if (!pipeline) {
-                                g_engine->throwException("Failed to create compute pipeline");
-                                return g_engine->newUndefined();
-                            }
+                                    if (g_bufferMapData.status == WGPUBufferMapAsyncStatus_Success_Compat) {
+                                        bufferInfo.isMapped = true;
+                                        bufferInfo.mapMode = mode;  // Store whether mapped for read or write
+                                        return g_engine->evalWithResult("Promise.resolve()", "mapAsync-success");
+                                    } else {
+                                        std::cerr << "[WebGPU] mapAsync: Failed with status " << g_bufferMapData.status;
+                                        if (!g_bufferMapData.errorMessage.empty()) {
+                                            std::cerr << " - " << g_bufferMapData.errorMessage;
+                                        }
+                                        std::cerr << std::endl;
+                                        return g_engine->evalWithResult("Promise.reject(new Error('Buffer map failed'))", "mapAsync-failed");
+                                    }
+                                })
+                            );
 
-                            // Register pipeline for getBindGroupLayout
-                            uint64_t pipelineId = g_nextComputePipelineId++;
-                            g_computePipelineRegistry[pipelineId] = pipeline;
+                            // buffer.getMappedRange(offset?, size?) -> ArrayBuffer
+                            // Capture bufferId in closure to identify the correct buffer
+                            g_engine->setProperty(jsBuffer, "getMappedRange",
+                                g_engine->newFunction("getMappedRange", [bufferId](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                                    // Look up this specific buffer by its ID
+                                    auto it = g_bufferRegistry.find(bufferId);
+                                    if (it == g_bufferRegistry.end()) {
+                                        std::cerr << "[WebGPU] getMappedRange: Buffer " << bufferId << " not found in registry" << std::endl;
+                                        return g_engine->newUndefined();
+                                    }
 
-                            auto jsPipeline = g_engine->newObject();
-                            g_engine->setPrivateData(jsPipeline, pipeline);
-                            g_engine->setProperty(jsPipeline, "_pipelineId", g_engine->newNumber((double)pipelineId));
-                            g_engine->setProperty(jsPipeline, "_type", g_engine->newString("computePipeline"));
+                                    auto& bufferInfo = it->second;
 
-                            // Add getBindGroupLayout method using captured pipelineId
-                            g_engine->setProperty(jsPipeline, "getBindGroupLayout",
-                                g_engine->newFunction("getBindGroupLayout", [pipelineId](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    auto it = g_computePipelineRegistry.find(pipelineId);
-                                    if (it == g_computePipelineRegistry.end() || !it->second) {
-                                        std::cerr << "[WebGPU] getBindGroupLayout: Compute pipeline not found" << std::endl;
+                                    if (!bufferInfo.isMapped && !bufferInfo.mappedData) {
+                                        if (g_verboseLogging) std::cerr << "[WebGPU] getMappedRange: Buffer " << bufferId << " is not mapped" << std::endl;
                                         return g_engine->newUndefined();
                                     }
 
-                                    uint32_t groupIndex = args.empty() ? 0 : (uint32_t)g_engine->toNumber(args[0]);
-                                    WGPUBindGroupLayout layout = wgpuComputePipelineGetBindGroupLayout(it->second, groupIndex);
+                                    uint64_t offset = args.empty() ? 0 : (uint64_t)g_engine->toNumber(args[0]);
+                                    uint64_t rangeSize = args.size() > 1 ? (uint64_t)g_engine->toNumber(args[1]) : bufferInfo.size - offset;
 
-                                    if (!layout) {
-                                        std::cerr << "[WebGPU] getBindGroupLayout: Failed to get layout for group " << groupIndex << std::endl;
-                                        return g_engine->newUndefined();
+                                    // Use wgpuBufferGetConstMappedRange for MAP_READ, wgpuBufferGetMappedRange for MAP_WRITE
+                                    // Dawn requires the const version for read-only mapped buffers
+                                    const void* mappedData = nullptr;
+                                    if (bufferInfo.mapMode == WGPUMapMode_Read) {
+                                        mappedData = wgpuBufferGetConstMappedRange(bufferInfo.buffer, offset, rangeSize);
+                                    } else {
+                                        mappedData = wgpuBufferGetMappedRange(bufferInfo.buffer, offset, rangeSize);
                                     }
 
-                                    auto jsLayout = g_engine->newObject();
-                                    g_engine->setPrivateData(jsLayout, layout);
-                                    g_engine->setProperty(jsLayout, "_type", g_engine->newString("bindGroupLayout"));
+                                    if (mappedData) {
+                                        // Use newArrayBufferExternal to avoid copying
+                                        // Cast away const for read-only buffers - the JS side shouldn't modify but we need void*
+                                        return g_engine->newArrayBufferExternal(const_cast<void*>(mappedData), rangeSize);
+                                    }
 
-                                    return jsLayout;
+                                    if (g_verboseLogging) std::cerr << "[WebGPU] getMappedRange: GetMappedRange returned null for buffer " << bufferId << std::endl;
+                                    return g_engine->newUndefined();
                                 })
                             );
 
-                            if (g_verboseLogging) std::cout << "[WebGPU] Compute pipeline created (id=" << pipelineId << ")" << std::endl;
-                            return jsPipeline;
-                        })
-                    );
-
-                    // device.createCommandEncoder(descriptor?)
-                    g_engine->setProperty(device, "createCommandEncoder",
-                        g_engine->newFunction("createCommandEncoder", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                            WGPUCommandEncoderDescriptor desc = {};
-                            WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(g_device, &desc);
-
-                            // Store in global for use by beginRenderPass
-                            // Note: Multiple encoders are supported via per-encoder render pass tracking
-                            g_jsCommandEncoder = encoder;
-
-                            // Suspend frame tracking while creating encoder wrapper
-                            // This prevents the wrapper's methods from being garbage collected at frame end
-                            g_engine->suspendFrameTracking();
-
-                            auto jsEncoder = g_engine->newObject();
-                            g_engine->setPrivateData(jsEncoder, encoder);
-
-                            // Capture encoder pointer for use in closures
-                            WGPUCommandEncoder capturedEncoder = encoder;
-
-                            // encoder.beginRenderPass(descriptor)
-                            g_engine->setProperty(jsEncoder, "beginRenderPass",
-                                g_engine->newFunction("beginRenderPass", [capturedEncoder](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    if (args.empty()) {
-                                        g_engine->throwException("beginRenderPass requires a descriptor");
+                            // buffer.unmap()
+                            // Capture bufferId in closure to identify the correct buffer
+                            g_engine->setProperty(jsBuffer, "unmap",
+                                g_engine->newFunction("unmap", [bufferId](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                                    // Look up this specific buffer by its ID
+                                    auto it = g_bufferRegistry.find(bufferId);
+                                    if (it == g_bufferRegistry.end()) {
+                                        std::cerr << "[WebGPU] unmap: Buffer " << bufferId << " not found in registry" << std::endl;
                                         return g_engine->newUndefined();
                                     }
 
-                                    // Use the captured encoder for this specific command encoder
-                                    WGPUCommandEncoder encoderToUse = capturedEncoder;
-                                    if (!encoderToUse) {
-                                        g_engine->throwException("Command encoder not available");
-                                        return g_engine->newUndefined();
+                                    auto& bufferInfo = it->second;
+                                    if (bufferInfo.isMapped) {
+                                        wgpuBufferUnmap(bufferInfo.buffer);
+                                        bufferInfo.isMapped = false;
+                                        bufferInfo.mappedData = nullptr;
+                                        bufferInfo.mappedSize = 0;
                                     }
+                                    return g_engine->newUndefined();
+                                })
+                            );
 
-                                    auto descriptor = args[0];
-                                    auto colorAttachments = g_engine->getProperty(descriptor, "colorAttachments");
-
-                                    // Parse all color attachments (deferred renderer uses multiple)
-                                    auto attachmentsLengthProp = g_engine->getProperty(colorAttachments, "length");
-                                    int numAttachments = g_engine->isUndefined(attachmentsLengthProp) ? 0 : (int)g_engine->toNumber(attachmentsLengthProp);
-                                    std::vector<WGPURenderPassColorAttachment> colorAttachmentList;
-                                    colorAttachmentList.reserve(numAttachments);
-
-                                    double firstR = 0, firstG = 0, firstB = 0, firstA = 1;
+                            // buffer.destroy()
+                            // Capture bufferId in closure to identify the correct buffer
+                            g_engine->setProperty(jsBuffer, "destroy",
+                                g_engine->newFunction("destroy", [bufferId](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                                    auto it = g_bufferRegistry.find(bufferId);
+                                    if (it != g_bufferRegistry.end()) {
+                                        wgpuBufferDestroy(it->second.buffer);
+                                        wgpuBufferRelease(it->second.buffer);
+                                        g_gpuBufferBytes.fetch_sub(it->second.size, std::memory_order_relaxed);
+                                        g_bufferRegistry.erase(it);
+                                    }
+                                    return g_engine->newUndefined();
+                                })
+                            );
 
-                                    for (int i = 0; i < numAttachments; i++) {
-                                        auto attachment = g_engine->getPropertyIndex(colorAttachments, i);
-                                        auto viewHandle = g_engine->getProperty(attachment, "view");
-                                        WGPUTextureView view = (WGPUTextureView)g_engine->getPrivateData(viewHandle);
+                            // Collected without destroy(): drop the registry's reference. Copies
+                            // posted to workers hold their own, so the buffer outlives this.
+                            g_engine->registerRelease(jsBuffer, [bufferId]() {
+                                auto it = g_bufferRegistry.find(bufferId);
+                                if (it != g_bufferRegistry.end()) {
+                                    if (it->second.isMapped) {
+                                        wgpuBufferUnmap(it->second.buffer);
+                                    }
+                                    wgpuBufferRelease(it->second.buffer);
+                                    g_gpuBufferBytes.fetch_sub(it->second.size, std::memory_order_relaxed);
+                                    g_bufferRegistry.erase(it);
+                                }
+                            });
 
-                                        // Debug: Log first color attachment for comparison with g_currentTextureView
-                                        if (i == 0) {
-                                            if (g_verboseLogging) {
-                                                std::cout << "[WebGPU] Render pass attachment[0]: view=" << (void*)view
-                                                          << ", g_currentTextureView=" << (void*)g_currentTextureView
-                                                          << ", matches=" << (view == g_currentTextureView ? "YES" : "NO") << std::endl;
-                                            }
+                            return jsBuffer;
+                        })
+                    );
 
-                                            // Track if this render pass uses the surface texture
-                                            if (view == g_currentTextureView && g_currentTextureView != nullptr) {
-                                                g_surfaceRenderEncoder = encoderToUse;
-                                                g_surfaceRenderPassEnded = false;
-                                            }
-                                        }
+                    // device.createShaderModule(descriptor)
+                    g_engine->setProperty(device, "createShaderModule",
+                        g_engine->newFunction("createShaderModule", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                            if (args.empty()) {
+                                g_engine->throwException("createShaderModule requires a descriptor");
+                                return g_engine->newUndefined();
+                            }
 
-                                        // Debug: Log GBuffer pass attachments
-                                        if (numAttachments >= 5 && i == 0) {
-                                            if (g_verboseLogging) std::cout << "[WebGPU] GBuffer pass - 5 attachments, view[0]=" << (void*)view << std::endl;
-                                        }
-                                        if (!view && numAttachments >= 5) {
-                                            std::cerr << "[WebGPU] ERROR: GBuffer attachment " << i << " has null view!" << std::endl;
-                                        }
+                            auto descriptor = args[0];
+                            std::string code = g_engine->toString(g_engine->getProperty(descriptor, "code"));
 
-                                        // Parse loadOp (default 'clear')
-                                        WGPULoadOp loadOp = WGPULoadOp_Clear;
-                                        auto loadOpProp = g_engine->getProperty(attachment, "loadOp");
-                                        if (!g_engine->isUndefined(loadOpProp)) {
-                                            std::string loadOpStr = g_engine->toString(loadOpProp);
-                                            if (loadOpStr == "load") loadOp = WGPULoadOp_Load;
-                                        }
+                            // Debug: Print first 500 chars of shader code
+                            if (g_verboseLogging && code.length() > 0) {
+                                std::cout << "[Shader] Creating shader (" << code.length() << " chars):\n"
+                                          << code.substr(0, std::min((size_t)500, code.length()))
+                                          << (code.length() > 500 ? "\n..." : "") << std::endl;
+                            }
 
-                                        // Parse storeOp (default 'store')
-                                        WGPUStoreOp storeOp = WGPUStoreOp_Store;
-                                        auto storeOpProp = g_engine->getProperty(attachment, "storeOp");
-                                        if (!g_engine->isUndefined(storeOpProp)) {
-                                            std::string storeOpStr = g_engine->toString(storeOpProp);
-                                            if (storeOpStr == "discard") storeOp = WGPUStoreOp_Discard;
-                                        }
+                            WGPUShaderModuleWGSLDescriptor_Compat wgslDesc = {};
+                            WGPUShaderModuleDescriptor shaderDesc = {};
+                            setupShaderModuleWGSL(&shaderDesc, &wgslDesc, code.c_str());
 
-                                        // Parse clearValue only if loadOp is 'clear'
-                                        double r = 0, g = 0, b = 0, a = 1;
-                                        if (loadOp == WGPULoadOp_Clear) {
-                                            auto clearValue = g_engine->getProperty(attachment, "clearValue");
-                                            if (!g_engine->isUndefined(clearValue)) {
-                                                // Check if it's an array [r, g, b, a] or object {r, g, b, a}
-                                                if (g_engine->isArray(clearValue)) {
-                                                    r = g_engine->toNumber(g_engine->getPropertyIndex(clearValue, 0));
-                                                    g = g_engine->toNumber(g_engine->getPropertyIndex(clearValue, 1));
-                                                    b = g_engine->toNumber(g_engine->getPropertyIndex(clearValue, 2));
-                                                    a = g_engine->toNumber(g_engine->getPropertyIndex(clearValue, 3));
-                                                } else {
-                                                    r = g_engine->toNumber(g_engine->getProperty(clearValue, "r"));
-                                                    g = g_engine->toNumber(g_engine->getProperty(clearValue, "g"));
-                                                    b = g_engine->toNumber(g_engine->getProperty(clearValue, "b"));
-                                                    a = g_engine->toNumber(g_engine->getProperty(clearValue, "a"));
-                                                }
-                                            }
-                                        }
+                            WGPUShaderModule shaderModule = wgpuDeviceCreateShaderModule(g_device, &shaderDesc);
 
-                                        if (i == 0) {
-                                            firstR = r; firstG = g; firstB = b; firstA = a;
-                                        }
+                            auto jsShader = g_engine->newObject();
+                            g_engine->setPrivateData(jsShader, shaderModule);
 
-                                        WGPURenderPassColorAttachment colorAttachment = {};
-                                        colorAttachment.view = view;
-                                        colorAttachment.loadOp = loadOp;
-                                        colorAttachment.storeOp = storeOp;
-                                        colorAttachment.clearValue = {r, g, b, a};
-                                        colorAttachment.depthSlice = WGPU_DEPTH_SLICE_UNDEFINED;
-                                        colorAttachmentList.push_back(colorAttachment);
-                                    }
+                            return jsShader;
+                        })
+                    );
 
-                                    WGPURenderPassDescriptor renderPassDesc = {};
-                                    renderPassDesc.colorAttachmentCount = colorAttachmentList.size();
-                                    renderPassDesc.colorAttachments = colorAttachmentList.data();
-
-                                    // Parse depth stencil attachment if present
-                                    WGPURenderPassDepthStencilAttachment depthStencilAttachment = {};
-                                    auto depthStencilProp = g_engine->getProperty(descriptor, "depthStencilAttachment");
-                                    if (!g_engine->isUndefined(depthStencilProp)) {
-                                        auto depthViewHandle = g_engine->getProperty(depthStencilProp, "view");
-                                        WGPUTextureView depthView = (WGPUTextureView)g_engine->getPrivateData(depthViewHandle);
-                                        depthStencilAttachment.view = depthView;
-
-                                        // Depth clear value (default 1.0)
-                                        auto depthClearValueProp = g_engine->getProperty(depthStencilProp, "depthClearValue");
-                                        depthStencilAttachment.depthClearValue = g_engine->isUndefined(depthClearValueProp)
-                                            ? 1.0f : (float)g_engine->toNumber(depthClearValueProp);
-
-                                        // Depth load/store ops (default clear/store)
-                                        auto depthLoadOpProp = g_engine->getProperty(depthStencilProp, "depthLoadOp");
-                                        if (!g_engine->isUndefined(depthLoadOpProp)) {
-                                            std::string loadOpStr = g_engine->toString(depthLoadOpProp);
-                                            if (loadOpStr == "load") depthStencilAttachment.depthLoadOp = WGPULoadOp_Load;
-                                            else depthStencilAttachment.depthLoadOp = WGPULoadOp_Clear;
-                                        } else {
-                                            depthStencilAttachment.depthLoadOp = WGPULoadOp_Clear;
-                                        }
+                    // device.createRenderPipeline(descriptor)
+                    g_engine->setProperty(device, "createRenderPipeline",
+                        g_engine->newFunction("createRenderPipeline", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                            MYSTRAL_TRACE_SCOPE_CAT("gpu.createRenderPipeline", "webgpu");
+                            if (args.empty()) {
+                                g_engine->throwException("createRenderPipeline requires a descriptor");
+                                return g_engine->newUndefined();
+                            }
 
-                                        auto depthStoreOpProp = g_engine->getProperty(depthStencilProp, "depthStoreOp");
-                                        if (!g_engine->isUndefined(depthStoreOpProp)) {
-                                            std::string storeOpStr = g_engine->toString(depthStoreOpProp);
-                                            if (storeOpStr == "discard") depthStencilAttachment.depthStoreOp = WGPUStoreOp_Discard;
-                                            else depthStencilAttachment.depthStoreOp = WGPUStoreOp_Store;
-                                        } else {
-                                            depthStencilAttachment.depthStoreOp = WGPUStoreOp_Store;
-                                        }
+                            auto descriptor = args[0];
 
-                                        // Stencil ops (default undefined/disabled)
-                                        depthStencilAttachment.stencilClearValue = 0;
-                                        depthStencilAttachment.stencilLoadOp = WGPULoadOp_Undefined;
-                                        depthStencilAttachment.stencilStoreOp = WGPUStoreOp_Undefined;
+                            // Get vertex stage
+                            auto vertex = g_engine->getProperty(descriptor, "vertex");
+                            auto vertexModule = g_engine->getProperty(vertex, "module");
+                            std::string vertexEntry = g_engine->toString(g_engine->getProperty(vertex, "entryPoint"));
 
-                                        renderPassDesc.depthStencilAttachment = &depthStencilAttachment;
-                                        if (g_verboseLogging) std::cout << "[WebGPU] Render pass with depth attachment, clear=" << depthStencilAttachment.depthClearValue << std::endl;
-                                    }
+                            // Get fragment stage (optional - depth-only pipelines don't have fragment)
+                            auto fragment = g_engine->getProperty(descriptor, "fragment");
+                            WGPUShaderModule fsModule = nullptr;
+                            std::string fragmentEntry = "main";
+                            bool hasFragment = !g_engine->isUndefined(fragment) && !g_engine->isNull(fragment);
+                            if (hasFragment) {
+                                auto fragmentModule = g_engine->getProperty(fragment, "module");
+                                fsModule = (WGPUShaderModule)g_engine->getPrivateData(fragmentModule);
+                                auto fragEntryProp = g_engine->getProperty(fragment, "entryPoint");
+                                if (!g_engine->isUndefined(fragEntryProp)) {
+                                    fragmentEntry = g_engine->toString(fragEntryProp);
+                                }
+                            }
 
-                                    // Begin render pass on the captured encoder (not the global)
-                                    WGPURenderPassEncoder renderPass = wgpuCommandEncoderBeginRenderPass(encoderToUse, &renderPassDesc);
+                            // Get native shader modules
+                            WGPUShaderModule vsModule = (WGPUShaderModule)g_engine->getPrivateData(vertexModule);
 
-                                    // Store in per-encoder map (fixes issue with multiple encoders)
-                                    g_encoderRenderPassMap[encoderToUse] = renderPass;
+                            // Create pipeline descriptor
+                            WGPURenderPipelineDescriptor pipelineDesc = {};
 
-                                    // Also set global for backwards compatibility with render pass methods
-                                    g_jsRenderPass = renderPass;
+                            // Check for layout property
+                            auto layoutProp = g_engine->getProperty(descriptor, "layout");
+                            if (!g_engine->isUndefined(layoutProp)) {
+                                // Check if it's "auto" string or a PipelineLayout object
+                                if (g_engine->isString(layoutProp)) {
+                                    std::string layoutStr = g_engine->toString(layoutProp);
+                                    if (layoutStr == "auto") {
+                                        pipelineDesc.layout = nullptr;  // Auto layout
+                                    }
+                                } else {
+                                    // It's a PipelineLayout object
+                                    WGPUPipelineLayout layout = (WGPUPipelineLayout)g_engine->getPrivateData(layoutProp);
+                                    pipelineDesc.layout = layout;
+                                }
+                            }
 
-                                    if (g_verboseLogging) std::cout << "[WebGPU] Render pass started (" << numAttachments << " attachments), clear: (" << firstR << "," << firstG << "," << firstB << "," << firstA << ")" << std::endl;
+                            // Vertex state
+                            pipelineDesc.vertex.module = vsModule;
+                            WGPU_SET_ENTRY_POINT(pipelineDesc.vertex, vertexEntry.c_str());
 
-                                    // Suspend frame tracking while creating render pass wrapper
-                                    g_engine->suspendFrameTracking();
+                            // Parse vertex buffers if present
+                            std::vector<WGPUVertexBufferLayout> vertexBuffers;
+                            std::vector<std::vector<WGPUVertexAttribute>> allAttributes; // Keep attributes alive
 
-                                    auto jsRenderPass = g_engine->newObject();
-                                    g_engine->setPrivateData(jsRenderPass, renderPass);
+                            auto buffersArray = g_engine->getProperty(vertex, "buffers");
+                            if (!g_engine->isUndefined(buffersArray)) {
+                                auto buffersLen = g_engine->getProperty(buffersArray, "length");
+                                int bufferCount = (int)g_engine->toNumber(buffersLen);
 
-                                    // renderPass.setPipeline(pipeline)
-                                    g_engine->setProperty(jsRenderPass, "setPipeline",
-                                        g_engine->newFunction("setPipeline", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                            if (args.empty()) return g_engine->newUndefined();
+                                for (int i = 0; i < bufferCount; i++) {
+                                    auto buffer = g_engine->getPropertyIndex(buffersArray, i);
 
-                                            WGPURenderPipeline pipeline = (WGPURenderPipeline)g_engine->getPrivateData(args[0]);
-                                            if (g_jsRenderPass && pipeline) {
-                                                wgpuRenderPassEncoderSetPipeline(g_jsRenderPass, pipeline);
-                                                if (g_verboseLogging) std::cout << "[WebGPU] Pipeline set" << std::endl;
-                                            }
+                                    WGPUVertexBufferLayout layout = {};
+                                    layout.arrayStride = (uint64_t)g_engine->toNumber(g_engine->getProperty(buffer, "arrayStride"));
+                                    layout.stepMode = WGPUVertexStepMode_Vertex;
 
-                                            return g_engine->newUndefined();
-                                        })
-                                    );
-
-                                    // renderPass.setBindGroup(index, bindGroup, dynamicOffsets?)
-                                    g_engine->setProperty(jsRenderPass, "setBindGroup",
-                                        g_engine->newFunction("setBindGroup", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                            if (args.size() < 2) {
-                                                g_engine->throwException("setBindGroup requires index and bindGroup");
-                                                return g_engine->newUndefined();
-                                            }
+                                    // Parse step mode if present
+                                    auto stepModeProp = g_engine->getProperty(buffer, "stepMode");
+                                    if (!g_engine->isUndefined(stepModeProp)) {
+                                        std::string stepModeStr = g_engine->toString(stepModeProp);
+                                        if (stepModeStr == "instance") {
+                                            layout.stepMode = WGPUVertexStepMode_Instance;
+                                        }
+                                    }
 
-                                            uint32_t groupIndex = (uint32_t)g_engine->toNumber(args[0]);
-                                            WGPUBindGroup bindGroup = (WGPUBindGroup)g_engine->getPrivateData(args[1]);
+                                    // Parse attributes
+                                    auto attrsArray = g_engine->getProperty(buffer, "attributes");
+                                    if (!g_engine->isUndefined(attrsArray)) {
+                                        auto attrsLen = g_engine->getProperty(attrsArray, "length");
+                                        int attrCount = (int)g_engine->toNumber(attrsLen);
 
-                                            if (g_jsRenderPass && bindGroup) {
-                                                // TODO: Support dynamic offsets
-                                                wgpuRenderPassEncoderSetBindGroup(g_jsRenderPass, groupIndex, bindGroup, 0, nullptr);
-                                                if (g_verboseLogging) std::cout << "[WebGPU] Set bind group at index " << groupIndex << std::endl;
-                                            }
+                                        std::vector<WGPUVertexAttribute> attributes;
+                                        for (int j = 0; j < attrCount; j++) {
+                                            auto attr = g_engine->getPropertyIndex(attrsArray, j);
 
-                                            return g_engine->newUndefined();
-                                        })
-                                    );
-
-                                    // renderPass.draw(vertexCount, instanceCount?, firstVertex?, firstInstance?)
-                                    g_engine->setProperty(jsRenderPass, "draw",
-                                        g_engine->newFunction("draw", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                            if (args.empty()) return g_engine->newUndefined();
-
-                                            uint32_t vertexCount = (uint32_t)g_engine->toNumber(args[0]);
-                                            uint32_t instanceCount = args.size() > 1 ? (uint32_t)g_engine->toNumber(args[1]) : 1;
-                                            uint32_t firstVertex = args.size() > 2 ? (uint32_t)g_engine->toNumber(args[2]) : 0;
-                                            uint32_t firstInstance = args.size() > 3 ? (uint32_t)g_engine->toNumber(args[3]) : 0;
-
-                                            if (g_jsRenderPass) {
-                                                wgpuRenderPassEncoderDraw(g_jsRenderPass, vertexCount, instanceCount, firstVertex, firstInstance);
-                                                if (g_verboseLogging) std::cout << "[WebGPU] Draw: " << vertexCount << " vertices" << std::endl;
-                                            }
+                                            WGPUVertexAttribute va = {};
+                                            va.shaderLocation = (uint32_t)g_engine->toNumber(g_engine->getProperty(attr, "shaderLocation"));
+                                            va.offset = (uint64_t)g_engine->toNumber(g_engine->getProperty(attr, "offset"));
 
-                                            return g_engine->newUndefined();
-                                        })
-                                    );
-
-                                    // renderPass.setVertexBuffer(slot, buffer, offset?, size?)
-                                    g_engine->setProperty(jsRenderPass, "setVertexBuffer",
-                                        g_engine->newFunction("setVertexBuffer", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                            if (args.size() < 2) return g_engine->newUndefined();
-
-                                            uint32_t slot = (uint32_t)g_engine->toNumber(args[0]);
-                                            WGPUBuffer buffer = (WGPUBuffer)g_engine->getPrivateData(args[1]);
-                                            uint64_t offset = args.size() > 2 ? (uint64_t)g_engine->toNumber(args[2]) : 0;
-                                            uint64_t size = args.size() > 3 ? (uint64_t)g_engine->toNumber(args[3]) : WGPU_WHOLE_SIZE;
-
-                                            if (g_jsRenderPass && buffer) {
-                                                wgpuRenderPassEncoderSetVertexBuffer(g_jsRenderPass, slot, buffer, offset, size);
-                                                if (g_verboseLogging) std::cout << "[WebGPU] Set vertex buffer at slot " << slot << std::endl;
-                                            }
+                                            std::string formatStr = g_engine->toString(g_engine->getProperty(attr, "format"));
+                                            // Parse vertex format
+                                            if (formatStr == "float32") va.format = WGPUVertexFormat_Float32;
+                                            else if (formatStr == "float32x2") va.format = WGPUVertexFormat_Float32x2;
+                                            else if (formatStr == "float32x3") va.format = WGPUVertexFormat_Float32x3;
+                                            else if (formatStr == "float32x4") va.format = WGPUVertexFormat_Float32x4;
+                                            else if (formatStr == "uint8x2") va.format = WGPUVertexFormat_Uint8x2;
+                                            else if (formatStr == "uint8x4") va.format = WGPUVertexFormat_Uint8x4;
+                                            else if (formatStr == "sint8x2") va.format = WGPUVertexFormat_Sint8x2;
+                                            else if (formatStr == "sint8x4") va.format = WGPUVertexFormat_Sint8x4;
+                                            else if (formatStr == "unorm8x2") va.format = WGPUVertexFormat_Unorm8x2;
+                                            else if (formatStr == "unorm8x4") va.format = WGPUVertexFormat_Unorm8x4;
+                                            else if (formatStr == "snorm8x2") va.format = WGPUVertexFormat_Snorm8x2;
+                                            else if (formatStr == "snorm8x4") va.format = WGPUVertexFormat_Snorm8x4;
+                                            else if (formatStr == "uint16x2") va.format = WGPUVertexFormat_Uint16x2;
+                                            else if (formatStr == "uint16x4") va.format = WGPUVertexFormat_Uint16x4;
+                                            else if (formatStr == "sint16x2") va.format = WGPUVertexFormat_Sint16x2;
+                                            else if (formatStr == "sint16x4") va.format = WGPUVertexFormat_Sint16x4;
+                                            else if (formatStr == "unorm16x2") va.format = WGPUVertexFormat_Unorm16x2;
+                                            else if (formatStr == "unorm16x4") va.format = WGPUVertexFormat_Unorm16x4;
+                                            else if (formatStr == "snorm16x2") va.format = WGPUVertexFormat_Snorm16x2;
+                                            else if (formatStr == "snorm16x4") va.format = WGPUVertexFormat_Snorm16x4;
+                                            else if (formatStr == "float16x2") va.format = WGPUVertexFormat_Float16x2;
+                                            else if (formatStr == "float16x4") va.format = WGPUVertexFormat_Float16x4;
+                                            else if (formatStr == "uint32") va.format = WGPUVertexFormat_Uint32;
+                                            else if (formatStr == "uint32x2") va.format = WGPUVertexFormat_Uint32x2;
+                                            else if (formatStr == "uint32x3") va.format = WGPUVertexFormat_Uint32x3;
+                                            else if (formatStr == "uint32x4") va.format = WGPUVertexFormat_Uint32x4;
+                                            else if (formatStr == "sint32") va.format = WGPUVertexFormat_Sint32;
+                                            else if (formatStr == "sint32x2") va.format = WGPUVertexFormat_Sint32x2;
+                                            else if (formatStr == "sint32x3") va.format = WGPUVertexFormat_Sint32x3;
+                                            else if (formatStr == "sint32x4") va.format = WGPUVertexFormat_Sint32x4;
+                                            else va.format = WGPUVertexFormat_Float32x3; // Default
 
-                                            return g_engine->newUndefined();
-                                        })
-                                    );
-
-                                    // renderPass.setIndexBuffer(buffer, format, offset?, size?)
-                                    g_engine->setProperty(jsRenderPass, "setIndexBuffer",
-                                        g_engine->newFunction("setIndexBuffer", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                            if (args.size() < 2) return g_engine->newUndefined();
-
-                                            WGPUBuffer buffer = (WGPUBuffer)g_engine->getPrivateData(args[0]);
-                                            std::string formatStr = g_engine->toString(args[1]);
-                                            uint64_t offset = args.size() > 2 ? (uint64_t)g_engine->toNumber(args[2]) : 0;
-                                            uint64_t size = args.size() > 3 ? (uint64_t)g_engine->toNumber(args[3]) : WGPU_WHOLE_SIZE;
-
-                                            WGPUIndexFormat format = WGPUIndexFormat_Uint16;
-                                            if (formatStr == "uint32") format = WGPUIndexFormat_Uint32;
-                                            else if (formatStr == "uint16") format = WGPUIndexFormat_Uint16;
-
-                                            if (g_jsRenderPass && buffer) {
-                                                wgpuRenderPassEncoderSetIndexBuffer(g_jsRenderPass, buffer, format, offset, size);
-                                                if (g_verboseLogging) std::cout << "[WebGPU] Set index buffer, format: " << formatStr << std::endl;
-                                            }
+                                            attributes.push_back(va);
+                                        }
 
-                                            return g_engine->newUndefined();
-                                        })
-                                    );
-
-                                    // renderPass.drawIndexed(indexCount, instanceCount?, firstIndex?, baseVertex?, firstInstance?)
-                                    g_engine->setProperty(jsRenderPass, "drawIndexed",
-                                        g_engine->newFunction("drawIndexed", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                            if (args.empty()) return g_engine->newUndefined();
-
-                                            uint32_t indexCount = (uint32_t)g_engine->toNumber(args[0]);
-                                            uint32_t instanceCount = args.size() > 1 ? (uint32_t)g_engine->toNumber(args[1]) : 1;
-                                            uint32_t firstIndex = args.size() > 2 ? (uint32_t)g_engine->toNumber(args[2]) : 0;
-                                            int32_t baseVertex = args.size() > 3 ? (int32_t)g_engine->toNumber(args[3]) : 0;
-                                            uint32_t firstInstance = args.size() > 4 ? (uint32_t)g_engine->toNumber(args[4]) : 0;
-
-                                            if (g_jsRenderPass) {
-                                                wgpuRenderPassEncoderDrawIndexed(g_jsRenderPass, indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
-                                                if (g_verboseLogging) std::cout << "[WebGPU] DrawIndexed: " << indexCount << " indices, firstInstance=" << firstInstance << std::endl;
-                                            }
+                                        allAttributes.push_back(attributes);
+                                        layout.attributeCount = attributes.size();
+                                        layout.attributes = allAttributes.back().data();
+                                    }
 
-                                            return g_engine->newUndefined();
-                                        })
-                                    );
+                                    vertexBuffers.push_back(layout);
+                                }
 
-                                    // renderPass.drawIndirect(indirectBuffer, indirectOffset)
-                                    g_engine->setProperty(jsRenderPass, "drawIndirect",
-                                        g_engine->newFunction("drawIndirect", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                            if (args.size() < 2) return g_engine->newUndefined();
+                                pipelineDesc.vertex.bufferCount = vertexBuffers.size();
+                                pipelineDesc.vertex.buffers = vertexBuffers.data();
+                            }
 
-                                            WGPUBuffer indirectBuffer = (WGPUBuffer)g_engine->getPrivateData(args[0]);
-                                            uint64_t indirectOffset = (uint64_t)g_engine->toNumber(args[1]);
+                            // Fragment state (only if fragment shader exists)
+                            WGPUColorTargetState colorTarget = {};
+                            WGPUFragmentState fragmentState = {};
+                            std::vector<WGPUColorTargetState> colorTargets;
+                            bool targetsExplicitlySpecified = false;
+                            if (hasFragment && fsModule) {
+                                // Parse targets from fragment descriptor
+                                auto targetsProp = g_engine->getProperty(fragment, "targets");
+                                if (!g_engine->isUndefined(targetsProp)) {
+                                    targetsExplicitlySpecified = true;  // Even if empty array
+                                    auto targetsLen = g_engine->getProperty(targetsProp, "length");
+                                    int targetCount = (int)g_engine->toNumber(targetsLen);
+                                    for (int i = 0; i < targetCount; i++) {
+                                        auto target = g_engine->getPropertyIndex(targetsProp, i);
+                                        WGPUColorTargetState targetState = {};
 
-                                            if (g_jsRenderPass && indirectBuffer) {
-                                                wgpuRenderPassEncoderDrawIndirect(g_jsRenderPass, indirectBuffer, indirectOffset);
-                                                if (g_verboseLogging) std::cout << "[WebGPU] DrawIndirect at offset " << indirectOffset << std::endl;
+                                        auto formatProp = g_engine->getProperty(target, "format");
+                                        if (!g_engine->isUndefined(formatProp)) {
+                                            std::string formatStr = g_engine->toString(formatProp);
+                                            targetState.format = stringToFormat(formatStr);
+                                            if (targetCount >= 5) {
+                                                if (g_verboseLogging) std::cout << "[WebGPU] Pipeline target " << i << ": format=" << formatStr << " (enum=" << targetState.format << ")" << std::endl;
                                             }
+                                        } else {
+                                            targetState.format = g_surfaceFormat;
+                                        }
+                                        targetState.writeMask = WGPUColorWriteMask_All;
 
-                                            return g_engine->newUndefined();
-                                        })
-                                    );
-
-                                    // renderPass.drawIndexedIndirect(indirectBuffer, indirectOffset)
-                                    g_engine->setProperty(jsRenderPass, "drawIndexedIndirect",
-                                        g_engine->newFunction("drawIndexedIndirect", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                            if (args.size() < 2) return g_engine->newUndefined();
-
-                                            WGPUBuffer indirectBuffer = (WGPUBuffer)g_engine->getPrivateData(args[0]);
-                                            uint64_t indirectOffset = (uint64_t)g_engine->toNumber(args[1]);
+                                        // Parse blend state if provided
+                                        auto blendProp = g_engine->getProperty(target, "blend");
+                                        if (!g_engine->isUndefined(blendProp)) {
+                                            // Store blend state in a persistent container
+                                            static std::vector<std::unique_ptr<WGPUBlendState>> blendStates;
+                                            auto blendState = std::make_unique<WGPUBlendState>();
 
-                                            if (g_jsRenderPass && indirectBuffer) {
-                                                wgpuRenderPassEncoderDrawIndexedIndirect(g_jsRenderPass, indirectBuffer, indirectOffset);
-                                                if (g_verboseLogging) std::cout << "[WebGPU] DrawIndexedIndirect at offset " << indirectOffset << std::endl;
-                                            }
+                                            // Helper lambda to parse blend factor
+                                            auto parseBlendFactor = [](const std::string& str) -> WGPUBlendFactor {
+                                                if (str == "zero") return WGPUBlendFactor_Zero;
+                                                if (str == "one") return WGPUBlendFactor_One;
+                                                if (str == "src") return WGPUBlendFactor_Src;
+                                                if (str == "one-minus-src") return WGPUBlendFactor_OneMinusSrc;
+                                                if (str == "src-alpha") return WGPUBlendFactor_SrcAlpha;
+                                                if (str == "one-minus-src-alpha") return WGPUBlendFactor_OneMinusSrcAlpha;
+                                                if (str == "dst") return WGPUBlendFactor_Dst;
+                                                if (str == "one-minus-dst") return WGPUBlendFactor_OneMinusDst;
+                                                if (str == "dst-alpha") return WGPUBlendFactor_DstAlpha;
+                                                if (str == "one-minus-dst-alpha") return WGPUBlendFactor_OneMinusDstAlpha;
+                                                if (str == "src-alpha-saturated") return WGPUBlendFactor_SrcAlphaSaturated;
+                                                if (str == "constant") return WGPUBlendFactor_Constant;
+                                                if (str == "one-minus-constant") return WGPUBlendFactor_OneMinusConstant;
+                                                return WGPUBlendFactor_One;  // Default
+                                            };
 
-                                            return g_engine->newUndefined();
-                                        })
-                                    );
-
-                                    // renderPass.setViewport(x, y, width, height, minDepth, maxDepth)
-                                    g_engine->setProperty(jsRenderPass, "setViewport",
-                                        g_engine->newFunction("setViewport", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                            if (args.size() < 6) return g_engine->newUndefined();
-
-                                            float x = (float)g_engine->toNumber(args[0]);
-                                            float y = (float)g_engine->toNumber(args[1]);
-                                            float width = (float)g_engine->toNumber(args[2]);
-                                            float height = (float)g_engine->toNumber(args[3]);
-                                            float minDepth = (float)g_engine->toNumber(args[4]);
-                                            float maxDepth = (float)g_engine->toNumber(args[5]);
-
-                                            if (g_jsRenderPass) {
-                                                wgpuRenderPassEncoderSetViewport(g_jsRenderPass, x, y, width, height, minDepth, maxDepth);
-                                                if (g_verboseLogging) std::cout << "[WebGPU] SetViewport: " << x << "," << y << " " << width << "x" << height << std::endl;
-                                            }
+                                            // Helper lambda to parse blend operation
+                                            auto parseBlendOp = [](const std::string& str) -> WGPUBlendOperation {
+                                                if (str == "add") return WGPUBlendOperation_Add;
+                                                if (str == "subtract") return WGPUBlendOperation_Subtract;
+                                                if (str == "reverse-subtract") return WGPUBlendOperation_ReverseSubtract;
+                                                if (str == "min") return WGPUBlendOperation_Min;
+                                                if (str == "max") return WGPUBlendOperation_Max;
+                                                return WGPUBlendOperation_Add;  // Default
+                                            };
 
-                                            return g_engine->newUndefined();
-                                        })
-                                    );
-
-                                    // renderPass.setScissorRect(x, y, width, height)
-                                    g_engine->setProperty(jsRenderPass, "setScissorRect",
-                                        g_engine->newFunction("setScissorRect", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                            if (args.size() < 4) return g_engine->newUndefined();
-
-                                            uint32_t x = (uint32_t)g_engine->toNumber(args[0]);
-                                            uint32_t y = (uint32_t)g_engine->toNumber(args[1]);
-                                            uint32_t width = (uint32_t)g_engine->toNumber(args[2]);
-                                            uint32_t height = (uint32_t)g_engine->toNumber(args[3]);
-
-                                            if (g_jsRenderPass) {
-                                                wgpuRenderPassEncoderSetScissorRect(g_jsRenderPass, x, y, width, height);
-                                                if (g_verboseLogging) std::cout << "[WebGPU] SetScissorRect: " << x << "," << y << " " << width << "x" << height << std::endl;
+                                            // Parse color blend component
+                                            auto colorProp = g_engine->getProperty(blendProp, "color");
+                                            if (!g_engine->isUndefined(colorProp)) {
+                                                auto srcFactor = g_engine->getProperty(colorProp, "srcFactor");
+                                                auto dstFactor = g_engine->getProperty(colorProp, "dstFactor");
+                                                auto operation = g_engine->getProperty(colorProp, "operation");
+                                                if (!g_engine->isUndefined(srcFactor))
+                                                    blendState->color.srcFactor = parseBlendFactor(g_engine->toString(srcFactor));
+                                                else
+                                                    blendState->color.srcFactor = WGPUBlendFactor_One;
+                                                if (!g_engine->isUndefined(dstFactor))
+                                                    blendState->color.dstFactor = parseBlendFactor(g_engine->toString(dstFactor));
+                                                else
+                                                    blendState->color.dstFactor = WGPUBlendFactor_Zero;
+                                                if (!g_engine->isUndefined(operation))
+                                                    blendState->color.operation = parseBlendOp(g_engine->toString(operation));
+                                                else
+                                                    blendState->color.operation = WGPUBlendOperation_Add;
+                                            } else {
+                                                // Default color blend (no blending)
+                                                blendState->color.srcFactor = WGPUBlendFactor_One;
+                                                blendState->color.dstFactor = WGPUBlendFactor_Zero;
+                                                blendState->color.operation = WGPUBlendOperation_Add;
                                             }
 
-                                            return g_engine->newUndefined();
-                                        })
-                                    );
-
-                                    // renderPass.setBlendConstant(color)
-                                    g_engine->setProperty(jsRenderPass, "setBlendConstant",
-                                        g_engine->newFunction("setBlendConstant", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                            if (args.empty()) return g_engine->newUndefined();
-
-                                            auto color = args[0];
-                                            WGPUColor blendColor = {};
-                                            if (g_engine->isArray(color)) {
-                                                blendColor.r = g_engine->toNumber(g_engine->getPropertyIndex(color, 0));
-                                                blendColor.g = g_engine->toNumber(g_engine->getPropertyIndex(color, 1));
-                                                blendColor.b = g_engine->toNumber(g_engine->getPropertyIndex(color, 2));
-                                                blendColor.a = g_engine->toNumber(g_engine->getPropertyIndex(color, 3));
+                                            // Parse alpha blend component
+                                            auto alphaProp = g_engine->getProperty(blendProp, "alpha");
+                                            if (!g_engine->isUndefined(alphaProp)) {
+                                                auto srcFactor = g_engine->getProperty(alphaProp, "srcFactor");
+                                                auto dstFactor = g_engine->getProperty(alphaProp, "dstFactor");
+                                                auto operation = g_engine->getProperty(alphaProp, "operation");
+                                                if (!g_engine->isUndefined(srcFactor))
+                                                    blendState->alpha.srcFactor = parseBlendFactor(g_engine->toString(srcFactor));
+                                                else
+                                                    blendState->alpha.srcFactor = WGPUBlendFactor_One;
+                                                if (!g_engine->isUndefined(dstFactor))
+                                                    blendState->alpha.dstFactor = parseBlendFactor(g_engine->toString(dstFactor));
+                                                else
+                                                    blendState->alpha.dstFactor = WGPUBlendFactor_Zero;
+                                                if (!g_engine->isUndefined(operation))
+                                                    blendState->alpha.operation = parseBlendOp(g_engine->toString(operation));
+                                                else
+                                                    blendState->alpha.operation = WGPUBlendOperation_Add;
                                             } else {
-                                                blendColor.r = g_engine->toNumber(g_engine->getProperty(color, "r"));
-                                                blendColor.g = g_engine->toNumber(g_engine->getProperty(color, "g"));
-                                                blendColor.b = g_engine->toNumber(g_engine->getProperty(color, "b"));
-                                                blendColor.a = g_engine->toNumber(g_engine->getProperty(color, "a"));
+                                                // Default alpha blend (no blending)
+                                                blendState->alpha.srcFactor = WGPUBlendFactor_One;
+                                                blendState->alpha.dstFactor = WGPUBlendFactor_Zero;
+                                                blendState->alpha.operation = WGPUBlendOperation_Add;
                                             }
 
-                                            if (g_jsRenderPass) {
-                                                wgpuRenderPassEncoderSetBlendConstant(g_jsRenderPass, &blendColor);
-                                            }
+                                            targetState.blend = blendState.get();
+                                            blendStates.push_back(std::move(blendState));
 
-                                            return g_engine->newUndefined();
-                                        })
-                                    );
+                                            if (g_verboseLogging) std::cout << "[WebGPU] Pipeline target " << i << " has blend state" << std::endl;
+                                        }
+
+                                        colorTargets.push_back(targetState);
+                                    }
+                                }
+                                // Only add default target if targets wasn't explicitly specified
+                                // If targets: [] was specified, don't add any (depth-only pass)
+                                if (colorTargets.empty() && !targetsExplicitlySpecified) {
+                                    // Default single target only when targets is not specified at all
+                                    colorTarget.format = g_surfaceFormat;
+                                    colorTarget.writeMask = WGPUColorWriteMask_All;
+                                    colorTargets.push_back(colorTarget);
+                                }
 
-                                    // renderPass.setStencilReference(reference)
-                                    g_engine->setProperty(jsRenderPass, "setStencilReference",
-                                        g_engine->newFunction("setStencilReference", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                            if (args.empty()) return g_engine->newUndefined();
+                                fragmentState.module = fsModule;
+                                WGPU_SET_ENTRY_POINT(fragmentState, fragmentEntry.c_str());
+                                fragmentState.targetCount = colorTargets.size();
+                                fragmentState.targets = colorTargets.data();
+                                pipelineDesc.fragment = &fragmentState;
+                                if (g_verboseLogging) std::cout << "[WebGPU] Render pipeline with " << colorTargets.size() << " color targets" << std::endl;
+                            } else {
+                                // Depth-only pipeline - no fragment state
+                                pipelineDesc.fragment = nullptr;
+                            }
 
-                                            uint32_t reference = (uint32_t)g_engine->toNumber(args[0]);
-                                            if (g_jsRenderPass) {
-                                                wgpuRenderPassEncoderSetStencilReference(g_jsRenderPass, reference);
-                                            }
+                            // Primitive state
+                            pipelineDesc.primitive.topology = WGPUPrimitiveTopology_TriangleList;
+                            pipelineDesc.primitive.stripIndexFormat = WGPUIndexFormat_Undefined;
+                            pipelineDesc.primitive.frontFace = WGPUFrontFace_CCW;
+                            pipelineDesc.primitive.cullMode = WGPUCullMode_None;
 
-                                            return g_engine->newUndefined();
-                                        })
-                                    );
-
-                                    // renderPass.executeBundles(bundles)
-                                    // Used by Three.js for mipmap generation
-                                    WGPURenderPassEncoder capturedRenderPassForBundles = renderPass;
-                                    g_engine->setProperty(jsRenderPass, "executeBundles",
-                                        g_engine->newFunction("executeBundles", [capturedRenderPassForBundles](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                            if (args.empty() || !capturedRenderPassForBundles) return g_engine->newUndefined();
-
-                                            auto bundlesArray = args[0];
-                                            auto lengthProp = g_engine->getProperty(bundlesArray, "length");
-                                            int bundleCount = g_engine->isUndefined(lengthProp) ? 0 : (int)g_engine->toNumber(lengthProp);
-
-                                            std::vector<WGPURenderBundle> bundles;
-                                            bundles.reserve(bundleCount);
-                                            for (int i = 0; i < bundleCount; i++) {
-                                                auto bundleHandle = g_engine->getPropertyIndex(bundlesArray, i);
-                                                WGPURenderBundle bundle = (WGPURenderBundle)g_engine->getPrivateData(bundleHandle);
-                                                if (bundle) bundles.push_back(bundle);
-                                            }
+                            // Parse primitive state if provided
+                            auto primitiveProp = g_engine->getProperty(descriptor, "primitive");
+                            if (!g_engine->isUndefined(primitiveProp)) {
+                                auto topologyProp = g_engine->getProperty(primitiveProp, "topology");
+                                if (!g_engine->isUndefined(topologyProp)) {
+                                    std::string topologyStr = g_engine->toString(topologyProp);
+                                    if (topologyStr == "point-list") pipelineDesc.primitive.topology = WGPUPrimitiveTopology_PointList;
+                                    else if (topologyStr == "line-list") pipelineDesc.primitive.topology = WGPUPrimitiveTopology_LineList;
+                                    else if (topologyStr == "line-strip") pipelineDesc.primitive.topology = WGPUPrimitiveTopology_LineStrip;
+                                    else if (topologyStr == "triangle-list") pipelineDesc.primitive.topology = WGPUPrimitiveTopology_TriangleList;
+                                    else if (topologyStr == "triangle-strip") pipelineDesc.primitive.topology = WGPUPrimitiveTopology_TriangleStrip;
+                                }
+                                auto cullModeProp = g_engine->getProperty(primitiveProp, "cullMode");
+                                if (!g_engine->isUndefined(cullModeProp)) {
+                                    std::string cullModeStr = g_engine->toString(cullModeProp);
+                                    if (cullModeStr == "none") pipelineDesc.primitive.cullMode = WGPUCullMode_None;
+                                    else if (cullModeStr == "front") pipelineDesc.primitive.cullMode = WGPUCullMode_Front;
+                                    else if (cullModeStr == "back") pipelineDesc.primitive.cullMode = WGPUCullMode_Back;
+                                }
+                                auto frontFaceProp = g_engine->getProperty(primitiveProp, "frontFace");
+                                if (!g_engine->isUndefined(frontFaceProp)) {
+                                    std::string frontFaceStr = g_engine->toString(frontFaceProp);
+                                    if (frontFaceStr == "ccw") pipelineDesc.primitive.frontFace = WGPUFrontFace_CCW;
+                                    else if (frontFaceStr == "cw") pipelineDesc.primitive.frontFace = WGPUFrontFace_CW;
+                                }
+                            }
 
-                                            if (!bundles.empty()) {
-                                                wgpuRenderPassEncoderExecuteBundles(capturedRenderPassForBundles, bundles.size(), bundles.data());
-                                                if (g_verboseLogging) std::cout << "[WebGPU] Executed " << bundles.size() << " render bundles" << std::endl;
-                                            }
+                            // Depth stencil state
+                            WGPUDepthStencilState depthStencilState = {};
+                            bool hasDepthStencil = false;
 
-                                            return g_engine->newUndefined();
-                                        })
-                                    );
-
-                                    // renderPass.end() - capture encoder and render pass for cleanup
-                                    WGPUCommandEncoder capturedEncoderForEnd = encoderToUse;
-                                    WGPURenderPassEncoder capturedRenderPass = renderPass;
-                                    g_engine->setProperty(jsRenderPass, "end",
-                                        g_engine->newFunction("end", [capturedEncoderForEnd, capturedRenderPass](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                            if (capturedRenderPass) {
-                                                wgpuRenderPassEncoderEnd(capturedRenderPass);
-                                                wgpuRenderPassEncoderRelease(capturedRenderPass);
-
-                                                // Remove from per-encoder map
-                                                g_encoderRenderPassMap.erase(capturedEncoderForEnd);
-
-                                                // Clear global if it matches
-                                                if (g_jsRenderPass == capturedRenderPass) {
-                                                    g_jsRenderPass = nullptr;
-                                                }
+                            auto depthStencilProp = g_engine->getProperty(descriptor, "depthStencil");
+                            if (!g_engine->isUndefined(depthStencilProp)) {
+                                hasDepthStencil = true;
 
-                                                // Mark surface render pass as ended
-                                                if (g_surfaceRenderEncoder == capturedEncoderForEnd) {
-                                                    g_surfaceRenderPassEnded = true;
-                                                }
-                                                if (g_verboseLogging) std::cout << "[WebGPU] Render pass ended" << std::endl;
-                                            }
-                                            return g_engine->newUndefined();
-                                        })
-                                    );
+                                auto formatProp = g_engine->getProperty(depthStencilProp, "format");
+                                if (!g_engine->isUndefined(formatProp)) {
+                                    depthStencilState.format = stringToFormat(g_engine->toString(formatProp));
+                                } else {
+                                    depthStencilState.format = WGPUTextureFormat_Depth24Plus;
+                                }
 
-                                    // Resume frame tracking
-                                    g_engine->resumeFrameTracking();
+                                auto depthWriteEnabledProp = g_engine->getProperty(depthStencilProp, "depthWriteEnabled");
+                                depthStencilState.depthWriteEnabled = g_engine->isUndefined(depthWriteEnabledProp)
+                                    ? WGPU_OPTIONAL_BOOL_TRUE
+                                    : (g_engine->toBoolean(depthWriteEnabledProp) ? WGPU_OPTIONAL_BOOL_TRUE : WGPU_OPTIONAL_BOOL_FALSE);
 
-                                    return jsRenderPass;
-                                })
-                            );
+                                auto depthCompareProp = g_engine->getProperty(depthStencilProp, "depthCompare");
+                                if (!g_engine->isUndefined(depthCompareProp)) {
+                                    std::string compareStr = g_engine->toString(depthCompareProp);
+                                    if (compareStr == "never") depthStencilState.depthCompare = WGPUCompareFunction_Never;
+                                    else if (compareStr == "less") depthStencilState.depthCompare = WGPUCompareFunction_Less;
+                                    else if (compareStr == "less-equal") depthStencilState.depthCompare = WGPUCompareFunction_LessEqual;
+                                    else if (compareStr == "greater") depthStencilState.depthCompare = WGPUCompareFunction_Greater;
+                                    else if (compareStr == "greater-equal") depthStencilState.depthCompare = WGPUCompareFunction_GreaterEqual;
+                                    else if (compareStr == "equal") depthStencilState.depthCompare = WGPUCompareFunction_Equal;
+                                    else if (compareStr == "not-equal") depthStencilState.depthCompare = WGPUCompareFunction_NotEqual;
+                                    else if (compareStr == "always") depthStencilState.depthCompare = WGPUCompareFunction_Always;
+                                } else {
+                                    depthStencilState.depthCompare = WGPUCompareFunction_Less;
+                                }
 
-                            // encoder.beginComputePass(descriptor?)
-                            g_engine->setProperty(jsEncoder, "beginComputePass",
-                                g_engine->newFunction("beginComputePass", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    if (!g_jsCommandEncoder) {
-                                        g_engine->throwException("No command encoder");
-                                        return g_engine->newUndefined();
-                                    }
+                                // Default stencil operations
+                                depthStencilState.stencilFront.compare = WGPUCompareFunction_Always;
+                                depthStencilState.stencilFront.failOp = WGPUStencilOperation_Keep;
+                                depthStencilState.stencilFront.depthFailOp = WGPUStencilOperation_Keep;
+                                depthStencilState.stencilFront.passOp = WGPUStencilOperation_Keep;
+                                depthStencilState.stencilBack = depthStencilState.stencilFront;
+                                depthStencilState.stencilReadMask = 0xFFFFFFFF;
+                                depthStencilState.stencilWriteMask = 0xFFFFFFFF;
 
-                                    WGPUComputePassDescriptor computePassDesc = {};
-                                    g_jsComputePass = wgpuCommandEncoderBeginComputePass(g_jsCommandEncoder, &computePassDesc);
+                                pipelineDesc.depthStencil = &depthStencilState;
+                            }
 
-                                    auto jsComputePass = g_engine->newObject();
+                            // Multisample state - parse from descriptor or use defaults
+                            pipelineDesc.multisample.count = 1;
+                            pipelineDesc.multisample.mask = 0xFFFFFFFF;
+                            pipelineDesc.multisample.alphaToCoverageEnabled = false;
 
-                                    // computePass.setPipeline(pipeline)
-                                    g_engine->setProperty(jsComputePass, "setPipeline",
-                                        g_engine->newFunction("setPipeline", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                            if (args.empty()) return g_engine->newUndefined();
-                                            WGPUComputePipeline pipeline = (WGPUComputePipeline)g_engine->getPrivateData(args[0]);
-                                            if (g_jsComputePass && pipeline) {
-                                                wgpuComputePassEncoderSetPipeline(g_jsComputePass, pipeline);
-                                            }
-                                            return g_engine->newUndefined();
-                                        })
-                                    );
-
-                                    // computePass.setBindGroup(index, bindGroup, dynamicOffsets?)
-                                    g_engine->setProperty(jsComputePass, "setBindGroup",
-                                        g_engine->newFunction("setBindGroup", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                            if (args.size() < 2) return g_engine->newUndefined();
-                                            uint32_t index = (uint32_t)g_engine->toNumber(args[0]);
-                                            WGPUBindGroup bindGroup = (WGPUBindGroup)g_engine->getPrivateData(args[1]);
-                                            if (g_jsComputePass && bindGroup) {
-                                                wgpuComputePassEncoderSetBindGroup(g_jsComputePass, index, bindGroup, 0, nullptr);
-                                            }
-                                            return g_engine->newUndefined();
-                                        })
-                                    );
-
-                                    // computePass.dispatchWorkgroups(countX, countY?, countZ?)
-                                    g_engine->setProperty(jsComputePass, "dispatchWorkgroups",
-                                        g_engine->newFunction("dispatchWorkgroups", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                            if (args.empty()) return g_engine->newUndefined();
-                                            uint32_t countX = (uint32_t)g_engine->toNumber(args[0]);
-                                            uint32_t countY = args.size() > 1 ? (uint32_t)g_engine->toNumber(args[1]) : 1;
-                                            uint32_t countZ = args.size() > 2 ? (uint32_t)g_engine->toNumber(args[2]) : 1;
-                                            if (g_jsComputePass) {
-                                                wgpuComputePassEncoderDispatchWorkgroups(g_jsComputePass, countX, countY, countZ);
-                                            }
-                                            return g_engine->newUndefined();
-                                        })
-                                    );
-
-                                    // computePass.end()
-                                    g_engine->setProperty(jsComputePass, "end",
-                                        g_engine->newFunction("end", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                            if (g_jsComputePass) {
-                                                wgpuComputePassEncoderEnd(g_jsComputePass);
-                                                wgpuComputePassEncoderRelease(g_jsComputePass);
-                                                g_jsComputePass = nullptr;
-                                            }
-                                            return g_engine->newUndefined();
-                                        })
-                                    );
+                            auto multisampleProp = g_engine->getProperty(descriptor, "multisample");
+                            if (!g_engine->isUndefined(multisampleProp)) {
+                                auto countProp = g_engine->getProperty(multisampleProp, "count");
+                                if (!g_engine->isUndefined(countProp)) {
+                                    pipelineDesc.multisample.count = (uint32_t)g_engine->toNumber(countProp);
+                                }
 
-                                    if (g_verboseLogging) std::cout << "[WebGPU] Compute pass started" << std::endl;
-                                    return jsComputePass;
-                                })
-                            );
+                                auto maskProp = g_engine->getProperty(multisampleProp, "mask");
+                                if (!g_engine->isUndefined(maskProp)) {
+                                    pipelineDesc.multisample.mask = (uint32_t)g_engine->toNumber(maskProp);
+                                }
 
-                            // encoder.copyBufferToBuffer(source, sourceOffset, destination, destinationOffset, size)
-                            g_engine->setProperty(jsEncoder, "copyBufferToBuffer",
-                                g_engine->newFunction("copyBufferToBuffer", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    if (args.size() < 5 || !g_jsCommandEncoder) return g_engine->newUndefined();
+                                auto alphaToCoverageProp = g_engine->getProperty(multisampleProp, "alphaToCoverageEnabled");
+                                if (!g_engine->isUndefined(alphaToCoverageProp)) {
+                                    pipelineDesc.multisample.alphaToCoverageEnabled = g_engine->toBoolean(alphaToCoverageProp);
+                                }
 
-                                    WGPUBuffer source = (WGPUBuffer)g_engine->getPrivateData(args[0]);
-                                    uint64_t sourceOffset = (uint64_t)g_engine->toNumber(args[1]);
-                                    WGPUBuffer destination = (WGPUBuffer)g_engine->getPrivateData(args[2]);
-                                    uint64_t destOffset = (uint64_t)g_engine->toNumber(args[3]);
-                                    uint64_t size = (uint64_t)g_engine->toNumber(args[4]);
+                                if (g_verboseLogging) {
+                                    std::cout << "[WebGPU] Render pipeline multisample: count=" << pipelineDesc.multisample.count
+                                              << ", mask=" << pipelineDesc.multisample.mask << std::endl;
+                                }
+                            }
 
-                                    if (source && destination) {
-                                        wgpuCommandEncoderCopyBufferToBuffer(g_jsCommandEncoder, source, sourceOffset, destination, destOffset, size);
-                                    }
-                                    return g_engine->newUndefined();
-                                })
-                            );
+                            // Create pipeline
+                            WGPURenderPipeline pipeline = wgpuDeviceCreateRenderPipeline(g_device, &pipelineDesc);
+                            if (!pipeline) {
+                                g_engine->throwException("Failed to create render pipeline");
+                                return g_engine->newUndefined();
+                            }
 
-                            // encoder.copyBufferToTexture(source, destination, copySize)
-                            g_engine->setProperty(jsEncoder, "copyBufferToTexture",
-                                g_engine->newFunction("copyBufferToTexture", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    if (args.size() < 3 || !g_jsCommandEncoder) return g_engine->newUndefined();
-
-                                    auto sourceProp = args[0];
-                                    auto destProp = args[1];
-                                    auto sizeProp = args[2];
-
-                                    // Source (buffer info)
-                                    WGPUBuffer buffer = (WGPUBuffer)g_engine->getPrivateData(g_engine->getProperty(sourceProp, "buffer"));
-                                    uint64_t offset = (uint64_t)g_engine->toNumber(g_engine->getProperty(sourceProp, "offset"));
-                                    uint32_t bytesPerRow = (uint32_t)g_engine->toNumber(g_engine->getProperty(sourceProp, "bytesPerRow"));
-                                    uint32_t rowsPerImage = (uint32_t)g_engine->toNumber(g_engine->getProperty(sourceProp, "rowsPerImage"));
-
-                                    // Destination (texture info)
-                                    WGPUTexture texture = (WGPUTexture)g_engine->getPrivateData(g_engine->getProperty(destProp, "texture"));
-                                    uint32_t mipLevel = (uint32_t)g_engine->toNumber(g_engine->getProperty(destProp, "mipLevel"));
-                                    auto originProp = g_engine->getProperty(destProp, "origin");
-                                    uint32_t originX = 0, originY = 0, originZ = 0;
-                                    if (!g_engine->isUndefined(originProp)) {
-                                        originX = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originProp, 0));
-                                        originY = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originProp, 1));
-                                        originZ = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originProp, 2));
-                                    }
+                            // Register pipeline for getBindGroupLayout
+                            uint64_t pipelineId = g_nextRenderPipelineId++;
+                            g_renderPipelineRegistry[pipelineId] = pipeline;
 
-                                    // Copy size
-                                    uint32_t width = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeProp, 0));
-                                    uint32_t height = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeProp, 1));
-                                    uint32_t depthOrLayers = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeProp, 2));
-                                    if (depthOrLayers == 0) depthOrLayers = 1;
-
-                                    if (buffer && texture) {
-                                        WGPUImageCopyBuffer_Compat srcCopy = {};
-                                        srcCopy.buffer = buffer;
-                                        srcCopy.layout.offset = offset;
-                                        srcCopy.layout.bytesPerRow = bytesPerRow;
-                                        srcCopy.layout.rowsPerImage = rowsPerImage > 0 ? rowsPerImage : height;
-
-                                        WGPUImageCopyTexture_Compat dstCopy = {};
-                                        dstCopy.texture = texture;
-                                        dstCopy.mipLevel = mipLevel;
-                                        dstCopy.origin = {originX, originY, originZ};
-
-                                        WGPUExtent3D copySize = {width, height, depthOrLayers};
-                                        wgpuCommandEncoderCopyBufferToTexture(g_jsCommandEncoder, &srcCopy, &dstCopy, &copySize);
-                                    }
-                                    return g_engine->newUndefined();
-                                })
-                            );
+                            auto jsPipeline = g_engine->newObject();
+                            g_engine->setPrivateData(jsPipeline, pipeline);
+                            g_engine->setProperty(jsPipeline, "_pipelineId", g_engine->newNumber((double)pipelineId));
+                            g_engine->setProperty(jsPipeline, "_type", g_engine->newString("renderPipeline"));
 
-                            // encoder.copyTextureToBuffer(source, destination, copySize)
-                            g_engine->setProperty(jsEncoder, "copyTextureToBuffer",
-                                g_engine->newFunction("copyTextureToBuffer", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    if (args.size() < 3 || !g_jsCommandEncoder) return g_engine->newUndefined();
-
-                                    auto sourceProp = args[0];
-                                    auto destProp = args[1];
-                                    auto sizeProp = args[2];
-
-                                    // Source (texture info)
-                                    WGPUTexture texture = (WGPUTexture)g_engine->getPrivateData(g_engine->getProperty(sourceProp, "texture"));
-                                    uint32_t mipLevel = (uint32_t)g_engine->toNumber(g_engine->getProperty(sourceProp, "mipLevel"));
-                                    auto originProp = g_engine->getProperty(sourceProp, "origin");
-                                    uint32_t originX = 0, originY = 0, originZ = 0;
-                                    if (!g_engine->isUndefined(originProp)) {
-                                        originX = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originProp, 0));
-                                        originY = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originProp, 1));
-                                        originZ = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(originProp, 2));
+                            // Add getBindGroupLayout method using captured pipelineId
+                            g_engine->setProperty(jsPipeline, "getBindGroupLayout",
+                                g_engine->newFunction("getBindGroupLayout", [pipelineId](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                                    auto it = g_renderPipelineRegistry.find(pipelineId);
+                                    if (it == g_renderPipelineRegistry.end() || !it->second) {
+                                        std::cerr << "[WebGPU] getBindGroupLayout: Render pipeline not found" << std::endl;
+                                        return g_engine->newUndefined();
                                     }
 
-                                    // Destination (buffer info)
-                                    WGPUBuffer buffer = (WGPUBuffer)g_engine->getPrivateData(g_engine->getProperty(destProp, "buffer"));
-                                    uint64_t offset = (uint64_t)g_engine->toNumber(g_engine->getProperty(destProp, "offset"));
-                                    uint32_t bytesPerRow = (uint32_t)g_engine->toNumber(g_engine->getProperty(destProp, "bytesPerRow"));
-                                    uint32_t rowsPerImage = (uint32_t)g_engine->toNumber(g_engine->getProperty(destProp, "rowsPerImage"));
-
-                                    // Copy size - can be array [w,h,d] or object {width, height, depthOrArrayLayers}
-                                    uint32_t width = 0, height = 0, depthOrLayers = 1;
-                                    auto widthProp = g_engine->getProperty(sizeProp, "width");
-                                    if (!g_engine->isUndefined(widthProp)) {
-                                        // Object format: { width, height, depthOrArrayLayers }
-                                        width = (uint32_t)g_engine->toNumber(widthProp);
-                                        height = (uint32_t)g_engine->toNumber(g_engine->getProperty(sizeProp, "height"));
-                                        auto depthProp = g_engine->getProperty(sizeProp, "depthOrArrayLayers");
-                                        depthOrLayers = g_engine->isUndefined(depthProp) ? 1 : (uint32_t)g_engine->toNumber(depthProp);
-                                    } else {
-                                        // Array format: [width, height, depth]
-                                        width = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeProp, 0));
-                                        height = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeProp, 1));
-                                        depthOrLayers = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeProp, 2));
-                                    }
-                                    if (depthOrLayers == 0) depthOrLayers = 1;
+                                    uint32_t groupIndex = args.empty() ? 0 : (uint32_t)g_engine->toNumber(args[0]);
+                                    WGPUBindGroupLayout layout = wgpuRenderPipelineGetBindGroupLayout(it->second, groupIndex);
 
-                                    if (g_verboseLogging) {
-                                        std::cout << "[WebGPU] copyTextureToBuffer: texture=" << texture
-                                                  << ", buffer=" << buffer
-                                                  << ", size=" << width << "x" << height << "x" << depthOrLayers
-                                                  << ", bytesPerRow=" << bytesPerRow << std::endl;
+                                    if (!layout) {
+                                        std::cerr << "[WebGPU] getBindGroupLayout: Failed to get layout for group " << groupIndex << std::endl;
+                                        return g_engine->newUndefined();
                                     }
 
-                                    if (buffer && texture) {
-                                        WGPUImageCopyTexture_Compat srcCopy = {};
-                                        srcCopy.texture = texture;
-                                        srcCopy.mipLevel = mipLevel;
-                                        srcCopy.origin = {originX, originY, originZ};
-
-                                        WGPUImageCopyBuffer_Compat dstCopy = {};
-                                        dstCopy.buffer = buffer;
-                                        dstCopy.layout.offset = offset;
-                                        dstCopy.layout.bytesPerRow = bytesPerRow;
-                                        dstCopy.layout.rowsPerImage = rowsPerImage > 0 ? rowsPerImage : height;
+                                    auto jsLayout = g_engine->newObject();
+                                    g_engine->setPrivateData(jsLayout, layout);
+                                    g_engine->setProperty(jsLayout, "_type", g_engine->newString("bindGroupLayout"));
 
-                                        WGPUExtent3D copySize = {width, height, depthOrLayers};
-                                        wgpuCommandEncoderCopyTextureToBuffer(g_jsCommandEncoder, &srcCopy, &dstCopy, &copySize);
-                                    }
-                                    return g_engine->newUndefined();
+                                    return jsLayout;
                                 })
                             );
 
-                            // encoder.copyTextureToTexture(source, destination, copySize)
-                            g_engine->setProperty(jsEncoder, "copyTextureToTexture",
-                                g_engine->newFunction("copyTextureToTexture", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    if (args.size() < 3 || !g_jsCommandEncoder) return g_engine->newUndefined();
-
-                                    auto sourceProp = args[0];
-                                    auto destProp = args[1];
-                                    auto sizeProp = args[2];
-
-                                    // Source texture
-                                    WGPUTexture srcTexture = (WGPUTexture)g_engine->getPrivateData(g_engine->getProperty(sourceProp, "texture"));
-                                    uint32_t srcMipLevel = (uint32_t)g_engine->toNumber(g_engine->getProperty(sourceProp, "mipLevel"));
-                                    auto srcOriginProp = g_engine->getProperty(sourceProp, "origin");
-                                    uint32_t srcOriginX = 0, srcOriginY = 0, srcOriginZ = 0;
-                                    if (!g_engine->isUndefined(srcOriginProp)) {
-                                        srcOriginX = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(srcOriginProp, 0));
-                                        srcOriginY = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(srcOriginProp, 1));
-                                        srcOriginZ = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(srcOriginProp, 2));
-                                    }
-
-                                    // Destination texture
-                                    WGPUTexture dstTexture = (WGPUTexture)g_engine->getPrivateData(g_engine->getProperty(destProp, "texture"));
-                                    uint32_t dstMipLevel = (uint32_t)g_engine->toNumber(g_engine->getProperty(destProp, "mipLevel"));
-                                    auto dstOriginProp = g_engine->getProperty(destProp, "origin");
-                                    uint32_t dstOriginX = 0, dstOriginY = 0, dstOriginZ = 0;
-                                    if (!g_engine->isUndefined(dstOriginProp)) {
-                                        dstOriginX = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(dstOriginProp, 0));
-                                        dstOriginY = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(dstOriginProp, 1));
-                                        dstOriginZ = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(dstOriginProp, 2));
-                                    }
+                            if (g_verboseLogging) std::cout << "[WebGPU] Render pipeline created (id=" << pipelineId << ")" << std::endl;
+                            return jsPipeline;
+                        })
+                    );
 
-                                    // Copy size - handle both array and object forms
-                                    uint32_t width = 1, height = 1, depthOrLayers = 1;
-                                    if (g_engine->isArray(sizeProp)) {
-                                        width = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeProp, 0));
-                                        height = (uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(sizeProp, 1));
-                                        auto depthVal = g_engine->getPropertyIndex(sizeProp, 2);
-                                        if (!g_engine->isUndefined(depthVal)) {
-                                            depthOrLayers = (uint32_t)g_engine->toNumber(depthVal);
-                                        }
-                                    } else {
-                                        width = (uint32_t)g_engine->toNumber(g_engine->getProperty(sizeProp, "width"));
-                                        height = (uint32_t)g_engine->toNumber(g_engine->getProperty(sizeProp, "height"));
-                                        auto depthVal = g_engine->getProperty(sizeProp, "depthOrArrayLayers");
-                                        if (!g_engine->isUndefined(depthVal)) {
-                                            depthOrLayers = (uint32_t)g_engine->toNumber(depthVal);
-                                        }
-                                    }
-                                    if (depthOrLayers == 0) depthOrLayers = 1;
+                    // device.createComputePipeline(descriptor)
+                    g_engine->setProperty(device, "createComputePipeline",
+                        g_engine->newFunction("createComputePipeline", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                            MYSTRAL_TRACE_SCOPE_CAT("gpu.createComputePipeline", "webgpu");
+                            if (args.empty()) {
+                                g_engine->throwException("createComputePipeline requires a descriptor");
+                                return g_engine->newUndefined();
+                            }
 
-                                    if (srcTexture && dstTexture) {
-                                        WGPUImageCopyTexture_Compat srcCopy = {};
-                                        srcCopy.texture = srcTexture;
-                                        srcCopy.mipLevel = srcMipLevel;
-                                        srcCopy.origin = {srcOriginX, srcOriginY, srcOriginZ};
+                            auto descriptor = args[0];
 
-                                        WGPUImageCopyTexture_Compat dstCopy = {};
-                                        dstCopy.texture = dstTexture;
-                                        dstCopy.mipLevel = dstMipLevel;
-                                        dstCopy.origin = {dstOriginX, dstOriginY, dstOriginZ};
+                            // Get layout
+                            auto layoutProp = g_engine->getProperty(descriptor, "layout");
+                            WGPUPipelineLayout layout = nullptr;
+                            bool isAutoLayout = false;
+                            if (!g_engine->isUndefined(layoutProp) && !g_engine->isString(layoutProp)) {
+                                layout = (WGPUPipelineLayout)g_engine->getPrivateData(layoutProp);
+                            } else if (g_engine->isString(layoutProp)) {
+                                std::string layoutStr = g_engine->toString(layoutProp);
+                                if (layoutStr == "auto") {
+                                    isAutoLayout = true;
+                                    if (g_verboseLogging) std::cout << "[WebGPU] Using 'auto' layout for compute pipeline" << std::endl;
+                                    std::cout.flush();
+                                }
+                            }
 
-                                        WGPUExtent3D copySize = {width, height, depthOrLayers};
-                                        wgpuCommandEncoderCopyTextureToTexture(g_jsCommandEncoder, &srcCopy, &dstCopy, &copySize);
-                                    }
-                                    return g_engine->newUndefined();
-                                })
-                            );
+                            // Get compute stage
+                            auto computeProp = g_engine->getProperty(descriptor, "compute");
+                            auto moduleProp = g_engine->getProperty(computeProp, "module");
+                            WGPUShaderModule module = (WGPUShaderModule)g_engine->getPrivateData(moduleProp);
 
-                            // encoder.clearBuffer(buffer, offset?, size?)
-                            g_engine->setProperty(jsEncoder, "clearBuffer",
-                                g_engine->newFunction("clearBuffer", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    if (args.empty() || !g_jsCommandEncoder) return g_engine->newUndefined();
+                            // Entry point (default "main")
+                            std::string entryPoint = "main";
+                            auto entryPointProp = g_engine->getProperty(computeProp, "entryPoint");
+                            if (!g_engine->isUndefined(entryPointProp)) {
+                                entryPoint = g_engine->toString(entryPointProp);
+                            }
 
-                                    WGPUBuffer buffer = (WGPUBuffer)g_engine->getPrivateData(args[0]);
-                                    uint64_t offset = args.size() > 1 ? (uint64_t)g_engine->toNumber(args[1]) : 0;
-                                    uint64_t size = args.size() > 2 ? (uint64_t)g_engine->toNumber(args[2]) : WGPU_WHOLE_SIZE;
+                            // Create pipeline
+                            WGPUComputePipelineDescriptor pipelineDesc = {};
+                            pipelineDesc.layout = layout;
+                            pipelineDesc.compute.module = module;
+                            WGPU_SET_ENTRY_POINT(pipelineDesc.compute, entryPoint.c_str());
 
-                                    if (buffer) {
-                                        wgpuCommandEncoderClearBuffer(g_jsCommandEncoder, buffer, offset, size);
-                                    }
-                                    return g_engine->newUndefined();
-                                })
-                            );
+                            WGPUComputePipeline pipeline = wgpuDeviceCreateComputePipeline(g_device, &pipelineDesc);
+                            if (!pipeline) {
+                                g_engine->throwException("Failed to create compute pipeline");
+                                return g_engine->newUndefined();
+                            }
 
-                            // encoder.finish(descriptor?)
-                            g_engine->setProperty(jsEncoder, "finish",
-                                g_engine->newFunction("finish", [capturedEncoder](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    // Use captured encoder for this specific command encoder
-                                    WGPUCommandEncoder encoderToFinish = capturedEncoder;
-
-                                    // Auto-end any active render/compute passes for THIS encoder
-                                    // Look up from per-encoder map, not global
-                                    auto renderPassIt = g_encoderRenderPassMap.find(encoderToFinish);
-                                    if (renderPassIt != g_encoderRenderPassMap.end() && renderPassIt->second) {
-                                        WGPURenderPassEncoder renderPass = renderPassIt->second;
-                                        if (g_verboseLogging) std::cout << "[WebGPU] Auto-ending render pass (pass=" << (void*)renderPass << ", encoder=" << (void*)encoderToFinish << ")" << std::endl;
-                                        wgpuRenderPassEncoderEnd(renderPass);
-                                        wgpuRenderPassEncoderRelease(renderPass);
-                                        g_encoderRenderPassMap.erase(renderPassIt);
-
-                                        // Clear global if it matches
-                                        if (g_jsRenderPass == renderPass) {
-                                            g_jsRenderPass = nullptr;
-                                        }
+                            // Register pipeline for getBindGroupLayout
+                            uint64_t pipelineId = g_nextComputePipelineId++;
+                            g_computePipelineRegistry[pipelineId] = pipeline;
 
-                                        // Mark surface render pass as ended
-                                        if (g_surfaceRenderEncoder == encoderToFinish) {
-                                            g_surfaceRenderPassEnded = true;
-                                            if (g_verboseLogging) std::cout << "[WebGPU] Surface render pass auto-ended (encoder=" << (void*)encoderToFinish << ")" << std::endl;
-                                        }
-                                    }
+                            auto jsPipeline = g_engine->newObject();
+                            g_engine->setPrivateData(jsPipeline, pipeline);
+                            g_engine->setProperty(jsPipeline, "_pipelineId", g_engine->newNumber((double)pipelineId));
+                            g_engine->setProperty(jsPipeline, "_type", g_engine->newString("computePipeline"));
 
-                                    auto computePassIt = g_encoderComputePassMap.find(encoderToFinish);
-                                    if (computePassIt != g_encoderComputePassMap.end() && computePassIt->second) {
-                                        WGPUComputePassEncoder computePass = computePassIt->second;
-                                        if (g_verboseLogging) std::cout << "[WebGPU] Auto-ending compute pass (pass=" << (void*)computePass << ", encoder=" << (void*)encoderToFinish << ")" << std::endl;
-                                        wgpuComputePassEncoderEnd(computePass);
-                                        wgpuComputePassEncoderRelease(computePass);
-                                        g_encoderComputePassMap.erase(computePassIt);
-
-                                        // Clear global if it matches
-                                        if (g_jsComputePass == computePass) {
-                                            g_jsComputePass = nullptr;
-                                        }
+                            // Add getBindGroupLayout method using captured pipelineId
+                            g_engine->setProperty(jsPipeline, "getBindGroupLayout",
+                                g_engine->newFunction("getBindGroupLayout", [pipelineId](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                                    auto it = g_computePipelineRegistry.find(pipelineId);
+                                    if (it == g_computePipelineRegistry.end() || !it->second) {
+                                        std::cerr << "[WebGPU] getBindGroupLayout: Compute pipeline not found" << std::endl;
+                                        return g_engine->newUndefined();
                                     }
 
-                                    WGPUCommandBufferDescriptor cmdDesc = {};
-                                    WGPUCommandBuffer cmdBuffer = nullptr;
-
-                                    if (encoderToFinish) {
-                                        cmdBuffer = wgpuCommandEncoderFinish(encoderToFinish, &cmdDesc);
-                                        wgpuCommandEncoderRelease(encoderToFinish);
-
-                                        // Clear global if it matches
-                                        if (g_jsCommandEncoder == encoderToFinish) {
-                                            g_jsCommandEncoder = nullptr;
-                                        }
+                                    uint32_t groupIndex = args.empty() ? 0 : (uint32_t)g_engine->toNumber(args[0]);
+                                    WGPUBindGroupLayout layout = wgpuComputePipelineGetBindGroupLayout(it->second, groupIndex);
 
-                                        if (g_verboseLogging) std::cout << "[WebGPU] Command encoder finished, buffer: " << cmdBuffer << std::endl;
+                                    if (!layout) {
+                                        std::cerr << "[WebGPU] getBindGroupLayout: Failed to get layout for group " << groupIndex << std::endl;
+                                        return g_engine->newUndefined();
                                     }
 
-                                    auto jsCommandBuffer = g_engine->newObject();
-                                    g_engine->setPrivateData(jsCommandBuffer, cmdBuffer);
+                                    auto jsLayout = g_engine->newObject();
+                                    g_engine->setPrivateData(jsLayout, layout);
+                                    g_engine->setProperty(jsLayout, "_type", g_engine->newString("bindGroupLayout"));
 
-                                    return jsCommandBuffer;
+                                    return jsLayout;
                                 })
                             );
 
-                            // Resume frame tracking now that encoder wrapper is created
-                            g_engine->resumeFrameTracking();
-
-                            return jsEncoder;
+                            if (g_verboseLogging) std::cout << "[WebGPU] Compute pipeline created (id=" << pipelineId << ")" << std::endl;
+                            return jsPipeline;
                         })
                     );
 
+                    // device.createCommandEncoder(descriptor?)
+                    g_engine->setProperty(device, "createCommandEncoder", g_engine->newFunction("createCommandEncoder", createCommandEncoder));
+
                     // device.createTexture(descriptor)
                     g_engine->setProperty(device, "createTexture",
                         g_engine->newFunction("createTexture", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
@@ -3202,6 +3656,8 @@ bool initBindings(js::Engine* engine, void* wgpuInstance, void* wgpuDevice, void
                             // Register texture for lookup by createView
                             uint64_t textureId = g_nextTextureId++;
                             g_textureRegistry[textureId] = {texture, format, width, height, depthOrArrayLayers, mipLevelCount, dimension};
+                            uint64_t bytes = textureBytes(format, width, height, depthOrArrayLayers, mipLevelCount, sampleCount, dimension);
+                            g_gpuTextureBytes.fetch_add(bytes, std::memory_order_relaxed);
 
                             // Store texture ID for lookup
                             g_engine->setProperty(jsTexture, "_textureId", g_engine->newNumber((double)textureId));
@@ -3347,13 +3803,28 @@ bool initBindings(js::Engine* engine, void* wgpuInstance, void* wgpuDevice, void
 
                             // texture.destroy()
                             g_engine->setProperty(jsTexture, "destroy",
-                                g_engine->newFunction("destroy", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    // TODO: Get texture from context and destroy
-                                    // Would need to look up by ID and call wgpuTextureDestroy
+                                g_engine->newFunction("destroy", [textureId, bytes](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                                    // Frees the GPU memory now; the handle itself lives until the wrapper is collected
+                                    auto it = g_textureRegistry.find(textureId);
+                                    if (it != g_textureRegistry.end()) {
+                                        wgpuTextureDestroy(it->second.texture);
+                                        g_textureRegistry.erase(it);
+                                        g_gpuTextureBytes.fetch_sub(bytes, std::memory_order_relaxed);
+                                    }
                                     return g_engine->newUndefined();
                                 })
                             );
 
+                            // Collected: release the handle, and its memory if destroy() wasn't called
+                            g_engine->registerRelease(jsTexture, [textureId, texture, bytes]() {
+                                auto it = g_textureRegistry.find(textureId);
+                                if (it != g_textureRegistry.end()) {
+                                    g_textureRegistry.erase(it);
+                                    g_gpuTextureBytes.fetch_sub(bytes, std::memory_order_relaxed);
+                                }
+                                wgpuTextureRelease(texture);
+                            });
+
                             if (g_verboseLogging) std::cout << "[WebGPU] Created texture " << width << "x" << height << " format=" << formatStr << " (id=" << textureId << ")" << std::endl;
                             return jsTexture;
                         })
@@ -3675,6 +4146,7 @@ bool initBindings(js::Engine* engine, void* wgpuInstance, void* wgpuDevice, void
 
                             auto jsBindGroup = g_engine->newObject();
                             g_engine->setPrivateData(jsBindGroup, bindGroup);
+                            g_engine->setProperty(jsBindGroup, "_type", g_engine->newString("bindGroup"));
                             g_engine->registerRelease(jsBindGroup, [bindGroup]() {
                                 wgpuBindGroupRelease(bindGroup);
                             });
@@ -3839,168 +4311,7 @@ bool initBindings(js::Engine* engine, void* wgpuInstance, void* wgpuDevice, void
 
                     // device.createRenderBundleEncoder(descriptor)
                     // Used by Three.js for mipmap generation
-                    g_engine->setProperty(device, "createRenderBundleEncoder",
-                        g_engine->newFunction("createRenderBundleEncoder", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                            if (args.empty()) {
-                                g_engine->throwException("createRenderBundleEncoder requires a descriptor");
-                                return g_engine->newUndefined();
-                            }
-
-                            auto descriptor = args[0];
-
-                            // Parse color formats
-                            auto colorFormats = g_engine->getProperty(descriptor, "colorFormats");
-                            auto colorFormatsLength = g_engine->getProperty(colorFormats, "length");
-                            int colorFormatCount = g_engine->isUndefined(colorFormatsLength) ? 0 : (int)g_engine->toNumber(colorFormatsLength);
-
-                            std::vector<WGPUTextureFormat> formats;
-                            formats.reserve(colorFormatCount);
-                            for (int i = 0; i < colorFormatCount; i++) {
-                                auto formatProp = g_engine->getPropertyIndex(colorFormats, i);
-                                if (!g_engine->isUndefined(formatProp) && !g_engine->isNull(formatProp)) {
-                                    formats.push_back(stringToFormat(g_engine->toString(formatProp)));
-                                }
-                            }
-
-                            // Parse depth stencil format
-                            WGPUTextureFormat depthFormat = WGPUTextureFormat_Undefined;
-                            auto depthFormatProp = g_engine->getProperty(descriptor, "depthStencilFormat");
-                            if (!g_engine->isUndefined(depthFormatProp) && !g_engine->isNull(depthFormatProp)) {
-                                depthFormat = stringToFormat(g_engine->toString(depthFormatProp));
-                            }
-
-                            // Parse sample count
-                            uint32_t sampleCount = 1;
-                            auto sampleCountProp = g_engine->getProperty(descriptor, "sampleCount");
-                            if (!g_engine->isUndefined(sampleCountProp)) {
-                                sampleCount = (uint32_t)g_engine->toNumber(sampleCountProp);
-                            }
-
-                            WGPURenderBundleEncoderDescriptor desc = {};
-                            desc.colorFormatCount = formats.size();
-                            desc.colorFormats = formats.data();
-                            desc.depthStencilFormat = depthFormat;
-                            desc.sampleCount = sampleCount;
-
-                            WGPURenderBundleEncoder bundleEncoder = wgpuDeviceCreateRenderBundleEncoder(g_device, &desc);
-
-                            if (!bundleEncoder) {
-                                g_engine->throwException("Failed to create render bundle encoder");
-                                return g_engine->newUndefined();
-                            }
-
-                            auto jsEncoder = g_engine->newObject();
-                            g_engine->setPrivateData(jsEncoder, bundleEncoder);
-
-                            // Capture for closures
-                            WGPURenderBundleEncoder capturedEncoder = bundleEncoder;
-
-                            // renderBundleEncoder.setPipeline(pipeline)
-                            g_engine->setProperty(jsEncoder, "setPipeline",
-                                g_engine->newFunction("setPipeline", [capturedEncoder](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    if (args.empty()) return g_engine->newUndefined();
-                                    WGPURenderPipeline pipeline = (WGPURenderPipeline)g_engine->getPrivateData(args[0]);
-                                    wgpuRenderBundleEncoderSetPipeline(capturedEncoder, pipeline);
-                                    return g_engine->newUndefined();
-                                })
-                            );
-
-                            // renderBundleEncoder.setVertexBuffer(slot, buffer, offset?, size?)
-                            g_engine->setProperty(jsEncoder, "setVertexBuffer",
-                                g_engine->newFunction("setVertexBuffer", [capturedEncoder](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    if (args.size() < 2) return g_engine->newUndefined();
-                                    uint32_t slot = (uint32_t)g_engine->toNumber(args[0]);
-                                    WGPUBuffer buffer = (WGPUBuffer)g_engine->getPrivateData(args[1]);
-                                    uint64_t offset = args.size() > 2 && !g_engine->isUndefined(args[2]) ? (uint64_t)g_engine->toNumber(args[2]) : 0;
-                                    uint64_t size = args.size() > 3 && !g_engine->isUndefined(args[3]) ? (uint64_t)g_engine->toNumber(args[3]) : WGPU_WHOLE_SIZE;
-                                    wgpuRenderBundleEncoderSetVertexBuffer(capturedEncoder, slot, buffer, offset, size);
-                                    return g_engine->newUndefined();
-                                })
-                            );
-
-                            // renderBundleEncoder.setIndexBuffer(buffer, format, offset?, size?)
-                            g_engine->setProperty(jsEncoder, "setIndexBuffer",
-                                g_engine->newFunction("setIndexBuffer", [capturedEncoder](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    if (args.size() < 2) return g_engine->newUndefined();
-                                    WGPUBuffer buffer = (WGPUBuffer)g_engine->getPrivateData(args[0]);
-                                    std::string formatStr = g_engine->toString(args[1]);
-                                    WGPUIndexFormat format = formatStr == "uint32" ? WGPUIndexFormat_Uint32 : WGPUIndexFormat_Uint16;
-                                    uint64_t offset = args.size() > 2 && !g_engine->isUndefined(args[2]) ? (uint64_t)g_engine->toNumber(args[2]) : 0;
-                                    uint64_t size = args.size() > 3 && !g_engine->isUndefined(args[3]) ? (uint64_t)g_engine->toNumber(args[3]) : WGPU_WHOLE_SIZE;
-                                    wgpuRenderBundleEncoderSetIndexBuffer(capturedEncoder, buffer, format, offset, size);
-                                    return g_engine->newUndefined();
-                                })
-                            );
-
-                            // renderBundleEncoder.setBindGroup(index, bindGroup, dynamicOffsets?)
-                            g_engine->setProperty(jsEncoder, "setBindGroup",
-                                g_engine->newFunction("setBindGroup", [capturedEncoder](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    if (args.size() < 2) return g_engine->newUndefined();
-                                    uint32_t index = (uint32_t)g_engine->toNumber(args[0]);
-                                    WGPUBindGroup bindGroup = (WGPUBindGroup)g_engine->getPrivateData(args[1]);
-
-                                    // Parse dynamic offsets if provided
-                                    std::vector<uint32_t> dynamicOffsets;
-                                    if (args.size() > 2 && !g_engine->isUndefined(args[2])) {
-                                        auto offsetsArray = args[2];
-                                        auto lengthProp = g_engine->getProperty(offsetsArray, "length");
-                                        int offsetCount = g_engine->isUndefined(lengthProp) ? 0 : (int)g_engine->toNumber(lengthProp);
-                                        for (int i = 0; i < offsetCount; i++) {
-                                            dynamicOffsets.push_back((uint32_t)g_engine->toNumber(g_engine->getPropertyIndex(offsetsArray, i)));
-                                        }
-                                    }
-
-                                    wgpuRenderBundleEncoderSetBindGroup(capturedEncoder, index, bindGroup, dynamicOffsets.size(), dynamicOffsets.data());
-                                    return g_engine->newUndefined();
-                                })
-                            );
-
-                            // renderBundleEncoder.draw(vertexCount, instanceCount?, firstVertex?, firstInstance?)
-                            g_engine->setProperty(jsEncoder, "draw",
-                                g_engine->newFunction("draw", [capturedEncoder](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    if (args.empty()) return g_engine->newUndefined();
-                                    uint32_t vertexCount = (uint32_t)g_engine->toNumber(args[0]);
-                                    uint32_t instanceCount = args.size() > 1 ? (uint32_t)g_engine->toNumber(args[1]) : 1;
-                                    uint32_t firstVertex = args.size() > 2 ? (uint32_t)g_engine->toNumber(args[2]) : 0;
-                                    uint32_t firstInstance = args.size() > 3 ? (uint32_t)g_engine->toNumber(args[3]) : 0;
-                                    wgpuRenderBundleEncoderDraw(capturedEncoder, vertexCount, instanceCount, firstVertex, firstInstance);
-                                    return g_engine->newUndefined();
-                                })
-                            );
-
-                            // renderBundleEncoder.drawIndexed(indexCount, instanceCount?, firstIndex?, baseVertex?, firstInstance?)
-                            g_engine->setProperty(jsEncoder, "drawIndexed",
-                                g_engine->newFunction("drawIndexed", [capturedEncoder](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    if (args.empty()) return g_engine->newUndefined();
-                                    uint32_t indexCount = (uint32_t)g_engine->toNumber(args[0]);
-                                    uint32_t instanceCount = args.size() > 1 ? (uint32_t)g_engine->toNumber(args[1]) : 1;
-                                    uint32_t firstIndex = args.size() > 2 ? (uint32_t)g_engine->toNumber(args[2]) : 0;
-                                    int32_t baseVertex = args.size() > 3 ? (int32_t)g_engine->toNumber(args[3]) : 0;
-                                    uint32_t firstInstance = args.size() > 4 ? (uint32_t)g_engine->toNumber(args[4]) : 0;
-                                    wgpuRenderBundleEncoderDrawIndexed(capturedEncoder, indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
-                                    return g_engine->newUndefined();
-                                })
-                            );
-
-                            // renderBundleEncoder.finish(descriptor?)
-                            g_engine->setProperty(jsEncoder, "finish",
-                                g_engine->newFunction("finish", [capturedEncoder](void* ctx, const std::vector<js::JSValueHandle>& args) {
-                                    WGPURenderBundleDescriptor desc = {};
-                                    WGPURenderBundle bundle = wgpuRenderBundleEncoderFinish(capturedEncoder, &desc);
-
-                                    auto jsBundle = g_engine->newObject();
-                                    g_engine->setPrivateData(jsBundle, bundle);
-                                    g_engine->setProperty(jsBundle, "_type", g_engine->newString("renderBundle"));
-
-                                    if (g_verboseLogging) std::cout << "[WebGPU] Render bundle finished" << std::endl;
-                                    return jsBundle;
-                                })
-                            );
-
-                            if (g_verboseLogging) std::cout << "[WebGPU] Created render bundle encoder" << std::endl;
-                            return jsEncoder;
-                        })
-                    );
+                    g_engine->setProperty(device, "createRenderBundleEncoder", g_engine->newFunction("createRenderBundleEncoder", createRenderBundleEncoder));
 
                     // device.pushErrorScope(filter) - Push an error scope for validation/OOM/internal errors
                     // Used by Three.js for error handling during pipeline creation
@@ -4162,67 +4473,65 @@ bool initBindings(js::Engine* engine, void* wgpuInstance, void* wgpuDevice, void
                 return g_engine->newUndefined();
             }
 
-            const unsigned char* inputBytes = (const unsigned char*)inputData;
             int width = 0, height = 0;
-            unsigned char* data = nullptr;
-            bool isWebP = false;
-
-            // Check if this is a WebP image (starts with "RIFF" and has "WEBP" at offset 8)
-            if (inputSize >= 12 &&
-                inputBytes[0] == 'R' && inputBytes[1] == 'I' &&
-                inputBytes[2] == 'F' && inputBytes[3] == 'F' &&
-                inputBytes[8] == 'W' && inputBytes[9] == 'E' &&
-                inputBytes[10] == 'B' && inputBytes[11] == 'P') {
-                isWebP = true;
-            }
-
-            if (isWebP) {
-#ifdef MYSTRAL_HAS_WEBP
-                // Decode WebP using libwebp
-                data = WebPDecodeRGBA(inputBytes, inputSize, &width, &height);
-                if (!data) {
-                    g_engine->throwException("Failed to decode WebP image");
-                    return g_engine->newUndefined();
-                }
-                if (g_verboseLogging) std::cout << "[createImageBitmap] Decoded WebP " << width << "x" << height << " image" << std::endl;
-#else
-                g_engine->throwException("WebP image detected but libwebp support not compiled in. Rebuild with MYSTRAL_HAS_WEBP.");
+            std::string error;
+            auto pixels = decodeImageBytes(static_cast<const unsigned char*>(inputData), inputSize, width, height, error);
+            if (!pixels) {
+                g_engine->throwException(error.c_str());
                 return g_engine->newUndefined();
-#endif
-            } else {
-                // Decode using stb_image (PNG, JPEG, etc.)
-                int channels;
-                data = stbi_load_from_memory(inputBytes, (int)inputSize, &width, &height, &channels, 4);
-                if (!data) {
-                    std::string error = std::string("Failed to decode image: ") + stbi_failure_reason();
-                    g_engine->throwException(error.c_str());
-                    return g_engine->newUndefined();
-                }
-                if (g_verboseLogging) std::cout << "[createImageBitmap] Decoded " << width << "x" << height << " image" << std::endl;
             }
 
-            // Create ImageBitmap-like object
-            auto result = g_engine->newObject();
-
-            // Create ArrayBuffer with RGBA pixel data
-            size_t dataSize = width * height * 4;
-            auto arrayBuffer = g_engine->newArrayBuffer(data, dataSize);
+            return makeDecodedImage(width, height, std::move(pixels));
+        })
+    );
 
-            g_engine->setProperty(result, "width", g_engine->newNumber(width));
-            g_engine->setProperty(result, "height", g_engine->newNumber(height));
-            g_engine->setProperty(result, "_data", arrayBuffer);  // Internal pixel data
-            g_engine->setProperty(result, "_closed", g_engine->newBoolean(false));
+    // Native helper that decodes on the job pool: __decodeImageDataAsync(buffer, callback(result, error))
+    engine->setGlobalProperty("__decodeImageDataAsync",
+        engine->newFunction("__decodeImageDataAsync", [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (args.size() < 2) {
+                return g_engine->newString("__decodeImageDataAsync requires (buffer, callback)");
+            }
 
-            // Free decoded data (we copied it to ArrayBuffer)
-            if (isWebP) {
-#ifdef MYSTRAL_HAS_WEBP
-                WebPFree(data);
-#endif
-            } else {
-                stbi_image_free(data);
+            size_t inputSize = 0;
+            void* inputData = g_engine->getArrayBufferData(args[0], &inputSize);
+            if (!inputData || inputSize == 0) {
+                return g_engine->newString("__decodeImageDataAsync: invalid ArrayBuffer");
             }
 
-            return result;
+            // Copy the input: the JS buffer may be mutated or collected while we decode
+            struct DecodeJob {
+                std::vector<unsigned char> input;
+                std::shared_ptr<js::BackingStore> pixels;
+                int width = 0;
+                int height = 0;
+                std::string error;
+                js::JSValueHandle callback;
+            };
+            auto job = std::make_shared<DecodeJob>();
+            job->input.assign(static_cast<const unsigned char*>(inputData),
+                              static_cast<const unsigned char*>(inputData) + inputSize);
+            job->callback = args[1];
+            g_engine->protect(job->callback);
+
+            jobs::JobSystem::instance().submit(
+                [job]() {
+                    job->pixels = decodeImageBytes(job->input.data(), job->input.size(), job->width, job->height, job->error);
+                    job->input = {};
+                },
+                [job]() {
+                    if (!g_engine) return;
+                    std::vector<js::JSValueHandle> callbackArgs;
+                    if (job->pixels) {
+                        callbackArgs = { makeDecodedImage(job->width, job->height, std::move(job->pixels)), g_engine->newNull() };
+                    } else {
+                        callbackArgs = { g_engine->newNull(), g_engine->newString(job->error.c_str()) };
+                    }
+                    g_engine->call(job->callback, g_engine->newUndefined(), callbackArgs);
+                    g_engine->unprotect(job->callback);
+                },
+                jobs::JobPriority::Normal
+            );
+            return g_engine->newUndefined();
         })
     );
 
@@ -4262,8 +4571,14 @@ async function createImageBitmap(source, options) {
         throw new Error('createImageBitmap: unsupported source type');
     }
 
-    // Decode using native function
-    const decoded = __decodeImageData(arrayBuffer);
+    // Decode on the native job pool (keeps the main thread free for large textures)
+    const decoded = await new Promise((resolve, reject) => {
+        const error = __decodeImageDataAsync(arrayBuffer, (result, message) => {
+            if (message) reject(new Error(message));
+            else resolve(result);
+        });
+        if (error) reject(new Error(error));
+    });
 
     if (!decoded) {
         throw new Error('createImageBitmap: failed to decode image');
@@ -4737,17 +5052,49 @@ static WGPUBindGroup g_canvas2DBindGroup = nullptr;
 static WGPUSampler g_canvas2DSampler = nullptr;
 static uint32_t g_canvas2DTextureWidth = 0;
 static uint32_t g_canvas2DTextureHeight = 0;
+static uint64_t g_canvas2DFrameSerial = 0;  // Last transferred-canvas frame uploaded
+
+/**
+ * Give the main canvas back to the next script (full reload): forget its 2D
+ * context and drop the compositor's reference to a transferred canvas
+ */
+void resetCanvasControl() {
+    g_mainCanvas2DContext = nullptr;
+    if (g_transferredCanvas) {
+        g_transferredCanvas->release();
+        g_transferredCanvas = nullptr;
+    }
+    g_canvas2DFrameSerial = 0;
+}
 
 void compositeCanvas2DToWebGPU() {
-    if (!g_mainCanvas2DContext || !g_device || !g_queue || !g_surface) {
+    if ((!g_mainCanvas2DContext && !g_transferredCanvas) || !g_device || !g_queue || !g_surface) {
         return;
     }
 
-    // Get Canvas 2D pixel data
-    const uint8_t* pixelData = g_mainCanvas2DContext->getPixelData();
-    size_t pixelDataSize = g_mainCanvas2DContext->getPixelDataSize();
-    int width = g_mainCanvas2DContext->getWidth();
-    int height = g_mainCanvas2DContext->getHeight();
+    // Get Canvas 2D pixel data: the main-thread context, or the newest frame a worker committed
+    const uint8_t* pixelData = nullptr;
+    size_t pixelDataSize = 0;
+    int width = 0;
+    int height = 0;
+    bool upload = true;
+    if (g_transferredCanvas) {
+        const canvas::CanvasFrame* frame = g_transferredCanvas->frames().acquire();
+        if (!frame) {
+            return;  // Nothing committed yet
+        }
+        pixelData = frame->pixels.data();
+        pixelDataSize = frame->pixels.size();
+        width = frame->width;
+        height = frame->height;
+        upload = frame->serial != g_canvas2DFrameSerial;
+        g_canvas2DFrameSerial = frame->serial;
+    } else {
+        pixelData = g_mainCanvas2DContext->getPixelData();
+        pixelDataSize = g_mainCanvas2DContext->getPixelDataSize();
+        width = g_mainCanvas2DContext->getWidth();
+        height = g_mainCanvas2DContext->getHeight();
+    }
 
     if (!pixelData || pixelDataSize == 0) {
         return;
@@ -4755,6 +5102,7 @@ void compositeCanvas2DToWebGPU() {
 
     // Create or resize texture if needed
     if (!g_canvas2DTexture || g_canvas2DTextureWidth != (uint32_t)width || g_canvas2DTextureHeight != (uint32_t)height) {
+        upload = true;
         if (g_canvas2DTexture) {
             wgpuTextureDestroy(g_canvas2DTexture);
             wgpuTextureRelease(g_canvas2DTexture);
@@ -4777,20 +5125,22 @@ void compositeCanvas2DToWebGPU() {
         g_canvas2DTextureHeight = height;
     }
 
-    // Upload pixel data to texture
-    WGPUImageCopyTexture_Compat destTexture = {};
-    destTexture.texture = g_canvas2DTexture;
-    destTexture.mipLevel = 0;
-    destTexture.origin = {0, 0, 0};
-    destTexture.aspect = WGPUTextureAspect_All;
-
-    WGPUTextureDataLayout_Compat dataLayout = {};
-    dataLayout.offset = 0;
-    dataLayout.bytesPerRow = width * 4;
-    dataLayout.rowsPerImage = height;
-
-    WGPUExtent3D writeSize = {(uint32_t)width, (uint32_t)height, 1};
-    wgpuQueueWriteTexture(g_queue, &destTexture, pixelData, pixelDataSize, &dataLayout, &writeSize);
+    // Upload pixel data to texture (a transferred canvas only when a new frame was committed)
+    if (upload) {
+        WGPUImageCopyTexture_Compat destTexture = {};
+        destTexture.texture = g_canvas2DTexture;
+        destTexture.mipLevel = 0;
+        destTexture.origin = {0, 0, 0};
+        destTexture.aspect = WGPUTextureAspect_All;
+
+        WGPUTextureDataLayout_Compat dataLayout = {};
+        dataLayout.offset = 0;
+        dataLayout.bytesPerRow = width * 4;
+        dataLayout.rowsPerImage = height;
+
+        WGPUExtent3D writeSize = {(uint32_t)width, (uint32_t)height, 1};
+        wgpuQueueWriteTexture(g_queue, &destTexture, pixelData, pixelDataSize, &dataLayout, &writeSize);
+    }
 
     // Create pipeline if needed
     if (!g_canvas2DPipeline) {
@@ -5078,5 +5428,41 @@ void endDawnFrame() {
     }
 }
 
+void setDeviceThreadSafe(bool threadSafe) {
+    g_threadSafeDevice = threadSafe;
+}
+
+// Worker device proxy: mystral.gpu.device with createCommandEncoder and
+// createRenderBundleEncoder. The resulting command buffers and bundles are
+// posted back and submitted on the main thread; pipelines, bind groups and
+// buffers created there arrive by reference through postMessage.
+void initWorkerBindings(js::Engine* engine) {
+#if defined(MYSTRAL_WEBGPU_WGPU) || defined(MYSTRAL_WEBGPU_DAWN)
+    if (!engine || !g_device) {
+        return;
+    }
+    if (!g_threadSafeDevice) {
+        if (g_verboseLogging) {
+            std::cout << "[WebGPU] Device is not thread-safe, workers get no GPU device" << std::endl;
+        }
+        return;
+    }
+
+    g_engine = engine;
+    g_workerEncoding = true;
+
+    auto device = engine->newObject();
+    engine->setPrivateData(device, g_device);
+    engine->setProperty(device, "createCommandEncoder", engine->newFunction("createCommandEncoder", createCommandEncoder));
+    engine->setProperty(device, "createRenderBundleEncoder", engine->newFunction("createRenderBundleEncoder", createRenderBundleEncoder));
+
+    auto gpu = engine->newObject();
+    engine->setProperty(gpu, "device", device);
+    engine->setGlobalProperty("__workerGPU", gpu);
+    engine->eval("(globalThis.mystral = globalThis.mystral || {}).gpu = __workerGPU; delete globalThis.__workerGPU;",
+                 "worker-gpu.js");
+#endif
+}
+
 }  // namespace webgpu
 }  // namespace mystral
@@ -292,13 +292,17 @@ bool Context::initializeHeadless() {
     WGPULimits requiredLimits = adapterLimits;
     deviceDesc.requiredLimits = &requiredLimits;
 
-    static WGPUFeatureName requiredFeaturesDawn[1];
+    static WGPUFeatureName requiredFeaturesDawn[2];
     size_t featureCount = 0;
     if (wgpuAdapterHasFeature(adapter_, WGPUFeatureName_IndirectFirstInstance)) {
-        requiredFeaturesDawn[0] = WGPUFeatureName_IndirectFirstInstance;
-        featureCount = 1;
+        requiredFeaturesDawn[featureCount++] = WGPUFeatureName_IndirectFirstInstance;
         hasIndirectFirstInstance_ = true;
     }
+    // Lets worker threads record command encoders and render bundles concurrently
+    if (wgpuAdapterHasFeature(adapter_, WGPUFeatureName_ImplicitDeviceSynchronization)) {
+        requiredFeaturesDawn[featureCount++] = WGPUFeatureName_ImplicitDeviceSynchronization;
+        hasThreadSafeDevice_ = true;
+    }
     deviceDesc.requiredFeatureCount = featureCount;
     deviceDesc.requiredFeatures = featureCount > 0 ? requiredFeaturesDawn : nullptr;
 #elif defined(MYSTRAL_WEBGPU_WGPU)
@@ -316,6 +320,7 @@ bool Context::initializeHeadless() {
     }
     deviceDesc.requiredFeatureCount = featureCount;
     deviceDesc.requiredFeatures = featureCount > 0 ? requiredFeaturesWGPU : nullptr;
+    hasThreadSafeDevice_ = true;  // wgpu-native devices are always internally synchronized
 #endif
 
     WGPUUncapturedErrorCallbackInfo errorCallbackInfo = {};
@@ -555,17 +560,21 @@ bool Context::createSurface(void* nativeHandle, int platformType) {
 
     // Check if IndirectFirstInstance is supported before requesting it
     // This feature allows instance_index in shaders to include firstInstance offset
-    static WGPUFeatureName requiredFeaturesDawn[1];
+    static WGPUFeatureName requiredFeaturesDawn[2];
     size_t featureCount = 0;
     if (wgpuAdapterHasFeature(adapter_, WGPUFeatureName_IndirectFirstInstance)) {
-        requiredFeaturesDawn[0] = WGPUFeatureName_IndirectFirstInstance;
-        featureCount = 1;
+        requiredFeaturesDawn[featureCount++] = WGPUFeatureName_IndirectFirstInstance;
         hasIndirectFirstInstance_ = true;
         std::cout << "[WebGPU] Requesting IndirectFirstInstance feature (supported)" << std::endl;
     } else {
         hasIndirectFirstInstance_ = false;
         std::cout << "[WebGPU] IndirectFirstInstance feature NOT supported (continuing without)" << std::endl;
     }
+    // Lets worker threads record command encoders and render bundles concurrently
+    if (wgpuAdapterHasFeature(adapter_, WGPUFeatureName_ImplicitDeviceSynchronization)) {
+        requiredFeaturesDawn[featureCount++] = WGPUFeatureName_ImplicitDeviceSynchronization;
+        hasThreadSafeDevice_ = true;
+    }
     deviceDesc.requiredFeatureCount = featureCount;
     deviceDesc.requiredFeatures = featureCount > 0 ? requiredFeaturesDawn : nullptr;
 #elif defined(MYSTRAL_WEBGPU_WGPU)
@@ -597,6 +606,7 @@ bool Context::createSurface(void* nativeHandle, int platformType) {
     }
     deviceDesc.requiredFeatureCount = featureCount;
     deviceDesc.requiredFeatures = featureCount > 0 ? requiredFeaturesWGPU : nullptr;
+    hasThreadSafeDevice_ = true;  // wgpu-native devices are always internally synchronized
 #endif
 
     // Set up error callback
@@ -742,13 +752,17 @@ bool Context::createSurfaceWithDisplay(void* display, void* window, int platform
     }
     deviceDesc.requiredLimits = &requiredLimits;
 
-    static WGPUFeatureName requiredFeaturesDawn[1];
+    static WGPUFeatureName requiredFeaturesDawn[2];
     size_t featureCount = 0;
     if (wgpuAdapterHasFeature(adapter_, WGPUFeatureName_IndirectFirstInstance)) {
-        requiredFeaturesDawn[0] = WGPUFeatureName_IndirectFirstInstance;
-        featureCount = 1;
+        requiredFeaturesDawn[featureCount++] = WGPUFeatureName_IndirectFirstInstance;
         hasIndirectFirstInstance_ = true;
     }
+    // Lets worker threads record command encoders and render bundles concurrently
+    if (wgpuAdapterHasFeature(adapter_, WGPUFeatureName_ImplicitDeviceSynchronization)) {
+        requiredFeaturesDawn[featureCount++] = WGPUFeatureName_ImplicitDeviceSynchronization;
+        hasThreadSafeDevice_ = true;
+    }
     deviceDesc.requiredFeatureCount = featureCount;
     deviceDesc.requiredFeatures = featureCount > 0 ? requiredFeaturesDawn : nullptr;
 #elif defined(MYSTRAL_WEBGPU_WGPU)
@@ -770,6 +784,7 @@ bool Context::createSurfaceWithDisplay(void* display, void* window, int platform
     }
     deviceDesc.requiredFeatureCount = featureCount;
     deviceDesc.requiredFeatures = featureCount > 0 ? requiredFeaturesWGPU : nullptr;
+    hasThreadSafeDevice_ = true;  // wgpu-native devices are always internally synchronized
 #endif
 
     WGPUUncapturedErrorCallbackInfo errorCallbackInfo = {};
@@ -0,0 +1,161 @@
+/**
+ * Atomics.wait / Atomics.notify fallback implementation
+ *
+ * Waiters park in one of a fixed set of buckets chosen by address. The value
+ * check and enqueue happen under the bucket mutex, and notify takes the same
+ * mutex, so a notify between "value still equals expected" and "sleep" is
+ * never lost.
+ */
+
+#include "mystral/workers/atomics_wait.h"
+#include "mystral/js/engine.h"
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+
+namespace mystral {
+namespace workers {
+
+namespace {
+
+struct Waiter {
+    int32_t* address;
+    std::condition_variable cv;
+    bool notified = false;
+};
+
+struct Bucket {
+    std::mutex mutex;
+    std::list<Waiter*> waiters;  // FIFO per spec
+};
+
+constexpr size_t kBucketCount = 64;
+Bucket g_buckets[kBucketCount];
+
+Bucket& bucketFor(const int32_t* address) {
+    return g_buckets[(reinterpret_cast<uintptr_t>(address) >> 2) % kBucketCount];
+}
+
+int32_t atomicLoad(int32_t* address) {
+    static_assert(sizeof(std::atomic<int32_t>) == sizeof(int32_t), "lock-free int32 required");
+    return reinterpret_cast<std::atomic<int32_t>*>(address)->load(std::memory_order_seq_cst);
+}
+
+}  // namespace
+
+AtomicsWaitResult atomicsWait(int32_t* address, int32_t expected, double timeoutMs) {
+    Bucket& bucket = bucketFor(address);
+    std::unique_lock<std::mutex> lock(bucket.mutex);
+
+    if (atomicLoad(address) != expected) {
+        return AtomicsWaitResult::NotEqual;
+    }
+
+    Waiter waiter{address};
+    auto it = bucket.waiters.insert(bucket.waiters.end(), &waiter);
+
+    if (std::isnan(timeoutMs) || std::isinf(timeoutMs)) {
+        waiter.cv.wait(lock, [&]() { return waiter.notified; });
+    } else {
+        auto timeout = std::chrono::duration<double, std::milli>(timeoutMs < 0 ? 0 : timeoutMs);
+        waiter.cv.wait_for(lock, timeout, [&]() { return waiter.notified; });
+    }
+
+    if (!waiter.notified) {
+        bucket.waiters.erase(it);  // Still queued: nobody woke us
+        return AtomicsWaitResult::TimedOut;
+    }
+    return AtomicsWaitResult::Ok;
+}
+
+int atomicsNotify(int32_t* address, int count) {
+    Bucket& bucket = bucketFor(address);
+    std::lock_guard<std::mutex> lock(bucket.mutex);
+
+    int woken = 0;
+    for (auto it = bucket.waiters.begin(); it != bucket.waiters.end() && woken < count;) {
+        Waiter* waiter = *it;
+        if (waiter->address != address) {
+            ++it;
+            continue;
+        }
+        waiter->notified = true;
+        waiter->cv.notify_one();
+        it = bucket.waiters.erase(it);
+        woken++;
+    }
+    return woken;
+}
+
+void installAtomicsFallback(js::Engine* engine, bool canBlock) {
+    if (!engine) return;
+
+    // Resolve the int32 slot an (Int32Array, index) pair refers to
+    auto slotAddress = [engine](const std::vector<js::JSValueHandle>& args) -> int32_t* {
+        size_t size = 0;
+        auto* data = static_cast<uint8_t*>(engine->getArrayBufferData(args[0], &size));
+        double index = engine->toNumber(args[1]);
+        // Written so NaN fails too; never trust the polyfill's range check
+        if (!data || !(index >= 0) || index >= static_cast<double>(size / sizeof(int32_t))) return nullptr;
+        return reinterpret_cast<int32_t*>(data) + static_cast<size_t>(index);
+    };
+
+    // __atomicsWait(int32Array, index, value, timeoutMs) -> 0 ok, 1 not-equal, 2 timed-out
+    engine->setGlobalProperty("__atomicsWait",
+        engine->newFunction("__atomicsWait", [engine, slotAddress, canBlock](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (!canBlock) {
+                engine->throwException("Atomics.wait cannot be called on the main thread");
+                return engine->newUndefined();
+            }
+            if (args.size() < 4) return engine->newNumber(1);
+            int32_t* address = slotAddress(args);
+            if (!address) return engine->newNumber(1);
+            int32_t expected = static_cast<int32_t>(engine->toNumber(args[2]));
+            auto result = atomicsWait(address, expected, engine->toNumber(args[3]));
+            return engine->newNumber(static_cast<int>(result));
+        })
+    );
+
+    // __atomicsNotify(int32Array, index, count) -> number of waiters woken
+    engine->setGlobalProperty("__atomicsNotify",
+        engine->newFunction("__atomicsNotify", [engine, slotAddress](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (args.size() < 3) return engine->newNumber(0);
+            int32_t* address = slotAddress(args);
+            if (!address) return engine->newNumber(0);
+            double count = engine->toNumber(args[2]);
+            int limit = (std::isinf(count) || count > INT_MAX) ? INT_MAX : static_cast<int>(count < 0 ? 0 : count);
+            return engine->newNumber(atomicsNotify(address, limit));
+        })
+    );
+
+    const char* atomicsPolyfill = R"JS(
+if (typeof Atomics !== 'undefined' && typeof Atomics.wait !== 'function') {
+    const results = ['ok', 'not-equal', 'timed-out'];
+    const checkSlot = (array, index, name) => {
+        if (!(array instanceof Int32Array)) throw new TypeError('Atomics.' + name + ' requires an Int32Array');
+        index = Math.trunc(Number(index)) || 0;
+        if (index < 0 || index >= array.length) throw new RangeError('Atomics.' + name + ': index out of range');
+        return index;
+    };
+    Atomics.wait = function(array, index, value, timeout) {
+        index = checkSlot(array, index, 'wait');
+        const ms = timeout === undefined ? Infinity : Number(timeout);
+        return results[__atomicsWait(array, index, value | 0, ms)];
+    };
+    Atomics.notify = function(array, index, count) {
+        index = checkSlot(array, index, 'notify');
+        const n = count === undefined ? Infinity : Math.max(0, Math.trunc(Number(count)) || 0);
+        return __atomicsNotify(array, index, n);
+    };
+}
+)JS";
+
+    engine->eval(atomicsPolyfill, "atomics-fallback.js");
+}
+
+}  // namespace workers
+}  // namespace mystral
@@ -0,0 +1,88 @@
+/**
+ * WakeupSignal Implementation
+ */
+
+#include "mystral/workers/wakeup_signal.h"
+#include <chrono>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <climits>
+#include <ctime>
+#endif
+
+namespace mystral {
+namespace workers {
+
+#if defined(__linux__)
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex needs a plain 32-bit word");
+
+void WakeupSignal::notify() {
+    // seq_cst pairs with the sleeper's increment-then-check in wait()
+    epoch_.fetch_add(1, std::memory_order_seq_cst);
+    // Skip the syscall when nobody is asleep (the common case under load)
+    if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+    }
+}
+
+bool WakeupSignal::wait(uint32_t observedEpoch, double timeoutMs) {
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        std::chrono::duration<double, std::milli>(timeoutMs < 0 ? 0 : timeoutMs));
+
+    sleepers_.fetch_add(1, std::memory_order_seq_cst);
+    bool notified = true;
+    while (epoch_.load(std::memory_order_seq_cst) == observedEpoch) {
+        timespec ts;
+        timespec* timeout = nullptr;
+        if (timeoutMs >= 0) {
+            auto remaining = deadline - std::chrono::steady_clock::now();
+            if (remaining <= std::chrono::steady_clock::duration::zero()) {
+                notified = false;
+                break;
+            }
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+            ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+            ts.tv_nsec = static_cast<long>(ns % 1000000000);
+            timeout = &ts;
+        }
+        // Returns immediately (EAGAIN) if the epoch already moved on
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAIT_PRIVATE, observedEpoch, timeout, nullptr, 0);
+    }
+    sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+    return notified;
+}
+
+#else
+
+void WakeupSignal::notify() {
+    epoch_.fetch_add(1, std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+        // Lock so the increment can't land between a sleeper's check and its wait
+        std::lock_guard<std::mutex> lock(mutex_);
+        cv_.notify_all();
+    }
+}
+
+bool WakeupSignal::wait(uint32_t observedEpoch, double timeoutMs) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    sleepers_.fetch_add(1, std::memory_order_seq_cst);
+    auto changed = [&]() { return epoch_.load(std::memory_order_seq_cst) != observedEpoch; };
+    bool notified = true;
+    if (timeoutMs < 0) {
+        cv_.wait(lock, changed);
+    } else {
+        notified = cv_.wait_for(lock, std::chrono::duration<double, std::milli>(timeoutMs), changed);
+    }
+    sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+    return notified;
+}
+
+#endif
+
+}  // namespace workers
+}  // namespace mystral
@@ -0,0 +1,165 @@
+/**
+ * WorkerEventLoop Implementation
+ *
+ * Timers are kept in a TimerQueue rather than as libuv timers so
+ * an idle worker with only timers pending sleeps on its message signal with
+ * a timeout; the libuv loop is only entered while I/O is in flight.
+ */
+
+#include "mystral/workers/worker_event_loop.h"
+#include "mystral/workers/wakeup_signal.h"
+#include "mystral/async/event_loop.h"
+#include "mystral/http/async_http_client.h"
+#include "mystral/fs/async_file.h"
+#include <iostream>
+#include <vector>
+
+namespace mystral {
+namespace workers {
+
+void WorkerEventLoop::init(js::Engine* engine, int workerId) {
+    engine_ = engine;
+    workerId_ = workerId;
+
+    // This thread's loop, HTTP client and file reader (all per-thread instances)
+    auto& loop = async::EventLoop::instance();
+    loop.init();
+    if (loop.isAvailable()) {
+        http::getAsyncHttpClient().init();
+        fs::getAsyncFileReader().init();
+    }
+    {
+        std::lock_guard<std::mutex> lock(loopMutex_);
+        loop_ = &loop;
+    }
+
+    // setTimeout(callback, delay) / setInterval(callback, delay)
+    engine->setGlobalProperty("setTimeout",
+        engine->newFunction("setTimeout", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (args.empty()) {
+                return engine_->newNumber(-1);
+            }
+            int delay = args.size() > 1 ? static_cast<int>(engine_->toNumber(args[1])) : 0;
+            engine_->protect(args[0]);
+            return engine_->newNumber(static_cast<double>(timers_.add(args[0], delay, 0, async::TimerQueue::Clock::now())));
+        })
+    );
+
+    engine->setGlobalProperty("setInterval",
+        engine->newFunction("setInterval", [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
+            if (args.empty()) {
+                return engine_->newNumber(-1);
+            }
+            int delay = args.size() > 1 ? static_cast<int>(engine_->toNumber(args[1])) : 0;
+            if (delay < 1) delay = 1;
+            engine_->protect(args[0]);
+            return engine_->newNumber(static_cast<double>(timers_.add(args[0], delay, delay, async::TimerQueue::Clock::now())));
+        })
+    );
+
+    // clearTimeout and clearInterval share one id space, as in browsers
+    auto clear = [this](void* ctx, const std::vector<js::JSValueHandle>& args) {
+        async::TimerQueue::TimerId id;
+        js::JSValueHandle callback;
+        if (!args.empty() && async::TimerQueue::idFromNumber(engine_->toNumber(args[0]), id) &&
+            timers_.cancel(id, callback)) {
+            engine_->unprotect(callback);
+        }
+        return engine_->newUndefined();
+    };
+    engine->setGlobalProperty("clearTimeout", engine->newFunction("clearTimeout", clear));
+    engine->setGlobalProperty("clearInterval", engine->newFunction("clearInterval", clear));
+
+    async::installFetchBindings(engine, fileCallbacks_);
+}
+
+void WorkerEventLoop::runDueTimers() {
+    timers_.beginPass(async::TimerQueue::Clock::now());
+
+    async::TimerQueue::Due timer;
+    while (timers_.popDue(timer)) {
+        if (!engine_->call(timer.callback, engine_->newUndefined(), {}).ptr) {
+            std::cerr << "[Worker " << workerId_ << "] Exception in timer callback: "
+                      << engine_->getException() << std::endl;
+        }
+
+        // A timer may clear itself from its own callback; release it once the call returns
+        if (timer.intervalMs == 0 || !timers_.rearm(timer)) {
+            engine_->unprotect(timer.callback);
+        }
+    }
+}
+
+void WorkerEventLoop::runOnce() {
+    if (!engine_) return;
+
+    // Same order as the main thread's pollEvents(): I/O, completions, timers, file callbacks
+    async::EventLoop::instance().runOnce();
+    http::getAsyncHttpClient().processCompletedRequests();
+    fs::getAsyncFileReader().processCompletedReads();
+    runDueTimers();
+    fileCallbacks_.drain(engine_);
+}
+
+void WorkerEventLoop::wait(WakeupSignal& signal, uint32_t observedEpoch) {
+    if (!fileCallbacks_.empty()) {
+        return;  // Embedded-bundle reads complete immediately
+    }
+
+    double timeoutMs = timers_.msUntilNext(async::TimerQueue::Clock::now());
+    if (timeoutMs == 0) {
+        return;
+    }
+
+    auto& loop = async::EventLoop::instance();
+    if (!loop.hasPendingWork()) {
+        // Nothing in flight: only a message or a timer can wake us
+        signal.wait(observedEpoch, timeoutMs);
+        return;
+    }
+
+    // Requests in flight: sleep inside the loop so completions wake us too.
+    // Publish inLoopWait_ before re-checking the epoch; the poster bumps the
+    // epoch before reading inLoopWait_, so one of the two sides sees the other.
+    inLoopWait_.store(true);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (signal.epoch() == observedEpoch) {
+        loop.waitForEvents(timeoutMs);
+    }
+    inLoopWait_.store(false);
+}
+
+void WorkerEventLoop::wakeup() {
+    if (!inLoopWait_.load()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(loopMutex_);
+    if (loop_) {
+        loop_->wakeup();
+    }
+}
+
+void WorkerEventLoop::shutdown() {
+    if (!engine_) return;
+
+    {
+        std::lock_guard<std::mutex> lock(loopMutex_);
+        loop_ = nullptr;
+    }
+
+    // Pending fetches are rejected and reads delivered while the engine is still alive.
+    // Closing the loop runs it until queued reads finish, so collect them afterwards.
+    http::getAsyncHttpClient().shutdown();
+    async::EventLoop::instance().shutdown();
+    fs::getAsyncFileReader().processCompletedReads();
+    fs::getAsyncFileReader().shutdown();
+    fileCallbacks_.drain(engine_);
+
+    for (auto& callback : timers_.clear()) {
+        engine_->unprotect(callback);
+    }
+    engine_ = nullptr;
+}
+
+}  // namespace workers
+}  // namespace mystral
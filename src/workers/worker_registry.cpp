@@ -34,7 +34,7 @@ int WorkerRegistry::createWorker(const std::string& code) {
 
     int id = nextId_++;
 
-    auto worker = std::make_unique<WorkerThread>(id, code);
+    auto worker = std::make_unique<WorkerThread>(id, code, &messageSignal_);
     worker->start();
 
     workers_[id] = std::move(worker);
@@ -53,32 +53,68 @@ void WorkerRegistry::postToWorker(int id, WorkerMessage msg) {
         return;
     }
 
-    it->second->postMessage(std::move(msg.payload), std::move(msg.transfers));
+    it->second->postMessage(std::move(msg));
 }
 
 void WorkerRegistry::terminateWorker(int id) {
-    std::unique_ptr<WorkerThread> worker;
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = workers_.find(id);
+    if (it == workers_.end()) {
+        return;
+    }
+
+    // Signal termination without joining: the worker may be mid-job.
+    // The thread is joined once it has exited (see reapRetiredWorkers).
+    it->second->terminate();
+    retired_.push_back(std::move(it->second));
+    workers_.erase(it);
+    callbacks_.erase(id);
+
+    std::cout << "[WorkerRegistry] Terminated worker " << id << std::endl;
+}
+
+void WorkerRegistry::reapRetiredWorkers() {
+    std::vector<std::unique_ptr<WorkerThread>> finished;
 
     {
         std::lock_guard<std::mutex> lock(mutex_);
-
-        auto it = workers_.find(id);
-        if (it == workers_.end()) {
-            return;
+        for (auto it = retired_.begin(); it != retired_.end();) {
+            if (!(*it)->isRunning()) {
+                finished.push_back(std::move(*it));
+                it = retired_.erase(it);
+            } else {
+                ++it;
+            }
         }
+    }
 
-        worker = std::move(it->second);
-        workers_.erase(it);
-        callbacks_.erase(id);
+    // Join outside the lock (threads have already exited, so this is quick)
+    for (auto& worker : finished) {
+        worker->join();
     }
+}
+
+void WorkerRegistry::terminateAll() {
+    std::vector<int> ids;
 
-    // Terminate outside lock to avoid deadlock
-    if (worker) {
-        worker->terminate();
-        std::cout << "[WorkerRegistry] Terminated worker " << id << std::endl;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [id, _] : workers_) {
+            ids.push_back(id);
+        }
+    }
+
+    for (int id : ids) {
+        terminateWorker(id);
     }
 }
 
+size_t WorkerRegistry::activeWorkerCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return workers_.size();
+}
+
 void WorkerRegistry::registerCallback(int id, JSWorkerCallback callback) {
     std::lock_guard<std::mutex> lock(mutex_);
     callbacks_[id] = std::move(callback);
@@ -99,22 +135,26 @@ bool WorkerRegistry::processWorkerMessages(js::Engine* mainEngine) {
     // Collect messages and dead workers (hold lock briefly)
     std::vector<std::tuple<int, JSWorkerCallback, WorkerMessage>> messages;
     std::vector<int> deadWorkers;
+    std::vector<WorkerMessage> batch;
 
     {
         std::lock_guard<std::mutex> lock(mutex_);
 
         for (auto& [id, worker] : workers_) {
+            // A worker that called close() may still have queued messages
+            // (e.g. postMessage(result); close();), so drain before reaping
             if (!worker->isRunning()) {
                 deadWorkers.push_back(id);
-                continue;
             }
 
             auto callbackIt = callbacks_.find(id);
             if (callbackIt == callbacks_.end()) continue;
 
             // Collect all messages from this worker
-            while (worker->hasMessages()) {
-                messages.emplace_back(id, callbackIt->second, worker->popMessage());
+            batch.clear();
+            worker->popMessages(batch);
+            for (auto& msg : batch) {
+                messages.emplace_back(id, callbackIt->second, std::move(msg));
             }
         }
     }
@@ -134,22 +174,35 @@ bool WorkerRegistry::processWorkerMessages(js::Engine* mainEngine) {
     for (int id : deadWorkers) {
         terminateWorker(id);
     }
+    reapRetiredWorkers();
 
     return hadMessages;
 }
 
-void WorkerRegistry::shutdown() {
-    std::vector<int> ids;
-
+bool WorkerRegistry::waitForMessages(double timeoutMs) {
+    uint32_t epoch = messageSignal_.epoch();
     {
         std::lock_guard<std::mutex> lock(mutex_);
-        for (auto& [id, _] : workers_) {
-            ids.push_back(id);
+        for (auto& [id, worker] : workers_) {
+            if (worker->hasMessages()) return true;
         }
+        if (workers_.empty()) return false;
     }
+    return messageSignal_.wait(epoch, timeoutMs);
+}
 
-    for (int id : ids) {
-        terminateWorker(id);
+void WorkerRegistry::shutdown() {
+    terminateAll();
+
+    // Wait for every worker thread to exit
+    std::vector<std::unique_ptr<WorkerThread>> retired;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        retired = std::move(retired_);
+        retired_.clear();
+    }
+    for (auto& worker : retired) {
+        worker->join();
     }
 
     initialized_ = false;
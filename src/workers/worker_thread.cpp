@@ -3,14 +3,27 @@
  *
  * Runs JavaScript code in a separate thread with its own JS engine.
  * Communicates with the main thread via thread-safe message queues.
+ * Timers, fetch and async fs run on the worker's own event loop.
  */
 
 #include "mystral/workers/worker_thread.h"
+#include "mystral/workers/atomics_wait.h"
 #include "mystral/js/engine.h"
+#include "mystral/debug/trace.h"
+#include "mystral/js/structured_clone.h"
+#include "mystral/js/text_codec.h"
+#include "mystral/vfs/embedded_bundle.h"
 #include <iostream>
+#include <fstream>
 #include <chrono>
 
 namespace mystral {
+
+// Forward declaration for WebGPU bindings
+namespace webgpu {
+    void initWorkerBindings(js::Engine* engine);
+}
+
 namespace workers {
 
 // Global pointer used by worker's native functions to access the engine
@@ -18,17 +31,17 @@ namespace workers {
 thread_local js::Engine* g_workerEngine = nullptr;
 thread_local WorkerThread* g_workerThread = nullptr;
 
-WorkerThread::WorkerThread(int id, const std::string& code)
+WorkerThread::WorkerThread(int id, const std::string& code, WakeupSignal* outSignal)
     : id_(id)
     , code_(code)
+    , inChannel_(kChannelCapacity)
+    , outChannel_(kChannelCapacity, outSignal)
 {
 }
 
 WorkerThread::~WorkerThread() {
     terminate();
-    if (thread_ && thread_->joinable()) {
-        thread_->join();
-    }
+    join();
 }
 
 void WorkerThread::start() {
@@ -42,20 +55,20 @@ void WorkerThread::start() {
 
 void WorkerThread::postMessage(std::vector<uint8_t> data,
                                std::vector<std::shared_ptr<ArrayBufferData>> transfers) {
-    if (terminated_.load()) {
-        return;
-    }
-
     WorkerMessage msg;
     msg.type = WorkerMessage::Type::MESSAGE;
     msg.payload = std::move(data);
     msg.transfers = std::move(transfers);
+    postMessage(std::move(msg));
+}
 
-    {
-        std::lock_guard<std::mutex> lock(inMutex_);
-        inQueue_.push(std::move(msg));
+void WorkerThread::postMessage(WorkerMessage msg) {
+    if (terminated_.load()) {
+        return;
     }
-    inCondition_.notify_one();
+
+    inChannel_.push(std::move(msg));
+    eventLoop_.wakeup();
 }
 
 void WorkerThread::terminate() {
@@ -63,42 +76,64 @@ void WorkerThread::terminate() {
         return;  // Already terminated
     }
 
-    // Send termination message
-    {
-        std::lock_guard<std::mutex> lock(inMutex_);
-        WorkerMessage msg;
-        msg.type = WorkerMessage::Type::TERMINATE;
-        inQueue_.push(std::move(msg));
-    }
-    inCondition_.notify_one();
+    // Send termination message (also wakes the worker if it is idle)
+    WorkerMessage msg;
+    msg.type = WorkerMessage::Type::TERMINATE;
+    inChannel_.push(std::move(msg));
+    eventLoop_.wakeup();
+
+    // Don't join here: the worker may be in the middle of a long-running
+    // job, and terminate() is called from the main thread's JS. The thread
+    // exits at its next loop iteration; join() reclaims it.
+}
 
-    // Wait for thread to finish
+void WorkerThread::join() {
     if (thread_ && thread_->joinable()) {
         thread_->join();
     }
-
     running_ = false;
 }
 
 bool WorkerThread::hasMessages() const {
-    std::lock_guard<std::mutex> lock(outMutex_);
-    return !outQueue_.empty();
+    return outChannel_.hasItems();
 }
 
 WorkerMessage WorkerThread::popMessage() {
-    std::lock_guard<std::mutex> lock(outMutex_);
-    if (outQueue_.empty()) {
-        return WorkerMessage{};
-    }
-    WorkerMessage msg = std::move(outQueue_.front());
-    outQueue_.pop();
+    WorkerMessage msg;
+    outChannel_.tryPop(msg);
     return msg;
 }
 
+size_t WorkerThread::popMessages(std::vector<WorkerMessage>& out, size_t max) {
+    return outChannel_.popBatch(out, max);
+}
+
+// Convert a message from the main thread into { type, data } for the worker's JS
+static js::JSValueHandle messageToJS(js::Engine* engine, const WorkerMessage& msg, int workerId) {
+    auto result = engine->newObject();
+    auto type = engine->newNumber(static_cast<int>(msg.type));
+    engine->setProperty(result, "type", type);
+    engine->releaseHandle(type);
+
+    if (!msg.payload.empty()) {
+        std::string error;
+        js::JSValueHandle data = js::structuredDeserialize(engine,
+            msg.payload.data(), msg.payload.size(), msg.transfers, msg.shared, msg.natives, error);
+        if (data.ptr) {
+            engine->setProperty(result, "data", data);
+            engine->releaseHandle(data);
+        } else {
+            std::cerr << "[Worker " << workerId << "] Failed to read message: " << error << std::endl;
+        }
+    }
+    return result;
+}
+
 void WorkerThread::setupWorkerGlobals(void* enginePtr) {
     auto* engine = static_cast<js::Engine*>(enginePtr);
 
-    // __workerPostMessage(jsonString, transfers) - Send message to main thread
+    // __workerPostMessage(data, transfer) - Send message to main thread
+    // Returns undefined, or a DataCloneError message if data can't be cloned
     engine->setGlobalProperty("__workerPostMessage",
         engine->newFunction("__workerPostMessage",
             [](void* ctx, const std::vector<js::JSValueHandle>& args) {
@@ -110,24 +145,46 @@ void WorkerThread::setupWorkerGlobals(void* enginePtr) {
                     return g_workerEngine->newUndefined();
                 }
 
-                // Get JSON string payload
-                std::string json = g_workerEngine->toString(args[0]);
+                // Serialize; transferred ArrayBuffers are detached and move with the message
+                js::SerializedValue serialized;
+                std::string error;
+                js::JSValueHandle transfer = args.size() > 1 ? args[1] : js::JSValueHandle{};
+                if (!js::structuredSerialize(g_workerEngine, args[0], transfer, serialized, error)) {
+                    return g_workerEngine->newString(error.c_str());
+                }
 
                 WorkerMessage msg;
                 msg.type = WorkerMessage::Type::MESSAGE;
-                msg.payload = std::vector<uint8_t>(json.begin(), json.end());
-
-                // Handle transfers (ArrayBuffers)
-                if (args.size() > 1 && g_workerEngine->isArray(args[1])) {
-                    // TODO: Extract ArrayBuffers and mark as transferred
-                }
+                msg.payload = std::move(serialized.data);
+                msg.transfers = std::move(serialized.transfers);
+                msg.shared = std::move(serialized.shared);
+                msg.natives = std::move(serialized.natives);
 
                 // Queue message for main thread
-                {
-                    std::lock_guard<std::mutex> lock(g_workerThread->outMutex_);
-                    g_workerThread->outQueue_.push(std::move(msg));
+                g_workerThread->outChannel_.push(std::move(msg));
+
+                return g_workerEngine->newUndefined();
+            }
+        )
+    );
+
+    // __workerReportError(message, stack) - Forward an error the worker scope
+    // did not handle to the Worker object's onerror/'error' listeners
+    engine->setGlobalProperty("__workerReportError",
+        engine->newFunction("__workerReportError",
+            [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                if (!g_workerThread || args.empty()) return g_workerEngine->newUndefined();
+
+                std::string text = g_workerEngine->toString(args[0]);
+                if (args.size() > 1) {
+                    std::string stack = g_workerEngine->toString(args[1]);
+                    if (!stack.empty()) text += '\0' + stack;
                 }
 
+                WorkerMessage msg;
+                msg.type = WorkerMessage::Type::ERROR;
+                msg.payload = std::vector<uint8_t>(text.begin(), text.end());
+                g_workerThread->outChannel_.push(std::move(msg));
                 return g_workerEngine->newUndefined();
             }
         )
@@ -152,8 +209,7 @@ void WorkerThread::setupWorkerGlobals(void* enginePtr) {
                 if (!g_workerThread) {
                     return g_workerEngine->newBoolean(false);
                 }
-                std::lock_guard<std::mutex> lock(g_workerThread->inMutex_);
-                return g_workerEngine->newBoolean(!g_workerThread->inQueue_.empty());
+                return g_workerEngine->newBoolean(g_workerThread->inChannel_.hasItems());
             }
         )
     );
@@ -171,43 +227,86 @@ void WorkerThread::setupWorkerGlobals(void* enginePtr) {
                     blocking = g_workerEngine->toBoolean(args[0]);
                 }
 
+                auto& channel = g_workerThread->inChannel_;
                 WorkerMessage msg;
-                {
-                    std::unique_lock<std::mutex> lock(g_workerThread->inMutex_);
-
-                    if (blocking) {
-                        // Wait for a message with timeout (100ms)
-                        g_workerThread->inCondition_.wait_for(lock,
-                            std::chrono::milliseconds(100),
-                            [&]() {
-                                return !g_workerThread->inQueue_.empty() ||
-                                       g_workerThread->terminated_.load();
-                            }
-                        );
-                    }
-
-                    if (g_workerThread->inQueue_.empty()) {
+                while (!channel.tryPop(msg)) {
+                    if (!blocking || g_workerThread->terminated_.load()) {
                         return g_workerEngine->newNull();
                     }
+                    // Sleep until the main thread posts (terminate() posts too)
+                    uint32_t epoch = channel.signal().epoch();
+                    if (!channel.hasItems()) {
+                        channel.signal().wait(epoch);
+                    }
+                }
+
+                return messageToJS(g_workerEngine, msg, g_workerThread->getId());
+            }
+        )
+    );
 
-                    msg = std::move(g_workerThread->inQueue_.front());
-                    g_workerThread->inQueue_.pop();
+    // __workerGetMessages() - Drain every queued message as an array (non-blocking)
+    engine->setGlobalProperty("__workerGetMessages",
+        engine->newFunction("__workerGetMessages",
+            [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                std::vector<WorkerMessage> batch;
+                if (g_workerThread) {
+                    g_workerThread->inChannel_.popBatch(batch);
+                }
+
+                auto result = g_workerEngine->newArray(batch.size());
+                for (size_t i = 0; i < batch.size(); i++) {
+                    auto item = messageToJS(g_workerEngine, batch[i], g_workerThread->getId());
+                    g_workerEngine->setPropertyIndex(result, static_cast<uint32_t>(i), item);
+                    g_workerEngine->releaseHandle(item);
                 }
+                return result;
+            }
+        )
+    );
 
-                // Create result object
-                auto result = g_workerEngine->newObject();
-                g_workerEngine->setProperty(result, "type",
-                    g_workerEngine->newNumber(static_cast<int>(msg.type)));
+    // __workerNow() - Milliseconds since the worker started (performance.now)
+    static thread_local auto startTime = std::chrono::steady_clock::now();
+    startTime = std::chrono::steady_clock::now();
+    engine->setGlobalProperty("__workerNow",
+        engine->newFunction("__workerNow",
+            [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                auto elapsed = std::chrono::steady_clock::now() - startTime;
+                return g_workerEngine->newNumber(
+                    std::chrono::duration<double, std::milli>(elapsed).count());
+            }
+        )
+    );
 
-                if (!msg.payload.empty()) {
-                    std::string json(msg.payload.begin(), msg.payload.end());
-                    g_workerEngine->setProperty(result, "data",
-                        g_workerEngine->newString(json.c_str()));
+    // __workerReadFile(path) - Synchronous text read for importScripts()
+    // Checks the embedded bundle first, then the file system
+    engine->setGlobalProperty("__workerReadFile",
+        engine->newFunction("__workerReadFile",
+            [](void* ctx, const std::vector<js::JSValueHandle>& args) {
+                if (args.empty()) {
+                    return g_workerEngine->newNull();
                 }
 
-                // TODO: Handle transferred ArrayBuffers
+                std::string path = g_workerEngine->toString(args[0]);
+                if (path.substr(0, 7) == "file://") {
+                    path = path.substr(7);
+                }
 
-                return result;
+                std::vector<uint8_t> data;
+                if (!vfs::readEmbeddedFile(path, data)) {
+                    std::ifstream file(path, std::ios::binary | std::ios::ate);
+                    if (!file.is_open()) {
+                        return g_workerEngine->newNull();
+                    }
+                    size_t size = file.tellg();
+                    file.seekg(0, std::ios::beg);
+                    data.resize(size);
+                    if (!file.read(reinterpret_cast<char*>(data.data()), size)) {
+                        return g_workerEngine->newNull();
+                    }
+                }
+
+                return g_workerEngine->newStringUtf8(reinterpret_cast<const char*>(data.data()), data.size());
             }
         )
     );
@@ -217,10 +316,15 @@ void WorkerThread::setupWorkerGlobals(void* enginePtr) {
 // Worker global scope - make self a global reference to globalThis
 globalThis.self = globalThis;
 
+if (typeof performance === 'undefined') {
+    globalThis.performance = { now: () => __workerNow() };
+}
+
 // Private state (using closure via IIFE to hide internals)
 (function() {
     let _onmessage = null;
     let _onerror = null;
+    const _listeners = { message: [], error: [] };
 
     // onmessage property on globalThis (accessible as self.onmessage)
     Object.defineProperty(globalThis, 'onmessage', {
@@ -240,9 +344,9 @@ globalThis.self = globalThis;
 
     // postMessage function
     globalThis.postMessage = function(data, transfer) {
-        transfer = transfer || [];
-        const json = JSON.stringify(data);
-        __workerPostMessage(json, transfer);
+        if (transfer && !Array.isArray(transfer)) transfer = transfer.transfer;
+        const error = __workerPostMessage(data, transfer);
+        if (error) throw __structuredCloneHelpers.fail(error);
     };
 
     // close function
@@ -250,26 +354,86 @@ globalThis.self = globalThis;
         __workerClose();
     };
 
+    // addEventListener('message' | 'error', fn)
+    globalThis.addEventListener = function(type, fn) {
+        if (_listeners[type] && typeof fn === 'function') _listeners[type].push(fn);
+    };
+    globalThis.removeEventListener = function(type, fn) {
+        if (!_listeners[type]) return;
+        const idx = _listeners[type].indexOf(fn);
+        if (idx !== -1) _listeners[type].splice(idx, 1);
+    };
+
+    // Patched eval that handles Emscripten's `(var X = ...)` pattern, which is
+    // invalid as an expression but common in WASM module loaders (Draco, etc.)
+    const _nativeEval = globalThis.eval;
+    globalThis.eval = function(code) {
+        try { return _nativeEval(code); }
+        catch (e) {
+            if (e instanceof SyntaxError) {
+                const t = String(code).trim();
+                if (t[0] === '(' && t[t.length - 1] === ')') {
+                    const inner = t.slice(1, -1).trim();
+                    if (/^(?:var|let|const)\s/.test(inner)) {
+                        _nativeEval(inner);
+                        const m = inner.match(/^(?:var|let|const)\s+(\w+)/);
+                        if (m) return _nativeEval(m[1]);
+                    }
+                }
+            }
+            throw e;
+        }
+    };
+
+    // importScripts(...urls) - synchronous script loading, as in browsers
+    globalThis.importScripts = function() {
+        for (let i = 0; i < arguments.length; i++) {
+            const url = String(arguments[i]);
+            const code = __workerReadFile(url);
+            if (code === null) {
+                throw new Error('importScripts: Failed to load script: ' + url);
+            }
+            _nativeEval(code);
+        }
+    };
+
+    // As in browsers, an error the worker scope does not handle (onerror
+    // returning true or a listener calling preventDefault) goes to the parent
+    function dispatchError(e) {
+        const message = e && e.message !== undefined ? String(e.message) : String(e);
+        let handled = false;
+        const event = {
+            error: e, message: message,
+            preventDefault() { handled = true; }
+        };
+        try {
+            if (_onerror && _onerror(event) === true) handled = true;
+            for (const fn of _listeners.error) fn(event);
+        } catch (handlerError) {
+            console.error('[Worker] Error in error handler:', handlerError);
+        }
+        if (!handled) __workerReportError(message, e && e.stack ? String(e.stack) : '');
+    }
+
     // Internal: Process incoming messages
     globalThis.__processMessages = function() {
-        while (true) {
-            const msg = __workerGetMessage(false);  // Non-blocking
-            if (!msg) break;
+        const batch = __workerGetMessages();  // Non-blocking, drains the queue
+        for (let i = 0; i < batch.length; i++) {
+            const msg = batch[i];
 
             if (msg.type === 2) {  // TERMINATE
                 globalThis.close();
                 return false;
             }
 
-            if (msg.type === 0 && _onmessage) {  // MESSAGE
+            if (msg.type === 0 && (_onmessage || _listeners.message.length)) {  // MESSAGE
                 try {
-                    const data = msg.data ? JSON.parse(msg.data) : undefined;
-                    _onmessage({ data: data, target: globalThis });
+                    const event = { data: msg.data, target: globalThis };
+                    if (_onmessage) _onmessage(event);
+                    for (const fn of _listeners.message) fn(event);
                 } catch (e) {
                     console.error('[Worker] Error processing message:', e);
-                    if (_onerror) {
-                        _onerror({ error: e, message: e.message });
-                    }
+                    dispatchError(e);
                 }
             }
         }
@@ -278,11 +442,17 @@ globalThis.self = globalThis;
 })();
 )";
 
+    js::installStructuredClone(engine);
+    js::installTextCodec(engine);
+    // Workers may block in Atomics.wait; the main thread may not
+    engine->setAtomicsWaitAllowed(true);
+    installAtomicsFallback(engine, true);
     engine->eval(workerGlobalCode, "worker-global.js");
 }
 
 void WorkerThread::threadMain() {
     std::cout << "[Worker " << id_ << "] Thread started" << std::endl;
+    debug::trace::setThreadName("Worker " + std::to_string(id_));
 
     // Create a new JS engine for this worker
     auto engine = js::createEngine();
@@ -295,10 +465,7 @@ void WorkerThread::threadMain() {
         errMsg.type = WorkerMessage::Type::ERROR;
         std::string error = "Failed to create JS engine";
         errMsg.payload = std::vector<uint8_t>(error.begin(), error.end());
-        {
-            std::lock_guard<std::mutex> lock(outMutex_);
-            outQueue_.push(std::move(errMsg));
-        }
+        outChannel_.push(std::move(errMsg));
         return;
     }
 
@@ -338,6 +505,12 @@ globalThis.console = {
     // Setup worker globals (after console is available)
     setupWorkerGlobals(engine.get());
 
+    // Timers, fetch and async fs on this thread's own event loop
+    eventLoop_.init(engine.get(), id_);
+
+    // mystral.gpu.device for recording command buffers and render bundles
+    webgpu::initWorkerBindings(engine.get());
+
     // Execute the worker code
     std::cout << "[Worker " << id_ << "] Executing user code..." << std::endl;
     if (!engine->eval(code_.c_str(), "worker.js")) {
@@ -347,10 +520,7 @@ globalThis.console = {
         WorkerMessage errMsg;
         errMsg.type = WorkerMessage::Type::ERROR;
         errMsg.payload = std::vector<uint8_t>(error.begin(), error.end());
-        {
-            std::lock_guard<std::mutex> lock(outMutex_);
-            outQueue_.push(std::move(errMsg));
-        }
+        outChannel_.push(std::move(errMsg));
     } else {
         std::cout << "[Worker " << id_ << "] User code executed successfully" << std::endl;
     }
@@ -363,23 +533,48 @@ globalThis.console = {
 
     std::cout << "[Worker " << id_ << "] Entering main loop..." << std::endl;
 
+    // Look up the message pump once instead of re-evaluating source every iteration
+    js::JSValueHandle processMessages = engine->getGlobalProperty("__processMessages");
+    engine->protect(processMessages);
+
     // Main worker loop
     while (!terminated_.load()) {
+        engine->beginFrame();
+
+        // Due timers and finished fetch/file reads
+        {
+            MYSTRAL_TRACE_SCOPE_CAT("worker.eventLoop", "worker");
+            eventLoop_.runOnce();
+        }
+
         // Process messages via JS
-        auto processResult = engine->evalWithResult("__processMessages()", "worker-loop.js");
-        if (engine->hasException()) {
+        js::JSValueHandle processResult;
+        {
+            MYSTRAL_TRACE_SCOPE_CAT("worker.messages", "worker");
+            processResult = engine->call(processMessages, engine->newUndefined(), {});
+        }
+        if (!processResult.ptr) {
             std::string error = engine->getException();
             std::cerr << "[Worker " << id_ << "] Exception in message loop: " << error << std::endl;
-        }
-        if (!engine->toBoolean(processResult)) {
+        } else if (!engine->toBoolean(processResult)) {
             std::cout << "[Worker " << id_ << "] __processMessages returned false, exiting" << std::endl;
+            engine->clearFrameHandles();
             break;  // Worker requested close
         }
 
-        // Small sleep to prevent busy-waiting
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        engine->clearFrameHandles();
+
+        // Sleep until the main thread posts a message (or terminates us),
+        // a timer is due or an in-flight request completes
+        uint32_t epoch = inChannel_.signal().epoch();
+        if (!inChannel_.hasItems() && !terminated_.load()) {
+            eventLoop_.wait(inChannel_.signal(), epoch);
+        }
     }
 
+    engine->unprotect(processMessages);
+    eventLoop_.shutdown();
+
     // Cleanup
     g_workerEngine = nullptr;
     g_workerThread = nullptr;
@@ -0,0 +1,278 @@
+/**
+ * Structured Clone Tests
+ *
+ * Round-trips values through structuredClone() and worker postMessage(),
+ * which share the binary clone codec. Only the GPU handle test needs a
+ * device (runs headless and exits from the script).
+ */
+
+import { describe, it, expect, beforeAll } from "bun:test";
+import { spawn } from "bun";
+import { existsSync, writeFileSync, mkdirSync } from "fs";
+import { join } from "path";
+
+const MYSTRAL_BIN = join(import.meta.dir, "../../build/mystral");
+const TEST_DIR = join(import.meta.dir, "../../.test-tmp");
+
+// Prints "PASS: <name>" or "FAIL: <name> ..." per check
+const CHECK_PRELUDE = `
+  function check(name, fn) {
+    try {
+      console.log((fn() ? 'PASS: ' : 'FAIL: ') + name);
+    } catch (e) {
+      console.log('FAIL: ' + name + ' threw ' + e.message);
+    }
+  }
+  function throwsDataCloneError(name, fn) {
+    try {
+      fn();
+      console.log('FAIL: ' + name + ' did not throw');
+    } catch (e) {
+      console.log((e.name === 'DataCloneError' ? 'PASS: ' : 'FAIL: ') + name);
+    }
+  }
+  const NUL = String.fromCharCode(0);
+`;
+
+async function runScript(name: string, body: string): Promise<string> {
+  const scriptPath = join(TEST_DIR, `${name}.js`);
+  writeFileSync(scriptPath, CHECK_PRELUDE + body);
+
+  const proc = spawn({
+    cmd: [MYSTRAL_BIN, "run", scriptPath, "--headless"],
+    stdout: "pipe",
+    stderr: "pipe",
+  });
+
+  const stdout = await new Response(proc.stdout).text();
+  await proc.exited;
+  return stdout;
+}
+
+function expectAllPassed(stdout: string, names: string[]) {
+  expect(stdout).not.toContain("FAIL:");
+  for (const name of names) {
+    expect(stdout).toContain(`PASS: ${name}`);
+  }
+}
+
+describe("Structured Clone", () => {
+  beforeAll(() => {
+    if (!existsSync(TEST_DIR)) {
+      mkdirSync(TEST_DIR, { recursive: true });
+    }
+  });
+
+  it("should round-trip Map, Set, Date, RegExp, Error and BigInt", async () => {
+    if (!existsSync(MYSTRAL_BIN)) {
+      console.log("Skipping: mystral binary not found");
+      return;
+    }
+
+    const stdout = await runScript("clone-types-test", `
+      check('map', () => {
+        const key = { k: 1 };
+        const c = structuredClone(new Map([[1, 'a'], [key, new Set([1, 2])]]));
+        const keys = [...c.keys()];
+        const values = [...c.values()];
+        return c instanceof Map && c.size === 2 && c.get(1) === 'a' &&
+               keys[1] !== key && keys[1].k === 1 && values[1] instanceof Set;
+      });
+      check('set', () => {
+        const c = structuredClone(new Set(['x', 2, null]));
+        return c instanceof Set && c.size === 3 && c.has('x') && c.has(2) && c.has(null);
+      });
+      check('date', () => {
+        const d = new Date(1700000000123);
+        const c = structuredClone(d);
+        return c instanceof Date && c !== d && c.getTime() === 1700000000123;
+      });
+      check('regexp flags', () => {
+        const r = /a.b/gimsuy;
+        r.lastIndex = 3;
+        const c = structuredClone(r);
+        return c instanceof RegExp && c.source === 'a.b' && c.flags === r.flags && c.lastIndex === 0;
+      });
+      check('error', () => {
+        const c = structuredClone(new TypeError('bad input'));
+        return c instanceof TypeError && c.name === 'TypeError' && c.message === 'bad input';
+      });
+      check('plain error', () => {
+        const c = structuredClone(new Error('oops'));
+        return c instanceof Error && c.name === 'Error' && c.message === 'oops';
+      });
+      check('bigint', () => {
+        return structuredClone(12345678901234567890n) === 12345678901234567890n &&
+               structuredClone(-42n) === -42n;
+      });
+      process.exit(0);
+    `);
+
+    expectAllPassed(stdout, ["map", "set", "date", "regexp flags", "error", "plain error", "bigint"]);
+  });
+
+  it("should keep cycles, shared references and views over one buffer", async () => {
+    if (!existsSync(MYSTRAL_BIN)) {
+      console.log("Skipping: mystral binary not found");
+      return;
+    }
+
+    const stdout = await runScript("clone-graph-test", `
+      check('cycle', () => {
+        const o = { name: 'o' };
+        o.self = o;
+        o.list = [o];
+        const c = structuredClone(o);
+        return c !== o && c.self === c && c.list[0] === c && c.name === 'o';
+      });
+      check('shared reference', () => {
+        const shared = { v: 1 };
+        const c = structuredClone({ a: shared, b: [shared] });
+        return c.a === c.b[0] && c.a !== shared && c.a.v === 1;
+      });
+      check('views share a buffer', () => {
+        const buffer = new ArrayBuffer(16);
+        const bytes = new Uint8Array(buffer, 0, 8);
+        const floats = new Float32Array(buffer, 8, 2);
+        const view = new DataView(buffer, 4, 4);
+        bytes[0] = 7;
+        floats[1] = 1.5;
+        const c = structuredClone({ bytes, floats, view, buffer });
+        return c.buffer !== buffer && c.buffer.byteLength === 16 &&
+               c.bytes.buffer === c.buffer && c.floats.buffer === c.buffer && c.view.buffer === c.buffer &&
+               c.bytes.byteOffset === 0 && c.bytes.length === 8 && c.bytes[0] === 7 &&
+               c.floats.byteOffset === 8 && c.floats.length === 2 && c.floats[1] === 1.5 &&
+               c.view instanceof DataView && c.view.byteOffset === 4 && c.view.byteLength === 4;
+      });
+      process.exit(0);
+    `);
+
+    expectAllPassed(stdout, ["cycle", "shared reference", "views share a buffer"]);
+  });
+
+  it("should keep embedded NULs in strings and keys", async () => {
+    if (!existsSync(MYSTRAL_BIN)) {
+      console.log("Skipping: mystral binary not found");
+      return;
+    }
+
+    const stdout = await runScript("clone-nul-test", `
+      check('nul value', () => {
+        const c = structuredClone('a' + NUL + 'b');
+        return c.length === 3 && c === 'a' + NUL + 'b';
+      });
+      check('nul key', () => {
+        const c = structuredClone({ ['k' + NUL + 'ey']: 1, k: 2 });
+        return c['k' + NUL + 'ey'] === 1 && c.k === 2 && Object.keys(c).length === 2;
+      });
+      check('nul in error and regexp', () => {
+        const e = structuredClone(new Error('x' + NUL + 'y'));
+        const r = structuredClone(new RegExp('a' + NUL + 'b'));
+        return e.message === 'x' + NUL + 'y' && r.source === new RegExp('a' + NUL + 'b').source;
+      });
+      check('nul in map', () => {
+        const c = structuredClone(new Map([['m' + NUL, 'v' + NUL]]));
+        return c.get('m' + NUL) === 'v' + NUL;
+      });
+      process.exit(0);
+    `);
+
+    expectAllPassed(stdout, ["nul value", "nul key", "nul in error and regexp", "nul in map"]);
+  });
+
+  it("should throw DataCloneError for values that cannot be cloned", async () => {
+    if (!existsSync(MYSTRAL_BIN)) {
+      console.log("Skipping: mystral binary not found");
+      return;
+    }
+
+    const stdout = await runScript("clone-errors-test", `
+      throwsDataCloneError('function', () => structuredClone(() => 1));
+      throwsDataCloneError('nested function', () => structuredClone({ a: [{ f() {} }] }));
+      throwsDataCloneError('symbol', () => structuredClone(Symbol('s')));
+      throwsDataCloneError('weakmap', () => structuredClone(new WeakMap()));
+      throwsDataCloneError('promise', () => structuredClone(Promise.resolve(1)));
+      throwsDataCloneError('transfer not a buffer', () => structuredClone(1, { transfer: [{}] }));
+      process.exit(0);
+    `);
+
+    expectAllPassed(stdout, [
+      "function",
+      "nested function",
+      "symbol",
+      "weakmap",
+      "promise",
+      "transfer not a buffer",
+    ]);
+  });
+
+  it("should share GPU objects and transfer command buffers", async () => {
+    if (!existsSync(MYSTRAL_BIN)) {
+      console.log("Skipping: mystral binary not found");
+      return;
+    }
+
+    const stdout = await runScript("clone-gpu-test", `
+      function throws(fn) {
+        try { fn(); return false; } catch (e) { return true; }
+      }
+      navigator.gpu.requestAdapter().then((adapter) => adapter.requestDevice()).then((device) => {
+        const buffer = device.createBuffer({ size: 16, usage: GPUBufferUsage.COPY_DST });
+        check('buffer is shared', () => {
+          const c = structuredClone(buffer);
+          return c !== buffer && c._type === 'buffer' && structuredClone(buffer)._type === 'buffer';
+        });
+
+        const commandBuffer = device.createCommandEncoder().finish();
+        throwsDataCloneError('command buffer needs the transfer list', () => structuredClone(commandBuffer));
+        const moved = structuredClone(commandBuffer, { transfer: [commandBuffer] });
+        check('transferred command buffer is emptied', () => throws(() => device.queue.submit([commandBuffer])));
+        check('command buffer submits once', () => {
+          device.queue.submit([moved]);
+          return throws(() => device.queue.submit([moved]));
+        });
+        check('duplicate command buffer rejected', () => {
+          const cb = device.createCommandEncoder().finish();
+          return throws(() => device.queue.submit([cb, cb]));
+        });
+        process.exit(0);
+      });
+    `);
+
+    expectAllPassed(stdout, [
+      "buffer is shared",
+      "command buffer needs the transfer list",
+      "transferred command buffer is emptied",
+      "command buffer submits once",
+      "duplicate command buffer rejected",
+    ]);
+  });
+
+  it("should round-trip through a worker", async () => {
+    if (!existsSync(MYSTRAL_BIN)) {
+      console.log("Skipping: mystral binary not found");
+      return;
+    }
+
+    const stdout = await runScript("clone-worker-test", `
+      const worker = new Worker(new Blob(['self.onmessage = (e) => postMessage(e.data);']));
+      const o = { s: 'a' + NUL + 'b', m: new Map([[1, new Set([2])]]), n: 5n, d: new Date(1000) };
+      o.self = o;
+      o.bytes = new Uint16Array([1, 2, 3]);
+      worker.onmessage = (e) => {
+        const c = e.data;
+        check('worker round trip', () =>
+          c.self === c && c.s === 'a' + NUL + 'b' && c.m.get(1).has(2) && c.n === 5n &&
+          c.d.getTime() === 1000 && c.bytes instanceof Uint16Array && c.bytes[2] === 3);
+        process.exit(0);
+      };
+      worker.postMessage(o);
+      setTimeout(() => {
+        console.log('FAIL: worker round trip timed out');
+        process.exit(1);
+      }, 5000);
+    `);
+
+    expectAllPassed(stdout, ["worker round trip"]);
+  });
+});
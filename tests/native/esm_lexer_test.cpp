@@ -0,0 +1,274 @@
+/**
+ * ESM Lexer Tests (mystral-test-esm-lexer)
+ *
+ * Checks scanEsm() and transformEsmToCjs() on the constructs a line-based
+ * rewrite gets wrong: regex literals vs division, template literals with
+ * nested ${}, comments and strings that mention import/export, every export
+ * default form, import.meta, re-exports and literal require() calls.
+ * No JS engine is involved.
+ *
+ * Run with: ctest --test-dir build -R esm-lexer
+ */
+
+#include "mystral/js/esm_lexer.h"
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using mystral::js::EsmScanResult;
+using mystral::js::EsmStatement;
+using mystral::js::scanEsm;
+using mystral::js::transformEsmToCjs;
+
+namespace {
+
+int g_failures = 0;
+const char* g_test = "";
+
+#define CHECK(cond)                                                                          \
+    do {                                                                                     \
+        if (!(cond)) {                                                                       \
+            std::cerr << "FAIL " << g_test << " (line " << __LINE__ << "): " #cond << std::endl; \
+            g_failures++;                                                                    \
+        }                                                                                    \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                                      \
+    do {                                                                                    \
+        if (!((a) == (b))) {                                                                \
+            std::cerr << "FAIL " << g_test << " (line " << __LINE__ << "): " #a " == " #b   \
+                      << "\n  got:      " << (a) << "\n  expected: " << (b) << std::endl;   \
+            g_failures++;                                                                   \
+        }                                                                                   \
+    } while (0)
+
+using Names = std::vector<std::pair<std::string, std::string>>;
+
+bool contains(const std::string& text, const std::string& part) {
+    return text.find(part) != std::string::npos;
+}
+
+size_t lineCount(const std::string& text) {
+    return static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+}
+
+void testRegexVersusDivision() {
+    g_test = "regex literals vs division";
+    EsmScanResult result = scanEsm(
+        "const re = /import x from \"y\"/g;\n"
+        "const cls = /[/]export const a = 1;/;\n"
+        "const ratio = width / height / 2;\n"
+        "const half = (a + b) / 2; const s = 'x'.length / 1;\n"
+        "if (ok) /export default 1/.test(s);\n"
+        "export const z = ratio;\n");
+    CHECK_EQ(result.statements.size(), 1u);
+    if (result.statements.size() == 1) {
+        CHECK(result.statements[0].kind == EsmStatement::Kind::ExportDeclaration);
+        CHECK(result.statements[0].declared == std::vector<std::string>{"z"});
+    }
+}
+
+void testTemplateLiterals() {
+    g_test = "template literals with ${}";
+    EsmScanResult result = scanEsm(
+        "const t = `export const a = ${ `import x from \"y\" ${ {b: 1}.b }` } }`;\n"
+        "const u = `${'`'}import y from \"z\"`;\n"
+        "export default t;\n");
+    CHECK_EQ(result.statements.size(), 1u);
+    if (result.statements.size() == 1) {
+        CHECK(result.statements[0].kind == EsmStatement::Kind::ExportDefault);
+    }
+}
+
+void testCommentsAndStrings() {
+    g_test = "comments and strings mentioning import";
+    EsmScanResult result = scanEsm(
+        "// import a from \"b\"\n"
+        "/* export const x = 1;\n"
+        "   import c from \"c\"; */\n"
+        "const s = \"import d from 'd'\"; const q = 'export { e }';\n"
+        "import f from \"f\"; // import g from \"g\"\n");
+    CHECK_EQ(result.statements.size(), 1u);
+    if (result.statements.size() == 1) {
+        CHECK(result.statements[0].kind == EsmStatement::Kind::Import);
+        CHECK_EQ(result.statements[0].specifier, "f");
+        CHECK_EQ(result.statements[0].defaultName, "f");
+    }
+}
+
+void testImports() {
+    g_test = "import forms";
+    EsmScanResult result = scanEsm(
+        "import d, { a as b, c } from \"m\";\n"
+        "import * as ns from './ns.js';\n"
+        "import {\n  x,\n  y as z,\n} from \"multi\";\n"
+        "import \"side-effect\";\n");
+    CHECK_EQ(result.statements.size(), 4u);
+    if (result.statements.size() == 4) {
+        CHECK_EQ(result.statements[0].defaultName, "d");
+        CHECK(result.statements[0].names == (Names{{"a", "b"}, {"c", "c"}}));
+        CHECK_EQ(result.statements[1].namespaceName, "ns");
+        CHECK_EQ(result.statements[1].specifier, "./ns.js");
+        CHECK(result.statements[2].names == (Names{{"x", "x"}, {"y", "z"}}));
+        CHECK_EQ(result.statements[3].specifier, "side-effect");
+    }
+}
+
+void testExportDefaultForms() {
+    g_test = "export default forms";
+    EsmScanResult result = scanEsm(
+        "export default function () {}\n");
+    CHECK_EQ(result.statements.size(), 1u);
+    if (result.statements.size() == 1) {
+        const EsmStatement& s = result.statements[0];
+        CHECK(s.kind == EsmStatement::Kind::ExportDefault);
+        CHECK(s.defaultIsDeclaration);
+        CHECK(s.nameInsertAt != std::string::npos);
+    }
+
+    result = scanEsm("export default class Player extends Base {}\n");
+    CHECK_EQ(result.statements.size(), 1u);
+    if (result.statements.size() == 1) {
+        CHECK(result.statements[0].defaultIsDeclaration);
+        CHECK_EQ(result.statements[0].defaultName, "Player");
+    }
+
+    result = scanEsm("export default async function load() {}\n");
+    CHECK_EQ(result.statements.size(), 1u);
+    if (result.statements.size() == 1) {
+        CHECK(result.statements[0].defaultIsDeclaration);
+        CHECK_EQ(result.statements[0].defaultName, "load");
+    }
+
+    result = scanEsm("export default { speed: 5 } ;\n");
+    CHECK_EQ(result.statements.size(), 1u);
+    if (result.statements.size() == 1) {
+        CHECK(!result.statements[0].defaultIsDeclaration);
+    }
+
+    std::string out = transformEsmToCjs("export default function () { return 1; }\n");
+    CHECK(!contains(out, "export "));
+    CHECK(contains(out, "default"));
+}
+
+void testReExports() {
+    g_test = "re-exports";
+    EsmScanResult result = scanEsm(
+        "export * from \"a\";\n"
+        "export * as ns from 'b';\n"
+        "export { x as y, default as z } from \"c\";\n"
+        "const w = 1; export { w, w as v };\n");
+    CHECK_EQ(result.statements.size(), 4u);
+    if (result.statements.size() == 4) {
+        CHECK(result.statements[0].kind == EsmStatement::Kind::ExportAll);
+        CHECK(result.statements[0].namespaceName.empty());
+        CHECK_EQ(result.statements[0].specifier, "a");
+        CHECK(result.statements[1].kind == EsmStatement::Kind::ExportAll);
+        CHECK_EQ(result.statements[1].namespaceName, "ns");
+        CHECK(result.statements[2].kind == EsmStatement::Kind::ExportFrom);
+        CHECK(result.statements[2].names == (Names{{"x", "y"}, {"default", "z"}}));
+        CHECK(result.statements[3].kind == EsmStatement::Kind::ExportList);
+        CHECK(result.statements[3].names == (Names{{"w", "w"}, {"w", "v"}}));
+    }
+
+    std::string out = transformEsmToCjs("export * from \"a\";\nexport * as ns from 'b';\n");
+    CHECK(contains(out, "require(\"a\")"));
+    CHECK(contains(out, "require('b')") || contains(out, "require(\"b\")"));
+}
+
+void testImportMeta() {
+    g_test = "import.meta";
+    std::string source =
+        "const url = import.meta.url;\n"
+        "const s = 'import.meta'; // import.meta\n"
+        "if (import.meta.hot) import.meta.hot.accept();\n"
+        "export { url };\n";
+    EsmScanResult result = scanEsm(source);
+    CHECK_EQ(result.importMetas.size(), 3u);
+
+    std::string out = transformEsmToCjs(source);
+    CHECK(contains(out, "__esm_importMeta.url"));
+    CHECK(contains(out, "__esm_importMeta.hot.accept()"));
+    CHECK(contains(out, "'import.meta'"));  // Strings and comments are left alone
+    CHECK_EQ(lineCount(out), lineCount(source));
+
+    // No exports: the import.meta prelude is still emitted
+    out = transformEsmToCjs("console.log(import.meta.url);\n");
+    CHECK(contains(out, "__esm_importMeta = {"));
+    CHECK(contains(out, "console.log(__esm_importMeta.url)"));
+}
+
+void testRequireAndDynamicImport() {
+    g_test = "literal require() and import()";
+    EsmScanResult result = scanEsm(
+        "const a = require(\"a\");\n"
+        "require('b');\n"
+        "const c = require(name);\n"
+        "const d = require(\"d\" + suffix);\n"
+        "obj.require(\"not-a-require\");\n"
+        "// require(\"commented\")\n"
+        "const e = `${require(\"in-template\")}`;\n"
+        "import(\"dyn\").then(() => {});\n"
+        "import(spec);\n");
+    CHECK(result.requireCalls == (std::vector<std::string>{"a", "b", "in-template"}));
+    CHECK(result.dynamicImports == (std::vector<std::string>{"dyn"}));
+    CHECK(result.statements.empty());
+}
+
+void testLinesPreserved() {
+    g_test = "line numbers preserved";
+    std::string source =
+        "import {\n"
+        "  a,\n"
+        "  b,\n"
+        "} from \"m\";\n"
+        "export const x = a + b;\n"
+        "export {\n"
+        "  x as y,\n"
+        "};\n"
+        "throw new Error('line 9');\n";
+    std::string out = transformEsmToCjs(source);
+    CHECK_EQ(lineCount(out), lineCount(source));
+    size_t throwLine = lineCount(out.substr(0, out.find("throw new Error")));
+    CHECK_EQ(throwLine, 8u);
+    CHECK(!contains(out, "import {"));
+}
+
+void testNestedNotTopLevel() {
+    g_test = "import/export only at top level";
+    EsmScanResult result = scanEsm(
+        "function f() { const importer = 1; return { export: 2, import: 3 }; }\n"
+        "class K { import() {} export() {} }\n"
+        "const o = { import: 1 }; o.export = 2;\n");
+    CHECK(result.statements.empty());
+}
+
+}  // namespace
+
+int main() {
+    const std::vector<std::function<void()>> tests = {
+        testRegexVersusDivision,
+        testTemplateLiterals,
+        testCommentsAndStrings,
+        testImports,
+        testExportDefaultForms,
+        testReExports,
+        testImportMeta,
+        testRequireAndDynamicImport,
+        testLinesPreserved,
+        testNestedNotTopLevel,
+    };
+    for (const auto& test : tests) {
+        test();
+    }
+
+    if (g_failures > 0) {
+        std::cerr << g_failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All " << tests.size() << " ESM lexer tests passed" << std::endl;
+    return 0;
+}